@@ -33,6 +33,13 @@ object InfluxRepository {
 
     private const val KEY_CACHED_LATEST_FIELDS = "cached_last_fields"
 
+    // The node writes a steady field only once per REPORT_HEARTBEAT_MS
+    // (5 min by default with REPORT_CHANGE_ONLY), and fields that moved at
+    // different times don't share a timestamp: look back at least two
+    // heartbeats, and carry a field forward that long in history rows
+    private const val STALE_FIELD_MS = 10 * 60 * 1000L
+    private const val MIN_LATEST_RANGE_MINUTES = 10
+
     private val client = OkHttpClient.Builder()
         .connectTimeout(15, TimeUnit.SECONDS)
         .readTimeout(15, TimeUnit.SECONDS)
@@ -154,7 +161,7 @@ object InfluxRepository {
 
             val fluxQuery = """
                 from(bucket: "$influxBucket")
-                  |> range(start: -${maxDataAge}m)
+                  |> range(start: -${max(maxDataAge, MIN_LATEST_RANGE_MINUTES)}m)
                   |> filter(fn: (r) => r["_measurement"] == "environment")
                   |> filter(fn: (r) => r["_field"] == "pm2_5" or r["_field"] == "pm10" or r["_field"] == "co2" or r["_field"] == "voc" or r["_field"] == "nox")
                   |> last()
@@ -265,10 +272,26 @@ object InfluxRepository {
         }
     }
 
+    // Last value and time of each field of one series in a history response
+    private class Carry {
+        private val values = FloatArray(5) { Float.NaN }
+        private val times = LongArray(5)
+
+        fun forward(field: Int, value: Float, time: Long): Float {
+            if (!value.isNaN()) {
+                values[field] = value
+                times[field] = time
+                return value
+            }
+            return if (time - times[field] <= STALE_FIELD_MS) values[field] else value
+        }
+    }
+
     private fun parseHistoryResponse(csv: String): List<HistoryItem> {
         val items = mutableListOf<HistoryItem>()
         val lines = csv.lines()
         
+        var tableIdx = -1
         var timeIdx = -1
         var pm25Idx = -1
         var pm10Idx = -1
@@ -278,12 +301,14 @@ object InfluxRepository {
 
         val sdf = SimpleDateFormat("yyyy-MM-dd'T'HH:mm:ss", Locale.US)
         sdf.timeZone = TimeZone.getTimeZone("UTC")
+        val carries = mutableMapOf<String, Carry>()
 
         for (line in lines) {
             if (line.isBlank() || line.startsWith("#")) continue
             val cols = line.split(",")
             
             if (cols.contains("_time")) {
+                tableIdx = cols.indexOf("table")
                 timeIdx = cols.indexOf("_time")
                 pm25Idx = cols.indexOf("pm2_5")
                 pm10Idx = cols.indexOf("pm10")
@@ -313,6 +338,14 @@ object InfluxRepository {
                 if (vocIdx != -1 && cols.size > vocIdx) fields.voc = cols[vocIdx].toFloatOrNull() ?: Float.NaN
                 if (noxIdx != -1 && cols.size > noxIdx) fields.nox = cols[noxIdx].toFloatOrNull() ?: Float.NaN
 
+                val table = if (tableIdx != -1 && cols.size > tableIdx) cols[tableIdx] else ""
+                val carry = carries.getOrPut(table) { Carry() }
+                fields.pm25 = carry.forward(0, fields.pm25, time)
+                fields.pm10 = carry.forward(1, fields.pm10, time)
+                fields.co2 = carry.forward(2, fields.co2, time)
+                fields.voc = carry.forward(3, fields.voc, time)
+                fields.nox = carry.forward(4, fields.nox, time)
+
                 items.add(HistoryItem(time, fields))
             }
         }
@@ -10,8 +10,34 @@ const client = new InfluxDB({ url: process.env.INFLUXDB_URL, token: process.env.
 const queryApi = client.getQueryApi(process.env.INFLUXDB_ORG);
 const bucket = process.env.INFLUXDB_BUCKET;
 
+// With REPORT_CHANGE_ONLY (the firmware default) a node writes a field only
+// when it left its deadband or after REPORT_HEARTBEAT_MS, so a steady
+// field's newest point can be a heartbeat old, and fields that moved at
+// different times don't share a _time
+const changeOnly = (process.env.REPORT_CHANGE_ONLY || 'true').toLowerCase() !== 'false';
+const heartbeatMs = parseInt(process.env.REPORT_HEARTBEAT_MS, 10) || 300000;
+// Carry-forward limit: a node that went quiet shows as a gap, not as its
+// last values
+const staleMs = changeOnly ? 2 * heartbeatMs : 5 * 60000;
+const latestRange = `-${Math.max(5, Math.ceil(staleMs / 60000))}m`;
+
 app.use(express.static(path.join(__dirname, 'public')));
 
+// Completes pivoted rows: a field missing at a row's _time takes its
+// previous value in the same series, if that is at most staleMs old
+function fillForward(rows, fields) {
+  const last = {};
+  for (const r of rows) {
+    const t = Date.parse(r._time);
+    const series = last[r.table] || (last[r.table] = {});
+    for (const f of fields) {
+      if (r[f] != null) series[f] = { v: r[f], t };
+      else if (series[f] && t - series[f].t <= staleMs) r[f] = series[f].v;
+    }
+  }
+  return rows;
+}
+
 // ===== IAQ computation helpers (0..100, higher is worse) =====
 function clamp(v, a, b) { return Math.max(a, Math.min(b, v)); }
 function lin(x, x0, x1, y0, y1) {
@@ -214,7 +240,7 @@ function computePMX(series) {
 
 app.get('/api/current', async (req, res) => {
   try {
-    const query = `from(bucket:"${bucket}") |> range(start:-5m) |> filter(fn:(r)=>r._measurement=="environment") |> last()`;
+    const query = `from(bucket:"${bucket}") |> range(start:${latestRange}) |> filter(fn:(r)=>r._measurement=="environment") |> last()`;
     const rows = await queryApi.collectRows(query);
     const result = {};
     rows.forEach(r => { result[r._field] = r._value; });
@@ -273,7 +299,7 @@ app.get('/api/index/history', async (req, res) => {
     }
     flux += ` |> pivot(rowKey:["_time"], columnKey:["_field"], valueColumn:"_value")`;
 
-    const table = await queryApi.collectRows(flux);
+    const table = fillForward(await queryApi.collectRows(flux), baseFields);
     const rows = [];
     for (const r of table) {
       if (needVOC) {
@@ -317,7 +343,7 @@ app.get('/api/pmx/current', async (req, res) => {
 // Current IAQ calculated from latest values
 app.get('/api/iaq/current', async (req, res) => {
   try {
-    const query = `from(bucket:"${bucket}") |> range(start:-5m) |> filter(fn:(r)=>r._measurement=="environment") |> last()`;
+    const query = `from(bucket:"${bucket}") |> range(start:${latestRange}) |> filter(fn:(r)=>r._measurement=="environment") |> last()`;
     const rows = await queryApi.collectRows(query);
     const fields = {};
     rows.forEach(r => { fields[r._field] = r._value; });
@@ -337,7 +363,7 @@ app.get('/api/iaq/current', async (req, res) => {
 // Current indices (0..100): voc_index, co2_index, pm_index
 app.get('/api/index/current', async (req, res) => {
   try {
-    const query = `from(bucket:"${bucket}") |> range(start:-5m) |> filter(fn:(r)=>r._measurement=="environment") |> last()`;
+    const query = `from(bucket:"${bucket}") |> range(start:${latestRange}) |> filter(fn:(r)=>r._measurement=="environment") |> last()`;
     const rows = await queryApi.collectRows(query);
     const fields = {};
     rows.forEach(r => { fields[r._field] = r._value; });
@@ -363,7 +389,7 @@ app.get('/api/iaq/history', async (req, res) => {
     }
     flux += ` |> pivot(rowKey:["_time"], columnKey:["_field"], valueColumn:"_value")`;
 
-    const table = await queryApi.collectRows(flux);
+    const table = fillForward(await queryApi.collectRows(flux), fields);
     const rows = [];
     for (const r of table) {
       const iaq = computeIAQ(r);
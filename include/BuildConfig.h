@@ -0,0 +1,111 @@
+// include/BuildConfig.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+  Layout of the build configuration. scripts/gen_config.py writes one
+  constexpr instance, CONFIG, into include/config.h from .env; the
+  firmware reads its settings from there and checks them with
+  static_assert (see "Configuration checks" in each main.cpp), so a bad
+  value fails the build instead of the device.
+
+  Subsystems that can be left out of the image (WEATHER_ENABLED,
+  OTA_ENABLED, INFLUX_ENABLED, VENTILATION_ENABLED, EXPOSURE_ENABLED,
+  UPLINK_BINARY) stay 0/1 macros next to CONFIG: their code is removed
+  with #if, which a constexpr value cannot do in C++11.
+*/
+
+// One SEN66 of the node (SEN66_SENSORS): on Wire or Wire1, either
+// directly or behind a TCA9548A channel
+struct SensorConfig {
+  const char *tag;   // upload tag value, "" for a single untagged sensor
+  uint8_t bus;       // 0 = Wire, 1 = Wire1
+  int8_t muxChannel; // TCA9548A channel, -1 if directly attached
+};
+
+static constexpr uint8_t CONFIG_MAX_SENSORS = 8;
+static constexpr uint8_t CONFIG_MAX_TLS_CAS = 16;
+
+// An aggregate (no member initializers) so it can be a constant
+struct BuildConfig {
+  // WiFi
+  const char *wifiSsid;
+  const char *wifiPassword;
+
+  // Sampling and reporting
+  uint32_t measurementIntervalMs; // upload interval
+  bool reportChangeOnly;
+  uint32_t reportHeartbeatMs;
+  const char *ntpServer;
+  const char *timezone; // POSIX TZ, for local midnight
+
+  // OTA (ArduinoOTA and delta OTA)
+  const char *otaHostname;
+  const char *otaPassword;
+
+  bool rawCaptureAutostart;
+  bool heapGuardTrap; // abort on an allocation after setup()
+
+  // Sensors
+  uint8_t sensorCount;
+  SensorConfig sensors[CONFIG_MAX_SENSORS];
+
+  // Device / location tags
+  const char *deviceId; // "" = derived at boot
+  bool deviceIdFromSen66;
+  const char *deviceRoom;
+  const char *deviceSite;
+
+  // Lamp
+  const char *lampDevice;
+  bool lampMultiRoom;
+  const char *lampSite;
+  uint32_t lampFreshnessMs; // older data is flagged on the ring and OLED
+
+  // Ventilation detection
+  float ventilationCo2Drop; // ppm
+  uint32_t ventilationWindow; // samples
+  uint32_t fanCleaningCooldownMs;
+  // The boot cleaning is skipped if the last one is more recent (NVS)
+  uint32_t fanCleaningIntervalMs;
+
+  // InfluxDB v2 and the binary uplink bridge
+  const char *influxUrl;
+  const char *influxOrg;
+  const char *influxBucket;
+  const char *influxToken;
+  const char *uplinkBridgeUrl;
+
+  // Root CAs, DER, concatenated
+  const char *tlsCa;
+  uint8_t tlsCaCount;
+  uint16_t tlsCaSizes[CONFIG_MAX_TLS_CAS];
+
+  // Open-Meteo location
+  const char *weatherLatitude;
+  const char *weatherLongitude;
+};
+
+// ===== Checks for static_assert =====
+// Recursive single-return functions, as C++11 constexpr requires
+
+constexpr bool configStartsWith(const char *s, const char *prefix) {
+  return *prefix == '\0' ||
+         (*s == *prefix && configStartsWith(s + 1, prefix + 1));
+}
+
+// http:// or https:// followed by a host
+constexpr bool configIsHttpUrl(const char *s) {
+  return (configStartsWith(s, "http://") && s[7] != '\0') ||
+         (configStartsWith(s, "https://") && s[8] != '\0');
+}
+
+constexpr bool configEndsWithSlash(const char *s) {
+  return *s != '\0' && (s[1] == '\0' ? *s == '/' : configEndsWithSlash(s + 1));
+}
+
+// For buffers sized from CONFIG strings
+constexpr size_t configLength(const char *s) {
+  return *s == '\0' ? 0 : 1 + configLength(s + 1);
+}
@@ -0,0 +1,85 @@
+// lib/Deadband/SwingingDoor.cpp
+#include "SwingingDoor.h"
+
+#include <math.h>
+
+void SwingingDoor::reset() {
+  _hasPivot = false;
+  _hasHeld = false;
+}
+
+float SwingingDoor::tolerance(float value) const {
+  const float rel = _policy.relative * fabsf(value);
+  return rel > _policy.absolute ? rel : _policy.absolute;
+}
+
+// Archives the held sample at the point of the door closest to it; that
+// point is within tolerance of every sample since the pivot.
+ArchivedPoint SwingingDoor::archiveHeld() {
+  const float dt = (float)(uint32_t)(_held.tMs - _pivot.tMs);
+  float slope = (_held.value - _pivot.value) / dt;
+  if (slope < _slopeLo)
+    slope = _slopeLo;
+  if (slope > _slopeHi)
+    slope = _slopeHi;
+  ArchivedPoint p = {_held.tMs, _pivot.value + slope * dt};
+  _pivot = p;
+  _hasHeld = false;
+  return p;
+}
+
+// Opens a door from the pivot through one sample
+void SwingingDoor::restart(uint32_t tMs, float value) {
+  const float dt = (float)(uint32_t)(tMs - _pivot.tMs);
+  const float tol = tolerance(value);
+  _slopeLo = (value - tol - _pivot.value) / dt;
+  _slopeHi = (value + tol - _pivot.value) / dt;
+  _held.tMs = tMs;
+  _held.value = value;
+  _hasHeld = true;
+}
+
+uint8_t SwingingDoor::offer(uint32_t tMs, float value,
+                            ArchivedPoint out[MAX_POINTS]) {
+  uint8_t n = 0;
+  if (isnan(value)) {
+    if (_hasHeld)
+      out[n++] = archiveHeld();
+    reset();
+    return n;
+  }
+  if (!_hasPivot) {
+    _pivot.tMs = tMs;
+    _pivot.value = value;
+    _hasPivot = true;
+    _hasHeld = false;
+    out[n++] = _pivot;
+    return n;
+  }
+  if ((_hasHeld && tMs == _held.tMs) || tMs == _pivot.tMs)
+    return 0;
+
+  if (_hasHeld) {
+    const float dt = (float)(uint32_t)(tMs - _pivot.tMs);
+    const float tol = tolerance(value);
+    const float lo = (value - tol - _pivot.value) / dt;
+    const float hi = (value + tol - _pivot.value) / dt;
+    const float newLo = lo > _slopeLo ? lo : _slopeLo;
+    const float newHi = hi < _slopeHi ? hi : _slopeHi;
+    if (newLo <= newHi) {
+      _slopeLo = newLo;
+      _slopeHi = newHi;
+      _held.tMs = tMs;
+      _held.value = value;
+    } else {
+      out[n++] = archiveHeld();
+      restart(tMs, value);
+    }
+  } else {
+    restart(tMs, value);
+  }
+
+  if (_policy.heartbeatMs && tMs - _pivot.tMs >= _policy.heartbeatMs)
+    out[n++] = archiveHeld();
+  return n;
+}
@@ -0,0 +1,69 @@
+// lib/Deadband/SwingingDoor.h
+#pragma once
+#include <stdint.h>
+
+/*
+  Swinging-door compression of one field with a deadband and heartbeat.
+
+  Samples go in at their acquisition time; only "archived" points come
+  out. Drawing straight lines between archived points reproduces every
+  sample within its tolerance max(absolute, relative * |value|):
+
+  - The first archived point is the pivot. Every later sample narrows the
+    range of slopes from the pivot that stay within tolerance of all
+    samples seen since (the "door").
+  - When a sample would close the door completely, the previous sample is
+    archived (on the door, so the bound holds exactly) and becomes the
+    new pivot.
+  - If nothing was archived for heartbeatMs, the current sample is
+    archived anyway, so readers see the field is alive.
+  - A NaN sample closes the segment at the last valid sample; the next
+    valid sample starts a new one.
+
+  A flat or slowly drifting signal costs one point per heartbeat.
+*/
+struct DeadbandPolicy {
+  float absolute;       // field units
+  float relative;       // fraction of |value|
+  uint32_t heartbeatMs; // 0 = no heartbeat
+};
+
+struct ArchivedPoint {
+  uint32_t tMs;
+  float value;
+};
+
+class SwingingDoor {
+public:
+  static constexpr uint8_t MAX_POINTS = 2;
+
+  SwingingDoor() {}
+  explicit SwingingDoor(const DeadbandPolicy &policy) : _policy(policy) {}
+  void setPolicy(const DeadbandPolicy &policy) {
+    _policy = policy;
+    reset();
+  }
+
+  // Feeds the next sample (tMs increasing, same clock as millis()).
+  // Writes the points to archive, oldest first, and returns their count.
+  // A sample with the same timestamp as the previous one is ignored.
+  uint8_t offer(uint32_t tMs, float value, ArchivedPoint out[MAX_POINTS]);
+  // Forget the segment, e.g. when the field stops being reported
+  void reset();
+
+  const DeadbandPolicy &policy() const { return _policy; }
+
+private:
+  float tolerance(float value) const;
+  ArchivedPoint archiveHeld();
+  void restart(uint32_t tMs, float value);
+
+  DeadbandPolicy _policy = {};
+  bool _hasPivot = false;
+  bool _hasHeld = false;
+  ArchivedPoint _pivot = {};
+  ArchivedPoint _held = {}; // newest sample not yet archived
+  // Door: slopes (units/ms) from the pivot that fit all held samples
+  float _slopeLo = 0.0f;
+  float _slopeHi = 0.0f;
+};
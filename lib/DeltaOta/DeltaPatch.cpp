@@ -0,0 +1,261 @@
+// lib/DeltaOta/DeltaPatch.cpp
+#include "DeltaPatch.h"
+
+#include <string.h>
+
+static const uint8_t MAGIC[4] = {'S', 'D', 'P', '1'};
+static const uint8_t TAG_END = 0x00;
+static const uint8_t TAG_DIFF = 0x01;
+static const uint8_t TAG_INSERT = 0x02;
+
+static uint32_t readU32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+         ((uint32_t)p[3] << 24);
+}
+
+const char *DeltaPatcher::errorName(Error e) {
+  switch (e) {
+  case ERR_NONE:
+    return "ok";
+  case ERR_BAD_HEADER:
+    return "bad header";
+  case ERR_WRONG_BASE:
+    return "patch is for another base image";
+  case ERR_BAD_PATCH:
+    return "malformed patch";
+  case ERR_SOURCE_READ:
+    return "old image read failed";
+  case ERR_SINK:
+    return "new image write failed";
+  case ERR_TRUNCATED:
+    return "patch truncated";
+  case ERR_HASH:
+    return "new image hash mismatch";
+  }
+  return "?";
+}
+
+void DeltaPatcher::begin() {
+  _state = ST_HEADER;
+  _error = ERR_NONE;
+  _headerLen = 0;
+  _oldSize = _newSize = 0;
+  _varint = 0;
+  _varintShift = 0;
+  _oldCursor = 0;
+  _remaining = _run = 0;
+  _oldBufStart = _oldBufLen = 0;
+  _outLen = 0;
+  _written = 0;
+  _sha.reset();
+}
+
+bool DeltaPatcher::fail(Error e) {
+  if (_error == ERR_NONE)
+    _error = e;
+  _state = ST_FAILED;
+  return false;
+}
+
+// Checks the magic and that the old image is the patch's base, then
+// opens the sink.
+bool DeltaPatcher::parseHeader() {
+  if (memcmp(_header, MAGIC, sizeof(MAGIC)) != 0)
+    return fail(ERR_BAD_HEADER);
+  _oldSize = readU32(_header + 4);
+  _newSize = readU32(_header + 8);
+
+  Sha256 sha;
+  for (uint32_t pos = 0; pos < _oldSize; pos += BUFFER_SIZE) {
+    const size_t n =
+        _oldSize - pos < BUFFER_SIZE ? _oldSize - pos : BUFFER_SIZE;
+    if (!_source.read(pos, _oldBuf, n))
+      return fail(ERR_SOURCE_READ);
+    sha.update(_oldBuf, n);
+  }
+  uint8_t digest[Sha256::DIGEST_SIZE];
+  sha.finish(digest);
+  if (memcmp(digest, _header + 12, sizeof(digest)) != 0)
+    return fail(ERR_WRONG_BASE);
+
+  if (!_sink.open(_newSize))
+    return fail(ERR_SINK);
+  _state = ST_TAG;
+  return true;
+}
+
+// Accumulates one LEB128 byte; true once the value is complete
+bool DeltaPatcher::varint(uint8_t byte, uint32_t &out) {
+  if (_varintShift > 28) {
+    fail(ERR_BAD_PATCH);
+    return false;
+  }
+  _varint |= (uint32_t)(byte & 0x7F) << _varintShift;
+  _varintShift += 7;
+  if (byte & 0x80)
+    return false;
+  out = _varint;
+  _varint = 0;
+  _varintShift = 0;
+  return true;
+}
+
+bool DeltaPatcher::readOld(uint32_t offset, uint8_t &out) {
+  if (offset - _oldBufStart >= _oldBufLen) {
+    _oldBufStart = offset;
+    _oldBufLen = _oldSize - offset < BUFFER_SIZE ? _oldSize - offset
+                                                 : (uint32_t)BUFFER_SIZE;
+    if (!_source.read(offset, _oldBuf, _oldBufLen)) {
+      _oldBufLen = 0;
+      return fail(ERR_SOURCE_READ);
+    }
+  }
+  out = _oldBuf[offset - _oldBufStart];
+  return true;
+}
+
+bool DeltaPatcher::flush() {
+  if (_outLen == 0)
+    return true;
+  _sha.update(_outBuf, _outLen);
+  if (!_sink.write(_outBuf, _outLen))
+    return fail(ERR_SINK);
+  _written += _outLen;
+  _outLen = 0;
+  return true;
+}
+
+bool DeltaPatcher::emit(uint8_t byte) {
+  _outBuf[_outLen++] = byte;
+  return _outLen < BUFFER_SIZE || flush();
+}
+
+bool DeltaPatcher::copyOld(uint32_t count) {
+  for (; count; --count) {
+    uint8_t b;
+    if (!readOld(_oldCursor++, b) || !emit(b))
+      return false;
+  }
+  return true;
+}
+
+void DeltaPatcher::endOfDiffGroup() {
+  _state = _remaining ? ST_DIFF_ZEROS : ST_TAG;
+}
+
+bool DeltaPatcher::feed(const uint8_t *data, size_t len) {
+  for (size_t i = 0; i < len; ++i) {
+    const uint8_t b = data[i];
+    uint32_t v;
+    switch (_state) {
+    case ST_HEADER:
+      _header[_headerLen++] = b;
+      if (_headerLen == HEADER_SIZE && !parseHeader())
+        return false;
+      break;
+
+    case ST_TAG:
+      if (b == TAG_DIFF)
+        _state = ST_DIFF_OFFSET;
+      else if (b == TAG_INSERT)
+        _state = ST_INSERT_LENGTH;
+      else if (b == TAG_END)
+        _state = ST_END;
+      else
+        return fail(ERR_BAD_PATCH);
+      break;
+
+    case ST_DIFF_OFFSET:
+      if (varint(b, v)) {
+        const int32_t delta = (int32_t)((v >> 1) ^ (uint32_t)-(int32_t)(v & 1));
+        _oldCursor += (uint32_t)delta;
+        _state = ST_DIFF_LENGTH;
+      }
+      break;
+
+    case ST_DIFF_LENGTH:
+      if (varint(b, v)) {
+        if (_oldCursor > _oldSize || v > _oldSize - _oldCursor ||
+            v > _newSize - written())
+          return fail(ERR_BAD_PATCH);
+        _remaining = v;
+        _state = v ? ST_DIFF_ZEROS : ST_TAG;
+      }
+      break;
+
+    case ST_DIFF_ZEROS:
+      if (varint(b, v)) {
+        if (v > _remaining)
+          return fail(ERR_BAD_PATCH);
+        if (!copyOld(v))
+          return false;
+        _remaining -= v;
+        _state = ST_DIFF_LITERALS;
+      }
+      break;
+
+    case ST_DIFF_LITERALS:
+      if (varint(b, v)) {
+        if (v > _remaining)
+          return fail(ERR_BAD_PATCH);
+        _run = v;
+        if (_run)
+          _state = ST_DIFF_LITERAL_BYTES;
+        else
+          endOfDiffGroup();
+      }
+      break;
+
+    case ST_DIFF_LITERAL_BYTES: {
+      uint8_t old;
+      if (!readOld(_oldCursor++, old) || !emit((uint8_t)(old + b)))
+        return false;
+      _remaining--;
+      if (--_run == 0)
+        endOfDiffGroup();
+      break;
+    }
+
+    case ST_INSERT_LENGTH:
+      if (varint(b, v)) {
+        if (v > _newSize - written())
+          return fail(ERR_BAD_PATCH);
+        _remaining = v;
+        _state = v ? ST_INSERT_BYTES : ST_TAG;
+      }
+      break;
+
+    case ST_INSERT_BYTES:
+      if (!emit(b))
+        return false;
+      if (--_remaining == 0)
+        _state = ST_TAG;
+      break;
+
+    case ST_END:
+      return fail(ERR_BAD_PATCH); // trailing data
+
+    case ST_FAILED:
+      return false;
+    }
+    if (_state == ST_FAILED)
+      return false;
+  }
+  return true;
+}
+
+bool DeltaPatcher::finish() {
+  if (_state == ST_FAILED)
+    return false;
+  if (_state != ST_END)
+    return fail(ERR_TRUNCATED);
+  if (!flush())
+    return false;
+  if (_written != _newSize)
+    return fail(ERR_TRUNCATED);
+  uint8_t digest[Sha256::DIGEST_SIZE];
+  _sha.finish(digest);
+  if (memcmp(digest, _header + 12 + Sha256::DIGEST_SIZE, sizeof(digest)) != 0)
+    return fail(ERR_HASH);
+  return true;
+}
@@ -0,0 +1,133 @@
+// lib/DeltaOta/DeltaPatch.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Sha256.h"
+
+/*
+  Streaming application of firmware delta patches (scripts/ota_delta.py
+  builds them). The patch arrives in chunks of any size; the new image is
+  produced front to back from the old one, so RAM use is two small
+  buffers regardless of image size.
+
+  Patch format (integers little endian, varints unsigned LEB128):
+
+    header  "SDP1", u32 old size, u32 new size,
+            sha256(old image), sha256(new image)
+    records
+      0x01 DIFF    varint zigzag(old offset - old cursor), varint length,
+                   then groups until length is covered:
+                   varint zeros, varint literals, literal bytes
+                   new byte = old byte + literal (mod 256); zeros copy
+                   old bytes unchanged. The old cursor ends after the run.
+      0x02 INSERT  varint length, raw bytes
+      0x00 END
+
+  On the wire everything after the header is a raw deflate stream
+  (32 KiB window); the node inflates it with the ROM tinfl and feeds the
+  records here, so DeltaPatcher only ever sees the form above.
+
+  Moved code mostly differs from its old copy in a few address bytes, so
+  DIFF runs are long zero runs with sparse literals.
+
+  The old image is hashed before anything is written, so a patch built
+  for another base is rejected up front; the new image hash is checked
+  at the end, before the caller switches partitions.
+*/
+
+// Old image, random access (the running app partition)
+class DeltaSource {
+public:
+  virtual ~DeltaSource() {}
+  virtual bool read(uint32_t offset, uint8_t *buf, size_t len) = 0;
+};
+
+// New image, written strictly sequentially (the inactive OTA partition)
+class DeltaSink {
+public:
+  virtual ~DeltaSink() {}
+  // Called once the header is verified, before the first write
+  virtual bool open(uint32_t size) = 0;
+  virtual bool write(const uint8_t *data, size_t len) = 0;
+};
+
+class DeltaPatcher {
+public:
+  enum Error : uint8_t {
+    ERR_NONE,
+    ERR_BAD_HEADER,  // not a patch or unsupported version
+    ERR_WRONG_BASE,  // old image hash differs from the patch's base
+    ERR_BAD_PATCH,   // malformed record or out-of-range copy
+    ERR_SOURCE_READ, // reading the old image failed
+    ERR_SINK,        // opening or writing the new image failed
+    ERR_TRUNCATED,   // finish() before END or size mismatch
+    ERR_HASH,        // new image hash mismatch
+  };
+
+  static constexpr size_t HEADER_SIZE = 4 + 4 + 4 + 2 * Sha256::DIGEST_SIZE;
+  static constexpr size_t BUFFER_SIZE = 256;
+
+  DeltaPatcher(DeltaSource &source, DeltaSink &sink)
+      : _source(source), _sink(sink) {}
+
+  void begin();
+  // Consumes patch bytes; false once an error occurred
+  bool feed(const uint8_t *data, size_t len);
+  // Flushes and checks size and hash; true if the new image is good
+  bool finish();
+
+  Error error() const { return _error; }
+  static const char *errorName(Error e);
+  uint32_t oldSize() const { return _oldSize; }
+  uint32_t newSize() const { return _newSize; }
+  uint32_t written() const { return _written + _outLen; }
+
+private:
+  enum State : uint8_t {
+    ST_HEADER,
+    ST_TAG,
+    ST_DIFF_OFFSET,
+    ST_DIFF_LENGTH,
+    ST_DIFF_ZEROS,
+    ST_DIFF_LITERALS,
+    ST_DIFF_LITERAL_BYTES,
+    ST_INSERT_LENGTH,
+    ST_INSERT_BYTES,
+    ST_END,
+    ST_FAILED,
+  };
+
+  bool fail(Error e);
+  bool parseHeader();
+  bool varint(uint8_t byte, uint32_t &out);
+  bool readOld(uint32_t offset, uint8_t &out);
+  bool copyOld(uint32_t count);
+  bool emit(uint8_t byte);
+  bool flush();
+  void endOfDiffGroup();
+
+  DeltaSource &_source;
+  DeltaSink &_sink;
+  Sha256 _sha;
+
+  State _state = ST_HEADER;
+  Error _error = ERR_NONE;
+  uint8_t _header[HEADER_SIZE];
+  size_t _headerLen = 0;
+  uint32_t _oldSize = 0;
+  uint32_t _newSize = 0;
+
+  uint32_t _varint = 0;
+  uint8_t _varintShift = 0;
+  uint32_t _oldCursor = 0;
+  uint32_t _remaining = 0; // bytes left in the DIFF or INSERT record
+  uint32_t _run = 0;       // literal bytes left in the current group
+
+  uint8_t _oldBuf[BUFFER_SIZE];
+  uint32_t _oldBufStart = 0;
+  uint32_t _oldBufLen = 0;
+  uint8_t _outBuf[BUFFER_SIZE];
+  size_t _outLen = 0;
+  uint32_t _written = 0;
+};
@@ -0,0 +1,128 @@
+// lib/DeltaOta/DeltaStream.h
+#pragma once
+#include <stdlib.h>
+
+#include "DeltaPatch.h"
+
+#if defined(ESP_PLATFORM)
+#include <sdkconfig.h>
+#if CONFIG_IDF_TARGET_ESP32S3
+#include <esp32s3/rom/miniz.h>
+#else
+#include <esp32/rom/miniz.h>
+#endif
+#else
+#include <miniz.h> // host builds bring their own tinfl (test/miniz.h)
+#endif
+
+/*
+  A patch as it arrives over the wire (see DeltaPatch.h): the header
+  goes to the patcher as it is, the deflated records through tinfl with
+  a 32 KiB window. Upload chunks can have any size.
+
+  Header-only, so only the builds that include it need a tinfl: the
+  ROM's on the node, test/miniz.h on the host.
+*/
+class DeltaStream {
+public:
+  explicit DeltaStream(DeltaPatcher &patcher) : _patcher(patcher) {}
+  ~DeltaStream() { release(); }
+
+  // Allocates the inflater and its window and starts the patcher; false
+  // if out of memory
+  bool begin() {
+    release();
+    _error = nullptr;
+    _headerLen = 0;
+    _windowPos = 0;
+    _inflated = false;
+    _inflator = (tinfl_decompressor *)malloc(sizeof(tinfl_decompressor));
+    _window = (uint8_t *)malloc(TINFL_LZ_DICT_SIZE);
+    if (!_inflator || !_window) {
+      release();
+      _error = "out of memory";
+      return false;
+    }
+    tinfl_init(_inflator);
+    _patcher.begin();
+    return true;
+  }
+
+  // Consumes upload bytes; false on error (see error())
+  bool feed(const uint8_t *data, size_t len) {
+    if (!_inflator)
+      return fail("not started");
+    if (_headerLen < DeltaPatcher::HEADER_SIZE) {
+      size_t n = DeltaPatcher::HEADER_SIZE - _headerLen;
+      if (n > len)
+        n = len;
+      if (!_patcher.feed(data, n))
+        return false;
+      _headerLen += n;
+      data += n;
+      len -= n;
+    }
+    while (!_inflated) {
+      size_t in = len;
+      size_t out = TINFL_LZ_DICT_SIZE - _windowPos;
+      const tinfl_status status =
+          tinfl_decompress(_inflator, data, &in, _window, _window + _windowPos,
+                           &out, TINFL_FLAG_HAS_MORE_INPUT);
+      data += in;
+      len -= in;
+      if (out && !_patcher.feed(_window + _windowPos, out))
+        return false;
+      _windowPos = (_windowPos + out) & (TINFL_LZ_DICT_SIZE - 1);
+      if (status < TINFL_STATUS_DONE)
+        return fail("malformed patch");
+      _inflated = status == TINFL_STATUS_DONE;
+      // Output still pending (HAS_MORE_OUTPUT) is drained before returning
+      if (status == TINFL_STATUS_NEEDS_MORE_INPUT && len == 0)
+        break;
+    }
+    if (_inflated && len > 0)
+      return fail("malformed patch"); // data after the deflate stream
+    return true;
+  }
+
+  // End of the upload: the deflate stream must be complete and the new
+  // image good. Frees the inflater either way.
+  bool finish() {
+    if (!error() && !_inflated)
+      fail("patch truncated");
+    const bool ok = !error() && _patcher.finish();
+    release();
+    return ok;
+  }
+
+  void release() {
+    free(_inflator);
+    free(_window);
+    _inflator = nullptr;
+    _window = nullptr;
+  }
+
+  // What went wrong, nullptr if nothing did
+  const char *error() const {
+    if (_error)
+      return _error;
+    if (_patcher.error() != DeltaPatcher::ERR_NONE)
+      return DeltaPatcher::errorName(_patcher.error());
+    return nullptr;
+  }
+
+private:
+  bool fail(const char *error) {
+    if (!_error)
+      _error = error;
+    return false;
+  }
+
+  DeltaPatcher &_patcher;
+  tinfl_decompressor *_inflator = nullptr;
+  uint8_t *_window = nullptr; // TINFL_LZ_DICT_SIZE
+  size_t _windowPos = 0;
+  size_t _headerLen = 0;
+  bool _inflated = false;
+  const char *_error = nullptr;
+};
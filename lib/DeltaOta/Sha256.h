@@ -0,0 +1,24 @@
+// lib/DeltaOta/Sha256.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Incremental SHA-256 (FIPS 180-4), portable so patches verify the same
+// way on the device and on the host.
+class Sha256 {
+public:
+  static constexpr size_t DIGEST_SIZE = 32;
+
+  Sha256() { reset(); }
+  void reset();
+  void update(const uint8_t *data, size_t len);
+  void finish(uint8_t digest[DIGEST_SIZE]);
+
+private:
+  void block(const uint8_t *p);
+
+  uint32_t _h[8];
+  uint8_t _buf[64];
+  uint64_t _total;
+  uint8_t _used;
+};
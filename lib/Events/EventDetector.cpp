@@ -0,0 +1,210 @@
+// lib/Events/EventDetector.cpp
+#include "EventDetector.h"
+
+#include <math.h>
+
+namespace Events {
+
+// Baseline weight while an event (or a CUSUM excursion) is in progress:
+// slow enough that the event does not raise its own baseline, fast
+// enough that a lasting step is absorbed instead of never ending.
+static constexpr float EVENT_BASELINE_SLOWDOWN = 1.0f / 16.0f;
+
+void Detector::configure(Kind kind, const Params &params) {
+  _kind = kind;
+  _params = params;
+  reset();
+}
+
+void Detector::reset() {
+  _event = Event();
+  _primed = false;
+  _s = 0.0f;
+  _quiet = 0;
+  _age = 0;
+}
+
+Change Detector::update(uint32_t tMs, float x) {
+  if (!_params.enabled || isnan(x))
+    return CHANGE_NONE;
+  if (!_primed) {
+    _primed = true;
+    _a = _b = _ref = x;
+    _sampleMs = 0.0f;
+    _lastMs = _onsetMs = tMs;
+    return CHANGE_NONE;
+  }
+  switch (_kind) {
+  case KIND_LEVEL_RISE:
+    return updateLevelRise(tMs, x);
+  case KIND_SLOPE_RISE:
+    return updateSlopeRise(tMs, x);
+  case KIND_PEAK_DROP:
+    return updatePeakDrop(tMs, x);
+  }
+  return CHANGE_NONE;
+}
+
+Change Detector::start(uint32_t startMs, float magnitude) {
+  _event.active = true;
+  _event.startMs = startMs;
+  _event.endMs = 0;
+  _event.magnitude = magnitude;
+  _quiet = 0;
+  return CHANGE_STARTED;
+}
+
+bool Detector::quiet(uint32_t tMs, bool isQuiet) {
+  if (!isQuiet) {
+    _quiet = 0;
+    return false;
+  }
+  if (_quiet == 0)
+    _quietMs = tMs;
+  if (++_quiet < _params.hold)
+    return false;
+  _event.active = false;
+  _event.endMs = _quietMs;
+  _quiet = 0;
+  _s = 0.0f;
+  return true;
+}
+
+Change Detector::updateLevelRise(uint32_t tMs, float x) {
+  const float dev = x - _a;
+  Change change = CHANGE_NONE;
+  if (_event.active) {
+    if (dev > _event.magnitude)
+      _event.magnitude = dev;
+    if (quiet(tMs, dev < _params.k))
+      change = CHANGE_ENDED;
+  } else {
+    if (_s == 0.0f)
+      _onsetMs = tMs;
+    _s += dev - _params.k;
+    if (_s < 0.0f)
+      _s = 0.0f;
+    if (_s > _params.h)
+      change = start(_onsetMs, dev);
+  }
+  const bool calm = !_event.active && _s == 0.0f;
+  _a += (calm ? _params.alpha : _params.alpha * EVENT_BASELINE_SLOWDOWN) * dev;
+  return change;
+}
+
+Change Detector::updateSlopeRise(uint32_t tMs, float x) {
+  const float alpha = _params.alpha;
+  _a += alpha * (x - _a);
+  _b += alpha * (_a - _b);
+  const uint32_t dtMs = tMs - _lastMs;
+  _lastMs = tMs;
+  if (dtMs == 0)
+    return CHANGE_NONE;
+  _sampleMs = _sampleMs == 0.0f ? (float)dtMs
+                                : _sampleMs + 0.1f * ((float)dtMs - _sampleMs);
+  // Brown's trend estimate, units per sample, scaled to per minute
+  const float rate =
+      alpha / (1.0f - alpha) * (_a - _b) * (60000.0f / _sampleMs);
+  // Until the smoothers settled (about 2 / alpha samples) the trend is
+  // mostly start-up transient
+  if (_age < 2.0f / alpha) {
+    _age++;
+    return CHANGE_NONE;
+  }
+
+  if (_event.active) {
+    const float rise = _a - _ref;
+    if (rise > _event.magnitude)
+      _event.magnitude = rise;
+    return quiet(tMs, rate < _params.k) ? CHANGE_ENDED : CHANGE_NONE;
+  }
+  if (_s == 0.0f) {
+    _onsetMs = tMs;
+    _ref = _a;
+  }
+  _s += rate - _params.k;
+  if (_s < 0.0f)
+    _s = 0.0f;
+  if (_s <= _params.h)
+    return CHANGE_NONE;
+  // The trend lags the onset by about (1 - alpha) / alpha samples
+  const uint32_t lagMs = (uint32_t)((1.0f - alpha) / alpha * _sampleMs);
+  return start(_onsetMs - lagMs, _a - _ref);
+}
+
+Change Detector::updatePeakDrop(uint32_t tMs, float x) {
+  if (_event.active) {
+    if (x < _b) {
+      _b = x;
+      _age = 0;
+      _quietMs = tMs;
+      _event.magnitude = _a - x;
+    } else {
+      _age++;
+    }
+    if (x - _b <= _params.k && _age < _params.hold)
+      return CHANGE_NONE;
+    _event.active = false;
+    _event.endMs = _quietMs;
+    _a = x;
+    _onsetMs = tMs;
+    _age = 0;
+    return CHANGE_ENDED;
+  }
+
+  if (x > _a) {
+    _a = x;
+    _onsetMs = tMs;
+    _age = 0;
+  } else if (++_age >= _params.window) {
+    // Peak no longer recent
+    _a = x;
+    _onsetMs = tMs;
+    _age = 0;
+  }
+  if (_a - x < _params.h)
+    return CHANGE_NONE;
+  _b = x;
+  _age = 0;
+  _quietMs = tMs;
+  return start(_onsetMs, _a - x);
+}
+
+bool Pipeline::add(const Config &config) {
+  if (_count >= MAX_DETECTORS)
+    return false;
+  _configs[_count] = config;
+  _detectors[_count].configure(config.kind, config.params);
+  _changes[_count] = CHANGE_NONE;
+  _count++;
+  return true;
+}
+
+void Pipeline::setParams(uint8_t i, const Params &params) {
+  _configs[i].params = params;
+  _detectors[i].configure(_configs[i].kind, params);
+}
+
+uint32_t Pipeline::update(uint32_t tMs, const float *values) {
+  uint32_t changed = 0;
+  for (uint8_t i = 0; i < _count; ++i) {
+    _changes[i] = _detectors[i].update(tMs, values[_configs[i].signal]);
+    if (_changes[i] != CHANGE_NONE)
+      changed |= 1u << i;
+  }
+  return changed;
+}
+
+const char *kindName(Kind kind) {
+  switch (kind) {
+  case KIND_LEVEL_RISE:
+    return "level_rise";
+  case KIND_SLOPE_RISE:
+    return "slope_rise";
+  case KIND_PEAK_DROP:
+    return "peak_drop";
+  }
+  return "?";
+}
+
+} // namespace Events
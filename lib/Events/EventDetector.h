@@ -0,0 +1,134 @@
+// lib/Events/EventDetector.h
+#pragma once
+#include <stdint.h>
+
+/*
+  Streaming event detectors over one signal each, O(1) state and work per
+  sample (no sample windows), for air-quality events like cooking, room
+  occupancy or ventilation.
+
+  Kinds:
+
+  - KIND_LEVEL_RISE  (spikes: cooking PM, VOC bursts)
+      baseline b = EWMA(x, alpha) while quiet, 16x slower during an event
+      CUSUM      S = max(0, S + (x - b) - k), starts when S > h
+      ends       after `hold` samples with x - b < k
+      magnitude  highest x - b
+  - KIND_SLOPE_RISE  (onsets: occupancy from the CO2 rise rate)
+      trend r    Brown's double EWMA slope of x, in units per minute,
+                 used after a warm-up of 2 / alpha samples
+      CUSUM      S = max(0, S + r - k), starts when S > h
+      ends       after `hold` samples with r < k
+      magnitude  rise of the smoothed level over the event
+  - KIND_PEAK_DROP  (ventilation: CO2 falling from its recent peak)
+      peak       highest x, forgotten after `window` samples without a
+                 new one
+      starts     when peak - x >= h
+      ends       when x rebounds k above the lowest value, or after
+                 `hold` samples without a new lowest value
+      magnitude  peak - lowest value
+
+  The start time of a CUSUM event is the last sample where S left zero
+  (the change-point estimate), for KIND_SLOPE_RISE moved back by the
+  smoother's lag; for KIND_PEAK_DROP it is the time of the peak. The end
+  time is the first sample of the quiet run that ended the event.
+
+  NaN samples are skipped. Times are millis() of the samples.
+*/
+
+namespace Events {
+
+enum Kind : uint8_t { KIND_LEVEL_RISE, KIND_SLOPE_RISE, KIND_PEAK_DROP };
+
+// Stored as an NVS blob by the node, so the layout is fixed
+struct Params {
+  float alpha;     // EWMA weight per sample (unused by KIND_PEAK_DROP)
+  float k;         // slack, signal units (per minute for KIND_SLOPE_RISE)
+  float h;         // decision threshold: CUSUM sum, or drop for PEAK_DROP
+  uint16_t hold;   // samples of quiet that end an event
+  uint16_t window; // KIND_PEAK_DROP: samples a peak stays the reference
+  uint8_t enabled;
+  uint8_t reserved[3];
+};
+static_assert(sizeof(Params) == 20, "Events::Params layout is fixed");
+
+struct Config {
+  const char *type; // event type tag, e.g. "cooking" (at most 15 chars)
+  uint8_t signal;   // index into the values passed to Pipeline::update()
+  Kind kind;
+  Params params;
+};
+
+struct Event {
+  uint32_t startMs;
+  uint32_t endMs; // valid once !active
+  float magnitude;
+  bool active;
+};
+
+enum Change : uint8_t { CHANGE_NONE, CHANGE_STARTED, CHANGE_ENDED };
+
+class Detector {
+public:
+  // Restarts from scratch with the new settings
+  void configure(Kind kind, const Params &params);
+  Change update(uint32_t tMs, float x);
+  void reset();
+
+  const Event &event() const { return _event; }
+  Kind kind() const { return _kind; }
+  const Params &params() const { return _params; }
+
+private:
+  Change updateLevelRise(uint32_t tMs, float x);
+  Change updateSlopeRise(uint32_t tMs, float x);
+  Change updatePeakDrop(uint32_t tMs, float x);
+  Change start(uint32_t startMs, float magnitude);
+  // Counts a quiet sample during an event; true once `hold` are in a row
+  bool quiet(uint32_t tMs, bool isQuiet);
+
+  Kind _kind = KIND_LEVEL_RISE;
+  Params _params = {};
+  Event _event = {};
+  bool _primed = false;
+  float _a = 0.0f;        // baseline / smoothed level / peak
+  float _b = 0.0f;        // second EWMA / lowest value in a drop
+  float _s = 0.0f;        // CUSUM
+  float _ref = 0.0f;      // level at the onset (slope rise)
+  float _sampleMs = 0.0f; // EWMA of the sample interval (slope rise)
+  uint32_t _lastMs = 0;
+  uint32_t _onsetMs = 0;  // where S left zero / time of the peak
+  uint32_t _quietMs = 0;
+  uint16_t _quiet = 0;
+  uint16_t _age = 0;      // samples since the peak / the lowest value /
+                          // warm-up samples (slope rise)
+};
+
+// The detectors of one sensor. update() feeds each detector its signal
+// and returns a bit per detector whose event started or ended.
+class Pipeline {
+public:
+  static constexpr uint8_t MAX_DETECTORS = 8;
+
+  // False if full; disabled detectors are kept but never fire
+  bool add(const Config &config);
+  uint32_t update(uint32_t tMs, const float *values);
+  // Replaces detector i's settings and restarts it
+  void setParams(uint8_t i, const Params &params);
+
+  uint8_t size() const { return _count; }
+  const Config &config(uint8_t i) const { return _configs[i]; }
+  const Detector &detector(uint8_t i) const { return _detectors[i]; }
+  // Last change of detector i (valid for the bits update() returned)
+  Change change(uint8_t i) const { return _changes[i]; }
+
+private:
+  Config _configs[MAX_DETECTORS];
+  Detector _detectors[MAX_DETECTORS];
+  Change _changes[MAX_DETECTORS] = {};
+  uint8_t _count = 0;
+};
+
+const char *kindName(Kind kind);
+
+} // namespace Events
@@ -0,0 +1,103 @@
+// lib/Exposure/ExposureDose.cpp
+#include "ExposureDose.h"
+
+#include <math.h>
+
+namespace Exposure {
+
+static constexpr float MS_PER_HOUR = 3600000.0f;
+static constexpr uint32_t MS_PER_MINUTE = 60000;
+
+void Totals::add(const Totals &o) {
+  pm25Dose += o.pm25Dose;
+  co2Excess += o.co2Excess;
+  pm25OverH += o.pm25OverH;
+  pm10OverH += o.pm10OverH;
+  coveredH += o.coveredH;
+}
+
+// Area of max(0, x - limit) for x linear from a to b over hours, and the
+// time x spends above the limit
+static void above(float a, float b, float limit, float hours, float &area,
+                  float &time) {
+  const float ea = a - limit;
+  const float eb = b - limit;
+  if (ea <= 0.0f && eb <= 0.0f) {
+    area = 0.0f;
+    time = 0.0f;
+  } else if (ea >= 0.0f && eb >= 0.0f) {
+    area = 0.5f * (ea + eb) * hours;
+    time = hours;
+  } else {
+    // Crosses the limit: only the triangle above it counts
+    const float hi = ea > 0.0f ? ea : eb;
+    const float lo = ea > 0.0f ? eb : ea;
+    time = hours * hi / (hi - lo);
+    area = 0.5f * hi * time;
+  }
+}
+
+// Moves the running minute up to the one holding tMs, clearing the
+// buckets it passes and closing the day's share of each
+void Accumulator::advance(uint32_t tMs) {
+  if (!_started) {
+    _started = true;
+    _bucketStartMs = tMs;
+    return;
+  }
+  const uint32_t minutes = (tMs - _bucketStartMs) / MS_PER_MINUTE;
+  if (minutes == 0)
+    return;
+  _day.add(_partial);
+  _partial = Totals();
+  const uint32_t clear = minutes < HOUR_BUCKETS ? minutes : HOUR_BUCKETS;
+  for (uint32_t i = 0; i < clear; ++i) {
+    _bucket = (uint8_t)((_bucket + 1) % HOUR_BUCKETS);
+    _minutes[_bucket] = Totals();
+  }
+  _bucketStartMs += minutes * MS_PER_MINUTE;
+}
+
+void Accumulator::add(uint32_t tMs, float pm25, float pm10, float co2) {
+  advance(tMs);
+  const bool valid = !isnan(pm25) && !isnan(pm10) && !isnan(co2);
+  if (_primed && valid && tMs - _lastMs <= MAX_GAP_MS && tMs != _lastMs) {
+    const float hours = (tMs - _lastMs) / MS_PER_HOUR;
+    Totals t;
+    t.pm25Dose = 0.5f * (_pm25 + pm25) * hours;
+    float ignored;
+    above(_co2, co2, CO2_LIMIT, hours, t.co2Excess, ignored);
+    above(_pm25, pm25, WHO_PM2_5, hours, ignored, t.pm25OverH);
+    above(_pm10, pm10, WHO_PM10, hours, ignored, t.pm10OverH);
+    t.coveredH = hours;
+    _minutes[_bucket].add(t);
+    _partial.add(t);
+  }
+  _primed = valid;
+  _lastMs = tMs;
+  _pm25 = pm25;
+  _pm10 = pm10;
+  _co2 = co2;
+}
+
+void Accumulator::newDay() {
+  _day = Totals();
+  _partial = Totals();
+}
+
+void Accumulator::restoreDay(const Totals &t) { _day.add(t); }
+
+Totals Accumulator::day() const {
+  Totals t = _day;
+  t.add(_partial);
+  return t;
+}
+
+Totals Accumulator::hour() const {
+  Totals t = {};
+  for (uint8_t i = 0; i < HOUR_BUCKETS; ++i)
+    t.add(_minutes[i]);
+  return t;
+}
+
+} // namespace Exposure
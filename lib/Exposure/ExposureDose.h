@@ -0,0 +1,74 @@
+// lib/Exposure/ExposureDose.h
+#pragma once
+#include <stdint.h>
+
+/*
+  Cumulative exposure of one sensor, integrated sample by sample instead
+  of over long query ranges:
+
+    pm2_5 dose      integral of PM2.5 dt, ug*h/m3
+    co2 excess      integral of max(0, CO2 - 1000 ppm) dt, ppm*h
+    over WHO        hours with PM2.5 above 15 ug/m3 / PM10 above
+                    45 ug/m3 (WHO 2021 24-hour guideline levels)
+    covered         hours actually integrated
+
+  Each interval between two samples is integrated as a trapezoid (the
+  signal linear in between), thresholds at the interpolated crossing.
+  An interval longer than MAX_GAP_MS, or with a NaN at either end, is a
+  gap: it is left out, and shows up as covered hours short of the clock.
+
+  The day runs until newDay(); the rolling hour is kept in minute buckets
+  and is exact to the minute. O(1) work per sample, no allocation. Times
+  are millis() of the samples.
+*/
+
+namespace Exposure {
+
+static constexpr float WHO_PM2_5 = 15.0f;   // ug/m3, 24-hour guideline
+static constexpr float WHO_PM10 = 45.0f;    // ug/m3, 24-hour guideline
+static constexpr float CO2_LIMIT = 1000.0f; // ppm
+// Samples further apart are not integrated across (fan cleaning, restarts)
+static constexpr uint32_t MAX_GAP_MS = 10000;
+
+struct Totals {
+  float pm25Dose;  // ug*h/m3
+  float co2Excess; // ppm*h
+  float pm25OverH; // h
+  float pm10OverH; // h
+  float coveredH;  // h
+
+  void add(const Totals &o);
+};
+
+class Accumulator {
+public:
+  static constexpr uint8_t HOUR_BUCKETS = 60;
+
+  // Integrates the interval since the previous sample
+  void add(uint32_t tMs, float pm25, float pm10, float co2);
+  // Ends the day: what follows counts toward a new one
+  void newDay();
+  // Adds a day's totals from before a reboot to the current day
+  void restoreDay(const Totals &t);
+
+  Totals day() const;
+  // The last 60 minutes, at minute resolution
+  Totals hour() const;
+
+private:
+  void advance(uint32_t tMs);
+
+  Totals _day = {};     // minutes closed so far today
+  Totals _partial = {}; // today's share of the running minute
+  Totals _minutes[HOUR_BUCKETS] = {};
+  uint8_t _bucket = 0;        // the running minute
+  uint32_t _bucketStartMs = 0;
+  bool _started = false;      // _bucketStartMs is set
+  bool _primed = false;       // the previous sample is valid
+  uint32_t _lastMs = 0;
+  float _pm25 = 0.0f;
+  float _pm10 = 0.0f;
+  float _co2 = 0.0f;
+};
+
+} // namespace Exposure
@@ -0,0 +1,220 @@
+// lib/FrameColumns/ColumnFile.cpp
+#include "ColumnFile.h"
+
+#include <string.h>
+
+namespace FrameColumns {
+
+using namespace Sen66Protocol;
+
+// Records decoded per pass: their words (14 x 512 x 2 bytes) stay in L1
+static const size_t BLOCK_ROWS = 512;
+
+static const uint16_t NUMBER_MASK = ((1u << NUMBER_TRIPLETS) - 1)
+                                    << MEASURED_TRIPLETS;
+static const char *const NUMBER_NAMES[NUMBER_TRIPLETS] = {
+    "nc0_5", "nc1_0", "nc2_5", "nc4_0", "nc10"};
+
+static uint64_t align64(uint64_t n) { return (n + 63) & ~(uint64_t)63; }
+
+static size_t typeSize(uint8_t type) {
+  switch (type) {
+  case COLUMN_INT64:
+    return 8;
+  case COLUMN_FLOAT32:
+  case COLUMN_UINT32:
+    return 4;
+  default:
+    return 1;
+  }
+}
+
+// The environment line's field names
+static const char *wordName(Word w) {
+  switch (w) {
+  case W_PM1_0:
+    return "pm1_0";
+  case W_PM2_5:
+    return "pm2_5";
+  case W_PM4_0:
+    return "pm4_0";
+  case W_PM10_0:
+    return "pm10";
+  case W_HUMIDITY:
+    return "humidity";
+  case W_TEMPERATURE:
+    return "temperature";
+  case W_VOC:
+    return "voc";
+  case W_NOX:
+    return "nox";
+  case W_CO2:
+    return "co2";
+  case W_HCHO:
+    return "hcho";
+  default:
+    return "?";
+  }
+}
+
+// ===== Layout =====
+
+struct WordInfo {
+  Word word;
+  bool isSigned;
+  uint16_t scale;
+};
+
+template <typename Words> struct WordInfos;
+
+template <Word... Ws> struct WordInfos<WordList<Ws...>> {
+  static uint8_t fill(WordInfo *out) {
+    const WordInfo all[] = {{Ws, WordCodec<Ws>::SIGNED, WordCodec<Ws>::SCALE}...};
+    memcpy(out, all, sizeof(all));
+    return sizeof...(Ws);
+  }
+};
+
+template <Model M> static uint8_t measuredInfos(WordInfo *out) {
+  return WordInfos<typename ModelTraits<M>::MeasuredWords>::fill(out);
+}
+
+static uint8_t measuredInfos(Model model, WordInfo *out) {
+  switch (model) {
+  case SEN63C:
+    return measuredInfos<SEN63C>(out);
+  case SEN65:
+    return measuredInfos<SEN65>(out);
+  case SEN68:
+    return measuredInfos<SEN68>(out);
+  default:
+    return measuredInfos<SEN66>(out);
+  }
+}
+
+ColumnLayout::ColumnLayout(Model model, uint64_t rows)
+    : _model(model), _rows(rows) {
+  memset(_columns, 0, sizeof(_columns));
+  const char *fixed[3] = {"epoch_ms", "mono_ms", "sensor"};
+  const uint8_t fixedTypes[3] = {COLUMN_INT64, COLUMN_UINT32, COLUMN_UINT8};
+  for (uint8_t i = 0; i < 3; ++i) {
+    strncpy(_columns[_count].name, fixed[i], sizeof(_columns[0].name));
+    _columns[_count++].type = fixedTypes[i];
+  }
+
+  WordInfo words[MEASURED_TRIPLETS];
+  const uint8_t n = measuredInfos(model, words);
+  _measuredMask = (uint16_t)((1u << n) - 1);
+  for (uint8_t t = 0; t < n + NUMBER_TRIPLETS; ++t) {
+    const bool measured = t < n;
+    ColumnEntry &c = _columns[_count];
+    strncpy(c.name, measured ? wordName(words[t].word) : NUMBER_NAMES[t - n],
+            sizeof(c.name));
+    c.type = COLUMN_FLOAT32;
+    Value &v = _values[_valueCount++];
+    v.column = _count++;
+    v.triplet = measured ? t : (uint8_t)(MEASURED_TRIPLETS + t - n);
+    v.isSigned = measured && words[t].isSigned;
+    v.scale = measured ? (float)words[t].scale : 10.0f;
+  }
+
+  uint64_t at = align64(sizeof(ColumnFileHeader) + _count * sizeof(ColumnEntry));
+  for (uint8_t i = 0; i < _count; ++i) {
+    _columns[i].dataOffset = at;
+    at = align64(at + rows * typeSize(_columns[i].type));
+    if (_columns[i].type == COLUMN_FLOAT32) {
+      _columns[i].validOffset = at;
+      at = align64(at + (rows + 7) / 8);
+    }
+  }
+  _fileSize = at;
+}
+
+void ColumnLayout::writeHeader(uint8_t *file) const {
+  ColumnFileHeader h;
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, "S6CL", 4);
+  h.version = COLUMN_FILE_VERSION;
+  h.columnCount = _count;
+  h.rows = _rows;
+  h.model = _model;
+  memcpy(file, &h, sizeof(h));
+  memcpy(file + sizeof(h), _columns, _count * sizeof(ColumnEntry));
+}
+
+// ===== Decoding =====
+
+void DecodeStats::add(const DecodeStats &o) {
+  rows += o.rows;
+  measuredCrcErrors += o.measuredCrcErrors;
+  numberCrcErrors += o.numberCrcErrors;
+  numbersMissing += o.numbersMissing;
+}
+
+void decodeRows(Kernel k, const ColumnLayout &layout, const Record *records,
+                uint64_t first, size_t count, uint8_t *file,
+                DecodeStats &stats) {
+  uint16_t words[RECORD_TRIPLETS * BLOCK_ROWS];
+  uint16_t crcOk[BLOCK_ROWS];
+  uint8_t measuredOk[BLOCK_ROWS];
+  uint8_t numbersOk[BLOCK_ROWS];
+  const uint16_t measuredMask = layout._measuredMask;
+
+  int64_t *epochMs = (int64_t *)(file + layout.column(0).dataOffset);
+  uint32_t *monoMs = (uint32_t *)(file + layout.column(1).dataOffset);
+  uint8_t *sensor = file + layout.column(2).dataOffset;
+
+  for (size_t done = 0; done < count; done += BLOCK_ROWS) {
+    const size_t n = count - done < BLOCK_ROWS ? count - done : BLOCK_ROWS;
+    const Record *block = records + done;
+    const uint64_t row = first + done;
+    extractWords(k, block, n, words, BLOCK_ROWS, crcOk);
+
+    for (size_t i = 0; i < n; ++i) {
+      const Record &r = block[i];
+      epochMs[row + i] = r.epochMs;
+      monoMs[row + i] = r.monoMs;
+      sensor[row + i] = r.sensor;
+      measuredOk[i] = (crcOk[i] & measuredMask) == measuredMask;
+      const bool hasNumbers = r.flags & FRAME_HAS_NUMBERS;
+      numbersOk[i] = hasNumbers && (crcOk[i] & NUMBER_MASK) == NUMBER_MASK;
+      stats.measuredCrcErrors += !measuredOk[i];
+      stats.numberCrcErrors += hasNumbers && !numbersOk[i];
+      stats.numbersMissing += !hasNumbers;
+    }
+
+    for (uint8_t c = 0; c < layout._valueCount; ++c) {
+      const ColumnLayout::Value &v = layout._values[c];
+      const ColumnEntry &e = layout.column(v.column);
+      scaleWords(k, words + v.triplet * BLOCK_ROWS,
+                 v.triplet < MEASURED_TRIPLETS ? measuredOk : numbersOk, n,
+                 v.isSigned, v.scale, (float *)(file + e.dataOffset) + row,
+                 file + e.validOffset + row / 8);
+    }
+  }
+  stats.rows += count;
+}
+
+bool checkColumnFile(const uint8_t *file, uint64_t size, const char *&error) {
+  ColumnFileHeader h;
+  if (size < sizeof(h)) {
+    error = "file too short";
+    return false;
+  }
+  memcpy(&h, file, sizeof(h));
+  if (memcmp(h.magic, "S6CL", 4) != 0) {
+    error = "not a column file";
+    return false;
+  }
+  if (h.version != COLUMN_FILE_VERSION || h.columnCount > MAX_COLUMNS) {
+    error = "unsupported column file version";
+    return false;
+  }
+  if (size < sizeof(h) + h.columnCount * sizeof(ColumnEntry)) {
+    error = "truncated directory";
+    return false;
+  }
+  return true;
+}
+
+} // namespace FrameColumns
@@ -0,0 +1,137 @@
+// lib/FrameColumns/ColumnFile.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FrameBatch.h"
+#include "FrameLog.h"
+
+/*
+  Columnar export of a frame log ("S6CL"): one array per field, so an
+  analysis touches only the columns it needs and maps each one straight
+  into numpy, pandas or Arrow without parsing.
+
+  File layout (little-endian):
+
+    offset  size  header (32 bytes)
+         0     4  magic "S6CL"
+         4     2  uint16  version (1)
+         6     2  uint16  column count
+         8     8  uint64  row count (one per frame log record)
+        16     1  uint8   model
+        17    15  reserved, 0
+
+    then a directory entry per column (48 bytes each):
+         0    16  name, NUL-padded
+        16     1  uint8   type, ColumnType
+        17     7  reserved
+        24     8  uint64  data offset
+        32     8  uint64  validity offset, 0 = always valid
+        40     8  reserved
+
+  Arrays start on 64-byte boundaries. Validity is a bitmap as in Arrow:
+  bit r % 8 of byte r / 8 for row r (numpy.unpackbits(..., bitorder=
+  'little')). A value is valid when every CRC of its frame matched and
+  the sensor did not send its "not available" marker; invalid values are
+  NaN. The values are bit-identical to Sen66Protocol's decoders.
+
+  Columns: epoch_ms (int64), mono_ms (uint32), sensor (uint8), then the
+  model's measured values in frame order and the five number
+  concentrations (float32), named like the environment line's fields.
+*/
+
+namespace FrameColumns {
+
+enum ColumnType : uint8_t {
+  COLUMN_FLOAT32,
+  COLUMN_INT64,
+  COLUMN_UINT32,
+  COLUMN_UINT8,
+};
+
+struct ColumnFileHeader {
+  char magic[4];
+  uint16_t version;
+  uint16_t columnCount;
+  uint64_t rows;
+  uint8_t model;
+  uint8_t reserved[15];
+};
+
+struct ColumnEntry {
+  char name[16];
+  uint8_t type;
+  uint8_t reserved[7];
+  uint64_t dataOffset;
+  uint64_t validOffset;
+  uint64_t reserved2;
+};
+
+static_assert(sizeof(ColumnFileHeader) == 32,
+              "FrameColumns::ColumnFileHeader layout is fixed");
+static_assert(sizeof(ColumnEntry) == 48,
+              "FrameColumns::ColumnEntry layout is fixed");
+
+constexpr uint16_t COLUMN_FILE_VERSION = 1;
+constexpr uint8_t MAX_COLUMNS = 3 + RECORD_TRIPLETS;
+
+// decodeRows() ranges that start on a multiple of this share no bytes
+// of the file (validity bytes, cache lines), so threads can fill one
+// file side by side
+constexpr uint64_t ROW_ALIGN = 64;
+
+struct DecodeStats {
+  uint64_t rows = 0;
+  uint64_t measuredCrcErrors = 0; // frames with a bad triplet
+  uint64_t numberCrcErrors = 0;
+  uint64_t numbersMissing = 0; // records without a 0x0316 frame
+
+  void add(const DecodeStats &o);
+};
+
+// Where the columns of a file with `rows` rows of `model` go
+class ColumnLayout {
+public:
+  ColumnLayout(Sen66Protocol::Model model, uint64_t rows);
+
+  Sen66Protocol::Model model() const { return _model; }
+  uint64_t rows() const { return _rows; }
+  uint8_t columnCount() const { return _count; }
+  const ColumnEntry &column(uint8_t i) const { return _columns[i]; }
+  uint64_t fileSize() const { return _fileSize; }
+
+  // Header and directory, at offset 0 of the file
+  void writeHeader(uint8_t *file) const;
+
+private:
+  friend void decodeRows(Kernel, const ColumnLayout &, const Record *,
+                         uint64_t, size_t, uint8_t *, DecodeStats &);
+
+  // A float column: its record triplet, decoding, and marker
+  struct Value {
+    uint8_t column;
+    uint8_t triplet;
+    bool isSigned;
+    float scale;
+  };
+
+  Sen66Protocol::Model _model;
+  uint64_t _rows;
+  uint8_t _count = 0;
+  ColumnEntry _columns[MAX_COLUMNS];
+  Value _values[RECORD_TRIPLETS];
+  uint8_t _valueCount = 0;
+  uint16_t _measuredMask = 0; // triplets of the model's measured frame
+  uint64_t _fileSize = 0;
+};
+
+// Decodes records [first, first + count) of a log into the same rows of
+// `file` (layout.fileSize() bytes). `records` points at record `first`.
+void decodeRows(Kernel k, const ColumnLayout &layout, const Record *records,
+                uint64_t first, size_t count, uint8_t *file,
+                DecodeStats &stats);
+
+// Checks magic, version and that the directory lies within `size`
+bool checkColumnFile(const uint8_t *file, uint64_t size, const char *&error);
+
+} // namespace FrameColumns
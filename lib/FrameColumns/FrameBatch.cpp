@@ -0,0 +1,433 @@
+// lib/FrameColumns/FrameBatch.cpp
+#include "FrameBatch.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define FRAME_BATCH_X86 1
+#include <immintrin.h>
+#else
+#define FRAME_BATCH_X86 0
+#endif
+
+namespace FrameColumns {
+
+// The kernels read a record's triplets as one run of 42 bytes
+static_assert(offsetof(Record, numbers) ==
+                  offsetof(Record, measured) + 3 * MEASURED_TRIPLETS,
+              "frames must be contiguous");
+static_assert(offsetof(Record, measured) == 14 && sizeof(Record) == 56,
+              "the shuffle masks assume the record layout");
+
+static const uint16_t ALL_TRIPLETS = (1u << RECORD_TRIPLETS) - 1;
+
+static const char *const KERNEL_NAMES[KERNEL_COUNT] = {"scalar", "ssse3",
+                                                       "avx2"};
+
+// ===== Tables =====
+
+struct CrcTables {
+  uint8_t byte[256]; // crc' = byte[crc ^ data]
+  // Linear part of the CRC per nibble of MSB and LSB, and the init's
+  // constant: crc = msbHi ^ msbLo ^ lsbHi ^ lsbLo ^ init
+  alignas(16) uint8_t msbHi[16];
+  alignas(16) uint8_t msbLo[16];
+  alignas(16) uint8_t lsbHi[16];
+  alignas(16) uint8_t lsbLo[16];
+  uint8_t init;
+  // PSHUFB selectors gathering byte `part` of each triplet from the three
+  // 16-byte loads at record offsets 8, 24 and 40 (0x80 = zero)
+  alignas(16) uint8_t select[3][3][16]; // [part][load][lane]
+
+  CrcTables();
+};
+
+CrcTables::CrcTables() {
+  for (int i = 0; i < 256; ++i) {
+    uint8_t crc = (uint8_t)i;
+    for (int b = 0; b < 8; ++b)
+      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+    byte[i] = crc;
+  }
+  const uint8_t zero[2] = {0, 0};
+  init = Sen66Protocol::crc8(zero, 2);
+  for (uint8_t n = 0; n < 16; ++n) {
+    const uint8_t pairs[4][2] = {
+        {(uint8_t)(n << 4), 0}, {n, 0}, {0, (uint8_t)(n << 4)}, {0, n}};
+    msbHi[n] = Sen66Protocol::crc8(pairs[0], 2) ^ init;
+    msbLo[n] = Sen66Protocol::crc8(pairs[1], 2) ^ init;
+    lsbHi[n] = Sen66Protocol::crc8(pairs[2], 2) ^ init;
+    lsbLo[n] = Sen66Protocol::crc8(pairs[3], 2) ^ init;
+  }
+  memset(select, 0x80, sizeof(select));
+  for (uint8_t part = 0; part < 3; ++part) {
+    for (uint8_t t = 0; t < RECORD_TRIPLETS; ++t) {
+      const uint8_t at = 6 + 3 * t + part; // from record offset 8
+      select[part][at / 16][t] = at % 16;
+    }
+  }
+}
+
+static const CrcTables &tables() {
+  static const CrcTables t;
+  return t;
+}
+
+// ===== Scalar =====
+
+static void extractScalar(const Record *records, size_t n, uint16_t *words,
+                          size_t stride, uint16_t *crcOk) {
+  const uint8_t *byte = tables().byte;
+  for (size_t i = 0; i < n; ++i) {
+    const uint8_t *p = records[i].measured;
+    uint16_t ok = 0;
+    for (uint8_t t = 0; t < RECORD_TRIPLETS; ++t, p += 3) {
+      if (byte[byte[0xFF ^ p[0]] ^ p[1]] == p[2])
+        ok |= (uint16_t)(1u << t);
+      words[t * stride + i] = (uint16_t)((p[0] << 8) | p[1]);
+    }
+    crcOk[i] = ok;
+  }
+}
+
+static void scaleScalar(const uint16_t *words, const uint8_t *frameOk, size_t n,
+                        bool isSigned, float scale, float *out,
+                        uint8_t *valid) {
+  const uint16_t marker = isSigned ? 0x7FFF : 0xFFFF;
+  for (size_t i = 0; i < n; i += 8) {
+    const size_t end = n - i < 8 ? n - i : 8;
+    uint8_t bits = 0;
+    for (size_t j = 0; j < end; ++j) {
+      const uint16_t w = words[i + j];
+      const bool ok = frameOk[i + j] && w != marker;
+      const float v = isSigned ? (float)(int16_t)w / scale : (float)w / scale;
+      out[i + j] = ok ? v : NAN;
+      bits |= (uint8_t)(ok << j);
+    }
+    valid[i / 8] = bits;
+  }
+}
+
+// ===== SSSE3 / AVX2 =====
+#if FRAME_BATCH_X86
+
+// Words of 8 records (one per register) to 8 words of all of them
+__attribute__((target("ssse3"))) static inline void transpose8x8(__m128i r[8]) {
+  const __m128i a0 = _mm_unpacklo_epi16(r[0], r[1]);
+  const __m128i a1 = _mm_unpackhi_epi16(r[0], r[1]);
+  const __m128i a2 = _mm_unpacklo_epi16(r[2], r[3]);
+  const __m128i a3 = _mm_unpackhi_epi16(r[2], r[3]);
+  const __m128i a4 = _mm_unpacklo_epi16(r[4], r[5]);
+  const __m128i a5 = _mm_unpackhi_epi16(r[4], r[5]);
+  const __m128i a6 = _mm_unpacklo_epi16(r[6], r[7]);
+  const __m128i a7 = _mm_unpackhi_epi16(r[6], r[7]);
+  const __m128i b0 = _mm_unpacklo_epi32(a0, a2);
+  const __m128i b1 = _mm_unpackhi_epi32(a0, a2);
+  const __m128i b2 = _mm_unpacklo_epi32(a1, a3);
+  const __m128i b3 = _mm_unpackhi_epi32(a1, a3);
+  const __m128i b4 = _mm_unpacklo_epi32(a4, a6);
+  const __m128i b5 = _mm_unpackhi_epi32(a4, a6);
+  const __m128i b6 = _mm_unpacklo_epi32(a5, a7);
+  const __m128i b7 = _mm_unpackhi_epi32(a5, a7);
+  r[0] = _mm_unpacklo_epi64(b0, b4);
+  r[1] = _mm_unpackhi_epi64(b0, b4);
+  r[2] = _mm_unpacklo_epi64(b1, b5);
+  r[3] = _mm_unpackhi_epi64(b1, b5);
+  r[4] = _mm_unpacklo_epi64(b2, b6);
+  r[5] = _mm_unpackhi_epi64(b2, b6);
+  r[6] = _mm_unpacklo_epi64(b3, b7);
+  r[7] = _mm_unpackhi_epi64(b3, b7);
+}
+
+// Stores the words of 8 records, lo[j] / hi[j] holding words 0..7 /
+// 8..15 of record j
+__attribute__((target("ssse3"))) static inline void
+storeColumns(__m128i lo[8], __m128i hi[8], uint16_t *words, size_t stride) {
+  transpose8x8(lo);
+  transpose8x8(hi);
+  for (uint8_t t = 0; t < 8; ++t)
+    _mm_storeu_si128((__m128i *)(words + t * stride), lo[t]);
+  for (uint8_t t = 8; t < RECORD_TRIPLETS; ++t)
+    _mm_storeu_si128((__m128i *)(words + t * stride), hi[t - 8]);
+}
+
+struct Lookup128 {
+  __m128i nibble, init, msbHi, msbLo, lsbHi, lsbLo;
+  const uint8_t (*select)[3][16];
+};
+
+__attribute__((target("ssse3"))) static inline __m128i
+lanes128(const __m128i v[3], const uint8_t sel[3][16]) {
+  const __m128i a = _mm_shuffle_epi8(v[0], _mm_load_si128((const __m128i *)sel[0]));
+  const __m128i b = _mm_shuffle_epi8(v[1], _mm_load_si128((const __m128i *)sel[1]));
+  const __m128i c = _mm_shuffle_epi8(v[2], _mm_load_si128((const __m128i *)sel[2]));
+  return _mm_or_si128(_mm_or_si128(a, b), c);
+}
+
+// One record: its CRC matches and its words, 0..7 in lo and 8..13 in hi
+__attribute__((target("ssse3"))) static inline uint16_t
+record128(const Record &r, const Lookup128 &k, __m128i &lo, __m128i &hi) {
+  const uint8_t *p = (const uint8_t *)&r + 8;
+  const __m128i v[3] = {_mm_loadu_si128((const __m128i *)p),
+                        _mm_loadu_si128((const __m128i *)(p + 16)),
+                        _mm_loadu_si128((const __m128i *)(p + 32))};
+  const __m128i msb = lanes128(v, k.select[0]);
+  const __m128i lsb = lanes128(v, k.select[1]);
+  const __m128i crc = lanes128(v, k.select[2]);
+
+  __m128i c = _mm_xor_si128(
+      _mm_shuffle_epi8(k.msbHi, _mm_and_si128(_mm_srli_epi16(msb, 4), k.nibble)),
+      _mm_shuffle_epi8(k.msbLo, _mm_and_si128(msb, k.nibble)));
+  c = _mm_xor_si128(c, _mm_shuffle_epi8(k.lsbHi, _mm_and_si128(
+                                                     _mm_srli_epi16(lsb, 4), k.nibble)));
+  c = _mm_xor_si128(c, _mm_shuffle_epi8(k.lsbLo, _mm_and_si128(lsb, k.nibble)));
+  c = _mm_xor_si128(c, k.init);
+  lo = _mm_unpacklo_epi8(lsb, msb);
+  hi = _mm_unpackhi_epi8(lsb, msb);
+  return (uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(c, crc)) & ALL_TRIPLETS;
+}
+
+__attribute__((target("ssse3"))) static void
+extractSsse3(const Record *records, size_t n, uint16_t *words, size_t stride,
+             uint16_t *crcOk) {
+  const CrcTables &tab = tables();
+  Lookup128 k;
+  k.nibble = _mm_set1_epi8(0x0F);
+  k.init = _mm_set1_epi8((char)tab.init);
+  k.msbHi = _mm_load_si128((const __m128i *)tab.msbHi);
+  k.msbLo = _mm_load_si128((const __m128i *)tab.msbLo);
+  k.lsbHi = _mm_load_si128((const __m128i *)tab.lsbHi);
+  k.lsbLo = _mm_load_si128((const __m128i *)tab.lsbLo);
+  k.select = tab.select;
+
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i lo[8], hi[8];
+    for (uint8_t j = 0; j < 8; ++j)
+      crcOk[i + j] = record128(records[i + j], k, lo[j], hi[j]);
+    storeColumns(lo, hi, words + i, stride);
+  }
+  alignas(16) uint16_t w[16];
+  for (; i < n; ++i) {
+    __m128i lo, hi;
+    crcOk[i] = record128(records[i], k, lo, hi);
+    _mm_store_si128((__m128i *)w, lo);
+    _mm_store_si128((__m128i *)(w + 8), hi);
+    for (uint8_t t = 0; t < RECORD_TRIPLETS; ++t)
+      words[t * stride + i] = w[t];
+  }
+}
+
+__attribute__((target("avx2"))) static inline __m256i
+lanes256(const __m256i v[3], const uint8_t sel[3][16]) {
+  const __m256i a = _mm256_shuffle_epi8(
+      v[0], _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)sel[0])));
+  const __m256i b = _mm256_shuffle_epi8(
+      v[1], _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)sel[1])));
+  const __m256i c = _mm256_shuffle_epi8(
+      v[2], _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)sel[2])));
+  return _mm256_or_si256(_mm256_or_si256(a, b), c);
+}
+
+__attribute__((target("avx2"))) static inline __m256i
+pair256(const uint8_t *a, const uint8_t *b) {
+  return _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)a)),
+      _mm_loadu_si128((const __m128i *)b), 1);
+}
+
+// Two records per pass, one in each 128-bit half (PSHUFB stays within
+// its half); halves go through the same transpose as SSSE3's
+__attribute__((target("avx2"))) static void
+extractAvx2(const Record *records, size_t n, uint16_t *words, size_t stride,
+            uint16_t *crcOk) {
+  const CrcTables &tab = tables();
+  const __m256i nibble = _mm256_set1_epi8(0x0F);
+  const __m256i init = _mm256_set1_epi8((char)tab.init);
+  const __m256i msbHi =
+      _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)tab.msbHi));
+  const __m256i msbLo =
+      _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)tab.msbLo));
+  const __m256i lsbHi =
+      _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)tab.lsbHi));
+  const __m256i lsbLo =
+      _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)tab.lsbLo));
+
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i lo[8], hi[8];
+    for (uint8_t j = 0; j < 8; j += 2) {
+      const uint8_t *pa = (const uint8_t *)&records[i + j] + 8;
+      const uint8_t *pb = pa + sizeof(Record);
+      const __m256i v[3] = {pair256(pa, pb), pair256(pa + 16, pb + 16),
+                            pair256(pa + 32, pb + 32)};
+      const __m256i msb = lanes256(v, tab.select[0]);
+      const __m256i lsb = lanes256(v, tab.select[1]);
+      const __m256i crc = lanes256(v, tab.select[2]);
+
+      __m256i c = _mm256_xor_si256(
+          _mm256_shuffle_epi8(msbHi,
+                              _mm256_and_si256(_mm256_srli_epi16(msb, 4), nibble)),
+          _mm256_shuffle_epi8(msbLo, _mm256_and_si256(msb, nibble)));
+      c = _mm256_xor_si256(
+          c, _mm256_shuffle_epi8(
+                 lsbHi, _mm256_and_si256(_mm256_srli_epi16(lsb, 4), nibble)));
+      c = _mm256_xor_si256(
+          c, _mm256_shuffle_epi8(lsbLo, _mm256_and_si256(lsb, nibble)));
+      c = _mm256_xor_si256(c, init);
+      const uint32_t ok = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(c, crc));
+      crcOk[i + j] = (uint16_t)ok & ALL_TRIPLETS;
+      crcOk[i + j + 1] = (uint16_t)(ok >> 16) & ALL_TRIPLETS;
+
+      const __m256i wl = _mm256_unpacklo_epi8(lsb, msb);
+      const __m256i wh = _mm256_unpackhi_epi8(lsb, msb);
+      lo[j] = _mm256_castsi256_si128(wl);
+      lo[j + 1] = _mm256_extracti128_si256(wl, 1);
+      hi[j] = _mm256_castsi256_si128(wh);
+      hi[j + 1] = _mm256_extracti128_si256(wh, 1);
+    }
+    storeColumns(lo, hi, words + i, stride);
+  }
+  if (i < n)
+    extractSsse3(records + i, n - i, words + i, stride, crcOk + i);
+}
+
+// 8 rows and one validity byte per pass
+__attribute__((target("ssse3"))) static void
+scaleSsse3(const uint16_t *words, const uint8_t *frameOk, size_t n,
+           bool isSigned, float scale, float *out, uint8_t *valid) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i marker = _mm_set1_epi16((short)(isSigned ? 0x7FFF : 0xFFFF));
+  const __m128 divisor = _mm_set1_ps(scale);
+  const __m128 nan = _mm_set1_ps(NAN);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m128i w = _mm_loadu_si128((const __m128i *)(words + i));
+    const __m128i ok = _mm_cmpgt_epi16(
+        _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(frameOk + i)), zero),
+        zero);
+    const __m128i v = _mm_andnot_si128(_mm_cmpeq_epi16(w, marker), ok);
+    valid[i / 8] = (uint8_t)_mm_movemask_epi8(_mm_packs_epi16(v, zero));
+
+    const __m128i lo = isSigned ? _mm_srai_epi32(_mm_unpacklo_epi16(w, w), 16)
+                                : _mm_unpacklo_epi16(w, zero);
+    const __m128i hi = isSigned ? _mm_srai_epi32(_mm_unpackhi_epi16(w, w), 16)
+                                : _mm_unpackhi_epi16(w, zero);
+    const __m128 flo = _mm_div_ps(_mm_cvtepi32_ps(lo), divisor);
+    const __m128 fhi = _mm_div_ps(_mm_cvtepi32_ps(hi), divisor);
+    const __m128 mlo = _mm_castsi128_ps(_mm_unpacklo_epi16(v, v));
+    const __m128 mhi = _mm_castsi128_ps(_mm_unpackhi_epi16(v, v));
+    _mm_storeu_ps(out + i, _mm_or_ps(_mm_and_ps(mlo, flo), _mm_andnot_ps(mlo, nan)));
+    _mm_storeu_ps(out + i + 4,
+                  _mm_or_ps(_mm_and_ps(mhi, fhi), _mm_andnot_ps(mhi, nan)));
+  }
+  if (i < n)
+    scaleScalar(words + i, frameOk + i, n - i, isSigned, scale, out + i,
+                valid + i / 8);
+}
+
+// 16 rows and two validity bytes per pass
+__attribute__((target("avx2"))) static void
+scaleAvx2(const uint16_t *words, const uint8_t *frameOk, size_t n,
+          bool isSigned, float scale, float *out, uint8_t *valid) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i marker = _mm256_set1_epi16((short)(isSigned ? 0x7FFF : 0xFFFF));
+  const __m256 divisor = _mm256_set1_ps(scale);
+  const __m256 nan = _mm256_set1_ps(NAN);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m256i w = _mm256_loadu_si256((const __m256i *)(words + i));
+    const __m256i ok = _mm256_cmpgt_epi16(
+        _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(frameOk + i))),
+        zero);
+    const __m256i v = _mm256_andnot_si256(_mm256_cmpeq_epi16(w, marker), ok);
+    // Packs within each half: rows 0..7 land in bits 0..7, 8..15 in 16..23
+    const uint32_t bits = (uint32_t)_mm256_movemask_epi8(_mm256_packs_epi16(v, zero));
+    valid[i / 8] = (uint8_t)bits;
+    valid[i / 8 + 1] = (uint8_t)(bits >> 16);
+
+    const __m128i w0 = _mm256_castsi256_si128(w);
+    const __m128i w1 = _mm256_extracti128_si256(w, 1);
+    const __m256i lo = isSigned ? _mm256_cvtepi16_epi32(w0) : _mm256_cvtepu16_epi32(w0);
+    const __m256i hi = isSigned ? _mm256_cvtepi16_epi32(w1) : _mm256_cvtepu16_epi32(w1);
+    const __m256 mlo = _mm256_castsi256_ps(_mm256_cvtepi16_epi32(_mm256_castsi256_si128(v)));
+    const __m256 mhi = _mm256_castsi256_ps(_mm256_cvtepi16_epi32(_mm256_extracti128_si256(v, 1)));
+    _mm256_storeu_ps(out + i, _mm256_blendv_ps(nan, _mm256_div_ps(_mm256_cvtepi32_ps(lo), divisor), mlo));
+    _mm256_storeu_ps(out + i + 8, _mm256_blendv_ps(nan, _mm256_div_ps(_mm256_cvtepi32_ps(hi), divisor), mhi));
+  }
+  if (i < n)
+    scaleSsse3(words + i, frameOk + i, n - i, isSigned, scale, out + i,
+               valid + i / 8);
+}
+
+#endif
+
+// ===== Dispatch =====
+
+const char *kernelName(Kernel k) {
+  return k < KERNEL_COUNT ? KERNEL_NAMES[k] : "?";
+}
+
+bool parseKernel(const char *name, Kernel &k) {
+  for (uint8_t i = 0; i < KERNEL_COUNT; ++i) {
+    if (strcmp(name, KERNEL_NAMES[i]) == 0) {
+      k = (Kernel)i;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool kernelSupported(Kernel k) {
+  switch (k) {
+  case KERNEL_SCALAR:
+    return true;
+#if FRAME_BATCH_X86
+  case KERNEL_SSSE3:
+    return __builtin_cpu_supports("ssse3");
+  case KERNEL_AVX2:
+    return __builtin_cpu_supports("avx2");
+#endif
+  default:
+    return false;
+  }
+}
+
+Kernel bestKernel() {
+  if (kernelSupported(KERNEL_AVX2))
+    return KERNEL_AVX2;
+  if (kernelSupported(KERNEL_SSSE3))
+    return KERNEL_SSSE3;
+  return KERNEL_SCALAR;
+}
+
+void extractWords(Kernel k, const Record *records, size_t n, uint16_t *words,
+                  size_t stride, uint16_t *crcOk) {
+  if (!kernelSupported(k))
+    k = KERNEL_SCALAR;
+#if FRAME_BATCH_X86
+  if (k == KERNEL_AVX2)
+    return extractAvx2(records, n, words, stride, crcOk);
+  if (k == KERNEL_SSSE3)
+    return extractSsse3(records, n, words, stride, crcOk);
+#endif
+  extractScalar(records, n, words, stride, crcOk);
+}
+
+void scaleWords(Kernel k, const uint16_t *words, const uint8_t *frameOk,
+                size_t n, bool isSigned, float scale, float *out,
+                uint8_t *valid) {
+  if (!kernelSupported(k))
+    k = KERNEL_SCALAR;
+#if FRAME_BATCH_X86
+  if (k == KERNEL_AVX2)
+    return scaleAvx2(words, frameOk, n, isSigned, scale, out, valid);
+  if (k == KERNEL_SSSE3)
+    return scaleSsse3(words, frameOk, n, isSigned, scale, out, valid);
+#endif
+  scaleScalar(words, frameOk, n, isSigned, scale, out, valid);
+}
+
+} // namespace FrameColumns
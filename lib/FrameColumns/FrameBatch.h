@@ -0,0 +1,50 @@
+// lib/FrameColumns/FrameBatch.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FrameLog.h"
+
+/*
+  Kernels behind ColumnFile.h's decoder, for many frame log records at
+  once: CRC check and word extraction, then scaling one column.
+
+  CRC-8 (poly 0x31) is linear, so the CRC of a [MSB, LSB] pair is the XOR
+  of four 16-entry tables indexed by its nibbles and a constant for the
+  0xFF init. The SIMD kernels use that: one record's 14 triplets are
+  split into MSB, LSB and CRC lanes with byte shuffles, and the tables
+  are looked up 16 (SSSE3) or 32 (AVX2, two records) lanes at a time
+  with PSHUFB. The words of 8 records are then transposed into columns
+  in registers. The scalar kernel is a byte-table CRC per triplet.
+
+  The SIMD kernels are compiled with per-function target attributes and
+  picked at run time, so the binary runs on any x86-64; elsewhere only
+  the scalar kernel is available.
+*/
+
+namespace FrameColumns {
+
+enum Kernel : uint8_t { KERNEL_SCALAR, KERNEL_SSSE3, KERNEL_AVX2, KERNEL_COUNT };
+
+const char *kernelName(Kernel k);
+bool parseKernel(const char *name, Kernel &k);
+bool kernelSupported(Kernel k);
+// Widest kernel the CPU runs
+Kernel bestKernel();
+
+// Verifies the CRC of every triplet of records [0, n) and extracts the
+// words column-wise: words[t * stride + i] is triplet t of record i
+// (stride >= n). crcOk[i] has bit t set when triplet t's CRC matched.
+// An unsupported kernel falls back to the scalar one.
+void extractWords(Kernel k, const Record *records, size_t n, uint16_t *words,
+                  size_t stride, uint16_t *crcOk);
+
+// Scales n words of one column as Sen66Protocol::scaleUInt16 /
+// scaleInt16 do, bit for bit. Rows whose frameOk is 0 or that hold the
+// "not available" marker are NaN and cleared in `valid`, a bitmap from
+// bit 0 of valid[0].
+void scaleWords(Kernel k, const uint16_t *words, const uint8_t *frameOk,
+                size_t n, bool isSigned, float scale, float *out,
+                uint8_t *valid);
+
+} // namespace FrameColumns
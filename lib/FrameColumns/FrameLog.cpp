@@ -0,0 +1,54 @@
+// lib/FrameColumns/FrameLog.cpp
+#include "FrameLog.h"
+
+#include <string.h>
+
+namespace FrameColumns {
+
+Record makeRecord(uint8_t sensor, uint32_t monoMs, int64_t epochMs,
+                  const uint8_t *measured, size_t measuredLen,
+                  const uint8_t *numbers) {
+  Record r;
+  memset(&r, 0, sizeof(r));
+  r.epochMs = epochMs;
+  r.monoMs = monoMs;
+  r.sensor = sensor;
+  r.flags = epochMs != 0 ? FRAME_CLOCK_SYNCED : 0;
+  if (measuredLen > sizeof(r.measured))
+    measuredLen = sizeof(r.measured);
+  memcpy(r.measured, measured, measuredLen);
+  if (numbers) {
+    memcpy(r.numbers, numbers, sizeof(r.numbers));
+    r.flags |= FRAME_HAS_NUMBERS;
+  }
+  return r;
+}
+
+FileHeader fileHeader(Sen66Protocol::Model model) {
+  FileHeader h;
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, "S6FR", 4);
+  h.version = FILE_VERSION;
+  h.recordSize = sizeof(Record);
+  h.model = model;
+  return h;
+}
+
+bool checkHeader(const FileHeader &h, const char *&error) {
+  if (memcmp(h.magic, "S6FR", 4) != 0) {
+    error = "not a frame log";
+    return false;
+  }
+  if (h.version != FILE_VERSION || h.recordSize != sizeof(Record)) {
+    error = "unsupported frame log version";
+    return false;
+  }
+  if (h.model != Sen66Protocol::SEN63C && h.model != Sen66Protocol::SEN65 &&
+      h.model != Sen66Protocol::SEN66 && h.model != Sen66Protocol::SEN68) {
+    error = "unknown model";
+    return false;
+  }
+  return true;
+}
+
+} // namespace FrameColumns
@@ -0,0 +1,82 @@
+// lib/FrameColumns/FrameLog.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Sen66Protocol.h>
+
+/*
+  Log of SEN6x value frames exactly as read off the bus, CRC bytes
+  included: the measured values response of the node's model plus the
+  0x0316 number concentration response of the same sample. Decoding is
+  left to the reader (FrameBatch.h, ColumnFile.h), so a log keeps what a
+  noisy bus delivered.
+
+  File layout (little-endian, no padding; a reader can mmap the file and
+  view the records as an array):
+
+    offset  size  header (16 bytes)
+         0     4  magic "S6FR"
+         4     2  uint16  version (1)
+         6     2  uint16  record size (56)
+         8     1  uint8   model (SEN6X_MODEL: 63, 65, 66 or 68)
+         9     7  reserved, 0
+
+    offset  size  record (56 bytes, 8-byte aligned from offset 16)
+         0     8  int64   wall clock [ms since epoch], 0 if not synced
+         8     4  uint32  node millis() at data-ready
+        12     1  uint8   sensor index (SEN66_SENSORS order)
+        13     1  uint8   flags, FRAME_CLOCK_SYNCED | FRAME_HAS_NUMBERS
+        14    27  measured values frame, the model's words, zero-padded
+                  to the SEN66's 9 triplets
+        41    15  0x0316 frame (5 triplets), zero without FRAME_HAS_NUMBERS
+
+  The record count is (file size - 16) / 56, so logs of the same model
+  grow by appending records.
+*/
+
+namespace FrameColumns {
+
+constexpr uint8_t FRAME_CLOCK_SYNCED = 0x01;
+constexpr uint8_t FRAME_HAS_NUMBERS = 0x02;
+
+// Triplets of a record: 9 measured value slots, then the 5 number
+// concentrations
+constexpr uint8_t MEASURED_TRIPLETS = 9;
+constexpr uint8_t NUMBER_TRIPLETS = 5;
+constexpr uint8_t RECORD_TRIPLETS = MEASURED_TRIPLETS + NUMBER_TRIPLETS;
+
+struct Record {
+  int64_t epochMs;
+  uint32_t monoMs;
+  uint8_t sensor;
+  uint8_t flags;
+  uint8_t measured[3 * MEASURED_TRIPLETS];
+  uint8_t numbers[3 * NUMBER_TRIPLETS];
+};
+
+struct FileHeader {
+  char magic[4];
+  uint16_t version;
+  uint16_t recordSize;
+  uint8_t model;
+  uint8_t reserved[7];
+};
+
+static_assert(sizeof(Record) == 56, "FrameColumns::Record layout is fixed");
+static_assert(sizeof(FileHeader) == 16,
+              "FrameColumns::FileHeader layout is fixed");
+
+constexpr uint16_t FILE_VERSION = 1;
+
+// `numbers` may be null (no 0x0316 read for this sample)
+Record makeRecord(uint8_t sensor, uint32_t monoMs, int64_t epochMs,
+                  const uint8_t *measured, size_t measuredLen,
+                  const uint8_t *numbers);
+
+FileHeader fileHeader(Sen66Protocol::Model model);
+
+// Checks magic, version, record size and model; false with `error` set
+bool checkHeader(const FileHeader &h, const char *&error);
+
+} // namespace FrameColumns
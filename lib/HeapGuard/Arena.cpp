@@ -0,0 +1,59 @@
+// lib/HeapGuard/Arena.cpp
+#include "Arena.h"
+
+#include <string.h>
+
+Arena::Arena(void *buf, size_t cap) : _buf((uint8_t *)buf), _cap(cap) {
+  // Start the first block on an aligned address
+  const size_t skew = (uintptr_t)_buf & (ALIGN - 1);
+  if (skew != 0) {
+    const size_t skip = ALIGN - skew;
+    _buf += skip < _cap ? skip : _cap;
+    _cap -= skip < _cap ? skip : _cap;
+  }
+}
+
+void *Arena::allocate(size_t size) {
+  const size_t need = HEADER + align(size);
+  if (need < size || need > _cap - _used)
+    return nullptr;
+  void *p = _buf + _used + HEADER;
+  blockSize(p) = size;
+  _last = _used + HEADER;
+  _used += need;
+  if (_used > _peak)
+    _peak = _used;
+  return p;
+}
+
+void *Arena::reallocate(void *p, size_t size) {
+  if (!p)
+    return allocate(size);
+  const size_t old = blockSize(p);
+  if ((size_t)((uint8_t *)p - _buf) == _last) {
+    // The newest block ends at _used: move the end
+    const size_t need = align(size);
+    if (need < size || need > _cap - _last)
+      return nullptr;
+    blockSize(p) = size;
+    _used = _last + need;
+    if (_used > _peak)
+      _peak = _used;
+    return p;
+  }
+  if (size <= old) {
+    blockSize(p) = size;
+    return p;
+  }
+  void *q = allocate(size);
+  if (q)
+    memcpy(q, p, old);
+  return q;
+}
+
+void Arena::release(void *p) {
+  if (!p || (size_t)((uint8_t *)p - _buf) != _last)
+    return;
+  _used = _last - HEADER;
+  _last = NONE;
+}
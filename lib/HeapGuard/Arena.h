@@ -0,0 +1,44 @@
+// lib/HeapGuard/Arena.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+  Bump allocator over a caller-owned buffer, for work that needs dynamic
+  memory for a while and then lets go of all of it at once (a parsed
+  JSON document): reset() returns the whole buffer.
+
+  Blocks are 8-byte aligned and carry their size. The newest block can
+  grow or shrink in place and release() gives it back; any other block
+  is only reclaimed by reset(). allocate() returns null when the buffer
+  is full rather than falling back to the heap.
+*/
+class Arena {
+public:
+  Arena(void *buf, size_t cap);
+
+  void *allocate(size_t size);
+  void *reallocate(void *p, size_t size);
+  void release(void *p);
+  void reset() { _used = 0; _last = NONE; }
+
+  size_t used() const { return _used; }
+  size_t peak() const { return _peak; }
+  size_t capacity() const { return _cap; }
+
+private:
+  static constexpr size_t ALIGN = 8;
+  static constexpr size_t HEADER = ALIGN; // block size, padded
+  static constexpr size_t NONE = (size_t)-1;
+
+  static size_t align(size_t n) { return (n + ALIGN - 1) & ~(ALIGN - 1); }
+  size_t &blockSize(void *p) {
+    return *(size_t *)((uint8_t *)p - HEADER);
+  }
+
+  uint8_t *_buf;
+  size_t _cap;
+  size_t _used = 0;
+  size_t _last = NONE; // offset of the newest block's data
+  size_t _peak = 0;
+};
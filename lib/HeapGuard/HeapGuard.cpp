@@ -0,0 +1,113 @@
+// lib/HeapGuard/HeapGuard.cpp
+#include "HeapGuard.h"
+
+#if HEAP_GUARD_ENABLED
+
+#include <stdlib.h>
+
+#ifdef ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <new>
+#endif
+
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *p, size_t size);
+}
+
+namespace HeapGuard {
+
+static bool isArmed = false;
+static bool trapping = false;
+static uint16_t transientDepth = 0;
+static uint16_t pausedDepth = 0;
+static Stats counters = {};
+#ifdef ESP32
+static TaskHandle_t armedTask = nullptr;
+#endif
+
+void arm(bool trap) {
+#ifdef ESP32
+  armedTask = xTaskGetCurrentTaskHandle();
+#endif
+  counters = Stats();
+  trapping = trap;
+  isArmed = true;
+}
+
+bool armed() { return isArmed; }
+
+Stats stats() { return counters; }
+
+TransientScope::TransientScope() { transientDepth++; }
+TransientScope::~TransientScope() { transientDepth--; }
+
+PausedScope::PausedScope() { pausedDepth++; }
+PausedScope::~PausedScope() { pausedDepth--; }
+
+// Scope depths are only touched by the armed task, so other tasks'
+// allocations are filtered out before they are looked at
+static void note(size_t bytes, const void *caller) {
+  if (!isArmed)
+    return;
+#ifdef ESP32
+  if (xTaskGetCurrentTaskHandle() != armedTask)
+    return;
+#endif
+  if (pausedDepth > 0)
+    return;
+  if (transientDepth > 0) {
+    counters.transient++;
+    return;
+  }
+  counters.allocations++;
+  counters.bytes += (uint32_t)bytes;
+  counters.lastCaller = caller;
+  if (trapping)
+    abort();
+}
+
+} // namespace HeapGuard
+
+extern "C" {
+
+void *__wrap_malloc(size_t size) {
+  HeapGuard::note(size, __builtin_return_address(0));
+  return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t n, size_t size) {
+  HeapGuard::note(n * size, __builtin_return_address(0));
+  return __real_calloc(n, size);
+}
+
+// Shrinking or freeing through realloc() is not an allocation
+void *__wrap_realloc(void *p, size_t size) {
+  if (size > 0)
+    HeapGuard::note(size, __builtin_return_address(0));
+  return __real_realloc(p, size);
+}
+
+} // extern "C"
+
+#ifndef ESP32
+// The host's operator new lives in the shared libstdc++, out of reach of
+// --wrap; route it through malloc() so String and container growth show
+// up like they do on the ESP32, whose libstdc++ is linked statically.
+void *operator new(size_t size) {
+  void *p = malloc(size ? size : 1);
+  if (!p)
+    throw std::bad_alloc();
+  return p;
+}
+void *operator new[](size_t size) { return operator new(size); }
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+#endif
+
+#endif
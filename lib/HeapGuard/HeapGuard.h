@@ -0,0 +1,86 @@
+// lib/HeapGuard/HeapGuard.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+  Heap use after startup. The sensor node allocates what it keeps in
+  setup() (history blocks, line buffers, URLs, the weather JSON arena);
+  after that loop() is meant to run without touching the heap, because
+  weeks of small allocations fragment it until a large one fails.
+
+  With HEAP_GUARD_ENABLED the link wraps malloc, calloc and realloc
+  (-Wl,--wrap=malloc,...; needs GNU ld) and, from arm() at the end of
+  setup(), every allocation made by the arming task (loop()'s) is
+  counted. arm(true) aborts on the first one instead, so a soak run
+  stops with the culprit in the backtrace; stats().lastCaller is the
+  return address into the allocating code otherwise.
+
+  Some allocations are expected and given back: a TLS connection's
+  buffers, an NVS write, a LAN request to the OTA or diagnostics server.
+  Their call sites open a transient scope:
+
+    HEAP_GUARD_TRANSIENT(); // counted apart, never trapped
+
+  HEAP_GUARD_PAUSED() leaves the rest of the block out entirely (the
+  simulator's own bookkeeping, which stands in for other tasks).
+
+  Memory taken from heap_caps_malloc() directly (ps_malloc()) and other
+  tasks' allocations (the WiFi driver, lwIP) are not seen.
+
+  Build with -DHEAP_GUARD_ENABLED=0 (the default) and the HEAP_GUARD_*
+  macros expand to nothing and arm() and stats() do nothing.
+*/
+
+#ifndef HEAP_GUARD_ENABLED
+#define HEAP_GUARD_ENABLED 0
+#endif
+
+namespace HeapGuard {
+
+struct Stats {
+  uint32_t allocations;   // since arm(), outside transient scopes
+  uint32_t bytes;         // requested by those
+  uint32_t transient;     // inside transient scopes
+  const void *lastCaller; // of the last counted allocation
+};
+
+#if HEAP_GUARD_ENABLED
+
+// Starts counting the calling task's allocations; with trap, the first
+// one outside a transient scope aborts.
+void arm(bool trap);
+bool armed();
+Stats stats();
+
+class TransientScope {
+public:
+  TransientScope();
+  ~TransientScope();
+};
+
+class PausedScope {
+public:
+  PausedScope();
+  ~PausedScope();
+};
+
+#define HEAP_GUARD_CONCAT_(a, b) a##b
+#define HEAP_GUARD_CONCAT(a, b) HEAP_GUARD_CONCAT_(a, b)
+#define HEAP_GUARD_TRANSIENT()                                                 \
+  HeapGuard::TransientScope HEAP_GUARD_CONCAT(_heapTransient, __LINE__)
+#define HEAP_GUARD_PAUSED()                                                    \
+  HeapGuard::PausedScope HEAP_GUARD_CONCAT(_heapPaused, __LINE__)
+
+#else
+
+inline void arm(bool) {}
+inline bool armed() { return false; }
+inline Stats stats() { return Stats(); }
+
+#define HEAP_GUARD_TRANSIENT() ((void)0)
+#define HEAP_GUARD_PAUSED() ((void)0)
+
+#endif
+
+} // namespace HeapGuard
@@ -0,0 +1,395 @@
+// lib/History/History.cpp
+#include "History.h"
+
+#include <math.h>
+#include <string.h>
+
+namespace History {
+
+// ===== Channels =====
+static const float SCALE[CHANNEL_COUNT] = {10, 10, 10, 10, 100, 200, 10, 10,
+                                           1,  10, 10, 10, 10,  10,  10};
+
+static bool isSigned(uint8_t ch) {
+  return ch >= CH_HUMIDITY && ch <= CH_NOX;
+}
+
+static bool isUnknown(uint8_t ch, uint16_t tick) {
+  return tick == (isSigned(ch) ? 0x7FFF : 0xFFFF);
+}
+
+// Tick in a domain where min/max/sum make sense
+static int32_t signedTick(uint8_t ch, uint16_t tick) {
+  return isSigned(ch) ? (int32_t)(int16_t)tick : (int32_t)tick;
+}
+
+static uint16_t tickOf(uint8_t ch, float v) {
+  if (isnan(v))
+    return isSigned(ch) ? 0x7FFF : 0xFFFF;
+  const float s = roundf(v * SCALE[ch]);
+  if (isSigned(ch))
+    return (uint16_t)(int16_t)(s < -32768 ? -32768 : (s > 32766 ? 32766 : s));
+  return (uint16_t)(s < 0 ? 0 : (s > 65534 ? 65534 : s));
+}
+
+void toTicks(const Sen66Protocol::MeasuredValues &mv,
+             const Sen66Protocol::NumberConcentration &nc, Ticks &out) {
+  const float v[CHANNEL_COUNT] = {
+      mv.pm1_0,     mv.pm2_5,       mv.pm4_0,   mv.pm10_0, mv.humidity_rh,
+      mv.temperature_c, mv.voc_index, mv.nox_index, mv.co2_ppm, nc.nc0_5,
+      nc.nc1_0,     nc.nc2_5,       nc.nc4_0,   nc.nc10_0, mv.hcho_ppb};
+  for (uint8_t ch = 0; ch < CHANNEL_COUNT; ++ch)
+    out.v[ch] = tickOf(ch, v[ch]);
+}
+
+float toValue(Channel ch, uint16_t tick) {
+  if (isUnknown(ch, tick))
+    return NAN;
+  return (float)signedTick(ch, tick) / SCALE[ch];
+}
+
+// ===== Bit codes =====
+static inline uint16_t zigzag16(int16_t d) {
+  return (uint16_t)(((uint16_t)d << 1) ^ (uint16_t)(d >> 15));
+}
+
+static inline int16_t unzigzag16(uint16_t z) {
+  return (int16_t)((z >> 1) ^ (uint16_t)-(int16_t)(z & 1));
+}
+
+static inline uint32_t zigzag32(int32_t d) {
+  return ((uint32_t)d << 1) ^ (uint32_t)(d >> 31);
+}
+
+static inline int32_t unzigzag32(uint32_t z) {
+  return (int32_t)((z >> 1) ^ (uint32_t)-(int32_t)(z & 1));
+}
+
+// Worst case: 36 timestamp bits + 19 bits per channel
+static const uint32_t MAX_SAMPLE_BITS = 36 + CHANNEL_COUNT * 19;
+// The last 5 bytes stay unused so the reader can always load a 40 bit
+// window without bounds checks
+static const uint32_t BLOCK_BITS = (BLOCK_BYTES - 5) * 8;
+
+// Next 32 bits at `pos`
+static inline uint32_t peekBits(const uint8_t *data, uint32_t pos) {
+  const uint8_t *p = data + (pos >> 3);
+  const uint64_t window = ((uint64_t)p[0] << 32) | ((uint32_t)p[1] << 24) |
+                          ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 8) |
+                          p[4];
+  return (uint32_t)(window >> (8 - (pos & 7)));
+}
+
+static inline uint32_t readBits(const uint8_t *data, uint32_t &pos,
+                                uint8_t n) {
+  if (n == 32) {
+    const uint32_t v = peekBits(data, pos);
+    pos += 32;
+    return v;
+  }
+  const uint32_t v = peekBits(data, pos) >> (32 - n);
+  pos += n;
+  return v;
+}
+
+// Number of leading 1 bits up to `max` (the prefix of a code)
+static inline uint8_t readPrefix(const uint8_t *data, uint32_t &pos,
+                                 uint8_t max) {
+  const uint32_t inverted = ~peekBits(data, pos);
+  uint8_t ones = inverted ? (uint8_t)__builtin_clz(inverted) : 32;
+  if (ones >= max) {
+    pos += max;
+    return max;
+  }
+  pos += ones + 1u;
+  return ones;
+}
+
+void Store::writeBits(uint32_t value, uint8_t n) {
+  BlockSummary &s = _summaries[_head];
+  uint8_t *data = _data + _head * BLOCK_BYTES;
+  uint32_t pos = s.bits;
+  while (n) {
+    const uint8_t bit = pos & 7;
+    const uint8_t room = (uint8_t)(8 - bit);
+    const uint8_t put = room < n ? room : n;
+    const uint8_t chunk = (uint8_t)((value >> (n - put)) & ((1u << put) - 1));
+    if (bit == 0)
+      data[pos >> 3] = 0;
+    data[pos >> 3] |= (uint8_t)(chunk << (room - put));
+    pos += put;
+    n -= put;
+  }
+  s.bits = (uint16_t)pos;
+}
+
+// ===== Store =====
+Store::Store(void *storage, size_t bytes) {
+  _blockCount = bytes / (BLOCK_BYTES + sizeof(BlockSummary));
+  _summaries = (BlockSummary *)storage;
+  _data = (uint8_t *)storage + _blockCount * sizeof(BlockSummary);
+}
+
+void Store::clear() {
+  _live = 0;
+  _head = 0;
+  _samples = 0;
+}
+
+const BlockSummary &Store::summaryAt(size_t age) const {
+  return _summaries[(_head + _blockCount - (_live - 1) + age) % _blockCount];
+}
+
+const uint8_t *Store::dataAt(size_t age) const {
+  return _data +
+         ((_head + _blockCount - (_live - 1) + age) % _blockCount) * BLOCK_BYTES;
+}
+
+uint32_t Store::oldestMs() const { return _live ? summaryAt(0).firstMs : 0; }
+
+uint32_t Store::newestMs() const { return _live ? _summaries[_head].lastMs : 0; }
+
+size_t Store::usedBytes() const {
+  size_t bits = 0;
+  for (size_t age = 0; age < _live; ++age)
+    bits += summaryAt(age).bits;
+  return (bits + 7) / 8 + _live * sizeof(BlockSummary);
+}
+
+void Store::startBlock(uint32_t tMs) {
+  if (_live == 0) {
+    _head = 0;
+    _live = 1;
+  } else {
+    _head = (_head + 1) % _blockCount;
+    if (_live == _blockCount)
+      _samples -= _summaries[_head].count; // ring full: drop the oldest
+    else
+      _live++;
+  }
+  BlockSummary &s = _summaries[_head];
+  memset(&s, 0, sizeof(s));
+  s.firstMs = tMs;
+  for (uint8_t ch = 0; ch < CHANNEL_COUNT; ++ch) {
+    s.min[ch] = INT32_MAX;
+    s.max[ch] = INT32_MIN;
+  }
+  // The first sample of a block is coded against zero, so blocks decode
+  // independently
+  memset(&_prev, 0, sizeof(_prev));
+  _prevMs = tMs;
+  _prevDelta = 0;
+}
+
+bool Store::append(uint32_t tMs, const Ticks &t) {
+  if (_blockCount < 2)
+    return false;
+  if (_live && _summaries[_head].count && (int32_t)(tMs - _prevMs) < 0)
+    return false; // out of order
+  if (_live == 0 || _summaries[_head].bits + MAX_SAMPLE_BITS > BLOCK_BITS ||
+      _summaries[_head].count == UINT16_MAX)
+    startBlock(tMs);
+
+  BlockSummary &s = _summaries[_head];
+  if (s.count > 0) {
+    const int32_t delta = (int32_t)(tMs - _prevMs);
+    const uint32_t z = zigzag32(delta - _prevDelta);
+    if (z == 0) {
+      writeBits(0, 1);
+    } else if (z <= 128) {
+      writeBits(0x2, 2);
+      writeBits(z - 1, 7);
+    } else if (z <= 1024) {
+      writeBits(0x6, 3);
+      writeBits(z - 1, 10);
+    } else if (z <= 65536) {
+      writeBits(0xE, 4);
+      writeBits(z - 1, 16);
+    } else {
+      writeBits(0xF, 4);
+      writeBits(z, 32);
+    }
+    _prevDelta = delta;
+  }
+  _prevMs = tMs;
+
+  for (uint8_t ch = 0; ch < CHANNEL_COUNT; ++ch) {
+    const uint16_t tick = t.v[ch];
+    const uint16_t z = zigzag16((int16_t)(uint16_t)(tick - _prev.v[ch]));
+    if (z == 0) {
+      writeBits(0, 1);
+    } else if (z <= 16) {
+      writeBits(0x2, 2);
+      writeBits(z - 1u, 4);
+    } else if (z <= 256) {
+      writeBits(0x6, 3);
+      writeBits(z - 1u, 8);
+    } else {
+      writeBits(0x7, 3);
+      writeBits(z, 16);
+    }
+    _prev.v[ch] = tick;
+
+    if (!isUnknown(ch, tick)) {
+      const int32_t v = signedTick(ch, tick);
+      s.valid[ch]++;
+      s.sum[ch] += v;
+      if (v < s.min[ch])
+        s.min[ch] = v;
+      if (v > s.max[ch])
+        s.max[ch] = v;
+    }
+  }
+  s.lastMs = tMs;
+  s.count++;
+  _samples++;
+  return true;
+}
+
+// ===== Reading =====
+Cursor Store::cursor() const {
+  Cursor c;
+  c._store = this;
+  c._block = 0;
+  c.openBlock();
+  return c;
+}
+
+bool Cursor::openBlock() {
+  if (_block >= _store->_live)
+    return false;
+  const BlockSummary &s = _store->summaryAt(_block);
+  _data = _store->dataAt(_block);
+  _count = s.count;
+  _index = 0;
+  _bitPos = 0;
+  _prevMs = s.firstMs;
+  _prevDelta = 0;
+  memset(&_prev, 0, sizeof(_prev));
+  return true;
+}
+
+bool Cursor::next(uint32_t &tMs, Ticks &out) {
+  if (!_store || _block >= _store->_live)
+    return false;
+  while (_index >= _count) {
+    _block++;
+    if (!openBlock())
+      return false;
+  }
+
+  const uint8_t *data = _data;
+  if (_index > 0) {
+    uint32_t z = 0;
+    switch (readPrefix(data, _bitPos, 4)) {
+    case 0:
+      break;
+    case 1:
+      z = readBits(data, _bitPos, 7) + 1;
+      break;
+    case 2:
+      z = readBits(data, _bitPos, 10) + 1;
+      break;
+    case 3:
+      z = readBits(data, _bitPos, 16) + 1;
+      break;
+    default:
+      z = readBits(data, _bitPos, 32);
+      break;
+    }
+    _prevDelta += unzigzag32(z);
+    _prevMs += (uint32_t)_prevDelta;
+  }
+  tMs = _prevMs;
+
+  for (uint8_t ch = 0; ch < CHANNEL_COUNT; ++ch) {
+    uint16_t z = 0;
+    switch (readPrefix(data, _bitPos, 3)) {
+    case 0:
+      break;
+    case 1:
+      z = (uint16_t)(readBits(data, _bitPos, 4) + 1);
+      break;
+    case 2:
+      z = (uint16_t)(readBits(data, _bitPos, 8) + 1);
+      break;
+    default:
+      z = (uint16_t)readBits(data, _bitPos, 16);
+      break;
+    }
+    _prev.v[ch] = (uint16_t)(_prev.v[ch] + (uint16_t)unzigzag16(z));
+  }
+  out = _prev;
+  _index++;
+  return true;
+}
+
+static void addToBucket(Bucket &b, float lo, float hi, uint32_t n,
+                        double sum) {
+  if (b.count == 0) {
+    b.min = lo;
+    b.max = hi;
+  } else {
+    if (lo < b.min)
+      b.min = lo;
+    if (hi > b.max)
+      b.max = hi;
+  }
+  b.count += n;
+  b.sum += sum;
+}
+
+size_t Store::scan(Channel ch, uint32_t fromMs, uint32_t toMs,
+                   uint32_t bucketMs, Bucket *out, size_t maxOut) const {
+  if (bucketMs == 0 || (int32_t)(toMs - fromMs) <= 0)
+    return 0;
+  size_t n = (toMs - fromMs + bucketMs - 1) / bucketMs;
+  if (n > maxOut)
+    n = maxOut;
+  for (size_t i = 0; i < n; ++i) {
+    out[i].startMs = fromMs + (uint32_t)i * bucketMs;
+    out[i].count = 0;
+    out[i].min = out[i].max = NAN;
+    out[i].sum = 0;
+  }
+  const uint32_t span = (uint32_t)n * bucketMs;
+  const float scale = SCALE[ch];
+
+  for (size_t age = 0; age < _live; ++age) {
+    const BlockSummary &s = summaryAt(age);
+    const int32_t firstRel = (int32_t)(s.firstMs - fromMs);
+    const int32_t lastRel = (int32_t)(s.lastMs - fromMs);
+    if (lastRel < 0)
+      continue; // before the window
+    if (firstRel >= 0 && (uint32_t)firstRel >= span)
+      break; // after the window, and so are all newer blocks
+    if (firstRel >= 0 && (uint32_t)lastRel < span &&
+        (uint32_t)firstRel / bucketMs == (uint32_t)lastRel / bucketMs) {
+      // Whole block in one bucket: merge its summary
+      if (s.valid[ch])
+        addToBucket(out[(uint32_t)firstRel / bucketMs], s.min[ch] / scale,
+                    s.max[ch] / scale, s.valid[ch], s.sum[ch] / (double)scale);
+      continue;
+    }
+
+    // Decode the block sample by sample
+    Cursor c;
+    c._store = this;
+    c._block = age;
+    c.openBlock();
+    uint32_t t;
+    Ticks ticks;
+    for (uint16_t i = 0; i < s.count && c.next(t, ticks); ++i) {
+      if ((int32_t)(t - fromMs) < 0 || t - fromMs >= span)
+        continue;
+      const uint16_t tick = ticks.v[ch];
+      if (isUnknown(ch, tick))
+        continue;
+      const float v = (float)signedTick(ch, tick) / scale;
+      addToBucket(out[(t - fromMs) / bucketMs], v, v, 1, v);
+    }
+  }
+  return n;
+}
+
+} // namespace History
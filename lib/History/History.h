@@ -0,0 +1,160 @@
+// lib/History/History.h
+#pragma once
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Sen66Protocol.h>
+
+/*
+  Compressed in-RAM history of SEN6x samples, all 15 channels (HCHO is
+  "unknown" on every model but the SEN68, costing 1 bit per sample).
+
+  - Values are kept as the sensor's own 16-bit ticks (PM x10, RH x100,
+    T x200, ...), so storage is lossless and "unknown" (0xFFFF / 0x7FFF)
+    round-trips. Each channel stores the zigzag delta to the previous
+    sample in a prefix code: 1 bit if unchanged, 6 bits for +-8 ticks,
+    11 bits for +-128, 19 bits otherwise.
+  - Timestamps (ms, caller's clock) are Gorilla delta-of-delta: 1 bit for
+    a steady 1 Hz cadence, 9 bits for up to +-64 ms of jitter.
+  - The caller's buffer (internal RAM or PSRAM) is split into fixed
+    BLOCK_BYTES blocks used as a ring; when full, the oldest block is
+    dropped. append() touches only the newest block: O(1).
+  - Each block carries a summary (time range, per-channel min/max/sum),
+    so downsampled scans skip decoding blocks that fall into one bucket.
+
+  Timestamps are compared with wrap-safe arithmetic; a history must span
+  less than 24 days of the clock.
+*/
+
+namespace History {
+
+enum Channel : uint8_t {
+  CH_PM1_0,
+  CH_PM2_5,
+  CH_PM4_0,
+  CH_PM10,
+  CH_HUMIDITY,
+  CH_TEMPERATURE,
+  CH_VOC,
+  CH_NOX,
+  CH_CO2,
+  CH_NC0_5,
+  CH_NC1_0,
+  CH_NC2_5,
+  CH_NC4_0,
+  CH_NC10,
+  CH_HCHO,
+  CHANNEL_COUNT
+};
+
+struct Ticks {
+  uint16_t v[CHANNEL_COUNT];
+};
+
+// Re-encodes decoded values as sensor ticks (NaN -> unknown marker).
+void toTicks(const Sen66Protocol::MeasuredValues &mv,
+             const Sen66Protocol::NumberConcentration &nc, Ticks &out);
+// Physical value of one tick; NaN for the unknown marker.
+float toValue(Channel ch, uint16_t tick);
+
+constexpr size_t BLOCK_BYTES = 4096;
+
+struct BlockSummary {
+  uint32_t firstMs;
+  uint32_t lastMs;
+  uint16_t count;
+  uint16_t bits; // used bits in the data block
+  // Per channel over valid samples, in signed tick units
+  uint16_t valid[CHANNEL_COUNT];
+  int32_t min[CHANNEL_COUNT];
+  int32_t max[CHANNEL_COUNT];
+  int32_t sum[CHANNEL_COUNT];
+};
+
+struct Bucket {
+  uint32_t startMs;
+  uint32_t count; // valid samples
+  float min;
+  float max;
+  double sum;
+  float mean() const { return count ? (float)(sum / count) : NAN; }
+};
+
+class Store;
+
+// Full-resolution, oldest-first iteration over the stored samples.
+class Cursor {
+public:
+  bool next(uint32_t &tMs, Ticks &out);
+
+private:
+  friend class Store;
+  bool openBlock();
+
+  const Store *_store = nullptr;
+  size_t _block = 0;  // age index, 0 = oldest live block
+  const uint8_t *_data = nullptr;
+  uint16_t _count = 0; // samples in the block
+  uint16_t _index = 0; // sample within the block
+  uint32_t _bitPos = 0;
+  uint32_t _prevMs = 0;
+  int32_t _prevDelta = 0;
+  Ticks _prev = {};
+};
+
+class Store {
+public:
+  // `storage` stays owned by the caller; needs room for at least two
+  // blocks plus their summaries (see bytesFor()).
+  Store(void *storage, size_t bytes);
+
+  static size_t bytesFor(size_t blocks) {
+    return blocks * (BLOCK_BYTES + sizeof(BlockSummary));
+  }
+
+  bool append(uint32_t tMs, const Ticks &t);
+  void clear();
+
+  uint32_t samples() const { return _samples; }
+  size_t blocks() const { return _live; }
+  size_t capacityBlocks() const { return _blockCount; }
+  uint32_t oldestMs() const;
+  uint32_t newestMs() const;
+  // Encoded bits of all live blocks plus their summaries
+  size_t usedBytes() const;
+  float bytesPerSample() const {
+    return _samples ? (float)usedBytes() / _samples : 0.0f;
+  }
+
+  // Downsampled read of one channel over [fromMs, toMs): out[i] covers
+  // fromMs + i * bucketMs. Blocks that fall completely into one bucket
+  // are merged from their summary without decoding. Returns the number
+  // of buckets written.
+  size_t scan(Channel ch, uint32_t fromMs, uint32_t toMs, uint32_t bucketMs,
+              Bucket *out, size_t maxOut) const;
+
+  Cursor cursor() const;
+
+private:
+  friend class Cursor;
+
+  const BlockSummary &summaryAt(size_t age) const;
+  const uint8_t *dataAt(size_t age) const;
+  void startBlock(uint32_t tMs);
+  void writeBits(uint32_t value, uint8_t n);
+
+  BlockSummary *_summaries;
+  uint8_t *_data;
+  size_t _blockCount;
+  size_t _live = 0;
+  size_t _head = 0; // newest block
+  uint32_t _samples = 0;
+
+  // Encoder state of the newest block
+  uint32_t _prevMs = 0;
+  int32_t _prevDelta = 0;
+  Ticks _prev = {};
+};
+
+} // namespace History
@@ -0,0 +1,359 @@
+// lib/Iaq/FluxCsv.cpp
+#include "FluxCsv.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+size_t splitCsvLine(const char *line, size_t len, CsvField *cols, size_t maxCols)
+{
+  size_t count = 0;
+  size_t start = 0;
+  for (size_t i = 0; i <= len && count < maxCols; ++i)
+  {
+    if (i == len || line[i] == ',')
+    {
+      cols[count].ptr = line + start;
+      cols[count].len = i - start;
+      ++count;
+      start = i + 1;
+    }
+  }
+  return count;
+}
+
+static bool fieldEquals(const CsvField &f, const char *s)
+{
+  const size_t n = strlen(s);
+  return f.len == n && memcmp(f.ptr, s, n) == 0;
+}
+
+static float fieldToFloat(const CsvField &f)
+{
+  char buf[32];
+  const size_t n = f.len < sizeof(buf) - 1 ? f.len : sizeof(buf) - 1;
+  memcpy(buf, f.ptr, n);
+  buf[n] = '\0';
+  return strtof(buf, nullptr);
+}
+
+static bool isSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// Empty cell (a field the source never sent) = NaN
+static float cellToFloat(const CsvField &f)
+{
+  return f.len == 0 ? NAN : fieldToFloat(f);
+}
+
+// Non-negative whole-number cell (sequence numbers, ms times), past
+// float precision but exact as a double. Empty or negative = 0.
+static uint64_t cellToUInt(const CsvField &f)
+{
+  // Plain digits, the usual case, without the copy for strtod
+  uint64_t whole = 0;
+  size_t i = 0;
+  for (; i < f.len && i < 19 && f.ptr[i] >= '0' && f.ptr[i] <= '9'; ++i)
+  {
+    whole = whole * 10 + static_cast<uint64_t>(f.ptr[i] - '0');
+  }
+  if (i == f.len)
+  {
+    return whole;
+  }
+  char buf[32];
+  const size_t n = f.len < sizeof(buf) - 1 ? f.len : sizeof(buf) - 1;
+  memcpy(buf, f.ptr, n);
+  buf[n] = '\0';
+  const double v = strtod(buf, nullptr);
+  return v > 0 && v < 1.8e19 ? static_cast<uint64_t>(v) : 0;
+}
+
+static bool digits(const char *s, size_t n, int &out)
+{
+  out = 0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    if (s[i] < '0' || s[i] > '9')
+    {
+      return false;
+    }
+    out = out * 10 + (s[i] - '0');
+  }
+  return true;
+}
+
+// Days from 1970-01-01 to y-m-d (proleptic Gregorian)
+static int64_t daysFromCivil(int y, int m, int d)
+{
+  y -= m <= 2;
+  const int era = (y >= 0 ? y : y - 399) / 400;
+  const int yoe = y - era * 400;
+  const int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return static_cast<int64_t>(era) * 146097 + doe - 719468;
+}
+
+bool parseRfc3339(const char *s, size_t len, int64_t &epochMs)
+{
+  // YYYY-MM-DDTHH:MM:SS[.fraction]Z
+  int year, month, day, hour, minute, second;
+  if (len < 20 || s[4] != '-' || s[7] != '-' || s[10] != 'T' ||
+      s[13] != ':' || s[16] != ':' || s[len - 1] != 'Z' ||
+      !digits(s, 4, year) || !digits(s + 5, 2, month) ||
+      !digits(s + 8, 2, day) || !digits(s + 11, 2, hour) ||
+      !digits(s + 14, 2, minute) || !digits(s + 17, 2, second))
+  {
+    return false;
+  }
+  if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 ||
+      minute > 59 || second > 60)
+  {
+    return false;
+  }
+  int ms = 0;
+  if (len > 20)
+  {
+    // ".f" up to nanoseconds; only the first three digits count
+    if (s[19] != '.' || len < 22)
+    {
+      return false;
+    }
+    int scale = 100;
+    for (size_t i = 20; i < len - 1; ++i)
+    {
+      if (s[i] < '0' || s[i] > '9')
+      {
+        return false;
+      }
+      ms += (s[i] - '0') * scale;
+      scale /= 10;
+    }
+  }
+  else if (s[19] != 'Z')
+  {
+    return false;
+  }
+  const int64_t days = daysFromCivil(year, month, day);
+  epochMs = ((days * 24 + hour) * 60 + minute) * 60000LL + second * 1000LL + ms;
+  return true;
+}
+
+// Next non-blank, non-annotation line of payload from pos; false at the end
+static bool nextCsvLine(const char *payload, size_t len, size_t &pos,
+                        size_t &lineStart, size_t &lineEnd)
+{
+  while (pos < len)
+  {
+    const char *nl = static_cast<const char *>(memchr(payload + pos, '\n', len - pos));
+    const size_t next = nl ? static_cast<size_t>(nl - payload) : len;
+    lineStart = pos;
+    lineEnd = next;
+    pos = next + 1;
+    while (lineStart < lineEnd && isSpace(payload[lineStart]))
+      ++lineStart;
+    while (lineEnd > lineStart && isSpace(payload[lineEnd - 1]))
+      --lineEnd;
+    if (lineStart != lineEnd && payload[lineStart] != '#')
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool parseFluxResponse(const char *payload, size_t len, LatestFields &out,
+                       SampleStamp &stamp)
+{
+  bool gotAny = false;
+  int valueIdx = -1;
+  int fieldIdx = -1;
+  int timeIdx = -1;
+  bool gotSeq = false;
+  int64_t newestField = 0;
+  size_t pos = 0;
+  size_t lineStart, lineEnd;
+
+  while (nextCsvLine(payload, len, pos, lineStart, lineEnd))
+  {
+    CsvField cols[12];
+    const size_t count = splitCsvLine(payload + lineStart, lineEnd - lineStart, cols, 12);
+    if (count == 0)
+    {
+      continue;
+    }
+
+    bool isHeader = false;
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (fieldEquals(cols[i], "_field"))
+      {
+        fieldIdx = static_cast<int>(i);
+        isHeader = true;
+      }
+      else if (fieldEquals(cols[i], "_value"))
+      {
+        valueIdx = static_cast<int>(i);
+        isHeader = true;
+      }
+      else if (fieldEquals(cols[i], "_time"))
+      {
+        timeIdx = static_cast<int>(i);
+      }
+    }
+    if (isHeader)
+    {
+      continue;
+    }
+
+    if (fieldIdx < 0 || valueIdx < 0 || fieldIdx >= static_cast<int>(count) ||
+        valueIdx >= static_cast<int>(count))
+    {
+      continue;
+    }
+
+    const CsvField &field = cols[fieldIdx];
+    int64_t timeMs = 0;
+    const bool hasTime = timeIdx >= 0 && timeIdx < static_cast<int>(count);
+    if (fieldEquals(field, "seq"))
+    {
+      stamp.seq = static_cast<uint32_t>(cellToUInt(cols[valueIdx]));
+      if (!hasTime ||
+          !parseRfc3339(cols[timeIdx].ptr, cols[timeIdx].len, timeMs))
+      {
+        timeMs = 0;
+      }
+      stamp.timeMs = timeMs;
+      gotSeq = true;
+      continue;
+    }
+    const float value = fieldToFloat(cols[valueIdx]);
+    bool scored = true;
+    if (fieldEquals(field, "pm2_5"))
+    {
+      out.pm25 = value;
+      gotAny = true;
+    }
+    else if (fieldEquals(field, "pm10"))
+    {
+      out.pm10 = value;
+      gotAny = true;
+    }
+    else if (fieldEquals(field, "co2"))
+    {
+      out.co2 = value;
+      gotAny = true;
+    }
+    else if (fieldEquals(field, "voc"))
+    {
+      out.voc = value;
+      gotAny = true;
+    }
+    else if (fieldEquals(field, "nox"))
+    {
+      out.nox = value;
+      gotAny = true;
+    }
+    else
+    {
+      scored = false;
+    }
+    if (scored && !gotSeq && hasTime &&
+        parseRfc3339(cols[timeIdx].ptr, cols[timeIdx].len, timeMs) &&
+        timeMs > newestField)
+    {
+      newestField = timeMs;
+    }
+  }
+  if (!gotSeq)
+  {
+    stamp.timeMs = newestField;
+  }
+  return gotAny;
+}
+
+// Columns of the multi-room pivot, in header order of appearance
+enum RoomColumn
+{
+  COL_DEVICE,
+  COL_SENSOR,
+  COL_ROOM,
+  COL_PM25,
+  COL_PM10,
+  COL_CO2,
+  COL_VOC,
+  COL_NOX,
+  COL_SEQ,
+  COL_ACQUIRED_MS,
+  ROOM_COLUMN_COUNT
+};
+
+static const char *const ROOM_COLUMNS[ROOM_COLUMN_COUNT] = {
+    "device", "sensor", "room", "pm2_5", "pm10", "co2", "voc", "nox",
+    "seq", "acquired_ms"};
+
+size_t parseFluxRooms(const char *payload, size_t len, RoomTable &table)
+{
+  static constexpr size_t MAX_COLS = 16;
+  int idx[ROOM_COLUMN_COUNT];
+  for (int &i : idx)
+    i = -1;
+  size_t rows = 0;
+  size_t pos = 0;
+  size_t lineStart, lineEnd;
+  while (nextCsvLine(payload, len, pos, lineStart, lineEnd))
+  {
+    CsvField cols[MAX_COLS];
+    const size_t count = splitCsvLine(payload + lineStart, lineEnd - lineStart, cols, MAX_COLS);
+
+    // A header starts each table; rows follow until the next one
+    bool isHeader = false;
+    for (size_t i = 0; i < count && !isHeader; ++i)
+    {
+      isHeader = fieldEquals(cols[i], "device");
+    }
+    if (isHeader)
+    {
+      for (int c = 0; c < ROOM_COLUMN_COUNT; ++c)
+      {
+        idx[c] = -1;
+        for (size_t i = 0; i < count; ++i)
+        {
+          if (fieldEquals(cols[i], ROOM_COLUMNS[c]))
+          {
+            idx[c] = static_cast<int>(i);
+            break;
+          }
+        }
+      }
+      continue;
+    }
+    if (idx[COL_DEVICE] < 0 || idx[COL_DEVICE] >= static_cast<int>(count))
+    {
+      continue;
+    }
+
+    static const CsvField EMPTY = {"", 0};
+    auto cell = [&](RoomColumn c) -> const CsvField &
+    {
+      return idx[c] >= 0 && idx[c] < static_cast<int>(count) ? cols[idx[c]] : EMPTY;
+    };
+    LatestFields fields;
+    fields.pm25 = cellToFloat(cell(COL_PM25));
+    fields.pm10 = cellToFloat(cell(COL_PM10));
+    fields.co2 = cellToFloat(cell(COL_CO2));
+    fields.voc = cellToFloat(cell(COL_VOC));
+    fields.nox = cellToFloat(cell(COL_NOX));
+    SampleStamp stamp;
+    stamp.seq = static_cast<uint32_t>(cellToUInt(cell(COL_SEQ)));
+    stamp.timeMs = static_cast<int64_t>(cellToUInt(cell(COL_ACQUIRED_MS)));
+    const CsvField &device = cell(COL_DEVICE);
+    const CsvField &sensor = cell(COL_SENSOR);
+    const CsvField &room = cell(COL_ROOM);
+    table.update(device.ptr, device.len, sensor.ptr, sensor.len, room.ptr,
+                 room.len, fields, stamp);
+    rows++;
+  }
+  return rows;
+}
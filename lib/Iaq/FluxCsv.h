@@ -0,0 +1,37 @@
+// lib/Iaq/FluxCsv.h
+#pragma once
+#include <stddef.h>
+
+#include "Freshness.h"
+#include "Iaq.h"
+#include "RoomTable.h"
+
+// A column of a CSV line; points into the parsed buffer, not terminated.
+struct CsvField
+{
+  const char *ptr;
+  size_t len;
+};
+
+// Splits one CSV line (no quoting) into at most maxCols fields.
+size_t splitCsvLine(const char *line, size_t len, CsvField *cols, size_t maxCols);
+
+// An RFC 3339 UTC time as Influx writes _time ("2026-10-18T08:30:20Z",
+// optionally with a fraction) in ms since epoch; false if malformed.
+bool parseRfc3339(const char *s, size_t len, int64_t &epochMs);
+
+// Parses an InfluxDB annotated/plain CSV response with _field/_value columns
+// into `out`. Returns true if at least one scored field was found. The
+// "seq" row, if any, gives `stamp` its number and (from _time) its
+// acquisition time; without one the newest _time of the scored fields
+// is the time.
+bool parseFluxResponse(const char *payload, size_t len, LatestFields &out,
+                       SampleStamp &stamp);
+
+// Parses the lamp's multi-room response: one pivoted row per source with
+// device, sensor and room columns, one column per scored field (empty =
+// missing) and the newest sample's "seq" and "acquired_ms" (ms since
+// epoch), as many tables as Influx sends. Each row goes straight into
+// `table` (between its beginUpdate()/endUpdate()). Returns the number of
+// rows read.
+size_t parseFluxRooms(const char *payload, size_t len, RoomTable &table);
@@ -0,0 +1,114 @@
+// lib/Iaq/Freshness.cpp
+#include "Freshness.h"
+
+#include <stdio.h>
+
+bool isNewSample(const SampleStamp &s, const SampleStamp &before)
+{
+  return s.timeMs != 0 && (s.timeMs != before.timeMs || s.seq != before.seq);
+}
+
+Staleness staleness(const SampleStamp &s, int64_t nowMs, uint32_t budgetMs,
+                    uint32_t *ageMs)
+{
+  if (s.timeMs == 0 || nowMs <= 0)
+  {
+    return STALENESS_UNKNOWN;
+  }
+  const int64_t age = nowMs > s.timeMs ? nowMs - s.timeMs : 0;
+  if (ageMs)
+  {
+    *ageMs = age > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(age);
+  }
+  return age > budgetMs ? STALENESS_STALE : STALENESS_FRESH;
+}
+
+void LatencyStats::record(uint32_t ms)
+{
+  _count++;
+  _sumMs += ms;
+  if (ms > _maxMs)
+  {
+    _maxMs = ms;
+  }
+  if (_keptCount < CAPACITY)
+  {
+    _kept[_keptCount++] = ms;
+    _sorted = false;
+    return;
+  }
+  // Reservoir sampling: the n-th latency replaces a kept one with
+  // probability CAPACITY / n
+  _random ^= _random << 13;
+  _random ^= _random >> 17;
+  _random ^= _random << 5;
+  const uint32_t slot = _random % _count;
+  if (slot < CAPACITY)
+  {
+    _kept[slot] = ms;
+    _sorted = false;
+  }
+}
+
+uint32_t LatencyStats::meanMs() const
+{
+  return _count ? static_cast<uint32_t>(_sumMs / _count) : 0;
+}
+
+void LatencyStats::sort()
+{
+  // Insertion sort: at most CAPACITY entries, once per report
+  for (uint16_t i = 1; i < _keptCount; ++i)
+  {
+    const uint32_t v = _kept[i];
+    uint16_t j = i;
+    while (j > 0 && _kept[j - 1] > v)
+    {
+      _kept[j] = _kept[j - 1];
+      --j;
+    }
+    _kept[j] = v;
+  }
+  _sorted = true;
+}
+
+uint32_t LatencyStats::percentileMs(uint8_t pct)
+{
+  if (_keptCount == 0)
+  {
+    return 0;
+  }
+  if (!_sorted)
+  {
+    sort();
+  }
+  const uint32_t rank = (static_cast<uint32_t>(_keptCount) * pct + 99) / 100;
+  return _kept[rank > 0 ? rank - 1 : 0];
+}
+
+size_t LatencyStats::formatFields(char *buf, size_t cap, const char *prefix)
+{
+  const int n = snprintf(buf, cap,
+                         ",%s_count=%lui,%s_mean_ms=%lui,%s_p50_ms=%lui,"
+                         "%s_p90_ms=%lui,%s_p99_ms=%lui,%s_max_ms=%lui",
+                         prefix, static_cast<unsigned long>(_count), prefix,
+                         static_cast<unsigned long>(meanMs()), prefix,
+                         static_cast<unsigned long>(percentileMs(50)), prefix,
+                         static_cast<unsigned long>(percentileMs(90)), prefix,
+                         static_cast<unsigned long>(percentileMs(99)), prefix,
+                         static_cast<unsigned long>(_maxMs));
+  if (n < 0 || static_cast<size_t>(n) >= cap)
+  {
+    return 0;
+  }
+  return static_cast<size_t>(n);
+}
+
+void LatencyStats::reset()
+{
+  _keptCount = 0;
+  _sorted = true;
+  _count = 0;
+  _sumMs = 0;
+  _maxMs = 0;
+}
@@ -0,0 +1,70 @@
+// lib/Iaq/Freshness.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Newest sample behind a set of fields: the node's acquisition time and
+// its number on the node ("seq" on the environment lines). 0 = unknown,
+// e.g. from a node that does not write seq yet.
+struct SampleStamp
+{
+  int64_t timeMs = 0; // ms since epoch
+  uint32_t seq = 0;
+};
+
+// A different sample than `before` (a node that rebooted counts seq
+// from 1 again, so any change counts); false while the time is unknown
+bool isNewSample(const SampleStamp &s, const SampleStamp &before);
+
+enum Staleness : uint8_t
+{
+  STALENESS_UNKNOWN, // no acquisition time, or no wall clock yet
+  STALENESS_FRESH,
+  STALENESS_STALE // older than the freshness budget
+};
+
+// Age of the sample at nowMs (0 if stamped in the future), against
+// budgetMs. nowMs <= 0: the lamp's clock is not set.
+Staleness staleness(const SampleStamp &s, int64_t nowMs, uint32_t budgetMs,
+                    uint32_t *ageMs = nullptr);
+
+/*
+  Acquisition-to-display latency over a reporting interval: from the
+  node taking a sample to the lamp first showing it. Count, mean and max
+  are exact; the percentiles come from a reservoir of up to CAPACITY
+  latencies, a uniform sample of the interval once more than that were
+  recorded. Fixed size, never allocates.
+*/
+class LatencyStats
+{
+public:
+  static constexpr uint16_t CAPACITY = 128;
+
+  void record(uint32_t ms);
+
+  uint32_t count() const { return _count; }
+  uint32_t maxMs() const { return _maxMs; }
+  uint32_t meanMs() const;
+  // Nearest-rank percentile (0..100) of the kept latencies, 0 if none
+  uint32_t percentileMs(uint8_t pct);
+
+  // Appends ",<prefix>_count=..i,<prefix>_mean_ms=..i" and the p50, p90,
+  // p99 and max fields the same way. Returns the length written, 0 if it
+  // didn't fit. The interval is kept: reset() once the line was accepted,
+  // so a failed upload's latencies go out with the next one.
+  size_t formatFields(char *buf, size_t cap, const char *prefix);
+
+  // Starts a new interval
+  void reset();
+
+private:
+  void sort();
+
+  uint32_t _kept[CAPACITY];
+  uint16_t _keptCount = 0;
+  bool _sorted = true;
+  uint32_t _count = 0;
+  uint64_t _sumMs = 0;
+  uint32_t _maxMs = 0;
+  uint32_t _random = 0x9E3779B9u;
+};
@@ -0,0 +1,111 @@
+// lib/Iaq/Iaq.cpp
+#include "Iaq.h"
+
+float clampf(float v, float a, float b)
+{
+  return (v < a) ? a : (v > b ? b : v);
+}
+
+float lin(float x, float x0, float x1, float y0, float y1)
+{
+  if (x <= x0)
+    return y0;
+  if (x >= x1)
+    return y1;
+  return y0 + (y1 - y0) * ((x - x0) / (x1 - x0));
+}
+
+float scorePM25(float v)
+{
+  if (!isfinite(v))
+    return NAN;
+  if (v <= 10)
+    return lin(v, 0, 10, 0, 20);
+  if (v <= 25)
+    return lin(v, 10, 25, 20, 50);
+  if (v <= 50)
+    return lin(v, 25, 50, 50, 75);
+  if (v <= 75)
+    return lin(v, 50, 75, 75, 90);
+  return 100;
+}
+
+float scorePM10(float v)
+{
+  if (!isfinite(v))
+    return NAN;
+  if (v <= 20)
+    return lin(v, 0, 20, 0, 20);
+  if (v <= 45)
+    return lin(v, 20, 45, 20, 60);
+  if (v <= 100)
+    return lin(v, 45, 100, 60, 90);
+  return 100;
+}
+
+float scoreCO2(float v)
+{
+  if (!isfinite(v))
+    return NAN;
+  if (v <= 800)
+    return lin(v, 400, 800, 0, 20);
+  if (v <= 1000)
+    return lin(v, 800, 1000, 20, 40);
+  if (v <= 1400)
+    return lin(v, 1000, 1400, 40, 70);
+  if (v <= 2000)
+    return lin(v, 1400, 2000, 70, 90);
+  return 100;
+}
+
+float scoreVOC(float v)
+{
+  if (!isfinite(v))
+    return NAN;
+  if (v <= 100)
+    return 10;
+  if (v <= 200)
+    return lin(v, 100, 200, 10, 60);
+  if (v <= 300)
+    return lin(v, 200, 300, 60, 85);
+  if (v <= 500)
+    return lin(v, 300, 500, 85, 100);
+  return 100;
+}
+
+float scoreNOx(float v)
+{
+  if (!isfinite(v))
+    return NAN;
+  if (v <= 100)
+    return 10;
+  if (v <= 200)
+    return lin(v, 100, 200, 10, 60);
+  if (v <= 300)
+    return lin(v, 200, 300, 60, 85);
+  if (v <= 500)
+    return lin(v, 300, 500, 85, 100);
+  return 100;
+}
+
+float computeIAQ(const LatestFields &f)
+{
+  float worst = NAN;
+  const float scores[] = {
+      scorePM25(f.pm25),
+      scorePM10(f.pm10),
+      scoreCO2(f.co2),
+      scoreVOC(f.voc),
+      scoreNOx(f.nox)};
+  for (float s : scores)
+  {
+    if (isnan(s))
+      continue;
+    worst = (isnan(worst) || s > worst) ? s : worst;
+  }
+  if (isnan(worst))
+  {
+    return NAN;
+  }
+  return clampf(worst, 0, 100);
+}
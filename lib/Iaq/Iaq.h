@@ -0,0 +1,26 @@
+// lib/Iaq/Iaq.h
+#pragma once
+#include <math.h>
+
+// Latest values of the five fields the lamp scores (NaN = missing).
+struct LatestFields
+{
+  float pm25 = NAN;
+  float pm10 = NAN;
+  float co2 = NAN;
+  float voc = NAN;
+  float nox = NAN;
+};
+
+float clampf(float v, float a, float b);
+float lin(float x, float x0, float x1, float y0, float y1);
+
+// Sub-scores 0 (good) .. 100 (bad), NaN for non-finite input
+float scorePM25(float v);
+float scorePM10(float v);
+float scoreCO2(float v);
+float scoreVOC(float v);
+float scoreNOx(float v);
+
+// Worst of the available sub-scores, NaN if none is available
+float computeIAQ(const LatestFields &f);
@@ -0,0 +1,113 @@
+// lib/Iaq/RoomTable.cpp
+#include "RoomTable.h"
+
+#include <string.h>
+
+// Copies a non-terminated span, truncated to the destination
+static void copySpan(char *dst, size_t cap, const char *src, size_t len)
+{
+  const size_t n = len < cap - 1 ? len : cap - 1;
+  memcpy(dst, src, n);
+  dst[n] = '\0';
+}
+
+static bool spanEquals(const char *s, const char *span, size_t len, size_t cap)
+{
+  const size_t n = len < cap - 1 ? len : cap - 1;
+  return strncmp(s, span, n) == 0 && s[n] == '\0';
+}
+
+// NaN-aware equality: a field that stays missing is unchanged
+static bool sameValue(float a, float b)
+{
+  return a == b || (isnan(a) && isnan(b));
+}
+
+static bool sameFields(const LatestFields &a, const LatestFields &b)
+{
+  return sameValue(a.pm25, b.pm25) && sameValue(a.pm10, b.pm10) &&
+         sameValue(a.co2, b.co2) && sameValue(a.voc, b.voc) &&
+         sameValue(a.nox, b.nox);
+}
+
+void RoomTable::beginUpdate()
+{
+  _generation++;
+  _recomputed = 0;
+  _overflow = 0;
+}
+
+bool RoomTable::update(const char *device, size_t deviceLen, const char *sensor,
+                       size_t sensorLen, const char *room, size_t roomLen,
+                       const LatestFields &fields, const SampleStamp &stamp)
+{
+  RoomEntry *e = nullptr;
+  for (uint8_t i = 0; i < _count; ++i)
+  {
+    RoomEntry &c = _entries[i];
+    if (spanEquals(c.device, device, deviceLen, sizeof(c.device)) &&
+        spanEquals(c.sensor, sensor, sensorLen, sizeof(c.sensor)))
+    {
+      e = &c;
+      break;
+    }
+  }
+  if (!e)
+  {
+    if (_count == MAX_ENTRIES)
+    {
+      _overflow++;
+      return false;
+    }
+    e = &_entries[_count++];
+    copySpan(e->device, sizeof(e->device), device, deviceLen);
+    copySpan(e->sensor, sizeof(e->sensor), sensor, sensorLen);
+    e->fields = LatestFields();
+    e->iaq = NAN;
+    e->stamp = SampleStamp();
+    e->generation = 0;
+  }
+  copySpan(e->room, sizeof(e->room), room, roomLen);
+  if (e->generation == 0 || !sameFields(e->fields, fields))
+  {
+    e->fields = fields;
+    e->iaq = computeIAQ(fields);
+    _recomputed++;
+  }
+  e->newSample = isNewSample(stamp, e->stamp);
+  e->stamp = stamp;
+  e->generation = _generation;
+  return true;
+}
+
+void RoomTable::endUpdate()
+{
+  uint8_t kept = 0;
+  for (uint8_t i = 0; i < _count; ++i)
+  {
+    if (_entries[i].generation != _generation)
+    {
+      continue;
+    }
+    if (kept != i)
+    {
+      _entries[kept] = _entries[i];
+    }
+    kept++;
+  }
+  _count = kept;
+}
+
+int RoomTable::worst() const
+{
+  int worst = -1;
+  for (uint8_t i = 0; i < _count; ++i)
+  {
+    const float iaq = _entries[i].iaq;
+    if (!isnan(iaq) && (worst < 0 || iaq > _entries[worst].iaq))
+    {
+      worst = i;
+    }
+  }
+  return worst;
+}
@@ -0,0 +1,61 @@
+// lib/Iaq/RoomTable.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Freshness.h"
+#include "Iaq.h"
+
+// One source of the multi-room lamp: a (device, sensor) series and the
+// room it is tagged with. Strings are truncated to fit.
+struct RoomEntry
+{
+  char device[33];
+  char sensor[9];
+  char room[25]; // empty if the node has no room tag
+  LatestFields fields;
+  float iaq = NAN;
+  SampleStamp stamp;       // newest sample of the source
+  bool newSample = false;  // stamp changed in the last round
+  uint32_t generation = 0; // last update() round that saw it
+};
+
+/*
+  Fixed-size table of the latest fields per source, filled row by row
+  from one grouped query (parseFluxRooms()). IAQ is recomputed only for a
+  row whose fields changed since the previous round; sources missing from
+  a round are dropped in endUpdate(). newSample marks the sources whose
+  newest sample changed, so each sample's latency is counted once. The
+  table never allocates.
+*/
+class RoomTable
+{
+public:
+  static constexpr uint8_t MAX_ENTRIES = 32;
+
+  // Starts a round of update() calls
+  void beginUpdate();
+  // Stores one source's fields and newest sample; false if the table
+  // is full
+  bool update(const char *device, size_t deviceLen, const char *sensor,
+              size_t sensorLen, const char *room, size_t roomLen,
+              const LatestFields &fields, const SampleStamp &stamp);
+  // Drops sources not seen since beginUpdate()
+  void endUpdate();
+
+  uint8_t size() const { return _count; }
+  const RoomEntry &entry(uint8_t i) const { return _entries[i]; }
+  // Index of the highest IAQ, -1 if no entry has one
+  int worst() const;
+  // IAQ recomputations in the last round (rows that changed)
+  uint8_t recomputed() const { return _recomputed; }
+  // Rows that did not fit in the last round
+  uint16_t overflow() const { return _overflow; }
+
+private:
+  RoomEntry _entries[MAX_ENTRIES];
+  uint8_t _count = 0;
+  uint32_t _generation = 0;
+  uint8_t _recomputed = 0;
+  uint16_t _overflow = 0;
+};
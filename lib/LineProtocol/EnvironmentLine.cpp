@@ -0,0 +1,82 @@
+// lib/LineProtocol/EnvironmentLine.cpp
+#include "EnvironmentLine.h"
+#include <math.h>
+
+float dewPoint(float tempC, float humidityRH) {
+  if (isnan(tempC) || isnan(humidityRH))
+    return NAN;
+  const float a = 17.62f;
+  const float b = 243.12f;
+  float gamma = (a * tempC) / (b + tempC) + logf(humidityRH / 100.0f);
+  return (b * gamma) / (a - gamma);
+}
+
+const EnvironmentFieldInfo ENVIRONMENT_FIELDS[ENV_FIELD_COUNT] = {
+    {"pm1_0", 1},    {"pm2_5", 1},       {"pm4_0", 1},     {"pm10", 1},
+    {"humidity", 2}, {"temperature", 2}, {"dew_point", 2}, {"voc", 1},
+    {"nox", 1},      {"co2", 0},         {"hcho", 1},      {"nc0_5", 1},
+    {"nc1_0", 1},    {"nc2_5", 1},       {"nc4_0", 1},     {"nc10", 1}};
+
+void environmentFieldValues(const Sen66Protocol::MeasuredValues &mv,
+                            const Sen66Protocol::NumberConcentration &nc,
+                            float out[ENV_FIELD_COUNT]) {
+  out[ENV_PM1_0] = mv.pm1_0;
+  out[ENV_PM2_5] = mv.pm2_5;
+  out[ENV_PM4_0] = mv.pm4_0;
+  out[ENV_PM10] = mv.pm10_0;
+  out[ENV_HUMIDITY] = mv.humidity_rh;
+  out[ENV_TEMPERATURE] = mv.temperature_c;
+  out[ENV_DEW_POINT] = dewPoint(mv.temperature_c, mv.humidity_rh);
+  out[ENV_VOC] = mv.voc_index;
+  out[ENV_NOX] = mv.nox_index;
+  out[ENV_CO2] = mv.co2_ppm;
+  out[ENV_HCHO] = mv.hcho_ppb;
+  out[ENV_NC0_5] = nc.nc0_5;
+  out[ENV_NC1_0] = nc.nc1_0;
+  out[ENV_NC2_5] = nc.nc2_5;
+  out[ENV_NC4_0] = nc.nc4_0;
+  out[ENV_NC10] = nc.nc10_0;
+}
+
+// Spelled out rather than looped over ENVIRONMENT_FIELDS so the
+// per-upload path keeps constant keys and digits. The model checks are
+// constants: fields the model lacks are compiled out.
+void encodeEnvironmentFields(LineProtocolWriter &w,
+                             const Sen66Protocol::MeasuredValues &mv,
+                             const Sen66Protocol::NumberConcentration &nc,
+                             uint32_t statusFlags, const char *seriesKey) {
+  const float dp = dewPoint(mv.temperature_c, mv.humidity_rh);
+  if (seriesKey)
+    w.seriesKey(seriesKey);
+  else
+    w.measurement("environment");
+  w.field("pm1_0", mv.pm1_0, 1);
+  w.field("pm2_5", mv.pm2_5, 1);
+  w.field("pm4_0", mv.pm4_0, 1);
+  w.field("pm10", mv.pm10_0, 1);
+  w.field("humidity", mv.humidity_rh, 2);
+  w.field("temperature", mv.temperature_c, 2);
+  w.field("dew_point", dp, 2);
+  if (environmentFieldMeasured(ENV_VOC)) {
+    w.field("voc", mv.voc_index, 1);
+    w.field("nox", mv.nox_index, 1);
+  }
+  if (environmentFieldMeasured(ENV_CO2))
+    w.field("co2", mv.co2_ppm, 0);
+  if (environmentFieldMeasured(ENV_HCHO))
+    w.field("hcho", mv.hcho_ppb, 1);
+  w.field("nc0_5", nc.nc0_5, 1);
+  w.field("nc1_0", nc.nc1_0, 1);
+  w.field("nc2_5", nc.nc2_5, 1);
+  w.field("nc4_0", nc.nc4_0, 1);
+  w.field("nc10", nc.nc10_0, 1);
+  w.fieldUInt("status", statusFlags);
+}
+
+void encodeEnvironmentLine(LineProtocolWriter &w,
+                           const Sen66Protocol::MeasuredValues &mv,
+                           const Sen66Protocol::NumberConcentration &nc,
+                           uint32_t statusFlags, const char *seriesKey) {
+  encodeEnvironmentFields(w, mv, nc, statusFlags, seriesKey);
+  w.endLine();
+}
@@ -0,0 +1,66 @@
+// lib/LineProtocol/EnvironmentLine.h
+#pragma once
+#include "LineProtocol.h"
+#include <Sen66Protocol.h>
+
+// Magnus formula (Sonntag 1990 constants), NaN if an input is invalid.
+float dewPoint(float tempC, float humidityRH);
+
+// Float fields of the 'environment' line, in line order. Fields the
+// build model does not measure (environmentFieldMeasured) are never
+// written.
+enum EnvironmentField : uint8_t {
+  ENV_PM1_0,
+  ENV_PM2_5,
+  ENV_PM4_0,
+  ENV_PM10,
+  ENV_HUMIDITY,
+  ENV_TEMPERATURE,
+  ENV_DEW_POINT,
+  ENV_VOC,
+  ENV_NOX,
+  ENV_CO2,
+  ENV_HCHO,
+  ENV_NC0_5,
+  ENV_NC1_0,
+  ENV_NC2_5,
+  ENV_NC4_0,
+  ENV_NC10,
+  ENV_FIELD_COUNT
+};
+
+struct EnvironmentFieldInfo {
+  const char *name;
+  uint8_t digits;
+};
+
+extern const EnvironmentFieldInfo ENVIRONMENT_FIELDS[ENV_FIELD_COUNT];
+
+// Whether SEN6X_MODEL measures field f (Sen6x.h)
+constexpr bool environmentFieldMeasured(EnvironmentField f) {
+  return ((f != ENV_VOC && f != ENV_NOX) ||
+          Sen66Protocol::BuildModel::HAS_VOC_NOX) &&
+         (f != ENV_CO2 || Sen66Protocol::BuildModel::HAS_CO2) &&
+         (f != ENV_HCHO || Sen66Protocol::BuildModel::HAS_HCHO);
+}
+
+// Values in EnvironmentField order (dew point derived), NaN if invalid
+void environmentFieldValues(const Sen66Protocol::MeasuredValues &mv,
+                            const Sen66Protocol::NumberConcentration &nc,
+                            float out[ENV_FIELD_COUNT]);
+
+// Appends the 'environment' line uploaded by the sensor node. seriesKey
+// is the precomputed "environment,<tags>" from buildSeriesKey(); null
+// writes an untagged line.
+void encodeEnvironmentLine(LineProtocolWriter &w,
+                           const Sen66Protocol::MeasuredValues &mv,
+                           const Sen66Protocol::NumberConcentration &nc,
+                           uint32_t statusFlags,
+                           const char *seriesKey = nullptr);
+// Same without ending the line, so the caller can add fields or end it
+// with a timestamp
+void encodeEnvironmentFields(LineProtocolWriter &w,
+                             const Sen66Protocol::MeasuredValues &mv,
+                             const Sen66Protocol::NumberConcentration &nc,
+                             uint32_t statusFlags,
+                             const char *seriesKey = nullptr);
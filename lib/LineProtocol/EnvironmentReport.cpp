@@ -0,0 +1,94 @@
+// lib/LineProtocol/EnvironmentReport.cpp
+#include "EnvironmentReport.h"
+
+const DeadbandPolicy ENVIRONMENT_DEADBAND[ENV_FIELD_COUNT] = {
+    {1.0f, 0.05f, 0},  // pm1_0 ug/m3
+    {1.0f, 0.05f, 0},  // pm2_5
+    {1.0f, 0.05f, 0},  // pm4_0
+    {1.0f, 0.05f, 0},  // pm10
+    {0.5f, 0.0f, 0},   // humidity %RH
+    {0.1f, 0.0f, 0},   // temperature C
+    {0.2f, 0.0f, 0},   // dew_point C
+    {3.0f, 0.0f, 0},   // voc index
+    {1.0f, 0.0f, 0},   // nox index
+    {15.0f, 0.02f, 0}, // co2 ppm
+    {2.0f, 0.05f, 0},  // hcho ppb
+    {2.0f, 0.05f, 0},  // nc0_5 #/cm3
+    {2.0f, 0.05f, 0},  // nc1_0
+    {2.0f, 0.05f, 0},  // nc2_5
+    {2.0f, 0.05f, 0},  // nc4_0
+    {2.0f, 0.05f, 0},  // nc10
+};
+
+void EnvironmentReport::begin(uint32_t heartbeatMs) {
+  for (uint8_t f = 0; f < ENV_FIELD_COUNT; ++f) {
+    DeadbandPolicy p = ENVIRONMENT_DEADBAND[f];
+    p.heartbeatMs = heartbeatMs;
+    _state.fields[f].setPolicy(p);
+  }
+  _state.reportedStatus = 0;
+  _state.statusReported = false;
+  _state.prevSeq = 0;
+  commit();
+}
+
+void EnvironmentReport::encode(LineProtocolWriter &w, const char *seriesKey,
+                               uint32_t sampleMs, uint32_t seq,
+                               const Sen66Protocol::MeasuredValues &mv,
+                               const Sen66Protocol::NumberConcentration &nc,
+                               bool statusValid, uint32_t statusFlags,
+                               uint32_t (*toEpochSeconds)(uint32_t)) {
+  float values[ENV_FIELD_COUNT];
+  environmentFieldValues(mv, nc, values);
+  ArchivedPoint points[ENV_FIELD_COUNT][SwingingDoor::MAX_POINTS];
+  uint8_t counts[ENV_FIELD_COUNT];
+  for (uint8_t f = 0; f < ENV_FIELD_COUNT; ++f)
+    counts[f] = environmentFieldMeasured((EnvironmentField)f)
+                    ? _state.fields[f].offer(sampleMs, values[f], points[f])
+                    : 0;
+
+  bool statusDue =
+      statusValid && (!_state.statusReported ||
+                      statusFlags != _state.reportedStatus);
+  uint8_t written[ENV_FIELD_COUNT] = {};
+  for (;;) {
+    // Oldest sample time with unwritten points
+    bool pending = false;
+    uint32_t t = 0;
+    for (uint8_t f = 0; f < ENV_FIELD_COUNT; ++f) {
+      if (written[f] == counts[f])
+        continue;
+      const uint32_t pt = points[f][written[f]].tMs;
+      if (!pending || (int32_t)(pt - t) < 0)
+        t = pt;
+      pending = true;
+    }
+    if (!pending && !statusDue)
+      break;
+    if (!pending)
+      t = sampleMs;
+
+    w.seriesKey(seriesKey);
+    for (uint8_t f = 0; f < ENV_FIELD_COUNT; ++f) {
+      if (written[f] == counts[f] || points[f][written[f]].tMs != t)
+        continue;
+      w.field(ENVIRONMENT_FIELDS[f].name, points[f][written[f]].value,
+              ENVIRONMENT_FIELDS[f].digits);
+      written[f]++;
+    }
+    if (statusDue && t == sampleMs) {
+      w.fieldUInt("status", statusFlags);
+      _state.reportedStatus = statusFlags;
+      _state.statusReported = true;
+      statusDue = false;
+    }
+    const uint32_t lineSeq = t == sampleMs        ? seq
+                             : t == _state.prevMs ? _state.prevSeq
+                                                  : 0;
+    if (lineSeq)
+      w.fieldUInt("seq", lineSeq);
+    w.endLine(toEpochSeconds(t));
+  }
+  _state.prevMs = sampleMs;
+  _state.prevSeq = seq;
+}
@@ -0,0 +1,54 @@
+// lib/LineProtocol/EnvironmentReport.h
+#pragma once
+#include "EnvironmentLine.h"
+#include <SwingingDoor.h>
+
+// Allowed reconstruction error per environment field: the larger of the
+// absolute (field units) and relative bound, no heartbeat. See
+// SwingingDoor.h.
+extern const DeadbandPolicy ENVIRONMENT_DEADBAND[ENV_FIELD_COUNT];
+
+/*
+  Change-driven 'environment' lines of one sensor, as the node uploads
+  them once its clock is set: every field goes through its swinging door
+  and only archived points are written, one line per sample time, each
+  stamped via toEpochSeconds(tMs). The status word is written only when
+  it changed. Every line carries its sample's number as "seq", so a
+  reader can tell how recent the newest line of the series is.
+
+  The lines of an encode() only count as delivered once the caller
+  commit()s them after a 2xx. rollback() goes back to the last commit,
+  so points and status changes of a failed upload are written again from
+  the next sample instead of being lost.
+*/
+class EnvironmentReport {
+public:
+  // ENVIRONMENT_DEADBAND with a heartbeat; forgets all state
+  void begin(uint32_t heartbeatMs);
+
+  // Feeds the sample taken at sampleMs (millis() clock), number seq, and
+  // writes the lines it completes, possibly none
+  void encode(LineProtocolWriter &w, const char *seriesKey, uint32_t sampleMs,
+              uint32_t seq, const Sen66Protocol::MeasuredValues &mv,
+              const Sen66Protocol::NumberConcentration &nc, bool statusValid,
+              uint32_t statusFlags, uint32_t (*toEpochSeconds)(uint32_t));
+
+  // The lines encoded since the last commit() were accepted
+  void commit() { _committed = _state; }
+  // They were not: forget the samples fed since the last commit()
+  void rollback() { _state = _committed; }
+
+private:
+  struct State {
+    SwingingDoor fields[ENV_FIELD_COUNT];
+    uint32_t reportedStatus = 0;
+    bool statusReported = false;
+    // The sample fed before the current one: archived points are either
+    // the current sample or the one held back from there
+    uint32_t prevMs = 0;
+    uint32_t prevSeq = 0;
+  };
+
+  State _state;
+  State _committed;
+};
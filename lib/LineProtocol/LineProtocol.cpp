@@ -0,0 +1,190 @@
+// lib/LineProtocol/LineProtocol.cpp
+#include "LineProtocol.h"
+#include <math.h>
+#include <string.h>
+
+LineProtocolWriter::LineProtocolWriter(char *buf, size_t cap)
+    : _buf(buf), _cap(cap) {
+  reset();
+}
+
+void LineProtocolWriter::reset() {
+  _len = 0;
+  _lineStart = 0;
+  _fields = 0;
+  _overflow = false;
+  if (_cap)
+    _buf[0] = '\0';
+}
+
+void LineProtocolWriter::put(char c) {
+  // Keep one byte for the terminator
+  if (_len + 1 >= _cap) {
+    _overflow = true;
+    return;
+  }
+  _buf[_len++] = c;
+  _buf[_len] = '\0';
+}
+
+void LineProtocolWriter::put(const char *s) {
+  while (*s)
+    put(*s++);
+}
+
+// Escapes the characters that are significant in measurements and tags
+void LineProtocolWriter::putEscaped(const char *s) {
+  for (; *s; ++s) {
+    if (*s == ' ' || *s == ',' || *s == '=')
+      put('\\');
+    put(*s);
+  }
+}
+
+void LineProtocolWriter::putUInt(uint32_t v) {
+  char tmp[10];
+  uint8_t n = 0;
+  do {
+    tmp[n++] = (char)('0' + v % 10);
+    v /= 10;
+  } while (v);
+  while (n)
+    put(tmp[--n]);
+}
+
+// Fixed-point formatting without printf; rounds half away from zero.
+void LineProtocolWriter::putFixed(float value, uint8_t digits) {
+  static const uint32_t POW10[] = {1, 10, 100, 1000, 10000, 100000};
+  if (digits > 5)
+    digits = 5;
+  double v = value;
+  if (v < 0) {
+    v = -v;
+  }
+  const uint64_t scaled = (uint64_t)(v * POW10[digits] + 0.5);
+  const uint64_t ip = scaled / POW10[digits];
+  const uint32_t fp = (uint32_t)(scaled % POW10[digits]);
+  if (value < 0 && scaled != 0)
+    put('-');
+  if (ip > UINT32_MAX) {
+    _overflow = true;
+    return;
+  }
+  putUInt((uint32_t)ip);
+  if (digits) {
+    put('.');
+    for (uint32_t d = POW10[digits] / 10; d; d /= 10)
+      put((char)('0' + (fp / d) % 10));
+  }
+}
+
+void LineProtocolWriter::measurement(const char *name) {
+  _lineStart = _len;
+  _fields = 0;
+  putEscaped(name);
+}
+
+void LineProtocolWriter::seriesKey(const char *key) {
+  _lineStart = _len;
+  _fields = 0;
+  put(key);
+}
+
+void LineProtocolWriter::tag(const char *key, const char *value) {
+  put(',');
+  putEscaped(key);
+  put('=');
+  putEscaped(value);
+}
+
+size_t buildSeriesKey(char *buf, size_t cap, const char *measurement,
+                      const LineProtocolTag *tags, size_t count) {
+  // Insertion sort over indices; a handful of tags, built once at boot
+  uint8_t order[16];
+  if (count > sizeof(order))
+    return 0;
+  for (size_t i = 0; i < count; ++i) {
+    size_t j = i;
+    while (j > 0 && strcmp(tags[order[j - 1]].key, tags[i].key) > 0) {
+      order[j] = order[j - 1];
+      --j;
+    }
+    order[j] = (uint8_t)i;
+  }
+
+  LineProtocolWriter w(buf, cap);
+  w.measurement(measurement);
+  for (size_t i = 0; i < count; ++i) {
+    const LineProtocolTag &t = tags[order[i]];
+    if (t.value && *t.value)
+      w.tag(t.key, t.value);
+  }
+  return w.overflow() ? 0 : w.length();
+}
+
+void LineProtocolWriter::beginField(const char *key) {
+  put(_fields ? ',' : ' ');
+  put(key);
+  put('=');
+  _fields++;
+}
+
+void LineProtocolWriter::field(const char *key, float value, uint8_t digits) {
+  if (isnan(value) || isinf(value))
+    return;
+  beginField(key);
+  putFixed(value, digits);
+}
+
+void LineProtocolWriter::field(const char *key, int32_t value) {
+  beginField(key);
+  if (value < 0) {
+    put('-');
+    putUInt((uint32_t)(-(int64_t)value));
+  } else {
+    putUInt((uint32_t)value);
+  }
+}
+
+void LineProtocolWriter::fieldUInt(const char *key, uint32_t value) {
+  beginField(key);
+  putUInt(value);
+}
+
+void LineProtocolWriter::endLine() {
+  if (_fields == 0) {
+    // A line without fields is invalid; drop it
+    _len = _lineStart;
+    if (_cap)
+      _buf[_len] = '\0';
+    return;
+  }
+  put('\n');
+}
+
+void LineProtocolWriter::endLine(uint32_t timestamp) {
+  if (_fields == 0) {
+    endLine();
+    return;
+  }
+  put(' ');
+  putUInt(timestamp);
+  put('\n');
+}
+
+void LineProtocolWriter::endLine(uint32_t seconds, uint16_t millis) {
+  if (_fields == 0) {
+    endLine();
+    return;
+  }
+  put(' ');
+  if (seconds) {
+    putUInt(seconds);
+    put((char)('0' + millis / 100 % 10));
+    put((char)('0' + millis / 10 % 10));
+    put((char)('0' + millis % 10));
+  } else {
+    putUInt(millis);
+  }
+  put('\n');
+}
@@ -0,0 +1,71 @@
+// lib/LineProtocol/LineProtocol.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+  Allocation-free InfluxDB line-protocol writer into a caller-owned buffer.
+
+    LineProtocolWriter w(buf, sizeof(buf));
+    w.measurement("environment");
+    w.field("co2", 612.0f, 0);
+    w.endLine();
+
+  - NaN float fields are skipped (Influx rejects empty field values).
+  - Integers are written without the "i" suffix, matching the float-typed
+    series already in the bucket.
+  - On overflow the writer stops appending and overflow() turns true.
+  - Constant tag sets can be rendered once with buildSeriesKey() and
+    started with seriesKey() instead of measurement() + tag() per line.
+*/
+struct LineProtocolTag {
+  const char *key;
+  const char *value; // null or empty: tag omitted
+};
+
+// Renders "measurement,k1=v1,k2=v2" (escaped, tags sorted by key as Influx
+// stores them) into buf. Returns the length, or 0 if it doesn't fit.
+size_t buildSeriesKey(char *buf, size_t cap, const char *measurement,
+                      const LineProtocolTag *tags, size_t count);
+
+class LineProtocolWriter {
+public:
+  LineProtocolWriter(char *buf, size_t cap);
+
+  void reset();
+  void measurement(const char *name);
+  // Starts a line with a key from buildSeriesKey(); no escaping is done
+  void seriesKey(const char *key);
+  void tag(const char *key, const char *value);
+  void field(const char *key, float value, uint8_t digits);
+  void field(const char *key, int32_t value);
+  void fieldUInt(const char *key, uint32_t value);
+  void endLine();
+  // Ends the line with an explicit timestamp in the write's precision
+  // (e.g. seconds with &precision=s)
+  void endLine(uint32_t timestamp);
+  // Same in ms (&precision=ms), given as epoch seconds + milliseconds so
+  // no 64-bit formatting is needed
+  void endLine(uint32_t seconds, uint16_t millis);
+
+  const char *c_str() const { return _buf; }
+  size_t length() const { return _len; }
+  bool overflow() const { return _overflow; }
+  // Fields written on the current line
+  uint8_t fieldCount() const { return _fields; }
+
+private:
+  void put(char c);
+  void put(const char *s);
+  void putEscaped(const char *s);
+  void putUInt(uint32_t v);
+  void putFixed(float v, uint8_t digits);
+  void beginField(const char *key);
+
+  char *_buf;
+  size_t _cap;
+  size_t _len;
+  size_t _lineStart;
+  uint8_t _fields;
+  bool _overflow;
+};
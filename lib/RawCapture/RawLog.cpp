@@ -0,0 +1,62 @@
+// lib/RawCapture/RawLog.cpp
+#include "RawLog.h"
+
+#include <string.h>
+
+namespace RawCapture {
+
+Record makeRecord(uint8_t sensor, uint32_t monoMs, int64_t epochMs,
+                  const Sen66Protocol::RawValues &raw) {
+  Record r;
+  r.epochMs = epochMs;
+  r.monoMs = monoMs;
+  r.sensor = sensor;
+  r.flags = epochMs != 0 ? RECORD_CLOCK_SYNCED : 0;
+  r.humidity = raw.humidity;
+  r.temperature = raw.temperature;
+  r.vocTicks = raw.vocTicks;
+  r.noxTicks = raw.noxTicks;
+  r.co2 = raw.co2;
+  return r;
+}
+
+Log::Log(void *storage, size_t bytes)
+    : _records(static_cast<Record *>(storage)),
+      _capacity(bytes / sizeof(Record)) {}
+
+void Log::append(const Record &r) {
+  if (_capacity == 0)
+    return;
+  _records[_end % _capacity] = r;
+  _end++;
+  if (_count < _capacity)
+    _count++;
+}
+
+void Log::clear() {
+  // Sequence numbers keep counting so readers notice the reset
+  _count = 0;
+}
+
+const Record *Log::run(uint32_t seq, size_t &count) const {
+  count = 0;
+  if (seq - firstSeq() >= _count) // wrap-safe: also rejects seq < first
+    return nullptr;
+  const size_t slot = seq % _capacity;
+  const size_t toEnd = _end - seq;
+  const size_t toWrap = _capacity - slot;
+  count = toEnd < toWrap ? toEnd : toWrap;
+  return _records + slot;
+}
+
+FileHeader Log::header(uint32_t firstSeq, uint32_t count) {
+  FileHeader h;
+  memcpy(h.magic, "S6RW", 4);
+  h.version = FILE_VERSION;
+  h.recordSize = sizeof(Record);
+  h.firstSeq = firstSeq;
+  h.count = count;
+  return h;
+}
+
+} // namespace RawCapture
@@ -0,0 +1,105 @@
+// lib/RawCapture/RawLog.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Sen66Protocol.h>
+
+/*
+  Fixed-size binary log of SEN66 raw frames (0x0405), one record per
+  sensor and data-ready, for offline analysis of the signals behind the
+  compensated values and the VOC/NOx indexes.
+
+  File layout (as downloaded; little-endian, no padding, so a host tool
+  can mmap the file and view the records as an array):
+
+    offset  size  header (16 bytes)
+         0     4  magic "S6RW"
+         4     2  uint16  version (1)
+         6     2  uint16  record size (24)
+         8     4  uint32  sequence number of the first record
+        12     4  uint32  record count
+
+    offset  size  record (24 bytes, 8-byte aligned from offset 16)
+         0     8  int64   wall clock [ms since epoch], 0 if not synced
+         8     4  uint32  node millis() at data-ready
+        12     1  uint8   sensor index (SEN66_SENSORS order)
+        13     1  uint8   flags, RECORD_CLOCK_SYNCED
+        14     2  int16   humidity [%RH x100]
+        16     2  int16   temperature [°C x200]
+        18     2  uint16  VOC raw ticks
+        20     2  uint16  NOx raw ticks
+        22     2  uint16  CO2 [ppm], not interpolated
+
+  Unavailable signals keep the sensor's markers (0x7FFF / 0xFFFF).
+  Record n of a file has sequence number first + n; sequence numbers
+  count every record ever appended, so a reader that polls with the next
+  expected number sees a gap where the ring overwrote records.
+
+  The log is a ring over the caller's buffer (internal RAM or PSRAM):
+  append() overwrites the oldest record when full. run() hands out
+  records in place, so they can be written to a socket without copying.
+*/
+
+namespace RawCapture {
+
+constexpr uint8_t RECORD_CLOCK_SYNCED = 0x01;
+
+struct Record {
+  int64_t epochMs;
+  uint32_t monoMs;
+  uint8_t sensor;
+  uint8_t flags;
+  int16_t humidity;
+  int16_t temperature;
+  uint16_t vocTicks;
+  uint16_t noxTicks;
+  uint16_t co2;
+};
+
+struct FileHeader {
+  char magic[4];
+  uint16_t version;
+  uint16_t recordSize;
+  uint32_t firstSeq;
+  uint32_t count;
+};
+
+static_assert(sizeof(Record) == 24, "RawCapture::Record layout is fixed");
+static_assert(sizeof(FileHeader) == 16, "RawCapture::FileHeader layout is fixed");
+
+constexpr uint16_t FILE_VERSION = 1;
+
+Record makeRecord(uint8_t sensor, uint32_t monoMs, int64_t epochMs,
+                  const Sen66Protocol::RawValues &raw);
+
+class Log {
+public:
+  // `storage` stays owned by the caller; holds bytes / sizeof(Record)
+  // records.
+  Log(void *storage, size_t bytes);
+
+  void append(const Record &r);
+  void clear();
+
+  // Live records are [firstSeq(), endSeq())
+  uint32_t firstSeq() const { return _end - _count; }
+  uint32_t endSeq() const { return _end; }
+  size_t size() const { return _count; }
+  size_t capacity() const { return _capacity; }
+
+  // Contiguous records from seq on (at most up to the ring's wrap point
+  // or endSeq()); count is 0 when seq is not live.
+  const Record *run(uint32_t seq, size_t &count) const;
+
+  // Header of a file holding [firstSeq, firstSeq + count)
+  static FileHeader header(uint32_t firstSeq, uint32_t count);
+
+private:
+  Record *_records;
+  size_t _capacity;
+  size_t _count = 0;
+  uint32_t _end = 0; // sequence number of the next record
+};
+
+} // namespace RawCapture
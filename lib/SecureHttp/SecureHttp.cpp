@@ -0,0 +1,320 @@
+// lib/SecureHttp/SecureHttp.cpp
+#include "SecureHttp.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+
+static const char DRBG_PERSONALIZATION[] = "sen66-node";
+
+SecureHttp::~SecureHttp() {
+  if (!_initialised)
+    return;
+  _tls.stop();
+  mbedtls_ssl_config_free(&_conf);
+  mbedtls_x509_crt_free(&_ca);
+  mbedtls_ctr_drbg_free(&_drbg);
+  mbedtls_entropy_free(&_entropy);
+}
+
+bool SecureHttp::begin(const uint8_t *caDer, const uint16_t *lengths,
+                       uint8_t count) {
+  if (_initialised)
+    return _ready;
+  mbedtls_entropy_init(&_entropy);
+  mbedtls_ctr_drbg_init(&_drbg);
+  mbedtls_x509_crt_init(&_ca);
+  mbedtls_ssl_config_init(&_conf);
+  _initialised = true;
+
+  uint8_t parsed = 0;
+  for (uint8_t i = 0; i < count; caDer += lengths[i], ++i)
+    if (mbedtls_x509_crt_parse_der_nocopy(&_ca, caDer, lengths[i]) == 0)
+      parsed++;
+  if (parsed == 0)
+    return false;
+
+  if (mbedtls_ctr_drbg_seed(&_drbg, mbedtls_entropy_func, &_entropy,
+                            (const unsigned char *)DRBG_PERSONALIZATION,
+                            sizeof(DRBG_PERSONALIZATION) - 1) != 0 ||
+      mbedtls_ssl_config_defaults(&_conf, MBEDTLS_SSL_IS_CLIENT,
+                                  MBEDTLS_SSL_TRANSPORT_STREAM,
+                                  MBEDTLS_SSL_PRESET_DEFAULT) != 0)
+    return false;
+  mbedtls_ssl_conf_authmode(&_conf, MBEDTLS_SSL_VERIFY_REQUIRED);
+  mbedtls_ssl_conf_ca_chain(&_conf, &_ca, nullptr);
+  mbedtls_ssl_conf_rng(&_conf, mbedtls_ctr_drbg_random, &_drbg);
+  mbedtls_ssl_conf_session_tickets(&_conf, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+  _ready = true;
+  return true;
+}
+
+// "scheme://host[:port]/path" -> host, port, path ("" if none)
+static bool parseUrl(const char *s, bool &https, char *host, size_t cap,
+                     uint16_t &port, const char *&path) {
+  const char *p = strstr(s, "://");
+  if (!p)
+    return false;
+  https = (size_t)(p - s) == 5 && strncmp(s, "https", 5) == 0;
+  port = https ? 443 : 80;
+  p += 3;
+  const size_t len = strcspn(p, ":/?");
+  if (len == 0 || len >= cap)
+    return false;
+  memcpy(host, p, len);
+  host[len] = '\0';
+  if (p[len] == ':')
+    port = (uint16_t)atoi(p + len + 1);
+  path = p + len + strcspn(p + len, "/?");
+  return true;
+}
+
+bool SecureHttp::begin(HTTPClient &http, const String &url) {
+  bool https;
+  char host[TlsSessionCache::HOST_SIZE];
+  uint16_t port;
+  const char *path;
+  if (!parseUrl(url.c_str(), https, host, sizeof(host), port, path))
+    return false;
+  if (!https) {
+    _tls.stop();
+    if (port != _tcpPort || strcmp(host, _tcpHost) != 0) {
+      _tcp.stop();
+      strcpy(_tcpHost, host);
+      _tcpPort = port;
+    }
+    return http.begin(_tcp, url);
+  }
+  if (!_ready)
+    return false;
+  _tcp.stop();
+  if (!_tls.connectedTo(host, port))
+    _tls.stop();
+  return http.begin(_tls, url);
+}
+
+// ===== Requests without HTTPClient =====
+
+// The client for host:port, connected; reused if it already was
+WiFiClient *SecureHttp::connection(bool https, const char *host,
+                                   uint16_t port, uint32_t timeoutMs,
+                                   bool &reused) {
+  WiFiClient *c;
+  if (https) {
+    if (!_ready)
+      return nullptr;
+    _tcp.stop();
+    if (!_tls.connectedTo(host, port))
+      _tls.stop();
+    c = &_tls;
+  } else {
+    _tls.stop();
+    if (port != _tcpPort || strcmp(host, _tcpHost) != 0) {
+      _tcp.stop();
+      strcpy(_tcpHost, host);
+      _tcpPort = port;
+    }
+    c = &_tcp;
+  }
+  reused = c->connected();
+  if (reused)
+    return c;
+  // Socket, receive buffer and TLS contexts, freed by stop()
+  HEAP_GUARD_TRANSIENT();
+  return c->connect(host, port, (int32_t)timeoutMs) ? c : nullptr;
+}
+
+static bool startsWithNoCase(const char *s, const char *prefix) {
+  return strncasecmp(s, prefix, strlen(prefix)) == 0;
+}
+
+// Next line without its CRLF into _line (cut at LINE_SIZE - 1); returns
+// its length or an HTTPC_ERROR_* code
+int SecureHttp::readLine(WiFiClient &c, uint32_t timeoutMs) {
+  size_t len = 0;
+  unsigned long since = millis();
+  for (;;) {
+    if (c.available() <= 0) {
+      if (!c.connected())
+        return HTTPC_ERROR_CONNECTION_LOST;
+      if (millis() - since > timeoutMs)
+        return HTTPC_ERROR_READ_TIMEOUT;
+      delay(1);
+      continue;
+    }
+    const int ch = c.read();
+    if (ch < 0)
+      continue;
+    since = millis();
+    if (ch == '\n')
+      break;
+    if (len < sizeof(_line) - 1)
+      _line[len++] = (char)ch;
+  }
+  if (len > 0 && _line[len - 1] == '\r')
+    len--;
+  _line[len] = '\0';
+  return (int)len;
+}
+
+// n body bytes (SIZE_MAX: until the server closes), the part that fits
+// appended to response
+int SecureHttp::readBody(WiFiClient &c, size_t n, char *response, size_t cap,
+                         size_t &stored, uint32_t timeoutMs) {
+  const bool untilClose = n == SIZE_MAX;
+  unsigned long since = millis();
+  bool overflow = false;
+  while (n > 0) {
+    const int avail = c.available();
+    if (avail <= 0) {
+      if (!c.connected() && untilClose)
+        break;
+      if (!c.connected())
+        return HTTPC_ERROR_CONNECTION_LOST;
+      if (millis() - since > timeoutMs)
+        return HTTPC_ERROR_READ_TIMEOUT;
+      delay(1);
+      continue;
+    }
+    uint8_t *dst = (uint8_t *)_line;
+    size_t want = sizeof(_line);
+    if (response && stored + 1 < cap) {
+      dst = (uint8_t *)response + stored;
+      want = cap - 1 - stored;
+    } else if (response) {
+      overflow = true;
+    }
+    if (want > (size_t)avail)
+      want = (size_t)avail;
+    if (want > n)
+      want = n;
+    const int got = c.read(dst, want);
+    if (got <= 0)
+      continue;
+    since = millis();
+    if (dst != (uint8_t *)_line)
+      stored += (size_t)got;
+    if (!untilClose)
+      n -= (size_t)got;
+  }
+  return overflow ? HTTPC_ERROR_TOO_LESS_RAM : 0;
+}
+
+// Sends the request in _head plus the body and reads the response;
+// answered once the status line has arrived
+int SecureHttp::exchange(WiFiClient &c, size_t headLen, const uint8_t *body,
+                         size_t len, char *response, size_t cap,
+                         size_t *length, uint32_t timeoutMs, bool &answered) {
+  answered = false;
+  if (c.write((const uint8_t *)_head, headLen) != headLen)
+    return HTTPC_ERROR_SEND_HEADER_FAILED;
+  if (len > 0 && c.write(body, len) != len)
+    return HTTPC_ERROR_SEND_PAYLOAD_FAILED;
+
+  int r = readLine(c, timeoutMs);
+  if (r < 0)
+    return r;
+  answered = true;
+  int code;
+  if (sscanf(_line, "HTTP/1.%*d %d", &code) != 1)
+    return HTTPC_ERROR_NO_HTTP_SERVER;
+
+  size_t contentLength = SIZE_MAX;
+  bool chunked = false;
+  bool keepAlive = true;
+  while ((r = readLine(c, timeoutMs)) > 0) {
+    if (startsWithNoCase(_line, "Content-Length:"))
+      contentLength = strtoul(_line + 15, nullptr, 10);
+    else if (startsWithNoCase(_line, "Transfer-Encoding:"))
+      chunked = strstr(_line, "chunked") != nullptr;
+    else if (startsWithNoCase(_line, "Connection:"))
+      keepAlive = strstr(_line, "close") == nullptr;
+  }
+  if (r < 0)
+    return r;
+
+  size_t stored = 0;
+  int err = 0;
+  if (code == 204 || code == 304) {
+    // No body
+  } else if (chunked) {
+    for (;;) {
+      if ((r = readLine(c, timeoutMs)) < 0)
+        return r;
+      const size_t n = strtoul(_line, nullptr, 16);
+      if (n == 0)
+        break;
+      const int e = readBody(c, n, response, cap, stored, timeoutMs);
+      if (e == HTTPC_ERROR_TOO_LESS_RAM)
+        err = e;
+      else if (e < 0)
+        return e;
+      if ((r = readLine(c, timeoutMs)) < 0) // CRLF after the chunk
+        return r;
+    }
+    // Trailer up to the empty line
+    while ((r = readLine(c, timeoutMs)) > 0) {
+    }
+    if (r < 0)
+      return r;
+  } else {
+    if (contentLength == SIZE_MAX)
+      keepAlive = false;
+    err = readBody(c, contentLength, response, cap, stored, timeoutMs);
+    if (err < 0 && err != HTTPC_ERROR_TOO_LESS_RAM)
+      return err;
+  }
+  if (!keepAlive)
+    c.stop();
+  if (response)
+    response[stored] = '\0';
+  if (length)
+    *length = stored;
+  return err < 0 ? err : code;
+}
+
+int SecureHttp::request(const char *method, const char *url,
+                        const char *headers, const uint8_t *body, size_t len,
+                        char *response, size_t cap, size_t *length,
+                        uint32_t timeoutMs) {
+  bool https;
+  char host[TlsSessionCache::HOST_SIZE];
+  uint16_t port;
+  const char *path;
+  if (!parseUrl(url, https, host, sizeof(host), port, path))
+    return HTTPC_ERROR_CONNECTION_REFUSED;
+  if (response && cap == 0)
+    return HTTPC_ERROR_TOO_LESS_RAM;
+
+  int headLen = snprintf(_head, sizeof(_head),
+                         "%s %s%s HTTP/1.1\r\nHost: %s\r\n"
+                         "Connection: keep-alive\r\n%s",
+                         method, *path == '/' ? "" : "/", path, host,
+                         headers ? headers : "");
+  if (headLen > 0 && (size_t)headLen < sizeof(_head))
+    headLen += snprintf(_head + headLen, sizeof(_head) - headLen,
+                        len > 0 || strcmp(method, "POST") == 0
+                            ? "Content-Length: %u\r\n\r\n"
+                            : "\r\n",
+                        (unsigned)len);
+  if (headLen < 0 || (size_t)headLen >= sizeof(_head))
+    return HTTPC_ERROR_TOO_LESS_RAM;
+
+  // A kept-alive connection may have been closed by the server since the
+  // last request; that shows as a failure before any answer, so it is
+  // retried once on a new connection.
+  for (;;) {
+    bool reused;
+    WiFiClient *c = connection(https, host, port, timeoutMs, reused);
+    if (!c)
+      return HTTPC_ERROR_CONNECTION_REFUSED;
+    bool answered;
+    const int code = exchange(*c, (size_t)headLen, body, len, response, cap,
+                              length, timeoutMs, answered);
+    if (code >= 0 || code == HTTPC_ERROR_TOO_LESS_RAM)
+      return code;
+    c->stop();
+    if (!reused || answered)
+      return code;
+  }
+}
@@ -0,0 +1,100 @@
+// lib/SecureHttp/SecureHttp.h
+#pragma once
+#include <Arduino.h>
+#include <HTTPClient.h>
+#include <WiFiClient.h>
+#include <mbedtls/ctr_drbg.h>
+#include <mbedtls/entropy.h>
+#include <mbedtls/ssl.h>
+#include <mbedtls/x509_crt.h>
+
+#include "HeapGuard.h"
+#include "TlsClient.h"
+
+/*
+  The node's HTTP(S) transport: one TLS client with verified certificates
+  and a per-host session cache, one plain TCP client for http:// URLs.
+
+    secureHttp.begin(caDer, lengths, count);  // once, from setup()
+    HTTPClient http;
+    secureHttp.begin(http, url);              // instead of http.begin(url)
+    secureHttp.post(url, headers, body, len); // or without HTTPClient
+
+  Root CAs are DER blobs in flash (scripts/gen_config.py converts
+  TLS_CA_FILES) parsed in place, so the bundle costs only the parsed
+  certificate structures in RAM. The TLS configuration (RNG, CA chain,
+  verification required) is built once and shared by every connection.
+
+  Requests run one at a time from loop(), so a single TLS client serves
+  all hosts: HTTPClient keeps a keep-alive connection open for the next
+  request of the same HTTPClient, and begin() drops it when that request
+  goes to another host (HTTPClient would otherwise reuse it blindly).
+
+  post()/get() make the request themselves, for callers that must not
+  allocate once running: the request head is formatted into a member
+  buffer, the body is written straight from the caller's, and a
+  response body is read into a caller's buffer (chunked or not). The
+  connection is kept alive for the next request to the same host; one
+  that the server has closed meanwhile is retried once on a new
+  connection. Connecting is the only step that allocates (socket, TLS
+  buffers), inside a HEAP_GUARD_TRANSIENT() scope.
+*/
+class SecureHttp {
+public:
+  static constexpr uint32_t TIMEOUT_MS = 5000; // without data, per read
+  static constexpr size_t HEAD_SIZE = 768;     // request head
+  static constexpr size_t LINE_SIZE = 128;     // response header line, cut
+
+  SecureHttp() : _tls(_conf, _sessions) {}
+  ~SecureHttp();
+
+  // Parses the CA bundle and sets up the TLS configuration; true if at
+  // least one certificate was usable.
+  bool begin(const uint8_t *caDer, const uint16_t *lengths, uint8_t count);
+  // http.begin() on the TLS client for https URLs, plain TCP otherwise
+  bool begin(HTTPClient &http, const String &url);
+
+  // headers: extra header lines, each ending in "\r\n", or null. Return
+  // the HTTP status code, or an HTTPC_ERROR_* code (< 0).
+  int post(const char *url, const char *headers, const uint8_t *body,
+           size_t len, uint32_t timeoutMs = TIMEOUT_MS) {
+    return request("POST", url, headers, body, len, nullptr, 0, nullptr,
+                   timeoutMs);
+  }
+  // The body goes to response[0..cap-1), NUL terminated, its length to
+  // length; a longer one fails with HTTPC_ERROR_TOO_LESS_RAM.
+  int get(const char *url, const char *headers, char *response, size_t cap,
+          size_t &length, uint32_t timeoutMs = TIMEOUT_MS) {
+    return request("GET", url, headers, nullptr, 0, response, cap, &length,
+                   timeoutMs);
+  }
+
+  void onHandshake(void (*fn)(const TlsHandshakeStats &)) { _tls.onHandshake(fn); }
+
+private:
+  int request(const char *method, const char *url, const char *headers,
+              const uint8_t *body, size_t len, char *response, size_t cap,
+              size_t *length, uint32_t timeoutMs);
+  WiFiClient *connection(bool https, const char *host, uint16_t port,
+                         uint32_t timeoutMs, bool &reused);
+  int exchange(WiFiClient &c, size_t headLen, const uint8_t *body, size_t len,
+               char *response, size_t cap, size_t *length, uint32_t timeoutMs,
+               bool &answered);
+  int readLine(WiFiClient &c, uint32_t timeoutMs);
+  int readBody(WiFiClient &c, size_t n, char *response, size_t cap,
+               size_t &stored, uint32_t timeoutMs);
+
+  mbedtls_entropy_context _entropy;
+  mbedtls_ctr_drbg_context _drbg;
+  mbedtls_x509_crt _ca;
+  mbedtls_ssl_config _conf;
+  bool _initialised = false; // contexts above need freeing
+  bool _ready = false;       // configuration usable
+  TlsSessionCache _sessions;
+  TlsClient _tls;
+  WiFiClient _tcp;
+  char _tcpHost[TlsSessionCache::HOST_SIZE] = "";
+  uint16_t _tcpPort = 0;
+  char _head[HEAD_SIZE];
+  char _line[LINE_SIZE];
+};
@@ -0,0 +1,256 @@
+// lib/SecureHttp/TlsClient.cpp
+#include "TlsClient.h"
+
+#include <esp_heap_caps.h>
+#include <string.h>
+
+static constexpr uint32_t IO_TIMEOUT_MS = 5000;
+
+// ===== Session cache =====
+TlsSessionCache::TlsSessionCache() {
+  for (Slot &s : _slots) {
+    s.host[0] = '\0';
+    s.port = 0;
+    s.valid = false;
+    s.lastUse = 0;
+    mbedtls_ssl_session_init(&s.session);
+  }
+}
+
+TlsSessionCache::~TlsSessionCache() {
+  for (Slot &s : _slots)
+    mbedtls_ssl_session_free(&s.session);
+}
+
+TlsSessionCache::Slot *TlsSessionCache::slot(const char *host, uint16_t port) {
+  for (Slot &s : _slots)
+    if (s.valid && s.port == port && strcmp(s.host, host) == 0)
+      return &s;
+  return nullptr;
+}
+
+const mbedtls_ssl_session *TlsSessionCache::find(const char *host,
+                                                 uint16_t port) {
+  Slot *s = slot(host, port);
+  if (!s)
+    return nullptr;
+  s->lastUse = ++_uses;
+  return &s->session;
+}
+
+void TlsSessionCache::store(const char *host, uint16_t port,
+                            const mbedtls_ssl_context &ssl) {
+  if (strlen(host) >= HOST_SIZE)
+    return;
+  Slot *s = slot(host, port);
+  if (!s) {
+    s = &_slots[0];
+    for (Slot &c : _slots)
+      if (!c.valid || c.lastUse < s->lastUse)
+        s = &c;
+  }
+  // get_session() wants a fresh destination
+  mbedtls_ssl_session_free(&s->session);
+  mbedtls_ssl_session_init(&s->session);
+  s->valid = mbedtls_ssl_get_session(&ssl, &s->session) == 0;
+  strcpy(s->host, host);
+  s->port = port;
+  s->lastUse = ++_uses;
+}
+
+void TlsSessionCache::forget(const char *host, uint16_t port) {
+  Slot *s = slot(host, port);
+  if (!s)
+    return;
+  mbedtls_ssl_session_free(&s->session);
+  mbedtls_ssl_session_init(&s->session);
+  s->valid = false;
+}
+
+// ===== Connection =====
+int TlsClient::connect(IPAddress ip, uint16_t port) {
+  return connect(ip, port, (int32_t)IO_TIMEOUT_MS);
+}
+
+// Verification needs the name in the certificate; an address only
+// matches a certificate issued for that literal address.
+int TlsClient::connect(IPAddress ip, uint16_t port, int32_t timeoutMs) {
+  return connect(ip.toString().c_str(), port, timeoutMs);
+}
+
+int TlsClient::connect(const char *host, uint16_t port) {
+  return connect(host, port, (int32_t)IO_TIMEOUT_MS);
+}
+
+int TlsClient::connect(const char *host, uint16_t port, int32_t timeoutMs) {
+  stop();
+  if (!WiFiClient::connect(host, port, timeoutMs))
+    return 0;
+  return handshake(host, port, HANDSHAKE_TIMEOUT_MS) ? 1 : 0;
+}
+
+bool TlsClient::handshake(const char *host, uint16_t port, uint32_t timeoutMs) {
+  TlsHandshakeStats stats = {host, 0, 0, false, 0};
+  const uint32_t freeBefore = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+  uint32_t freeMin = freeBefore;
+  const uint32_t t0 = millis();
+
+  mbedtls_ssl_init(&_ssl);
+  _sslReady = true;
+  int ret = mbedtls_ssl_setup(&_ssl, &_config);
+  if (ret == 0)
+    ret = mbedtls_ssl_set_hostname(&_ssl, host);
+  const mbedtls_ssl_session *cached = _sessions.find(host, port);
+  if (ret == 0 && cached)
+    ret = mbedtls_ssl_set_session(&_ssl, cached);
+
+  bool sawCertificate = false;
+  if (ret == 0) {
+    mbedtls_net_init(&_net);
+    _net.fd = fd();
+    mbedtls_net_set_nonblock(&_net);
+    mbedtls_ssl_set_bio(&_ssl, &_net, mbedtls_net_send, mbedtls_net_recv,
+                        nullptr);
+    // Stepped rather than mbedtls_ssl_handshake() to see whether the
+    // server sent its certificate (full) or skipped it (resumed), and to
+    // sample the heap while the handshake state is alive
+    while (_ssl.state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+      if (_ssl.state == MBEDTLS_SSL_SERVER_CERTIFICATE)
+        sawCertificate = true;
+      ret = mbedtls_ssl_handshake_step(&_ssl);
+      const uint32_t freeNow = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+      if (freeNow < freeMin)
+        freeMin = freeNow;
+      if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) {
+        if (millis() - t0 > timeoutMs) {
+          ret = MBEDTLS_ERR_SSL_TIMEOUT;
+          break;
+        }
+        delay(2);
+        ret = 0;
+        continue;
+      }
+      if (ret != 0)
+        break;
+    }
+  }
+
+  stats.ms = millis() - t0;
+  stats.peakHeap = freeBefore - freeMin;
+  stats.resumed = ret == 0 && cached && !sawCertificate;
+  stats.error = ret;
+  if (ret == 0) {
+    _sessions.store(host, port, _ssl);
+    strncpy(_host, host, sizeof(_host) - 1);
+    _host[sizeof(_host) - 1] = '\0';
+    _port = port;
+    _tlsConnected = true;
+  } else if (cached) {
+    _sessions.forget(host, port);
+  }
+  if (_onHandshake)
+    _onHandshake(stats);
+  if (ret != 0)
+    fail();
+  return ret == 0;
+}
+
+bool TlsClient::connectedTo(const char *host, uint16_t port) {
+  return connected() && _port == port && strcmp(_host, host) == 0;
+}
+
+void TlsClient::fail() {
+  if (_sslReady) {
+    mbedtls_ssl_free(&_ssl);
+    _sslReady = false;
+  }
+  _tlsConnected = false;
+  _peeked = -1;
+  _host[0] = '\0';
+  WiFiClient::stop();
+}
+
+void TlsClient::stop() {
+  if (_tlsConnected)
+    mbedtls_ssl_close_notify(&_ssl); // best effort, non-blocking
+  fail();
+}
+
+// ===== I/O =====
+size_t TlsClient::write(const uint8_t *buf, size_t size) {
+  if (!_tlsConnected)
+    return 0;
+  size_t sent = 0;
+  const uint32_t t0 = millis();
+  while (sent < size) {
+    const int ret = mbedtls_ssl_write(&_ssl, buf + sent, size - sent);
+    if (ret > 0) {
+      sent += (size_t)ret;
+      continue;
+    }
+    if ((ret != MBEDTLS_ERR_SSL_WANT_WRITE && ret != MBEDTLS_ERR_SSL_WANT_READ) ||
+        millis() - t0 > IO_TIMEOUT_MS) {
+      stop();
+      break;
+    }
+    delay(1);
+  }
+  return sent;
+}
+
+int TlsClient::available() {
+  if (!_tlsConnected)
+    return _peeked >= 0 ? 1 : 0;
+  // A zero-length read pulls in the next record if one arrived
+  const int ret = mbedtls_ssl_read(&_ssl, nullptr, 0);
+  const int avail = (int)mbedtls_ssl_get_bytes_avail(&_ssl);
+  if (ret < 0 && ret != MBEDTLS_ERR_SSL_WANT_READ &&
+      ret != MBEDTLS_ERR_SSL_WANT_WRITE && avail == 0)
+    stop(); // peer closed or the connection broke
+  return avail + (_peeked >= 0 ? 1 : 0);
+}
+
+int TlsClient::read(uint8_t *buf, size_t size) {
+  if (size == 0)
+    return 0;
+  size_t n = 0;
+  if (_peeked >= 0) {
+    buf[n++] = (uint8_t)_peeked;
+    _peeked = -1;
+  }
+  if (n < size && _tlsConnected && available() > 0) {
+    const int ret = mbedtls_ssl_read(&_ssl, buf + n, size - n);
+    if (ret > 0)
+      n += (size_t)ret;
+    else if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE)
+      stop();
+  }
+  return n > 0 ? (int)n : -1;
+}
+
+int TlsClient::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+int TlsClient::peek() {
+  if (_peeked < 0) {
+    uint8_t c;
+    if (read(&c, 1) == 1)
+      _peeked = c;
+  }
+  return _peeked;
+}
+
+// Discards unread input, as WiFiClient::flush() does
+void TlsClient::flush() {
+  uint8_t scratch[64];
+  while (available() > 0 && read(scratch, sizeof(scratch)) > 0) {
+  }
+}
+
+uint8_t TlsClient::connected() {
+  if (_tlsConnected)
+    available();
+  return _tlsConnected;
+}
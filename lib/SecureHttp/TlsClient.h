@@ -0,0 +1,110 @@
+// lib/SecureHttp/TlsClient.h
+#pragma once
+#include <Arduino.h>
+#include <WiFiClient.h>
+#include <mbedtls/net_sockets.h>
+#include <mbedtls/ssl.h>
+
+/*
+  TLS 1.2 client on mbedTLS with certificate verification and session
+  resumption, usable as the WiFiClient of HTTPClient::begin(client, url).
+
+  WiFiClientSecure runs a full handshake for every connection: ECDHE,
+  certificate chain parsing and verification, the most CPU time and
+  transient heap a request costs. This client remembers the session (ID and
+  ticket) per host in a TlsSessionCache and offers it on the next
+  connection; a server that accepts it skips the key exchange and the
+  certificate, leaving two round trips and symmetric crypto. A rejected
+  or expired session costs nothing extra: the server answers with a full
+  handshake and the new session replaces the old one.
+
+  What resumption saves on the ESP32 (handshake ms and peak heap, full
+  against resumed) has not been measured yet; the README's HTTPS section
+  describes how, from the onHandshake() log lines.
+
+  The socket is WiFiClient's (TCP connect, timeouts); mbedTLS reads and
+  writes it non-blocking, like WiFiClientSecure does. Hostnames are
+  verified against the certificate (SNI + CN/SAN), so connect by name.
+*/
+
+// One handshake, as reported to the onHandshake() hook
+struct TlsHandshakeStats {
+  const char *host;
+  uint32_t ms;       // TCP connected to handshake done
+  uint32_t peakHeap; // bytes of heap in use at most, sampled per step
+  bool resumed;      // server accepted the cached session
+  int error;         // 0, or the mbedTLS error code
+};
+
+// Last session per host:port, least recently used slot replaced
+class TlsSessionCache {
+public:
+  static constexpr uint8_t SLOTS = 4;
+  static constexpr size_t HOST_SIZE = 64;
+
+  TlsSessionCache();
+  ~TlsSessionCache();
+
+  // Session to offer for host:port, null if none
+  const mbedtls_ssl_session *find(const char *host, uint16_t port);
+  void store(const char *host, uint16_t port, const mbedtls_ssl_context &ssl);
+  void forget(const char *host, uint16_t port);
+
+private:
+  struct Slot {
+    char host[HOST_SIZE];
+    uint16_t port;
+    bool valid;
+    uint32_t lastUse;
+    mbedtls_ssl_session session;
+  };
+  Slot *slot(const char *host, uint16_t port);
+
+  Slot _slots[SLOTS];
+  uint32_t _uses = 0;
+};
+
+class TlsClient : public WiFiClient {
+public:
+  static constexpr uint32_t HANDSHAKE_TIMEOUT_MS = 15000;
+
+  // config must be set up (CA chain, RNG, verification) and outlive the
+  // client
+  TlsClient(const mbedtls_ssl_config &config, TlsSessionCache &sessions)
+      : _config(config), _sessions(sessions) {}
+  ~TlsClient() { stop(); }
+
+  void onHandshake(void (*fn)(const TlsHandshakeStats &)) { _onHandshake = fn; }
+  // True while connected to host:port (HTTPClient reuses any connection)
+  bool connectedTo(const char *host, uint16_t port);
+
+  int connect(IPAddress ip, uint16_t port) override;
+  int connect(IPAddress ip, uint16_t port, int32_t timeoutMs) override;
+  int connect(const char *host, uint16_t port) override;
+  int connect(const char *host, uint16_t port, int32_t timeoutMs) override;
+  size_t write(uint8_t data) override { return write(&data, 1); }
+  size_t write(const uint8_t *buf, size_t size) override;
+  int available() override;
+  int read() override;
+  int read(uint8_t *buf, size_t size) override;
+  int peek() override;
+  void flush() override;
+  void stop() override;
+  uint8_t connected() override;
+
+private:
+  bool handshake(const char *host, uint16_t port, uint32_t timeoutMs);
+  void fail();
+
+  const mbedtls_ssl_config &_config;
+  TlsSessionCache &_sessions;
+  void (*_onHandshake)(const TlsHandshakeStats &) = nullptr;
+
+  mbedtls_ssl_context _ssl;
+  mbedtls_net_context _net;
+  bool _sslReady = false; // _ssl initialised, must be freed
+  bool _tlsConnected = false;
+  int _peeked = -1;
+  char _host[TlsSessionCache::HOST_SIZE] = "";
+  uint16_t _port = 0;
+};
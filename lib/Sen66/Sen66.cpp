@@ -1,210 +1,196 @@
 // lib/Sen66/Sen66.cpp
 #include "Sen66.h"
 
-// ===== CRC-8 (poly 0x31, init 0xFF) per datasheet =====
-uint8_t Sen66::crc8(const uint8_t *data, uint16_t count) {
-  uint8_t crc = 0xFF; // init
-  for (uint16_t i = 0; i < count; ++i) {
-    crc ^= data[i];
-    for (uint8_t b = 0; b < 8; ++b) {
-      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+#include <Telemetry.h>
+
+// attempts, delay [ms]. Reads are cheap to repeat; start gets more room
+// since the sensor NACKs for a while after power-up.
+const Sen66::RetryPolicy Sen66::RETRY_POLICY[CMD_COUNT] = {
+    {3, 100}, // CMD_START_MEASUREMENT
+    {2, 20},  // CMD_STOP_MEASUREMENT
+    {2, 2},   // CMD_DATA_READY
+    {2, 2},   // CMD_MEASURED_VALUES
+    {2, 2},   // CMD_NUMBER_CONCENTRATION
+    {2, 2},   // CMD_RAW_VALUES
+    {2, 2},   // CMD_DEVICE_STATUS
+    {3, 20},  // CMD_SERIAL_NUMBER
+    {2, 20},  // CMD_FAN_CLEANING
+    {3, 20},  // CMD_TEMPERATURE_OFFSET
+};
+
+template <typename Op> bool Sen66::withRetry(Command c, Op op) {
+  const RetryPolicy &p = RETRY_POLICY[c];
+  for (uint8_t attempt = 1;; ++attempt) {
+    if (op())
+      return true;
+    if (attempt >= p.attempts) {
+      _failures++;
+      return false;
     }
+    _retries++;
+    _bus.delayMs(p.delayMs);
   }
-  return crc;
 }
 
-bool Sen66::begin(int sda, int scl, uint32_t freq) {
-  _wire.begin();
-  _wire.setClock(freq);
-  delay(5);
-  return true;
+bool Sen66::sendCommand(uint16_t cmd) {
+  const uint8_t b[2] = {(uint8_t)(cmd >> 8), (uint8_t)(cmd & 0xFF)};
+  return _bus.write(I2C_ADDR, b, sizeof(b));
 }
 
-bool Sen66::sendCommand(uint16_t cmd) {
-  _wire.beginTransmission(I2C_ADDR);
-  _wire.write((uint8_t)(cmd >> 8));
-  _wire.write((uint8_t)(cmd & 0xFF));
-  uint8_t err = _wire.endTransmission();
-  return err == 0;
+bool Sen66::request(uint16_t cmd, Command c) {
+  return withRetry(c, [&]() { return sendCommand(cmd); });
 }
 
 bool Sen66::readBytes(uint8_t *buf, size_t len) {
-  size_t readLen = _wire.requestFrom((int)I2C_ADDR, (int)len);
-  if (readLen != len)
-    return false;
-  for (size_t i = 0; i < len; ++i)
-    buf[i] = (uint8_t)_wire.read();
-  return true;
+  if (_chainCmd == 0)
+    return _bus.read(I2C_ADDR, buf, len);
+  const uint8_t next[2] = {(uint8_t)(_chainCmd >> 8),
+                           (uint8_t)(_chainCmd & 0xFF)};
+  _chainCmd = 0;
+  return _bus.readThenWrite(I2C_ADDR, buf, len, next, sizeof(next),
+                            _chainSent);
 }
 
-bool Sen66::readTriplet(uint16_t &word) {
-  uint8_t b[3];
-  if (!readBytes(b, 3))
-    return false;
-  // Verify CRC over the two data bytes
-  if (crc8(b, 2) != b[2])
-    return false;
-  word = ((uint16_t)b[0] << 8) | b[1];
-  return true;
+bool Sen66::checkCrc(const uint8_t *word) {
+  if (crc8(word, 2) == word[2])
+    return true;
+  _bus.reportCorrupt();
+  return false;
 }
 
 bool Sen66::startMeasurement() {
-  if (!sendCommand(0x0021))
-    return false; // Start Continuous Measurement (SEN6x)
-  delay(50);      // execution time (ms)
+  // Start Continuous Measurement (SEN6x)
+  if (!withRetry(CMD_START_MEASUREMENT,
+                 [&]() { return sendCommand(0x0021); }))
+    return false;
+  _bus.delayMs(50); // execution time (ms)
   _measurementRunning = true;
   return true;
 }
 
 bool Sen66::stopMeasurement() {
-  if (!sendCommand(0x0104))
-    return false; // Stop Measurement (SEN6x)
-  delay(1000); // execution time (ms) - wait at least 1s before new measurement
+  if (!requestStopMeasurement())
+    return false;
+  _bus.delayMs(STOP_EXEC_TIME_MS);
+  return true;
+}
+
+bool Sen66::requestStopMeasurement() {
+  // Stop Measurement (SEN6x)
+  if (!withRetry(CMD_STOP_MEASUREMENT, [&]() { return sendCommand(0x0104); }))
+    return false;
   _measurementRunning = false;
   return true;
 }
 
 bool Sen66::dataReady(bool &ready) {
-  if (!sendCommand(0x0202))
-    return false; // Get Data Ready (SEN6x)
-  delay(20);
+  // Get Data Ready (SEN6x)
+  return withRetry(CMD_DATA_READY, [&]() {
+    if (!sendCommand(DATA_READY_CMD))
+      return false;
+    _bus.delayMs(READ_EXEC_TIME_MS);
+    return fetchDataReady(ready);
+  });
+}
+
+bool Sen66::fetchDataReady(bool &ready) {
   // Expect 3 bytes: padding(0x00), ready(0x00/0x01), CRC
   uint8_t b[3];
   if (!readBytes(b, 3))
     return false;
-  if (crc8(b, 2) != b[2])
+  if (!checkCrc(b))
     return false;
   ready = (b[1] == 0x01);
   return true;
 }
 
-float Sen66::scaleUInt16(uint16_t v, float scale, bool &valid) {
-  if (v == 0xFFFF) {
-    valid = false;
-    return NAN;
-  }
-  valid = true;
-  return (float)v / scale;
-}
-
-float Sen66::scaleInt16(int16_t v, float scale, bool &valid) {
-  if (v == 0x7FFF) {
-    valid = false;
-    return NAN;
-  }
-  valid = true;
-  return (float)v / scale;
-}
-
 bool Sen66::readMeasuredValues(MeasuredValues &out) {
-  if (!sendCommand(0x0300))
-    return false; // Read Measured Values (SEN66)
-  delay(20);
-
-  // 9 words, each with CRC => 9 * 3 = 27 bytes
-  uint16_t w;
-
-  // PM1.0 [µg/m3] (scale x10)
-  if (!readTriplet(w))
-    return false;
-  out.pm1_0 = scaleUInt16(w, 10.0f, out.valid_pm1_0);
-
-  // PM2.5
-  if (!readTriplet(w))
-    return false;
-  out.pm2_5 = scaleUInt16(w, 10.0f, out.valid_pm2_5);
-
-  // PM4.0
-  if (!readTriplet(w))
-    return false;
-  out.pm4_0 = scaleUInt16(w, 10.0f, out.valid_pm4_0);
-
-  // PM10.0
-  if (!readTriplet(w))
-    return false;
-  out.pm10_0 = scaleUInt16(w, 10.0f, out.valid_pm10_0);
-
-  // RH int16 (scale x100)
-  if (!readTriplet(w))
-    return false;
-  out.humidity_rh = scaleInt16((int16_t)w, 100.0f, out.valid_humidity);
-
-  // T int16 (scale x200)
-  if (!readTriplet(w))
-    return false;
-  out.temperature_c = scaleInt16((int16_t)w, 200.0f, out.valid_temperature);
+  // Read Measured Values (0x0300 on the SEN66)
+  return withRetry(CMD_MEASURED_VALUES, [&]() {
+    if (!sendCommand(MEASURED_VALUES_CMD))
+      return false;
+    _bus.delayMs(READ_EXEC_TIME_MS);
+    return fetchMeasuredValues(out);
+  });
+}
 
-  // VOC index int16 (scale x10)
-  if (!readTriplet(w))
+bool Sen66::fetchMeasuredValues(MeasuredValues &out) {
+  // SEN66: 9 words, each with CRC => 9 * 3 = 27 bytes, read as one
+  // transaction
+  uint8_t frame[Sen66Protocol::MEASURED_VALUES_FRAME_LEN];
+  if (!readBytes(frame, sizeof(frame)))
     return false;
-  out.voc_index = scaleInt16((int16_t)w, 10.0f, out.valid_voc);
-
-  // NOx index int16 (scale x10)
-  if (!readTriplet(w))
+  if (!Sen66Protocol::decodeMeasuredValues(frame, out)) {
+    TELEMETRY_ERROR(Telemetry::STAGE_I2C);
+    _bus.reportCorrupt();
     return false;
-  out.nox_index = scaleInt16((int16_t)w, 10.0f, out.valid_nox);
-
-  // CO2 ppm (uint16, direct)
-  if (!readTriplet(w))
-    return false;
-  if (w == 0xFFFF) {
-    out.valid_co2 = false;
-    out.co2_ppm = NAN;
-  } else {
-    out.valid_co2 = true;
-    out.co2_ppm = (float)w;
   }
-
   return true;
 }
 
 bool Sen66::readNumberConcentration(NumberConcentration &out) {
-  if (!sendCommand(0x0316))
-    return false; // Read Number Concentration (SEN6x)
-  delay(20);
+  // Read Number Concentration (SEN6x)
+  return withRetry(CMD_NUMBER_CONCENTRATION, [&]() {
+    if (!sendCommand(NUMBER_CONCENTRATION_CMD))
+      return false;
+    _bus.delayMs(READ_EXEC_TIME_MS);
+    return fetchNumberConcentration(out);
+  });
+}
 
-  uint16_t w;
-  // PM0.5 #/cm3 (scale x10)
-  if (!readTriplet(w))
+bool Sen66::fetchNumberConcentration(NumberConcentration &out) {
+  // 5 words, each with CRC => 5 * 3 = 15 bytes
+  uint8_t frame[Sen66Protocol::NUMBER_CONCENTRATION_FRAME_LEN];
+  if (!readBytes(frame, sizeof(frame)))
     return false;
-  out.nc0_5 = scaleUInt16(w, 10.0f, out.valid_nc0_5);
-
-  // PM1.0
-  if (!readTriplet(w))
+  if (!Sen66Protocol::decodeNumberConcentration(frame, out)) {
+    TELEMETRY_ERROR(Telemetry::STAGE_I2C);
+    _bus.reportCorrupt();
     return false;
-  out.nc1_0 = scaleUInt16(w, 10.0f, out.valid_nc1_0);
+  }
+  return true;
+}
 
-  // PM2.5
-  if (!readTriplet(w))
-    return false;
-  out.nc2_5 = scaleUInt16(w, 10.0f, out.valid_nc2_5);
+bool Sen66::readRawValues(RawValues &out) {
+  // Read Measured Raw Values (0x0405 on the SEN66)
+  return withRetry(CMD_RAW_VALUES, [&]() {
+    if (!sendCommand(RAW_VALUES_CMD))
+      return false;
+    _bus.delayMs(READ_EXEC_TIME_MS);
+    return fetchRawValues(out);
+  });
+}
 
-  // PM4.0
-  if (!readTriplet(w))
+bool Sen66::fetchRawValues(RawValues &out) {
+  // SEN66: 5 words, each with CRC => 5 * 3 = 15 bytes
+  uint8_t frame[Sen66Protocol::RAW_VALUES_FRAME_LEN];
+  if (!readBytes(frame, sizeof(frame)))
     return false;
-  out.nc4_0 = scaleUInt16(w, 10.0f, out.valid_nc4_0);
-
-  // PM10.0
-  if (!readTriplet(w))
+  if (!Sen66Protocol::decodeRawValues(frame, out)) {
+    TELEMETRY_ERROR(Telemetry::STAGE_I2C);
+    _bus.reportCorrupt();
     return false;
-  out.nc10_0 = scaleUInt16(w, 10.0f, out.valid_nc10_0);
-
+  }
   return true;
 }
 
 bool Sen66::readDeviceStatus(uint32_t &statusFlags) {
-  if (!sendCommand(0xD206))
-    return false; // Read Device Status (SEN6x)
-  delay(20);
+  // Read Device Status (SEN6x)
+  return withRetry(CMD_DEVICE_STATUS, [&]() {
+    if (!sendCommand(DEVICE_STATUS_CMD))
+      return false;
+    _bus.delayMs(READ_EXEC_TIME_MS);
+    return fetchDeviceStatus(statusFlags);
+  });
+}
 
+bool Sen66::fetchDeviceStatus(uint32_t &statusFlags) {
   // Expect 6 bytes: [MSB word][CRC][LSB word][CRC]
   uint8_t b[6];
   if (!readBytes(b, 6))
     return false;
 
-  if (crc8(b + 0, 2) != b[2])
-    return false;
-  if (crc8(b + 3, 2) != b[5])
+  if (!checkCrc(b + 0) || !checkCrc(b + 3))
     return false;
 
   statusFlags = ((uint32_t)b[0] << 24) | ((uint32_t)b[1] << 16) |
@@ -212,59 +198,78 @@ bool Sen66::readDeviceStatus(uint32_t &statusFlags) {
   return true;
 }
 
+bool Sen66::readSerialNumber(char *out, size_t cap) {
+  if (cap < 33)
+    return false;
+  // Get Serial Number (SEN6x): 16 words => 32 ASCII chars, NUL-padded
+  return withRetry(CMD_SERIAL_NUMBER, [&]() {
+    if (!sendCommand(0xD033))
+      return false;
+    _bus.delayMs(READ_EXEC_TIME_MS);
+    uint8_t b[48];
+    if (!readBytes(b, sizeof(b)))
+      return false;
+    size_t n = 0;
+    for (size_t i = 0; i < sizeof(b); i += 3) {
+      if (!checkCrc(b + i))
+        return false;
+      out[n++] = (char)b[i];
+      out[n++] = (char)b[i + 1];
+    }
+    out[n] = '\0';
+    return true;
+  });
+}
+
 bool Sen66::startFanCleaning() {
+  beginFanCleaning();
+  _bus.delayMs(STOP_EXEC_TIME_MS);
+  if (!cleanFan())
+    return false;
+
+  // Wait for cleaning to finish (required before restarting measurement)
+  _bus.delayMs(FAN_CLEANING_TIME_MS);
+
+  return finishFanCleaning();
+}
+
+void Sen66::beginFanCleaning() {
   // Save current state
-  bool wasRunning = _measurementRunning;
+  _resumeAfterCleaning = _measurementRunning;
 
   // Fan cleaning requires Idle mode.
   // We try to stop measurement just in case.
-  stopMeasurement(); // This sets _measurementRunning = false
-
-  if (!sendCommand(0x5607))
-    return false; // Start Fan Cleaning
+  requestStopMeasurement(); // This sets _measurementRunning = false
+}
 
-  // Wait for cleaning to finish (required before restarting measurement)
-  delay(10000);
+bool Sen66::cleanFan() {
+  // Start Fan Cleaning
+  return withRetry(CMD_FAN_CLEANING, [&]() { return sendCommand(0x5607); });
+}
 
+bool Sen66::finishFanCleaning() {
   // Restore state
-  if (wasRunning) {
+  if (_resumeAfterCleaning) {
     if (!startMeasurement()) {
       return false; // Failed to restart
     }
   }
-
   return true;
 }
 
 bool Sen66::setTemperatureOffsetParameters(int16_t offset, int16_t slope,
                                            uint16_t timeConstant) {
-  _wire.beginTransmission(I2C_ADDR);
-  // Command 0x60B2
-  _wire.write(0x60);
-  _wire.write(0xB2);
-
-  // Arg1: Offset
-  uint8_t b[2];
-  b[0] = (uint8_t)((uint16_t)offset >> 8);
-  b[1] = (uint8_t)((uint16_t)offset & 0xFF);
-  _wire.write(b[0]);
-  _wire.write(b[1]);
-  _wire.write(crc8(b, 2));
-
-  // Arg2: Slope
-  b[0] = (uint8_t)((uint16_t)slope >> 8);
-  b[1] = (uint8_t)((uint16_t)slope & 0xFF);
-  _wire.write(b[0]);
-  _wire.write(b[1]);
-  _wire.write(crc8(b, 2));
-
-  // Arg3: TimeConstant
-  b[0] = (uint8_t)(timeConstant >> 8);
-  b[1] = (uint8_t)(timeConstant & 0xFF);
-  _wire.write(b[0]);
-  _wire.write(b[1]);
-  _wire.write(crc8(b, 2));
-
-  uint8_t err = _wire.endTransmission();
-  return err == 0;
+  // Command 0x60B2, then three argument words with CRC
+  uint8_t b[11];
+  b[0] = 0x60;
+  b[1] = 0xB2;
+  const uint16_t args[3] = {(uint16_t)offset, (uint16_t)slope, timeConstant};
+  for (int i = 0; i < 3; ++i) {
+    uint8_t *w = b + 2 + i * 3;
+    w[0] = (uint8_t)(args[i] >> 8);
+    w[1] = (uint8_t)(args[i] & 0xFF);
+    w[2] = crc8(w, 2);
+  }
+  return withRetry(CMD_TEMPERATURE_OFFSET,
+                   [&]() { return _bus.write(I2C_ADDR, b, sizeof(b)); });
 }
@@ -1,7 +1,8 @@
 // lib/Sen66/Sen66.h
 #pragma once
-#include <Arduino.h>
-#include <Wire.h>
+#include <Sen66Protocol.h>
+
+#include "Sen66Bus.h"
 
 /*
   SEN66 I2C protocol notes (datasheet):
@@ -13,67 +14,141 @@
   :contentReference[oaicite:2]{index=2} 0x0300 Read Measured Values (SEN66).
   Returns 27 bytes (9 * [MSB, LSB, CRC]) with PMs, RH, T, VOC, NOx, CO2.
   :contentReference[oaicite:3]{index=3} 0x0316 Read Number Concentrations
-  (SEN6x). Returns PM0.5..PM10 number conc. (5 * triplets).
+  (SEN6x). Returns PM0.5..PM10 number conc. (5 * triplets). 0x0405 Read
+  Measured Raw Values (SEN66): raw RH, T, VOC/NOx ticks, CO2 (5 triplets).
   :contentReference[oaicite:4]{index=4} 0xD206 Read Device Status (uint32
   flags). :contentReference[oaicite:5]{index=5}
   - Data words are 16-bit MSB-first, each followed by CRC-8 (poly 0x31, init
   0xFF). :contentReference[oaicite:6]{index=6}
+  - The class drives any SEN6x: the two value reads use the commands and
+    frames of SEN6X_MODEL (Sen6x.h), every other command is shared.
 */
 
 class Sen66 {
 public:
-  struct MeasuredValues {
-    // Mass concentration [µg/m3]
-    float pm1_0, pm2_5, pm4_0, pm10_0;
-    // Ambient
-    float humidity_rh;   // [%]
-    float temperature_c; // [°C]
-    // Indexes
-    float voc_index; // unitless
-    float nox_index; // unitless
-    // Gas
-    float co2_ppm; // [ppm]
-    // Validity flags
-    bool valid_pm1_0, valid_pm2_5, valid_pm4_0, valid_pm10_0;
-    bool valid_humidity, valid_temperature, valid_voc, valid_nox, valid_co2;
-  };
+  using MeasuredValues = Sen66Protocol::MeasuredValues;
+  using NumberConcentration = Sen66Protocol::NumberConcentration;
+  using RawValues = Sen66Protocol::RawValues;
 
-  struct NumberConcentration {
-    // [particles/cm3]
-    float nc0_5, nc1_0, nc2_5, nc4_0, nc10_0;
-    bool valid_nc0_5, valid_nc1_0, valid_nc2_5, valid_nc4_0, valid_nc10_0;
+  // Bounded retries per command: a command that fails (NACK, short read,
+  // CRC mismatch) is re-run after delayMs, at most `attempts` times in
+  // all. Split-phase requests retry the command write only; a failed
+  // fetch is left to the caller (Sen66Array retries in its next round).
+  enum Command : uint8_t {
+    CMD_START_MEASUREMENT,
+    CMD_STOP_MEASUREMENT,
+    CMD_DATA_READY,
+    CMD_MEASURED_VALUES,
+    CMD_NUMBER_CONCENTRATION,
+    CMD_RAW_VALUES,
+    CMD_DEVICE_STATUS,
+    CMD_SERIAL_NUMBER,
+    CMD_FAN_CLEANING,
+    CMD_TEMPERATURE_OFFSET,
+    CMD_COUNT
   };
+  struct RetryPolicy {
+    uint8_t attempts;
+    uint16_t delayMs;
+  };
+  static const RetryPolicy RETRY_POLICY[CMD_COUNT];
 
-  explicit Sen66(TwoWire &w = Wire) : _wire(w) {}
+  explicit Sen66(Sen66Bus &bus) : _bus(bus) {}
 
-  bool begin(int sda = SEN66_I2C_SDA, int scl = SEN66_I2C_SCL,
-             uint32_t freq = SEN66_I2C_FREQ);
   bool startMeasurement();
+  // Blocking: the stop plus its STOP_EXEC_TIME_MS execution time
   bool stopMeasurement();
+  // The stop alone; send nothing else for STOP_EXEC_TIME_MS
+  static constexpr uint32_t STOP_EXEC_TIME_MS = 1000;
+  bool requestStopMeasurement();
   bool dataReady(bool &ready);
   bool readMeasuredValues(MeasuredValues &out);
   bool readNumberConcentration(NumberConcentration &out);
+  bool readRawValues(RawValues &out);
   bool readDeviceStatus(uint32_t &statusFlags);
+  // NUL-terminated ASCII serial (up to 32 chars); out needs cap >= 33
+  bool readSerialNumber(char *out, size_t cap);
+
+  // Split-phase reads: request*() sends the command, fetch*() reads the
+  // response at least READ_EXEC_TIME_MS later. The blocking calls above
+  // are request + wait + fetch; Sen66Array uses the halves to overlap the
+  // wait across several sensors.
+  static constexpr uint32_t READ_EXEC_TIME_MS = 20;
+  static constexpr uint16_t DATA_READY_CMD = 0x0202;
+  bool requestDataReady() { return request(DATA_READY_CMD, CMD_DATA_READY); }
+  bool fetchDataReady(bool &ready);
+  static constexpr uint16_t MEASURED_VALUES_CMD =
+      Sen66Protocol::BuildModel::MEASURED_VALUES_CMD;
+  static constexpr uint16_t RAW_VALUES_CMD =
+      Sen66Protocol::BuildModel::RAW_VALUES_CMD;
+  bool requestMeasuredValues() {
+    return request(MEASURED_VALUES_CMD, CMD_MEASURED_VALUES);
+  }
+  bool fetchMeasuredValues(MeasuredValues &out);
+  static constexpr uint16_t NUMBER_CONCENTRATION_CMD = 0x0316;
+  bool requestNumberConcentration() {
+    return request(NUMBER_CONCENTRATION_CMD, CMD_NUMBER_CONCENTRATION);
+  }
+  bool fetchNumberConcentration(NumberConcentration &out);
+  bool requestRawValues() { return request(RAW_VALUES_CMD, CMD_RAW_VALUES); }
+  bool fetchRawValues(RawValues &out);
+  static constexpr uint16_t DEVICE_STATUS_CMD = 0xD206;
+  bool requestDeviceStatus() {
+    return request(DEVICE_STATUS_CMD, CMD_DEVICE_STATUS);
+  }
+  bool fetchDeviceStatus(uint32_t &statusFlags);
+
+  // Pipelining for Sen66Array: the next fetch*() sends `cmd` (one of the
+  // *_CMD reads above) right after reading its response, in the same bus
+  // transaction where the bus allows it (Sen66Bus::readThenWrite).
+  // chainedSent() tells whether the command went out; if it didn't, send
+  // it with its request*() as usual.
+  void chainRequest(uint16_t cmd) {
+    _chainCmd = cmd;
+    _chainSent = false;
+  }
+  bool chainedSent() const { return _chainSent; }
 
   // Maintenance / Compensation
+  // Blocking: stop, clean, restore the previous measurement state
   bool startFanCleaning();
+  // Split form of startFanCleaning(), so the caller can wait without
+  // blocking and several sensors can share the waits: beginFanCleaning()
+  // saves the state and stops the measurement, cleanFan() starts the fan
+  // STOP_EXEC_TIME_MS later, finishFanCleaning() restores the state
+  // FAN_CLEANING_TIME_MS after that
+  static constexpr uint32_t FAN_CLEANING_TIME_MS = 10000;
+  void beginFanCleaning();
+  bool cleanFan();
+  bool finishFanCleaning();
   bool setTemperatureOffsetParameters(int16_t offset, int16_t slope,
                                       uint16_t timeConstant);
 
   static constexpr uint8_t I2C_ADDR = 0x6B;
 
+  bool measurementRunning() const { return _measurementRunning; }
+  // Attempts repeated under RETRY_POLICY, and commands that still failed
+  uint32_t retries() const { return _retries; }
+  uint32_t failures() const { return _failures; }
+
 private:
-  TwoWire &_wire;
+  Sen66Bus &_bus;
 
   // Low-level helpers
   bool sendCommand(uint16_t cmd);
+  bool request(uint16_t cmd, Command c);
   bool readBytes(uint8_t *buf, size_t len);
-  bool readTriplet(uint16_t &word);
-  static uint8_t crc8(const uint8_t *data, uint16_t count);
-
-  // Parse helpers
-  static float scaleUInt16(uint16_t v, float scale, bool &valid);
-  static float scaleInt16(int16_t v, float scale, bool &valid);
+  bool checkCrc(const uint8_t *word);
+  // Runs op() under c's retry policy
+  template <typename Op> bool withRetry(Command c, Op op);
+  static uint8_t crc8(const uint8_t *data, uint16_t count) {
+    return Sen66Protocol::crc8(data, count);
+  }
 
   bool _measurementRunning = false;
+  bool _resumeAfterCleaning = false;
+  uint16_t _chainCmd = 0; // chainRequest() for the next readBytes()
+  bool _chainSent = false;
+  uint32_t _retries = 0;
+  uint32_t _failures = 0;
 };
@@ -0,0 +1,172 @@
+// lib/Sen66/Sen66Array.cpp
+#include "Sen66Array.h"
+
+bool Sen66Array::add(Sen66 &sensor) {
+  if (_count >= MAX_SENSORS)
+    return false;
+  _sensors[_count++] = &sensor;
+  return true;
+}
+
+uint16_t Sen66Array::command(Phase phase) {
+  switch (phase) {
+  case PHASE_DATA_READY:
+    return Sen66::DATA_READY_CMD;
+  case PHASE_MEASURED_VALUES:
+    return Sen66::MEASURED_VALUES_CMD;
+  case PHASE_NUMBER_CONCENTRATION:
+    return Sen66::NUMBER_CONCENTRATION_CMD;
+  case PHASE_DEVICE_STATUS:
+    return Sen66::DEVICE_STATUS_CMD;
+  case PHASE_RAW_VALUES:
+    return Sen66::RAW_VALUES_CMD;
+  default:
+    return 0;
+  }
+}
+
+bool Sen66Array::request(Sen66 &s, Phase phase) {
+  switch (phase) {
+  case PHASE_DATA_READY:
+    return s.requestDataReady();
+  case PHASE_MEASURED_VALUES:
+    return s.requestMeasuredValues();
+  case PHASE_NUMBER_CONCENTRATION:
+    return s.requestNumberConcentration();
+  case PHASE_DEVICE_STATUS:
+    return s.requestDeviceStatus();
+  case PHASE_RAW_VALUES:
+    return s.requestRawValues();
+  default:
+    return false;
+  }
+}
+
+bool Sen66Array::fetch(uint8_t i, Phase phase) {
+  Sen66 &s = *_sensors[i];
+  Sample &out = _samples[i];
+  switch (phase) {
+  case PHASE_DATA_READY: {
+    bool ready = false;
+    return s.fetchDataReady(ready) && ready;
+  }
+  case PHASE_MEASURED_VALUES:
+    return s.fetchMeasuredValues(out.mv);
+  case PHASE_NUMBER_CONCENTRATION:
+    return s.fetchNumberConcentration(out.nc);
+  case PHASE_DEVICE_STATUS:
+    out.statusValid = s.fetchDeviceStatus(out.statusFlags);
+    if (!out.statusValid)
+      out.statusFlags = 0;
+    return true; // a sample without status is still a sample
+  case PHASE_RAW_VALUES:
+    out.rawValid = s.fetchRawValues(out.raw);
+    return true; // likewise without raw values
+  default:
+    return false;
+  }
+}
+
+void Sen66Array::issue(Phase phase, uint32_t nowMs) {
+  for (uint8_t k = 0; k < _count; ++k) {
+    const uint8_t i = (uint8_t)((_rrStart + k) % _count);
+    if (!(_active & (1u << i)))
+      continue;
+    if (!request(*_sensors[i], phase)) {
+      _active &= (uint8_t)~(1u << i);
+      _errors[i]++;
+    }
+  }
+  _phase = phase;
+  _phaseStartMs = nowMs;
+}
+
+void Sen66Array::collect(Phase phase, Phase next, uint32_t nowMs) {
+  // Data-ready decides whether a sensor goes on, so that answer is read
+  // before the next command is sent
+  const bool chain = next != PHASE_IDLE && phase != PHASE_DATA_READY;
+  for (uint8_t k = 0; k < _count; ++k) {
+    const uint8_t i = (uint8_t)((_rrStart + k) % _count);
+    if (!(_active & (1u << i)))
+      continue;
+    Sen66 &s = *_sensors[i];
+    if (chain)
+      s.chainRequest(command(next));
+    bool ready = true;
+    if (!fetch(i, phase)) {
+      _active &= (uint8_t)~(1u << i);
+      ready = phase == PHASE_DATA_READY; // not ready yet is no error
+    }
+    if (!ready)
+      _errors[i]++;
+    if (next == PHASE_IDLE || !(_active & (1u << i)) ||
+        (chain && s.chainedSent()))
+      continue;
+    if (!request(s, next)) {
+      _active &= (uint8_t)~(1u << i);
+      _errors[i]++;
+    }
+  }
+  if (next != PHASE_IDLE) {
+    _phase = next;
+    _phaseStartMs = nowMs;
+  }
+}
+
+bool Sen66Array::poll(uint32_t nowMs) {
+  if (_phase == PHASE_IDLE) {
+    if (_started && nowMs - _roundStartMs < DATA_READY_POLL_MS)
+      return false;
+    _started = true;
+    _roundStartMs = nowMs;
+    _active = 0;
+    for (uint8_t i = 0; i < _count; ++i)
+      if (_sensors[i]->measurementRunning())
+        _active |= (uint8_t)(1u << i);
+    if (_active == 0)
+      return false;
+    _lastPhase = _rawValues ? PHASE_RAW_VALUES : PHASE_DEVICE_STATUS;
+    issue(PHASE_DATA_READY, nowMs);
+    return false;
+  }
+
+  if (nowMs - _phaseStartMs < Sen66::READ_EXEC_TIME_MS)
+    return false;
+
+  const Phase phase = _phase;
+  const Phase next = phase == _lastPhase ? PHASE_IDLE : (Phase)(phase + 1);
+  collect(phase, next, nowMs);
+  if (phase == PHASE_DATA_READY)
+    _readyMs = nowMs;
+  if (_active != 0 && next != PHASE_IDLE)
+    return false;
+
+  // Round complete
+  const bool delivered = next == PHASE_IDLE && _active != 0;
+  _fresh = delivered ? _active : 0;
+  for (uint8_t i = 0; i < _count; ++i) {
+    if (!(_fresh & (1u << i)))
+      continue;
+    _samples[i].readyMs = _readyMs;
+    if (_lastPhase != PHASE_RAW_VALUES)
+      _samples[i].rawValid = false;
+  }
+  _valid |= _fresh;
+  _phase = PHASE_IDLE;
+  _rrStart = (uint8_t)((_rrStart + 1) % _count);
+  if (delivered)
+    _lastRoundMs = nowMs - _roundStartMs;
+  return delivered;
+}
+
+uint32_t Sen66Array::msUntilPoll(uint32_t nowMs) const {
+  uint32_t dueMs;
+  if (_phase != PHASE_IDLE)
+    dueMs = _phaseStartMs + Sen66::READ_EXEC_TIME_MS;
+  else if (_started)
+    dueMs = _roundStartMs + DATA_READY_POLL_MS;
+  else
+    return 0;
+  const int32_t left = (int32_t)(dueMs - nowMs);
+  return left > 0 ? (uint32_t)left : 0;
+}
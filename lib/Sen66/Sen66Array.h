@@ -0,0 +1,96 @@
+// lib/Sen66/Sen66Array.h
+#pragma once
+#include <stdint.h>
+
+#include "Sen66.h"
+
+/*
+  Round-robin acquisition for several SEN66 on one node (separate buses or
+  TCA9548A channels). Every read command costs a 20 ms execution wait; the
+  scheduler sends a command to all participating sensors, waits once, then
+  collects all responses, so one round takes 4 x 20 ms plus bus time
+  instead of N x 80 ms. poll() never blocks; call it from loop().
+
+  Round: data-ready -> measured values -> number concentration -> status
+  (-> raw values while setRawValues(true)). Each sensor's response is
+  read and its next command sent back to back, in one transaction where
+  the bus can combine them (Sen66::chainRequest), and behind a TCA9548A
+  with one channel select for both.
+  A sensor drops out of the round when it is not ready or a transfer
+  fails; it is retried in the next round. The start position rotates
+  every round so a misbehaving sensor doesn't always delay the same
+  neighbours.
+*/
+class Sen66Array {
+public:
+  static constexpr uint8_t MAX_SENSORS = 8;
+  static constexpr uint32_t DATA_READY_POLL_MS = 50;
+
+  struct Sample {
+    Sen66::MeasuredValues mv;
+    Sen66::NumberConcentration nc;
+    uint32_t statusFlags;
+    bool statusValid;
+    Sen66::RawValues raw; // only with setRawValues(true)
+    bool rawValid;
+    uint32_t readyMs; // poll() time at which data-ready reported the sample
+  };
+
+  bool add(Sen66 &sensor);
+  uint8_t size() const { return _count; }
+  Sen66 &sensor(uint8_t i) { return *_sensors[i]; }
+  // Adds the raw-values read to every round (one more 20 ms wait); takes
+  // effect with the next round
+  void setRawValues(bool on) { _rawValues = on; }
+  bool rawValues() const { return _rawValues; }
+
+  // Advances the acquisition state machine. Returns true when a round
+  // finished and at least one sensor delivered a sample.
+  bool poll(uint32_t nowMs);
+  // Time until poll() has something to do, for callers that sleep
+  // between polls (src/gateway); 0 when it is due
+  uint32_t msUntilPoll(uint32_t nowMs) const;
+
+  bool newSample(uint8_t i) const { return _fresh & (1u << i); }
+  bool hasSample(uint8_t i) const { return _valid & (1u << i); }
+  const Sample &sample(uint8_t i) const { return _samples[i]; }
+  uint32_t errors(uint8_t i) const { return _errors[i]; }
+  // Duration of the last completed round, first command to last read
+  uint32_t lastRoundMs() const { return _lastRoundMs; }
+
+private:
+  enum Phase : uint8_t {
+    PHASE_IDLE,
+    PHASE_DATA_READY,
+    PHASE_MEASURED_VALUES,
+    PHASE_NUMBER_CONCENTRATION,
+    PHASE_DEVICE_STATUS,
+    PHASE_RAW_VALUES,
+  };
+
+  static uint16_t command(Phase phase);
+  bool request(Sen66 &s, Phase phase);
+  bool fetch(uint8_t i, Phase phase);
+  void issue(Phase phase, uint32_t nowMs);
+  // Reads phase's responses and sends next's commands (PHASE_IDLE: the
+  // round ends)
+  void collect(Phase phase, Phase next, uint32_t nowMs);
+
+  Sen66 *_sensors[MAX_SENSORS] = {};
+  Sample _samples[MAX_SENSORS] = {};
+  uint32_t _errors[MAX_SENSORS] = {};
+  uint8_t _count = 0;
+
+  Phase _phase = PHASE_IDLE;
+  uint8_t _active = 0; // bitmask of sensors still in this round
+  uint8_t _fresh = 0;  // sensors that delivered in the last round
+  uint8_t _valid = 0;  // sensors that ever delivered
+  uint8_t _rrStart = 0;
+  uint32_t _phaseStartMs = 0;
+  uint32_t _roundStartMs = 0;
+  uint32_t _lastRoundMs = 0;
+  uint32_t _readyMs = 0; // data-ready answer of the current round
+  bool _started = false;
+  bool _rawValues = false;
+  Phase _lastPhase = PHASE_DEVICE_STATUS; // of the current round
+};
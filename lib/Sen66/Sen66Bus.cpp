@@ -0,0 +1,62 @@
+// lib/Sen66/Sen66Bus.cpp
+#include "Sen66Bus.h"
+
+// ===== TCA9548A =====
+Tca9548a::Tca9548a(Sen66Bus &upstream, uint8_t addr)
+    : _upstream(upstream), _addr(addr) {
+  for (uint8_t i = 0; i < CHANNEL_COUNT; ++i) {
+    _channels[i]._mux = this;
+    _channels[i]._channel = i;
+  }
+}
+
+bool Tca9548a::select(uint8_t ch) {
+  const uint32_t resets = _upstream.resets();
+  if (resets != _upstreamResets) {
+    _upstreamResets = resets;
+    _selected = -1;
+  }
+  if (_selected == (int8_t)ch)
+    return true;
+  const uint8_t mask = (uint8_t)(1u << ch);
+  if (!_upstream.write(_addr, &mask, 1)) {
+    _selected = -1;
+    return false;
+  }
+  _selected = (int8_t)ch;
+  return true;
+}
+
+bool Tca9548aChannel::write(uint8_t addr, const uint8_t *data, size_t len) {
+  if (_mux->select(_channel) && _mux->_upstream.write(addr, data, len))
+    return true;
+  _mux->invalidate();
+  return false;
+}
+
+bool Tca9548aChannel::read(uint8_t addr, uint8_t *buf, size_t len) {
+  if (_mux->select(_channel) && _mux->_upstream.read(addr, buf, len))
+    return true;
+  _mux->invalidate();
+  return false;
+}
+
+bool Tca9548aChannel::readThenWrite(uint8_t addr, uint8_t *buf, size_t len,
+                                    const uint8_t *data, size_t dataLen,
+                                    bool &wrote) {
+  // The switch connects a channel at STOP, so the select can't join the
+  // transaction; the read and write behind it can
+  wrote = false;
+  const bool ok =
+      _mux->select(_channel) &&
+      _mux->_upstream.readThenWrite(addr, buf, len, data, dataLen, wrote);
+  if (!ok || !wrote)
+    _mux->invalidate();
+  return ok;
+}
+
+void Tca9548aChannel::delayMs(uint32_t ms) { _mux->_upstream.delayMs(ms); }
+
+void Tca9548aChannel::reportCorrupt() { _mux->_upstream.reportCorrupt(); }
+
+uint32_t Tca9548aChannel::resets() const { return _mux->_upstream.resets(); }
@@ -0,0 +1,95 @@
+// lib/Sen66/Sen66Bus.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+  Transport seen by the Sen66 driver. One instance per physical path to a
+  sensor: a TwoWire port (lib/Sen66Wire), a Linux i2c-dev adapter
+  (lib/Sen66Linux), a TCA9548A channel below, or a fake bus on the host.
+  Only raw write/read transactions are needed; the driver owns command
+  framing and CRCs.
+*/
+class Sen66Bus {
+public:
+  virtual ~Sen66Bus() {}
+
+  // Whole transaction with STOP; false on NACK or short transfer
+  virtual bool write(uint8_t addr, const uint8_t *data, size_t len) = 0;
+  virtual bool read(uint8_t addr, uint8_t *buf, size_t len) = 0;
+  // A read and then a write to the same device, as one transaction
+  // (repeated START between them) where the bus can do that; this
+  // default runs them one after the other. The result is the read's;
+  // `wrote` tells whether the write went out too.
+  virtual bool readThenWrite(uint8_t addr, uint8_t *buf, size_t len,
+                             const uint8_t *data, size_t dataLen,
+                             bool &wrote) {
+    wrote = false;
+    if (!read(addr, buf, len))
+      return false;
+    wrote = write(addr, data, dataLen);
+    return true;
+  }
+  // Command execution waits go through the bus so fakes can model time
+  virtual void delayMs(uint32_t ms) = 0;
+  // The driver found a CRC mismatch in a response read over this bus
+  virtual void reportCorrupt() {}
+  // Times the bus was reset (bus clear); devices on it may have lost
+  // their state since
+  virtual uint32_t resets() const { return 0; }
+};
+
+class Tca9548a;
+
+// One downstream channel of a TCA9548A. Selects its channel before every
+// transaction (skipped when the mux is already there). A failed
+// transaction forgets the selection, so the next one selects again.
+class Tca9548aChannel : public Sen66Bus {
+public:
+  bool write(uint8_t addr, const uint8_t *data, size_t len) override;
+  bool read(uint8_t addr, uint8_t *buf, size_t len) override;
+  bool readThenWrite(uint8_t addr, uint8_t *buf, size_t len,
+                     const uint8_t *data, size_t dataLen,
+                     bool &wrote) override;
+  void delayMs(uint32_t ms) override;
+  void reportCorrupt() override;
+  uint32_t resets() const override;
+
+private:
+  friend class Tca9548a;
+  Tca9548a *_mux = nullptr;
+  uint8_t _channel = 0;
+};
+
+/*
+  TCA9548A 1-to-8 I2C switch. Lets several SEN66 (fixed address 0x6B)
+  share one upstream bus. The control register is a channel bitmask; only
+  one channel is enabled at a time.
+
+  The selected channel is cached to spare a write per transaction. A
+  switch that reset or browned out is back at 0 (no channel) without
+  telling anyone, so the cache is dropped whenever a transaction through
+  a channel fails and when the upstream bus was reset.
+*/
+class Tca9548a {
+public:
+  static constexpr uint8_t DEFAULT_ADDR = 0x70;
+  static constexpr uint8_t CHANNEL_COUNT = 8;
+
+  explicit Tca9548a(Sen66Bus &upstream, uint8_t addr = DEFAULT_ADDR);
+  Tca9548a(const Tca9548a &) = delete;
+  Tca9548a &operator=(const Tca9548a &) = delete;
+
+  Sen66Bus &channel(uint8_t ch) { return _channels[ch & 7]; }
+  bool select(uint8_t ch);
+  // Forget the cached selection, e.g. after a bus reset
+  void invalidate() { _selected = -1; }
+
+private:
+  friend class Tca9548aChannel;
+  Sen66Bus &_upstream;
+  uint8_t _addr;
+  int8_t _selected = -1;
+  uint32_t _upstreamResets = 0; // _upstream.resets() the cache is from
+  Tca9548aChannel _channels[CHANNEL_COUNT];
+};
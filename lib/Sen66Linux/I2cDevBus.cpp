@@ -0,0 +1,109 @@
+// lib/Sen66Linux/I2cDevBus.cpp
+#include "I2cDevBus.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+// ===== Kernel =====
+
+namespace {
+
+class KernelIo : public I2cDevIo {
+public:
+  int open(const char *path) override { return ::open(path, O_RDWR | O_CLOEXEC); }
+  int ioctl(int fd, unsigned long request, void *arg) override {
+    return ::ioctl(fd, request, arg);
+  }
+  void close(int fd) override { ::close(fd); }
+};
+
+} // namespace
+
+I2cDevIo &kernelI2cDevIo() {
+  static KernelIo io;
+  return io;
+}
+
+static uint64_t monotonicUs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+// ===== Bus =====
+
+I2cDevBus::I2cDevBus(const char *path, I2cDevIo &io) : _io(io) {
+  strncpy(_path, path, sizeof(_path) - 1);
+  _path[sizeof(_path) - 1] = '\0';
+}
+
+bool I2cDevBus::open() {
+  close();
+  _fd = _io.open(_path);
+  if (_fd < 0)
+    return false;
+  unsigned long funcs = 0;
+  const bool queried = _io.ioctl(_fd, I2C_FUNCS, &funcs) >= 0;
+  if (!queried || !(funcs & I2C_FUNC_I2C)) {
+    const int err = queried ? EOPNOTSUPP : errno;
+    close();
+    errno = err;
+    return false;
+  }
+  return true;
+}
+
+void I2cDevBus::close() {
+  if (_fd >= 0)
+    _io.close(_fd);
+  _fd = -1;
+}
+
+int I2cDevBus::transfer(i2c_msg *msgs, uint32_t count) {
+  if (_fd < 0)
+    return -1;
+  struct i2c_rdwr_ioctl_data data;
+  data.msgs = msgs;
+  data.nmsgs = count;
+  const uint64_t start = monotonicUs();
+  const int done = _io.ioctl(_fd, I2C_RDWR, &data);
+  _stats.busUs += monotonicUs() - start;
+  _stats.ioctls++;
+  _stats.messages += count;
+  if (done < (int)count)
+    _stats.errors++;
+  return done;
+}
+
+bool I2cDevBus::write(uint8_t addr, const uint8_t *data, size_t len) {
+  i2c_msg msg = {addr, 0, (uint16_t)len, const_cast<uint8_t *>(data)};
+  return transfer(&msg, 1) == 1;
+}
+
+bool I2cDevBus::read(uint8_t addr, uint8_t *buf, size_t len) {
+  i2c_msg msg = {addr, I2C_M_RD, (uint16_t)len, buf};
+  return transfer(&msg, 1) == 1;
+}
+
+bool I2cDevBus::readThenWrite(uint8_t addr, uint8_t *buf, size_t len,
+                              const uint8_t *data, size_t dataLen,
+                              bool &wrote) {
+  i2c_msg msgs[2] = {{addr, I2C_M_RD, (uint16_t)len, buf},
+                     {addr, 0, (uint16_t)dataLen, const_cast<uint8_t *>(data)}};
+  // Adapters that stop at a NACK report the messages done before it
+  const int done = transfer(msgs, 2);
+  wrote = done == 2;
+  return done >= 1;
+}
+
+void I2cDevBus::delayMs(uint32_t ms) {
+  struct timespec ts = {(time_t)(ms / 1000), (long)(ms % 1000) * 1000000L};
+  while (nanosleep(&ts, &ts) < 0 && errno == EINTR) {
+  }
+}
@@ -0,0 +1,84 @@
+// lib/Sen66Linux/I2cDevBus.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Sen66Bus.h>
+
+struct i2c_msg;
+
+/*
+  The system calls behind I2cDevBus. kernelI2cDevIo() passes them to the
+  kernel; a fake one stands in for the adapter where there is no
+  hardware (src/gateway/MockI2c.h). Same contract as open(2), ioctl(2)
+  and close(2): -1 and errno on failure.
+*/
+class I2cDevIo {
+public:
+  virtual ~I2cDevIo() {}
+  virtual int open(const char *path) = 0;
+  virtual int ioctl(int fd, unsigned long request, void *arg) = 0;
+  virtual void close(int fd) = 0;
+};
+
+I2cDevIo &kernelI2cDevIo();
+
+/*
+  Sen66Bus on a Linux i2c-dev adapter (/dev/i2c-N).
+
+  - Every transaction is one I2C_RDWR ioctl that carries the address in
+    its message, so a TCA9548A and the sensors behind it share one
+    descriptor without I2C_SLAVE switches in between.
+  - readThenWrite() puts the read and the write into the same I2C_RDWR
+    (repeated START, one STOP): one kernel round trip for a response and
+    the next command. A command and its own response can't share one:
+    the SEN6x needs READ_EXEC_TIME_MS between them, which is why
+    Sen66Array pairs each response with the command after it.
+  - Counters of ioctls, messages, failed ioctls and the CRC errors the
+    driver reports.
+
+  Linux only (<linux/i2c-dev.h>). Waits in delayMs() sleep the thread.
+*/
+class I2cDevBus : public Sen66Bus {
+public:
+  static constexpr size_t PATH_SIZE = 64;
+
+  struct Stats {
+    uint32_t ioctls;
+    uint32_t messages;
+    uint32_t errors;  // failed ioctls (NACK, timeout, arbitration)
+    uint32_t corrupt; // CRC mismatches reported by the driver
+    uint64_t busUs;   // time inside the ioctls
+  };
+
+  explicit I2cDevBus(const char *path, I2cDevIo &io = kernelI2cDevIo());
+  ~I2cDevBus() override { close(); }
+  I2cDevBus(const I2cDevBus &) = delete;
+  I2cDevBus &operator=(const I2cDevBus &) = delete;
+
+  // Opens the adapter and checks that it does plain I2C transfers
+  // (I2C_FUNC_I2C, which I2C_RDWR needs); false with errno set if not
+  bool open();
+  void close();
+  bool isOpen() const { return _fd >= 0; }
+  const char *path() const { return _path; }
+
+  bool write(uint8_t addr, const uint8_t *data, size_t len) override;
+  bool read(uint8_t addr, uint8_t *buf, size_t len) override;
+  bool readThenWrite(uint8_t addr, uint8_t *buf, size_t len,
+                     const uint8_t *data, size_t dataLen,
+                     bool &wrote) override;
+  void delayMs(uint32_t ms) override;
+  void reportCorrupt() override { _stats.corrupt++; }
+
+  const Stats &stats() const { return _stats; }
+
+private:
+  // Runs msgs as one I2C_RDWR; the number of messages done, or -1
+  int transfer(i2c_msg *msgs, uint32_t count);
+
+  I2cDevIo &_io;
+  char _path[PATH_SIZE];
+  int _fd = -1;
+  Stats _stats = {};
+};
@@ -0,0 +1,69 @@
+// lib/Sen66Protocol/Sen66Protocol.cpp
+#include "Sen66Protocol.h"
+#include <math.h>
+
+namespace Sen66Protocol {
+
+// ===== CRC-8 (poly 0x31, init 0xFF) per datasheet =====
+uint8_t crc8(const uint8_t *data, uint16_t count) {
+  uint8_t crc = 0xFF; // init
+  for (uint16_t i = 0; i < count; ++i) {
+    crc ^= data[i];
+    for (uint8_t b = 0; b < 8; ++b) {
+      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+bool decodeWord(const uint8_t *triplet, uint16_t &word) {
+  // Verify CRC over the two data bytes
+  if (crc8(triplet, 2) != triplet[2])
+    return false;
+  word = ((uint16_t)triplet[0] << 8) | triplet[1];
+  return true;
+}
+
+float scaleUInt16(uint16_t v, float scale, bool &valid) {
+  if (v == 0xFFFF) {
+    valid = false;
+    return NAN;
+  }
+  valid = true;
+  return (float)v / scale;
+}
+
+float scaleInt16(int16_t v, float scale, bool &valid) {
+  if (v == 0x7FFF) {
+    valid = false;
+    return NAN;
+  }
+  valid = true;
+  return (float)v / scale;
+}
+
+bool decodeMeasuredValues(const uint8_t *frame, MeasuredValues &out) {
+  return decodeMeasuredValuesOf<BuildModel::MODEL>(frame, out);
+}
+
+bool decodeNumberConcentration(const uint8_t *frame, NumberConcentration &out) {
+  uint16_t w[5];
+  for (uint8_t i = 0; i < 5; ++i) {
+    if (!decodeWord(frame + 3 * i, w[i]))
+      return false;
+  }
+
+  // PM0.5..PM10 #/cm3 (scale x10)
+  out.nc0_5 = scaleUInt16(w[0], 10.0f, out.valid_nc0_5);
+  out.nc1_0 = scaleUInt16(w[1], 10.0f, out.valid_nc1_0);
+  out.nc2_5 = scaleUInt16(w[2], 10.0f, out.valid_nc2_5);
+  out.nc4_0 = scaleUInt16(w[3], 10.0f, out.valid_nc4_0);
+  out.nc10_0 = scaleUInt16(w[4], 10.0f, out.valid_nc10_0);
+  return true;
+}
+
+bool decodeRawValues(const uint8_t *frame, RawValues &out) {
+  return decodeRawValuesOf<BuildModel::MODEL>(frame, out);
+}
+
+} // namespace Sen66Protocol
@@ -0,0 +1,193 @@
+// lib/Sen66Protocol/Sen66Protocol.h
+#pragma once
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Sen6x.h"
+
+/*
+  Bus-independent part of the SEN6x protocol: CRC and frame decoding.
+  No Arduino dependencies, so it also builds for the native environments.
+
+  - Data words are 16-bit MSB-first, each followed by CRC-8 (poly 0x31,
+    init 0xFF).
+  - Read Measured Values returns the model's measured words (SEN66:
+    0x0300, 27 bytes, 9 triplets; others see Sen6x.h).
+  - 0x0316 Read Number Concentrations returns 15 bytes (5 triplets).
+  - Read Measured Raw Values returns the model's raw words (SEN66: 0x0405,
+    15 bytes, 5 triplets).
+
+  Fields the model does not measure are NaN and invalid in
+  MeasuredValues, and "not available" in RawValues.
+*/
+
+namespace Sen66Protocol {
+
+struct MeasuredValues {
+  // Mass concentration [µg/m3]
+  float pm1_0, pm2_5, pm4_0, pm10_0;
+  // Ambient
+  float humidity_rh;   // [%]
+  float temperature_c; // [°C]
+  // Indexes
+  float voc_index; // unitless
+  float nox_index; // unitless
+  // Gas
+  float co2_ppm;  // [ppm]
+  float hcho_ppb; // [ppb], SEN68 only
+  // Validity flags
+  bool valid_pm1_0, valid_pm2_5, valid_pm4_0, valid_pm10_0;
+  bool valid_humidity, valid_temperature, valid_voc, valid_nox, valid_co2;
+  bool valid_hcho;
+};
+
+struct NumberConcentration {
+  // [particles/cm3]
+  float nc0_5, nc1_0, nc2_5, nc4_0, nc10_0;
+  bool valid_nc0_5, valid_nc1_0, valid_nc2_5, valid_nc4_0, valid_nc10_0;
+};
+
+// Sensor signals before compensation and index algorithms, kept in the
+// sensor's own integer scaling (0x7FFF / 0xFFFF = not available)
+struct RawValues {
+  int16_t humidity;     // [%RH] x100
+  int16_t temperature;  // [°C] x200
+  uint16_t vocTicks;    // SGP41 VOC raw signal
+  uint16_t noxTicks;    // SGP41 NOx raw signal
+  uint16_t co2;         // [ppm], not interpolated (updates every 5 s)
+};
+
+// Of the SEN6X_MODEL the firmware is built for
+constexpr size_t MEASURED_VALUES_FRAME_LEN = BuildModel::MeasuredWords::FRAME_LEN;
+constexpr size_t NUMBER_CONCENTRATION_FRAME_LEN = 15;
+constexpr size_t RAW_VALUES_FRAME_LEN = BuildModel::RawWords::FRAME_LEN;
+
+uint8_t crc8(const uint8_t *data, uint16_t count);
+
+// Verifies the CRC of one [MSB, LSB, CRC] triplet and extracts the word.
+bool decodeWord(const uint8_t *triplet, uint16_t &word);
+
+float scaleUInt16(uint16_t v, float scale, bool &valid);
+float scaleInt16(int16_t v, float scale, bool &valid);
+
+// Decode a complete measured values / 0x0316 / raw values response of
+// the build model. Returns false on CRC error; `out` is left partially
+// written in that case.
+bool decodeMeasuredValues(const uint8_t *frame, MeasuredValues &out);
+bool decodeNumberConcentration(const uint8_t *frame, NumberConcentration &out);
+bool decodeRawValues(const uint8_t *frame, RawValues &out);
+
+// ===== Per-model decoding =====
+// Unrolled at compile time from ModelTraits<M>: one store per word in
+// frame order, no branching on the model at run time.
+
+// Where a word lands, its scale, and its "not available" value
+template <Word W> struct WordCodec;
+
+template <float MeasuredValues::*Value, bool MeasuredValues::*Valid,
+          bool Signed, uint16_t Scale>
+struct MeasuredWord {
+  static constexpr bool SIGNED = Signed;
+  static constexpr uint16_t SCALE = Scale;
+  static void store(uint16_t w, MeasuredValues &out) {
+    out.*Value = Signed ? scaleInt16((int16_t)w, Scale, out.*Valid)
+                        : scaleUInt16(w, Scale, out.*Valid);
+  }
+  static void absent(MeasuredValues &out) {
+    out.*Value = NAN;
+    out.*Valid = false;
+  }
+};
+
+template <typename T, T RawValues::*Field, T NotAvailable> struct RawWord {
+  static void store(uint16_t w, RawValues &out) { out.*Field = (T)w; }
+  static void absent(RawValues &out) { out.*Field = NotAvailable; }
+};
+
+#define SEN6X_MEASURED_WORD(W, FIELD, VALID, SIGNED, SCALE)                    \
+  template <>                                                                  \
+  struct WordCodec<W> : MeasuredWord<&MeasuredValues::FIELD,                   \
+                                     &MeasuredValues::VALID, SIGNED, SCALE> {}
+SEN6X_MEASURED_WORD(W_PM1_0, pm1_0, valid_pm1_0, false, 10);
+SEN6X_MEASURED_WORD(W_PM2_5, pm2_5, valid_pm2_5, false, 10);
+SEN6X_MEASURED_WORD(W_PM4_0, pm4_0, valid_pm4_0, false, 10);
+SEN6X_MEASURED_WORD(W_PM10_0, pm10_0, valid_pm10_0, false, 10);
+SEN6X_MEASURED_WORD(W_HUMIDITY, humidity_rh, valid_humidity, true, 100);
+SEN6X_MEASURED_WORD(W_TEMPERATURE, temperature_c, valid_temperature, true, 200);
+SEN6X_MEASURED_WORD(W_VOC, voc_index, valid_voc, true, 10);
+SEN6X_MEASURED_WORD(W_NOX, nox_index, valid_nox, true, 10);
+SEN6X_MEASURED_WORD(W_CO2, co2_ppm, valid_co2, false, 1);
+SEN6X_MEASURED_WORD(W_HCHO, hcho_ppb, valid_hcho, false, 10);
+#undef SEN6X_MEASURED_WORD
+
+template <> struct WordCodec<W_RAW_HUMIDITY>
+    : RawWord<int16_t, &RawValues::humidity, 0x7FFF> {};
+template <> struct WordCodec<W_RAW_TEMPERATURE>
+    : RawWord<int16_t, &RawValues::temperature, 0x7FFF> {};
+template <> struct WordCodec<W_RAW_VOC>
+    : RawWord<uint16_t, &RawValues::vocTicks, 0xFFFF> {};
+template <> struct WordCodec<W_RAW_NOX>
+    : RawWord<uint16_t, &RawValues::noxTicks, 0xFFFF> {};
+template <> struct WordCodec<W_RAW_CO2>
+    : RawWord<uint16_t, &RawValues::co2, 0xFFFF> {};
+
+// Every word each struct can hold, for marking the ones a model lacks
+using AllMeasuredWords =
+    WordList<W_PM1_0, W_PM2_5, W_PM4_0, W_PM10_0, W_HUMIDITY, W_TEMPERATURE,
+             W_VOC, W_NOX, W_CO2, W_HCHO>;
+using AllRawWords = WordList<W_RAW_HUMIDITY, W_RAW_TEMPERATURE, W_RAW_VOC,
+                             W_RAW_NOX, W_RAW_CO2>;
+
+template <typename Words> struct FrameDecoder;
+
+template <> struct FrameDecoder<WordList<>> {
+  template <typename Out> static bool decode(const uint8_t *, Out &) {
+    return true;
+  }
+};
+
+template <Word W, Word... Rest> struct FrameDecoder<WordList<W, Rest...>> {
+  template <typename Out> static bool decode(const uint8_t *frame, Out &out) {
+    uint16_t w;
+    if (!decodeWord(frame, w))
+      return false;
+    WordCodec<W>::store(w, out);
+    return FrameDecoder<WordList<Rest...>>::decode(frame + 3, out);
+  }
+};
+
+// Marks the words of All that are not in Words as not available
+template <typename Words, typename All> struct AbsentWords;
+
+template <typename Words> struct AbsentWords<Words, WordList<>> {
+  template <typename Out> static void mark(Out &) {}
+};
+
+template <typename Words, Word W, Word... Rest>
+struct AbsentWords<Words, WordList<W, Rest...>> {
+  template <typename Out> static void mark(Out &out) {
+    if (!Words::has(W))
+      WordCodec<W>::absent(out);
+    AbsentWords<Words, WordList<Rest...>>::mark(out);
+  }
+};
+
+template <Model M>
+bool decodeMeasuredValuesOf(const uint8_t *frame, MeasuredValues &out) {
+  using Words = typename ModelTraits<M>::MeasuredWords;
+  if (!FrameDecoder<Words>::decode(frame, out))
+    return false;
+  AbsentWords<Words, AllMeasuredWords>::mark(out);
+  return true;
+}
+
+template <Model M> bool decodeRawValuesOf(const uint8_t *frame, RawValues &out) {
+  using Words = typename ModelTraits<M>::RawWords;
+  if (!FrameDecoder<Words>::decode(frame, out))
+    return false;
+  AbsentWords<Words, AllRawWords>::mark(out);
+  return true;
+}
+
+} // namespace Sen66Protocol
@@ -0,0 +1,122 @@
+// lib/Sen66Protocol/Sen6x.h
+#pragma once
+#include <stdint.h>
+
+/*
+  SEN6x models at compile time. The family shares the I2C address and
+  every command except the two value reads, whose frames differ per model
+  (datasheet, "Read Measured Values" / "Read Measured Raw Values"):
+
+    model   measured values                     raw values
+    SEN63C  0x0471  PM x4, RH, T, CO2           0x0492  RH, T
+    SEN65   0x0446  PM x4, RH, T, VOC, NOx      0x0455  RH, T, VOC, NOx
+    SEN66   0x0300  PM x4, RH, T, VOC, NOx, CO2 0x0405  RH, T, VOC, NOx, CO2
+    SEN68   0x0467  PM x4, RH, T, VOC, NOx,     0x0455  RH, T, VOC, NOx
+                    HCHO
+
+  ModelTraits<M> gives each frame as a list of words in frame order; the
+  decoders in Sen66Protocol.h are generated from those lists, and the
+  feature flags are derived from them.
+
+  The firmware is built for one model, SEN6X_MODEL (63 = SEN63C, 65, 66
+  or 68; default 66). The driver, the environment line and the
+  simulator's fake sensor all follow it through BuildModel.
+*/
+
+#ifndef SEN6X_MODEL
+#define SEN6X_MODEL 66
+#endif
+
+namespace Sen66Protocol {
+
+enum Model : uint8_t { SEN63C = 63, SEN65 = 65, SEN66 = 66, SEN68 = 68 };
+
+// One data word of a value frame. Its scale and the field it lands in
+// are fixed across the family (see WordCodec in Sen66Protocol.h).
+enum Word : uint8_t {
+  W_PM1_0,
+  W_PM2_5,
+  W_PM4_0,
+  W_PM10_0,
+  W_HUMIDITY,
+  W_TEMPERATURE,
+  W_VOC,
+  W_NOX,
+  W_CO2,
+  W_HCHO,
+  // Raw values frame
+  W_RAW_HUMIDITY,
+  W_RAW_TEMPERATURE,
+  W_RAW_VOC,
+  W_RAW_NOX,
+  W_RAW_CO2,
+};
+
+constexpr bool wordIn(Word) { return false; }
+template <typename... Rest>
+constexpr bool wordIn(Word w, Word first, Rest... rest) {
+  return w == first || wordIn(w, rest...);
+}
+
+template <Word... Ws> struct WordList {
+  static constexpr uint8_t COUNT = sizeof...(Ws);
+  static constexpr uint8_t FRAME_LEN = 3 * sizeof...(Ws);
+  static constexpr bool has(Word w) { return wordIn(w, Ws...); }
+};
+
+// The two value frames of a model, specialized per model below
+template <Model M> struct ModelFrames;
+
+template <> struct ModelFrames<SEN63C> {
+  static constexpr uint16_t MEASURED_VALUES_CMD = 0x0471;
+  using MeasuredWords = WordList<W_PM1_0, W_PM2_5, W_PM4_0, W_PM10_0,
+                                 W_HUMIDITY, W_TEMPERATURE, W_CO2>;
+  static constexpr uint16_t RAW_VALUES_CMD = 0x0492;
+  using RawWords = WordList<W_RAW_HUMIDITY, W_RAW_TEMPERATURE>;
+};
+
+template <> struct ModelFrames<SEN65> {
+  static constexpr uint16_t MEASURED_VALUES_CMD = 0x0446;
+  using MeasuredWords = WordList<W_PM1_0, W_PM2_5, W_PM4_0, W_PM10_0,
+                                 W_HUMIDITY, W_TEMPERATURE, W_VOC, W_NOX>;
+  static constexpr uint16_t RAW_VALUES_CMD = 0x0455;
+  using RawWords = WordList<W_RAW_HUMIDITY, W_RAW_TEMPERATURE, W_RAW_VOC,
+                            W_RAW_NOX>;
+};
+
+template <> struct ModelFrames<SEN66> {
+  static constexpr uint16_t MEASURED_VALUES_CMD = 0x0300;
+  using MeasuredWords = WordList<W_PM1_0, W_PM2_5, W_PM4_0, W_PM10_0,
+                                 W_HUMIDITY, W_TEMPERATURE, W_VOC, W_NOX,
+                                 W_CO2>;
+  static constexpr uint16_t RAW_VALUES_CMD = 0x0405;
+  using RawWords = WordList<W_RAW_HUMIDITY, W_RAW_TEMPERATURE, W_RAW_VOC,
+                            W_RAW_NOX, W_RAW_CO2>;
+};
+
+template <> struct ModelFrames<SEN68> {
+  static constexpr uint16_t MEASURED_VALUES_CMD = 0x0467;
+  using MeasuredWords = WordList<W_PM1_0, W_PM2_5, W_PM4_0, W_PM10_0,
+                                 W_HUMIDITY, W_TEMPERATURE, W_VOC, W_NOX,
+                                 W_HCHO>;
+  static constexpr uint16_t RAW_VALUES_CMD = 0x0455;
+  using RawWords = WordList<W_RAW_HUMIDITY, W_RAW_TEMPERATURE, W_RAW_VOC,
+                            W_RAW_NOX>;
+};
+
+// Frames plus what the model measures, read off its measured words
+template <Model M> struct ModelTraits : ModelFrames<M> {
+  using Measured = typename ModelFrames<M>::MeasuredWords;
+  static constexpr Model MODEL = M;
+  static constexpr bool HAS_VOC_NOX = Measured::has(W_VOC);
+  static constexpr bool HAS_CO2 = Measured::has(W_CO2);
+  static constexpr bool HAS_HCHO = Measured::has(W_HCHO);
+};
+
+static_assert(SEN6X_MODEL == SEN63C || SEN6X_MODEL == SEN65 ||
+                  SEN6X_MODEL == SEN66 || SEN6X_MODEL == SEN68,
+              "SEN6X_MODEL must be 63 (SEN63C), 65, 66 or 68");
+
+using BuildModel = ModelTraits<(Model)SEN6X_MODEL>;
+
+} // namespace Sen66Protocol
@@ -0,0 +1,143 @@
+// lib/Sen66Wire/Sen66WireBus.cpp
+#include "Sen66WireBus.h"
+
+#include <Telemetry.h>
+
+const uint32_t Sen66WireBus::SPEEDS[SPEED_COUNT] = {400000, 100000, 50000};
+
+// Half an SCL period of the bus clear (~100 kHz)
+static constexpr uint32_t CLEAR_HALF_PERIOD_US = 5;
+// endTransmission(): the address was not acknowledged
+static constexpr uint8_t WIRE_NACK_ADDRESS = 2;
+
+bool Sen66WireBus::begin(uint32_t freq) {
+  _fastest = SPEED_COUNT - 1;
+  for (uint8_t i = 0; i < SPEED_COUNT; ++i) {
+    if (SPEEDS[i] <= freq) {
+      _fastest = i;
+      break;
+    }
+  }
+  _speed = _fastest;
+  _wire.begin(_sda, _scl, SPEEDS[_speed]);
+  delay(5);
+  return true;
+}
+
+bool Sen66WireBus::write(uint8_t addr, const uint8_t *data, size_t len) {
+  TELEMETRY_SCOPE(Telemetry::STAGE_I2C);
+  const uint32_t start = micros();
+  _wire.beginTransmission(addr);
+  _wire.write(data, len);
+  uint8_t err = _wire.endTransmission();
+  if (err != 0)
+    TELEMETRY_ERROR(Telemetry::STAGE_I2C);
+  account(err == 0                   ? RESULT_OK
+          : err == WIRE_NACK_ADDRESS ? RESULT_ABSENT
+                                     : RESULT_ERROR,
+          start);
+  return err == 0;
+}
+
+bool Sen66WireBus::read(uint8_t addr, uint8_t *buf, size_t len) {
+  TELEMETRY_SCOPE(Telemetry::STAGE_I2C);
+  const uint32_t start = micros();
+  size_t readLen = _wire.requestFrom((int)addr, (int)len);
+  if (readLen != len) {
+    // The ESP32 core returns 0 bytes for a NACK on the address but also
+    // for a bus error, lost arbitration or a timeout. Only an address
+    // probe that is NACKed too says nobody answered.
+    TELEMETRY_ERROR(Telemetry::STAGE_I2C);
+    _wire.beginTransmission(addr);
+    const uint8_t err = _wire.endTransmission();
+    account(err == WIRE_NACK_ADDRESS ? RESULT_ABSENT : RESULT_ERROR, start);
+    return false;
+  }
+  for (size_t i = 0; i < len; ++i)
+    buf[i] = (uint8_t)_wire.read();
+  account(RESULT_OK, start);
+  return true;
+}
+
+void Sen66WireBus::reportCorrupt() {
+  _stats[_speed].corrupt++;
+  countError();
+}
+
+void Sen66WireBus::account(Result result, uint32_t startUs) {
+  SpeedStats &st = _stats[_speed];
+  st.transactions++;
+  st.busUs += (uint32_t)(micros() - startUs);
+  if (result == RESULT_OK) {
+    _failStreak = 0;
+  } else if (result == RESULT_ABSENT) {
+    st.absent++;
+  } else {
+    st.errors++;
+    countError();
+    if (++_failStreak >= RECOVER_AFTER) {
+      _failStreak = 0;
+      if (_sda >= 0 && _scl >= 0 && !clearBus())
+        _failedClears++;
+    }
+  }
+
+  if (++_windowCount < WINDOW)
+    return;
+  if (_probeWindows > 0 && --_probeWindows == 0)
+    _holdMs = HOLD_MS; // the faster speed held
+  _windowCount = 0;
+  _windowErrors = 0;
+  if (_speed > _fastest && millis() - _steppedAtMs >= _holdMs) {
+    setSpeed(_speed - 1);
+    _probeWindows = PROBE_WINDOWS;
+  }
+}
+
+void Sen66WireBus::countError() {
+  if (++_windowErrors < STEP_DOWN_ERRORS || _speed + 1 >= SPEED_COUNT)
+    return;
+  if (_probeWindows > 0) {
+    _probeWindows = 0;
+    _holdMs = _holdMs > MAX_HOLD_MS / 2 ? MAX_HOLD_MS : _holdMs * 2;
+  }
+  setSpeed(_speed + 1);
+}
+
+void Sen66WireBus::setSpeed(uint8_t speed) {
+  _speed = speed;
+  _wire.setClock(SPEEDS[speed]);
+  _steppedAtMs = millis();
+  _windowCount = 0;
+  _windowErrors = 0;
+}
+
+// false if SDA is still held low afterwards
+bool Sen66WireBus::clearBus() {
+  _recoveries++;
+  _wire.end();
+  pinMode(_sda, INPUT_PULLUP);
+  pinMode(_scl, OUTPUT_OPEN_DRAIN);
+  digitalWrite(_scl, HIGH);
+  delayMicroseconds(CLEAR_HALF_PERIOD_US);
+  // A slave stuck mid-byte releases SDA within 9 clocks
+  for (uint8_t i = 0; i < 9 && digitalRead(_sda) == LOW; ++i) {
+    digitalWrite(_scl, LOW);
+    delayMicroseconds(CLEAR_HALF_PERIOD_US);
+    digitalWrite(_scl, HIGH);
+    delayMicroseconds(CLEAR_HALF_PERIOD_US);
+  }
+  // STOP: SDA rises while SCL is high
+  digitalWrite(_scl, LOW);
+  pinMode(_sda, OUTPUT_OPEN_DRAIN);
+  digitalWrite(_sda, LOW);
+  delayMicroseconds(CLEAR_HALF_PERIOD_US);
+  digitalWrite(_scl, HIGH);
+  delayMicroseconds(CLEAR_HALF_PERIOD_US);
+  digitalWrite(_sda, HIGH);
+  delayMicroseconds(CLEAR_HALF_PERIOD_US);
+  pinMode(_sda, INPUT_PULLUP);
+  const bool released = digitalRead(_sda) == HIGH;
+  _wire.begin(_sda, _scl, SPEEDS[_speed]);
+  return released;
+}
@@ -0,0 +1,96 @@
+// lib/Sen66Wire/Sen66WireBus.h
+#pragma once
+#include <Arduino.h>
+#include <Wire.h>
+
+#include "Sen66Bus.h"
+
+/*
+  Sen66Bus on an Arduino TwoWire port (Wire, Wire1).
+
+  - Adaptive clock: starts at the fastest step not above begin()'s freq
+    and steps down one speed when a window of WINDOW transactions sees
+    STEP_DOWN_ERRORS failures (bus error, timeout, NACK on data or a CRC
+    mismatch the driver reports), i.e. ~3%. A failed transfer only costs
+    a retry in the next acquisition round, so occasional errors are
+    cheaper than a 4x slower bus. After HOLD_MS it tries the faster speed again; unless
+    that holds for PROBE_WINDOWS windows the hold doubles, up to
+    MAX_HOLD_MS.
+  - A NACK on the address means no device answered, e.g. an unplugged
+    sensor or an empty mux channel. It is counted as absent and neither
+    steps the clock down nor leads to a bus clear: neither would bring the
+    device back. A short read is followed by a zero-length write to the
+    address; only a NACK on that probe makes it absent, anything else is
+    an error.
+  - Bus clear: after RECOVER_AFTER consecutive failed transactions the
+    port is released and SCL clocked (up to 9 pulses) until a slave
+    holding SDA low lets go, then a STOP is sent and the port restarted.
+    Needs the pins, so only when they were given to the constructor.
+    Clears that end with SDA still low are counted as failed.
+  - Per-speed counters of transactions, errors, absent devices and time
+    spent in transfers; with countSample() that gives bus time per sample.
+*/
+class Sen66WireBus : public Sen66Bus {
+public:
+  static constexpr uint8_t SPEED_COUNT = 3;
+  static const uint32_t SPEEDS[SPEED_COUNT]; // [Hz], fastest first
+  static constexpr uint16_t WINDOW = 256;
+  static constexpr uint16_t STEP_DOWN_ERRORS = 8;
+  static constexpr uint8_t PROBE_WINDOWS = 8;
+  static constexpr uint8_t RECOVER_AFTER = 3;
+  static constexpr uint32_t HOLD_MS = 3600000UL;
+  static constexpr uint32_t MAX_HOLD_MS = 24 * 3600000UL;
+
+  struct SpeedStats {
+    uint32_t transactions;
+    uint32_t errors;  // bus error, timeout, NACK on data, short read
+    uint32_t absent;  // NACK on the address (a short read: on the probe)
+    uint32_t corrupt; // CRC mismatches reported by the driver
+    uint32_t samples; // countSample() calls
+    uint64_t busUs;   // time inside write()/read()
+  };
+
+  // sda/scl < 0: the port's default pins, no bus clear
+  explicit Sen66WireBus(TwoWire &w, int sda = -1, int scl = -1)
+      : _wire(w), _sda(sda), _scl(scl) {}
+
+  bool begin(uint32_t freq = SEN66_I2C_FREQ);
+
+  bool write(uint8_t addr, const uint8_t *data, size_t len) override;
+  bool read(uint8_t addr, uint8_t *buf, size_t len) override;
+  void delayMs(uint32_t ms) override { delay(ms); }
+  void reportCorrupt() override;
+
+  // Call once per sample read over this bus
+  void countSample() { _stats[_speed].samples++; }
+
+  uint32_t clock() const { return SPEEDS[_speed]; }
+  uint8_t speed() const { return _speed; }
+  const SpeedStats &stats(uint8_t speed) const { return _stats[speed]; }
+  uint32_t recoveries() const { return _recoveries; }
+  uint32_t failedClears() const { return _failedClears; }
+  uint32_t resets() const override { return _recoveries; }
+
+private:
+  enum Result : uint8_t { RESULT_OK, RESULT_ABSENT, RESULT_ERROR };
+
+  void account(Result result, uint32_t startUs);
+  void countError();
+  void setSpeed(uint8_t speed);
+  bool clearBus();
+
+  TwoWire &_wire;
+  int _sda;
+  int _scl;
+  uint8_t _speed = 0;
+  uint8_t _fastest = 0; // from begin()'s freq
+  SpeedStats _stats[SPEED_COUNT] = {};
+  uint16_t _windowCount = 0;
+  uint16_t _windowErrors = 0;
+  uint8_t _failStreak = 0;
+  uint8_t _probeWindows = 0; // clean windows still needed at a probed speed
+  uint32_t _steppedAtMs = 0;
+  uint32_t _holdMs = HOLD_MS;
+  uint32_t _recoveries = 0;
+  uint32_t _failedClears = 0;
+};
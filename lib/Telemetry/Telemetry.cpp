@@ -0,0 +1,161 @@
+// lib/Telemetry/Telemetry.cpp
+#include "Telemetry.h"
+
+#if TELEMETRY_ENABLED
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "HeapGuard.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <chrono>
+#endif
+
+namespace Telemetry {
+
+static const char *const STAGE_NAMES[STAGE_COUNT] = {
+    "i2c",           "sensor_read", "influx_post", "weather_fetch",
+    "weather_parse", "tls_full",    "tls_resumed", "wifi_connect",
+    "wifi_outage"};
+
+static Histogram histograms[STAGE_COUNT];
+static uint32_t probes = 0;
+static uint32_t probeCostNs = 0;
+static uint32_t heapLargestMin = UINT32_MAX;
+
+uint32_t nowUs() {
+#ifdef ARDUINO
+  return micros();
+#else
+  using namespace std::chrono;
+  return (uint32_t)duration_cast<microseconds>(
+             steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+static inline uint8_t bucketFor(uint32_t us) {
+  if (us == 0)
+    return 0;
+  const uint8_t b = (uint8_t)(32 - __builtin_clz(us));
+  return b < BUCKET_COUNT ? b : BUCKET_COUNT - 1;
+}
+
+void record(Stage stage, uint32_t us) {
+  Histogram &h = histograms[stage];
+  h.buckets[bucketFor(us)]++;
+  h.count++;
+  h.sumUs += us;
+  if (us > h.maxUs)
+    h.maxUs = us;
+  probes++;
+}
+
+void recordError(Stage stage) { histograms[stage].errors++; }
+
+void sampleHeap() {
+#ifdef ESP32
+  const uint32_t largest = ESP.getMaxAllocHeap();
+  if (largest < heapLargestMin)
+    heapLargestMin = largest;
+#endif
+}
+
+void calibrate() {
+  constexpr uint32_t N = 1000;
+  const Histogram saved = histograms[STAGE_I2C];
+  const uint32_t savedProbes = probes;
+  const uint32_t t0 = nowUs();
+  for (uint32_t i = 0; i < N; ++i) {
+    ScopedTimer probe(STAGE_I2C);
+  }
+  const uint32_t elapsed = nowUs() - t0;
+  histograms[STAGE_I2C] = saved;
+  probes = savedProbes;
+  probeCostNs = (uint32_t)(((uint64_t)elapsed * 1000) / N);
+}
+
+uint32_t probeNs() { return probeCostNs; }
+
+uint32_t percentileUs(const Histogram &h, uint8_t pct) {
+  if (h.count == 0)
+    return 0;
+  const uint64_t target = ((uint64_t)h.count * pct + 99) / 100;
+  uint64_t seen = 0;
+  for (uint8_t i = 0; i < BUCKET_COUNT; ++i) {
+    seen += h.buckets[i];
+    if (seen >= target) {
+      if (i == 0)
+        return 0;
+      // Upper bucket edge, but never above the observed maximum
+      const uint32_t edge = (uint32_t)((1UL << i) - 1);
+      return edge < h.maxUs ? edge : h.maxUs;
+    }
+  }
+  return h.maxUs;
+}
+
+const Histogram &histogram(Stage stage) { return histograms[stage]; }
+
+static void append(char *buf, size_t cap, size_t &len, const char *fmt, ...)
+    __attribute__((format(printf, 4, 5)));
+
+static void append(char *buf, size_t cap, size_t &len, const char *fmt, ...) {
+  if (len >= cap)
+    return;
+  va_list args;
+  va_start(args, fmt);
+  const int n = vsnprintf(buf + len, cap - len, fmt, args);
+  va_end(args);
+  len = (n < 0) ? cap : len + (size_t)n;
+}
+
+size_t formatLine(char *buf, size_t cap, const char *seriesKey) {
+  size_t len = 0;
+  append(buf, cap, len, "%s ", seriesKey);
+  for (uint8_t s = 0; s < STAGE_COUNT; ++s) {
+    const Histogram &h = histograms[s];
+    const char *name = STAGE_NAMES[s];
+    const uint32_t mean = h.count ? (uint32_t)(h.sumUs / h.count) : 0;
+    append(buf, cap, len,
+           "%s%s_count=%lui,%s_errors=%lui,%s_mean_us=%lui,%s_p50_us=%lui,"
+           "%s_p99_us=%lui,%s_max_us=%lui",
+           s ? "," : "", name, (unsigned long)h.count, name,
+           (unsigned long)h.errors, name, (unsigned long)mean, name,
+           (unsigned long)percentileUs(h, 50), name,
+           (unsigned long)percentileUs(h, 99), name, (unsigned long)h.maxUs);
+  }
+
+#ifdef ESP32
+  sampleHeap();
+  append(buf, cap, len,
+         ",heap_free=%lui,heap_min_free=%lui,heap_largest_block=%lui",
+         (unsigned long)ESP.getFreeHeap(), (unsigned long)ESP.getMinFreeHeap(),
+         (unsigned long)heapLargestMin);
+#endif
+#if HEAP_GUARD_ENABLED
+  const HeapGuard::Stats heap = HeapGuard::stats();
+  append(buf, cap, len, ",heap_allocs=%lui,heap_transient=%lui",
+         (unsigned long)heap.allocations, (unsigned long)heap.transient);
+#endif
+
+  append(buf, cap, len, ",probes=%lui,probe_ns=%lui,overhead_us=%lui",
+         (unsigned long)probes, (unsigned long)probeCostNs,
+         (unsigned long)(((uint64_t)probes * probeCostNs) / 1000));
+
+  return len < cap ? len : 0;
+}
+
+void reset() {
+  memset(histograms, 0, sizeof(histograms));
+  probes = 0;
+  heapLargestMin = UINT32_MAX;
+}
+
+} // namespace Telemetry
+
+#endif // TELEMETRY_ENABLED
@@ -0,0 +1,102 @@
+// lib/Telemetry/Telemetry.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+  Lightweight runtime telemetry for the sensor node.
+
+  - One fixed-size log2 histogram per stage (microseconds). Bucket 0 holds
+    0 us, bucket i holds [2^(i-1), 2^i) us, the last bucket is open-ended.
+  - record() is O(1): a count-leading-zeros plus a few increments, no heap.
+  - Heap tracking: free heap, min free heap and the smallest "largest free
+    block" seen since the last snapshot (fragmentation indicator), and
+    with HEAP_GUARD_ENABLED the allocations since setup (lib/HeapGuard).
+  - probeNs() is the calibrated cost of one ScopedTimer (a nowUs() pair
+    and a record()), so the overhead of the instrumentation itself can
+    be reported (probes * probeNs).
+
+  Build with -DTELEMETRY_ENABLED=0 and every TELEMETRY_* macro expands to
+  nothing and the implementation is not compiled.
+*/
+
+#ifndef TELEMETRY_ENABLED
+#define TELEMETRY_ENABLED 0
+#endif
+
+namespace Telemetry {
+
+enum Stage : uint8_t {
+  STAGE_I2C = 0,       // single I2C transaction (write or read)
+  STAGE_SENSOR_READ,   // acquisition round (all sensors) incl. waits
+  STAGE_INFLUX_POST,   // one HTTP POST to /api/v2/write
+  STAGE_WEATHER_FETCH, // one Open-Meteo HTTP GET
+  STAGE_WEATHER_PARSE, // one deserializeJson() call
+  STAGE_TLS_FULL,      // TLS handshake with key exchange and certificate
+  STAGE_TLS_RESUMED,   // TLS handshake resuming a cached session
+  STAGE_WIFI_CONNECT,  // WiFi attempt from begin() to an IP; errors: failed
+  STAGE_WIFI_OUTAGE,   // link lost until it is back (count: outages ended)
+  STAGE_COUNT
+};
+
+constexpr uint8_t BUCKET_COUNT = 25; // last bucket: >= 2^23 us (~8.4 s)
+
+struct Histogram {
+  uint32_t buckets[BUCKET_COUNT];
+  uint32_t count;
+  uint32_t errors;
+  uint64_t sumUs;
+  uint32_t maxUs;
+};
+
+#if TELEMETRY_ENABLED
+
+uint32_t nowUs();
+void record(Stage stage, uint32_t us);
+void recordError(Stage stage);
+void sampleHeap();
+
+// Measures the cost of a ScopedTimer once; call from setup().
+void calibrate();
+uint32_t probeNs();
+
+// Upper bound of the bucket holding the given percentile (0..100).
+uint32_t percentileUs(const Histogram &h, uint8_t pct);
+const Histogram &histogram(Stage stage);
+
+// Writes the "telemetry" line-protocol line for the current interval.
+// seriesKey is measurement plus escaped tags. Returns the line length (0
+// if it didn't fit).
+size_t formatLine(char *buf, size_t cap, const char *seriesKey = "telemetry");
+// Starts a new interval; call once the line was accepted, so a failed
+// upload carries its interval over into the next line
+void reset();
+
+class ScopedTimer {
+public:
+  explicit ScopedTimer(Stage stage) : _stage(stage), _t0(nowUs()) {}
+  ~ScopedTimer() { record(_stage, nowUs() - _t0); }
+
+private:
+  Stage _stage;
+  uint32_t _t0;
+};
+
+#define TELEMETRY_CONCAT_(a, b) a##b
+#define TELEMETRY_CONCAT(a, b) TELEMETRY_CONCAT_(a, b)
+#define TELEMETRY_SCOPE(stage)                                                 \
+  Telemetry::ScopedTimer TELEMETRY_CONCAT(_telemetryScope, __LINE__)(stage)
+#define TELEMETRY_ERROR(stage) Telemetry::recordError(stage)
+#define TELEMETRY_RECORD(stage, us) Telemetry::record(stage, us)
+#define TELEMETRY_SAMPLE_HEAP() Telemetry::sampleHeap()
+
+#else
+
+#define TELEMETRY_SCOPE(stage) ((void)0)
+#define TELEMETRY_ERROR(stage) ((void)0)
+#define TELEMETRY_RECORD(stage, us) ((void)0)
+#define TELEMETRY_SAMPLE_HEAP() ((void)0)
+
+#endif
+
+} // namespace Telemetry
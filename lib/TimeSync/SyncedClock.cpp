@@ -0,0 +1,44 @@
+// lib/TimeSync/SyncedClock.cpp
+#include "SyncedClock.h"
+
+int64_t SyncedClock::toEpochMs(uint32_t monoMs) const {
+  // Samples up to MAX_BEFORE_ANCHOR_MS older than the anchor convert
+  // backwards; anything else is after it, for the whole millis() period
+  const uint32_t behind = _anchorMono - monoMs;
+  const int64_t elapsed = behind <= MAX_BEFORE_ANCHOR_MS
+                              ? -(int64_t)behind
+                              : (int64_t)(monoMs - _anchorMono);
+  return _anchorEpoch + elapsed + (int64_t)((float)elapsed * _drift);
+}
+
+uint32_t SyncedClock::toEpochSeconds(uint32_t monoMs) const {
+  return (uint32_t)((toEpochMs(monoMs) + 500) / 1000);
+}
+
+int32_t SyncedClock::sync(uint32_t monoMs, int64_t epochMs) {
+  int32_t offset = 0;
+  if (_syncs == 0) {
+    _refMono = monoMs;
+    _refEpoch = epochMs;
+  } else {
+    offset = (int32_t)(toEpochMs(monoMs) - epochMs);
+    // The rate is measured against the reference pair, which only moves
+    // once an interval was long enough, so frequent syncs still add up
+    const uint32_t elapsedMono = monoMs - _refMono;
+    if (elapsedMono >= MIN_DRIFT_INTERVAL_MS) {
+      const float rate = (float)(epochMs - _refEpoch - (int64_t)elapsedMono) /
+                         (float)elapsedMono;
+      if (rate * 1e6f < MAX_DRIFT_PPM && rate * 1e6f > -MAX_DRIFT_PPM) {
+        _drift = _driftKnown ? _drift + DRIFT_SMOOTHING * (rate - _drift)
+                             : rate;
+        _driftKnown = true;
+      }
+      _refMono = monoMs;
+      _refEpoch = epochMs;
+    }
+  }
+  _anchorMono = monoMs;
+  _anchorEpoch = epochMs;
+  _syncs++;
+  return offset;
+}
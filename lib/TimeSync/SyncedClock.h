@@ -0,0 +1,56 @@
+// lib/TimeSync/SyncedClock.h
+#pragma once
+#include <stdint.h>
+
+/*
+  Wall time for millis() timestamps, corrected for oscillator drift.
+
+  Acquisition times stay on the monotonic millis() clock, so an SNTP step
+  never reorders or duplicates samples; they are converted to wall time
+  only when written. Every SNTP sync hands in a (millis, epoch ms) pair:
+
+  - The newest pair is the anchor; conversions extrapolate from it.
+  - The wall time that elapsed between syncs against the millis() that
+    elapsed gives the local oscillator's rate error. It is smoothed
+    over syncs and applied to the extrapolation, so timestamps don't
+    drift by the crystal's tolerance (+-20 ppm, ~70 ms per hour) between
+    syncs or during an outage that keeps SNTP away for days.
+  - Intervals shorter than MIN_DRIFT_INTERVAL_MS are too dominated by
+    network jitter to estimate the rate; implausible rates (a manual
+    clock step, a bad server) are ignored.
+
+  Until the first sync there is no wall time at all: synced() is false
+  and callers mark their timestamps as low quality.
+*/
+class SyncedClock {
+public:
+  static constexpr uint32_t MIN_DRIFT_INTERVAL_MS = 15UL * 60 * 1000;
+  static constexpr float MAX_DRIFT_PPM = 500.0f;
+  static constexpr float DRIFT_SMOOTHING = 0.3f; // weight of a new estimate
+  // toEpochMs() takes a time this far before the anchor as earlier (a day
+  // of history, long events); any other is later, up to ~42 days
+  static constexpr uint32_t MAX_BEFORE_ANCHOR_MS = 7UL * 24 * 3600 * 1000;
+
+  // Records a sync. Returns the wall time predicted for monoMs minus
+  // epochMs (the error accumulated since the previous sync), 0 for the
+  // first.
+  int32_t sync(uint32_t monoMs, int64_t epochMs);
+
+  bool synced() const { return _syncs > 0; }
+  int64_t toEpochMs(uint32_t monoMs) const;
+  // Rounded to the nearest second
+  uint32_t toEpochSeconds(uint32_t monoMs) const;
+
+  float driftPpm() const { return _drift * 1e6f; }
+  uint32_t syncs() const { return _syncs; }
+  uint32_t lastSyncMs() const { return _anchorMono; }
+
+private:
+  uint32_t _anchorMono = 0;
+  int64_t _anchorEpoch = 0;
+  uint32_t _refMono = 0; // start of the current rate measurement
+  int64_t _refEpoch = 0;
+  float _drift = 0.0f; // wall ms per millis() ms, minus 1
+  bool _driftKnown = false;
+  uint32_t _syncs = 0;
+};
@@ -0,0 +1,228 @@
+// lib/Uplink/UplinkBatch.cpp
+#include "UplinkBatch.h"
+
+#include <string.h>
+
+namespace Uplink {
+
+static const uint8_t MAGIC[4] = {'S', '6', 'U', 'B'};
+static constexpr size_t HEADER_FIXED = 14; // magic .. base time
+
+static uint32_t zigzag(int32_t v) {
+  return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static int32_t unzigzag(uint32_t v) {
+  return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+// ===== Writer =====
+BatchWriter::BatchWriter(uint8_t *buf, size_t cap) : _buf(buf), _cap(cap) {}
+
+bool BatchWriter::putVarint(uint32_t v) {
+  do {
+    if (_len >= _cap)
+      return false;
+    const uint8_t b = v & 0x7F;
+    v >>= 7;
+    _buf[_len++] = v ? (uint8_t)(b | 0x80) : b;
+  } while (v);
+  return true;
+}
+
+bool BatchWriter::putString(const char *s) {
+  const size_t n = s ? strlen(s) : 0;
+  if (n > 255 || !putVarint((uint32_t)n) || _cap - _len < n)
+    return false;
+  memcpy(_buf + _len, s, n);
+  _len += n;
+  return true;
+}
+
+bool BatchWriter::begin(int64_t baseEpochMs, const char *device,
+                        const char *room, const char *site,
+                        const char *const *sensorTags, uint8_t sensorCount) {
+  _len = 0;
+  _records = 0;
+  _sensors = 0;
+  if (sensorCount > MAX_SENSORS || _cap < HEADER_FIXED)
+    return false;
+  memcpy(_buf, MAGIC, 4);
+  _buf[4] = VERSION;
+  _buf[5] = SCHEMA_SEN66_TICKS;
+  for (uint8_t i = 0; i < 8; ++i)
+    _buf[6 + i] = (uint8_t)((uint64_t)baseEpochMs >> (8 * i));
+  _len = HEADER_FIXED;
+  bool ok = putString(device) && putString(room) && putString(site) &&
+            putVarint(sensorCount);
+  for (uint8_t i = 0; ok && i < sensorCount; ++i)
+    ok = putString(sensorTags[i]);
+  if (!ok) {
+    _len = 0;
+    return false;
+  }
+  _sensors = sensorCount;
+  _lastMs = baseEpochMs;
+  for (uint8_t i = 0; i < MAX_SENSORS; ++i)
+    _seen[i] = false;
+  return true;
+}
+
+bool BatchWriter::add(uint8_t sensor, int64_t epochMs,
+                      const History::Ticks &ticks, uint32_t status,
+                      uint32_t seq) {
+  if (sensor >= _sensors || _len == 0)
+    return false;
+  const size_t start = _len;
+  const bool first = !_seen[sensor];
+  uint16_t mask = 0;
+  for (uint8_t c = 0; c < CHANNEL_COUNT; ++c)
+    if (first || ticks.v[c] != _prev[sensor].v[c])
+      mask |= 1u << c;
+  if (first || status != _prevStatus[sensor])
+    mask |= MASK_STATUS;
+  if (first || seq != _prevSeq[sensor] + 1)
+    mask |= MASK_SEQ;
+
+  bool ok = _cap - _len >= 3;
+  if (ok) {
+    _buf[_len++] = sensor;
+    ok = putVarint(zigzag((int32_t)(epochMs - _lastMs)));
+  }
+  if (ok && _cap - _len >= 2) {
+    _buf[_len++] = (uint8_t)mask;
+    _buf[_len++] = (uint8_t)(mask >> 8);
+  } else {
+    ok = false;
+  }
+  for (uint8_t c = 0; ok && c < CHANNEL_COUNT; ++c) {
+    if (!(mask & (1u << c)))
+      continue;
+    const int32_t prev = first ? 0 : _prev[sensor].v[c];
+    ok = putVarint(zigzag((int32_t)ticks.v[c] - prev));
+  }
+  if (ok && (mask & MASK_STATUS))
+    ok = putVarint(status);
+  if (ok && (mask & MASK_SEQ))
+    ok = putVarint(seq);
+  if (!ok) {
+    _len = start;
+    return false;
+  }
+
+  _lastMs = epochMs;
+  _prev[sensor] = ticks;
+  _prevStatus[sensor] = status;
+  _prevSeq[sensor] = seq;
+  _seen[sensor] = true;
+  _records++;
+  return true;
+}
+
+// ===== Reader =====
+BatchReader::BatchReader(const uint8_t *data, size_t len)
+    : _data(data), _len(len) {}
+
+bool BatchReader::fail(const char *error) {
+  _error = error;
+  return false;
+}
+
+bool BatchReader::getVarint(uint32_t &v) {
+  v = 0;
+  for (uint8_t shift = 0; shift < 35; shift += 7) {
+    if (_pos >= _len)
+      return false;
+    const uint8_t b = _data[_pos++];
+    v |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80))
+      return true;
+  }
+  return false;
+}
+
+bool BatchReader::getText(Text &t) {
+  uint32_t n;
+  if (!getVarint(n) || n > 255 || _len - _pos < n)
+    return false;
+  t.data = (const char *)_data + _pos;
+  t.len = (uint8_t)n;
+  _pos += n;
+  return true;
+}
+
+bool BatchReader::begin() {
+  _pos = 0;
+  _error = nullptr;
+  if (_len < HEADER_FIXED || memcmp(_data, MAGIC, 4) != 0)
+    return fail("not an uplink batch");
+  _version = _data[4];
+  if (_version != 1 && _version != VERSION)
+    return fail("unsupported version");
+  if (_data[5] != SCHEMA_SEN66_TICKS)
+    return fail("unknown schema");
+  uint64_t base = 0;
+  for (uint8_t i = 0; i < 8; ++i)
+    base |= (uint64_t)_data[6 + i] << (8 * i);
+  _baseMs = _lastMs = (int64_t)base;
+  _pos = HEADER_FIXED;
+  uint32_t sensors;
+  if (!getText(_device) || !getText(_room) || !getText(_site) ||
+      !getVarint(sensors))
+    return fail("truncated header");
+  if (sensors > MAX_SENSORS)
+    return fail("too many sensors");
+  _sensors = (uint8_t)sensors;
+  for (uint8_t i = 0; i < _sensors; ++i)
+    if (!getText(_tags[i]))
+      return fail("truncated header");
+  memset(_prev, 0, sizeof(_prev));
+  for (uint8_t i = 0; i < MAX_SENSORS; ++i)
+    _prev[i].v[History::CH_HCHO] = 0xFFFF; // not in the schema: unknown
+  memset(_prevStatus, 0, sizeof(_prevStatus));
+  memset(_prevSeq, 0, sizeof(_prevSeq));
+  return true;
+}
+
+bool BatchReader::next(Record &r) {
+  if (_error || _pos >= _len)
+    return false;
+  r.sensor = _data[_pos++];
+  if (r.sensor >= _sensors)
+    return fail("bad sensor index");
+  uint32_t v;
+  if (!getVarint(v) || _len - _pos < 2)
+    return fail("truncated record");
+  _lastMs += unzigzag(v);
+  r.epochMs = _lastMs;
+  const uint16_t mask = (uint16_t)(_data[_pos] | _data[_pos + 1] << 8);
+  _pos += 2;
+
+  History::Ticks &prev = _prev[r.sensor];
+  for (uint8_t c = 0; c < CHANNEL_COUNT; ++c) {
+    if (!(mask & (1u << c)))
+      continue;
+    if (!getVarint(v))
+      return fail("truncated record");
+    prev.v[c] = (uint16_t)(prev.v[c] + unzigzag(v));
+  }
+  if (mask & MASK_STATUS) {
+    if (!getVarint(_prevStatus[r.sensor]))
+      return fail("truncated record");
+  }
+  uint32_t &seq = _prevSeq[r.sensor];
+  if (_version == 1) {
+    seq = 0;
+  } else if (mask & MASK_SEQ) {
+    if (!getVarint(seq))
+      return fail("truncated record");
+  } else {
+    seq++;
+  }
+  r.ticks = prev;
+  r.status = _prevStatus[r.sensor];
+  r.seq = seq;
+  return true;
+}
+
+} // namespace Uplink
@@ -0,0 +1,152 @@
+// lib/Uplink/UplinkBatch.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include <History.h>
+
+/*
+  Binary uplink batch: every sample of every sensor since the last POST,
+  as the SEN66's own 16-bit words (History::Ticks, lossless, "unknown"
+  markers included), delta coded. The bridge (src/bridge) turns a batch
+  back into the node's "environment" lines.
+
+  Layout (little-endian; varint = LEB128, zvarint = zigzag + LEB128):
+
+    header
+      4  magic "S6UB"
+      1  uint8   version (2; 1 has no sequence numbers)
+      1  uint8   schema: SCHEMA_SEN66_TICKS = the SEN66's 14 channels
+                 (History::Channel order up to CH_HCHO, which is not
+                 carried) plus the device status word
+      8  int64   base time [ms since epoch]
+      .  device, room, site: varint length + bytes each
+      .  varint  sensor count, then each sensor tag (length + bytes)
+    records, up to the end of the body
+      1  uint8   sensor index
+      .  zvarint time [ms], relative to the previous record (the first:
+                 to the base time)
+      2  uint16  mask: bit c = channel c follows, bit 14 = status follows,
+                 bit 15 = sequence number follows
+      .  zvarint per channel in the mask: tick delta to the same sensor's
+                 previous record in this batch (the first: to 0)
+      .  varint  status word, if in the mask
+      .  varint  sequence number, if in the mask; otherwise the same
+                 sensor's previous record's + 1. The first record of
+                 each sensor always carries it.
+
+  An unchanged channel costs nothing, a noisy one usually a byte: a
+  steady 1 Hz sample is ~10 bytes against ~400 as line protocol. The
+  sequence number (the node's sample count, see Record::seq) only costs
+  bytes where samples are missing.
+*/
+
+namespace Uplink {
+
+constexpr uint8_t VERSION = 2;
+constexpr uint8_t SCHEMA_SEN66_TICKS = 1;
+constexpr uint8_t MAX_SENSORS = 8;
+// Channels of the schema; a decoded record's HCHO is "unknown"
+constexpr uint8_t CHANNEL_COUNT = History::CH_HCHO;
+constexpr uint16_t MASK_STATUS = 1u << CHANNEL_COUNT;
+static_assert(MASK_STATUS == 1u << 14, "the batch layout has 14 channels");
+constexpr uint16_t MASK_SEQ = 1u << 15;
+
+struct Record {
+  uint8_t sensor;
+  int64_t epochMs;
+  History::Ticks ticks;
+  uint32_t status;
+  // The sensor's sample number on the node, counted from 1 at boot;
+  // 0 in a version 1 batch
+  uint32_t seq;
+};
+
+class BatchWriter {
+public:
+  BatchWriter(uint8_t *buf, size_t cap);
+
+  // Starts a new batch (tags are copied); false if the header does not
+  // fit or there are too many sensors
+  bool begin(int64_t baseEpochMs, const char *device, const char *room,
+             const char *site, const char *const *sensorTags,
+             uint8_t sensorCount);
+  // Drops the batch; add() fails until the next begin()
+  void reset() {
+    _len = 0;
+    _records = 0;
+  }
+  // False, with nothing written, if the record does not fit
+  bool add(uint8_t sensor, int64_t epochMs, const History::Ticks &ticks,
+           uint32_t status, uint32_t seq);
+
+  const uint8_t *data() const { return _buf; }
+  size_t length() const { return _len; }
+  size_t capacity() const { return _cap; }
+  uint32_t records() const { return _records; }
+
+private:
+  bool putVarint(uint32_t v);
+  bool putString(const char *s);
+
+  uint8_t *_buf;
+  size_t _cap;
+  size_t _len = 0;
+  uint32_t _records = 0;
+  uint8_t _sensors = 0;
+  int64_t _lastMs = 0;
+  History::Ticks _prev[MAX_SENSORS];
+  uint32_t _prevStatus[MAX_SENSORS];
+  uint32_t _prevSeq[MAX_SENSORS];
+  bool _seen[MAX_SENSORS];
+};
+
+// A length-delimited string inside the batch
+struct Text {
+  const char *data;
+  uint8_t len;
+};
+
+class BatchReader {
+public:
+  BatchReader(const uint8_t *data, size_t len);
+
+  // Parses the header; false (see error()) if it is not a batch this
+  // reader understands
+  bool begin();
+  // Next record; false at the end of the body or on a malformed record
+  bool next(Record &r);
+  // Null unless begin() or next() failed
+  const char *error() const { return _error; }
+
+  uint8_t version() const { return _version; }
+  int64_t baseEpochMs() const { return _baseMs; }
+  const Text &device() const { return _device; }
+  const Text &room() const { return _room; }
+  const Text &site() const { return _site; }
+  uint8_t sensorCount() const { return _sensors; }
+  const Text &sensorTag(uint8_t i) const { return _tags[i]; }
+
+private:
+  bool getVarint(uint32_t &v);
+  bool getText(Text &t);
+  bool fail(const char *error);
+
+  const uint8_t *_data;
+  size_t _len;
+  size_t _pos = 0;
+  const char *_error = nullptr;
+  uint8_t _version = 0;
+  int64_t _baseMs = 0;
+  int64_t _lastMs = 0;
+  Text _device = {};
+  Text _room = {};
+  Text _site = {};
+  uint8_t _sensors = 0;
+  Text _tags[MAX_SENSORS];
+  History::Ticks _prev[MAX_SENSORS];
+  uint32_t _prevStatus[MAX_SENSORS];
+  uint32_t _prevSeq[MAX_SENSORS];
+};
+
+} // namespace Uplink
@@ -0,0 +1,303 @@
+#!/usr/bin/env python3
+"""End-to-end test of the uplink bridge (src/bridge) against a stand-in InfluxDB.
+
+  bridge_test.py BRIDGE_BINARY [--records 600]
+
+Starts a local HTTP server that records /api/v2/write requests the way
+InfluxDB would answer them, starts the bridge pointed at it, and posts
+binary batches (format: lib/Uplink/UplinkBatch.h) encoded here
+independently of the firmware. Checks that
+
+  - every record arrives as one "environment" line with the node's tags,
+    field values matching the ticks, its sequence number and a ms
+    timestamp; a version 1 batch (no sequence numbers) still does;
+  - the query and Authorization header are passed through, with
+    precision=ms added;
+  - InfluxDB's status is relayed (a 500 from InfluxDB reaches the node),
+    a malformed batch is answered 400 and an unreachable InfluxDB 502;
+
+and prints the wire size of the batches against the lines they became.
+Build the bridge with `pio run -e native_bridge` first
+(.pio/build/native_bridge/program).
+"""
+
+import argparse
+import random
+import socket
+import struct
+import subprocess
+import sys
+import threading
+import urllib.error
+import urllib.request
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlparse
+
+MAGIC = b"S6UB"
+VERSION = 2
+SCHEMA_SEN66_TICKS = 1
+MASK_STATUS = 1 << 14
+MASK_SEQ = 1 << 15
+
+# History::Channel order: field name, ticks per unit (lib/History) and
+# decimals on the line (lib/LineProtocol/EnvironmentLine.cpp)
+CHANNELS = [("pm1_0", 10, 1), ("pm2_5", 10, 1), ("pm4_0", 10, 1),
+            ("pm10", 10, 1), ("humidity", 100, 2), ("temperature", 200, 2),
+            ("voc", 10, 1), ("nox", 10, 1), ("co2", 1, 0), ("nc0_5", 10, 1),
+            ("nc1_0", 10, 1), ("nc2_5", 10, 1), ("nc4_0", 10, 1),
+            ("nc10", 10, 1)]
+DECIMALS = {name: d for name, _, d in CHANNELS}
+SIGNED = range(4, 8)  # humidity .. nox
+UNKNOWN_U, UNKNOWN_S = 0xFFFF, 0x7FFF
+
+DEVICE, ROOM, SITE = "sen66-test", "office", "home"
+SENSORS = ["a", "b"]
+TOKEN = "Token test-token"
+
+
+# ===== Batch encoder =====
+def varint(v):
+    out = bytearray()
+    while True:
+        b = v & 0x7F
+        v >>= 7
+        out.append(b | 0x80 if v else b)
+        if not v:
+            return bytes(out)
+
+
+def zigzag(v):
+    return (v << 1) ^ (v >> 31) if v >= 0 else ((v << 1) ^ -1) & 0xFFFFFFFF
+
+
+def text(s):
+    b = s.encode()
+    return varint(len(b)) + b
+
+
+def encode_batch(records, version=VERSION):
+    """records: [(sensor, epoch_ms, ticks[14], status, seq)] in time order."""
+    base = records[0][1] if records else 0
+    out = bytearray(MAGIC + bytes([version, SCHEMA_SEN66_TICKS]))
+    out += struct.pack("<q", base)
+    out += text(DEVICE) + text(ROOM) + text(SITE) + varint(len(SENSORS))
+    for tag in SENSORS:
+        out += text(tag)
+    last_ms, prev = base, {}
+    for sensor, ms, ticks, status, seq in records:
+        p = prev.get(sensor)
+        mask = 0
+        for c in range(14):
+            if p is None or ticks[c] != p[0][c]:
+                mask |= 1 << c
+        if p is None or status != p[1]:
+            mask |= MASK_STATUS
+        if version >= 2 and (p is None or seq != p[2] + 1):
+            mask |= MASK_SEQ
+        out += bytes([sensor]) + varint(zigzag(ms - last_ms))
+        out += struct.pack("<H", mask)
+        for c in range(14):
+            if mask & (1 << c):
+                out += varint(zigzag(ticks[c] - (p[0][c] if p else 0)))
+        if mask & MASK_STATUS:
+            out += varint(status)
+        if mask & MASK_SEQ:
+            out += varint(seq)
+        last_ms, prev[sensor] = ms, (ticks, status, seq)
+    return bytes(out)
+
+
+def synth_records(count, start_ms, rng):
+    """A plausible 1 Hz day fragment for two sensors, a few unknowns and
+    a stretch of samples that never made it into a batch."""
+    level = {"co2": 600.0, "pm": 8.0, "t": 22.0, "rh": 45.0, "voc": 100.0}
+    records = []
+    for i in range(count // len(SENSORS)):
+        level["co2"] += rng.uniform(-2, 3)
+        level["pm"] = max(0.0, level["pm"] + rng.uniform(-0.3, 0.3))
+        level["t"] += rng.uniform(-0.01, 0.01)
+        level["rh"] += rng.uniform(-0.05, 0.05)
+        for s in range(len(SENSORS)):
+            pm = level["pm"] + s
+            values = [pm * 0.7, pm, pm * 1.1, pm * 1.2, level["rh"],
+                      level["t"] + s * 0.3, level["voc"], 1.0, level["co2"],
+                      pm * 5, pm * 6, pm * 6.5, pm * 6.6, pm * 6.7]
+            ticks = [int(round(v * scale)) for v, (_, scale, _) in
+                     zip(values, CHANNELS)]
+            if i < 3:  # NOx is unknown for the first seconds after start
+                ticks[7] = UNKNOWN_S
+            ticks = [t & 0xFFFF for t in ticks]
+            ms = start_ms + i * 1000 + rng.randint(0, 40) + s * 3
+            seq = 1000 + i + (7 if i > 50 else 0)
+            records.append((s, ms, ticks, 0 if i % 97 else 0x10, seq))
+    return records
+
+
+def expected_fields(ticks, status, seq):
+    fields = {}
+    for c, (name, scale, _) in enumerate(CHANNELS):
+        t = ticks[c]
+        if t == (UNKNOWN_S if c in SIGNED else UNKNOWN_U):
+            continue
+        if c in SIGNED and t >= 0x8000:
+            t -= 0x10000
+        fields[name] = t / scale
+    fields["status"] = status
+    if seq:
+        fields["seq"] = seq
+    return fields
+
+
+# ===== Stand-in InfluxDB =====
+class Influx(BaseHTTPRequestHandler):
+    writes = []
+    fail_next = 0
+
+    def do_POST(self):
+        body = self.rfile.read(int(self.headers.get("Content-Length", 0)))
+        url = urlparse(self.path)
+        if url.path != "/api/v2/write":
+            self.reply(404, b"not found")
+        elif Influx.fail_next:
+            Influx.fail_next -= 1
+            self.reply(500, b'{"code":"internal error"}')
+        else:
+            Influx.writes.append((parse_qs(url.query),
+                                  self.headers.get("Authorization"),
+                                  body.decode()))
+            self.reply(204, b"")
+
+    def reply(self, code, body):
+        self.send_response(code)
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+    def log_message(self, *args):
+        pass
+
+
+def free_port():
+    with socket.socket() as s:
+        s.bind(("127.0.0.1", 0))
+        return s.getsockname()[1]
+
+
+def post(port, body, query="bucket=air&org=home"):
+    req = urllib.request.Request(
+        f"http://127.0.0.1:{port}/sen66/v1/batch?{query}", data=body,
+        method="POST", headers={"Authorization": TOKEN,
+                                "Content-Type": "application/octet-stream"})
+    try:
+        with urllib.request.urlopen(req, timeout=10) as r:
+            return r.status
+    except urllib.error.HTTPError as e:
+        return e.code
+
+
+def parse_line(line):
+    head, fields, stamp = line.rsplit(" ", 2)
+    tags = dict(kv.split("=", 1) for kv in head.split(",")[1:])
+    values = {}
+    for kv in fields.split(","):
+        k, v = kv.split("=", 1)
+        values[k] = int(v[:-1]) if v.endswith("u") else float(v)
+    return head.split(",")[0], tags, values, int(stamp)
+
+
+# ===== Checks =====
+def check(cond, what):
+    if not cond:
+        print("FAIL:", what)
+        sys.exit(1)
+
+
+def check_lines(lines, records):
+    check(len(lines) == len(records),
+          f"{len(lines)} lines for {len(records)} records")
+    for line, (sensor, ms, ticks, status, seq) in zip(lines, records):
+        measurement, tags, values, stamp = parse_line(line)
+        check(measurement == "environment", line)
+        check(tags == {"device": DEVICE, "room": ROOM, "site": SITE,
+                       "sensor": SENSORS[sensor]}, f"tags of {line}")
+        check(stamp == ms, f"timestamp {stamp} != {ms}")
+        values.pop("dew_point", None)
+        want = expected_fields(ticks, status, seq)
+        check(set(values) == set(want), f"fields of {line}")
+        for k, v in want.items():
+            tolerance = 0.5 * 10 ** -DECIMALS.get(k, 0) + 1e-6
+            check(abs(values[k] - v) <= tolerance,
+                  f"{k}={values[k]} != {v} in {line}")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("bridge")
+    ap.add_argument("--records", type=int, default=600)
+    args = ap.parse_args()
+
+    influx = ThreadingHTTPServer(("127.0.0.1", 0), Influx)
+    threading.Thread(target=influx.serve_forever, daemon=True).start()
+    influx_port = influx.server_address[1]
+    port = free_port()
+    bridge = subprocess.Popen(
+        [args.bridge, "--listen", f"127.0.0.1:{port}",
+         "--influx", f"http://127.0.0.1:{influx_port}"],
+        stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+    try:
+        bridge.stdout.readline()  # "listening on ..."
+        rng = random.Random(66)
+        records = synth_records(args.records, 1_760_000_000_000, rng)
+
+        # Batches as the node cuts them
+        batch_bytes = line_bytes = 0
+        for chunk in (records[:len(records) // 3], records[len(records) // 3:]):
+            body = encode_batch(chunk)
+            check(post(port, body) == 204, "batch not accepted")
+            query, auth, lines = Influx.writes[-1]
+            check(query == {"bucket": ["air"], "org": ["home"],
+                            "precision": ["ms"]}, f"query {query}")
+            check(auth == TOKEN, f"authorization {auth}")
+            check_lines(lines.splitlines(), chunk)
+            batch_bytes += len(body)
+            line_bytes += len(lines)
+        print(f"ok: {len(records)} records, {batch_bytes} batch bytes -> "
+              f"{line_bytes} line bytes ({line_bytes / batch_bytes:.1f}x, "
+              f"{batch_bytes / len(records):.1f} B/sample)")
+
+        # Nodes still sending version 1
+        old = records[:20]
+        check(post(port, encode_batch(old, version=1)) == 204,
+              "version 1 batch not accepted")
+        check_lines(Influx.writes[-1][2].splitlines(),
+                    [r[:4] + (0,) for r in old])
+        print("ok: version 1 batch, no sequence numbers")
+
+        # InfluxDB failures reach the node, which keeps the batch
+        writes = len(Influx.writes)
+        Influx.fail_next = 1
+        check(post(port, encode_batch(records[:10])) == 500, "500 not relayed")
+        check(len(Influx.writes) == writes, "failed write recorded")
+        print("ok: InfluxDB status relayed")
+
+        # Malformed batches
+        good = encode_batch(records[:10])
+        for name, body in [("garbage", b"not a batch"),
+                           ("bad version", good[:4] + b"\x03" + good[5:]),
+                           ("truncated", good[:-3])]:
+            check(post(port, body) == 400, f"{name} not rejected")
+        check(len(Influx.writes) == writes, "malformed batch forwarded")
+        print("ok: malformed batches rejected")
+
+        influx.shutdown()
+        influx.server_close()
+        check(post(port, good) == 502, "unreachable InfluxDB not 502")
+        print("ok: unreachable InfluxDB reported")
+    finally:
+        bridge.terminate()
+        bridge.wait()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+"""End-to-end test of the Linux gateway (src/gateway) on mocked i2c-dev adapters.
+
+  gateway_test.py GATEWAY_BINARY [--seconds 5]
+
+Runs the gateway with --mock, which swaps the kernel's ioctl layer for
+fake adapters (src/gateway/MockI2c.h): a SEN6x directly on one adapter
+and two behind a TCA9548A on another. Each fake sensor's values depend
+only on where it sits, so the checks below catch a read that reached
+the wrong sensor. Checks that
+
+  - every sensor delivers about one "environment" line per second with
+    its tags, its own values, increasing ms timestamps and consecutive
+    sequence numbers;
+  - no transfer failed, and each sample's response reads were combined
+    with the next command (two per sample at least);
+  - with bits flipped on the bus, CRC errors are counted and no
+    corrupted value reaches a line;
+  - clashing sensor addresses and a missing adapter are refused.
+
+Build the gateway with `pio run -e native_gateway` first
+(.pio/build/native_gateway/program).
+"""
+
+import argparse
+import re
+import subprocess
+import sys
+import time
+
+DEVICE, ROOM, SITE = "gw-test", "lab", "home"
+# tag, adapter path, mux channel (None: directly on the bus)
+SENSORS = [("a", "mock0", None), ("b", "mock1", 0), ("c", "mock1", 5)]
+# Decimals on the line (lib/LineProtocol/EnvironmentLine.cpp)
+DECIMALS = {"pm1_0": 1, "pm2_5": 1, "pm4_0": 1, "pm10": 1, "humidity": 2,
+            "temperature": 2, "voc": 1, "nox": 1, "co2": 0, "hcho": 1,
+            "nc0_5": 1, "nc1_0": 1, "nc2_5": 1, "nc4_0": 1, "nc10": 1}
+
+
+def sensor_values(adapter, position):
+    """MockI2c::sensorValues(): position 0 on the bus, 1 + channel behind the mux."""
+    k = adapter * 10 + position
+    return {"pm1_0": 3 + k, "pm2_5": 5 + k, "pm4_0": 6 + k, "pm10": 7 + k,
+            "humidity": 40 + k, "temperature": 20 + k / 2, "voc": 100 + 10 * k,
+            "nox": 1 + k, "co2": 500 + 10 * k, "hcho": 20 + k,
+            "nc0_5": 20 + k, "nc1_0": 24 + k, "nc2_5": 25 + k,
+            "nc4_0": 25.5 + k, "nc10": 26 + k}
+
+
+def expected():
+    adapters = []
+    out = {}
+    for tag, path, channel in SENSORS:
+        if path not in adapters:
+            adapters.append(path)
+        position = 0 if channel is None else 1 + channel
+        out[tag] = sensor_values(adapters.index(path), position)
+    return out
+
+
+def parse_line(line):
+    head, fields, stamp = line.rsplit(" ", 2)
+    tags = dict(kv.split("=", 1) for kv in head.split(",")[1:])
+    values = {}
+    for kv in fields.split(","):
+        k, v = kv.split("=", 1)
+        values[k] = float(v)
+    return head.split(",")[0], tags, values, int(stamp)
+
+
+def run(gateway, seconds, *extra):
+    args = [gateway, "--mock", "--device", DEVICE, "--room", ROOM,
+            "--site", SITE, "--duration", str(seconds)]
+    for tag, path, channel in SENSORS:
+        spec = path if channel is None else f"{path}@{channel}"
+        args += ["--sensor", f"{spec}={tag}"]
+    start_ms = time.time() * 1000
+    p = subprocess.run(args + list(extra), capture_output=True, text=True,
+                       timeout=seconds + 30)
+    end_ms = time.time() * 1000
+    check(p.returncode == 0, f"exit {p.returncode}: {p.stderr}")
+    return p.stdout.splitlines(), p.stderr, start_ms, end_ms
+
+
+# ===== Checks =====
+def check(cond, what):
+    if not cond:
+        print("FAIL:", what)
+        sys.exit(1)
+
+
+def check_lines(lines, seconds, start_ms, end_ms):
+    want = expected()
+    stamps = {tag: [] for tag in want}
+    seqs = {tag: [] for tag in want}
+    for line in lines:
+        measurement, tags, values, stamp = parse_line(line)
+        check(measurement == "environment", line)
+        tag = tags.get("sensor")
+        check(tag in want, f"sensor tag of {line}")
+        check(tags == {"device": DEVICE, "room": ROOM, "site": SITE,
+                       "sensor": tag}, f"tags of {line}")
+        check(start_ms - 1000 <= stamp <= end_ms, f"timestamp of {line}")
+        stamps[tag].append(stamp)
+        check("pm2_5" in values and "nc10" in values, f"fields of {line}")
+        seqs[tag].append(int(values["seq"]) if "seq" in values else None)
+        for k, v in values.items():
+            if k in ("dew_point", "status", "seq"):
+                continue
+            tolerance = 0.5 * 10 ** -DECIMALS[k] + 1e-6
+            check(abs(v - want[tag][k]) <= tolerance,
+                  f"{k}={v} != {want[tag][k]} in {line}")
+    for tag, s in stamps.items():
+        check(len(s) >= seconds - 2, f"{tag}: {len(s)} lines in {seconds} s")
+        gaps = [b - a for a, b in zip(s, s[1:])]
+        check(all(g >= 900 for g in gaps), f"{tag}: sample gaps {gaps}")
+        n = seqs[tag]
+        check(n and n[0] is not None and
+              n == list(range(n[0], n[0] + len(n))), f"{tag}: seq {n}")
+    return {tag: len(s) for tag, s in stamps.items()}
+
+
+def adapter_stats(summary):
+    """{path: (ioctls, failed, combined, crc errors)} from the exit summary."""
+    out = {}
+    for m in re.finditer(r"^  (\S+)\s+(\d+) ioctls \((\d+) failed\), "
+                         r"(\d+) combined read \+ command, (\d+) CRC errors",
+                         summary, re.M):
+        out[m.group(1)] = tuple(int(g) for g in m.groups()[1:])
+    return out
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("gateway")
+    ap.add_argument("--seconds", type=int, default=5)
+    args = ap.parse_args()
+
+    lines, summary, start_ms, end_ms = run(args.gateway, args.seconds)
+    counts = check_lines(lines, args.seconds, start_ms, end_ms)
+    stats = adapter_stats(summary)
+    check(set(stats) == {"mock0", "mock1"}, f"summary: {summary}")
+    per_adapter = {"mock0": counts["a"], "mock1": counts["b"] + counts["c"]}
+    for path, (ioctls, failed, combined, crc) in stats.items():
+        check(failed == 0 and crc == 0, f"{path}: {failed} failed, {crc} CRC")
+        check(combined >= 2 * per_adapter[path],
+              f"{path}: {combined} combined for {per_adapter[path]} lines")
+    print(f"ok: {len(lines)} lines from {len(SENSORS)} sensors in "
+          f"{args.seconds} s, " + ", ".join(
+              f"{p} {s[0]} ioctls ({s[2]} combined)" for p, s in stats.items()))
+
+    lines, summary, start_ms, end_ms = run(args.gateway, args.seconds,
+                                           "--mock-noise", "0.05")
+    check_lines(lines, args.seconds, start_ms, end_ms)
+    crc = sum(s[3] for s in adapter_stats(summary).values())
+    check(crc > 0, "no CRC errors with --mock-noise")
+    print(f"ok: {crc} CRC errors on a noisy bus, no corrupted values")
+
+    clash = subprocess.run([args.gateway, "--mock", "--sensor", "mock0",
+                            "--sensor", "mock0@1"], capture_output=True)
+    check(clash.returncode == 2, "clashing sensors accepted")
+    missing = subprocess.run([args.gateway, "--sensor", "/dev/i2c-does-not-exist",
+                              "--duration", "1"], capture_output=True)
+    check(missing.returncode == 1, "missing adapter accepted")
+    print("ok: clashing sensors and missing adapter refused")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
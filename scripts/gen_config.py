@@ -1,4 +1,6 @@
+import base64
 import os
+import re
 from pathlib import Path
 
 try:  # Running under PlatformIO's SCons environment
@@ -46,41 +48,172 @@ def get(name, default=""):
     return os.environ.get(name, default)
 
 
-# Load .env from project root so values are available during PlatformIO builds
-load_dotenv(ROOT / ".env")
-
-template = f"""// generated from environment variables
-#pragma once
-
-// ===== WiFi credentials =====
-#define WIFI_SSID \"{c_string(get('WIFI_SSID'))}\"
-#define WIFI_PASSWORD \"{c_string(get('WIFI_PASSWORD'))}\"
-
-#define MEASUREMENT_INTERVAL_MS {get('MEASUREMENT_INTERVAL_MS', '20000')}UL
+def sensor_table(spec):
+    """Parse SEN66_SENSORS into (count, C initializer).
 
-// ===== OTA =====
-#define OTA_HOSTNAME "{get('OTA_HOSTNAME', 'sen66-esp32')}"
-#define OTA_PASSWORD "{get('OTA_PASSWORD', 'admin')}"
-
-// ===== Ventilation Detection =====
+    Comma-separated entries ``tag:bus[:channel]``; bus 0 is Wire, 1 is Wire1,
+    channel selects a TCA9548A port on that bus. Empty means one sensor on
+    Wire with no tag, i.e. the single-sensor layout.
+    """
+    entries = []
+    for item in filter(None, (e.strip() for e in spec.split(","))):
+        parts = item.split(":")
+        if len(parts) not in (2, 3) or not parts[0]:
+            raise SystemExit(f"SEN66_SENSORS: bad entry '{item}' (tag:bus[:channel])")
+        tag, bus = parts[0], int(parts[1])
+        channel = int(parts[2]) if len(parts) == 3 else -1
+        if bus not in (0, 1) or not -1 <= channel <= 7:
+            raise SystemExit(f"SEN66_SENSORS: bus/channel out of range in '{item}'")
+        entries.append(f'{{"{c_string(tag)}", {bus}, {channel}}}')
+    if not entries:
+        entries.append('{"", 0, -1}')
+    if len(entries) > 8:
+        raise SystemExit("SEN66_SENSORS: at most 8 sensors")
+    return len(entries), "{" + ", ".join(entries) + "}"
+
+
+def ca_bundle(spec):
+    """Root CAs from comma-separated PEM files as (count, lengths, C string).
+
+    Certificates are embedded as DER so the node can parse them in place
+    from flash instead of copying the PEM text into RAM.
+    """
+    ders = []
+    for name in filter(None, (n.strip() for n in spec.split(","))):
+        path = Path(name) if Path(name).is_absolute() else ROOT / name
+        if not path.exists():
+            raise SystemExit(f"TLS_CA_FILES: {path} not found")
+        for b64 in re.findall(r"-----BEGIN CERTIFICATE-----(.*?)-----END CERTIFICATE-----",
+                              path.read_text(encoding="ascii"), re.S):
+            ders.append(base64.b64decode("".join(b64.split())))
+    if not ders:
+        raise SystemExit("TLS_CA_FILES: no certificates")
+    lines = []
+    for der in ders:
+        hexed = "".join(f"\\x{b:02x}" for b in der)
+        lines += [f'    "{hexed[i:i + 96]}"' for i in range(0, len(hexed), 96)]
+    lengths = "{" + ", ".join(str(len(d)) for d in ders) + "}"
+    if len(ders) > 16:
+        raise SystemExit("TLS_CA_FILES: at most 16 certificates")
+    return len(ders), lengths, "\n".join(lines)
+
+
+def flag(name, default):
+    """A true/false .env switch as 1/0."""
+    return 1 if get(name, default).lower() in ('true', '1', 'yes') else 0
+
+
+def c_bool(name, default):
+    return "true" if flag(name, default) else "false"
 
-#define VENTILATION_CO2_DROP_THRESHOLD {get('VENTILATION_CO2_DROP_THRESHOLD', '100')} // ppm
-#define VENTILATION_WINDOW_SIZE {get('VENTILATION_WINDOW_SIZE', '5')}          // number of samples
-#define FAN_CLEANING_COOLDOWN_MS {get('FAN_CLEANING_COOLDOWN_MS', '900000')}    // 15 minutes
 
+# Load .env from project root so values are available during PlatformIO builds
+load_dotenv(ROOT / ".env")
 
-// ===== InfluxDB v2 setup =====
-#define INFLUXDB_URL \"{c_string(get('INFLUXDB_URL'))}\"
-#define INFLUXDB_ORG \"{c_string(get('INFLUXDB_ORG'))}\"
-#define INFLUXDB_BUCKET \"{c_string(get('INFLUXDB_BUCKET'))}\"
-#define INFLUXDB_TOKEN \"{c_string(get('INFLUXDB_TOKEN'))}\"
+SENSOR_COUNT, SENSOR_TABLE = sensor_table(get('SEN66_SENSORS'))
+# A change-driven node may go quiet for a heartbeat while the room is
+# steady; a full-snapshot node writes every interval
+LAMP_FRESHNESS_DEFAULT = str(2 * int(
+    get('REPORT_HEARTBEAT_MS', '300000') if flag('REPORT_CHANGE_ONLY', 'true')
+    else get('MEASUREMENT_INTERVAL_MS', '20000')) + 60000)
+TLS_CA_COUNT, TLS_CA_LENGTHS, TLS_CA_DER = ca_bundle(get('TLS_CA_FILES', 'certs/ca_bundle.pem'))
 
-// ===== External Weather/AQI Configuration =====
-// Set to 1 to enable weather data fetching from Open-Meteo (free, no API key needed)
-#define WEATHER_ENABLED {1 if get('WEATHER_ENABLED', 'true').lower() in ('true', '1', 'yes') else 0}
-// Location coordinates - find your city at: https://open-meteo.com/en/docs
-#define WEATHER_LATITUDE \"{c_string(get('WEATHER_LATITUDE', '52.52'))}\"
-#define WEATHER_LONGITUDE \"{c_string(get('WEATHER_LONGITUDE', '13.405'))}\"
+template = f"""// generated from environment variables by scripts/gen_config.py
+#pragma once
+#include "BuildConfig.h"
+
+// ===== Modules =====
+// 0 leaves the subsystem out of the image; a -D in platformio.ini's
+// build_flags overrides .env
+#ifndef WEATHER_ENABLED
+#define WEATHER_ENABLED {flag('WEATHER_ENABLED', 'true')}
+#endif
+#ifndef OTA_ENABLED
+#define OTA_ENABLED {flag('OTA_ENABLED', 'true')}
+#endif
+#ifndef INFLUX_ENABLED
+#define INFLUX_ENABLED {flag('INFLUX_ENABLED', 'true')}
+#endif
+#ifndef VENTILATION_ENABLED
+#define VENTILATION_ENABLED {flag('VENTILATION_ENABLED', 'true')}
+#endif
+#ifndef EXPOSURE_ENABLED
+#define EXPOSURE_ENABLED {flag('EXPOSURE_ENABLED', 'true')}
+#endif
+// Environment samples as binary batches to UPLINK_BRIDGE_URL (src/bridge)
+#define UPLINK_BINARY {1 if get('UPLINK_BRIDGE_URL') else 0}
+
+// ===== Settings =====
+// See include/BuildConfig.h for the fields
+constexpr BuildConfig CONFIG = {{
+    // WiFi
+    "{c_string(get('WIFI_SSID'))}",
+    "{c_string(get('WIFI_PASSWORD'))}",
+
+    // Sampling and reporting. Change-driven: a field is uploaded when it
+    // leaves its deadband (swinging door) or the heartbeat expires, with
+    // the NTP clock's timestamps; otherwise a full snapshot every interval
+    {get('MEASUREMENT_INTERVAL_MS', '20000')}UL,
+    {c_bool('REPORT_CHANGE_ONLY', 'true')},
+    {get('REPORT_HEARTBEAT_MS', '300000')}UL,
+    "{c_string(get('NTP_SERVER', 'pool.ntp.org'))}",
+    // Local time (POSIX TZ) for the exposure day, e.g. CET-1CEST,M3.5.0,M10.5.0/3
+    "{c_string(get('TIMEZONE', 'UTC0'))}",
+
+    // OTA
+    "{c_string(get('OTA_HOSTNAME', 'sen66-esp32'))}",
+    "{c_string(get('OTA_PASSWORD', 'admin'))}",
+
+    // Raw capture: record SEN66 raw frames from boot (otherwise POST /raw/start)
+    {c_bool('RAW_CAPTURE_AUTOSTART', 'false')},
+    // Heap guard (HEAP_GUARD_ENABLED builds): abort on the first heap
+    // allocation after setup() instead of counting it
+    {c_bool('HEAP_GUARD_TRAP', 'false')},
+
+    // Sensors: {{tag, bus (0=Wire, 1=Wire1), TCA9548A channel or -1}}
+    {SENSOR_COUNT},
+    {SENSOR_TABLE},
+
+    // Device / location tags, written on every line (empty values are
+    // omitted). An empty DEVICE_ID is derived at boot from the chip MAC,
+    // or from the first SEN66 serial with DEVICE_ID_SOURCE=sen66.
+    "{c_string(get('DEVICE_ID'))}",
+    {"true" if get('DEVICE_ID_SOURCE', 'mac').lower() == 'sen66' else "false"},
+    "{c_string(get('DEVICE_ROOM'))}",
+    "{c_string(get('DEVICE_SITE'))}",
+
+    // Lamp: only show LAMP_DEVICE (empty = any device in the bucket), or
+    // with LAMP_MULTI_ROOM the worst of all devices/sensors, naming the
+    // room; LAMP_SITE limits that to one site (empty = all)
+    "{c_string(get('LAMP_DEVICE'))}",
+    {c_bool('LAMP_MULTI_ROOM', 'false')},
+    "{c_string(get('LAMP_SITE'))}",
+    // Lamp: data whose newest sample is older than this is flagged
+    // (default: two of the nodes' upload or heartbeat intervals + 1 min)
+    {get('LAMP_FRESHNESS_MS') or LAMP_FRESHNESS_DEFAULT}UL,
+
+    // Ventilation detection: CO2 drop (ppm) within a window (samples)
+    {get('VENTILATION_CO2_DROP_THRESHOLD', '100')},
+    {get('VENTILATION_WINDOW_SIZE', '5')},
+    {get('FAN_CLEANING_COOLDOWN_MS', '900000')}UL, // 15 minutes
+    {get('FAN_CLEANING_INTERVAL_MS', '604800000')}UL, // 7 days
+
+    // InfluxDB v2
+    "{c_string(get('INFLUXDB_URL'))}",
+    "{c_string(get('INFLUXDB_ORG'))}",
+    "{c_string(get('INFLUXDB_BUCKET'))}",
+    "{c_string(get('INFLUXDB_TOKEN'))}",
+    "{c_string(get('UPLINK_BRIDGE_URL'))}",
+
+    // Root CAs for HTTPS (TLS_CA_FILES)
+{TLS_CA_DER},
+    {TLS_CA_COUNT},
+    {TLS_CA_LENGTHS},
+
+    // Open-Meteo location - find your city at: https://open-meteo.com/en/docs
+    "{c_string(get('WEATHER_LATITUDE', '52.52'))}",
+    "{c_string(get('WEATHER_LONGITUDE', '13.405'))}",
+}};
 """
 
 CONFIG.write_text(template, encoding="utf-8")
@@ -0,0 +1,340 @@
+#!/usr/bin/env python3
+"""Delta OTA patches for the sensor node (format: lib/DeltaOta/DeltaPatch.h).
+
+  ota_delta.py diff OLD.bin NEW.bin PATCH.sdp
+  ota_delta.py apply OLD.bin PATCH.sdp OUT.bin
+  ota_delta.py roundtrip OLD.bin NEW.bin [OLD2.bin NEW2.bin ...]
+  ota_delta.py push PATCH.sdp [--host sen66-esp32.local] [--password admin]
+
+`roundtrip` builds, applies and verifies a patch per build pair and
+reports its size against the full image. `push` uploads a patch to the
+node's delta OTA endpoint; the node checks the patch's base against its
+running image, writes the new image to the inactive OTA partition and
+reboots into it.
+
+Keep the .bin of every build that is flashed to a node: it is the base
+for the next patch (.pio/build/<env>/firmware.bin).
+"""
+
+import argparse
+import base64
+import hashlib
+import struct
+import sys
+import urllib.request
+import uuid
+import zlib
+from pathlib import Path
+
+MAGIC = b"SDP1"
+TAG_END, TAG_DIFF, TAG_INSERT = 0, 1, 2
+
+SEED = 8       # bytes of an exact match that seed a DIFF
+STEP = 4       # old image is indexed every STEP bytes
+MIN_MATCH = 16  # shorter exact matches are not worth a record
+
+
+def varint(v):
+    out = bytearray()
+    while True:
+        b = v & 0x7F
+        v >>= 7
+        if v:
+            out.append(b | 0x80)
+        else:
+            out.append(b)
+            return bytes(out)
+
+
+def zigzag(v):
+    return (v << 1) if v >= 0 else ((-v << 1) - 1)
+
+
+# ===== Matching =====
+def exact_matches(old, new):
+    """Greedy exact matches (new_pos, old_pos, length), in new order."""
+    index = {}
+    for i in range(0, len(old) - SEED + 1, STEP):
+        index.setdefault(old[i:i + SEED], i)
+
+    def extend(o, n):
+        length = 0
+        limit = min(len(old) - o, len(new) - n)
+        while length + 64 <= limit and old[o + length:o + length + 64] == new[n + length:n + length + 64]:
+            length += 64
+        while length < limit and old[o + length] == new[n + length]:
+            length += 1
+        return length
+
+    matches = []
+    n = 0
+    offset = 0
+    while n <= len(new) - SEED:
+        best_o, best_len = -1, 0
+        # Code after a change usually keeps the previous shift
+        o = n + offset
+        if 0 <= o <= len(old) - SEED and old[o:o + SEED] == new[n:n + SEED]:
+            best_o, best_len = o, extend(o, n)
+        for delta in range(STEP):
+            if n < delta:
+                break
+            cand = index.get(new[n - delta:n - delta + SEED])
+            if cand is None or cand + delta == best_o:
+                continue
+            o = cand + delta
+            if old[o:o + SEED] != new[n:n + SEED]:
+                continue
+            length = extend(o, n)
+            if length > best_len:
+                best_o, best_len = o, length
+        if best_len >= MIN_MATCH:
+            matches.append((n, best_o, best_len))
+            offset = best_o - n
+            n += best_len
+        else:
+            n += 1
+    return matches
+
+
+def best_extension(old, new, n_from, n_to, offset, forward):
+    """bsdiff-style approximate extension of a match into a gap: the
+    length maximising 2 * equal bytes - length."""
+    best, best_len, score = 0, 0, 0
+    rng = range(n_from, n_to) if forward else range(n_to - 1, n_from - 1, -1)
+    for i, n in enumerate(rng, 1):
+        o = n + offset
+        if o < 0 or o >= len(old):
+            break
+        score += 1 if old[o] == new[n] else -1
+        if score > best:
+            best, best_len = score, i
+    return best_len
+
+
+def plan(old, new):
+    """Covering of new by ("diff", new_pos, old_pos, len) and
+    ("insert", new_pos, len), in order."""
+    matches = exact_matches(old, new)
+    regions = []  # (new_start, new_end, offset)
+    for n, o, length in matches:
+        regions.append([n, n + length, o - n])
+    # Grow every region into the gaps around it
+    for i, r in enumerate(regions):
+        gap_start = regions[i - 1][1] if i else 0
+        r[0] -= best_extension(old, new, gap_start, r[0], r[2], False)
+    for i, r in enumerate(regions):
+        gap_end = regions[i + 1][0] if i + 1 < len(regions) else len(new)
+        r[1] += best_extension(old, new, r[1], gap_end, r[2], True)
+    ops = []
+    pos = 0
+    for start, end, offset in regions:
+        start = max(start, pos)
+        if start >= end:
+            continue
+        if start > pos:
+            ops.append(("insert", pos, start - pos))
+        if ops and ops[-1][0] == "diff" and ops[-1][2] - ops[-1][1] == offset \
+                and ops[-1][1] + ops[-1][3] == start:
+            _, n, o, length = ops[-1]
+            ops[-1] = ("diff", n, o, length + end - start)
+        else:
+            ops.append(("diff", start, start + offset, end - start))
+        pos = end
+    if pos < len(new):
+        ops.append(("insert", pos, len(new) - pos))
+    return ops
+
+
+# ===== Patch encoding =====
+def encode_diff(old, new, n, o, length):
+    out = bytearray()
+    i = 0
+    while i < length:
+        zeros = 0
+        while i + zeros < length and old[o + i + zeros] == new[n + i + zeros]:
+            zeros += 1
+        i += zeros
+        lits = bytearray()
+        # A literal run ends at the first stretch of 3 equal bytes
+        while i < length:
+            if i + 3 <= length and old[o + i:o + i + 3] == new[n + i:n + i + 3]:
+                break
+            lits.append((new[n + i] - old[o + i]) & 0xFF)
+            i += 1
+        out += varint(zeros) + varint(len(lits)) + lits
+    return bytes(out)
+
+
+def make_patch(old, new):
+    header = MAGIC + struct.pack("<II", len(old), len(new))
+    header += hashlib.sha256(old).digest() + hashlib.sha256(new).digest()
+    out = bytearray()
+    cursor = 0
+    for op in plan(old, new):
+        if op[0] == "insert":
+            _, n, length = op
+            out.append(TAG_INSERT)
+            out += varint(length) + new[n:n + length]
+        else:
+            _, n, o, length = op
+            out.append(TAG_DIFF)
+            out += varint(zigzag(o - cursor)) + varint(length)
+            out += encode_diff(old, new, n, o, length)
+            cursor = o + length
+    out.append(TAG_END)
+    # Records travel as raw deflate with a 32 KiB window (ROM tinfl)
+    deflate = zlib.compressobj(9, zlib.DEFLATED, -15)
+    return header + deflate.compress(bytes(out)) + deflate.flush()
+
+
+# ===== Reference patcher (mirrors DeltaPatcher) =====
+class PatchError(Exception):
+    pass
+
+
+def apply_patch(old, patch):
+    if patch[:4] != MAGIC or len(patch) < 76:
+        raise PatchError("bad header")
+    old_size, new_size = struct.unpack_from("<II", patch, 4)
+    old_hash, new_hash = patch[12:44], patch[44:76]
+    if len(old) < old_size or hashlib.sha256(old[:old_size]).digest() != old_hash:
+        raise PatchError("patch is for another base image")
+    inflate = zlib.decompressobj(-15)
+    try:
+        records = inflate.decompress(patch[76:])
+    except zlib.error:
+        raise PatchError("malformed patch")
+    if not inflate.eof or inflate.unused_data:
+        raise PatchError("patch truncated")
+    pos = 0
+
+    def read_varint():
+        nonlocal pos
+        v = shift = 0
+        while True:
+            b = records[pos]
+            pos += 1
+            v |= (b & 0x7F) << shift
+            shift += 7
+            if not b & 0x80:
+                return v
+
+    out = bytearray()
+    cursor = 0
+    while True:
+        tag = records[pos]
+        pos += 1
+        if tag == TAG_END:
+            break
+        if tag == TAG_INSERT:
+            length = read_varint()
+            out += records[pos:pos + length]
+            pos += length
+        elif tag == TAG_DIFF:
+            z = read_varint()
+            cursor += (z >> 1) ^ -(z & 1)
+            remaining = read_varint()
+            if cursor < 0 or cursor + remaining > old_size:
+                raise PatchError("malformed patch")
+            while remaining:
+                zeros = read_varint()
+                out += old[cursor:cursor + zeros]
+                cursor += zeros
+                lits = read_varint()
+                for b in records[pos:pos + lits]:
+                    out.append((old[cursor] + b) & 0xFF)
+                    cursor += 1
+                pos += lits
+                remaining -= zeros + lits
+        else:
+            raise PatchError("malformed patch")
+    if pos != len(records) or len(out) != new_size:
+        raise PatchError("patch truncated")
+    if hashlib.sha256(out).digest() != new_hash:
+        raise PatchError("new image hash mismatch")
+    return bytes(out)
+
+
+# ===== Commands =====
+def cmd_diff(args):
+    old = Path(args.old).read_bytes()
+    new = Path(args.new).read_bytes()
+    patch = make_patch(old, new)
+    if apply_patch(old, patch) != new:
+        sys.exit("internal error: patch does not reproduce the new image")
+    Path(args.patch).write_bytes(patch)
+    print(f"{args.patch}: {len(patch)} bytes ({100.0 * len(patch) / len(new):.1f}% of {len(new)})")
+
+
+def cmd_apply(args):
+    old = Path(args.old).read_bytes()
+    patch = Path(args.patch).read_bytes()
+    try:
+        Path(args.out).write_bytes(apply_patch(old, patch))
+    except PatchError as e:
+        sys.exit(f"apply failed: {e}")
+
+
+def cmd_roundtrip(args):
+    if len(args.images) % 2:
+        sys.exit("roundtrip takes OLD NEW pairs")
+    print(f"{'old':<28} {'new':<28} {'image':>9} {'deflate':>9} {'patch':>9} {'ratio':>6}")
+    failed = False
+    for old_path, new_path in zip(args.images[::2], args.images[1::2]):
+        old = Path(old_path).read_bytes()
+        new = Path(new_path).read_bytes()
+        patch = make_patch(old, new)
+        ok = apply_patch(old, patch) == new
+        failed |= not ok
+        print(f"{Path(old_path).name[-28:]:<28} {Path(new_path).name[-28:]:<28} "
+              f"{len(new):>9} {len(zlib.compress(new, 9)):>9} {len(patch):>9} "
+              f"{100.0 * len(patch) / len(new):>5.1f}%{'' if ok else '  MISMATCH'}")
+    sys.exit(1 if failed else 0)
+
+
+def cmd_push(args):
+    patch = Path(args.patch).read_bytes()
+    boundary = uuid.uuid4().hex
+    body = (f"--{boundary}\r\n"
+            f"Content-Disposition: form-data; name=\"patch\"; filename=\"{Path(args.patch).name}\"\r\n"
+            f"Content-Type: application/octet-stream\r\n\r\n").encode() + patch + \
+        f"\r\n--{boundary}--\r\n".encode()
+    req = urllib.request.Request(f"http://{args.host}:{args.port}/delta", data=body, method="POST")
+    req.add_header("Content-Type", f"multipart/form-data; boundary={boundary}")
+    auth = base64.b64encode(f"admin:{args.password}".encode()).decode()
+    req.add_header("Authorization", f"Basic {auth}")
+    try:
+        with urllib.request.urlopen(req, timeout=120) as resp:
+            print(resp.read().decode(errors="replace"))
+    except urllib.error.HTTPError as e:
+        sys.exit(f"HTTP {e.code}: {e.read().decode(errors='replace')}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="cmd", required=True)
+    p = sub.add_parser("diff")
+    p.add_argument("old")
+    p.add_argument("new")
+    p.add_argument("patch")
+    p.set_defaults(fn=cmd_diff)
+    p = sub.add_parser("apply")
+    p.add_argument("old")
+    p.add_argument("patch")
+    p.add_argument("out")
+    p.set_defaults(fn=cmd_apply)
+    p = sub.add_parser("roundtrip")
+    p.add_argument("images", nargs="+")
+    p.set_defaults(fn=cmd_roundtrip)
+    p = sub.add_parser("push")
+    p.add_argument("patch")
+    p.add_argument("--host", default="sen66-esp32.local")
+    p.add_argument("--port", type=int, default=3233)
+    p.add_argument("--password", default="admin")
+    p.set_defaults(fn=cmd_push)
+    args = parser.parse_args()
+    args.fn(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""Raw SEN66 signal capture on the sensor node (format: lib/RawCapture/RawLog.h).
+
+  raw_capture.py start|stop|status [--host sen66-esp32.local] [--password admin]
+  raw_capture.py fetch OUT.s6rw [--host ...] [--follow SECONDS]
+  raw_capture.py csv FILE.s6rw [FILE.s6rw ...]
+
+`fetch` downloads the node's log. With --follow it keeps polling for new
+records (GET /raw?from=<next sequence number>) and appends them to OUT,
+keeping its header valid; if the node's ring overwrote records before
+they were fetched, or the node restarted, it warns and continues in
+OUT-<seq>.s6rw so sequence numbers stay implicit within each file.
+
+`start` and `stop` authenticate as admin with the node's OTA_PASSWORD.
+
+`csv` reads .s6rw files through mmap and prints the records in physical
+units.
+"""
+
+import argparse
+import base64
+import mmap
+import struct
+import sys
+import time
+import urllib.request
+from pathlib import Path
+
+MAGIC = b"S6RW"
+HEADER = struct.Struct("<4sHHII")       # magic, version, record size, first seq, count
+RECORD = struct.Struct("<qIBBhhHHH")    # epoch ms, mono ms, sensor, flags, rh, t, voc, nox, co2
+CLOCK_SYNCED = 0x01
+assert HEADER.size == 16 and RECORD.size == 24
+
+
+def url(args, path):
+    return f"http://{args.host}:{args.port}{path}"
+
+
+def request(args, path, method="GET"):
+    req = urllib.request.Request(url(args, path), method=method, data=b"" if method == "POST" else None)
+    if method == "POST":
+        auth = base64.b64encode(f"admin:{args.password}".encode()).decode()
+        req.add_header("Authorization", f"Basic {auth}")
+    with urllib.request.urlopen(req, timeout=60) as resp:
+        return resp.read()
+
+
+def parse(data):
+    """(first_seq, records bytes) of a downloaded file."""
+    magic, version, size, first, count = HEADER.unpack_from(data)
+    if magic != MAGIC or version != 1 or size != RECORD.size:
+        sys.exit("not an S6RW v1 file")
+    body = data[HEADER.size:]
+    if len(body) != count * RECORD.size:
+        # The node closes early when its ring overtakes a download
+        count = len(body) // RECORD.size
+        body = body[:count * RECORD.size]
+    return first, body
+
+
+# ===== Commands =====
+def cmd_control(args):
+    if args.cmd == "status":
+        print(request(args, "/raw/status").decode(), end="")
+    else:
+        print(request(args, f"/raw/{args.cmd}", "POST").decode(), end="")
+
+
+def cmd_fetch(args):
+    out = Path(args.out)
+    first, body = parse(request(args, "/raw"))
+    f = out.open("wb")
+    f.write(HEADER.pack(MAGIC, 1, RECORD.size, first, 0) + body)
+    count = len(body) // RECORD.size
+    print(f"{out}: {count} records from seq {first}")
+    next_seq = first + count
+    try:
+        while args.follow:
+            f.seek(8)
+            f.write(struct.pack("<II", first, count))
+            f.seek(0, 2)
+            f.flush()
+            time.sleep(args.follow)
+            got_first, body = parse(request(args, f"/raw?from={next_seq}"))
+            if got_first != next_seq:
+                why = "records lost" if got_first > next_seq else "node restarted"
+                print(f"warning: sequence jumped from {next_seq} to {got_first} ({why}), "
+                      "continuing in a new file")
+                f.close()
+                out = out.with_name(f"{out.stem}-{got_first}{out.suffix}")
+                f = out.open("wb")
+                f.write(HEADER.pack(MAGIC, 1, RECORD.size, got_first, 0))
+                first, count = got_first, 0
+            f.write(body)
+            n = len(body) // RECORD.size
+            count += n
+            next_seq = got_first + n
+            if n:
+                print(f"{out}: +{n} records ({count} total)")
+    except KeyboardInterrupt:
+        pass
+    f.seek(8)
+    f.write(struct.pack("<II", first, count))
+    f.close()
+
+
+def value(v, missing, scale=1, digits=0):
+    return "" if v == missing else f"{v / scale:.{digits}f}"
+
+
+def cmd_csv(args):
+    print("seq,epoch_ms,mono_ms,sensor,clock_synced,humidity_rh,temperature_c,"
+          "voc_ticks,nox_ticks,co2_ppm")
+    for name in args.files:
+        with open(name, "rb") as f, mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ) as m:
+            first, body = parse(m)
+            for i, (epoch, mono, sensor, flags, rh, t, voc, nox, co2) in \
+                    enumerate(RECORD.iter_unpack(body)):
+                print(f"{first + i},{epoch},{mono},{sensor},{flags & CLOCK_SYNCED},"
+                      f"{value(rh, 0x7FFF, 100, 2)},{value(t, 0x7FFF, 200, 3)},"
+                      f"{value(voc, 0xFFFF)},{value(nox, 0xFFFF)},{value(co2, 0xFFFF)}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="cmd", required=True)
+    for name in ("start", "stop", "status"):
+        p = sub.add_parser(name)
+        p.set_defaults(fn=cmd_control)
+    p = sub.add_parser("fetch")
+    p.add_argument("out")
+    p.add_argument("--follow", type=float, default=0, metavar="SECONDS")
+    p.set_defaults(fn=cmd_fetch)
+    p = sub.add_parser("csv")
+    p.add_argument("files", nargs="+")
+    p.set_defaults(fn=cmd_csv)
+    for p in sub.choices.values():
+        p.add_argument("--host", default="sen66-esp32.local")
+        p.add_argument("--port", type=int, default=3234)
+        p.add_argument("--password", default="admin")
+    args = parser.parse_args()
+    args.fn(args)
+
+
+if __name__ == "__main__":
+    main()
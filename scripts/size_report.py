@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""Flash/RAM footprint of a build against its budget.
+
+As a PlatformIO post script (extra_scripts = post:scripts/size_report.py)
+it runs after every link and fails the build when the image exceeds the
+environment's budgets, set in platformio.ini:
+
+  custom_flash_budget = 0x330000   ; bytes, K/M suffixes allowed
+  custom_ram_budget = 160K         ; static RAM (data + bss)
+
+An environment without budgets only gets the report. Standalone:
+
+  size_report.py .pio/build/<env>/firmware.elf [--size-tool T]
+                 [--flash-budget N] [--ram-budget N]
+
+Flash is code plus initialized data (what the image stores), RAM the
+statically allocated data; the heap and stacks come on top of it, so
+the RAM budget is what keeps room for TLS and the history buffers.
+"""
+
+import argparse
+import re
+import subprocess
+import sys
+
+# ESP-IDF images (the sections PlatformIO's espressif32 builder counts)
+ESP_FLASH = r"^(?:\.iram0\.text|\.iram0\.vectors|\.dram0\.data|\.flash\.text|\.flash\.rodata)\s+(\d+)"
+ESP_RAM = r"^(?:\.dram0\.data|\.dram0\.bss|\.noinit)\s+(\d+)"
+# Anything else, e.g. the native environments
+ELF_FLASH = r"^(?:\.text|\.data|\.rodata|\.data\.rel\.ro|\.init_array|\.fini_array)\s+(\d+)"
+ELF_RAM = r"^(?:\.data|\.bss|\.noinit)\s+(\d+)"
+
+
+def parse_size(text):
+    """Bytes from '123456', '0x1e0000', '160K' or '3M'."""
+    text = str(text).strip()
+    scale = {"K": 1024, "M": 1024 * 1024}.get(text[-1:].upper(), 1)
+    if scale != 1:
+        text = text[:-1]
+    return int(text, 0) * scale
+
+
+def sections(elf, size_tool, env=None):
+    out = subprocess.run([size_tool, "-A", "-d", elf], check=True,
+                         capture_output=True, text=True, env=env).stdout
+    return out.splitlines()
+
+
+def total(lines, pattern):
+    counted = []
+    for line in lines:
+        m = re.match(pattern, line)
+        if m:
+            counted.append((line.split()[0], int(m.group(1))))
+    return sum(n for _, n in counted), counted
+
+
+def report(name, lines, flash_budget, ram_budget, flash_re=None, ram_re=None):
+    """Prints the report; returns the exceeded budgets' names."""
+    if flash_re is None:
+        esp = any(line.startswith(".flash.") for line in lines)
+        flash_re, ram_re = (ESP_FLASH, ESP_RAM) if esp else (ELF_FLASH, ELF_RAM)
+    flash, flash_sections = total(lines, flash_re)
+    ram, _ = total(lines, ram_re)
+
+    print(f"Size report ({name})")
+    exceeded = []
+    for label, used, budget in (("flash", flash, flash_budget),
+                                ("RAM", ram, ram_budget)):
+        if budget:
+            print(f"  {label:<5} {used:>10,} B of {budget:>10,} B budget "
+                  f"({100.0 * used / budget:.1f}%)")
+            if used > budget:
+                exceeded.append(f"{label} budget exceeded by {used - budget:,} B")
+        else:
+            print(f"  {label:<5} {used:>10,} B (no budget)")
+    for section, n in sorted(flash_sections, key=lambda s: -s[1]):
+        print(f"    {section:<16} {n:>10,} B")
+    for message in exceeded:
+        print(f"  ERROR: {message}")
+    return exceeded
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    ap.add_argument("elf")
+    ap.add_argument("--size-tool", default="size")
+    ap.add_argument("--flash-budget", type=parse_size, default=0)
+    ap.add_argument("--ram-budget", type=parse_size, default=0)
+    args = ap.parse_args()
+    lines = sections(args.elf, args.size_tool)
+    return 1 if report(args.elf, lines, args.flash_budget, args.ram_budget) else 0
+
+
+def pio_post_action(target, source, env):
+    budget = lambda option: parse_size(env.GetProjectOption(option, "0") or "0")
+    size_tool = env.subst("$SIZETOOL") or "size"
+    lines = sections(str(target[0]), size_tool, env["ENV"])
+    flash_re = env.get("SIZEPROGREGEXP")
+    ram_re = env.get("SIZEDATAREGEXP")
+    exceeded = report(env["PIOENV"], lines, budget("custom_flash_budget"),
+                      budget("custom_ram_budget"),
+                      flash_re if flash_re and ram_re else None,
+                      ram_re if flash_re and ram_re else None)
+    return 1 if exceeded else 0
+
+
+try:  # Running under PlatformIO's SCons environment
+    Import("env")
+    env.AddPostAction("$PROGPATH", pio_post_action)
+except NameError:  # Direct execution
+    if __name__ == "__main__":
+        sys.exit(main())
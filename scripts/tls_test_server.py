@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+"""Local HTTPS endpoint for the sensor node's TLS client (lib/SecureHttp).
+
+  tls_test_server.py serve [--port 8443] [--name HOST ...]
+  tls_test_server.py probe https://HOST:8443 [--count 20]
+
+`serve` answers the node's requests (InfluxDB write, Open-Meteo forecast
+and air quality) over TLS with a throwaway CA from certs/test/, created
+on first use, and logs every handshake with its duration and whether the
+client resumed a session. Point the node at it with
+
+  INFLUXDB_URL=https://<this machine's address>:8443
+  TLS_CA_FILES=certs/ca_bundle.pem,certs/test/ca.pem
+
+The node logs its side of each handshake ("[TLS] host: resumed handshake
+N ms, peak heap N B"). The server certificate carries every --name both
+as a DNS and (for addresses) an IP entry, so the node may connect by
+address: mbedTLS matches the literal against the DNS entries.
+
+`probe` runs the same sequence from this machine with TLS 1.2, like the
+node: a full handshake, then connections offering the previous session,
+and prints the handshake times of both.
+"""
+
+import argparse
+import ipaddress
+import json
+import socket
+import ssl
+import statistics
+import subprocess
+import sys
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from pathlib import Path
+from urllib.parse import urlparse
+
+CERT_DIR = Path(__file__).resolve().parent.parent / "certs" / "test"
+
+FORECAST = {"current": {"temperature_2m": 11.4, "relative_humidity_2m": 71,
+                        "pressure_msl": 1016.2, "wind_speed_10m": 9.7,
+                        "wind_direction_10m": 240, "weather_code": 3,
+                        "cloud_cover": 88}}
+AIR_QUALITY = {"current": {"pm10": 14.2, "pm2_5": 8.1, "carbon_monoxide": 182.0,
+                           "nitrogen_dioxide": 17.3, "sulphur_dioxide": 1.9,
+                           "ozone": 48.0, "european_aqi": 31, "us_aqi": 34}}
+
+
+# ===== Certificates =====
+def openssl(*args):
+    subprocess.run(["openssl", *args], check=True, capture_output=True)
+
+
+def default_names():
+    names = {"localhost", "127.0.0.1", socket.gethostname()}
+    try:  # the address other hosts on the LAN reach us at
+        with socket.socket(socket.AF_INET, socket.SOCK_DGRAM) as s:
+            s.connect(("192.0.2.1", 9))
+            names.add(s.getsockname()[0])
+    except OSError:
+        pass
+    return sorted(names)
+
+
+def make_certs(names):
+    """certs/test/ca.pem plus a P-256 server certificate for names."""
+    CERT_DIR.mkdir(parents=True, exist_ok=True)
+    ca_key, ca = CERT_DIR / "ca.key", CERT_DIR / "ca.pem"
+    key, csr, cert = CERT_DIR / "server.key", CERT_DIR / "server.csr", CERT_DIR / "server.pem"
+    if not ca.exists():
+        openssl("ecparam", "-name", "prime256v1", "-genkey", "-noout", "-out", str(ca_key))
+        openssl("req", "-x509", "-new", "-key", str(ca_key), "-sha256", "-days", "3650",
+                "-subj", "/CN=sen66 test CA", "-out", str(ca))
+    san = []
+    for name in names:
+        san.append(f"DNS:{name}")
+        try:
+            ipaddress.ip_address(name)
+            san.append(f"IP:{name}")
+        except ValueError:
+            pass
+    ext = CERT_DIR / "server.ext"
+    ext.write_text("basicConstraints=CA:FALSE\n"
+                   "extendedKeyUsage=serverAuth\n"
+                   f"subjectAltName={','.join(san)}\n")
+    openssl("ecparam", "-name", "prime256v1", "-genkey", "-noout", "-out", str(key))
+    openssl("req", "-new", "-key", str(key), "-subj", f"/CN={names[0]}", "-out", str(csr))
+    openssl("x509", "-req", "-in", str(csr), "-CA", str(ca), "-CAkey", str(ca_key),
+            "-CAcreateserial", "-sha256", "-days", "825", "-extfile", str(ext), "-out", str(cert))
+    return cert, key
+
+
+# ===== Server =====
+class Handler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"  # keep-alive, as HTTPClient expects
+
+    def reply(self, code, body=b"", content_type="application/json"):
+        self.send_response(code)
+        self.send_header("Content-Type", content_type)
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+    def do_POST(self):
+        length = int(self.headers.get("Content-Length", 0))
+        body = self.rfile.read(length)
+        if urlparse(self.path).path != "/api/v2/write":
+            return self.reply(404)
+        lines = body.count(b"\n") + 1
+        print(f"  write {len(body)} bytes, {lines} lines")
+        self.reply(204)
+
+    def do_GET(self):
+        path = urlparse(self.path).path
+        if path == "/v1/forecast":
+            return self.reply(200, json.dumps(FORECAST).encode())
+        if path == "/v1/air-quality":
+            return self.reply(200, json.dumps(AIR_QUALITY).encode())
+        self.reply(404)
+
+    def log_message(self, fmt, *args):
+        pass
+
+
+class TlsServer(ThreadingHTTPServer):
+    daemon_threads = True
+
+    def __init__(self, address, context):
+        super().__init__(address, Handler)
+        self.context = context
+        self.handshakes = {"full": [], "resumed": []}
+
+    # Handshake here rather than in the handler thread to time it
+    def get_request(self):
+        sock, addr = self.socket.accept()
+        tls = self.context.wrap_socket(sock, server_side=True, do_handshake_on_connect=False)
+        t0 = time.perf_counter()
+        try:
+            tls.do_handshake()
+        except (ssl.SSLError, OSError) as e:
+            print(f"{addr[0]}: handshake failed: {e}")
+            sock.close()
+            raise
+        ms = (time.perf_counter() - t0) * 1000
+        kind = "resumed" if tls.session_reused else "full"
+        self.handshakes[kind].append(ms)
+        print(f"{addr[0]}: {kind} handshake {ms:.1f} ms ({tls.version()}, {tls.cipher()[0]})")
+        return tls, addr
+
+    def handle_error(self, request, client_address):
+        pass
+
+
+def cmd_serve(args):
+    cert, key = make_certs(args.name or default_names())
+    context = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+    context.load_cert_chain(cert, key)
+    server = TlsServer(("", args.port), context)
+    print(f"https on :{args.port}, CA {CERT_DIR / 'ca.pem'}")
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    for kind, times in server.handshakes.items():
+        if times:
+            print(f"{kind:>8}: {len(times)} handshakes, median {statistics.median(times):.1f} ms")
+
+
+# ===== Probe =====
+def cmd_probe(args):
+    url = urlparse(args.url)
+    host, port = url.hostname, url.port or 443
+    context = ssl.SSLContext(ssl.PROTOCOL_TLS_CLIENT)
+    context.maximum_version = ssl.TLSVersion.TLSv1_2  # what the node speaks
+    context.load_verify_locations(args.ca)
+    request = (f"GET /v1/forecast HTTP/1.1\r\nHost: {host}\r\n"
+               "Connection: close\r\n\r\n").encode()
+    times = {"full": [], "resumed": []}
+    session = None
+    for i in range(args.count):
+        offer = session if i % 2 else None  # alternate full and resumed
+        with socket.create_connection((host, port), timeout=10) as sock:
+            t0 = time.perf_counter()
+            with context.wrap_socket(sock, server_hostname=host, session=offer) as tls:
+                ms = (time.perf_counter() - t0) * 1000
+                times["resumed" if tls.session_reused else "full"].append(ms)
+                tls.sendall(request)
+                while tls.recv(4096):
+                    pass
+                session = tls.session
+    for kind, t in times.items():
+        if t:
+            print(f"{kind:>8}: {len(t):3} handshakes, median {statistics.median(t):6.2f} ms, "
+                  f"min {min(t):6.2f} ms, max {max(t):6.2f} ms")
+    if not times["resumed"]:
+        sys.exit("server never resumed a session")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="cmd", required=True)
+    p = sub.add_parser("serve")
+    p.add_argument("--port", type=int, default=8443)
+    p.add_argument("--name", action="append", help="certificate name (default: host name and addresses)")
+    p.set_defaults(fn=cmd_serve)
+    p = sub.add_parser("probe")
+    p.add_argument("url")
+    p.add_argument("--count", type=int, default=20)
+    p.add_argument("--ca", default=str(CERT_DIR / "ca.pem"))
+    p.set_defaults(fn=cmd_probe)
+    args = parser.parse_args()
+    args.fn(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,36 @@
+// src/bench/bench.h
+#pragma once
+#include <stdint.h>
+
+/*
+  Minimal host benchmark harness.
+
+    BENCH(crc8) {
+      for (uint32_t i = 0; i < iters; ++i)
+        doNotOptimize(Sen66Protocol::crc8(buf, 2));
+    }
+
+  Each benchmark gets an iteration count and must run its body that many
+  times. The harness scales the count until a run takes >= 100 ms, keeps
+  the fastest of several runs and reports ns/op plus heap allocations/op
+  (counted through the global operator new).
+*/
+
+typedef void (*BenchFn)(uint32_t iters);
+
+struct BenchRegistration {
+  BenchRegistration(const char *name, BenchFn fn);
+};
+
+#define BENCH(name)                                                            \
+  static void bench_##name(uint32_t iters);                                    \
+  static BenchRegistration benchReg_##name(#name, bench_##name);               \
+  static void bench_##name(uint32_t iters)
+
+template <typename T> inline void doNotOptimize(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Report an extra metric for the benchmark that is currently running
+// (e.g. compressed bytes per sample).
+void benchCounter(const char *name, double value);
@@ -0,0 +1,48 @@
+// src/bench/bench_columns.cpp
+//
+// Frame log to columns (lib/FrameColumns), per frame: the recorded
+// SEN66 responses of fixtures.h as log records, decoded 512 at a time.
+// One frame is a measured values plus a 0x0316 response, so the
+// one-at-a-time cost to compare with is sen66_decode_measured_values +
+// sen66_decode_number_concentration.
+#include <vector>
+
+#include "ColumnFile.h"
+#include "bench.h"
+#include "fixtures.h"
+
+static const size_t LOG_RECORDS = 512;
+
+static const std::vector<FrameColumns::Record> &fixtureLog() {
+  static std::vector<FrameColumns::Record> log;
+  if (!log.empty())
+    return log;
+  for (size_t i = 0; i < LOG_RECORDS; ++i) {
+    const size_t f = i % FRAME_COUNT;
+    log.push_back(FrameColumns::makeRecord(
+        0, (uint32_t)(i * 1000), 1760000000000LL + (int64_t)i * 1000,
+        MEASURED_VALUES_FRAMES[f], sizeof(MEASURED_VALUES_FRAMES[f]),
+        NUMBER_CONCENTRATION_FRAMES[f]));
+  }
+  return log;
+}
+
+static void decodeColumns(FrameColumns::Kernel k, uint32_t iters) {
+  const std::vector<FrameColumns::Record> &log = fixtureLog();
+  const FrameColumns::ColumnLayout layout(Sen66Protocol::SEN66, LOG_RECORDS);
+  static std::vector<uint8_t> file;
+  file.resize(layout.fileSize());
+  FrameColumns::DecodeStats stats;
+  for (uint32_t i = 0; i < iters; i += LOG_RECORDS) {
+    const size_t n = iters - i < LOG_RECORDS ? iters - i : LOG_RECORDS;
+    FrameColumns::decodeRows(k, layout, log.data(), 0, n, file.data(), stats);
+    doNotOptimize(file.data());
+  }
+}
+
+BENCH(columns_decode_scalar) {
+  decodeColumns(FrameColumns::KERNEL_SCALAR, iters);
+}
+
+// The widest kernel the host runs (SSSE3 or AVX2 on x86-64)
+BENCH(columns_decode_simd) { decodeColumns(FrameColumns::bestKernel(), iters); }
@@ -0,0 +1,115 @@
+// src/bench/bench_events.cpp
+//
+// Event detectors (lib/Events), per sample of a synthetic 24 h, 1 Hz
+// office trace: occupancy CO2 ramps with window ventilation, a cooking
+// PM/VOC spike, and sensor noise. Settings match the firmware defaults
+// (src/sen66/main.cpp, DETECTOR_DEFAULTS).
+#include <vector>
+
+#include "EnvironmentLine.h"
+#include "EventDetector.h"
+#include "bench.h"
+
+static const uint32_t TRACE_SECONDS = 24 * 3600;
+
+struct EventSample {
+  uint32_t tMs;
+  float values[ENV_FIELD_COUNT];
+};
+
+// Deterministic noise, no libc rand() so traces match across hosts
+static uint32_t lcgState = 4242;
+static float uniform() {
+  lcgState = lcgState * 1664525u + 1013904223u;
+  return (float)(lcgState >> 8) / 16777216.0f;
+}
+static float noise(float amplitude) {
+  return (uniform() + uniform() + uniform() - 1.5f) * amplitude;
+}
+
+static bool within(float h, float from, float to) {
+  return h >= from && h < to;
+}
+
+static const std::vector<EventSample> &officeDay() {
+  static std::vector<EventSample> trace;
+  if (!trace.empty())
+    return trace;
+  trace.resize(TRACE_SECONDS);
+  float co2 = 430.0f, pm = 4.0f;
+  for (uint32_t s = 0; s < TRACE_SECONDS; ++s) {
+    const float h = s / 3600.0f;
+    const bool occupied = within(h, 8.5f, 12.0f) || within(h, 13.0f, 17.5f);
+    const bool windowOpen = within(h, 10.0f, 10.1f) ||
+                            within(h, 12.0f, 12.2f) || within(h, 15.0f, 15.1f);
+    const bool cooking = within(h, 12.25f, 12.6f);
+    // CO2 and PM mass balance per second
+    co2 += ((occupied ? 10.0f : 0.0f) -
+            (windowOpen ? 30.0f : 0.5f) / 60.0f * (co2 - 420.0f)) / 60.0f;
+    pm += ((cooking ? 4.0f : 0.0f) -
+           ((windowOpen ? 30.0f : 0.5f) / 60.0f + 0.02f) * (pm - 4.0f)) /
+          60.0f;
+
+    EventSample &e = trace[s];
+    e.tMs = s * 1000u;
+    for (float &v : e.values)
+      v = 0.0f;
+    e.values[ENV_CO2] = co2 + noise(4.0f);
+    e.values[ENV_PM2_5] = pm + noise(0.4f);
+    e.values[ENV_VOC] =
+        100.0f + (occupied ? 40.0f : 0.0f) + (cooking ? 180.0f : 0.0f);
+  }
+  return trace;
+}
+
+static const Events::Config VENTILATION = {
+    "ventilation", ENV_CO2, Events::KIND_PEAK_DROP,
+    {0.0f, 20.0f, 50.0f, 120, 15, 1, {}}};
+static const Events::Config COOKING = {
+    "cooking", ENV_PM2_5, Events::KIND_LEVEL_RISE,
+    {1.0f / 600, 3.0f, 15.0f, 120, 0, 1, {}}};
+static const Events::Config OCCUPANCY = {
+    "occupancy", ENV_CO2, Events::KIND_SLOPE_RISE,
+    {0.05f, 5.0f, 120.0f, 300, 0, 1, {}}};
+static const Events::Config VOC_BURST = {
+    "voc_burst", ENV_VOC, Events::KIND_LEVEL_RISE,
+    {1.0f / 600, 50.0f, 300.0f, 60, 0, 1, {}}};
+
+// ns per sample into one detector; also counts its events per day
+static void runDetector(const Events::Config &c, uint32_t iters) {
+  const std::vector<EventSample> &trace = officeDay();
+  Events::Detector d;
+  d.configure(c.kind, c.params);
+  uint32_t started = 0;
+  for (uint32_t i = 0; i < iters; ++i) {
+    const EventSample &s = trace[i % TRACE_SECONDS];
+    const uint32_t lap = (i / TRACE_SECONDS) * TRACE_SECONDS * 1000u;
+    const Events::Change change = d.update(s.tMs + lap, s.values[c.signal]);
+    started += change == Events::CHANGE_STARTED;
+    doNotOptimize(change);
+  }
+  benchCounter("events/day", iters >= TRACE_SECONDS
+                                 ? (double)started * TRACE_SECONDS / iters
+                                 : 0.0);
+}
+
+BENCH(events_peak_drop) { runDetector(VENTILATION, iters); }
+
+BENCH(events_level_rise) { runDetector(COOKING, iters); }
+
+BENCH(events_slope_rise) { runDetector(OCCUPANCY, iters); }
+
+// The firmware's four detectors, ns per sample of one sensor
+BENCH(events_pipeline) {
+  const std::vector<EventSample> &trace = officeDay();
+  Events::Pipeline p;
+  p.add(VENTILATION);
+  p.add(COOKING);
+  p.add(OCCUPANCY);
+  p.add(VOC_BURST);
+  for (uint32_t i = 0; i < iters; ++i) {
+    const EventSample &s = trace[i % TRACE_SECONDS];
+    const uint32_t lap = (i / TRACE_SECONDS) * TRACE_SECONDS * 1000u;
+    doNotOptimize(p.update(s.tMs + lap, s.values));
+  }
+}
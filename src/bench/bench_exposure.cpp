@@ -0,0 +1,40 @@
+// src/bench/bench_exposure.cpp
+//
+// Exposure doses (lib/Exposure), per 1 Hz sample of a synthetic day that
+// keeps crossing the CO2 and WHO PM thresholds, so the crossing branch is
+// taken often. The rolling hour is read once per simulated minute, more
+// often than the node's 10 minute uploads.
+#include <math.h>
+#include <vector>
+
+#include "ExposureDose.h"
+#include "bench.h"
+
+struct ExposureSample {
+  float pm25, pm10, co2;
+};
+
+static const std::vector<ExposureSample> &exposureTrace() {
+  static std::vector<ExposureSample> trace;
+  if (trace.empty()) {
+    for (uint32_t s = 0; s < 24 * 3600; ++s) {
+      const float pm25 = 14.0f + 6.0f * sinf(s / 700.0f);
+      trace.push_back({pm25, 2.8f * pm25, 950.0f + 200.0f * sinf(s / 2300.0f)});
+    }
+  }
+  return trace;
+}
+
+BENCH(exposure_sample) {
+  const std::vector<ExposureSample> &trace = exposureTrace();
+  static Exposure::Accumulator acc;
+  static uint32_t tMs = 0;
+  for (uint32_t i = 0; i < iters; ++i) {
+    const ExposureSample &x = trace[i % trace.size()];
+    tMs += 1000;
+    acc.add(tMs, x.pm25, x.pm10, x.co2);
+    if (i % 60 == 0)
+      doNotOptimize(acc.hour());
+  }
+  doNotOptimize(acc.day());
+}
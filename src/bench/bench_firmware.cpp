@@ -0,0 +1,152 @@
+// src/bench/bench_firmware.cpp
+//
+// Hot paths of the sensor node (src/sen66) and the lamp (src/lamp).
+#include <string.h>
+
+#include "EnvironmentLine.h"
+#include "FluxCsv.h"
+#include "Iaq.h"
+#include "LineProtocol.h"
+#include "Sen66Protocol.h"
+#include "bench.h"
+#include "fixtures.h"
+
+BENCH(sen66_crc8_word) {
+  for (uint32_t i = 0; i < iters; ++i) {
+    const uint8_t *frame = MEASURED_VALUES_FRAMES[i % FRAME_COUNT];
+    doNotOptimize(Sen66Protocol::crc8(frame + 3 * (i % 9), 2));
+  }
+}
+
+BENCH(sen66_decode_measured_values) {
+  Sen66Protocol::MeasuredValues mv;
+  for (uint32_t i = 0; i < iters; ++i) {
+    doNotOptimize(Sen66Protocol::decodeMeasuredValues(
+        MEASURED_VALUES_FRAMES[i % FRAME_COUNT], mv));
+    doNotOptimize(mv);
+  }
+}
+
+// The other SEN6x models, decoded from the same SEN66 frames: their
+// frames are a prefix of it, valid CRCs included, and only the word
+// count matters for the cost
+template <Sen66Protocol::Model M> static void decodeModel(uint32_t iters) {
+  Sen66Protocol::MeasuredValues mv;
+  for (uint32_t i = 0; i < iters; ++i) {
+    doNotOptimize(Sen66Protocol::decodeMeasuredValuesOf<M>(
+        MEASURED_VALUES_FRAMES[i % FRAME_COUNT], mv));
+    doNotOptimize(mv);
+  }
+}
+
+BENCH(sen6x_decode_sen63c) { decodeModel<Sen66Protocol::SEN63C>(iters); }
+BENCH(sen6x_decode_sen65) { decodeModel<Sen66Protocol::SEN65>(iters); }
+BENCH(sen6x_decode_sen68) { decodeModel<Sen66Protocol::SEN68>(iters); }
+
+BENCH(sen66_decode_number_concentration) {
+  Sen66Protocol::NumberConcentration nc;
+  for (uint32_t i = 0; i < iters; ++i) {
+    doNotOptimize(Sen66Protocol::decodeNumberConcentration(
+        NUMBER_CONCENTRATION_FRAMES[i % FRAME_COUNT], nc));
+    doNotOptimize(nc);
+  }
+}
+
+BENCH(dew_point) {
+  for (uint32_t i = 0; i < iters; ++i) {
+    const float t = 18.0f + (float)(i % 64) * 0.125f;
+    const float rh = 30.0f + (float)(i % 50);
+    doNotOptimize(dewPoint(t, rh));
+  }
+}
+
+BENCH(encode_environment_line) {
+  static Sen66Protocol::MeasuredValues mv[FRAME_COUNT];
+  static Sen66Protocol::NumberConcentration nc[FRAME_COUNT];
+  for (size_t f = 0; f < FRAME_COUNT; ++f) {
+    Sen66Protocol::decodeMeasuredValues(MEASURED_VALUES_FRAMES[f], mv[f]);
+    Sen66Protocol::decodeNumberConcentration(NUMBER_CONCENTRATION_FRAMES[f],
+                                             nc[f]);
+  }
+  char buf[512];
+  size_t bytes = 0;
+  for (uint32_t i = 0; i < iters; ++i) {
+    LineProtocolWriter w(buf, sizeof(buf));
+    encodeEnvironmentLine(w, mv[i % FRAME_COUNT], nc[i % FRAME_COUNT],
+                          0x00000000u);
+    bytes += w.length();
+    doNotOptimize(buf);
+  }
+  benchCounter("bytes/line", (double)bytes / iters);
+}
+
+static const LineProtocolTag FIXTURE_TAGS[] = {{"site", "home"},
+                                               {"sensor", "desk"},
+                                               {"room", "living room"},
+                                               {"device", "3485185a0b2c"}};
+
+// Cost of rendering the tag set; paid once at boot, not per line
+BENCH(build_series_key) {
+  char key[160];
+  for (uint32_t i = 0; i < iters; ++i) {
+    doNotOptimize(buildSeriesKey(key, sizeof(key), "environment", FIXTURE_TAGS,
+                                 4));
+    doNotOptimize(key);
+  }
+}
+
+BENCH(encode_environment_line_tagged) {
+  static Sen66Protocol::MeasuredValues mv[FRAME_COUNT];
+  static Sen66Protocol::NumberConcentration nc[FRAME_COUNT];
+  for (size_t f = 0; f < FRAME_COUNT; ++f) {
+    Sen66Protocol::decodeMeasuredValues(MEASURED_VALUES_FRAMES[f], mv[f]);
+    Sen66Protocol::decodeNumberConcentration(NUMBER_CONCENTRATION_FRAMES[f],
+                                             nc[f]);
+  }
+  char key[160];
+  buildSeriesKey(key, sizeof(key), "environment", FIXTURE_TAGS, 4);
+  char buf[512];
+  size_t bytes = 0;
+  for (uint32_t i = 0; i < iters; ++i) {
+    LineProtocolWriter w(buf, sizeof(buf));
+    encodeEnvironmentLine(w, mv[i % FRAME_COUNT], nc[i % FRAME_COUNT],
+                          0x00000000u, key);
+    bytes += w.length();
+    doNotOptimize(buf);
+  }
+  benchCounter("bytes/line", (double)bytes / iters);
+}
+
+BENCH(split_csv_line) {
+  static const char line[] = ",_result,2,2026-10-18T08:30:20Z,618,co2";
+  CsvField cols[12];
+  for (uint32_t i = 0; i < iters; ++i) {
+    doNotOptimize(splitCsvLine(line, sizeof(line) - 1, cols, 12));
+    doNotOptimize(cols);
+  }
+}
+
+BENCH(parse_flux_response) {
+  for (uint32_t i = 0; i < iters; ++i) {
+    LatestFields fields;
+    SampleStamp stamp;
+    doNotOptimize(parseFluxResponse(FLUX_RESPONSE, sizeof(FLUX_RESPONSE) - 1,
+                                    fields, stamp));
+    doNotOptimize(fields);
+    doNotOptimize(stamp);
+  }
+}
+
+BENCH(iaq_compute) {
+  static const float CO2[] = {420, 650, 910, 1180, 1650, 2300};
+  static const float PM[] = {2.5f, 8.0f, 18.0f, 32.0f, 61.0f, 90.0f};
+  for (uint32_t i = 0; i < iters; ++i) {
+    LatestFields f;
+    f.pm25 = PM[i % 6];
+    f.pm10 = PM[(i + 1) % 6] * 1.3f;
+    f.co2 = CO2[i % 6];
+    f.voc = 80.0f + (float)(i % 300);
+    f.nox = 1.0f + (float)(i % 5);
+    doNotOptimize(computeIAQ(f));
+  }
+}
@@ -0,0 +1,133 @@
+// src/bench/bench_history.cpp
+//
+// Compressed sample history (lib/History) on a synthetic but realistic
+// 24 h, 1 Hz trace: slow day/night drift of T/RH/CO2, occupancy CO2 ramps,
+// a cooking PM spike, sensor noise at the SEN66 output resolution, and
+// the read-time jitter of the acquisition loop.
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "History.h"
+#include "bench.h"
+
+static const uint32_t TRACE_SECONDS = 24 * 3600;
+
+struct TraceSample {
+  uint32_t tMs;
+  History::Ticks ticks;
+};
+
+// Deterministic noise, no libc rand() so traces match across hosts
+static uint32_t lcgState = 12345;
+static float uniform() {
+  lcgState = lcgState * 1664525u + 1013904223u;
+  return (float)(lcgState >> 8) / 16777216.0f;
+}
+static float noise(float amplitude) {
+  return (uniform() + uniform() + uniform() - 1.5f) * amplitude;
+}
+
+static uint16_t tick(float value, float scale) {
+  return (uint16_t)lroundf(value * scale);
+}
+
+static const std::vector<TraceSample> &dayTrace() {
+  static std::vector<TraceSample> trace;
+  if (!trace.empty())
+    return trace;
+  trace.resize(TRACE_SECONDS);
+  uint32_t tMs = 0;
+  float pmWalk = 0.0f, vocWalk = 0.0f;
+  for (uint32_t s = 0; s < TRACE_SECONDS; ++s) {
+    const float hour = s / 3600.0f;
+    const float day = sinf((hour - 9.0f) * (float)M_PI / 12.0f);
+    const bool occupied = hour >= 7.0f && hour < 23.0f;
+    const bool cooking = hour >= 18.5f && hour < 19.25f;
+
+    pmWalk += noise(0.05f) - pmWalk * 0.002f;
+    vocWalk += noise(0.3f) - vocWalk * 0.001f;
+    float pm25 = 4.0f + pmWalk + noise(0.4f) + (cooking ? 35.0f : 0.0f);
+    if (pm25 < 0.0f)
+      pm25 = 0.0f;
+    const float co2 = 450.0f + (occupied ? 500.0f : 80.0f) * (0.6f + 0.4f * day) +
+                      noise(4.0f);
+
+    History::Ticks &t = trace[s].ticks;
+    t.v[History::CH_PM1_0] = tick(pm25 * 0.7f, 10.0f);
+    t.v[History::CH_PM2_5] = tick(pm25, 10.0f);
+    t.v[History::CH_PM4_0] = tick(pm25 * 1.1f, 10.0f);
+    t.v[History::CH_PM10] = tick(pm25 * 1.15f, 10.0f);
+    t.v[History::CH_HUMIDITY] =
+        (uint16_t)(int16_t)lroundf((45.0f - 6.0f * day + noise(0.04f)) * 100.0f);
+    t.v[History::CH_TEMPERATURE] =
+        (uint16_t)(int16_t)lroundf((21.5f + 1.5f * day + noise(0.02f)) * 200.0f);
+    // VOC index moves in whole steps
+    t.v[History::CH_VOC] = (uint16_t)(int16_t)(
+        10 * lroundf(100.0f + vocWalk + (cooking ? 150.0f : 0.0f)));
+    t.v[History::CH_NOX] = (uint16_t)(int16_t)(cooking ? 30 : 10);
+    t.v[History::CH_CO2] = tick(co2, 1.0f);
+    t.v[History::CH_NC0_5] = tick(pm25 * 5.2f, 10.0f);
+    t.v[History::CH_NC1_0] = tick(pm25 * 6.1f, 10.0f);
+    t.v[History::CH_NC2_5] = tick(pm25 * 6.2f, 10.0f);
+    t.v[History::CH_NC4_0] = tick(pm25 * 6.2f, 10.0f);
+    t.v[History::CH_NC10] = tick(pm25 * 6.2f, 10.0f);
+    t.v[History::CH_HCHO] = 0xFFFF; // a SEN66 has none
+
+    // Samples are read on a 50 ms poll grid plus bus time
+    tMs += 1000;
+    trace[s].tMs = tMs + (uint32_t)(uniform() * 60.0f);
+  }
+  return trace;
+}
+
+// 24 h of one sensor, sized like the firmware's PSRAM history
+static History::Store &dayStore() {
+  static const size_t BYTES = History::Store::bytesFor(256);
+  static void *storage = malloc(BYTES);
+  static History::Store store(storage, BYTES);
+  if (store.samples() == 0)
+    for (const TraceSample &s : dayTrace())
+      store.append(s.tMs, s.ticks);
+  return store;
+}
+
+BENCH(history_append) {
+  const std::vector<TraceSample> &trace = dayTrace();
+  static const size_t BYTES = History::Store::bytesFor(64);
+  static void *storage = malloc(BYTES);
+  History::Store store(storage, BYTES);
+  for (uint32_t i = 0; i < iters; ++i) {
+    const TraceSample &s = trace[i % TRACE_SECONDS];
+    const uint32_t lap = (i / TRACE_SECONDS) * TRACE_SECONDS * 1000u;
+    doNotOptimize(store.append(s.tMs + lap, s.ticks));
+  }
+  benchCounter("bytes/sample", dayStore().bytesPerSample());
+}
+
+// A day of PM2.5 into 15 min buckets, as a chart would request it
+BENCH(history_scan_day) {
+  const History::Store &store = dayStore();
+  History::Bucket buckets[96];
+  for (uint32_t i = 0; i < iters; ++i) {
+    doNotOptimize(store.scan(History::CH_PM2_5, store.oldestMs(),
+                             store.newestMs() + 1, 15 * 60 * 1000, buckets,
+                             96));
+    doNotOptimize(buckets);
+  }
+}
+
+// Full-resolution decode; ns per sample
+BENCH(history_decode) {
+  const History::Store &store = dayStore();
+  History::Cursor cursor = store.cursor();
+  uint32_t tMs;
+  History::Ticks t;
+  for (uint32_t i = 0; i < iters; ++i) {
+    if (!cursor.next(tMs, t)) {
+      cursor = store.cursor();
+      cursor.next(tMs, t);
+    }
+    doNotOptimize(t);
+  }
+}
@@ -0,0 +1,75 @@
+// src/bench/bench_rooms.cpp
+//
+// The lamp's multi-room poll: one pivoted Flux CSV response (a row per
+// source with the five scored fields and its newest sample's seq and
+// time) parsed straight into the RoomTable.
+// Responses alternate between two rounds in which a quarter of the rooms
+// changed, so the incremental IAQ update does its usual share of work.
+// ns/op is per response; bytes/room should stay flat from 1 to 32 rooms
+// (the same data as one CSV row per field and source is ~230 bytes/room).
+#include <stdio.h>
+#include <string>
+
+#include "FluxCsv.h"
+#include "RoomTable.h"
+#include "bench.h"
+
+struct RoomsFixture {
+  std::string rounds[2];
+};
+
+// Influx's CSV for the lamp's pivot query, CRLF line endings
+static RoomsFixture buildRooms(unsigned rooms) {
+  RoomsFixture fx;
+  for (int r = 0; r < 2; ++r) {
+    std::string &out = fx.rounds[r];
+    out = ",result,table,acquired_ms,co2,device,nox,pm10,pm2_5,room,sensor,"
+          "seq,voc\r\n";
+    for (unsigned i = 0; i < rooms; ++i) {
+      const bool changed = r == 1 && i % 4 == 0;
+      const float values[] = {(float)(520 + 37 * i + (changed ? 40 : 0)),
+                              1.0f, 4.0f + 0.7f * i, 3.1f + 0.5f * i,
+                              (float)(90 + 3 * i)};
+      const unsigned seq = 148213 + 20 * i + 30 * r;
+      const unsigned long long acquiredMs = 1760776220000ULL + 30000 * r + 977 * i;
+      char device[24], room[24], row[192];
+      snprintf(device, sizeof(device), "sen66-%06x", 0xa1b2c0 + i);
+      snprintf(room, sizeof(room), "room %u", i + 1);
+      snprintf(row, sizeof(row),
+               ",_result,0,%llu,%.0f,%s,%.1f,%.1f,%.1f,%s,a,%u,%.0f\r\n",
+               acquiredMs, values[0], device, values[1], values[2], values[3],
+               room, seq, values[4]);
+      out += row;
+    }
+    out += "\r\n";
+  }
+  return fx;
+}
+
+static void benchRooms(uint32_t iters, const RoomsFixture &fx,
+                       unsigned rooms) {
+  static RoomTable table;
+  for (uint32_t i = 0; i < iters; ++i) {
+    const std::string &body = fx.rounds[i & 1];
+    table.beginUpdate();
+    doNotOptimize(parseFluxRooms(body.data(), body.size(), table));
+    table.endUpdate();
+    doNotOptimize(table.worst());
+  }
+  benchCounter("bytes/room", (double)fx.rounds[0].size() / rooms);
+}
+
+BENCH(lamp_rooms_1) {
+  static const RoomsFixture fx = buildRooms(1);
+  benchRooms(iters, fx, 1);
+}
+
+BENCH(lamp_rooms_8) {
+  static const RoomsFixture fx = buildRooms(8);
+  benchRooms(iters, fx, 8);
+}
+
+BENCH(lamp_rooms_32) {
+  static const RoomsFixture fx = buildRooms(32);
+  benchRooms(iters, fx, 32);
+}
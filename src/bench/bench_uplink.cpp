@@ -0,0 +1,180 @@
+// src/bench/bench_uplink.cpp
+//
+// Binary uplink batches (lib/Uplink) against the line protocol they
+// replace, per 1 Hz sample of a synthetic office day: slow T/RH drift,
+// occupancy CO2, PM noise at the SEN66 output resolution and read-time
+// jitter. Both paths start from the SEN66 ticks the firmware already
+// keeps for its history; bytes/sample includes the batch headers.
+#include <math.h>
+#include <vector>
+
+#include "EnvironmentLine.h"
+#include "LineProtocol.h"
+#include "UplinkBatch.h"
+#include "bench.h"
+
+static const uint32_t TRACE_SECONDS = 6 * 3600;
+// Same as the firmware's batch buffer (src/sen66/main.cpp)
+static const size_t BATCH_SIZE = 4096;
+static const int64_t EPOCH_MS = 1760000000000LL;
+static const char SERIES_KEY[] =
+    "environment,device=sen66-a1b2c3,room=office,site=home,sensor=a";
+
+struct UplinkSample {
+  int64_t epochMs;
+  History::Ticks ticks;
+};
+
+// Deterministic noise, no libc rand() so traces match across hosts
+static uint32_t lcgState = 6606;
+static float uniform() {
+  lcgState = lcgState * 1664525u + 1013904223u;
+  return (float)(lcgState >> 8) / 16777216.0f;
+}
+static float noise(float amplitude) {
+  return (uniform() + uniform() + uniform() - 1.5f) * amplitude;
+}
+
+static uint16_t tick(float value, float scale) {
+  return (uint16_t)(int16_t)lroundf(value * scale);
+}
+
+static const std::vector<UplinkSample> &officeMorning() {
+  static std::vector<UplinkSample> trace;
+  if (!trace.empty())
+    return trace;
+  trace.resize(TRACE_SECONDS);
+  float pmWalk = 0.0f;
+  for (uint32_t s = 0; s < TRACE_SECONDS; ++s) {
+    const float hour = 6.0f + s / 3600.0f;
+    const bool occupied = hour >= 8.0f;
+    pmWalk += noise(0.05f) - pmWalk * 0.002f;
+    float pm25 = 4.0f + pmWalk + noise(0.4f);
+    if (pm25 < 0.0f)
+      pm25 = 0.0f;
+    const float co2 =
+        450.0f + (occupied ? 400.0f * (1.0f - expf((8.0f - hour) * 2.0f)) : 0) +
+        noise(4.0f);
+
+    History::Ticks &t = trace[s].ticks;
+    t.v[History::CH_PM1_0] = tick(pm25 * 0.7f, 10.0f);
+    t.v[History::CH_PM2_5] = tick(pm25, 10.0f);
+    t.v[History::CH_PM4_0] = tick(pm25 * 1.1f, 10.0f);
+    t.v[History::CH_PM10] = tick(pm25 * 1.15f, 10.0f);
+    t.v[History::CH_HUMIDITY] = tick(44.0f + 0.3f * hour + noise(0.04f), 100.0f);
+    t.v[History::CH_TEMPERATURE] =
+        tick(20.5f + 0.2f * hour + noise(0.02f), 200.0f);
+    t.v[History::CH_VOC] = tick(100.0f, 10.0f);
+    t.v[History::CH_NOX] = tick(1.0f, 10.0f);
+    t.v[History::CH_CO2] = tick(co2, 1.0f);
+    t.v[History::CH_NC0_5] = tick(pm25 * 5.2f, 10.0f);
+    t.v[History::CH_NC1_0] = tick(pm25 * 6.1f, 10.0f);
+    t.v[History::CH_NC2_5] = tick(pm25 * 6.2f, 10.0f);
+    t.v[History::CH_NC4_0] = tick(pm25 * 6.2f, 10.0f);
+    t.v[History::CH_NC10] = tick(pm25 * 6.2f, 10.0f);
+    t.v[History::CH_HCHO] = 0xFFFF; // a SEN66 has none
+    trace[s].epochMs = EPOCH_MS + s * 1000LL + (int64_t)(uniform() * 60.0f);
+  }
+  return trace;
+}
+
+static bool beginBatch(Uplink::BatchWriter &w, int64_t epochMs) {
+  static const char *const tags[] = {"a"};
+  return w.begin(epochMs, "sen66-a1b2c3", "office", "home", tags, 1);
+}
+
+// The whole trace in firmware-sized batches: total bytes
+static size_t encodeTrace(std::vector<std::vector<uint8_t>> *batches) {
+  uint8_t buf[BATCH_SIZE];
+  Uplink::BatchWriter w(buf, sizeof(buf));
+  size_t total = 0;
+  uint32_t seq = 0;
+  for (const UplinkSample &s : officeMorning()) {
+    seq++;
+    if (w.length() == 0)
+      beginBatch(w, s.epochMs);
+    if (w.add(0, s.epochMs, s.ticks, 0, seq))
+      continue;
+    total += w.length();
+    if (batches)
+      batches->emplace_back(w.data(), w.data() + w.length());
+    beginBatch(w, s.epochMs);
+    w.add(0, s.epochMs, s.ticks, 0, seq);
+  }
+  total += w.length();
+  if (batches)
+    batches->emplace_back(w.data(), w.data() + w.length());
+  return total;
+}
+
+// One sample into the batch, as handleSample() does with UPLINK_BINARY
+BENCH(uplink_encode_sample) {
+  const std::vector<UplinkSample> &trace = officeMorning();
+  static uint8_t buf[BATCH_SIZE];
+  Uplink::BatchWriter w(buf, sizeof(buf));
+  for (uint32_t i = 0; i < iters; ++i) {
+    const UplinkSample &s = trace[i % TRACE_SECONDS];
+    if (w.length() == 0 || !w.add(0, s.epochMs, s.ticks, 0, i + 1)) {
+      beginBatch(w, s.epochMs);
+      w.add(0, s.epochMs, s.ticks, 0, i + 1);
+    }
+    doNotOptimize(w.length());
+  }
+  benchCounter("bytes/sample", (double)encodeTrace(nullptr) / TRACE_SECONDS);
+}
+
+// The same sample as a full-snapshot line (the text path it replaces)
+BENCH(uplink_text_sample) {
+  const std::vector<UplinkSample> &trace = officeMorning();
+  char buf[512];
+  size_t bytes = 0;
+  for (uint32_t i = 0; i < iters; ++i) {
+    const UplinkSample &s = trace[i % TRACE_SECONDS];
+    Sen66Protocol::MeasuredValues mv;
+    Sen66Protocol::NumberConcentration nc;
+    mv.pm1_0 = History::toValue(History::CH_PM1_0, s.ticks.v[History::CH_PM1_0]);
+    mv.pm2_5 = History::toValue(History::CH_PM2_5, s.ticks.v[History::CH_PM2_5]);
+    mv.pm4_0 = History::toValue(History::CH_PM4_0, s.ticks.v[History::CH_PM4_0]);
+    mv.pm10_0 = History::toValue(History::CH_PM10, s.ticks.v[History::CH_PM10]);
+    mv.humidity_rh =
+        History::toValue(History::CH_HUMIDITY, s.ticks.v[History::CH_HUMIDITY]);
+    mv.temperature_c = History::toValue(History::CH_TEMPERATURE,
+                                        s.ticks.v[History::CH_TEMPERATURE]);
+    mv.voc_index = History::toValue(History::CH_VOC, s.ticks.v[History::CH_VOC]);
+    mv.nox_index = History::toValue(History::CH_NOX, s.ticks.v[History::CH_NOX]);
+    mv.co2_ppm = History::toValue(History::CH_CO2, s.ticks.v[History::CH_CO2]);
+    mv.hcho_ppb = NAN;
+    nc.nc0_5 = History::toValue(History::CH_NC0_5, s.ticks.v[History::CH_NC0_5]);
+    nc.nc1_0 = History::toValue(History::CH_NC1_0, s.ticks.v[History::CH_NC1_0]);
+    nc.nc2_5 = History::toValue(History::CH_NC2_5, s.ticks.v[History::CH_NC2_5]);
+    nc.nc4_0 = History::toValue(History::CH_NC4_0, s.ticks.v[History::CH_NC4_0]);
+    nc.nc10_0 = History::toValue(History::CH_NC10, s.ticks.v[History::CH_NC10]);
+    LineProtocolWriter w(buf, sizeof(buf));
+    encodeEnvironmentFields(w, mv, nc, 0, SERIES_KEY);
+    w.fieldUInt("seq", i + 1);
+    w.endLine((uint32_t)(s.epochMs / 1000), (uint16_t)(s.epochMs % 1000));
+    bytes += w.length();
+    doNotOptimize(w.length());
+  }
+  benchCounter("bytes/sample", (double)bytes / iters);
+}
+
+// Bridge side; ns per record
+BENCH(uplink_decode) {
+  static std::vector<std::vector<uint8_t>> batches;
+  if (batches.empty())
+    encodeTrace(&batches);
+  size_t b = 0;
+  Uplink::BatchReader reader(batches[0].data(), batches[0].size());
+  reader.begin();
+  Uplink::Record r;
+  for (uint32_t i = 0; i < iters; ++i) {
+    if (!reader.next(r)) {
+      b = (b + 1) % batches.size();
+      reader = Uplink::BatchReader(batches[b].data(), batches[b].size());
+      reader.begin();
+      reader.next(r);
+    }
+    doNotOptimize(r);
+  }
+}
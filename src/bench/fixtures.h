@@ -0,0 +1,43 @@
+// src/bench/fixtures.h
+#pragma once
+#include <stdint.h>
+
+// Recorded SEN66 responses (office, morning ramp-up incl. a cooking spike)
+// with their CRC bytes. The last frame of each set is the "no data yet"
+// pattern the sensor returns during warm-up.
+
+static const uint8_t MEASURED_VALUES_FRAMES[][27] = {
+    {0x00, 0x1F, 0xEC, 0x00, 0x30, 0x44, 0x00, 0x37, 0xD3, 0x00, 0x3A, 0x9F, 0x11, 0xA0, 0xE7, 0x11, 0x3A, 0x05, 0x03, 0xE8, 0xD4, 0x00, 0x0A, 0x5A, 0x02, 0x64, 0x27},
+    {0x00, 0x21, 0x36, 0x00, 0x34, 0x80, 0x00, 0x3C, 0x39, 0x00, 0x3F, 0x6A, 0x11, 0xA8, 0x5E, 0x11, 0x3C, 0xA3, 0x03, 0xF2, 0x4C, 0x00, 0x0A, 0x5A, 0x02, 0x6A, 0x38},
+    {0x00, 0x23, 0x54, 0x00, 0x37, 0xD3, 0x00, 0x3F, 0x6A, 0x00, 0x42, 0xDE, 0x11, 0xB3, 0xF7, 0x11, 0x3F, 0xF0, 0x04, 0x06, 0xA4, 0x00, 0x0A, 0x5A, 0x02, 0x73, 0xF3},
+    {0x00, 0x5C, 0x82, 0x00, 0x94, 0x7C, 0x00, 0xAB, 0x97, 0x00, 0xB4, 0xFA, 0x12, 0xCA, 0xAA, 0x11, 0xAA, 0x3C, 0x08, 0x66, 0xAB, 0x00, 0x1E, 0xDD, 0x03, 0x4D, 0xDD},
+    {0x00, 0x58, 0x46, 0x00, 0x8D, 0xB7, 0x00, 0xA2, 0x1F, 0x00, 0xAB, 0x97, 0x12, 0xB6, 0x2F, 0x11, 0xB2, 0xC6, 0x09, 0x06, 0xE4, 0x00, 0x28, 0xBE, 0x03, 0x86, 0x70},
+    {0x00, 0x28, 0xBE, 0x00, 0x3D, 0x08, 0x00, 0x46, 0x1A, 0x00, 0x4A, 0x67, 0x11, 0xFA, 0x42, 0x11, 0x81, 0x50, 0x05, 0xAA, 0xD1, 0x00, 0x0A, 0x5A, 0x04, 0xBA, 0x66},
+    {0x00, 0x1C, 0xBF, 0x00, 0x29, 0x8F, 0x00, 0x2F, 0x29, 0x00, 0x32, 0x26, 0x11, 0x76, 0x45, 0x11, 0x2E, 0x82, 0x03, 0xD4, 0x6C, 0x00, 0x0A, 0x5A, 0x02, 0x1C, 0x66},
+    {0xFF, 0xFF, 0xAC, 0xFF, 0xFF, 0xAC, 0xFF, 0xFF, 0xAC, 0xFF, 0xFF, 0xAC, 0x7F, 0xFF, 0x8F, 0x7F, 0xFF, 0x8F, 0x7F, 0xFF, 0x8F, 0x7F, 0xFF, 0x8F, 0xFF, 0xFF, 0xAC},
+};
+
+static const uint8_t NUMBER_CONCENTRATION_FRAMES[][15] = {
+    {0x00, 0xD2, 0xE7, 0x00, 0xF8, 0xBA, 0x00, 0xFB, 0xE9, 0x00, 0xFC, 0x7E, 0x00, 0xFC, 0x7E},
+    {0x00, 0xE0, 0x40, 0x01, 0x09, 0xFD, 0x01, 0x0C, 0x08, 0x01, 0x0D, 0x39, 0x01, 0x0D, 0x39},
+    {0x00, 0xEC, 0x3D, 0x01, 0x17, 0xA1, 0x01, 0x1A, 0xED, 0x01, 0x1B, 0xDC, 0x01, 0x1B, 0xDC},
+    {0x02, 0x81, 0x13, 0x02, 0xF5, 0x2F, 0x02, 0xFD, 0x96, 0x02, 0xFE, 0xC5, 0x02, 0xFF, 0xF4},
+    {0x02, 0x64, 0x27, 0x02, 0xD2, 0x3E, 0x02, 0xDA, 0x87, 0x02, 0xDB, 0xB6, 0x02, 0xDB, 0xB6},
+    {0x01, 0x06, 0xD3, 0x01, 0x36, 0x16, 0x01, 0x39, 0x38, 0x01, 0x3A, 0x6B, 0x01, 0x3A, 0x6B},
+    {0x00, 0xB4, 0xFA, 0x00, 0xD5, 0x70, 0x00, 0xD7, 0x12, 0x00, 0xD8, 0x3C, 0x00, 0xD8, 0x3C},
+    {0xFF, 0xFF, 0xAC, 0xFF, 0xFF, 0xAC, 0xFF, 0xFF, 0xAC, 0xFF, 0xFF, 0xAC, 0xFF, 0xFF, 0xAC},
+};
+
+static const size_t FRAME_COUNT =
+    sizeof(MEASURED_VALUES_FRAMES) / sizeof(MEASURED_VALUES_FRAMES[0]);
+
+// Response of the lamp's fetchLatestFields() query (CSV, CRLF line endings)
+static const char FLUX_RESPONSE[] =
+    ",result,table,_time,_value,_field\r\n"
+    ",_result,0,2026-10-18T08:30:20Z,6.3,pm10\r\n"
+    ",_result,1,2026-10-18T08:30:20Z,5.2,pm2_5\r\n"
+    ",_result,2,2026-10-18T08:30:20Z,618,co2\r\n"
+    ",_result,3,2026-10-18T08:30:20Z,101,voc\r\n"
+    ",_result,4,2026-10-18T08:30:20Z,1,nox\r\n"
+    ",_result,5,2026-10-18T08:30:40Z,148213,seq\r\n"
+    "\r\n";
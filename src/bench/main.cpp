@@ -0,0 +1,217 @@
+// src/bench/main.cpp
+//
+// Host-native benchmarks for the firmware hot paths.
+//
+//   pio run -e native_bench -t exec
+//   .pio/build/native_bench/program --save src/bench/baseline.tsv
+//   .pio/build/native_bench/program --compare src/bench/baseline.tsv
+//
+// Options: --filter <substr>, --save <file>, --compare <file>,
+//          --threshold <percent> (default 15)
+#include <chrono>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+// ===== Allocation counting =====
+static uint64_t allocCount = 0;
+
+void *operator new(size_t size) {
+  ++allocCount;
+  void *p = malloc(size ? size : 1);
+  if (!p)
+    throw std::bad_alloc();
+  return p;
+}
+void *operator new[](size_t size) { return operator new(size); }
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+// ===== Registry =====
+struct BenchEntry {
+  const char *name;
+  BenchFn fn;
+  double nsPerOp;
+  double allocsPerOp;
+  const char *counterName;
+  double counterValue;
+};
+
+static const int MAX_BENCHES = 64;
+static BenchEntry benches[MAX_BENCHES];
+static int benchCount = 0;
+static BenchEntry *currentBench = nullptr;
+
+BenchRegistration::BenchRegistration(const char *name, BenchFn fn) {
+  if (benchCount < MAX_BENCHES) {
+    BenchEntry &e = benches[benchCount++];
+    e.name = name;
+    e.fn = fn;
+  }
+}
+
+void benchCounter(const char *name, double value) {
+  if (!currentBench)
+    return;
+  currentBench->counterName = name;
+  currentBench->counterValue = value;
+}
+
+static double runOnce(BenchFn fn, uint32_t iters, uint64_t &allocs) {
+  const uint64_t a0 = allocCount;
+  const auto t0 = std::chrono::steady_clock::now();
+  fn(iters);
+  const auto t1 = std::chrono::steady_clock::now();
+  allocs = allocCount - a0;
+  return std::chrono::duration<double, std::nano>(t1 - t0).count();
+}
+
+static void runBench(BenchEntry &e) {
+  currentBench = &e;
+  uint64_t allocs = 0;
+  runOnce(e.fn, 1, allocs); // warm-up
+
+  // Scale until one run takes >= 100 ms
+  uint32_t iters = 1;
+  double ns = 0;
+  for (;;) {
+    ns = runOnce(e.fn, iters, allocs);
+    if (ns >= 1e8 || iters >= (1u << 30))
+      break;
+    const double factor = ns > 0 ? (1.2e8 / ns) : 100.0;
+    uint64_t next = (uint64_t)(iters * (factor < 100.0 ? factor : 100.0)) + 1;
+    iters = next > (1u << 30) ? (1u << 30) : (uint32_t)next;
+  }
+
+  // Best of five
+  double best = ns;
+  for (int i = 0; i < 4; ++i) {
+    const double t = runOnce(e.fn, iters, allocs);
+    if (t < best)
+      best = t;
+  }
+  e.nsPerOp = best / iters;
+  e.allocsPerOp = (double)allocs / iters;
+  currentBench = nullptr;
+}
+
+// ===== Baselines (TSV: name, ns/op, allocs/op) =====
+struct Baseline {
+  char name[64];
+  double nsPerOp;
+  double allocsPerOp;
+};
+
+static int loadBaseline(const char *path, Baseline *out, int max) {
+  FILE *f = fopen(path, "r");
+  if (!f)
+    return -1;
+  int n = 0;
+  char line[256];
+  while (n < max && fgets(line, sizeof(line), f)) {
+    if (line[0] == '#' || line[0] == '\n')
+      continue;
+    if (sscanf(line, "%63s %lf %lf", out[n].name, &out[n].nsPerOp,
+               &out[n].allocsPerOp) == 3)
+      ++n;
+  }
+  fclose(f);
+  return n;
+}
+
+static bool saveBaseline(const char *path) {
+  FILE *f = fopen(path, "w");
+  if (!f)
+    return false;
+  fprintf(f, "# name\tns_per_op\tallocs_per_op\n");
+  for (int i = 0; i < benchCount; ++i) {
+    if (benches[i].fn)
+      fprintf(f, "%s\t%.2f\t%.3f\n", benches[i].name, benches[i].nsPerOp,
+              benches[i].allocsPerOp);
+  }
+  fclose(f);
+  return true;
+}
+
+int main(int argc, char **argv) {
+  const char *filter = nullptr;
+  const char *savePath = nullptr;
+  const char *comparePath = nullptr;
+  double threshold = 15.0;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--filter") && i + 1 < argc)
+      filter = argv[++i];
+    else if (!strcmp(argv[i], "--save") && i + 1 < argc)
+      savePath = argv[++i];
+    else if (!strcmp(argv[i], "--compare") && i + 1 < argc)
+      comparePath = argv[++i];
+    else if (!strcmp(argv[i], "--threshold") && i + 1 < argc)
+      threshold = atof(argv[++i]);
+    else {
+      fprintf(stderr,
+              "usage: %s [--filter s] [--save f] [--compare f] "
+              "[--threshold pct]\n",
+              argv[0]);
+      return 2;
+    }
+  }
+
+  static Baseline baseline[MAX_BENCHES];
+  int baselineCount = 0;
+  if (comparePath) {
+    baselineCount = loadBaseline(comparePath, baseline, MAX_BENCHES);
+    if (baselineCount < 0) {
+      fprintf(stderr, "cannot read baseline %s\n", comparePath);
+      return 2;
+    }
+  }
+
+  int regressions = 0;
+  printf("%-32s %12s %10s %10s\n", "benchmark", "ns/op", "allocs/op",
+         comparePath ? "vs base" : "");
+  for (int i = 0; i < benchCount; ++i) {
+    BenchEntry &e = benches[i];
+    if (filter && !strstr(e.name, filter)) {
+      e.fn = nullptr; // excluded from --save
+      continue;
+    }
+    runBench(e);
+    printf("%-32s %12.2f %10.3f", e.name, e.nsPerOp, e.allocsPerOp);
+
+    for (int b = 0; b < baselineCount; ++b) {
+      if (strcmp(baseline[b].name, e.name) != 0)
+        continue;
+      const double delta =
+          baseline[b].nsPerOp > 0
+              ? 100.0 * (e.nsPerOp - baseline[b].nsPerOp) / baseline[b].nsPerOp
+              : 0.0;
+      const bool slower = delta > threshold;
+      const bool moreAllocs = e.allocsPerOp > baseline[b].allocsPerOp + 1e-9;
+      printf(" %+9.1f%%%s", delta,
+             slower ? " SLOWER" : (moreAllocs ? " ALLOCS" : ""));
+      if (slower || moreAllocs)
+        ++regressions;
+    }
+    if (e.counterName)
+      printf("  %s=%.3f", e.counterName, e.counterValue);
+    printf("\n");
+  }
+
+  if (savePath) {
+    if (!saveBaseline(savePath)) {
+      fprintf(stderr, "cannot write %s\n", savePath);
+      return 2;
+    }
+    printf("baseline written to %s\n", savePath);
+  }
+  if (regressions) {
+    printf("%d regression(s) beyond %.0f%%\n", regressions, threshold);
+    return 1;
+  }
+  return 0;
+}
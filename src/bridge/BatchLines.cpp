@@ -0,0 +1,104 @@
+// src/bridge/BatchLines.cpp
+#include "BatchLines.h"
+
+#include <math.h>
+
+#include "EnvironmentLine.h"
+#include "History.h"
+#include "LineProtocol.h"
+#include "UplinkBatch.h"
+
+namespace Bridge {
+
+static constexpr size_t SERIES_KEY_SIZE = 512;
+static constexpr size_t LINE_SIZE = 1024;
+
+static std::string text(const Uplink::Text &t) {
+  return std::string(t.data, t.len);
+}
+
+static float value(const Uplink::Record &r, History::Channel ch, bool &valid) {
+  const float v = History::toValue(ch, r.ticks.v[ch]);
+  valid = !isnan(v);
+  return v;
+}
+
+static void toValues(const Uplink::Record &r,
+                     Sen66Protocol::MeasuredValues &mv,
+                     Sen66Protocol::NumberConcentration &nc) {
+  mv.pm1_0 = value(r, History::CH_PM1_0, mv.valid_pm1_0);
+  mv.pm2_5 = value(r, History::CH_PM2_5, mv.valid_pm2_5);
+  mv.pm4_0 = value(r, History::CH_PM4_0, mv.valid_pm4_0);
+  mv.pm10_0 = value(r, History::CH_PM10, mv.valid_pm10_0);
+  mv.humidity_rh = value(r, History::CH_HUMIDITY, mv.valid_humidity);
+  mv.temperature_c = value(r, History::CH_TEMPERATURE, mv.valid_temperature);
+  mv.voc_index = value(r, History::CH_VOC, mv.valid_voc);
+  mv.nox_index = value(r, History::CH_NOX, mv.valid_nox);
+  mv.co2_ppm = value(r, History::CH_CO2, mv.valid_co2);
+  // Not in the batch schema, so always unknown (NaN)
+  mv.hcho_ppb = value(r, History::CH_HCHO, mv.valid_hcho);
+  nc.nc0_5 = value(r, History::CH_NC0_5, nc.valid_nc0_5);
+  nc.nc1_0 = value(r, History::CH_NC1_0, nc.valid_nc1_0);
+  nc.nc2_5 = value(r, History::CH_NC2_5, nc.valid_nc2_5);
+  nc.nc4_0 = value(r, History::CH_NC4_0, nc.valid_nc4_0);
+  nc.nc10_0 = value(r, History::CH_NC10, nc.valid_nc10_0);
+}
+
+bool batchToLines(const uint8_t *data, size_t len, std::string &out,
+                  BatchSummary &summary, std::string &error) {
+  Uplink::BatchReader reader(data, len);
+  if (!reader.begin()) {
+    error = reader.error();
+    return false;
+  }
+
+  // Series keys as the node renders them (buildSeriesKeys())
+  const std::string device = text(reader.device());
+  const std::string room = text(reader.room());
+  const std::string site = text(reader.site());
+  std::string keys[Uplink::MAX_SENSORS];
+  for (uint8_t i = 0; i < reader.sensorCount(); ++i) {
+    const std::string tag = text(reader.sensorTag(i));
+    const LineProtocolTag tags[] = {{"device", device.c_str()},
+                                    {"room", room.c_str()},
+                                    {"site", site.c_str()},
+                                    {"sensor", tag.c_str()}};
+    char key[SERIES_KEY_SIZE];
+    if (buildSeriesKey(key, sizeof(key), "environment", tags, 4) == 0) {
+      error = "tags too long";
+      return false;
+    }
+    keys[i] = key;
+  }
+
+  std::string lines;
+  Uplink::Record r;
+  char buf[LINE_SIZE];
+  uint32_t records = 0;
+  while (reader.next(r)) {
+    Sen66Protocol::MeasuredValues mv;
+    Sen66Protocol::NumberConcentration nc;
+    toValues(r, mv, nc);
+    LineProtocolWriter w(buf, sizeof(buf));
+    encodeEnvironmentFields(w, mv, nc, r.status, keys[r.sensor].c_str());
+    if (r.seq)
+      w.fieldUInt("seq", r.seq);
+    if (r.epochMs < 0) {
+      error = "timestamp before 1970";
+      return false;
+    }
+    w.endLine((uint32_t)(r.epochMs / 1000), (uint16_t)(r.epochMs % 1000));
+    lines.append(w.c_str(), w.length());
+    records++;
+  }
+  if (reader.error()) {
+    error = reader.error();
+    return false;
+  }
+  out += lines;
+  summary.records = records;
+  summary.device = device;
+  return true;
+}
+
+} // namespace Bridge
@@ -0,0 +1,21 @@
+// src/bridge/BatchLines.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+namespace Bridge {
+
+struct BatchSummary {
+  uint32_t records = 0;
+  std::string device;
+};
+
+// Appends the "environment" lines of a binary uplink batch (lib/Uplink)
+// to out, timestamps in ms (write with &precision=ms). The lines match
+// the node's own full-snapshot lines. On a malformed batch returns false
+// with error set and leaves out unchanged.
+bool batchToLines(const uint8_t *data, size_t len, std::string &out,
+                  BatchSummary &summary, std::string &error);
+
+} // namespace Bridge
@@ -0,0 +1,215 @@
+// src/bridge/HttpIo.cpp
+#include "HttpIo.h"
+
+#include <algorithm>
+#include <errno.h>
+#include <netdb.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace Bridge {
+
+static constexpr size_t MAX_HEAD = 8192;
+static constexpr int IO_TIMEOUT_S = 10;
+
+static void setTimeouts(int fd) {
+  struct timeval tv = {IO_TIMEOUT_S, 0};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+}
+
+static bool writeAll(int fd, const char *data, size_t len) {
+  while (len > 0) {
+    const ssize_t n = send(fd, data, len, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+    data += n;
+    len -= (size_t)n;
+  }
+  return true;
+}
+
+// Reads up to the end of the head; leftover body bytes stay in `rest`
+static bool readHead(int fd, std::string &head, std::string &rest) {
+  std::string buf;
+  char chunk[2048];
+  for (;;) {
+    const size_t end = buf.find("\r\n\r\n");
+    if (end != std::string::npos) {
+      head = buf.substr(0, end + 2);
+      rest = buf.substr(end + 4);
+      return true;
+    }
+    if (buf.size() > MAX_HEAD)
+      return false;
+    const ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+    buf.append(chunk, (size_t)n);
+  }
+}
+
+// Value of a header in head ("Name: value\r\n"), empty if absent
+static std::string header(const std::string &head, const char *name) {
+  const size_t len = strlen(name);
+  for (size_t pos = head.find("\r\n"); pos != std::string::npos;
+       pos = head.find("\r\n", pos + 2)) {
+    const char *line = head.c_str() + pos + 2;
+    if (strncasecmp(line, name, len) == 0 && line[len] == ':') {
+      const size_t start = head.find_first_not_of(' ', pos + 3 + len);
+      const size_t end = head.find("\r\n", pos + 2);
+      if (start == std::string::npos || start >= end)
+        return "";
+      return head.substr(start, end - start);
+    }
+  }
+  return "";
+}
+
+static bool readBody(int fd, std::string &body, size_t length) {
+  char chunk[4096];
+  while (body.size() < length) {
+    const size_t want = std::min(sizeof(chunk), length - body.size());
+    const ssize_t n = recv(fd, chunk, want, 0);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+    body.append(chunk, (size_t)n);
+  }
+  return true;
+}
+
+int listenOn(const std::string &address) {
+  std::string host, port = address;
+  const size_t colon = address.rfind(':');
+  if (colon != std::string::npos) {
+    host = address.substr(0, colon);
+    port = address.substr(colon + 1);
+  }
+  struct addrinfo hints = {};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = AI_PASSIVE;
+  struct addrinfo *res = nullptr;
+  if (getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints,
+                  &res) != 0)
+    return -1;
+  int fd = -1;
+  for (struct addrinfo *ai = res; ai; ai = ai->ai_next) {
+    fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+    if (fd < 0)
+      continue;
+    const int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (bind(fd, ai->ai_addr, ai->ai_addrlen) == 0 && listen(fd, 16) == 0)
+      break;
+    close(fd);
+    fd = -1;
+  }
+  freeaddrinfo(res);
+  return fd;
+}
+
+bool readRequest(int fd, HttpRequest &req, size_t maxBody) {
+  setTimeouts(fd);
+  std::string head;
+  if (!readHead(fd, head, req.body))
+    return false;
+  char method[16], target[1024];
+  if (sscanf(head.c_str(), "%15s %1023s", method, target) != 2)
+    return false;
+  req.method = method;
+  req.target = target;
+  req.authorization = header(head, "Authorization");
+  const std::string length = header(head, "Content-Length");
+  const unsigned long n = length.empty() ? 0 : strtoul(length.c_str(), nullptr, 10);
+  if (n > maxBody || req.body.size() > n)
+    return false;
+  return readBody(fd, req.body, n);
+}
+
+void writeResponse(int fd, int code, const char *reason,
+                   const std::string &body) {
+  char head[256];
+  const int n = snprintf(head, sizeof(head),
+                         "HTTP/1.1 %d %s\r\nContent-Type: text/plain\r\n"
+                         "Content-Length: %zu\r\nConnection: close\r\n\r\n",
+                         code, reason, body.size());
+  if (writeAll(fd, head, (size_t)n))
+    writeAll(fd, body.data(), body.size());
+}
+
+bool parseUrl(const std::string &url, HttpUrl &out) {
+  static const char SCHEME[] = "http://";
+  if (url.compare(0, sizeof(SCHEME) - 1, SCHEME) != 0)
+    return false;
+  const std::string rest = url.substr(sizeof(SCHEME) - 1);
+  const size_t slash = rest.find('/');
+  const std::string authority = rest.substr(0, slash);
+  out.prefix = slash == std::string::npos ? "" : rest.substr(slash);
+  while (!out.prefix.empty() && out.prefix.back() == '/')
+    out.prefix.pop_back();
+  const size_t colon = authority.rfind(':');
+  out.host = authority.substr(0, colon);
+  out.port = colon == std::string::npos ? "80" : authority.substr(colon + 1);
+  return !out.host.empty();
+}
+
+int httpPost(const HttpUrl &url, const std::string &pathAndQuery,
+             const std::string &authorization, const char *contentType,
+             const std::string &body, std::string &response) {
+  struct addrinfo hints = {};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  struct addrinfo *res = nullptr;
+  if (getaddrinfo(url.host.c_str(), url.port.c_str(), &hints, &res) != 0)
+    return -1;
+  int fd = -1;
+  for (struct addrinfo *ai = res; ai; ai = ai->ai_next) {
+    fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+    if (fd < 0)
+      continue;
+    setTimeouts(fd);
+    if (connect(fd, ai->ai_addr, ai->ai_addrlen) == 0)
+      break;
+    close(fd);
+    fd = -1;
+  }
+  freeaddrinfo(res);
+  if (fd < 0)
+    return -1;
+
+  std::string req = "POST " + url.prefix + pathAndQuery + " HTTP/1.1\r\n";
+  req += "Host: " + url.host + ":" + url.port + "\r\n";
+  if (!authorization.empty())
+    req += "Authorization: " + authorization + "\r\n";
+  req += std::string("Content-Type: ") + contentType + "\r\n";
+  req += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+  req += "Connection: close\r\n\r\n";
+
+  int code = -1;
+  std::string head;
+  response.clear();
+  if (writeAll(fd, req.data(), req.size()) &&
+      writeAll(fd, body.data(), body.size()) &&
+      readHead(fd, head, response) &&
+      sscanf(head.c_str(), "HTTP/%*s %d", &code) == 1) {
+    const std::string length = header(head, "Content-Length");
+    if (!length.empty())
+      readBody(fd, response, strtoul(length.c_str(), nullptr, 10));
+  }
+  close(fd);
+  return code;
+}
+
+} // namespace Bridge
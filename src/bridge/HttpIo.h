@@ -0,0 +1,41 @@
+// src/bridge/HttpIo.h
+#pragma once
+#include <stdint.h>
+#include <string>
+
+/*
+  Just enough blocking HTTP/1.1 over POSIX sockets for the bridge: one
+  request per connection (Connection: close), bodies by Content-Length.
+*/
+
+namespace Bridge {
+
+struct HttpRequest {
+  std::string method;
+  std::string target; // path and query
+  std::string authorization;
+  std::string body;
+};
+
+struct HttpUrl {
+  std::string host;
+  std::string port;
+  std::string prefix; // path before /api/v2/write, no trailing '/'
+};
+
+// Listening socket on [host:]port, -1 on error (errno set)
+int listenOn(const std::string &address);
+// Reads one request; false on a malformed, oversized or timed-out one
+bool readRequest(int fd, HttpRequest &req, size_t maxBody);
+void writeResponse(int fd, int code, const char *reason,
+                   const std::string &body);
+
+// "http://host[:port][/prefix]"; false for anything else (no https)
+bool parseUrl(const std::string &url, HttpUrl &out);
+// POSTs body and returns the status code, or -1 if the server could not
+// be reached or answered garbage; the response body goes to response
+int httpPost(const HttpUrl &url, const std::string &pathAndQuery,
+             const std::string &authorization, const char *contentType,
+             const std::string &body, std::string &response);
+
+} // namespace Bridge
@@ -0,0 +1,186 @@
+// src/bridge/main.cpp
+//
+// Uplink bridge: accepts the sensor node's binary batches (lib/Uplink)
+// and writes them to InfluxDB as the node's own "environment" lines.
+//
+//   pio run -e native_bridge
+//   .pio/build/native_bridge/program --influx http://influx:8086
+//   .pio/build/native_bridge/program decode batch.bin
+//
+// Options:
+//   --listen [addr:]port  where the node posts (default 8087)
+//   --influx <url>        InfluxDB base URL, http:// only (default
+//                         http://127.0.0.1:8086)
+//   --verbose             log every forwarded batch
+//
+// The node POSTs /sen66/v1/batch?bucket=&org= with its InfluxDB token;
+// the bridge forwards the lines to <influx>/api/v2/write with the same
+// query (plus precision=ms) and Authorization header, and answers with
+// InfluxDB's status: a 2xx only once the data is written, so the node
+// keeps and retries a batch that did not make it. A malformed batch is
+// answered 400, an unreachable InfluxDB 502.
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <sys/socket.h>
+
+#include "BatchLines.h"
+#include "HttpIo.h"
+
+static constexpr size_t MAX_BATCH = 64 * 1024;
+static const char BATCH_PATH[] = "/sen66/v1/batch";
+
+struct Totals {
+  uint64_t batches = 0;
+  uint64_t records = 0;
+  uint64_t batchBytes = 0;
+  uint64_t lineBytes = 0;
+};
+
+static void usage(const char *argv0) {
+  fprintf(stderr,
+          "usage: %s [--listen [addr:]port] [--influx url] [--verbose]\n"
+          "       %s decode <batch file>\n",
+          argv0, argv0);
+}
+
+// Prints a batch file as line protocol
+static int decodeFile(const char *path) {
+  std::ifstream f(path, std::ios::binary);
+  if (!f) {
+    fprintf(stderr, "cannot open %s\n", path);
+    return 1;
+  }
+  const std::string data((std::istreambuf_iterator<char>(f)),
+                         std::istreambuf_iterator<char>());
+  std::string lines, error;
+  Bridge::BatchSummary summary;
+  if (!Bridge::batchToLines((const uint8_t *)data.data(), data.size(), lines,
+                            summary, error)) {
+    fprintf(stderr, "%s: %s\n", path, error.c_str());
+    return 1;
+  }
+  fwrite(lines.data(), 1, lines.size(), stdout);
+  fprintf(stderr, "%u records, %zu batch bytes -> %zu line bytes\n",
+          (unsigned)summary.records, data.size(), lines.size());
+  return 0;
+}
+
+static void handle(int fd, const Bridge::HttpUrl &influx, Totals &totals,
+                   bool verbose) {
+  Bridge::HttpRequest req;
+  if (!Bridge::readRequest(fd, req, MAX_BATCH)) {
+    Bridge::writeResponse(fd, 400, "Bad Request", "bad request\n");
+    return;
+  }
+  const size_t q = req.target.find('?');
+  const std::string path = req.target.substr(0, q);
+  const std::string query = q == std::string::npos ? "" : req.target.substr(q + 1);
+  if (path != BATCH_PATH) {
+    Bridge::writeResponse(fd, 404, "Not Found", "not found\n");
+    return;
+  }
+  if (req.method != "POST") {
+    Bridge::writeResponse(fd, 405, "Method Not Allowed", "POST only\n");
+    return;
+  }
+
+  std::string lines, error;
+  Bridge::BatchSummary summary;
+  if (!Bridge::batchToLines((const uint8_t *)req.body.data(), req.body.size(),
+                            lines, summary, error)) {
+    fprintf(stderr, "[Bridge] rejected %zu byte batch: %s\n", req.body.size(),
+            error.c_str());
+    Bridge::writeResponse(fd, 400, "Bad Request", error + "\n");
+    return;
+  }
+  if (lines.empty()) {
+    Bridge::writeResponse(fd, 204, "No Content", "");
+    return;
+  }
+
+  std::string target = "/api/v2/write?";
+  if (!query.empty())
+    target += query + "&";
+  target += "precision=ms";
+  std::string response;
+  const int code = Bridge::httpPost(influx, target, req.authorization,
+                                    "text/plain; charset=utf-8", lines,
+                                    response);
+  if (code < 0) {
+    fprintf(stderr, "[Bridge] InfluxDB unreachable (%s:%s)\n",
+            influx.host.c_str(), influx.port.c_str());
+    Bridge::writeResponse(fd, 502, "Bad Gateway", "influxdb unreachable\n");
+    return;
+  }
+  if (code >= 200 && code < 300) {
+    totals.batches++;
+    totals.records += summary.records;
+    totals.batchBytes += req.body.size();
+    totals.lineBytes += lines.size();
+  } else {
+    fprintf(stderr, "[Bridge] InfluxDB HTTP %d: %s\n", code, response.c_str());
+  }
+  if (verbose)
+    printf("[Bridge] %s: %u records, %zu bytes -> %zu line bytes, HTTP %d "
+           "(total %.1fx over %llu batches)\n",
+           summary.device.c_str(), (unsigned)summary.records, req.body.size(),
+           lines.size(), code,
+           totals.batchBytes ? (double)totals.lineBytes / totals.batchBytes : 0.0,
+           (unsigned long long)totals.batches);
+  Bridge::writeResponse(fd, code, code < 300 ? "OK" : "Upstream Error",
+                        response);
+}
+
+int main(int argc, char **argv) {
+  std::string listenAddr = "8087";
+  std::string influxUrl = "http://127.0.0.1:8086";
+  bool verbose = false;
+
+  if (argc == 3 && !strcmp(argv[1], "decode"))
+    return decodeFile(argv[2]);
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--listen") && i + 1 < argc) {
+      listenAddr = argv[++i];
+    } else if (!strcmp(argv[i], "--influx") && i + 1 < argc) {
+      influxUrl = argv[++i];
+    } else if (!strcmp(argv[i], "--verbose")) {
+      verbose = true;
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  Bridge::HttpUrl influx;
+  if (!Bridge::parseUrl(influxUrl, influx)) {
+    fprintf(stderr, "--influx must be http://host[:port][/path]\n");
+    return 2;
+  }
+  const int server = Bridge::listenOn(listenAddr);
+  if (server < 0) {
+    perror(("listen " + listenAddr).c_str());
+    return 1;
+  }
+  signal(SIGPIPE, SIG_IGN);
+  printf("[Bridge] listening on %s, forwarding to %s\n", listenAddr.c_str(),
+         influxUrl.c_str());
+  fflush(stdout);
+
+  // One batch at a time: a node posts every few minutes, and serial
+  // forwarding keeps each node's writes in order
+  Totals totals;
+  for (;;) {
+    const int fd = accept(server, nullptr, nullptr);
+    if (fd < 0)
+      continue;
+    handle(fd, influx, totals, verbose);
+    close(fd);
+    fflush(stdout);
+  }
+}
@@ -0,0 +1,502 @@
+// src/columns/main.cpp
+//
+// Frame log to columns: decodes recorded SEN6x value frames (a frame
+// log, lib/FrameColumns/FrameLog.h) into a columnar file for analysis
+// (lib/FrameColumns/ColumnFile.h), batch-wise and on all cores.
+//
+//   pio run -e native_columns
+//   .pio/build/native_columns/program export frames.s6fr frames.s6cl
+//   .pio/build/native_columns/program bench frames.s6fr
+//
+// Commands:
+//   export <log> <out>   write the columnar file
+//   bench <log>          frames/s per kernel on one core, then the best
+//                        kernel's scaling across cores (nothing written)
+//   check <log>          decode with every kernel and compare with the
+//                        firmware's one-frame-at-a-time decoders
+//   info <columns>       columns, valid counts and value ranges
+//
+// Options:
+//   --kernel scalar|ssse3|avx2  (default: the widest the CPU runs)
+//   --threads N          decoding threads (default: all cores)
+//   --runs R             bench: best of R runs (default 3)
+//
+// The simulator writes frame logs: native_sim --frame-log frames.s6fr.
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "ColumnFile.h"
+#include "FrameBatch.h"
+#include "FrameLog.h"
+
+using namespace FrameColumns;
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  Kernel kernel = bestKernel();
+  unsigned threads = 0; // all cores
+  unsigned runs = 3;
+};
+
+// A read-only mapping of a whole file
+struct Mapped {
+  const uint8_t *data = nullptr;
+  size_t size = 0;
+
+  ~Mapped() {
+    if (data)
+      munmap((void *)data, size);
+  }
+};
+
+// A frame log's records, mapped in place
+struct FrameLogFile {
+  Mapped map;
+  Sen66Protocol::Model model = Sen66Protocol::SEN66;
+  const Record *records = nullptr;
+  size_t count = 0;
+};
+
+static void usage(const char *argv0) {
+  fprintf(stderr,
+          "usage: %s export <log> <out> [--kernel k] [--threads N]\n"
+          "       %s bench <log> [--kernel k] [--threads N] [--runs R]\n"
+          "       %s check <log>\n"
+          "       %s info <columns>\n",
+          argv0, argv0, argv0, argv0);
+}
+
+static double secondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static bool mapFile(const char *path, Mapped &out) {
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    fprintf(stderr, "cannot open %s\n", path);
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    fprintf(stderr, "%s: empty\n", path);
+    close(fd);
+    return false;
+  }
+  void *p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (p == MAP_FAILED) {
+    fprintf(stderr, "cannot map %s\n", path);
+    return false;
+  }
+  madvise(p, (size_t)st.st_size, MADV_SEQUENTIAL);
+  out.data = (const uint8_t *)p;
+  out.size = (size_t)st.st_size;
+  return true;
+}
+
+static bool openFrameLog(const char *path, FrameLogFile &log) {
+  if (!mapFile(path, log.map))
+    return false;
+  FileHeader h;
+  const char *error = "file too short";
+  if (log.map.size < sizeof(h)) {
+    fprintf(stderr, "%s: %s\n", path, error);
+    return false;
+  }
+  memcpy(&h, log.map.data, sizeof(h));
+  if (!checkHeader(h, error)) {
+    fprintf(stderr, "%s: %s\n", path, error);
+    return false;
+  }
+  log.model = (Sen66Protocol::Model)h.model;
+  log.records = (const Record *)(log.map.data + sizeof(h));
+  log.count = (log.map.size - sizeof(h)) / sizeof(Record);
+  return true;
+}
+
+// ===== Decoding =====
+
+// Splits the rows into one ROW_ALIGN-aligned range per thread
+static DecodeStats decodeParallel(Kernel k, const ColumnLayout &layout,
+                                  const Record *records, uint8_t *file,
+                                  unsigned threads) {
+  const uint64_t rows = layout.rows();
+  uint64_t chunk = (rows + threads - 1) / threads;
+  chunk = (chunk + ROW_ALIGN - 1) / ROW_ALIGN * ROW_ALIGN;
+  std::vector<DecodeStats> stats(threads);
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < threads; ++t) {
+    const uint64_t first = t * chunk;
+    if (first >= rows)
+      break;
+    const size_t count = (size_t)(rows - first < chunk ? rows - first : chunk);
+    workers.emplace_back([=, &layout, &stats] {
+      decodeRows(k, layout, records + first, first, count, file, stats[t]);
+    });
+  }
+  for (std::thread &w : workers)
+    w.join();
+  DecodeStats total;
+  for (const DecodeStats &s : stats)
+    total.add(s);
+  return total;
+}
+
+template <Sen66Protocol::Word... Ws>
+static const Sen66Protocol::Word *wordArray(Sen66Protocol::WordList<Ws...>) {
+  static const Sen66Protocol::Word words[] = {Ws...};
+  return words;
+}
+
+static float measuredField(const Sen66Protocol::MeasuredValues &mv,
+                           Sen66Protocol::Word w, bool &valid) {
+  using namespace Sen66Protocol;
+  switch (w) {
+  case W_PM1_0:
+    return valid = mv.valid_pm1_0, mv.pm1_0;
+  case W_PM2_5:
+    return valid = mv.valid_pm2_5, mv.pm2_5;
+  case W_PM4_0:
+    return valid = mv.valid_pm4_0, mv.pm4_0;
+  case W_PM10_0:
+    return valid = mv.valid_pm10_0, mv.pm10_0;
+  case W_HUMIDITY:
+    return valid = mv.valid_humidity, mv.humidity_rh;
+  case W_TEMPERATURE:
+    return valid = mv.valid_temperature, mv.temperature_c;
+  case W_VOC:
+    return valid = mv.valid_voc, mv.voc_index;
+  case W_NOX:
+    return valid = mv.valid_nox, mv.nox_index;
+  case W_CO2:
+    return valid = mv.valid_co2, mv.co2_ppm;
+  case W_HCHO:
+    return valid = mv.valid_hcho, mv.hcho_ppb;
+  default:
+    return valid = false, NAN;
+  }
+}
+
+static void putValue(const ColumnLayout &layout, uint8_t column, size_t row,
+                     float v, bool valid, uint8_t *file) {
+  const ColumnEntry &e = layout.column(column);
+  ((float *)(file + e.dataOffset))[row] = valid ? v : NAN;
+  uint8_t &bits = file[e.validOffset + row / 8];
+  bits = valid ? (uint8_t)(bits | (1u << (row % 8)))
+               : (uint8_t)(bits & ~(1u << (row % 8)));
+}
+
+// The same columns, one frame at a time through the firmware's decoders
+template <Sen66Protocol::Model M>
+static void referenceRows(const ColumnLayout &layout, const Record *records,
+                          size_t count, uint8_t *file) {
+  using namespace Sen66Protocol;
+  using Words = typename ModelTraits<M>::MeasuredWords;
+  const Word *words = wordArray(Words());
+  for (size_t i = 0; i < count; ++i) {
+    const Record &r = records[i];
+    ((int64_t *)(file + layout.column(0).dataOffset))[i] = r.epochMs;
+    ((uint32_t *)(file + layout.column(1).dataOffset))[i] = r.monoMs;
+    (file + layout.column(2).dataOffset)[i] = r.sensor;
+
+    MeasuredValues mv;
+    const bool measuredOk = decodeMeasuredValuesOf<M>(r.measured, mv);
+    uint8_t c = 3;
+    for (uint8_t j = 0; j < Words::COUNT; ++j, ++c) {
+      bool valid;
+      const float v = measuredField(mv, words[j], valid);
+      putValue(layout, c, i, v, measuredOk && valid, file);
+    }
+
+    NumberConcentration nc;
+    const bool numbersOk = (r.flags & FRAME_HAS_NUMBERS) &&
+                           decodeNumberConcentration(r.numbers, nc);
+    const float values[5] = {nc.nc0_5, nc.nc1_0, nc.nc2_5, nc.nc4_0, nc.nc10_0};
+    const bool valid[5] = {nc.valid_nc0_5, nc.valid_nc1_0, nc.valid_nc2_5,
+                           nc.valid_nc4_0, nc.valid_nc10_0};
+    for (uint8_t j = 0; j < 5; ++j, ++c)
+      putValue(layout, c, i, values[j], numbersOk && valid[j], file);
+  }
+}
+
+static void referenceDecode(const ColumnLayout &layout, const Record *records,
+                            uint8_t *file) {
+  const size_t n = (size_t)layout.rows();
+  switch (layout.model()) {
+  case Sen66Protocol::SEN63C:
+    return referenceRows<Sen66Protocol::SEN63C>(layout, records, n, file);
+  case Sen66Protocol::SEN65:
+    return referenceRows<Sen66Protocol::SEN65>(layout, records, n, file);
+  case Sen66Protocol::SEN68:
+    return referenceRows<Sen66Protocol::SEN68>(layout, records, n, file);
+  default:
+    return referenceRows<Sen66Protocol::SEN66>(layout, records, n, file);
+  }
+}
+
+static void printStats(const DecodeStats &s) {
+  printf("  %llu rows, CRC errors: %llu measured, %llu 0x0316; %llu without "
+         "0x0316\n",
+         (unsigned long long)s.rows, (unsigned long long)s.measuredCrcErrors,
+         (unsigned long long)s.numberCrcErrors,
+         (unsigned long long)s.numbersMissing);
+}
+
+// ===== Commands =====
+
+static int exportColumns(const char *logPath, const char *outPath,
+                         const Options &opt) {
+  FrameLogFile log;
+  if (!openFrameLog(logPath, log))
+    return 1;
+  const ColumnLayout layout(log.model, log.count);
+  const int fd = open(outPath, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0 || ftruncate(fd, (off_t)layout.fileSize()) != 0) {
+    fprintf(stderr, "cannot write %s\n", outPath);
+    if (fd >= 0)
+      close(fd);
+    return 1;
+  }
+  void *p = mmap(nullptr, layout.fileSize(), PROT_READ | PROT_WRITE,
+                 MAP_SHARED, fd, 0);
+  close(fd);
+  if (p == MAP_FAILED) {
+    fprintf(stderr, "cannot map %s\n", outPath);
+    return 1;
+  }
+  uint8_t *file = (uint8_t *)p;
+  layout.writeHeader(file);
+
+  const Clock::time_point start = Clock::now();
+  const DecodeStats stats =
+      decodeParallel(opt.kernel, layout, log.records, file, opt.threads);
+  const double s = secondsSince(start);
+  munmap(p, layout.fileSize());
+
+  printf("%s -> %s: %u columns, %.1f MB\n", logPath, outPath,
+         layout.columnCount(), layout.fileSize() / 1e6);
+  printStats(stats);
+  printf("  %.3f s, %.1f M frames/s (%s, %u thread%s)\n", s,
+         stats.rows / s / 1e6, kernelName(opt.kernel), opt.threads,
+         opt.threads > 1 ? "s" : "");
+  return 0;
+}
+
+// Best of `runs` decodes into `file`, in frames/s
+static double timeDecode(Kernel k, const ColumnLayout &layout,
+                         const Record *records, uint8_t *file, unsigned threads,
+                         unsigned runs) {
+  double best = 0;
+  for (unsigned i = 0; i < runs; ++i) {
+    const Clock::time_point start = Clock::now();
+    decodeParallel(k, layout, records, file, threads);
+    const double s = secondsSince(start);
+    if (best == 0 || s < best)
+      best = s;
+  }
+  return layout.rows() / best;
+}
+
+static void benchLine(const char *kernel, unsigned threads, double fps,
+                      double base) {
+  printf("  %-9s %7u %12.2f %10.1f %8.2fx\n", kernel, threads, fps / 1e6,
+         fps * sizeof(Record) / 1e6, fps / base);
+}
+
+static int bench(const char *logPath, const Options &opt) {
+  FrameLogFile log;
+  if (!openFrameLog(logPath, log))
+    return 1;
+  if (log.count == 0) {
+    fprintf(stderr, "%s: no records\n", logPath);
+    return 1;
+  }
+  const ColumnLayout layout(log.model, log.count);
+  // Touched once up front so page faults stay out of the timings
+  std::vector<uint8_t> file(layout.fileSize());
+  layout.writeHeader(file.data());
+
+  printf("%s: %zu frames (SEN%u), %.1f MB\n", logPath, log.count,
+         (unsigned)log.model, log.count * sizeof(Record) / 1e6);
+  printf("  %-9s %7s %12s %10s %9s\n", "kernel", "threads", "M frames/s",
+         "MB/s", "speedup");
+
+  double best = 0;
+  for (unsigned i = 0; i < opt.runs; ++i) {
+    const Clock::time_point start = Clock::now();
+    referenceDecode(layout, log.records, file.data());
+    const double s = secondsSince(start);
+    if (best == 0 || s < best)
+      best = s;
+  }
+  const double reference = log.count / best;
+  benchLine("reference", 1, reference, reference);
+
+  for (uint8_t k = 0; k < KERNEL_COUNT; ++k) {
+    if (!kernelSupported((Kernel)k))
+      continue;
+    benchLine(kernelName((Kernel)k), 1,
+              timeDecode((Kernel)k, layout, log.records, file.data(), 1,
+                         opt.runs),
+              reference);
+  }
+
+  // Scaling: 1, 2, 4, ... threads and the maximum
+  const double single =
+      timeDecode(opt.kernel, layout, log.records, file.data(), 1, opt.runs);
+  for (unsigned t = 2;; t *= 2) {
+    const unsigned threads = t < opt.threads ? t : opt.threads;
+    if (threads <= 1)
+      break;
+    const double fps = timeDecode(opt.kernel, layout, log.records, file.data(),
+                                  threads, opt.runs);
+    printf("  %-9s %7u %12.2f %10.1f %8.2fx  (%.2f per thread)\n",
+           kernelName(opt.kernel), threads, fps / 1e6,
+           fps * sizeof(Record) / 1e6, fps / reference,
+           fps / single / threads);
+    if (threads == opt.threads)
+      break;
+  }
+  return 0;
+}
+
+static int check(const char *logPath) {
+  FrameLogFile log;
+  if (!openFrameLog(logPath, log))
+    return 1;
+  const ColumnLayout layout(log.model, log.count);
+  std::vector<uint8_t> expected(layout.fileSize());
+  layout.writeHeader(expected.data());
+  referenceDecode(layout, log.records, expected.data());
+
+  int failed = 0;
+  DecodeStats scalarStats;
+  for (uint8_t k = 0; k < KERNEL_COUNT; ++k) {
+    if (!kernelSupported((Kernel)k)) {
+      printf("  %-7s not supported by this CPU\n", kernelName((Kernel)k));
+      continue;
+    }
+    for (unsigned threads = 1; threads <= 4; threads *= 4) {
+      std::vector<uint8_t> file(layout.fileSize());
+      layout.writeHeader(file.data());
+      const DecodeStats stats =
+          decodeParallel((Kernel)k, layout, log.records, file.data(), threads);
+      const bool same = file == expected;
+      printf("  %-7s %u thread%s  %s\n", kernelName((Kernel)k), threads,
+             threads > 1 ? "s" : " ", same ? "identical" : "DIFFERENT");
+      if (!same)
+        failed = 1;
+      if (k == KERNEL_SCALAR && threads == 1)
+        scalarStats = stats;
+    }
+  }
+  printStats(scalarStats);
+  return failed;
+}
+
+static int info(const char *path) {
+  Mapped map;
+  if (!mapFile(path, map))
+    return 1;
+  const char *error = nullptr;
+  if (!checkColumnFile(map.data, map.size, error)) {
+    fprintf(stderr, "%s: %s\n", path, error);
+    return 1;
+  }
+  ColumnFileHeader h;
+  memcpy(&h, map.data, sizeof(h));
+  printf("%s: SEN%u, %llu rows, %u columns\n", path, (unsigned)h.model,
+         (unsigned long long)h.rows, (unsigned)h.columnCount);
+  const ColumnEntry *dir = (const ColumnEntry *)(map.data + sizeof(h));
+  for (uint16_t c = 0; c < h.columnCount; ++c) {
+    ColumnEntry e;
+    memcpy(&e, dir + c, sizeof(e));
+    char name[17] = {};
+    memcpy(name, e.name, sizeof(e.name));
+    const char *type = e.type == COLUMN_FLOAT32  ? "float32"
+                       : e.type == COLUMN_INT64  ? "int64"
+                       : e.type == COLUMN_UINT32 ? "uint32"
+                                                 : "uint8";
+    printf("  %-12s %-8s @%-10llu", name, type,
+           (unsigned long long)e.dataOffset);
+    if (e.type != COLUMN_FLOAT32) {
+      printf("\n");
+      continue;
+    }
+    if (e.dataOffset + h.rows * 4 > map.size ||
+        e.validOffset + (h.rows + 7) / 8 > map.size) {
+      fprintf(stderr, "%s: column %s is truncated\n", path, name);
+      return 1;
+    }
+    const float *v = (const float *)(map.data + e.dataOffset);
+    const uint8_t *bits = map.data + e.validOffset;
+    uint64_t valid = 0;
+    double sum = 0;
+    float lo = INFINITY, hi = -INFINITY;
+    for (uint64_t r = 0; r < h.rows; ++r) {
+      if (!(bits[r / 8] & (1u << (r % 8))))
+        continue;
+      valid++;
+      sum += v[r];
+      lo = v[r] < lo ? v[r] : lo;
+      hi = v[r] > hi ? v[r] : hi;
+    }
+    printf("%llu valid", (unsigned long long)valid);
+    if (valid > 0)
+      printf(", %g .. %g, mean %g", lo, hi, sum / valid);
+    printf("\n");
+  }
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  Options opt;
+  std::vector<const char *> args;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--kernel") && i + 1 < argc) {
+      if (!parseKernel(argv[++i], opt.kernel)) {
+        usage(argv[0]);
+        return 2;
+      }
+      if (!kernelSupported(opt.kernel)) {
+        fprintf(stderr, "%s is not supported by this CPU\n", argv[i]);
+        return 2;
+      }
+    } else if (!strcmp(argv[i], "--threads") && i + 1 < argc) {
+      opt.threads = (unsigned)atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--runs") && i + 1 < argc) {
+      opt.runs = (unsigned)atoi(argv[++i]);
+    } else if (argv[i][0] == '-') {
+      usage(argv[0]);
+      return 2;
+    } else {
+      args.push_back(argv[i]);
+    }
+  }
+  if (opt.threads == 0)
+    opt.threads = std::thread::hardware_concurrency();
+  if (opt.threads == 0)
+    opt.threads = 1;
+  if (opt.runs == 0)
+    opt.runs = 1;
+
+  if (args.size() == 3 && !strcmp(args[0], "export"))
+    return exportColumns(args[1], args[2], opt);
+  if (args.size() == 2 && !strcmp(args[0], "bench"))
+    return bench(args[1], opt);
+  if (args.size() == 2 && !strcmp(args[0], "check"))
+    return check(args[1]);
+  if (args.size() == 2 && !strcmp(args[0], "info"))
+    return info(args[1]);
+  usage(argv[0]);
+  return 2;
+}
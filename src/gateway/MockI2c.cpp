@@ -0,0 +1,302 @@
+// src/gateway/MockI2c.cpp
+#include "MockI2c.h"
+
+#include <errno.h>
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <Sen66.h>
+
+using namespace Sen66Protocol;
+
+struct MockI2c::Sensor {
+  Values values;
+  char serial[32];
+  bool measuring = false;
+  uint64_t startUs = 0;
+  uint16_t pending = 0; // command whose response can be read
+  uint64_t commandUs = 0;
+  int64_t lastRead = -1; // sample index of the last measured values read
+};
+
+struct MockI2c::Adapter {
+  std::string path;
+  uint8_t index;
+  uint8_t mask = 0; // connected mux channels
+  Sensor sensors[POSITIONS];
+};
+
+static const int FD_BASE = 1000;
+
+static uint64_t monotonicUs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+// Deterministic, so a --mock-noise run can be repeated
+static uint32_t nextRandom() {
+  static uint32_t state = 0x9E3779B9u;
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+// ===== Frames =====
+
+static float wordValue(Word w, const MockI2c::Values &v) {
+  switch (w) {
+  case W_PM1_0:
+    return v.pm1_0;
+  case W_PM2_5:
+    return v.pm2_5;
+  case W_PM4_0:
+    return v.pm4_0;
+  case W_PM10_0:
+    return v.pm10;
+  case W_HUMIDITY:
+    return v.humidity;
+  case W_TEMPERATURE:
+    return v.temperature;
+  case W_VOC:
+    return v.voc;
+  case W_NOX:
+    return v.nox;
+  case W_CO2:
+    return v.co2;
+  case W_HCHO:
+    return v.hcho;
+  default:
+    return 0;
+  }
+}
+
+// Encoded as WordCodec<W> decodes it; "not available" before the first
+// sample, as the sensor sends it
+template <Word W> static uint16_t measuredWord(const MockI2c::Values &v,
+                                               bool available) {
+  if (!available)
+    return WordCodec<W>::SIGNED ? 0x7FFF : 0xFFFF;
+  const float s = roundf(wordValue(W, v) * WordCodec<W>::SCALE);
+  return WordCodec<W>::SIGNED ? (uint16_t)(int16_t)s : (uint16_t)s;
+}
+
+template <typename Words> struct MeasuredFrame;
+
+template <Word... Ws> struct MeasuredFrame<WordList<Ws...>> {
+  static uint8_t words(uint16_t *out, const MockI2c::Values &v,
+                       bool available) {
+    const uint16_t all[] = {measuredWord<Ws>(v, available)...};
+    memcpy(out, all, sizeof(all));
+    return sizeof...(Ws);
+  }
+};
+
+static size_t putWords(uint8_t *buf, size_t len, const uint16_t *words,
+                       size_t count) {
+  size_t n = 0;
+  for (size_t i = 0; i < count && n + 3 <= len; ++i) {
+    buf[n] = (uint8_t)(words[i] >> 8);
+    buf[n + 1] = (uint8_t)(words[i] & 0xFF);
+    buf[n + 2] = crc8(buf + n, 2);
+    n += 3;
+  }
+  return n;
+}
+
+MockI2c::Values MockI2c::sensorValues(uint8_t adapter, uint8_t position) {
+  const float k = (float)(adapter * 10 + position);
+  Values v;
+  v.pm1_0 = 3.0f + k;
+  v.pm2_5 = 5.0f + k;
+  v.pm4_0 = 6.0f + k;
+  v.pm10 = 7.0f + k;
+  v.humidity = 40.0f + k;
+  v.temperature = 20.0f + k / 2;
+  v.voc = 100.0f + 10 * k;
+  v.nox = 1.0f + k;
+  v.co2 = 500.0f + 10 * k;
+  v.hcho = 20.0f + k;
+  v.nc0_5 = 20.0f + k;
+  v.nc1_0 = 24.0f + k;
+  v.nc2_5 = 25.0f + k;
+  v.nc4_0 = 25.5f + k;
+  v.nc10 = 26.0f + k;
+  return v;
+}
+
+// ===== Adapter =====
+
+MockI2c::~MockI2c() {
+  for (Adapter *a : _adapters)
+    delete a;
+}
+
+int MockI2c::open(const char *path) {
+  for (Adapter *a : _adapters)
+    if (a->path == path)
+      return FD_BASE + a->index;
+  Adapter *a = new Adapter;
+  a->path = path;
+  a->index = (uint8_t)_adapters.size();
+  for (uint8_t p = 0; p < POSITIONS; ++p) {
+    Sensor &s = a->sensors[p];
+    s.values = sensorValues(a->index, p);
+    memset(s.serial, 0, sizeof(s.serial));
+    snprintf(s.serial, sizeof(s.serial), "MOCK%u.%u", (unsigned)a->index,
+             (unsigned)p);
+  }
+  _adapters.push_back(a);
+  return FD_BASE + a->index;
+}
+
+int MockI2c::ioctl(int fd, unsigned long request, void *arg) {
+  const int i = fd - FD_BASE;
+  if (i < 0 || i >= (int)_adapters.size()) {
+    errno = EBADF;
+    return -1;
+  }
+  if (request == I2C_FUNCS) {
+    *(unsigned long *)arg = I2C_FUNC_I2C;
+    return 0;
+  }
+  if (request == I2C_RDWR)
+    return rdwr(*_adapters[i], arg);
+  errno = ENOTTY;
+  return -1;
+}
+
+int MockI2c::rdwr(Adapter &a, void *arg) {
+  const i2c_rdwr_ioctl_data &data = *(const i2c_rdwr_ioctl_data *)arg;
+  if (data.nmsgs == 0 || data.nmsgs > I2C_RDWR_IOCTL_MAX_MSGS) {
+    errno = EINVAL;
+    return -1;
+  }
+  const uint64_t now = monotonicUs();
+  uint8_t mask = a.mask;
+  bool ok = true;
+  for (uint32_t m = 0; m < data.nmsgs && ok; ++m) {
+    i2c_msg &msg = data.msgs[m];
+    const bool rd = msg.flags & I2C_M_RD;
+    if (msg.addr == MUX_ADDR) {
+      // Control register; takes effect at the STOP below
+      ok = msg.len == 1;
+      if (ok && rd)
+        msg.buf[0] = mask;
+      else if (ok)
+        mask = msg.buf[0];
+      continue;
+    }
+    // Two connected channels would put two sensors on 0x6B
+    const bool one = a.mask && !(a.mask & (a.mask - 1));
+    if (msg.addr != SENSOR_ADDR || (a.mask && !one)) {
+      ok = false;
+      break;
+    }
+    Sensor &s = a.sensors[a.mask ? 1 + __builtin_ctz(a.mask) : 0];
+    ok = rd ? readSensor(s, msg.buf, msg.len, now)
+            : writeSensor(s, msg.buf, msg.len, now);
+  }
+  a.mask = mask;
+  if (!ok) {
+    errno = EREMOTEIO;
+    return -1;
+  }
+  return (int)data.nmsgs;
+}
+
+// ===== Sensor =====
+
+bool MockI2c::writeSensor(Sensor &s, const uint8_t *data, uint16_t len,
+                          uint64_t nowUs) {
+  if (len < 2)
+    return false;
+  const uint16_t cmd = (uint16_t)(data[0] << 8 | data[1]);
+  s.pending = 0;
+  switch (cmd) {
+  case 0x0021: // start measurement; not while measuring
+    if (s.measuring)
+      return false;
+    s.measuring = true;
+    s.startUs = nowUs;
+    s.lastRead = -1;
+    return true;
+  case 0x0104: // stop measurement
+    s.measuring = false;
+    return true;
+  case 0x5607: // fan cleaning, idle only
+    return !s.measuring;
+  case 0x60B2: // temperature offset parameters
+    return len == 11;
+  case Sen66::DATA_READY_CMD:
+  case Sen66::MEASURED_VALUES_CMD:
+  case Sen66::NUMBER_CONCENTRATION_CMD:
+  case Sen66::RAW_VALUES_CMD:
+  case Sen66::DEVICE_STATUS_CMD:
+  case 0xD033: // serial number
+    s.pending = cmd;
+    s.commandUs = nowUs;
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool MockI2c::readSensor(Sensor &s, uint8_t *buf, uint16_t len,
+                         uint64_t nowUs) {
+  if (s.pending == 0 ||
+      nowUs - s.commandUs < Sen66::READ_EXEC_TIME_MS * 1000)
+    return false;
+  const uint16_t cmd = s.pending;
+  s.pending = 0;
+  // First sample one second after the start
+  const int64_t sample =
+      s.measuring ? (int64_t)((nowUs - s.startUs) / 1000000) - 1 : -1;
+  uint16_t words[16];
+  size_t count = 0;
+  switch (cmd) {
+  case Sen66::DATA_READY_CMD:
+    words[0] = sample >= 0 && sample > s.lastRead;
+    count = 1;
+    break;
+  case Sen66::MEASURED_VALUES_CMD:
+    count = MeasuredFrame<BuildModel::MeasuredWords>::words(words, s.values,
+                                                           sample >= 0);
+    if (sample >= 0)
+      s.lastRead = sample;
+    break;
+  case Sen66::NUMBER_CONCENTRATION_CMD: {
+    const float nc[5] = {s.values.nc0_5, s.values.nc1_0, s.values.nc2_5,
+                         s.values.nc4_0, s.values.nc10};
+    for (count = 0; count < 5; ++count)
+      words[count] = sample >= 0 ? (uint16_t)roundf(nc[count] * 10) : 0xFFFF;
+    break;
+  }
+  case Sen66::RAW_VALUES_CMD:
+    for (count = 0; count < BuildModel::RawWords::COUNT; ++count)
+      words[count] = 0xFFFF;
+    break;
+  case Sen66::DEVICE_STATUS_CMD:
+    words[0] = words[1] = 0;
+    count = 2;
+    break;
+  case 0xD033: // "MOCK<adapter>.<position>", NUL-padded to 32 chars
+    for (count = 0; count < 16; ++count)
+      words[count] = (uint16_t)((uint8_t)s.serial[2 * count] << 8 |
+                                (uint8_t)s.serial[2 * count + 1]);
+    break;
+  }
+  if (len > count * 3)
+    return false; // the sensor NACKs reads past its response
+  putWords(buf, len, words, count);
+  if (_noise > 0 && nextRandom() < _noise * 4294967296.0) {
+    buf[nextRandom() % len] ^= (uint8_t)(1u << (nextRandom() % 8));
+    _flips++;
+  }
+  return true;
+}
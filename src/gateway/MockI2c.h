@@ -0,0 +1,65 @@
+// src/gateway/MockI2c.h
+#pragma once
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <I2cDevBus.h>
+
+/*
+  Fake i2c-dev adapters for the gateway's --mock, behind lib/Sen66Linux's
+  I2cDevIo. Each distinct path opened is one adapter, numbered in order
+  of first open, with a TCA9548A at 0x70 and a SEN6x at 0x6B both
+  directly on the bus and on each of the eight channels. I2C_RDWR runs
+  as the hardware would:
+
+  - A message to an address nobody answers is NACKed (EREMOTEIO), as is
+    a sensor read with no command pending or less than
+    Sen66::READ_EXEC_TIME_MS after it.
+  - The mux connects the channel written to it at the STOP that ends the
+    ioctl. With a channel connected, 0x6B is the sensor on it, otherwise
+    the one directly on the bus.
+  - A measuring sensor has a new sample every second. Its values depend
+    only on where it sits (sensorValues()), so a read that reached the
+    wrong sensor shows in the output.
+  - setNoise(p) flips one bit in a fraction p of reads.
+
+  Time is CLOCK_MONOTONIC: the gateway runs in real time against it.
+*/
+class MockI2c : public I2cDevIo {
+public:
+  static constexpr uint8_t MUX_ADDR = 0x70;
+  static constexpr uint8_t SENSOR_ADDR = 0x6B;
+  // Sensor positions per adapter: directly on the bus, then channels 0..7
+  static constexpr uint8_t POSITIONS = 9;
+
+  struct Values {
+    float pm1_0, pm2_5, pm4_0, pm10;
+    float humidity, temperature, voc, nox, co2, hcho;
+    float nc0_5, nc1_0, nc2_5, nc4_0, nc10;
+  };
+  // position: 0 on the bus, 1 + channel behind the mux
+  static Values sensorValues(uint8_t adapter, uint8_t position);
+
+  ~MockI2c() override;
+
+  int open(const char *path) override;
+  int ioctl(int fd, unsigned long request, void *arg) override;
+  void close(int) override {}
+
+  void setNoise(double p) { _noise = p; }
+  uint32_t flippedBits() const { return _flips; }
+
+private:
+  struct Sensor;
+  struct Adapter;
+
+  int rdwr(Adapter &a, void *arg);
+  bool readSensor(Sensor &s, uint8_t *buf, uint16_t len, uint64_t nowUs);
+  bool writeSensor(Sensor &s, const uint8_t *data, uint16_t len,
+                   uint64_t nowUs);
+
+  std::vector<Adapter *> _adapters;
+  double _noise = 0;
+  uint32_t _flips = 0;
+};
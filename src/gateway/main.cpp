@@ -0,0 +1,407 @@
+// src/gateway/main.cpp
+//
+// Linux gateway: the sensor node's Sen66 driver and Sen66Array on i2c-dev
+// adapters (lib/Sen66Linux), writing one "environment" line per sample,
+// in the node's line protocol, to stdout.
+//
+//   pio run -e native_gateway
+//   .pio/build/native_gateway/program --sensor /dev/i2c-1 --device gw1
+//   .pio/build/native_gateway/program --sensor /dev/i2c-1@0=a
+//       --sensor /dev/i2c-1@1=b --sensor /dev/i2c-3=c --site home
+//
+// Options:
+//   --sensor PATH[@CH][=TAG]
+//                        a SEN6x on adapter PATH, behind TCA9548A channel
+//                        CH (0..7) if given, with sensor tag TAG
+//   --mux ADDR           TCA9548A address (default 0x70)
+//   --device D --room R --site S
+//                        tags on every line (empty: left out)
+//   --duration s         exit after s seconds (default: until SIGINT or
+//                        SIGTERM)
+//   --mock               fake adapters (MockI2c.h) instead of the kernel
+//   --mock-noise P       with --mock, flip a bit in a fraction P of reads
+//
+// Sensors on one adapter share a Sen66Array, so their 20 ms command
+// waits overlap. Each adapter has a timerfd in one epoll loop, armed for
+// its array's next step (Sen66Array::msUntilPoll); the process sleeps in
+// between and adapters don't wait for each other's timers, only for
+// each other's transfers. Lines carry ms timestamps (precision=ms) of
+// the data-ready answer, and suit e.g. Telegraf's execd input. Log
+// lines and the summary at exit go to stderr.
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <EnvironmentLine.h>
+#include <I2cDevBus.h>
+#include <Sen66Array.h>
+
+#include "MockI2c.h"
+
+// "environment,<sorted tags>", as the node's setSeriesKey() sizes it
+static constexpr size_t SERIES_KEY_SIZE = 160;
+static constexpr size_t LINE_SIZE = 512;
+// Sensors that didn't start are tried again this often
+static constexpr uint32_t START_RETRY_MS = 5000;
+// The timers round to ms, millis()-style; one more keeps the 20 ms
+// command waits whole
+static constexpr uint32_t TIMER_SLACK_MS = 1;
+
+static constexpr uint64_t SIGNAL_TAG = ~(uint64_t)0;
+static constexpr uint64_t DURATION_TAG = SIGNAL_TAG - 1;
+
+struct SensorSpec {
+  std::string path;
+  int channel = -1;
+  std::string tag;
+};
+
+struct Options {
+  std::vector<SensorSpec> sensors;
+  uint8_t muxAddr = Tca9548a::DEFAULT_ADDR;
+  std::string device, room, site;
+  uint32_t durationS = 0;
+  bool mock = false;
+  double mockNoise = 0;
+};
+
+struct Sensor {
+  Sensor(Sen66Bus &bus, const SensorSpec &spec) : sen66(bus), spec(spec) {}
+  Sen66 sen66;
+  SensorSpec spec;
+  char seriesKey[SERIES_KEY_SIZE];
+  uint32_t startAttemptMs = 0;
+  uint32_t seq = 0; // samples taken; "seq" on the lines, as the node writes it
+  uint32_t lines = 0;
+};
+
+struct Adapter {
+  Adapter(const char *path, I2cDevIo &io) : bus(path, io) {}
+  I2cDevBus bus;
+  std::unique_ptr<Tca9548a> mux;
+  Sen66Array array;
+  std::vector<std::unique_ptr<Sensor>> sensors;
+  int timerFd = -1;
+};
+
+static uint32_t monotonicMs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)((uint64_t)ts.tv_sec * 1000u + ts.tv_nsec / 1000000);
+}
+
+static uint64_t epochMs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return (uint64_t)ts.tv_sec * 1000u + ts.tv_nsec / 1000000;
+}
+
+static void usage(const char *argv0) {
+  fprintf(stderr,
+          "usage: %s --sensor PATH[@CH][=TAG]... [--mux ADDR]\n"
+          "          [--device D] [--room R] [--site S] [--duration s]\n"
+          "          [--mock] [--mock-noise P]\n",
+          argv0);
+}
+
+static bool parseSensor(const char *arg, SensorSpec &out) {
+  std::string s = arg;
+  const size_t eq = s.find('=');
+  if (eq != std::string::npos) {
+    out.tag = s.substr(eq + 1);
+    s.resize(eq);
+  }
+  const size_t at = s.rfind('@');
+  if (at != std::string::npos) {
+    char *end;
+    const long ch = strtol(s.c_str() + at + 1, &end, 10);
+    if (*end || end == s.c_str() + at + 1 || ch < 0 ||
+        ch >= Tca9548a::CHANNEL_COUNT)
+      return false;
+    out.channel = (int)ch;
+    s.resize(at);
+  }
+  out.path = s;
+  return !s.empty() && s.size() < I2cDevBus::PATH_SIZE;
+}
+
+static bool parseArgs(int argc, char **argv, Options &opt) {
+  for (int i = 1; i < argc; ++i) {
+    const char *a = argv[i];
+    if (!strcmp(a, "--mock")) {
+      opt.mock = true;
+      continue;
+    }
+    const char *v = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!v)
+      return false;
+    ++i;
+    if (!strcmp(a, "--sensor")) {
+      SensorSpec spec;
+      if (!parseSensor(v, spec))
+        return false;
+      opt.sensors.push_back(spec);
+    } else if (!strcmp(a, "--mux")) {
+      opt.muxAddr = (uint8_t)strtol(v, nullptr, 0);
+    } else if (!strcmp(a, "--device")) {
+      opt.device = v;
+    } else if (!strcmp(a, "--room")) {
+      opt.room = v;
+    } else if (!strcmp(a, "--site")) {
+      opt.site = v;
+    } else if (!strcmp(a, "--duration")) {
+      opt.durationS = (uint32_t)atoi(v);
+    } else if (!strcmp(a, "--mock-noise")) {
+      opt.mockNoise = atof(v);
+    } else {
+      return false;
+    }
+  }
+  return !opt.sensors.empty();
+}
+
+static std::string sensorLabel(const SensorSpec &s) {
+  std::string label = s.path;
+  if (s.channel >= 0)
+    label += "@" + std::to_string(s.channel);
+  if (!s.tag.empty())
+    label += " (" + s.tag + ")";
+  return label;
+}
+
+// ===== Setup =====
+
+// Groups the sensors by adapter; a sensor directly on a bus and ones
+// behind a mux there would all answer at 0x6B
+static bool buildAdapters(const Options &opt, I2cDevIo &io,
+                          std::vector<std::unique_ptr<Adapter>> &adapters) {
+  for (const SensorSpec &spec : opt.sensors) {
+    Adapter *a = nullptr;
+    for (std::unique_ptr<Adapter> &candidate : adapters)
+      if (spec.path == candidate->bus.path())
+        a = candidate.get();
+    if (!a) {
+      adapters.emplace_back(new Adapter(spec.path.c_str(), io));
+      a = adapters.back().get();
+      if (spec.channel >= 0)
+        a->mux.reset(new Tca9548a(a->bus, opt.muxAddr));
+    }
+    for (const std::unique_ptr<Sensor> &s : a->sensors) {
+      if ((spec.channel < 0) != (s->spec.channel < 0) ||
+          spec.channel == s->spec.channel) {
+        fprintf(stderr, "%s: clashes with %s at 0x%02X\n",
+                sensorLabel(spec).c_str(), sensorLabel(s->spec).c_str(),
+                Sen66::I2C_ADDR);
+        return false;
+      }
+    }
+    Sen66Bus &bus = a->mux ? a->mux->channel((uint8_t)spec.channel)
+                           : static_cast<Sen66Bus &>(a->bus);
+    a->sensors.emplace_back(new Sensor(bus, spec));
+    if (!a->array.add(a->sensors.back()->sen66)) {
+      fprintf(stderr, "%s: more than %u sensors on one adapter\n",
+              spec.path.c_str(), (unsigned)Sen66Array::MAX_SENSORS);
+      return false;
+    }
+  }
+  return true;
+}
+
+static void buildSeriesKey(const Options &opt, Sensor &s) {
+  const LineProtocolTag tags[] = {{"device", opt.device.c_str()},
+                                  {"room", opt.room.c_str()},
+                                  {"site", opt.site.c_str()},
+                                  {"sensor", s.spec.tag.c_str()}};
+  if (buildSeriesKey(s.seriesKey, sizeof(s.seriesKey), "environment", tags,
+                     4) == 0) {
+    fprintf(stderr, "[Tags] %s: tag set exceeds %u bytes, sending untagged\n",
+            sensorLabel(s.spec).c_str(), (unsigned)SERIES_KEY_SIZE);
+    strcpy(s.seriesKey, "environment");
+  }
+}
+
+static bool startSensor(Sensor &s, uint32_t nowMs) {
+  s.startAttemptMs = nowMs;
+  if (s.sen66.startMeasurement())
+    return true;
+  // Still measuring from an earlier run: stop (1 s) and start again
+  return s.sen66.stopMeasurement() && s.sen66.startMeasurement();
+}
+
+static void setupSensor(const Options &opt, Sensor &s) {
+  buildSeriesKey(opt, s);
+  char serial[33];
+  const bool known = s.sen66.readSerialNumber(serial, sizeof(serial));
+  const bool started = startSensor(s, monotonicMs());
+  fprintf(stderr, "[Sensor] %s: serial %s, %s\n", sensorLabel(s.spec).c_str(),
+          known ? serial : "?",
+          started ? "measuring" : "start failed, retrying");
+}
+
+// ===== Loop =====
+
+static void armTimer(int fd, uint32_t ms) {
+  struct itimerspec t = {};
+  // A zero it_value disarms the timer; 1 ns fires right away
+  t.it_value.tv_sec = ms / 1000;
+  t.it_value.tv_nsec = ms ? (long)(ms % 1000) * 1000000L : 1;
+  timerfd_settime(fd, 0, &t, nullptr);
+}
+
+static void writeLine(Sensor &s, const Sen66Array::Sample &sample,
+                      uint32_t nowMs) {
+  char buf[LINE_SIZE];
+  LineProtocolWriter w(buf, sizeof(buf));
+  s.seq++;
+  encodeEnvironmentFields(w, sample.mv, sample.nc, sample.statusFlags,
+                          s.seriesKey);
+  if (w.fieldCount() == 0)
+    return; // nothing measured yet
+  w.fieldUInt("seq", s.seq);
+  const uint64_t ms = epochMs() - (nowMs - sample.readyMs);
+  w.endLine((uint32_t)(ms / 1000), (uint16_t)(ms % 1000));
+  if (w.overflow())
+    return;
+  fwrite(w.c_str(), 1, w.length(), stdout);
+  s.lines++;
+}
+
+// One timer expiry: starts sensors that aren't running, advances the
+// array and re-arms for its next step
+static void serviceAdapter(Adapter &a) {
+  uint32_t nowMs = monotonicMs();
+  uint32_t waitMs = START_RETRY_MS;
+  for (std::unique_ptr<Sensor> &s : a.sensors) {
+    if (s->sen66.measurementRunning())
+      continue;
+    if (nowMs - s->startAttemptMs >= START_RETRY_MS && startSensor(*s, nowMs))
+      fprintf(stderr, "[Sensor] %s: measuring\n", sensorLabel(s->spec).c_str());
+    nowMs = monotonicMs();
+  }
+  if (a.array.poll(nowMs)) {
+    for (uint8_t i = 0; i < a.array.size(); ++i)
+      if (a.array.newSample(i))
+        writeLine(*a.sensors[i], a.array.sample(i), nowMs);
+    fflush(stdout);
+  }
+  const uint32_t next = a.array.msUntilPoll(monotonicMs());
+  armTimer(a.timerFd, (next < waitMs ? next : waitMs) + TIMER_SLACK_MS);
+}
+
+static int runLoop(const Options &opt,
+                   std::vector<std::unique_ptr<Adapter>> &adapters) {
+  const int ep = epoll_create1(EPOLL_CLOEXEC);
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  sigprocmask(SIG_BLOCK, &signals, nullptr);
+  const int sigFd = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+  if (ep < 0 || sigFd < 0) {
+    perror("epoll/signalfd");
+    return 1;
+  }
+  struct epoll_event ev = {};
+  ev.events = EPOLLIN;
+  ev.data.u64 = SIGNAL_TAG;
+  epoll_ctl(ep, EPOLL_CTL_ADD, sigFd, &ev);
+
+  int durationFd = -1;
+  if (opt.durationS > 0) {
+    durationFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    armTimer(durationFd, opt.durationS * 1000);
+    ev.data.u64 = DURATION_TAG;
+    epoll_ctl(ep, EPOLL_CTL_ADD, durationFd, &ev);
+  }
+  for (size_t i = 0; i < adapters.size(); ++i) {
+    Adapter &a = *adapters[i];
+    a.timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    ev.data.u64 = i;
+    epoll_ctl(ep, EPOLL_CTL_ADD, a.timerFd, &ev);
+    armTimer(a.timerFd, 0);
+  }
+
+  struct epoll_event events[16];
+  for (;;) {
+    const int n = epoll_wait(ep, events, 16, -1);
+    if (n < 0 && errno != EINTR) {
+      perror("epoll_wait");
+      return 1;
+    }
+    for (int e = 0; e < n; ++e) {
+      const uint64_t tag = events[e].data.u64;
+      if (tag == SIGNAL_TAG || tag == DURATION_TAG)
+        return 0;
+      Adapter &a = *adapters[tag];
+      uint64_t expirations;
+      if (read(a.timerFd, &expirations, sizeof(expirations)) > 0)
+        serviceAdapter(a);
+    }
+  }
+}
+
+static void printSummary(const std::vector<std::unique_ptr<Adapter>> &adapters,
+                         double seconds) {
+  fprintf(stderr, "\nGateway, %.1f s\n", seconds);
+  for (const std::unique_ptr<Adapter> &a : adapters) {
+    const I2cDevBus::Stats &st = a->bus.stats();
+    uint32_t lines = 0;
+    for (const std::unique_ptr<Sensor> &s : a->sensors)
+      lines += s->lines;
+    fprintf(stderr,
+            "  %-20s %u ioctls (%u failed), %u combined read + command, "
+            "%u CRC errors, %.2f ms in ioctls/line\n",
+            a->bus.path(), st.ioctls, st.errors, st.messages - st.ioctls,
+            st.corrupt, lines ? st.busUs / 1e3 / lines : 0.0);
+    for (uint8_t i = 0; i < a->sensors.size(); ++i) {
+      const Sensor &s = *a->sensors[i];
+      fprintf(stderr, "    %-18s %u lines, %u errors, %u retries\n",
+              sensorLabel(s.spec).c_str(), s.lines, a->array.errors(i),
+              s.sen66.retries());
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  Options opt;
+  if (!parseArgs(argc, argv, opt)) {
+    usage(argv[0]);
+    return 2;
+  }
+  MockI2c mock;
+  mock.setNoise(opt.mockNoise);
+  I2cDevIo &io = opt.mock ? static_cast<I2cDevIo &>(mock) : kernelI2cDevIo();
+
+  std::vector<std::unique_ptr<Adapter>> adapters;
+  if (!buildAdapters(opt, io, adapters))
+    return 2;
+  for (std::unique_ptr<Adapter> &a : adapters) {
+    if (!a->bus.open()) {
+      fprintf(stderr, "%s: %s\n", a->bus.path(), strerror(errno));
+      return 1;
+    }
+  }
+  for (std::unique_ptr<Adapter> &a : adapters)
+    for (std::unique_ptr<Sensor> &s : a->sensors)
+      setupSensor(opt, *s);
+
+  // The sensors keep measuring after exit; the next start stops them
+  // first (startSensor)
+  const uint32_t startMs = monotonicMs();
+  const int rc = runLoop(opt, adapters);
+  printSummary(adapters, (monotonicMs() - startMs) / 1000.0);
+  if (opt.mock && opt.mockNoise > 0)
+    fprintf(stderr, "  mock noise           %u bits flipped\n",
+            mock.flippedBits());
+  return rc;
+}
@@ -5,9 +5,16 @@
 #include <Adafruit_GFX.h>
 #include <Adafruit_NeoPixel.h>
 #include <Adafruit_SSD1306.h>
+#include <esp_sntp.h>
 #include <math.h>
 #include <stdio.h>
+#include <sys/time.h>
 
+#include "FluxCsv.h"
+#include "Freshness.h"
+#include "Iaq.h"
+#include "RoomTable.h"
+#include "SecureHttp.h"
 #include "config.h"
 
 #ifndef LED_RING_PIN
@@ -49,24 +56,93 @@ constexpr uint8_t OLED_PAGE_COUNT = (OLED_HEIGHT + 7) / 8;
 #endif
 
 static_assert(LED_BRIGHTNESS_MAX >= LED_BRIGHTNESS_MIN, "LED_BRIGHTNESS_MAX must be >= LED_BRIGHTNESS_MIN");
+static_assert(*CONFIG.wifiSsid != '\0', "WIFI_SSID is empty");
+static_assert(configIsHttpUrl(CONFIG.influxUrl) && !configEndsWithSlash(CONFIG.influxUrl),
+              "INFLUXDB_URL must be http(s)://host[:port] without a trailing slash");
+static_assert(*CONFIG.influxBucket && *CONFIG.influxOrg, "INFLUXDB_BUCKET and INFLUXDB_ORG are required");
 constexpr unsigned long IAQ_REFRESH_MS = 30000UL;
 constexpr unsigned long WIFI_RETRY_DELAY_MS = 5000UL;
+// A node's newest line is at most one upload interval old, or a heartbeat
+// when it only reports changes; the lamp sees it up to a refresh later
+static_assert(CONFIG.lampFreshnessMs >=
+                  IAQ_REFRESH_MS + (CONFIG.reportChangeOnly ? CONFIG.reportHeartbeatMs
+                                                            : CONFIG.measurementIntervalMs),
+              "LAMP_FRESHNESS_MS must cover the nodes' upload interval (heartbeat when "
+              "REPORT_CHANGE_ONLY) plus the lamp's 30 s refresh");
 
 Adafruit_NeoPixel ring(LED_RING_COUNT, LED_RING_PIN, NEO_GRB + NEO_KHZ800);
 Adafruit_SSD1306 oled(OLED_WIDTH, OLED_HEIGHT, &Wire, -1);
 bool oledReady = false;
 
-struct LatestFields
-{
-  float pm25 = NAN;
-  float pm10 = NAN;
-  float co2 = NAN;
-  float voc = NAN;
-  float nox = NAN;
-};
+// The query goes out every IAQ_REFRESH_MS: verified against the CA bundle,
+// resuming the previous TLS session instead of a full handshake each time
+SecureHttp secureHttp;
 
 unsigned long lastPoll = 0;
 
+// Multi-room mode (LAMP_MULTI_ROOM): the latest fields of every source in
+// the bucket, refreshed row by row from one grouped query per poll
+RoomTable rooms;
+
+// Single-device mode: the newest sample shown so far
+SampleStamp shownSample;
+
+// ===== Wall clock =====
+// Staleness and latency compare the nodes' acquisition times (the _time
+// of their "seq" field) with SNTP time. Until the first sync both are
+// unknown and nothing is flagged.
+volatile bool clockSynced = false;
+
+int64_t wallClockMs()
+{
+  if (!clockSynced)
+  {
+    return 0;
+  }
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  return static_cast<int64_t>(tv.tv_sec) * 1000 + tv.tv_usec / 1000;
+}
+
+// ===== Telemetry =====
+// Every TELEMETRY_INTERVAL_MS a "telemetry" line tagged device=lamp-<MAC>:
+// acquisition-to-display latency percentiles of the samples first shown
+// in the interval (display_latency_*) and how many polls showed stale data
+#if TELEMETRY_ENABLED
+constexpr unsigned long TELEMETRY_INTERVAL_MS = 300000UL;
+LatencyStats displayLatency;
+uint32_t polls = 0;
+uint32_t stalePolls = 0;
+unsigned long lastTelemetry = 0;
+#endif
+
+// Latency of a sample the lamp shows for the first time
+void recordDisplayLatency(const SampleStamp &s)
+{
+#if TELEMETRY_ENABLED
+  const int64_t now = wallClockMs();
+  if (now > 0 && s.timeMs != 0)
+  {
+    displayLatency.record(now > s.timeMs ? static_cast<uint32_t>(now - s.timeMs) : 0);
+  }
+#else
+  (void)s;
+#endif
+}
+
+void countPoll(Staleness st)
+{
+#if TELEMETRY_ENABLED
+  polls++;
+  if (st == STALENESS_STALE)
+  {
+    stalePolls++;
+  }
+#else
+  (void)st;
+#endif
+}
+
 uint8_t brightnessForActiveLeds(uint8_t activeCount)
 {
   if (LED_BRIGHTNESS_MAX == LED_BRIGHTNESS_MIN)
@@ -99,115 +175,6 @@ void setRingBrightnessForActive(uint8_t activeCount)
   ring.setBrightness(brightnessForActiveLeds(activeCount));
 }
 
-float clampf(float v, float a, float b)
-{
-  return (v < a) ? a : (v > b ? b : v);
-}
-
-float lin(float x, float x0, float x1, float y0, float y1)
-{
-  if (x <= x0)
-    return y0;
-  if (x >= x1)
-    return y1;
-  return y0 + (y1 - y0) * ((x - x0) / (x1 - x0));
-}
-
-float scorePM25(float v)
-{
-  if (!isfinite(v))
-    return NAN;
-  if (v <= 10)
-    return lin(v, 0, 10, 0, 20);
-  if (v <= 25)
-    return lin(v, 10, 25, 20, 50);
-  if (v <= 50)
-    return lin(v, 25, 50, 50, 75);
-  if (v <= 75)
-    return lin(v, 50, 75, 75, 90);
-  return 100;
-}
-
-float scorePM10(float v)
-{
-  if (!isfinite(v))
-    return NAN;
-  if (v <= 20)
-    return lin(v, 0, 20, 0, 20);
-  if (v <= 45)
-    return lin(v, 20, 45, 20, 60);
-  if (v <= 100)
-    return lin(v, 45, 100, 60, 90);
-  return 100;
-}
-
-float scoreCO2(float v)
-{
-  if (!isfinite(v))
-    return NAN;
-  if (v <= 800)
-    return lin(v, 400, 800, 0, 20);
-  if (v <= 1000)
-    return lin(v, 800, 1000, 20, 40);
-  if (v <= 1400)
-    return lin(v, 1000, 1400, 40, 70);
-  if (v <= 2000)
-    return lin(v, 1400, 2000, 70, 90);
-  return 100;
-}
-
-float scoreVOC(float v)
-{
-  if (!isfinite(v))
-    return NAN;
-  if (v <= 100)
-    return 10;
-  if (v <= 200)
-    return lin(v, 100, 200, 10, 60);
-  if (v <= 300)
-    return lin(v, 200, 300, 60, 85);
-  if (v <= 500)
-    return lin(v, 300, 500, 85, 100);
-  return 100;
-}
-
-float scoreNOx(float v)
-{
-  if (!isfinite(v))
-    return NAN;
-  if (v <= 100)
-    return 10;
-  if (v <= 200)
-    return lin(v, 100, 200, 10, 60);
-  if (v <= 300)
-    return lin(v, 200, 300, 60, 85);
-  if (v <= 500)
-    return lin(v, 300, 500, 85, 100);
-  return 100;
-}
-
-float computeIAQ(const LatestFields &f)
-{
-  float worst = NAN;
-  const float scores[] = {
-      scorePM25(f.pm25),
-      scorePM10(f.pm10),
-      scoreCO2(f.co2),
-      scoreVOC(f.voc),
-      scoreNOx(f.nox)};
-  for (float s : scores)
-  {
-    if (isnan(s))
-      continue;
-    worst = isnan(worst) ? s : max(worst, s);
-  }
-  if (isnan(worst))
-  {
-    return NAN;
-  }
-  return clampf(worst, 0, 100);
-}
-
 void showSolid(uint32_t color)
 {
   for (uint16_t i = 0; i < LED_RING_COUNT; ++i)
@@ -277,13 +244,9 @@ void showOledStatus(const String &line1, const String &line2 = String())
   flushOled();
 }
 
-void showWorstFieldOnOled(const LatestFields &fields)
+// Name of the field with the highest sub-score, null if none is available
+const char *worstFieldLabel(const LatestFields &fields)
 {
-  if (!oledReady)
-  {
-    return;
-  }
-
   const char *label = nullptr;
   float score = NAN;
   auto consider = [&](const char *name, float value)
@@ -304,7 +267,53 @@ void showWorstFieldOnOled(const LatestFields &fields)
   consider("CO2", scoreCO2(fields.co2));
   consider("VOC", scoreVOC(fields.voc));
   consider("NOx", scoreNOx(fields.nox));
+  return label;
+}
+
+// "45s", "12m", "3h", "2d"
+void formatAge(char *buf, size_t cap, uint32_t ms)
+{
+  const uint32_t s = ms / 1000;
+  if (s < 60)
+  {
+    snprintf(buf, cap, "%lus", static_cast<unsigned long>(s));
+  }
+  else if (s < 3600)
+  {
+    snprintf(buf, cap, "%lum", static_cast<unsigned long>(s / 60));
+  }
+  else if (s < 86400)
+  {
+    snprintf(buf, cap, "%luh", static_cast<unsigned long>(s / 3600));
+  }
+  else
+  {
+    snprintf(buf, cap, "%lud", static_cast<unsigned long>(s / 86400));
+  }
+}
+
+// Bottom line, only for data past LAMP_FRESHNESS_MS: "old 12m"
+void printStaleOnOled(Staleness st, uint32_t ageMs)
+{
+  if (st != STALENESS_STALE)
+  {
+    return;
+  }
+  char age[8];
+  formatAge(age, sizeof(age), ageMs);
+  oled.setTextSize(1);
+  oled.print("old ");
+  oled.println(age);
+}
+
+void showWorstFieldOnOled(const LatestFields &fields, Staleness st, uint32_t ageMs)
+{
+  if (!oledReady)
+  {
+    return;
+  }
 
+  const char *label = worstFieldLabel(fields);
   oled.clearDisplay();
   oled.setTextColor(SSD1306_WHITE);
   oled.setCursor(0, 0);
@@ -317,6 +326,27 @@ void showWorstFieldOnOled(const LatestFields &fields)
   {
     oled.println("--");
   }
+  printStaleOnOled(st, ageMs);
+  flushOled();
+}
+
+// Worst room: its name on the first line, the field driving it below
+void showWorstRoomOnOled(const RoomEntry &e, Staleness st, uint32_t ageMs)
+{
+  if (!oledReady)
+  {
+    return;
+  }
+
+  const char *label = worstFieldLabel(e.fields);
+  oled.clearDisplay();
+  oled.setTextColor(SSD1306_WHITE);
+  oled.setCursor(0, 0);
+  oled.setTextSize(1);
+  oled.println(e.room[0] ? e.room : e.device);
+  oled.setTextSize(2);
+  oled.println(label ? label : "--");
+  printStaleOnOled(st, ageMs);
   flushOled();
 }
 
@@ -369,7 +399,9 @@ void drawIaqOnOled(float iaq, const LatestFields &fields)
   flushOled();
 }
 
-void displayIAQ(float iaq)
+// Stale data keeps its level on the ring, in grey at the lowest
+// brightness: still readable, but not mistaken for the current air
+void displayIAQ(float iaq, bool stale = false)
 {
   if (isnan(iaq))
   {
@@ -381,16 +413,23 @@ void displayIAQ(float iaq)
   ring.clear();
   for (uint8_t i = 0; i < active && i < LED_RING_COUNT; ++i)
   {
-    ring.setPixelColor(i, colorForSlot(i));
+    ring.setPixelColor(i, stale ? ring.Color(150, 150, 150) : colorForSlot(i));
+  }
+  if (stale)
+  {
+    ring.setBrightness(LED_BRIGHTNESS_MIN);
+  }
+  else
+  {
+    setRingBrightnessForActive(active);
   }
-  setRingBrightnessForActive(active);
   ring.show();
 }
 
 void wifiConnect()
 {
   WiFi.mode(WIFI_STA);
-  WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+  WiFi.begin(CONFIG.wifiSsid, CONFIG.wifiPassword);
   Serial.print("WiFi connecting");
   showOledStatus("WiFi", "Connecting...");
   unsigned long start = millis();
@@ -405,6 +444,13 @@ void wifiConnect()
   {
     Serial.print("WiFi OK, IP: ");
     Serial.println(WiFi.localIP());
+    static bool sntpStarted = false;
+    if (!sntpStarted)
+    {
+      sntpStarted = true;
+      sntp_set_time_sync_notification_cb([](struct timeval *) { clockSynced = true; });
+      configTime(0, 0, CONFIG.ntpServer);
+    }
     showSolid(ring.Color(0, 40, 0));
     showOledStatus("WiFi OK", WiFi.localIP().toString());
     delay(200);
@@ -419,126 +465,23 @@ void wifiConnect()
   }
 }
 
-size_t splitCsvLine(const String &line, String *cols, size_t maxCols)
-{
-  size_t count = 0;
-  int start = 0;
-  for (int i = 0; i <= line.length() && count < maxCols; ++i)
-  {
-    if (i == line.length() || line[i] == ',')
-    {
-      cols[count++] = line.substring(start, i);
-      start = i + 1;
-    }
-  }
-  return count;
-}
-
-bool parseFluxResponse(const String &payload, LatestFields &out)
+// POSTs a Flux query; the CSV response goes to body. Logs and returns
+// false on anything but 200.
+bool postFluxQuery(const String &flux, String &body)
 {
-  bool gotAny = false;
-  int valueIdx = -1;
-  int fieldIdx = -1;
-  int pos = 0;
-
-  while (pos < payload.length())
-  {
-    int next = payload.indexOf('\n', pos);
-    if (next < 0)
-      next = payload.length();
-    String line = payload.substring(pos, next);
-    pos = next + 1;
-    line.trim();
-    if (line.isEmpty() || line[0] == '#')
-    {
-      continue;
-    }
-
-    String cols[12];
-    size_t count = splitCsvLine(line, cols, 12);
-    if (count == 0)
-    {
-      continue;
-    }
-
-    bool isHeader = false;
-    for (size_t i = 0; i < count; ++i)
-    {
-      if (cols[i] == "_field")
-      {
-        fieldIdx = static_cast<int>(i);
-        isHeader = true;
-      }
-      else if (cols[i] == "_value")
-      {
-        valueIdx = static_cast<int>(i);
-        isHeader = true;
-      }
-    }
-    if (isHeader)
-    {
-      continue;
-    }
-
-    if (fieldIdx < 0 || valueIdx < 0 || fieldIdx >= static_cast<int>(count) ||
-        valueIdx >= static_cast<int>(count))
-    {
-      continue;
-    }
-
-    const String &field = cols[fieldIdx];
-    const float value = cols[valueIdx].toFloat();
-    if (field == "pm2_5")
-    {
-      out.pm25 = value;
-      gotAny = true;
-    }
-    else if (field == "pm10")
-    {
-      out.pm10 = value;
-      gotAny = true;
-    }
-    else if (field == "co2")
-    {
-      out.co2 = value;
-      gotAny = true;
-    }
-    else if (field == "voc")
-    {
-      out.voc = value;
-      gotAny = true;
-    }
-    else if (field == "nox")
-    {
-      out.nox = value;
-      gotAny = true;
-    }
-  }
-  return gotAny;
-}
-
-bool fetchLatestFields(LatestFields &fields)
-{
-  String flux = "from(bucket: \"" + String(INFLUXDB_BUCKET) + "\")\n";
-  flux += "  |> range(start: -6h)\n";
-  flux += "  |> filter(fn: (r) => r[\"_measurement\"] == \"environment\")\n";
-  flux += "  |> filter(fn: (r) => r[\"_field\"] == \"pm2_5\" or r[\"_field\"] == \"pm10\" or r[\"_field\"] == \"co2\" or r[\"_field\"] == \"voc\" or r[\"_field\"] == \"nox\")\n";
-  flux += "  |> last()\n";
-  flux += "  |> keep(columns: [\"_field\", \"_value\", \"_time\"])";
-
   HTTPClient http;
-  const String url = String(INFLUXDB_URL) + "/api/v2/query?org=" + INFLUXDB_ORG;
-  if (!http.begin(url))
+  const String url = String(CONFIG.influxUrl) + "/api/v2/query?org=" + CONFIG.influxOrg;
+  if (!secureHttp.begin(http, url))
   {
     Serial.println("HTTP begin failed");
     return false;
   }
-  http.addHeader("Authorization", String("Token ") + INFLUXDB_TOKEN);
+  http.addHeader("Authorization", String("Token ") + CONFIG.influxToken);
   http.addHeader("Accept", "application/csv");
   http.addHeader("Content-Type", "application/vnd.flux");
 
   const int code = http.POST(flux);
-  String body = http.getString();
+  body = http.getString();
   http.end();
 
   if (code != HTTP_CODE_OK)
@@ -551,8 +494,31 @@ bool fetchLatestFields(LatestFields &fields)
     Serial.println("-------------------");
     return false;
   }
+  return true;
+}
 
-  const bool ok = parseFluxResponse(body, fields);
+// The five fields plus "seq", whose _time is the acquisition time of the
+// node's newest line
+bool fetchLatestFields(LatestFields &fields, SampleStamp &stamp)
+{
+  String flux = "from(bucket: \"" + String(CONFIG.influxBucket) + "\")\n";
+  flux += "  |> range(start: -6h)\n";
+  flux += "  |> filter(fn: (r) => r[\"_measurement\"] == \"environment\")\n";
+  // Tag predicate right after the measurement so Influx can resolve it
+  // from the series index instead of scanning every node's data
+  if (CONFIG.lampDevice[0])
+    flux += "  |> filter(fn: (r) => r[\"device\"] == \"" + String(CONFIG.lampDevice) + "\")\n";
+  flux += "  |> filter(fn: (r) => r[\"_field\"] == \"pm2_5\" or r[\"_field\"] == \"pm10\" or r[\"_field\"] == \"co2\" or r[\"_field\"] == \"voc\" or r[\"_field\"] == \"nox\" or r[\"_field\"] == \"seq\")\n";
+  flux += "  |> last()\n";
+  flux += "  |> keep(columns: [\"_field\", \"_value\", \"_time\"])";
+
+  String body;
+  if (!postFluxQuery(flux, body))
+  {
+    return false;
+  }
+
+  const bool ok = parseFluxResponse(body.c_str(), body.length(), fields, stamp);
   if (!ok)
   {
     Serial.println("Influx response parsed but no target fields found:");
@@ -561,6 +527,153 @@ bool fetchLatestFields(LatestFields &fields)
   return ok;
 }
 
+// One row per device/sensor: last() per field series, then the five
+// fields and "seq" pivoted side by side within each source's group.
+// Change-driven nodes stamp fields at different times, so the pivot keys
+// on _start (the same for the whole query) rather than _time; the seq
+// row's _time survives it as one more float field, acquired_ms. The
+// final group() makes it a single table with a single header.
+bool fetchRooms()
+{
+  String flux = "data = from(bucket: \"" + String(CONFIG.influxBucket) + "\")\n";
+  flux += "  |> range(start: -6h)\n";
+  flux += "  |> filter(fn: (r) => r[\"_measurement\"] == \"environment\")\n";
+  if (CONFIG.lampSite[0])
+    flux += "  |> filter(fn: (r) => r[\"site\"] == \"" + String(CONFIG.lampSite) + "\")\n";
+  flux += "  |> filter(fn: (r) => r[\"_field\"] == \"pm2_5\" or r[\"_field\"] == \"pm10\" or r[\"_field\"] == \"co2\" or r[\"_field\"] == \"voc\" or r[\"_field\"] == \"nox\" or r[\"_field\"] == \"seq\")\n";
+  flux += "  |> last()\n";
+  flux += "  |> group(columns: [\"device\", \"sensor\", \"room\"])\n";
+  flux += "acquired = data\n";
+  flux += "  |> filter(fn: (r) => r[\"_field\"] == \"seq\")\n";
+  flux += "  |> map(fn: (r) => ({r with _field: \"acquired_ms\", _value: float(v: int(v: r._time) / 1000000)}))\n";
+  flux += "union(tables: [data, acquired])\n";
+  flux += "  |> group(columns: [\"device\", \"sensor\", \"room\"])\n";
+  flux += "  |> pivot(rowKey: [\"_start\"], columnKey: [\"_field\"], valueColumn: \"_value\")\n";
+  flux += "  |> keep(columns: [\"device\", \"sensor\", \"room\", \"pm2_5\", \"pm10\", \"co2\", \"voc\", \"nox\", \"seq\", \"acquired_ms\"])\n";
+  flux += "  |> group()";
+
+  String body;
+  if (!postFluxQuery(flux, body))
+  {
+    return false;
+  }
+
+  const unsigned long start = micros();
+  rooms.beginUpdate();
+  const size_t rows = parseFluxRooms(body.c_str(), body.length(), rooms);
+  rooms.endUpdate();
+  Serial.printf("Rooms: %u sources, %u bytes, %u updated, parsed in %lu us\n",
+                (unsigned)rows, (unsigned)body.length(),
+                (unsigned)rooms.recomputed(), micros() - start);
+  if (rooms.overflow())
+  {
+    Serial.printf("Rooms: %u sources beyond the %u-entry table ignored\n",
+                  (unsigned)rooms.overflow(), (unsigned)RoomTable::MAX_ENTRIES);
+  }
+  return rows > 0;
+}
+
+void pollRooms()
+{
+  if (!fetchRooms())
+  {
+    Serial.println("Failed to fetch rooms");
+    showSolid(ring.Color(40, 0, 40));
+    return;
+  }
+
+  const int worst = rooms.worst();
+  if (worst < 0)
+  {
+    displayIAQ(NAN);
+    showOledStatus("Rooms", "No data");
+    return;
+  }
+  const int64_t now = wallClockMs();
+  uint8_t stale = 0;
+  for (uint8_t i = 0; i < rooms.size(); ++i)
+  {
+    stale += staleness(rooms.entry(i).stamp, now, CONFIG.lampFreshnessMs) == STALENESS_STALE;
+  }
+  const RoomEntry &e = rooms.entry(static_cast<uint8_t>(worst));
+  uint32_t ageMs = 0;
+  const Staleness st = staleness(e.stamp, now, CONFIG.lampFreshnessMs, &ageMs);
+  char age[8] = "?";
+  if (st != STALENESS_UNKNOWN)
+  {
+    formatAge(age, sizeof(age), ageMs);
+  }
+  Serial.printf("IAQ=%.1f worst of %u: %s (%s%s%s), seq %lu, age %s; %u stale\n",
+                e.iaq, (unsigned)rooms.size(), e.room[0] ? e.room : "-", e.device,
+                e.sensor[0] ? "/" : "", e.sensor, (unsigned long)e.stamp.seq, age,
+                (unsigned)stale);
+  displayIAQ(e.iaq, st == STALENESS_STALE);
+  showWorstRoomOnOled(e, st, ageMs);
+
+  // A source's new sample counts once, in the first poll that has it
+  countPoll(st);
+  for (uint8_t i = 0; i < rooms.size(); ++i)
+  {
+    if (rooms.entry(i).newSample)
+    {
+      recordDisplayLatency(rooms.entry(i).stamp);
+    }
+  }
+}
+
+#if TELEMETRY_ENABLED
+// POSTs line protocol to /api/v2/write; needs a token with write access
+// to the bucket. Returns the HTTP status.
+int postLines(const char *lines, size_t len)
+{
+  HTTPClient http;
+  const String url = String(CONFIG.influxUrl) + "/api/v2/write?org=" + CONFIG.influxOrg +
+                     "&bucket=" + CONFIG.influxBucket + "&precision=s";
+  if (!secureHttp.begin(http, url))
+  {
+    return -1;
+  }
+  http.addHeader("Authorization", String("Token ") + CONFIG.influxToken);
+  http.addHeader("Content-Type", "text/plain; charset=utf-8");
+  const int code = http.POST(reinterpret_cast<uint8_t *>(const_cast<char *>(lines)), len);
+  http.end();
+  return code;
+}
+
+void sendTelemetry()
+{
+  uint8_t mac[6];
+  WiFi.macAddress(mac);
+  char line[320];
+  int len = snprintf(line, sizeof(line),
+                     "telemetry,device=lamp-%02x%02x%02x%02x%02x%02x polls=%lui,stale_polls=%lui",
+                     mac[0], mac[1], mac[2], mac[3], mac[4], mac[5],
+                     (unsigned long)polls, (unsigned long)stalePolls);
+  const uint32_t p50 = displayLatency.percentileMs(50);
+  const uint32_t p99 = displayLatency.percentileMs(99);
+  const size_t fields = displayLatency.formatFields(line + len, sizeof(line) - len, "display_latency");
+  if (fields == 0)
+  {
+    Serial.println("Telemetry: line exceeds buffer");
+    return;
+  }
+  len += fields;
+  Serial.printf("Telemetry: %lu polls (%lu stale), display latency p50 %lu ms, p99 %lu ms\n",
+                (unsigned long)polls, (unsigned long)stalePolls, (unsigned long)p50,
+                (unsigned long)p99);
+  const int code = postLines(line, len);
+  if (code < 200 || code >= 300)
+  {
+    // Counts and latencies carry over into the next interval's line
+    Serial.printf("Telemetry write failed, code=%d\n", code);
+    return;
+  }
+  polls = 0;
+  stalePolls = 0;
+  displayLatency.reset();
+}
+#endif
+
 void setup()
 {
   Serial.begin(115200);
@@ -589,6 +702,16 @@ void setup()
   ring.clear();
   ring.show();
 
+  if (!secureHttp.begin((const uint8_t *)CONFIG.tlsCa, CONFIG.tlsCaSizes, CONFIG.tlsCaCount))
+  {
+    Serial.println("TLS: no usable CA certificate");
+  }
+  secureHttp.onHandshake([](const TlsHandshakeStats &s) {
+    Serial.printf("TLS %s: %s %lu ms, peak heap %lu B, err %d\n", s.host,
+                  s.resumed ? "resumed" : "full", (unsigned long)s.ms,
+                  (unsigned long)s.peakHeap, s.error);
+  });
+
   wifiConnect();
 }
 
@@ -610,8 +733,23 @@ void loop()
   }
   lastPoll = now;
 
+#if TELEMETRY_ENABLED
+  if (now - lastTelemetry >= TELEMETRY_INTERVAL_MS)
+  {
+    lastTelemetry = now;
+    sendTelemetry();
+  }
+#endif
+
+  if (CONFIG.lampMultiRoom)
+  {
+    pollRooms();
+    return;
+  }
+
   LatestFields fields;
-  if (!fetchLatestFields(fields))
+  SampleStamp stamp;
+  if (!fetchLatestFields(fields, stamp))
   {
     Serial.println("Failed to fetch IAQ fields");
     showSolid(ring.Color(40, 0, 40));
@@ -619,8 +757,23 @@ void loop()
   }
 
   const float iaq = computeIAQ(fields);
-  Serial.printf("IAQ=%.1f (pm2.5=%.1f pm10=%.1f co2=%.0f voc=%.1f nox=%.1f)\n",
-                iaq, fields.pm25, fields.pm10, fields.co2, fields.voc, fields.nox);
-  displayIAQ(iaq);
-  showWorstFieldOnOled(fields);
+  uint32_t ageMs = 0;
+  const Staleness st = staleness(stamp, wallClockMs(), CONFIG.lampFreshnessMs, &ageMs);
+  char age[8] = "?";
+  if (st != STALENESS_UNKNOWN)
+  {
+    formatAge(age, sizeof(age), ageMs);
+  }
+  Serial.printf("IAQ=%.1f (pm2.5=%.1f pm10=%.1f co2=%.0f voc=%.1f nox=%.1f), seq %lu, age %s\n",
+                iaq, fields.pm25, fields.pm10, fields.co2, fields.voc, fields.nox,
+                (unsigned long)stamp.seq, age);
+  displayIAQ(iaq, st == STALENESS_STALE);
+  showWorstFieldOnOled(fields, st, ageMs);
+
+  countPoll(st);
+  if (isNewSample(stamp, shownSample))
+  {
+    shownSample = stamp;
+    recordDisplayLatency(stamp);
+  }
 }
@@ -0,0 +1,129 @@
+// src/loadgen/VirtualNode.cpp
+#include "VirtualNode.h"
+
+#include <math.h>
+#include <stdio.h>
+
+namespace Loadgen {
+
+static const char *const SENSOR_TAGS[MAX_SENSORS] = {"a", "b", "c", "d",
+                                                     "e", "f", "g", "h"};
+
+// Rounds to the SEN66's output step
+static float quantize(float value, float step) {
+  return roundf(value / step) * step;
+}
+
+void VirtualNode::begin(uint32_t index, uint8_t sensors, uint32_t heartbeatMs) {
+  _sensors = sensors > MAX_SENSORS ? MAX_SENSORS : sensors;
+  _lcg = 0x9E3779B9u * (index + 1);
+  _lastMs = 0;
+  snprintf(_deviceId, sizeof(_deviceId), "load-%05u", (unsigned)index);
+  char room[16], site[16];
+  snprintf(room, sizeof(room), "room-%u", (unsigned)(index % 40));
+  snprintf(site, sizeof(site), "site-%u", (unsigned)(index / 40));
+
+  LineProtocolTag tags[] = {{"device", _deviceId},
+                            {"room", room},
+                            {"site", site},
+                            {"sensor", nullptr}};
+  for (uint8_t i = 0; i < _sensors; ++i) {
+    tags[3].value = SENSOR_TAGS[i];
+    buildSeriesKey(_keys[i], sizeof(_keys[i]), "environment", tags, 4);
+    _reports[i].begin(heartbeatMs);
+    Room &r = _rooms[i];
+    r.co2 = 420.0f + 200.0f * uniform();
+    r.pm = 3.0f + 6.0f * uniform();
+    r.temperature = 20.0f + 3.0f * uniform();
+    r.humidity = 35.0f + 20.0f * uniform();
+    r.voc = 90.0f + 20.0f * uniform();
+    r.occupied = uniform() < 0.5f;
+    r.spikeUntilMs = 0;
+  }
+}
+
+// Deterministic per node, no libc rand() so runs repeat
+float VirtualNode::uniform() {
+  _lcg = _lcg * 1664525u + 1013904223u;
+  return (float)(_lcg >> 8) / 16777216.0f;
+}
+
+void VirtualNode::step(Room &r, uint32_t tMs, float dtS) {
+  // People come and go about twice an hour; CO2 follows with ~15 min
+  if (uniform() < dtS / 1800.0f)
+    r.occupied = !r.occupied;
+  const float co2Target = r.occupied ? 950.0f : 430.0f;
+  r.co2 += (co2Target - r.co2) * (1.0f - expf(-dtS / 900.0f)) +
+           (uniform() - 0.5f) * 8.0f;
+  // A cooking or dusting spike every few hours, ten minutes long
+  if (tMs >= r.spikeUntilMs && uniform() < dtS / 10800.0f)
+    r.spikeUntilMs = tMs + 600000;
+  const float pmTarget = tMs < r.spikeUntilMs ? 60.0f : 5.0f;
+  r.pm += (pmTarget - r.pm) * (1.0f - expf(-dtS / 120.0f)) +
+          (uniform() - 0.5f) * 0.6f;
+  if (r.pm < 0.0f)
+    r.pm = 0.0f;
+  r.temperature += (uniform() - 0.5f) * 0.02f * dtS / 20.0f;
+  r.humidity += (uniform() - 0.5f) * 0.1f * dtS / 20.0f;
+  r.voc += (100.0f - r.voc) * 0.01f + (uniform() - 0.5f) * 2.0f;
+}
+
+void VirtualNode::sample(const Room &r, Sen66Protocol::MeasuredValues &mv,
+                         Sen66Protocol::NumberConcentration &nc) {
+  const float pm = r.pm + (uniform() - 0.5f) * 0.4f;
+  mv.pm1_0 = quantize(pm * 0.7f, 0.1f);
+  mv.pm2_5 = quantize(pm, 0.1f);
+  mv.pm4_0 = quantize(pm * 1.1f, 0.1f);
+  mv.pm10_0 = quantize(pm * 1.15f, 0.1f);
+  mv.humidity_rh = quantize(r.humidity + (uniform() - 0.5f) * 0.08f, 0.01f);
+  mv.temperature_c =
+      quantize(r.temperature + (uniform() - 0.5f) * 0.04f, 0.005f);
+  mv.voc_index = quantize(r.voc, 1.0f);
+  mv.nox_index = 1.0f;
+  mv.co2_ppm = quantize(r.co2, 1.0f);
+  mv.hcho_ppb = NAN;
+  nc.nc0_5 = quantize(pm * 5.2f, 0.1f);
+  nc.nc1_0 = quantize(pm * 6.1f, 0.1f);
+  nc.nc2_5 = quantize(pm * 6.2f, 0.1f);
+  nc.nc4_0 = quantize(pm * 6.2f, 0.1f);
+  nc.nc10_0 = quantize(pm * 6.2f, 0.1f);
+}
+
+uint32_t VirtualNode::encodeUpload(LineProtocolWriter &w, uint32_t tMs,
+                                   bool changeOnly,
+                                   uint32_t (*toEpochSeconds)(uint32_t)) {
+  const float dtS = _lastMs == 0 ? 1.0f : (tMs - _lastMs) / 1000.0f;
+  _lastMs = tMs;
+  const size_t before = w.length();
+  // The node's sample number: one sample a second since it started
+  const uint32_t seq = tMs / 1000 + 1;
+  for (uint8_t i = 0; i < _sensors; ++i) {
+    step(_rooms[i], tMs, dtS);
+    Sen66Protocol::MeasuredValues mv;
+    Sen66Protocol::NumberConcentration nc;
+    sample(_rooms[i], mv, nc);
+    if (changeOnly) {
+      _reports[i].encode(w, _keys[i], tMs, seq, mv, nc, true, 0,
+                         toEpochSeconds);
+    } else {
+      encodeEnvironmentFields(w, mv, nc, 0, _keys[i]);
+      w.fieldUInt("seq", seq);
+      w.endLine(toEpochSeconds(tMs));
+    }
+  }
+  uint32_t lines = 0;
+  for (size_t p = before; p < w.length(); ++p)
+    lines += w.c_str()[p] == '\n';
+  return lines;
+}
+
+void VirtualNode::uploaded(bool accepted) {
+  for (uint8_t i = 0; i < _sensors; ++i) {
+    if (accepted)
+      _reports[i].commit();
+    else
+      _reports[i].rollback();
+  }
+}
+
+} // namespace Loadgen
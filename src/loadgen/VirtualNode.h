@@ -0,0 +1,62 @@
+// src/loadgen/VirtualNode.h
+#pragma once
+#include <stdint.h>
+
+#include "EnvironmentReport.h"
+#include "LineProtocol.h"
+
+namespace Loadgen {
+
+static constexpr uint8_t MAX_SENSORS = 8;
+// Same as the node's SERIES_KEY_SIZE (src/sen66/main.cpp)
+static constexpr size_t SERIES_KEY_SIZE = 160;
+
+/*
+  One emulated sensor node: its tags, series keys and a synthetic room
+  per sensor (CO2 following occupancy, PM with cooking spikes, slow T/RH
+  drift, all at the SEN66's output resolution), deterministic per index.
+  encodeUpload() writes the environment lines of one sendToInflux() call
+  with the firmware's own encoders: full snapshots, or the change-driven
+  lines (lib/LineProtocol/EnvironmentReport.h) it sends once its clock is
+  set.
+*/
+class VirtualNode {
+public:
+  VirtualNode() {}
+  void begin(uint32_t index, uint8_t sensors, uint32_t heartbeatMs);
+
+  // Lines for an upload at tMs (ms since the fleet started); returns the
+  // number of lines written
+  uint32_t encodeUpload(LineProtocolWriter &w, uint32_t tMs, bool changeOnly,
+                        uint32_t (*toEpochSeconds)(uint32_t));
+  // Result of that upload, as the node's change-driven state sees it
+  void uploaded(bool accepted);
+
+  uint8_t sensors() const { return _sensors; }
+
+private:
+  struct Room {
+    float co2;
+    float pm;
+    float temperature;
+    float humidity;
+    float voc;
+    bool occupied;
+    uint32_t spikeUntilMs;
+  };
+
+  float uniform();
+  void step(Room &r, uint32_t tMs, float dtS);
+  void sample(const Room &r, Sen66Protocol::MeasuredValues &mv,
+              Sen66Protocol::NumberConcentration &nc);
+
+  uint8_t _sensors = 0;
+  uint32_t _lcg = 0;
+  uint32_t _lastMs = 0;
+  char _deviceId[24];
+  char _keys[MAX_SENSORS][SERIES_KEY_SIZE];
+  Room _rooms[MAX_SENSORS];
+  EnvironmentReport _reports[MAX_SENSORS];
+};
+
+} // namespace Loadgen
@@ -0,0 +1,104 @@
+// src/loadgen/WriteSink.cpp
+#include "WriteSink.h"
+
+#include <chrono>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+#include "../bridge/HttpIo.h"
+
+namespace Loadgen {
+
+static constexpr size_t MAX_BODY = 1024 * 1024;
+static const char WRITE_PATH[] = "/api/v2/write";
+
+bool WriteSink::start(const std::string &address, unsigned threads,
+                      uint32_t ingestUsPerPoint) {
+  _fd = Bridge::listenOn(address);
+  if (_fd < 0)
+    return false;
+  struct sockaddr_storage addr;
+  socklen_t len = sizeof(addr);
+  if (getsockname(_fd, (struct sockaddr *)&addr, &len) == 0)
+    _port = ntohs(addr.ss_family == AF_INET6
+                      ? ((struct sockaddr_in6 *)&addr)->sin6_port
+                      : ((struct sockaddr_in *)&addr)->sin_port);
+  _ingestUs = ingestUsPerPoint;
+  for (unsigned i = 0; i < threads; ++i)
+    std::thread(&WriteSink::serve, this).detach();
+  return true;
+}
+
+std::string WriteSink::url() const {
+  return "http://127.0.0.1:" + std::to_string(_port);
+}
+
+WriteSink::Stats WriteSink::stats() {
+  std::lock_guard<std::mutex> guard(_lock);
+  return _stats;
+}
+
+// Lines and fields of a line-protocol body (no escaped spaces or commas
+// in the fields, as the node writes them)
+static void countPoints(const std::string &body, uint64_t &points,
+                        uint64_t &fields) {
+  size_t pos = 0;
+  while (pos < body.size()) {
+    size_t end = body.find('\n', pos);
+    if (end == std::string::npos)
+      end = body.size();
+    const size_t fieldsAt = body.find(' ', pos);
+    if (fieldsAt < end) {
+      points++;
+      fields++;
+      for (size_t i = fieldsAt + 1; i < end && body[i] != ' '; ++i)
+        fields += body[i] == ',';
+    }
+    pos = end + 1;
+  }
+}
+
+void WriteSink::serve() {
+  for (;;) {
+    const int fd = accept(_fd, nullptr, nullptr);
+    if (fd < 0)
+      continue;
+    const auto start = std::chrono::steady_clock::now();
+    Bridge::HttpRequest req;
+    const bool ok = Bridge::readRequest(fd, req, MAX_BODY) &&
+                    req.method == "POST" &&
+                    req.target.compare(0, sizeof(WRITE_PATH) - 1,
+                                       WRITE_PATH) == 0;
+    uint64_t points = 0, fields = 0;
+    if (ok) {
+      countPoints(req.body, points, fields);
+      if (_ingestUs > 0)
+        std::this_thread::sleep_for(
+            std::chrono::microseconds(_ingestUs * points));
+      Bridge::writeResponse(fd, 204, "No Content", "");
+    } else {
+      Bridge::writeResponse(fd, 400, "Bad Request", "bad request\n");
+    }
+    close(fd);
+    const double busy = std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+
+    std::lock_guard<std::mutex> guard(_lock);
+    _stats.busyS += busy;
+    if (!ok) {
+      _stats.rejected++;
+      continue;
+    }
+    _stats.requests++;
+    _stats.points += points;
+    _stats.fields += fields;
+    _stats.bodyBytes += req.body.size();
+    _stats.bodySizes.push_back((uint32_t)req.body.size());
+  }
+}
+
+} // namespace Loadgen
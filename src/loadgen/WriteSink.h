@@ -0,0 +1,48 @@
+// src/loadgen/WriteSink.h
+#pragma once
+#include <stdint.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Loadgen {
+
+/*
+  Stand-in for InfluxDB's /api/v2/write: accepts line protocol on a few
+  threads, answers 204 and records what arrived. It parses nothing beyond
+  counting lines and fields, so what the harness measures is the node
+  side and the HTTP exchange; --ingest-us adds a per-point service time
+  to emulate a loaded database.
+*/
+class WriteSink {
+public:
+  struct Stats {
+    uint64_t requests = 0;
+    uint64_t rejected = 0; // not a POST to /api/v2/write
+    uint64_t points = 0;   // lines
+    uint64_t fields = 0;
+    uint64_t bodyBytes = 0;
+    double busyS = 0.0; // summed over threads, incl. --ingest-us
+    std::vector<uint32_t> bodySizes;
+  };
+
+  // Listens on address ("host:port", port 0 for any) with `threads`
+  // accept loops that run until the process exits; false (errno set) if
+  // the socket can't be opened
+  bool start(const std::string &address, unsigned threads,
+             uint32_t ingestUsPerPoint);
+  // "http://127.0.0.1:<port>"
+  std::string url() const;
+  Stats stats();
+
+private:
+  void serve();
+
+  int _fd = -1;
+  uint16_t _port = 0;
+  uint32_t _ingestUs = 0;
+  std::mutex _lock;
+  Stats _stats;
+};
+
+} // namespace Loadgen
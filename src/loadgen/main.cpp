@@ -0,0 +1,394 @@
+// src/loadgen/main.cpp
+//
+// Fleet load harness: N virtual sensor nodes write their environment
+// lines, built by the firmware's own encoders (VirtualNode.h), to
+// /api/v2/write at the node's cadence, and the run reports what an
+// ingest path has to absorb.
+//
+//   pio run -e native_loadgen
+//   .pio/build/native_loadgen/program --nodes 500 --duration 120
+//
+// Options:
+//   --nodes N            virtual nodes (default 100)
+//   --sensors S          SEN66 per node, 1..8 (default 1)
+//   --interval s[,s..]   upload interval, nodes take them in turn
+//                        (default 20, MEASUREMENT_INTERVAL_MS)
+//   --mode change|snapshot
+//                        change-driven lines as with a set clock
+//                        (default) or a full line per sensor and upload
+//   --heartbeat s        REPORT_HEARTBEAT_MS for change mode (default 300)
+//   --duration s         run time (default 60)
+//   --connections C      concurrent writers (default 16)
+//   --target url         InfluxDB (or anything speaking /api/v2/write),
+//                        http:// only; default: a built-in stand-in
+//   --token T --bucket B --org O
+//                        passed on to --target (default: test, air, home)
+//   --sink-threads T     stand-in accept threads (default 4)
+//   --ingest-us U        stand-in service time per point (default 0)
+//   --report s           progress line interval (default 10)
+//
+// Nodes start spread over their interval, as a fleet powered up at
+// different times would. Each write is a fresh connection, as the
+// node's HTTPClient makes it. Latency is the client's view: connect to
+// the end of the response. Lag is how late a write started against its
+// schedule; a p99 lag near the interval means the harness (--connections)
+// or the target could not keep up, not that the nodes would queue.
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../bridge/HttpIo.h"
+#include "VirtualNode.h"
+#include "WriteSink.h"
+
+typedef std::chrono::steady_clock Clock;
+
+// Two change-driven lines per sensor at most, as sendToInflux sizes it
+static constexpr size_t BODY_SIZE = 2 * 512 * Loadgen::MAX_SENSORS;
+// Wall time of the first write; lines carry epoch seconds
+static uint32_t fleetEpoch = 0;
+
+struct Options {
+  uint32_t nodes = 100;
+  uint8_t sensors = 1;
+  std::vector<uint32_t> intervalsMs = {20000};
+  bool changeOnly = true;
+  uint32_t heartbeatMs = 300000;
+  uint32_t durationS = 60;
+  unsigned connections = 16;
+  std::string target;
+  std::string token = "test";
+  std::string bucket = "air";
+  std::string org = "home";
+  unsigned sinkThreads = 4;
+  uint32_t ingestUs = 0;
+  uint32_t reportS = 10;
+};
+
+struct Due {
+  uint32_t atMs; // since start
+  uint32_t node;
+  bool operator>(const Due &o) const { return atMs > o.atMs; }
+};
+
+struct WorkerStats {
+  std::vector<float> latencyMs;
+  std::vector<float> lagMs;
+  uint64_t failed = 0;
+  uint64_t points = 0;
+  uint64_t bytes = 0;
+};
+
+struct Run {
+  Options opt;
+  Bridge::HttpUrl url;
+  std::string path;
+  std::vector<Loadgen::VirtualNode> nodes;
+  Clock::time_point start;
+  std::mutex lock;
+  std::condition_variable wake;
+  std::priority_queue<Due, std::vector<Due>, std::greater<Due>> schedule;
+  bool stop = false;
+  std::atomic<uint64_t> writes{0};
+  std::atomic<uint64_t> failed{0};
+  std::atomic<uint64_t> points{0};
+  std::atomic<uint64_t> bytes{0};
+};
+
+static uint32_t epochSeconds(uint32_t monoMs) {
+  return fleetEpoch + monoMs / 1000;
+}
+
+static uint32_t sinceStartMs(const Run &run) {
+  return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+             Clock::now() - run.start)
+      .count();
+}
+
+static void usage(const char *argv0) {
+  fprintf(stderr,
+          "usage: %s [--nodes N] [--sensors S] [--interval s[,s..]]\n"
+          "          [--mode change|snapshot] [--heartbeat s] [--duration s]\n"
+          "          [--connections C] [--target url] [--token T]\n"
+          "          [--bucket B] [--org O] [--sink-threads T]\n"
+          "          [--ingest-us U] [--report s]\n",
+          argv0);
+}
+
+static bool parseIntervals(const char *arg, std::vector<uint32_t> &out) {
+  out.clear();
+  for (const char *p = arg; *p;) {
+    char *end;
+    const double s = strtod(p, &end);
+    if (end == p || s <= 0.0)
+      return false;
+    out.push_back((uint32_t)(s * 1000.0));
+    p = *end == ',' ? end + 1 : end;
+    if (*end && *end != ',')
+      return false;
+  }
+  return !out.empty();
+}
+
+static bool parseArgs(int argc, char **argv, Options &opt) {
+  for (int i = 1; i < argc; ++i) {
+    const char *a = argv[i];
+    const char *v = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!v)
+      return false;
+    ++i;
+    if (!strcmp(a, "--nodes")) {
+      opt.nodes = (uint32_t)atoi(v);
+    } else if (!strcmp(a, "--sensors")) {
+      const int s = atoi(v);
+      if (s < 1 || s > Loadgen::MAX_SENSORS)
+        return false;
+      opt.sensors = (uint8_t)s;
+    } else if (!strcmp(a, "--interval")) {
+      if (!parseIntervals(v, opt.intervalsMs))
+        return false;
+    } else if (!strcmp(a, "--mode")) {
+      if (strcmp(v, "change") && strcmp(v, "snapshot"))
+        return false;
+      opt.changeOnly = !strcmp(v, "change");
+    } else if (!strcmp(a, "--heartbeat")) {
+      opt.heartbeatMs = (uint32_t)(atof(v) * 1000.0);
+    } else if (!strcmp(a, "--duration")) {
+      opt.durationS = (uint32_t)atoi(v);
+    } else if (!strcmp(a, "--connections")) {
+      opt.connections = (unsigned)std::max(1, atoi(v));
+    } else if (!strcmp(a, "--target")) {
+      opt.target = v;
+    } else if (!strcmp(a, "--token")) {
+      opt.token = v;
+    } else if (!strcmp(a, "--bucket")) {
+      opt.bucket = v;
+    } else if (!strcmp(a, "--org")) {
+      opt.org = v;
+    } else if (!strcmp(a, "--sink-threads")) {
+      opt.sinkThreads = (unsigned)std::max(1, atoi(v));
+    } else if (!strcmp(a, "--ingest-us")) {
+      opt.ingestUs = (uint32_t)atoi(v);
+    } else if (!strcmp(a, "--report")) {
+      opt.reportS = (uint32_t)std::max(1, atoi(v));
+    } else {
+      return false;
+    }
+  }
+  return opt.nodes > 0 && opt.durationS > 0;
+}
+
+// One writer: takes the next due node, builds its upload and POSTs it
+static void writer(Run &run, WorkerStats &stats) {
+  static thread_local char body[BODY_SIZE];
+  const uint32_t endMs = run.opt.durationS * 1000;
+  std::string response;
+  for (;;) {
+    Due due;
+    {
+      std::unique_lock<std::mutex> guard(run.lock);
+      for (;;) {
+        if (run.stop)
+          return;
+        if (!run.schedule.empty()) {
+          const uint32_t now = sinceStartMs(run);
+          if (run.schedule.top().atMs <= now)
+            break;
+          run.wake.wait_for(guard, std::chrono::milliseconds(
+                                       run.schedule.top().atMs - now));
+        } else {
+          run.wake.wait(guard);
+        }
+      }
+      due = run.schedule.top();
+      run.schedule.pop();
+    }
+
+    const uint32_t startMs = sinceStartMs(run);
+    LineProtocolWriter w(body, sizeof(body));
+    const uint32_t lines = run.nodes[due.node].encodeUpload(
+        w, due.atMs, run.opt.changeOnly, epochSeconds);
+    // Nothing left the deadband: the node skips the request
+    if (lines > 0) {
+      const auto t0 = Clock::now();
+      const int code = Bridge::httpPost(
+          run.url, run.path, "Token " + run.opt.token,
+          "text/plain; charset=utf-8", std::string(w.c_str(), w.length()),
+          response);
+      const float ms =
+          std::chrono::duration<float, std::milli>(Clock::now() - t0).count();
+      stats.latencyMs.push_back(ms);
+      stats.lagMs.push_back((float)(startMs - due.atMs));
+      run.writes++;
+      const bool accepted = code >= 200 && code < 300;
+      run.nodes[due.node].uploaded(accepted);
+      if (!accepted) {
+        stats.failed++;
+        run.failed++;
+      } else {
+        stats.points += lines;
+        stats.bytes += w.length();
+        run.points += lines;
+        run.bytes += w.length();
+      }
+    } else {
+      run.nodes[due.node].uploaded(true);
+    }
+
+    const uint32_t interval =
+        run.opt.intervalsMs[due.node % run.opt.intervalsMs.size()];
+    if (due.atMs + interval < endMs) {
+      std::lock_guard<std::mutex> guard(run.lock);
+      run.schedule.push({due.atMs + interval, due.node});
+      run.wake.notify_one();
+    }
+  }
+}
+
+// Value at quantile q of an unsorted sample (sorts it)
+static float quantile(std::vector<float> &v, double q) {
+  if (v.empty())
+    return 0.0f;
+  std::sort(v.begin(), v.end());
+  return v[std::min(v.size() - 1, (size_t)(q * v.size()))];
+}
+
+static uint32_t quantile(std::vector<uint32_t> &v, double q) {
+  if (v.empty())
+    return 0;
+  std::sort(v.begin(), v.end());
+  return v[std::min(v.size() - 1, (size_t)(q * v.size()))];
+}
+
+int main(int argc, char **argv) {
+  Options opt;
+  if (!parseArgs(argc, argv, opt)) {
+    usage(argv[0]);
+    return 2;
+  }
+  signal(SIGPIPE, SIG_IGN);
+
+  Run run;
+  run.opt = opt;
+  Loadgen::WriteSink sink;
+  std::string target = opt.target;
+  if (target.empty()) {
+    if (!sink.start("127.0.0.1:0", opt.sinkThreads, opt.ingestUs)) {
+      perror("stand-in listen");
+      return 1;
+    }
+    target = sink.url();
+  }
+  if (!Bridge::parseUrl(target, run.url)) {
+    fprintf(stderr, "--target must be http://host[:port][/path]\n");
+    return 2;
+  }
+  run.path = "/api/v2/write?bucket=" + opt.bucket + "&org=" + opt.org +
+             "&precision=s";
+
+  run.nodes.resize(opt.nodes);
+  for (uint32_t i = 0; i < opt.nodes; ++i) {
+    run.nodes[i].begin(i, opt.sensors, opt.heartbeatMs);
+    // Spread the first uploads over the node's interval
+    const uint32_t interval = opt.intervalsMs[i % opt.intervalsMs.size()];
+    run.schedule.push({(uint32_t)((uint64_t)interval * i / opt.nodes), i});
+  }
+  fleetEpoch = (uint32_t)time(nullptr);
+
+  printf("[Load] %u nodes x %u sensor(s), %s lines, interval", opt.nodes,
+         opt.sensors, opt.changeOnly ? "change-driven" : "snapshot");
+  for (size_t i = 0; i < opt.intervalsMs.size(); ++i)
+    printf("%s%.0f", i ? "," : " ", opt.intervalsMs[i] / 1000.0);
+  printf(" s, %u connections -> %s%s\n", opt.connections, target.c_str(),
+         opt.target.empty() ? " (stand-in)" : "");
+  fflush(stdout);
+
+  run.start = Clock::now();
+  std::vector<WorkerStats> stats(opt.connections);
+  std::vector<std::thread> writers;
+  for (unsigned i = 0; i < opt.connections; ++i)
+    writers.emplace_back(writer, std::ref(run), std::ref(stats[i]));
+
+  uint64_t lastPoints = 0;
+  for (uint32_t s = opt.reportS; s <= opt.durationS; s += opt.reportS) {
+    std::this_thread::sleep_until(run.start + std::chrono::seconds(s));
+    const uint64_t points = run.points;
+    printf("[Load] %4us: %llu writes (%llu failed), %llu points, "
+           "%.1f points/s\n",
+           (unsigned)s, (unsigned long long)run.writes.load(),
+           (unsigned long long)run.failed.load(), (unsigned long long)points,
+           (double)(points - lastPoints) / opt.reportS);
+    fflush(stdout);
+    lastPoints = points;
+  }
+  std::this_thread::sleep_until(run.start +
+                                std::chrono::seconds(opt.durationS));
+  {
+    std::lock_guard<std::mutex> guard(run.lock);
+    run.stop = true;
+    run.wake.notify_all();
+  }
+  for (std::thread &t : writers)
+    t.join();
+  const double elapsedS =
+      std::chrono::duration<double>(Clock::now() - run.start).count();
+
+  WorkerStats all;
+  for (const WorkerStats &s : stats) {
+    all.latencyMs.insert(all.latencyMs.end(), s.latencyMs.begin(),
+                         s.latencyMs.end());
+    all.lagMs.insert(all.lagMs.end(), s.lagMs.begin(), s.lagMs.end());
+    all.failed += s.failed;
+    all.points += s.points;
+    all.bytes += s.bytes;
+  }
+  const uint64_t writes = all.latencyMs.size();
+
+  printf("\nWrites\n");
+  printf("  requests            %llu (%llu failed), %.1f/s\n",
+         (unsigned long long)writes, (unsigned long long)all.failed,
+         writes / elapsedS);
+  printf("  points              %llu, %.1f/s (%.2f per node and minute)\n",
+         (unsigned long long)all.points, all.points / elapsedS,
+         all.points / elapsedS * 60.0 / opt.nodes);
+  printf("  body bytes          %llu, %.1f KiB/s, %.1f bytes/point\n",
+         (unsigned long long)all.bytes, all.bytes / elapsedS / 1024.0,
+         all.points ? (double)all.bytes / all.points : 0.0);
+  const float maxLatency = quantile(all.latencyMs, 1.0);
+  printf("  latency             p50 %.2f ms, p99 %.2f ms, max %.2f ms\n",
+         quantile(all.latencyMs, 0.5), quantile(all.latencyMs, 0.99),
+         maxLatency);
+  printf("  schedule lag        p50 %.0f ms, p99 %.0f ms\n",
+         quantile(all.lagMs, 0.5), quantile(all.lagMs, 0.99));
+
+  if (opt.target.empty()) {
+    Loadgen::WriteSink::Stats sinkStats = sink.stats();
+    printf("Stand-in\n");
+    printf("  writes              %llu (%llu rejected)\n",
+           (unsigned long long)sinkStats.requests,
+           (unsigned long long)sinkStats.rejected);
+    printf("  points              %llu, %llu fields (%.1f per point)\n",
+           (unsigned long long)sinkStats.points,
+           (unsigned long long)sinkStats.fields,
+           sinkStats.points ? (double)sinkStats.fields / sinkStats.points
+                            : 0.0);
+    printf("  payload             p50 %u bytes, p99 %u bytes\n",
+           quantile(sinkStats.bodySizes, 0.5),
+           quantile(sinkStats.bodySizes, 0.99));
+    printf("  busy                %.1f%% of %u threads\n",
+           100.0 * sinkStats.busyS / (elapsedS * opt.sinkThreads),
+           opt.sinkThreads);
+  }
+  return all.failed > 0 ? 1 : 0;
+}
@@ -1,20 +1,341 @@
 // src/main.cpp
+#include "EnvironmentLine.h"
+#include "EnvironmentReport.h"
+#include "EventDetector.h"
+#include "HeapGuard.h"
+#include "History.h"
+#include "LineProtocol.h"
 #include "Sen66.h"
+#include "Sen66Array.h"
+#include "Sen66WireBus.h"
+#include "SyncedClock.h"
+#include "Telemetry.h"
 #include "config.h"
 #include <Arduino.h>
-#include <ArduinoJson.h>
-#include <ArduinoOTA.h>
-#include <HTTPClient.h>
+#include <Preferences.h>
 #include <WiFi.h>
 #include <Wire.h>
+#include <atomic>
+#include <esp_sntp.h>
 #include <math.h>
+#include <stdarg.h>
+#include <strings.h>
+#include <sys/time.h>
+#include <time.h>
+#if DELTA_OTA_ENABLED
+#include "DeltaPatch.h"
+#include "DeltaStream.h"
+#include <Update.h>
+#include <WebServer.h>
+#include <esp_ota_ops.h>
+#include <esp_partition.h>
+#endif
+#if RAW_CAPTURE_ENABLED
+#include "RawLog.h"
+#endif
+#if EXPOSURE_ENABLED
+#include "ExposureDose.h"
+#endif
+#if INFLUX_ENABLED
+#include "SecureHttp.h"
+#endif
+#if UPLINK_BINARY
+#include "UplinkBatch.h"
+#endif
+#if WEATHER_ENABLED
+#include "Arena.h"
+#include <ArduinoJson.h>
+#endif
+#if OTA_ENABLED
+#include <ArduinoOTA.h>
+#endif
 
-Sen66 sen66(Wire);
+// ===== Configuration checks =====
+// CONFIG and the module switches come from .env (scripts/gen_config.py)
+static_assert(*CONFIG.wifiSsid != '\0', "WIFI_SSID is empty");
+static_assert(CONFIG.sensorCount >= 1 &&
+                  CONFIG.sensorCount <= CONFIG_MAX_SENSORS,
+              "SEN66_SENSORS: 1 to 8 sensors");
+static_assert(CONFIG.measurementIntervalMs >= 1000,
+              "MEASUREMENT_INTERVAL_MS must be at least 1000");
+static_assert(!CONFIG.reportChangeOnly ||
+                  CONFIG.reportHeartbeatMs >= CONFIG.measurementIntervalMs,
+              "REPORT_HEARTBEAT_MS must not be shorter than "
+              "MEASUREMENT_INTERVAL_MS");
+static_assert((!OTA_ENABLED && !DELTA_OTA_ENABLED) || *CONFIG.otaPassword,
+              "OTA_PASSWORD is empty");
+#if INFLUX_ENABLED
+static_assert(configIsHttpUrl(CONFIG.influxUrl) &&
+                  !configEndsWithSlash(CONFIG.influxUrl),
+              "INFLUXDB_URL must be http(s)://host[:port] without a "
+              "trailing slash");
+static_assert(*CONFIG.influxBucket && *CONFIG.influxOrg,
+              "INFLUXDB_BUCKET and INFLUXDB_ORG are required");
+#else
+// Each of these only produces uploads
+static_assert(!WEATHER_ENABLED, "WEATHER_ENABLED requires INFLUX_ENABLED");
+static_assert(!UPLINK_BINARY, "UPLINK_BRIDGE_URL requires INFLUX_ENABLED");
+static_assert(!TELEMETRY_ENABLED, "TELEMETRY_ENABLED requires INFLUX_ENABLED");
+static_assert(!EXPOSURE_ENABLED, "EXPOSURE_ENABLED requires INFLUX_ENABLED");
+// A new image is confirmed by its first upload
+static_assert(!DELTA_OTA_ENABLED, "DELTA_OTA_ENABLED requires INFLUX_ENABLED");
+#endif
+#if UPLINK_BINARY
+static_assert(configIsHttpUrl(CONFIG.uplinkBridgeUrl) &&
+                  !configEndsWithSlash(CONFIG.uplinkBridgeUrl),
+              "UPLINK_BRIDGE_URL must be http(s)://host[:port] without a "
+              "trailing slash");
+// The batch schema is the SEN66's 14 channels, without History::CH_HCHO
+static_assert(!Sen66Protocol::BuildModel::HAS_HCHO,
+              "UPLINK_BRIDGE_URL cannot carry the SEN68's HCHO");
+#endif
+#if VENTILATION_ENABLED
+static_assert(CONFIG.ventilationCo2Drop > 0,
+              "VENTILATION_CO2_DROP_THRESHOLD must be positive");
+static_assert(CONFIG.ventilationWindow >= 1 &&
+                  CONFIG.ventilationWindow <= UINT16_MAX,
+              "VENTILATION_WINDOW_SIZE must be 1 to 65535 samples");
+#endif
+#if EXPOSURE_ENABLED
+static_assert(*CONFIG.timezone, "TIMEZONE is empty");
+#endif
+#if WEATHER_ENABLED
+static_assert(*CONFIG.weatherLatitude && *CONFIG.weatherLongitude,
+              "WEATHER_LATITUDE and WEATHER_LONGITUDE are required");
+#endif
+
+// ===== Logging =====
+// Serial.printf() mallocs a buffer for every line of 64 characters or
+// more; lines are formatted into a static one instead (and cut at 255).
+static char logBuffer[256];
+
+static void logPrintf(const char *fmt, ...)
+    __attribute__((format(printf, 1, 2)));
+static void logPrintf(const char *fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  const int n = vsnprintf(logBuffer, sizeof(logBuffer), fmt, args);
+  va_end(args);
+  if (n > 0)
+    Serial.write((const uint8_t *)logBuffer,
+                 (size_t)n < sizeof(logBuffer) ? (size_t)n
+                                               : sizeof(logBuffer) - 1);
+}
+
+// ===== Sensors =====
+// Layout from SEN66_SENSORS (CONFIG.sensors): each SEN66 sits on Wire or
+// Wire1, either directly or behind a TCA9548A channel.
+// Wire1 keeps the core's default pins (and has no bus clear) unless
+// SEN66_I2C1_SDA/SEN66_I2C1_SCL are defined
+#ifndef SEN66_I2C1_SDA
+#define SEN66_I2C1_SDA -1
+#define SEN66_I2C1_SCL -1
+#endif
+
+Sen66WireBus i2cBus0(Wire, SEN66_I2C_SDA, SEN66_I2C_SCL);
+Sen66WireBus i2cBus1(Wire1, SEN66_I2C1_SDA, SEN66_I2C1_SCL);
+Tca9548a mux0(i2cBus0);
+Tca9548a mux1(i2cBus1);
+Sen66WireBus *const i2cBuses[2] = {&i2cBus0, &i2cBus1};
+Tca9548a *const muxes[2] = {&mux0, &mux1};
+Sen66Array sensors;
+
+// A sensor that does not start (after Sen66's own retries) is tried
+// again with exponential backoff, so a missing one costs little bus time
+static constexpr unsigned long SENSOR_START_BACKOFF_MIN_MS = 1000;
+static constexpr unsigned long SENSOR_START_BACKOFF_MAX_MS = 60000;
 
 unsigned long lastSend = 0;
-unsigned long lastFanCleaning = 0;
+
+// ===== Wall clock =====
+// Samples are stamped with millis() when data-ready reports them and
+// converted through wallClock (SNTP anchored, drift corrected) when they
+// are written, at second precision, the coarsest Influx accepts. Until
+// the first sync lines go out without a timestamp, so Influx stamps them
+// on arrival, and carry time_unsynced=1; change-driven reporting needs
+// real timestamps and falls back to full snapshots meanwhile.
+SyncedClock wallClock;
+bool clockStarted = false;
+// Set by the SNTP task, applied from loop()
+volatile bool timeSyncPending = false;
+uint32_t timeSyncMonoMs = 0;
+int64_t timeSyncEpochMs = 0;
+
+static void onTimeSync(struct timeval *tv) {
+  timeSyncMonoMs = millis();
+  timeSyncEpochMs = (int64_t)tv->tv_sec * 1000 + tv->tv_usec / 1000;
+  timeSyncPending = true;
+}
+
+static void applyTimeSync() {
+  if (!timeSyncPending)
+    return;
+  const int32_t offset = wallClock.sync(timeSyncMonoMs, timeSyncEpochMs);
+  timeSyncPending = false;
+  if (wallClock.syncs() == 1)
+    Serial.println("[Time] SNTP synchronized");
+  else
+    logPrintf("[Time] SNTP sync: off by %ld ms, drift %.2f ppm\n",
+              (long)offset, wallClock.driftPpm());
+}
+
+static bool clockValid() { return wallClock.synced(); }
+
+#if INFLUX_ENABLED
+// Ends an environment/weather line stamped with monoMs, or marks it
+static void endStampedLine(LineProtocolWriter &w, uint32_t monoMs) {
+  if (clockValid()) {
+    w.endLine(wallClock.toEpochSeconds(monoMs));
+  } else {
+    w.field("time_unsynced", (int32_t)1);
+    w.endLine();
+  }
+}
+
+// ===== HTTPS =====
+// Every request goes through secureHttp: https URLs are verified against
+// the CA bundle from TLS_CA_FILES and resume the host's last TLS session.
+SecureHttp secureHttp;
+
+static void onTlsHandshake(const TlsHandshakeStats &s) {
+  if (s.error) {
+    // Counted against full handshakes; whether it would have resumed is moot
+    logPrintf("[TLS] %s: handshake failed after %lu ms (-0x%04x)\n",
+              s.host, (unsigned long)s.ms, (unsigned)-s.error);
+    TELEMETRY_ERROR(Telemetry::STAGE_TLS_FULL);
+    return;
+  }
+  logPrintf("[TLS] %s: %s handshake %lu ms, peak heap %lu B\n", s.host,
+            s.resumed ? "resumed" : "full", (unsigned long)s.ms,
+            (unsigned long)s.peakHeap);
+  TELEMETRY_RECORD(s.resumed ? Telemetry::STAGE_TLS_RESUMED
+                             : Telemetry::STAGE_TLS_FULL,
+                   s.ms * 1000);
+}
+
+// ===== Request URLs and headers =====
+// Formatted once from CONFIG in setup(), into buffers sized for it at
+// compile time: an upload builds no String. All writes use precision=s;
+// lines without a timestamp are stamped by the server either way.
+static const char INFLUX_WRITE_URL[] =
+    "%s/api/v2/write?bucket=%s&org=%s&precision=s";
+static const char INFLUX_HEADERS[] =
+    "Authorization: Token %s\r\nContent-Type: text/plain; charset=utf-8\r\n";
+char influxWriteUrl[sizeof(INFLUX_WRITE_URL) + configLength(CONFIG.influxUrl) +
+                    configLength(CONFIG.influxBucket) +
+                    configLength(CONFIG.influxOrg)];
+char influxHeaders[sizeof(INFLUX_HEADERS) + configLength(CONFIG.influxToken)];
+#if UPLINK_BINARY
+static const char UPLINK_URL[] = "%s/sen66/v1/batch?bucket=%s&org=%s";
+static const char UPLINK_HEADERS[] =
+    "Authorization: Token %s\r\nContent-Type: application/octet-stream\r\n";
+char uplinkUrl[sizeof(UPLINK_URL) + configLength(CONFIG.uplinkBridgeUrl) +
+               configLength(CONFIG.influxBucket) + configLength(CONFIG.influxOrg)];
+char uplinkHeaders[sizeof(UPLINK_HEADERS) + configLength(CONFIG.influxToken)];
+#endif
+#if WEATHER_ENABLED
+static const char WEATHER_URL[] =
+    "https://api.open-meteo.com/v1/forecast?latitude=%s&longitude=%s"
+    "&current=temperature_2m,relative_humidity_2m,pressure_msl,"
+    "wind_speed_10m,wind_direction_10m,weather_code,cloud_cover";
+static const char AQI_URL[] =
+    "https://air-quality-api.open-meteo.com/v1/air-quality?latitude=%s"
+    "&longitude=%s&current=pm10,pm2_5,carbon_monoxide,nitrogen_dioxide,"
+    "sulphur_dioxide,ozone,european_aqi,us_aqi";
+static constexpr size_t LOCATION_LENGTH =
+    configLength(CONFIG.weatherLatitude) + configLength(CONFIG.weatherLongitude);
+char weatherUrl[sizeof(WEATHER_URL) + LOCATION_LENGTH];
+char aqiUrl[sizeof(AQI_URL) + LOCATION_LENGTH];
+#endif
+
+static void formatRequestTargets() {
+  snprintf(influxWriteUrl, sizeof(influxWriteUrl), INFLUX_WRITE_URL,
+           CONFIG.influxUrl, CONFIG.influxBucket, CONFIG.influxOrg);
+  snprintf(influxHeaders, sizeof(influxHeaders), INFLUX_HEADERS,
+           CONFIG.influxToken);
+#if UPLINK_BINARY
+  snprintf(uplinkUrl, sizeof(uplinkUrl), UPLINK_URL, CONFIG.uplinkBridgeUrl,
+           CONFIG.influxBucket, CONFIG.influxOrg);
+  snprintf(uplinkHeaders, sizeof(uplinkHeaders), UPLINK_HEADERS,
+           CONFIG.influxToken);
+#endif
+#if WEATHER_ENABLED
+  snprintf(weatherUrl, sizeof(weatherUrl), WEATHER_URL,
+           CONFIG.weatherLatitude, CONFIG.weatherLongitude);
+  snprintf(aqiUrl, sizeof(aqiUrl), AQI_URL, CONFIG.weatherLatitude,
+           CONFIG.weatherLongitude);
+#endif
+}
+#endif
+
+// ===== Boot timing =====
+// Both are millis() since power-on, 0 until the milestone is reached.
+unsigned long bootFirstSampleMs = 0;
+unsigned long bootFirstUploadMs = 0;
+// Fan cleaning no longer runs in setup(); it is started once after the
+// first upload attempt (the first sample without INFLUX_ENABLED) so it
+// doesn't delay time-to-first-sample, and only for sensors whose last
+// cleaning is CONFIG.fanCleaningIntervalMs ago. That takes the wall
+// clock: without one after BOOT_FAN_CLEANING_CLOCK_WAIT_MS they clean.
+bool bootFanCleaningPending = true;
+static constexpr unsigned long BOOT_FAN_CLEANING_CLOCK_WAIT_MS = 300000;
+bool otaReady = false;
+
+// ===== WiFi fast reconnect cache (NVS) =====
+// Last AP (BSSID/channel), so a reboot or a lost link can skip the scan.
+// The address always comes from DHCP: a cached lease would outlive its
+// expiry on the server and could clash with another host. Falls back to a
+// normal connect if the cache is stale.
+struct WifiCache {
+  uint32_t magic;
+  char ssid[33];
+  uint8_t bssid[6];
+  int32_t channel;
+};
+
+static constexpr uint32_t WIFI_CACHE_MAGIC = 0x57434132; // "WCA2"
+
+Preferences prefs;
+WifiCache wifiCache;
+bool wifiCacheValid = false;
+
+// ===== WiFi connection manager =====
+// Nothing waits for the radio. The driver reports link changes through
+// WiFi.onEvent() from its own task; the handler only flags them, and
+// serviceWifi() acts on them from loop():
+//
+//   CONNECTING  an attempt is under way: the cached BSSID/channel first
+//               (fast path), a full scan if that fails; DHCP either way
+//   UP          uploads go ahead, see wifiUp()
+//   WAITING     the next attempt starts after an exponential backoff
+//               with jitter, so nodes that lost the same AP spread out
+//
+// A lost link is retried at once on the fast path; a failed attempt is
+// retried with a scan after the backoff. This replaces the driver's own
+// auto-reconnect, which is off. Attempts and outages are counted in
+// telemetry (wifi_connect, wifi_outage).
+enum WifiState : uint8_t { WIFI_CONNECTING, WIFI_UP, WIFI_WAITING };
+
+static constexpr unsigned long WIFI_FAST_CONNECT_TIMEOUT_MS = 4000;
+static constexpr unsigned long WIFI_CONNECT_TIMEOUT_MS = 20000;
+static constexpr unsigned long WIFI_BACKOFF_MIN_MS = 1000;
+static constexpr unsigned long WIFI_BACKOFF_MAX_MS = 60000;
+
+WifiState wifiState = WIFI_WAITING;
+// Set by the WiFi event task, taken with exchange() by serviceWifi() so an
+// event landing between the read and the clear is not lost
+std::atomic<bool> wifiGotIpEvent(false);
+std::atomic<bool> wifiLostEvent(false);
+bool wifiLostPending = false;    // lost while status() still read connected
+bool wifiFastPath = false;
+unsigned long wifiBeginAt = 0;
+unsigned long wifiBackoffMs = 0; // 0 until an attempt has failed
+unsigned long wifiWaitMs = 0;    // backoff plus jitter
+unsigned long wifiLostAt = 0;
+bool wifiOutage = false;         // the link was up and is lost
 
 // ===== External Weather Data Structure =====
+#if WEATHER_ENABLED
 struct WeatherData {
   float temperature;
   float humidity;
@@ -37,88 +358,460 @@ struct WeatherData {
 
 WeatherData lastWeatherData;
 const unsigned long WEATHER_CACHE_MS = 300000; // 5 minutes cache
+#endif
 
-class VentilationDetector {
-public:
-  void addSample(float co2) {
-    if (isnan(co2))
-      return;
+#if TELEMETRY_ENABLED
+const unsigned long TELEMETRY_INTERVAL_MS = 300000; // 5 minutes
+unsigned long lastTelemetry = 0;
+#endif
 
-    // Shift history
-    for (int i = VENTILATION_WINDOW_SIZE - 1; i > 0; i--) {
-      history[i] = history[i - 1];
-    }
-    history[0] = co2;
+// ===== Event detectors =====
+// Streaming detectors per sensor (lib/Events), fed every sample. Each
+// event goes out as an "events" line tagged with its type, stamped with
+// its start: once when it starts and again, with its end, when it ends
+// (Influx merges the two into one point). Ventilation also triggers fan
+// cleaning. The defaults below are overridden per type from NVS
+// (namespace "detectors", key = type), set through the diagnostics
+// server (POST /detectors/<type>?k=..., see below). Without
+// VENTILATION_ENABLED the ventilation detector and its fan cleaning are
+// left out.
+enum DetectorIndex : uint8_t {
+#if VENTILATION_ENABLED
+  DETECTOR_VENTILATION,
+#endif
+  DETECTOR_COOKING,
+  DETECTOR_OCCUPANCY,
+  DETECTOR_VOC_BURST,
+  DETECTOR_COUNT
+};
 
-    if (count < VENTILATION_WINDOW_SIZE) {
-      count++;
-    }
+// {alpha, k, h, hold, window, enabled}; samples are 1 s apart
+static const Events::Config DETECTOR_DEFAULTS[DETECTOR_COUNT] = {
+#if VENTILATION_ENABLED
+    // CO2 drop from its recent peak, as the old fixed-window detector
+    {"ventilation", ENV_CO2, Events::KIND_PEAK_DROP,
+     {0.0f, 20.0f, CONFIG.ventilationCo2Drop, 120, CONFIG.ventilationWindow,
+      1, {}}},
+#endif
+    // PM2.5 above a 10 min baseline
+    {"cooking", ENV_PM2_5, Events::KIND_LEVEL_RISE,
+     {1.0f / 600, 3.0f, 15.0f, 120, 0, 1, {}}},
+    // CO2 rising faster than 5 ppm/min
+    {"occupancy", ENV_CO2, Events::KIND_SLOPE_RISE,
+     {0.05f, 5.0f, 120.0f, 300, 0, 1, {}}},
+    // VOC index well above its 10 min baseline
+    {"voc_burst", ENV_VOC, Events::KIND_LEVEL_RISE,
+     {1.0f / 600, 50.0f, 300.0f, 60, 0, 1, {}}},
+};
 
-    // Update peak value (highest CO2 seen recently)
-    if (co2 > peakValue) {
-      peakValue = co2;
-      peakAge = 0;
-    } else {
-      peakAge++;
-    }
+// Effective settings: defaults with the NVS overrides applied
+Events::Config detectorConfig[DETECTOR_COUNT];
+bool detectorFromNvs[DETECTOR_COUNT];
 
-    // Reset peak if it's too old (no longer "recent")
-    if (peakAge >= VENTILATION_WINDOW_SIZE) {
-      peakValue = co2;
-      peakAge = 0;
-    }
+// Why a detector of this kind cannot run with p, nullptr if it can. A
+// window of 0 would drop the peak every sample, so the ventilation
+// detector never fired.
+static const char *detectorParamsError(Events::Kind kind,
+                                       const Events::Params &p) {
+  if (kind != Events::KIND_PEAK_DROP && !(p.alpha > 0.0f && p.alpha < 1.0f))
+    return "alpha must be in (0, 1)\n";
+  if (!isfinite(p.k) || !isfinite(p.h))
+    return "k and h must be finite\n";
+  if (p.hold < 1)
+    return "hold must be 1 to 65535 samples\n";
+  if (kind == Events::KIND_PEAK_DROP && p.window < 1)
+    return "window must be 1 to 65535 samples\n";
+  return nullptr;
+}
+
+static void loadDetectorConfig() {
+  prefs.begin("detectors", true);
+  for (uint8_t d = 0; d < DETECTOR_COUNT; ++d) {
+    detectorConfig[d] = DETECTOR_DEFAULTS[d];
+    Events::Params p;
+    // Overrides stored by older firmware may not pass today's checks
+    detectorFromNvs[d] =
+        prefs.getBytes(DETECTOR_DEFAULTS[d].type, &p, sizeof(p)) == sizeof(p) &&
+        !detectorParamsError(DETECTOR_DEFAULTS[d].kind, p);
+    if (detectorFromNvs[d])
+      detectorConfig[d].params = p;
   }
+  prefs.end();
+}
 
-  bool isVentilationDetected() {
-    if (count < 2)
-      return false;
+// Stores (or with null, forgets) detector d's override
+static void saveDetectorParams(uint8_t d, const Events::Params *p) {
+  prefs.begin("detectors", false);
+  if (p)
+    prefs.putBytes(DETECTOR_DEFAULTS[d].type, p, sizeof(*p));
+  else
+    prefs.remove(DETECTOR_DEFAULTS[d].type);
+  prefs.end();
+  detectorFromNvs[d] = p != nullptr;
+}
 
-    // Calculate drop from recent peak to current value
-    float drop = peakValue - history[0];
-    if (drop >= VENTILATION_CO2_DROP_THRESHOLD) {
-      Serial.printf(
-          "Ventilation Detected! Drop: %.0f ppm (Peak: %.0f -> Curr: %.0f)\n",
-          drop, peakValue, history[0]);
-      // Reset peak to prevent multiple triggers for same ventilation event
-      peakValue = history[0];
-      peakAge = 0;
-      return true;
-    }
-    return false;
+#if INFLUX_ENABLED
+// Events waiting for the next environment upload: the detectors' and the
+// fan cleanings
+struct PendingEvent {
+  uint8_t sensor;
+  const char *type;
+  int8_t digits; // of the magnitude
+  Events::Event event;
+};
+static constexpr uint8_t EVENT_QUEUE_SIZE = 8;
+PendingEvent eventQueue[EVENT_QUEUE_SIZE];
+uint8_t eventQueueLen = 0;
+
+static void queueEvent(uint8_t sensor, const char *type, int8_t digits,
+                       const Events::Event &e) {
+  if (eventQueueLen == EVENT_QUEUE_SIZE) {
+    // Uploads are failing: keep the newest
+    memmove(eventQueue, eventQueue + 1,
+            (EVENT_QUEUE_SIZE - 1) * sizeof(PendingEvent));
+    eventQueueLen--;
   }
+  eventQueue[eventQueueLen++] = {sensor, type, digits, e};
+}
 
-private:
-  float history[VENTILATION_WINDOW_SIZE];
-  int count = 0;
-  float peakValue = 0;
-  int peakAge = 0;
+// ===== Series keys =====
+// "measurement,<sorted tags>" rendered once in setup() (buildSeriesKeys)
+static constexpr size_t SERIES_KEY_SIZE = 160;
+
+char deviceId[33];
+#if WEATHER_ENABLED
+char weatherSeriesKey[SERIES_KEY_SIZE];
+#endif
+#if TELEMETRY_ENABLED
+char telemetrySeriesKey[SERIES_KEY_SIZE];
+#endif
+#endif
+
+// Per-sensor state; allocated once in setup()
+struct SensorNode {
+  SensorNode(Sen66Bus &bus, const char *tag) : sen66(bus), tag(tag) {}
+
+  Sen66 sen66;
+  const char *tag;
+  Events::Pipeline events;
+#if VENTILATION_ENABLED
+  unsigned long lastFanCleaning = 0;
+#endif
+  // A fan cleaning under way: the measurement was stopped at
+  // cleaningSince, the fan starts STOP_EXEC_TIME_MS later (fanRunning,
+  // cleaningSince restarted) and the sensor is idle until
+  // FAN_CLEANING_TIME_MS after that, see serviceFanCleaning()
+  const char *cleaningReason = nullptr;
+  unsigned long cleaningSince = 0;
+  bool fanRunning = false;
+#if INFLUX_ENABLED
+  char environmentKey[SERIES_KEY_SIZE];
+  EnvironmentReport report; // change-driven lines (REPORT_CHANGE_ONLY)
+#endif
+#if EXPOSURE_ENABLED
+  Exposure::Accumulator exposure;
+  Exposure::Totals finishedDay = {}; // while exposureFinishedDay is set
+  char exposureDayKey[SERIES_KEY_SIZE];
+  char exposureHourKey[SERIES_KEY_SIZE];
+#endif
+  History::Store *history = nullptr; // null if the allocation failed
+  unsigned long sampleMs = 0;         // readyMs of the newest sample
+  uint32_t seq = 0; // its number, counted from 1 at boot; "seq" on the lines
+  unsigned long startAttemptMs = 0;
+  unsigned long startBackoffMs = 0; // 0 while running
 };
 
-VentilationDetector ventilationDetector;
+SensorNode *sensorNodes[CONFIG.sensorCount];
+
+// ===== I2C health =====
+// Per bus and clock step: transfers, errors, absent devices and bus time
+// per sample (see Sen66WireBus.h), bus clears, and each sensor's command
+// retries. Logged hourly and served as GET /i2c on the diagnostics port.
+static const char *const I2C_BUS_NAMES[2] = {"Wire", "Wire1"};
+bool i2cBusUsed[2] = {false, false};
+uint32_t i2cLoggedClock[2] = {0, 0};
+// A line per bus and clock step, bus clears, and one per sensor
+static constexpr size_t I2C_STATS_SIZE =
+    (2 * (Sen66WireBus::SPEED_COUNT + 1) + CONFIG.sensorCount) * 144;
 
-static void wifiConnect() {
+static size_t formatI2cStats(char *buf, size_t cap) {
+  size_t len = 0;
+  for (uint8_t b = 0; b < 2; ++b) {
+    if (!i2cBusUsed[b])
+      continue;
+    const Sen66WireBus &bus = *i2cBuses[b];
+    for (uint8_t sp = 0; sp < Sen66WireBus::SPEED_COUNT && len < cap; ++sp) {
+      const Sen66WireBus::SpeedStats &st = bus.stats(sp);
+      if (st.transactions == 0 && sp != bus.speed())
+        continue;
+      len += snprintf(buf + len, cap - len,
+                      "%s %lu kHz%s: %lu samples, %.2f ms bus/sample, %lu "
+                      "transfers, %lu errors, %lu absent, %lu CRC\n",
+                      I2C_BUS_NAMES[b],
+                      (unsigned long)(Sen66WireBus::SPEEDS[sp] / 1000),
+                      sp == bus.speed() ? " (now)" : "",
+                      (unsigned long)st.samples,
+                      st.samples ? st.busUs / 1000.0 / st.samples : 0.0,
+                      (unsigned long)st.transactions,
+                      (unsigned long)st.errors, (unsigned long)st.absent,
+                      (unsigned long)st.corrupt);
+    }
+    if (len < cap)
+      len += snprintf(buf + len, cap - len,
+                      "%s bus clears: %lu, %lu left SDA low\n",
+                      I2C_BUS_NAMES[b], (unsigned long)bus.recoveries(),
+                      (unsigned long)bus.failedClears());
+  }
+  for (uint8_t i = 0; i < CONFIG.sensorCount && len < cap; ++i) {
+    const Sen66 &sen66 = sensorNodes[i]->sen66;
+    len += snprintf(buf + len, cap - len,
+                    "%s: %lu command retries, %lu failed commands\n",
+                    *sensorNodes[i]->tag ? sensorNodes[i]->tag : "SEN66",
+                    (unsigned long)sen66.retries(),
+                    (unsigned long)sen66.failures());
+  }
+  return len < cap ? len : cap - 1;
+}
+
+static void reportI2c() {
+  char buf[I2C_STATS_SIZE];
+  formatI2cStats(buf, sizeof(buf));
+  for (char *line = strtok(buf, "\n"); line; line = strtok(nullptr, "\n"))
+    logPrintf("[I2C] %s\n", line);
+}
+
+// Logs clock steps as they happen
+static void logI2cClock() {
+  for (uint8_t b = 0; b < 2; ++b) {
+    if (!i2cBusUsed[b] || i2cBuses[b]->clock() == i2cLoggedClock[b])
+      continue;
+    if (i2cLoggedClock[b] != 0)
+      logPrintf("[I2C] %s clock %lu -> %lu kHz\n", I2C_BUS_NAMES[b],
+                (unsigned long)(i2cLoggedClock[b] / 1000),
+                (unsigned long)(i2cBuses[b]->clock() / 1000));
+    i2cLoggedClock[b] = i2cBuses[b]->clock();
+  }
+}
+
+// ===== Sample history =====
+// Full-resolution 1 Hz history per sensor (lib/History). A day of one
+// sensor compresses to ~1.1 MB (noisy air; a quiet room is far smaller),
+// so 24 h needs PSRAM. Without it 8 blocks in internal RAM hold 40 min to
+// a few hours.
+static constexpr size_t HISTORY_BLOCKS_PSRAM = 330; // ~24 h
+static constexpr size_t HISTORY_PSRAM_BUDGET = 4 * 1024 * 1024; // all sensors
+static constexpr size_t HISTORY_BLOCKS_RAM = 8;
+static constexpr unsigned long HISTORY_REPORT_INTERVAL_MS = 3600000;
+unsigned long lastHistoryReport = 0;
+
+static History::Store *allocateHistory() {
+  size_t blocks = HISTORY_BLOCKS_RAM;
+  void *storage = nullptr;
+#if defined(BOARD_HAS_PSRAM)
+  if (psramFound()) {
+    blocks = HISTORY_PSRAM_BUDGET /
+             (History::Store::bytesFor(1) * CONFIG.sensorCount);
+    if (blocks > HISTORY_BLOCKS_PSRAM)
+      blocks = HISTORY_BLOCKS_PSRAM;
+    storage = ps_malloc(History::Store::bytesFor(blocks));
+  }
+#endif
+  if (!storage) {
+    blocks = HISTORY_BLOCKS_RAM;
+    storage = malloc(History::Store::bytesFor(blocks));
+  }
+  if (!storage)
+    return nullptr;
+  return new History::Store(storage, History::Store::bytesFor(blocks));
+}
+
+static void loadWifiCache() {
+  prefs.begin("wifi", true);
+  const size_t len = prefs.getBytes("cache", &wifiCache, sizeof(wifiCache));
+  prefs.end();
+  wifiCacheValid = len == sizeof(wifiCache) &&
+                   wifiCache.magic == WIFI_CACHE_MAGIC &&
+                   strncmp(wifiCache.ssid, CONFIG.wifiSsid, sizeof(wifiCache.ssid)) == 0;
+}
+
+static void saveWifiCache() {
+  WifiCache c = {};
+  c.magic = WIFI_CACHE_MAGIC;
+  strncpy(c.ssid, CONFIG.wifiSsid, sizeof(c.ssid) - 1);
+  memcpy(c.bssid, WiFi.BSSID(), sizeof(c.bssid));
+  c.channel = WiFi.channel();
+
+  // Only write on change to spare the flash
+  if (wifiCacheValid && memcmp(&c, &wifiCache, sizeof(c)) == 0)
+    return;
+  HEAP_GUARD_TRANSIENT(); // NVS handle and page cache
+  prefs.begin("wifi", false);
+  prefs.putBytes("cache", &c, sizeof(c));
+  prefs.end();
+  wifiCache = c;
+  wifiCacheValid = true;
+}
+
+static void onWifiEvent(arduino_event_id_t event) {
+  if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP)
+    wifiGotIpEvent = true;
+  else if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED)
+    wifiLostEvent = true;
+}
+
+// Starts association without waiting for it.
+static void wifiBegin(bool useCache) {
+  HEAP_GUARD_TRANSIENT(); // driver configuration, per attempt
   WiFi.mode(WIFI_STA);
-  WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-  Serial.print("WiFi connecting");
-  unsigned long t0 = millis();
-  while (WiFi.status() != WL_CONNECTED) {
-    Serial.print(".");
-    delay(400);
-    if (millis() - t0 > 20000)
-      break;
+  wifiFastPath = useCache && wifiCacheValid;
+  // Only this attempt's outcome counts
+  wifiGotIpEvent.store(false);
+  wifiLostEvent.store(false);
+  wifiLostPending = false;
+  if (wifiFastPath)
+    WiFi.begin(CONFIG.wifiSsid, CONFIG.wifiPassword, wifiCache.channel, wifiCache.bssid);
+  else
+    WiFi.begin(CONFIG.wifiSsid, CONFIG.wifiPassword);
+  wifiState = WIFI_CONNECTING;
+  wifiBeginAt = millis();
+}
+
+static void setupWifi() {
+  WiFi.mode(WIFI_STA);
+  WiFi.setAutoReconnect(false);
+  WiFi.onEvent(onWifiEvent);
+  wifiBegin(true);
+}
+
+#if INFLUX_ENABLED
+// Non-blocking: true while the link is up
+static bool wifiUp() { return wifiState == WIFI_UP; }
+#endif
+
+#if OTA_ENABLED
+static void setupOTA();
+#endif
+#if DELTA_OTA_ENABLED
+static void setupDeltaOta();
+#endif
+static void setupDiagServer();
+
+static void onWifiConnected() {
+  const uint32_t ip = (uint32_t)WiFi.localIP();
+  logPrintf("WiFi OK (%s), IP: %u.%u.%u.%u, after %lu ms\n",
+            wifiFastPath ? "cached" : "scan", (unsigned)(ip & 0xFF),
+            (unsigned)((ip >> 8) & 0xFF), (unsigned)((ip >> 16) & 0xFF),
+            (unsigned)(ip >> 24), millis() - wifiBeginAt);
+  saveWifiCache();
+  // The first link starts SNTP and the LAN services, once
+  HEAP_GUARD_TRANSIENT();
+  if (!clockStarted) {
+    sntp_set_time_sync_notification_cb(onTimeSync);
+    configTime(0, 0, CONFIG.ntpServer);
+    clockStarted = true;
   }
-  Serial.println();
-  if (WiFi.status() == WL_CONNECTED) {
-    Serial.print("WiFi OK, IP: ");
-    Serial.println(WiFi.localIP());
-  } else {
-    Serial.println("WiFi FAILED");
+  if (!otaReady) {
+#if OTA_ENABLED
+    setupOTA();
+#endif
+#if DELTA_OTA_ENABLED
+    setupDeltaOta();
+#endif
+    setupDiagServer();
+    otaReady = true;
+  }
+}
+
+static void wifiAttemptFailed() {
+  TELEMETRY_ERROR(Telemetry::STAGE_WIFI_CONNECT);
+  {
+    HEAP_GUARD_TRANSIENT();
+    WiFi.disconnect();
+  }
+  if (wifiFastPath) {
+    // The cached AP may be gone or have moved; scan right away
+    Serial.println("WiFi cached connect failed, scanning");
+    wifiBegin(false);
+    return;
   }
+  wifiBackoffMs = wifiBackoffMs == 0 ? WIFI_BACKOFF_MIN_MS : wifiBackoffMs * 2;
+  if (wifiBackoffMs > WIFI_BACKOFF_MAX_MS)
+    wifiBackoffMs = WIFI_BACKOFF_MAX_MS;
+  wifiWaitMs = wifiBackoffMs / 2 + random(wifiBackoffMs / 2 + 1);
+  wifiState = WIFI_WAITING;
+  wifiBeginAt = millis();
+  logPrintf("WiFi FAILED, next try in %lu ms\n", wifiWaitMs);
 }
 
+// The link is up, from an attempt or (late) while waiting for the next one
+static void wifiLinkUp() {
+  wifiState = WIFI_UP;
+  wifiBackoffMs = 0;
+  wifiLostPending = false;
+  if (wifiOutage) {
+    const unsigned long outageMs = millis() - wifiLostAt;
+    TELEMETRY_RECORD(Telemetry::STAGE_WIFI_OUTAGE,
+                     outageMs < UINT32_MAX / 1000 ? outageMs * 1000UL
+                                                  : UINT32_MAX);
+    logPrintf("WiFi back after %lu ms\n", outageMs);
+    wifiOutage = false;
+  }
+  onWifiConnected();
+}
+
+// Runs the connection manager; called every loop(), never blocks
+static void serviceWifi() {
+  const bool gotIp = wifiGotIpEvent.exchange(false);
+  const bool lost = wifiLostEvent.exchange(false);
+  const unsigned long elapsed = millis() - wifiBeginAt;
+
+  // The events can run ahead of status(): an address is kept until
+  // status() reads connected, a loss until it stops reading connected or a
+  // new address says the link came back
+  const bool connected = WiFi.status() == WL_CONNECTED;
+  if (gotIp && !connected && !lost && wifiState == WIFI_CONNECTING)
+    wifiGotIpEvent.store(true);
+
+  switch (wifiState) {
+  case WIFI_CONNECTING:
+    if (gotIp && connected) {
+      TELEMETRY_RECORD(Telemetry::STAGE_WIFI_CONNECT, elapsed * 1000UL);
+      wifiLinkUp();
+      wifiLostPending = lost;
+    } else if (lost || elapsed > (wifiFastPath ? WIFI_FAST_CONNECT_TIMEOUT_MS
+                                               : WIFI_CONNECT_TIMEOUT_MS)) {
+      wifiAttemptFailed();
+    }
+    break;
+  case WIFI_UP:
+    if (gotIp)
+      wifiLostPending = false;
+    if (lost)
+      wifiLostPending = true;
+    if (wifiLostPending && !connected) {
+      Serial.println("WiFi link lost");
+      wifiOutage = true;
+      wifiLostAt = millis();
+      wifiBegin(true);
+    }
+    break;
+  case WIFI_WAITING:
+    // The failed attempt's association may still complete; keep it rather
+    // than tear it down for the next one. A loss alone changes nothing.
+    if (gotIp && connected) {
+      wifiLinkUp();
+      wifiLostPending = lost;
+    } else if (elapsed >= wifiWaitMs) {
+      wifiBegin(false);
+    }
+    break;
+  }
+}
+
+#if OTA_ENABLED
 static void setupOTA() {
-  ArduinoOTA.setHostname(OTA_HOSTNAME);
-  ArduinoOTA.setPassword(OTA_PASSWORD);
+  ArduinoOTA.setHostname(CONFIG.otaHostname);
+  ArduinoOTA.setPassword(CONFIG.otaPassword);
 
   ArduinoOTA.onStart([]() {
     String type;
@@ -130,10 +823,10 @@ static void setupOTA() {
   });
   ArduinoOTA.onEnd([]() { Serial.println("\nEnd"); });
   ArduinoOTA.onProgress([](unsigned int progress, unsigned int total) {
-    Serial.printf("Progress: %u%%\r", (progress / (total / 100)));
+    logPrintf("Progress: %u%%\r", (progress / (total / 100)));
   });
   ArduinoOTA.onError([](ota_error_t error) {
-    Serial.printf("Error[%u]: ", error);
+    logPrintf("Error[%u]: ", error);
     if (error == OTA_AUTH_ERROR)
       Serial.println("Auth Failed");
     else if (error == OTA_BEGIN_ERROR)
@@ -149,143 +842,1084 @@ static void setupOTA() {
   ArduinoOTA.begin();
   Serial.println("OTA Ready");
 }
+#endif
 
-void setup() {
-  Serial.begin(115200);
+// ===== Delta OTA =====
+// scripts/ota_delta.py pushes a patch against the running image to
+// http://<node>:3233/delta (basic auth admin:OTA_PASSWORD). The patch's
+// records are inflated with the ROM tinfl (32 KiB window) and applied
+// straight into the inactive OTA partition, so only the patch crosses
+// the WiFi link. Boot switches to the new image only if its hash
+// matches; the new app then stays "pending verify" until its first
+// successful upload, and the bootloader rolls back if it resets before.
+#if DELTA_OTA_ENABLED
+static constexpr uint16_t DELTA_OTA_PORT = 3233;
+
+class RunningImage : public DeltaSource {
+public:
+  bool read(uint32_t offset, uint8_t *buf, size_t len) override {
+    const esp_partition_t *part = esp_ota_get_running_partition();
+    return part && esp_partition_read(part, offset, buf, len) == ESP_OK;
+  }
+};
+
+class UpdateSink : public DeltaSink {
+public:
+  bool open(uint32_t size) override { return Update.begin(size, U_FLASH); }
+  bool write(const uint8_t *data, size_t len) override {
+    return Update.write(const_cast<uint8_t *>(data), len) == len;
+  }
+};
+
+WebServer deltaServer(DELTA_OTA_PORT);
+RunningImage deltaSource;
+UpdateSink deltaSink;
+DeltaPatcher deltaPatcher(deltaSource, deltaSink);
+DeltaStream deltaStream(deltaPatcher);
+const char *deltaError = nullptr;
+
+static void deltaFail(const char *error) {
+  if (!deltaError)
+    deltaError = error;
+  if (Update.isRunning())
+    Update.abort();
+  deltaStream.release();
+}
+
+static void onDeltaUpload() {
+  HTTPUpload &upload = deltaServer.upload();
+  switch (upload.status) {
+  case UPLOAD_FILE_START:
+    deltaError = nullptr;
+    if (!deltaServer.authenticate("admin", CONFIG.otaPassword)) {
+      deltaError = "unauthorized";
+      return;
+    }
+    Serial.println("[OTA] Delta update started");
+    if (!deltaStream.begin())
+      deltaFail(deltaStream.error());
+    break;
+  case UPLOAD_FILE_WRITE:
+    if (!deltaError && !deltaStream.feed(upload.buf, upload.currentSize))
+      deltaFail(deltaStream.error());
+    break;
+  case UPLOAD_FILE_END:
+    if (deltaError)
+      break;
+    if (!deltaStream.finish())
+      deltaFail(deltaStream.error());
+    else if (!Update.end())
+      deltaFail(Update.errorString());
+    break;
+  case UPLOAD_FILE_ABORTED:
+    deltaFail("upload aborted");
+    break;
+  }
+}
+
+static void onDeltaDone() {
+  if (deltaError && strcmp(deltaError, "unauthorized") == 0)
+    return deltaServer.requestAuthentication();
+  if (deltaError) {
+    logPrintf("[OTA] Delta update failed: %s\n", deltaError);
+    deltaServer.send(400, "text/plain", deltaError);
+    return;
+  }
+  logPrintf("[OTA] Delta update OK: %lu -> %lu bytes, rebooting\n",
+            (unsigned long)deltaPatcher.oldSize(),
+            (unsigned long)deltaPatcher.newSize());
+  deltaServer.send(200, "text/plain", "OK, rebooting into the new image");
   delay(200);
+  ESP.restart();
+}
+
+static void setupDeltaOta() {
+  deltaServer.on("/delta", HTTP_POST, onDeltaDone, onDeltaUpload);
+  deltaServer.begin();
+}
+
+#ifdef CONFIG_APP_ROLLBACK_ENABLE
+// Called by the Arduino core at boot: keep an updated app pending until
+// confirmRunningApp()
+extern "C" bool verifyRollbackLater() { return true; }
+#endif
+
+static void confirmRunningApp() {
+#ifdef CONFIG_APP_ROLLBACK_ENABLE
+  static bool confirmed = false;
+  if (confirmed)
+    return;
+  confirmed = true;
+  esp_ota_img_states_t state;
+  if (esp_ota_get_state_partition(esp_ota_get_running_partition(), &state) ==
+          ESP_OK &&
+      state == ESP_OTA_IMG_PENDING_VERIFY) {
+    esp_ota_mark_app_valid_cancel_rollback();
+    Serial.println("[OTA] New firmware confirmed");
+  }
+#endif
+}
+#endif
+
+// ===== Diagnostics server =====
+// Plain HTTP on port 3234 for tools on the LAN, one connection at a time:
+//   GET /detectors                   event detector settings
+//   POST /detectors/<type>?k=&h=...  change (alpha, k, h, hold, window,
+//                                    enabled) and store in NVS; restarts
+//                                    that detector on every sensor
+//   POST /detectors/<type>/reset     back to the built-in defaults
+// plus the raw capture endpoints below. Every POST needs basic auth
+// admin:OTA_PASSWORD, like /delta; with an empty OTA_PASSWORD they are
+// all refused. A handler answers with diagRespond(), or sets diagStream
+// to send a long body a chunk per loop() pass.
+static constexpr uint16_t DIAG_PORT = 3234;
+static constexpr unsigned long DIAG_REQUEST_TIMEOUT_MS = 5000;
+
+WiFiServer diagServer(DIAG_PORT);
+WiFiClient diagClient;
+char diagRequestLine[160];
+size_t diagRequestLen = 0;
+char diagHeaderLine[128]; // the header line being read
+size_t diagHeaderLen = 0;
+uint8_t diagHeaderEnd = 0; // "\r\n\r\n" matched so far
+bool diagAuthorized = false;
+char diagCredentials[96] = ""; // base64 admin:OTA_PASSWORD, set up once
+unsigned long diagClientSince = 0;
+void (*diagStream)() = nullptr;
+
+static void diagRespond(int code, const char *status, const char *body) {
+  diagClient.printf("HTTP/1.1 %d %s\r\nContent-Type: text/plain\r\n"
+                    "Content-Length: %u\r\nConnection: close\r\n\r\n%s",
+                    code, status, (unsigned)strlen(body), body);
+  diagClient.stop();
+}
+
+static void diagRequestAuthentication() {
+  diagClient.printf("HTTP/1.1 401 Unauthorized\r\n"
+                    "WWW-Authenticate: Basic realm=\"sen66\"\r\n"
+                    "Content-Type: text/plain\r\nContent-Length: 13\r\n"
+                    "Connection: close\r\n\r\nunauthorized\n");
+  diagClient.stop();
+}
+
+// Base64 of admin:OTA_PASSWORD into diagCredentials; left empty (nothing
+// matches) without a password or if it does not fit
+static void setupDiagCredentials() {
+  static const char DIGITS[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  char plain[72];
+  const int len = snprintf(plain, sizeof(plain), "admin:%s", CONFIG.otaPassword);
+  if (!*CONFIG.otaPassword || len < 0 || (size_t)len >= sizeof(plain) ||
+      ((size_t)len + 2) / 3 * 4 >= sizeof(diagCredentials))
+    return;
+  char *out = diagCredentials;
+  for (int i = 0; i < len; i += 3) {
+    const uint32_t n = (uint32_t)(uint8_t)plain[i] << 16 |
+                       (i + 1 < len ? (uint32_t)(uint8_t)plain[i + 1] << 8 : 0) |
+                       (i + 2 < len ? (uint8_t)plain[i + 2] : 0);
+    *out++ = DIGITS[n >> 18 & 63];
+    *out++ = DIGITS[n >> 12 & 63];
+    *out++ = i + 1 < len ? DIGITS[n >> 6 & 63] : '=';
+    *out++ = i + 2 < len ? DIGITS[n & 63] : '=';
+  }
+  *out = '\0';
+}
 
-  sen66.begin();
+// Sets diagAuthorized if line is "Authorization: Basic <our credentials>"
+static void diagCheckHeader(char *line) {
+  static const char NAME[] = "authorization:";
+  if (strncasecmp(line, NAME, sizeof(NAME) - 1) != 0)
+    return;
+  char *value = line + sizeof(NAME) - 1;
+  value += strspn(value, " \t");
+  if (strncasecmp(value, "Basic", 5) != 0)
+    return;
+  value += 5;
+  value += strspn(value, " \t");
+  value[strcspn(value, " \t\r")] = '\0';
+  diagAuthorized = *diagCredentials && strcmp(value, diagCredentials) == 0;
+}
 
-  delay(1000);
+// Value of "key=" in the query part of path
+static bool queryValue(const char *path, const char *key, float &out) {
+  const size_t len = strlen(key);
+  for (const char *q = strchr(path, '?'); q; q = strchr(q + 1, '&')) {
+    if (strncmp(q + 1, key, len) == 0 && q[1 + len] == '=') {
+      out = strtof(q + 2 + len, nullptr);
+      return true;
+    }
+  }
+  return false;
+}
+
+// A query value as a number of samples, 0 unless it is 1 to 65535
+static uint16_t sampleCount(float v) {
+  return v >= 1.0f && v <= UINT16_MAX ? (uint16_t)v : 0;
+}
 
-  // Start fan cleaning (uncomment to enable on boot)
-  // stopMeasurement/restore is now handled inside startFanCleaning
-  if (sen66.startFanCleaning()) {
-    Serial.println("Fan cleaning started... (library handles wait)");
+static bool detectorsRequest(bool get, bool post, const char *path) {
+  if (strncmp(path, "/detectors", 10) != 0)
+    return false;
+  if (get && path[10] == '\0') {
+    char body[DETECTOR_COUNT * 112];
+    size_t len = 0;
+    for (uint8_t d = 0; d < DETECTOR_COUNT && len < sizeof(body); ++d) {
+      const Events::Config &c = detectorConfig[d];
+      len += snprintf(body + len, sizeof(body) - len,
+                      "%s %s %s enabled=%u alpha=%g k=%g h=%g hold=%u "
+                      "window=%u (%s)\n",
+                      c.type, ENVIRONMENT_FIELDS[c.signal].name,
+                      Events::kindName(c.kind), c.params.enabled,
+                      c.params.alpha, c.params.k, c.params.h,
+                      c.params.hold, c.params.window,
+                      detectorFromNvs[d] ? "nvs" : "default");
+    }
+    diagRespond(200, "OK", body);
+    return true;
+  }
+  if (!post || path[10] != '/') {
+    diagRespond(404, "Not Found", "not found\n");
+    return true;
+  }
+
+  const char *type = path + 11;
+  const size_t typeLen = strcspn(type, "/?");
+  uint8_t d = 0;
+  while (d < DETECTOR_COUNT &&
+         !(strncmp(detectorConfig[d].type, type, typeLen) == 0 &&
+           detectorConfig[d].type[typeLen] == '\0'))
+    d++;
+  if (d == DETECTOR_COUNT) {
+    diagRespond(404, "Not Found", "unknown detector\n");
+    return true;
+  }
+
+  Events::Params p = detectorConfig[d].params;
+  if (strcmp(type + typeLen, "/reset") == 0) {
+    p = DETECTOR_DEFAULTS[d].params;
+    saveDetectorParams(d, nullptr);
   } else {
-    Serial.println("Fan cleaning failed");
+    float v;
+    if (queryValue(path, "alpha", v))
+      p.alpha = v;
+    if (queryValue(path, "k", v))
+      p.k = v;
+    if (queryValue(path, "h", v))
+      p.h = v;
+    if (queryValue(path, "hold", v))
+      p.hold = sampleCount(v);
+    if (queryValue(path, "window", v))
+      p.window = sampleCount(v);
+    if (queryValue(path, "enabled", v))
+      p.enabled = v != 0.0f;
+    const char *error = detectorParamsError(detectorConfig[d].kind, p);
+    if (error) {
+      diagRespond(400, "Bad Request", error);
+      return true;
+    }
+    saveDetectorParams(d, &p);
   }
+  detectorConfig[d].params = p;
+  for (uint8_t i = 0; i < CONFIG.sensorCount; ++i)
+    sensorNodes[i]->events.setParams(d, p);
+  logPrintf("[Events] %s detector updated\n", detectorConfig[d].type);
+  diagRespond(200, "OK", "updated\n");
+  return true;
+}
+
+#if RAW_CAPTURE_ENABLED
+static bool rawRequest(bool get, bool post, const char *path);
+#endif
 
-  if (!sen66.startMeasurement()) {
-    Serial.println("SEN66 startMeasurement() failed");
+static void diagHandleRequest() {
+  char method[8] = "";
+  char path[128] = "";
+  sscanf(diagRequestLine, "%7s %127s", method, path);
+  const bool get = strcmp(method, "GET") == 0;
+  const bool post = strcmp(method, "POST") == 0;
+  if (post && !diagAuthorized)
+    return diagRequestAuthentication();
+  if (detectorsRequest(get, post, path))
+    return;
+  if (get && strcmp(path, "/i2c") == 0) {
+    char body[I2C_STATS_SIZE];
+    formatI2cStats(body, sizeof(body));
+    diagRespond(200, "OK", body);
+    return;
+  }
+#if RAW_CAPTURE_ENABLED
+  if (rawRequest(get, post, path))
+    return;
+#endif
+  diagRespond(404, "Not Found", "not found\n");
+}
+
+// One step of the connection: accept, read the request head, or stream
+// the next chunk of a response
+static void serviceDiagServer() {
+  if (!diagClient || !diagClient.connected()) {
+    diagClient.stop();
+    diagStream = nullptr;
+    diagClient = diagServer.available();
+    if (!diagClient)
+      return;
+    diagRequestLen = 0;
+    diagHeaderLen = 0;
+    diagHeaderEnd = 0;
+    diagAuthorized = false;
+    diagClientSince = millis();
   }
 
-  // Configure Temperature Offset (Offset=0, Slope=0, TimeConstant=0 for now)
-  // This compensates for self-heating or enclosure effects.
-  if (!sen66.setTemperatureOffsetParameters(0, 0, 0)) {
-    Serial.println("SEN66 setTemperatureOffsetParameters() failed");
+  if (diagStream) {
+    diagStream();
+    return;
+  }
+  while (diagHeaderEnd < 4 && diagClient.available() > 0) {
+    const char c = (char)diagClient.read();
+    diagHeaderEnd = (c == (diagHeaderEnd % 2 ? '\n' : '\r'))
+                        ? diagHeaderEnd + 1
+                        : (c == '\r' ? 1 : 0);
+    if (diagRequestLen < sizeof(diagRequestLine) - 1 &&
+        !memchr(diagRequestLine, '\n', diagRequestLen))
+      diagRequestLine[diagRequestLen++] = c;
+    if (c == '\n') {
+      diagHeaderLine[diagHeaderLen] = '\0';
+      diagCheckHeader(diagHeaderLine);
+      diagHeaderLen = 0;
+    } else if (diagHeaderLen < sizeof(diagHeaderLine) - 1) {
+      diagHeaderLine[diagHeaderLen++] = c;
+    }
   }
+  diagRequestLine[diagRequestLen] = '\0';
+  if (diagHeaderEnd == 4)
+    diagHandleRequest();
+  else if (millis() - diagClientSince > DIAG_REQUEST_TIMEOUT_MS)
+    diagClient.stop();
+}
+
+static void setupDiagServer() {
+  setupDiagCredentials();
+  if (!*diagCredentials)
+    Serial.println("[Diag] OTA_PASSWORD empty or longer than 65 chars, "
+                   "POST requests refused");
+  diagServer.begin();
+}
+
+// ===== Raw capture =====
+// SEN66 raw frames (0x0405) of every sample into a RAM ring of fixed
+// 24-byte records (lib/RawCapture), served by the diagnostics server:
+//   POST /raw/start, POST /raw/stop  capture on/off (adds one 20 ms read
+//                                    per sample round)
+//   GET /raw[?from=SEQ]              the log (or records from SEQ on) as
+//                                    an S6RW file, see RawLog.h
+//   GET /raw/status                  state, record count, sequence range
+// The download is streamed a chunk per loop() pass, so sampling and
+// uploads go on while it runs; it snapshots the record range at request
+// time and is cut short if the ring overwrites records not yet sent.
+#if RAW_CAPTURE_ENABLED
+static constexpr size_t RAW_CAPTURE_PSRAM_BYTES = 2 * 1024 * 1024; // ~24 h, 1 sensor
+static constexpr size_t RAW_CAPTURE_RAM_BYTES = 48 * 1024;         // ~34 min
+static constexpr size_t RAW_SEND_CHUNK = 60 * sizeof(RawCapture::Record);
+
+RawCapture::Log *rawLog = nullptr; // allocated on the first start
+uint32_t rawNextSeq = 0;
+uint32_t rawEndSeq = 0;
 
-  wifiConnect();
-  setupOTA();
+static bool startRawCapture() {
+  if (!rawLog) {
+    size_t bytes = RAW_CAPTURE_RAM_BYTES;
+    void *storage = nullptr;
+#if defined(BOARD_HAS_PSRAM)
+    if (psramFound()) {
+      bytes = RAW_CAPTURE_PSRAM_BYTES;
+      storage = ps_malloc(bytes);
+    }
+#endif
+    if (!storage) {
+      bytes = RAW_CAPTURE_RAM_BYTES;
+      storage = malloc(bytes);
+    }
+    if (!storage)
+      return false;
+    rawLog = new RawCapture::Log(storage, bytes);
+  }
+  sensors.setRawValues(true);
+  logPrintf("[Raw] capture on, %u records\n", (unsigned)rawLog->capacity());
+  return true;
 }
 
-static String f2s(float v, uint8_t digits = 2) {
-  if (isnan(v))
-    return "";
-  // Disambiguate constructor by casting to unsigned int
-  return String(v, static_cast<unsigned int>(digits));
+static void stopRawCapture() {
+  sensors.setRawValues(false);
+  Serial.println("[Raw] capture off");
 }
 
-static float dewPoint(float tempC, float humidityRH) {
-  if (isnan(tempC) || isnan(humidityRH))
-    return NAN;
-  const float a = 17.62f;
-  const float b = 243.12f;
-  float gamma = (a * tempC) / (b + tempC) + log(humidityRH / 100.0f);
-  return (b * gamma) / (a - gamma);
+static void captureRawSample(uint8_t i, const Sen66Array::Sample &s) {
+  if (!rawLog || !s.rawValid)
+    return;
+  const int64_t epochMs = clockValid() ? wallClock.toEpochMs(s.readyMs) : 0;
+  rawLog->append(RawCapture::makeRecord(i, s.readyMs, epochMs, s.raw));
 }
 
-static void sendToInflux(const Sen66::MeasuredValues &mv,
-                         const Sen66::NumberConcentration &nc,
-                         uint32_t statusFlags, const WeatherData &wd) {
-  if (WiFi.status() != WL_CONNECTED)
+// Next chunk of a download (diagStream)
+static void rawSendChunk() {
+  if (rawNextSeq == rawEndSeq) {
+    diagClient.stop();
     return;
+  }
+  size_t n = 0;
+  const RawCapture::Record *run = rawLog->run(rawNextSeq, n);
+  if (!run) {
+    // Overwritten before it was sent: the short body tells the client
+    Serial.println("[Raw] download overtaken by the ring, closed");
+    diagClient.stop();
+    return;
+  }
+  if (n > rawEndSeq - rawNextSeq)
+    n = rawEndSeq - rawNextSeq;
+  if (n * sizeof(*run) > RAW_SEND_CHUNK)
+    n = RAW_SEND_CHUNK / sizeof(*run);
+  const size_t bytes = n * sizeof(*run);
+  if (diagClient.write((const uint8_t *)run, bytes) != bytes) {
+    diagClient.stop();
+    return;
+  }
+  rawNextSeq += (uint32_t)n;
+}
+
+static bool rawRequest(bool get, bool post, const char *path) {
+  if (post && strcmp(path, "/raw/start") == 0) {
+    if (startRawCapture())
+      diagRespond(200, "OK", "capturing\n");
+    else
+      diagRespond(507, "Insufficient Storage", "no memory for the log\n");
+  } else if (post && strcmp(path, "/raw/stop") == 0) {
+    stopRawCapture();
+    diagRespond(200, "OK", "stopped\n");
+  } else if (get && strcmp(path, "/raw/status") == 0) {
+    char body[160];
+    snprintf(body, sizeof(body),
+             "capturing %d\nrecords %u\ncapacity %u\nfirst_seq %lu\n"
+             "end_seq %lu\n",
+             sensors.rawValues() ? 1 : 0,
+             rawLog ? (unsigned)rawLog->size() : 0u,
+             rawLog ? (unsigned)rawLog->capacity() : 0u,
+             rawLog ? (unsigned long)rawLog->firstSeq() : 0ul,
+             rawLog ? (unsigned long)rawLog->endSeq() : 0ul);
+    diagRespond(200, "OK", body);
+  } else if (get && strncmp(path, "/raw", 4) == 0 &&
+             (path[4] == '\0' || path[4] == '?')) {
+    rawNextSeq = rawLog ? rawLog->firstSeq() : 0;
+    rawEndSeq = rawLog ? rawLog->endSeq() : 0;
+    const char *from = strstr(path, "from=");
+    if (from) {
+      const uint32_t seq = (uint32_t)strtoul(from + 5, nullptr, 10);
+      // Records before first are gone; a SEQ past the end comes from
+      // before a reboot, so the reader gets the whole new log
+      if ((int32_t)(seq - rawNextSeq) > 0 && (int32_t)(seq - rawEndSeq) <= 0)
+        rawNextSeq = seq;
+    }
+    const uint32_t count = rawEndSeq - rawNextSeq;
+    const RawCapture::FileHeader h = RawCapture::Log::header(rawNextSeq, count);
+    diagClient.printf("HTTP/1.1 200 OK\r\nContent-Type: application/octet-stream\r\n"
+                      "Content-Disposition: attachment; filename=\"raw.s6rw\"\r\n"
+                      "Content-Length: %lu\r\nConnection: close\r\n\r\n",
+                      (unsigned long)(sizeof(h) + count * sizeof(RawCapture::Record)));
+    diagClient.write((const uint8_t *)&h, sizeof(h));
+    diagStream = rawSendChunk;
+  } else {
+    return false;
+  }
+  return true;
+}
+#endif
+
+static const char *sensorLabel(uint8_t i) {
+  return *sensorNodes[i]->tag ? sensorNodes[i]->tag : "SEN66";
+}
+
+#if INFLUX_ENABLED
+// DEVICE_ID if configured, else the first SEN66 serial (DEVICE_ID_SOURCE=
+// sen66) or the station MAC as 12 hex digits.
+static void resolveDeviceId() {
+  if (*CONFIG.deviceId) {
+    strncpy(deviceId, CONFIG.deviceId, sizeof(deviceId) - 1);
+    return;
+  }
+  if (CONFIG.deviceIdFromSen66) {
+    if (sensorNodes[0]->sen66.readSerialNumber(deviceId, sizeof(deviceId)) &&
+        *deviceId)
+      return;
+    Serial.println("SEN66 readSerialNumber() failed, using MAC as device ID");
+  }
+  uint8_t mac[6];
+  WiFi.macAddress(mac);
+  snprintf(deviceId, sizeof(deviceId), "%02x%02x%02x%02x%02x%02x", mac[0],
+           mac[1], mac[2], mac[3], mac[4], mac[5]);
+}
+
+static void setSeriesKey(char *buf, const char *measurement,
+                         const LineProtocolTag *tags, size_t count) {
+  if (buildSeriesKey(buf, SERIES_KEY_SIZE, measurement, tags, count) == 0) {
+    // Tags too long: fall back to the bare measurement
+    logPrintf("[Tags] %s tag set exceeds %u bytes, sending untagged\n",
+              measurement, (unsigned)SERIES_KEY_SIZE);
+    strncpy(buf, measurement, SERIES_KEY_SIZE - 1);
+    buf[SERIES_KEY_SIZE - 1] = '\0';
+  }
+}
+
+// "events,<sensor i's tags>,type=<type>"
+static void eventSeriesKey(char *buf, uint8_t i, const char *type) {
+  const LineProtocolTag tags[] = {{"device", deviceId},
+                                  {"room", CONFIG.deviceRoom},
+                                  {"site", CONFIG.deviceSite},
+                                  {"sensor", sensorNodes[i]->tag},
+                                  {"type", type}};
+  setSeriesKey(buf, "events", tags, 5);
+}
+
+static void buildSeriesKeys() {
+  resolveDeviceId();
+  logPrintf("[Tags] device=%s room=%s site=%s\n", deviceId, CONFIG.deviceRoom,
+            CONFIG.deviceSite);
+
+  LineProtocolTag tags[] = {{"device", deviceId},
+                            {"room", CONFIG.deviceRoom},
+                            {"site", CONFIG.deviceSite},
+                            {"sensor", nullptr}};
+#if WEATHER_ENABLED
+  setSeriesKey(weatherSeriesKey, "external_weather", tags, 3);
+#endif
+#if TELEMETRY_ENABLED
+  setSeriesKey(telemetrySeriesKey, "telemetry", tags, 3);
+#endif
+  for (uint8_t i = 0; i < CONFIG.sensorCount; ++i) {
+    SensorNode &node = *sensorNodes[i];
+    tags[3].value = node.tag;
+    setSeriesKey(node.environmentKey, "environment", tags, 4);
+#if EXPOSURE_ENABLED
+    LineProtocolTag periodTags[] = {tags[0], tags[1], tags[2], tags[3],
+                                    {"period", "day"}};
+    setSeriesKey(node.exposureDayKey, "exposure", periodTags, 5);
+    periodTags[4].value = "hour";
+    setSeriesKey(node.exposureHourKey, "exposure", periodTags, 5);
+#endif
+  }
+}
+#endif
+
+void setup() {
+  Serial.begin(115200);
+#if TELEMETRY_ENABLED
+  Telemetry::calibrate();
+#endif
+
+  // Kick off WiFi first; association and DHCP run in the background while
+  // the sensor powers up and takes its first sample.
+  loadWifiCache();
+  setupWifi();
+#if EXPOSURE_ENABLED
+  setenv("TZ", CONFIG.timezone, 1);
+  tzset();
+#endif
+
+#if INFLUX_ENABLED
+  if (!secureHttp.begin((const uint8_t *)CONFIG.tlsCa, CONFIG.tlsCaSizes,
+                        CONFIG.tlsCaCount))
+    Serial.println("[TLS] no usable CA certificate, https requests disabled");
+  secureHttp.onHandshake(onTlsHandshake);
+#endif
+
+  loadDetectorConfig();
+  for (uint8_t i = 0; i < CONFIG.sensorCount; ++i) {
+    const SensorConfig &c = CONFIG.sensors[i];
+    Sen66Bus &bus = c.muxChannel >= 0
+                        ? muxes[c.bus]->channel((uint8_t)c.muxChannel)
+                        : static_cast<Sen66Bus &>(*i2cBuses[c.bus]);
+    sensorNodes[i] = new SensorNode(bus, c.tag);
+    sensorNodes[i]->history = allocateHistory();
+#if INFLUX_ENABLED
+    sensorNodes[i]->report.begin(CONFIG.reportHeartbeatMs);
+#endif
+    for (uint8_t d = 0; d < DETECTOR_COUNT; ++d)
+      sensorNodes[i]->events.add(detectorConfig[d]);
+    if (!sensorNodes[i]->history)
+      logPrintf("%s history allocation failed\n", sensorLabel(i));
+    sensors.add(sensorNodes[i]->sen66);
+    i2cBusUsed[c.bus] = true;
+  }
+  for (uint8_t b = 0; b < 2; ++b)
+    if (i2cBusUsed[b])
+      i2cBuses[b]->begin();
+  logI2cClock();
+#if RAW_CAPTURE_ENABLED
+  if (CONFIG.rawCaptureAutostart && !startRawCapture())
+    Serial.println("[Raw] no memory for the capture log");
+#endif
+
+  // Fan cleaning is deferred until after the first upload (see loop()).
+  for (uint8_t i = 0; i < CONFIG.sensorCount; ++i) {
+    Sen66 &sen66 = sensorNodes[i]->sen66;
+    if (!sen66.startMeasurement()) {
+      logPrintf("%s startMeasurement() failed, retrying in loop\n",
+                sensorLabel(i));
+      sensorNodes[i]->startAttemptMs = millis();
+      sensorNodes[i]->startBackoffMs = SENSOR_START_BACKOFF_MIN_MS;
+    }
+
+    // Configure Temperature Offset (Offset=0, Slope=0, TimeConstant=0 for now)
+    // This compensates for self-heating or enclosure effects.
+    if (!sen66.setTemperatureOffsetParameters(0, 0, 0)) {
+      logPrintf("%s setTemperatureOffsetParameters() failed\n",
+                sensorLabel(i));
+    }
+  }
+
+#if INFLUX_ENABLED
+  buildSeriesKeys();
+  formatRequestTargets();
+#endif
+
+  // Everything loop() keeps is allocated by now
+  HeapGuard::arm(CONFIG.heapGuardTrap);
+}
+
+#if INFLUX_ENABLED
+// Upper bound for one environment line (~260 bytes, more with tags)
+static constexpr size_t LINE_BUFFER_SIZE = 512;
+
+// HTTP POST/GET wrappers that feed the per-stage latency histograms
+static int timedPost(const char *url, const char *headers, const void *body,
+                     size_t len) {
+  TELEMETRY_SCOPE(Telemetry::STAGE_INFLUX_POST);
+  const int code = secureHttp.post(url, headers, (const uint8_t *)body, len);
+  if (code < 200 || code >= 300)
+    TELEMETRY_ERROR(Telemetry::STAGE_INFLUX_POST);
+  return code;
+}
+
+#if WEATHER_ENABLED
+static constexpr uint32_t WEATHER_TIMEOUT_MS = 10000;
+
+static int timedGet(const char *url, char *response, size_t cap,
+                    size_t &length) {
+  TELEMETRY_SCOPE(Telemetry::STAGE_WEATHER_FETCH);
+  const int code =
+      secureHttp.get(url, nullptr, response, cap, length, WEATHER_TIMEOUT_MS);
+  if (code != 200)
+    TELEMETRY_ERROR(Telemetry::STAGE_WEATHER_FETCH);
+  return code;
+}
+#endif
+
+// Change-driven lines are stamped with their points' sample times
+static uint32_t epochSeconds(uint32_t monoMs) {
+  return wallClock.toEpochSeconds(monoMs);
+}
+
+// ===== Binary uplink =====
+// With UPLINK_BRIDGE_URL set, every sample taken with a synced clock goes
+// into a binary batch (lib/Uplink, the SEN66 words delta coded, ~10
+// bytes per sample) that replaces the environment lines: each upload
+// POSTs it to <bridge>/sen66/v1/batch?bucket=&org= with the InfluxDB
+// token, and src/bridge writes the same environment lines to InfluxDB.
+// A failed batch is kept and grows until the next upload; a full one is
+// dropped.
+#if UPLINK_BINARY
+static constexpr size_t UPLINK_BATCH_SIZE = 4096;
+// Upload before the batch can fill up
+static constexpr size_t UPLINK_BATCH_FLUSH = UPLINK_BATCH_SIZE * 3 / 4;
+
+uint8_t uplinkBuffer[UPLINK_BATCH_SIZE];
+Uplink::BatchWriter uplinkBatch(uplinkBuffer, sizeof(uplinkBuffer));
+
+static bool uplinkBegin(int64_t epochMs) {
+  const char *tags[CONFIG.sensorCount];
+  for (uint8_t i = 0; i < CONFIG.sensorCount; ++i)
+    tags[i] = sensorNodes[i]->tag;
+  return uplinkBatch.begin(epochMs, deviceId, CONFIG.deviceRoom, CONFIG.deviceSite, tags,
+                           CONFIG.sensorCount);
+}
+
+static void uplinkSample(uint8_t i, const Sen66Array::Sample &s,
+                         const History::Ticks &ticks, uint32_t seq) {
+  if (!clockValid())
+    return; // sent as a line instead
+  const int64_t epochMs = wallClock.toEpochMs(s.readyMs);
+  if (uplinkBatch.length() == 0 && !uplinkBegin(epochMs))
+    return;
+  if (uplinkBatch.add(i, epochMs, ticks, s.statusFlags, seq))
+    return;
+  logPrintf("[Uplink] batch full, dropped %lu samples\n",
+            (unsigned long)uplinkBatch.records());
+  if (uplinkBegin(epochMs))
+    uplinkBatch.add(i, epochMs, ticks, s.statusFlags, seq);
+}
+
+static bool uplinkDue() { return uplinkBatch.length() >= UPLINK_BATCH_FLUSH; }
+
+static bool postUplinkBatch() {
+  int code = timedPost(uplinkUrl, uplinkHeaders, uplinkBatch.data(),
+                       uplinkBatch.length());
+  logPrintf("[Uplink] batch HTTP %d (%lu samples, %u bytes)\n", code,
+            (unsigned long)uplinkBatch.records(),
+            (unsigned)uplinkBatch.length());
+  if (code < 200 || code >= 300)
+    return false;
+  uplinkBatch.reset();
+  return true;
+}
+#endif
+
+// Upper bound for one event line
+static constexpr size_t EVENT_LINE_SIZE = SERIES_KEY_SIZE + 96;
+
+// Writes the queued events, each line stamped with its event's start
+static void encodeEvents(LineProtocolWriter &w) {
+  char key[SERIES_KEY_SIZE];
+  for (uint8_t q = 0; q < eventQueueLen; ++q) {
+    const PendingEvent &p = eventQueue[q];
+    const Events::Event &e = p.event;
+    eventSeriesKey(key, p.sensor, p.type);
+    w.seriesKey(key);
+    w.field("active", (int32_t)(e.active ? 1 : 0));
+    w.field("magnitude", e.magnitude, p.digits);
+    if (!e.active)
+      w.fieldUInt("duration_s", (e.endMs - e.startMs) / 1000);
+    if (clockValid()) {
+      w.fieldUInt("start", wallClock.toEpochSeconds(e.startMs));
+      if (!e.active)
+        w.fieldUInt("end", wallClock.toEpochSeconds(e.endMs));
+      w.endLine(wallClock.toEpochSeconds(e.startMs));
+    } else {
+      w.field("time_unsynced", (int32_t)1);
+      w.endLine();
+    }
+  }
+}
+
+// True if the environment lines were accepted (or there were none)
+static bool sendToInflux() {
+  if (!wifiUp())
+    return false;
   
-  HTTPClient http;
-  String url = String(INFLUXDB_URL) +
-               "/api/v2/write?bucket=" + INFLUXDB_BUCKET +
-               "&org=" + INFLUXDB_ORG;
-  
-  // Send local sensor data to 'environment' measurement
-  const float dp = dewPoint(mv.temperature_c, mv.humidity_rh);
-  String line =
-      String("environment") + " pm1_0=" + f2s(mv.pm1_0, 1) +
-      ",pm2_5=" + f2s(mv.pm2_5, 1) + ",pm4_0=" + f2s(mv.pm4_0, 1) +
-      ",pm10=" + f2s(mv.pm10_0, 1) + ",humidity=" + f2s(mv.humidity_rh, 2) +
-      ",temperature=" + f2s(mv.temperature_c, 2) + ",dew_point=" + f2s(dp, 2) +
-      ",voc=" + f2s(mv.voc_index, 1) + ",nox=" + f2s(mv.nox_index, 1) +
-      ",co2=" + f2s(mv.co2_ppm, 0) + ",nc0_5=" + f2s(nc.nc0_5, 1) +
-      ",nc1_0=" + f2s(nc.nc1_0, 1) + ",nc2_5=" + f2s(nc.nc2_5, 1) +
-      ",nc4_0=" + f2s(nc.nc4_0, 1) + ",nc10=" + f2s(nc.nc10_0, 1) +
-      ",status=" + String((unsigned long)statusFlags);
-  
-  http.begin(url);
-  http.addHeader("Authorization", String("Token ") + INFLUXDB_TOKEN);
-  http.addHeader("Content-Type", "text/plain; charset=utf-8");
-  int code = http.POST(line);
-  Serial.printf("[InfluxDB] Environment HTTP %d\n", code);
-  http.end();
-  
-  // Send external weather data to 'external_weather' measurement (if available)
+  const bool changeOnly = CONFIG.reportChangeOnly && clockValid();
+
+  // Send local sensor data to 'environment' measurement, one line per
+  // sensor in a single request (up to two per sensor when change-driven),
+  // followed by the pending events
+  static char body[2 * LINE_BUFFER_SIZE * CONFIG.sensorCount +
+                   EVENT_QUEUE_SIZE * EVENT_LINE_SIZE];
+  LineProtocolWriter w(body, sizeof(body));
+  for (uint8_t i = 0; i < sensors.size(); ++i) {
+    if (!sensors.hasSample(i))
+      continue;
+    const Sen66Array::Sample &s = sensors.sample(i);
+#if UPLINK_BINARY
+    if (clockValid())
+      continue; // in the batch
+#endif
+    if (changeOnly) {
+      SensorNode &node = *sensorNodes[i];
+      node.report.encode(w, node.environmentKey, node.sampleMs, node.seq,
+                         s.mv, s.nc, s.statusValid, s.statusFlags,
+                         epochSeconds);
+    } else {
+      encodeEnvironmentFields(w, s.mv, s.nc, s.statusFlags,
+                              sensorNodes[i]->environmentKey);
+      w.fieldUInt("seq", sensorNodes[i]->seq);
+      endStampedLine(w, s.readyMs);
+    }
+  }
+  encodeEvents(w);
+
+  // Nothing left the deadband on any sensor: skip the request
+  bool accepted = true;
+  if (w.length() > 0) {
+    int code = timedPost(influxWriteUrl, influxHeaders, w.c_str(), w.length());
+    logPrintf("[InfluxDB] Environment HTTP %d (%u bytes)\n", code,
+              (unsigned)w.length());
+    accepted = code >= 200 && code < 300;
+  }
+  if (accepted)
+    eventQueueLen = 0;
+  // Change-driven state advances only with what the server has; after a
+  // failure the next upload re-sends from the last accepted point
+  if (changeOnly)
+    for (uint8_t i = 0; i < sensors.size(); ++i) {
+      EnvironmentReport &report = sensorNodes[i]->report;
+      if (accepted)
+        report.commit();
+      else
+        report.rollback();
+    }
+#if UPLINK_BINARY
+  if (uplinkBatch.records() > 0 && !postUplinkBatch())
+    accepted = false;
+#endif
+  return accepted;
+}
+
+#if WEATHER_ENABLED
+// Send external weather data to 'external_weather' measurement (if available)
+static void sendWeatherToInflux(const WeatherData &wd) {
   if (wd.valid) {
     delay(10); // Small delay between requests
     
-    String weatherLine = String("external_weather");
-    bool hasData = false;
+    char line[LINE_BUFFER_SIZE];
+    LineProtocolWriter w(line, sizeof(line));
+    w.seriesKey(weatherSeriesKey);
+    w.field("temperature", wd.temperature, 2);
+    w.field("humidity", wd.humidity, 1);
+    w.field("pressure", wd.pressure, 2);
+    w.field("wind_speed", wd.windSpeed, 2);
+    if (wd.windDirection != 0) w.field("wind_direction", (int32_t)wd.windDirection);
+    if (wd.cloudCover != 0) w.field("cloud_cover", (int32_t)wd.cloudCover);
+    if (wd.weatherCode != 0) w.field("weather_code", (int32_t)wd.weatherCode);
+    w.field("pm10", wd.pm10, 1);
+    w.field("pm2_5", wd.pm2_5, 1);
+    w.field("co", wd.carbonMonoxide, 2);
+    w.field("no2", wd.nitrogenDioxide, 2);
+    w.field("so2", wd.sulphurDioxide, 2);
+    w.field("o3", wd.ozone, 2);
+    if (wd.europeanAqi != 0) w.field("eu_aqi", (int32_t)wd.europeanAqi);
+    if (wd.usAqi != 0) w.field("us_aqi", (int32_t)wd.usAqi);
+    endStampedLine(w, wd.lastFetch);
     
-    if (!isnan(wd.temperature)) { weatherLine += " temperature=" + f2s(wd.temperature, 2); hasData = true; }
-    if (!isnan(wd.humidity)) { weatherLine += (hasData ? "," : " ") + String("humidity=") + f2s(wd.humidity, 1); hasData = true; }
-    if (!isnan(wd.pressure)) { weatherLine += (hasData ? "," : " ") + String("pressure=") + f2s(wd.pressure, 2); hasData = true; }
-    if (!isnan(wd.windSpeed)) { weatherLine += (hasData ? "," : " ") + String("wind_speed=") + f2s(wd.windSpeed, 2); hasData = true; }
-    if (wd.windDirection != 0) { weatherLine += (hasData ? "," : " ") + String("wind_direction=") + String(wd.windDirection); hasData = true; }
-    if (wd.cloudCover != 0) { weatherLine += (hasData ? "," : " ") + String("cloud_cover=") + String(wd.cloudCover); hasData = true; }
-    if (wd.weatherCode != 0) { weatherLine += (hasData ? "," : " ") + String("weather_code=") + String(wd.weatherCode); hasData = true; }
-    if (!isnan(wd.pm10)) { weatherLine += (hasData ? "," : " ") + String("pm10=") + f2s(wd.pm10, 1); hasData = true; }
-    if (!isnan(wd.pm2_5)) { weatherLine += (hasData ? "," : " ") + String("pm2_5=") + f2s(wd.pm2_5, 1); hasData = true; }
-    if (!isnan(wd.carbonMonoxide)) { weatherLine += (hasData ? "," : " ") + String("co=") + f2s(wd.carbonMonoxide, 2); hasData = true; }
-    if (!isnan(wd.nitrogenDioxide)) { weatherLine += (hasData ? "," : " ") + String("no2=") + f2s(wd.nitrogenDioxide, 2); hasData = true; }
-    if (!isnan(wd.sulphurDioxide)) { weatherLine += (hasData ? "," : " ") + String("so2=") + f2s(wd.sulphurDioxide, 2); hasData = true; }
-    if (!isnan(wd.ozone)) { weatherLine += (hasData ? "," : " ") + String("o3=") + f2s(wd.ozone, 2); hasData = true; }
-    if (wd.europeanAqi != 0) { weatherLine += (hasData ? "," : " ") + String("eu_aqi=") + String(wd.europeanAqi); hasData = true; }
-    if (wd.usAqi != 0) { weatherLine += (hasData ? "," : " ") + String("us_aqi=") + String(wd.usAqi); hasData = true; }
-    
-    if (hasData) {
-      http.begin(url);
-      http.addHeader("Authorization", String("Token ") + INFLUXDB_TOKEN);
-      http.addHeader("Content-Type", "text/plain; charset=utf-8");
-      int weatherCode = http.POST(weatherLine);
-      Serial.printf("[InfluxDB] External Weather HTTP %d\n", weatherCode);
-      http.end();
+    if (w.length() > 0) {
+      int weatherCode =
+          timedPost(influxWriteUrl, influxHeaders, w.c_str(), w.length());
+      logPrintf("[InfluxDB] External Weather HTTP %d\n", weatherCode);
     }
   }
 }
+#endif
 
-static void sendFanCleaningEventToInflux() {
-  if (WiFi.status() != WL_CONNECTED)
+#if TELEMETRY_ENABLED
+static void sendTelemetryToInflux() {
+  if (!wifiUp())
+    return;
+  // Nine stages at their widest, the heap fields and the tags
+  static char buf[2048];
+  const size_t len = Telemetry::formatLine(buf, sizeof(buf), telemetrySeriesKey);
+  if (len == 0) {
+    Serial.println("[Telemetry] line exceeds buffer");
     return;
-  HTTPClient http;
-  String url = String(INFLUXDB_URL) +
-               "/api/v2/write?bucket=" + INFLUXDB_BUCKET +
-               "&org=" + INFLUXDB_ORG;
-  String line = String("events,type=fan_cleaning value=1");
-  http.begin(url);
-  http.addHeader("Authorization", String("Token ") + INFLUXDB_TOKEN);
-  http.addHeader("Content-Type", "text/plain; charset=utf-8");
-  int code = http.POST(line);
-  Serial.printf("[InfluxDB] Fan Cleaning Event HTTP %d\n", code);
-  http.end();
+  }
+  int code = timedPost(influxWriteUrl, influxHeaders, buf, len);
+  logPrintf("[InfluxDB] Telemetry HTTP %d\n", code);
+  // Otherwise the next line covers this interval too
+  if (code >= 200 && code < 300)
+    Telemetry::reset();
+}
+#endif
+#endif
+
+// ===== Exposure =====
+// Daily doses per sensor (lib/Exposure), integrated from every sample.
+// The day is local (TIMEZONE) and is placed once the clock first syncs;
+// samples before that count toward it. The totals are checkpointed to
+// NVS (namespace "exposure", key "s<sensor>") every 10 minutes and at
+// midnight, so a reboot carries on from the last checkpoint; one from an
+// earlier day is uploaded as that day's final value. Every 10 minutes
+// "exposure" lines go out with period=day, stamped at local midnight so
+// each upload overwrites the day's point, and period=hour (the rolling
+// last hour); a finished day is sent once more with complete=1.
+#if EXPOSURE_ENABLED
+static constexpr unsigned long EXPOSURE_INTERVAL_MS = 600000;
+static constexpr uint32_t EXPOSURE_CHECKPOINT_MAGIC = 0x45585031; // "EXP1"
+// A line of five fields and the complete flag
+static constexpr size_t EXPOSURE_LINE_SIZE = SERIES_KEY_SIZE + 128;
+
+struct ExposureCheckpoint {
+  uint32_t magic;
+  uint32_t dayStart; // epoch of the day's local midnight
+  Exposure::Totals day;
+};
+
+uint32_t exposureDayStart = 0; // 0 until the clock syncs
+uint32_t exposureNextDay = 0;
+uint32_t exposureFinishedDay = 0; // a day awaiting its final upload, or 0
+unsigned long lastExposureCheckpoint = 0;
+unsigned long lastExposureUpload = 0;
+
+// Local midnight at or before epoch, and the next one
+static void localDayBounds(uint32_t epoch, uint32_t &start, uint32_t &next) {
+  const time_t t = epoch;
+  struct tm lt;
+  localtime_r(&t, &lt);
+  lt.tm_hour = 0;
+  lt.tm_min = 0;
+  lt.tm_sec = 0;
+  lt.tm_isdst = -1;
+  start = (uint32_t)mktime(&lt);
+  lt.tm_mday++;
+  lt.tm_isdst = -1;
+  next = (uint32_t)mktime(&lt);
 }
 
+static void checkpointExposure() {
+  HEAP_GUARD_TRANSIENT(); // NVS handle and page cache
+  prefs.begin("exposure", false);
+  for (uint8_t i = 0; i < CONFIG.sensorCount; ++i) {
+    const ExposureCheckpoint c = {EXPOSURE_CHECKPOINT_MAGIC, exposureDayStart,
+                                  sensorNodes[i]->exposure.day()};
+    char key[4];
+    snprintf(key, sizeof(key), "s%u", (unsigned)i);
+    prefs.putBytes(key, &c, sizeof(c));
+  }
+  prefs.end();
+  lastExposureCheckpoint = millis();
+}
+
+static void restoreExposure() {
+  HEAP_GUARD_TRANSIENT();
+  prefs.begin("exposure", true);
+  for (uint8_t i = 0; i < CONFIG.sensorCount; ++i) {
+    SensorNode &node = *sensorNodes[i];
+    ExposureCheckpoint c;
+    char key[4];
+    snprintf(key, sizeof(key), "s%u", (unsigned)i);
+    if (prefs.getBytes(key, &c, sizeof(c)) != sizeof(c) ||
+        c.magic != EXPOSURE_CHECKPOINT_MAGIC)
+      continue;
+    if (c.dayStart == exposureDayStart) {
+      node.exposure.restoreDay(c.day);
+      logPrintf("[Exposure] %s: restored %.2f h of today\n",
+                sensorLabel(i), c.day.coveredH);
+    } else if (c.dayStart < exposureDayStart) {
+      node.finishedDay = c.day;
+      exposureFinishedDay = c.dayStart;
+    }
+  }
+  prefs.end();
+}
+
+// Places the day at the first clock sync, rolls it over at local midnight
+// and checkpoints; called before each round's samples are added
+static void updateExposureDay() {
+  if (!clockValid())
+    return;
+  const uint32_t now = wallClock.toEpochSeconds(millis());
+  if (exposureDayStart == 0) {
+    localDayBounds(now, exposureDayStart, exposureNextDay);
+    restoreExposure();
+    lastExposureCheckpoint = millis();
+    return;
+  }
+  if (now >= exposureNextDay) {
+    for (uint8_t i = 0; i < CONFIG.sensorCount; ++i) {
+      SensorNode &node = *sensorNodes[i];
+      node.finishedDay = node.exposure.day();
+      node.exposure.newDay();
+      logPrintf("[Exposure] %s day: PM2.5 %.1f ug*h/m3, CO2 excess %.1f "
+                "ppm*h, over WHO PM2.5 %.2f h / PM10 %.2f h, %.2f h "
+                "covered\n",
+                sensorLabel(i), node.finishedDay.pm25Dose,
+                node.finishedDay.co2Excess, node.finishedDay.pm25OverH,
+                node.finishedDay.pm10OverH, node.finishedDay.coveredH);
+    }
+    exposureFinishedDay = exposureDayStart;
+    localDayBounds(now, exposureDayStart, exposureNextDay);
+    checkpointExposure();
+  } else if (millis() - lastExposureCheckpoint >= EXPOSURE_INTERVAL_MS) {
+    checkpointExposure();
+  }
+}
+
+static void encodeExposure(LineProtocolWriter &w, const char *key,
+                           const Exposure::Totals &t, uint32_t epoch,
+                           bool complete) {
+  w.seriesKey(key);
+  w.field("pm2_5_dose", t.pm25Dose, 2);
+  if (Sen66Protocol::BuildModel::HAS_CO2)
+    w.field("co2_excess", t.co2Excess, 1);
+  w.field("pm2_5_over_who_h", t.pm25OverH, 3);
+  w.field("pm10_over_who_h", t.pm10OverH, 3);
+  w.field("covered_h", t.coveredH, 3);
+  if (complete)
+    w.field("complete", (int32_t)1);
+  w.endLine(epoch);
+}
+
+static void sendExposureToInflux() {
+  if (exposureDayStart == 0 || !wifiUp())
+    return;
+  static char body[3 * EXPOSURE_LINE_SIZE * CONFIG.sensorCount];
+  LineProtocolWriter w(body, sizeof(body));
+  const uint32_t now = wallClock.toEpochSeconds(millis());
+  for (uint8_t i = 0; i < CONFIG.sensorCount; ++i) {
+    const SensorNode &node = *sensorNodes[i];
+    if (exposureFinishedDay != 0)
+      encodeExposure(w, node.exposureDayKey, node.finishedDay,
+                     exposureFinishedDay, true);
+    encodeExposure(w, node.exposureDayKey, node.exposure.day(),
+                   exposureDayStart, false);
+    encodeExposure(w, node.exposureHourKey, node.exposure.hour(), now, false);
+  }
+  int code = timedPost(influxWriteUrl, influxHeaders, w.c_str(), w.length());
+  logPrintf("[InfluxDB] Exposure HTTP %d (%u bytes)\n", code,
+            (unsigned)w.length());
+  if (code >= 200 && code < 300)
+    exposureFinishedDay = 0;
+}
+#endif
+
 // ===== Weather Data Fetching =====
+#if WEATHER_ENABLED
+// Both responses are read into one static buffer and parsed with
+// ArduinoJson on a static arena, emptied before each parse. An Open-Meteo
+// "current" response is ~600 bytes; the arena holds one ArduinoJson 7
+// variant pool (up to 4 KB) plus the document's strings.
+static constexpr size_t WEATHER_RESPONSE_SIZE = 2048;
+static constexpr size_t WEATHER_JSON_ARENA_SIZE = 6144;
+
+char weatherResponse[WEATHER_RESPONSE_SIZE];
+alignas(8) uint8_t weatherJsonMemory[WEATHER_JSON_ARENA_SIZE];
+Arena weatherJsonArena(weatherJsonMemory, sizeof(weatherJsonMemory));
+
+class ArenaJsonAllocator : public ArduinoJson::Allocator {
+public:
+  explicit ArenaJsonAllocator(Arena &arena) : _arena(arena) {}
+  void *allocate(size_t size) override { return _arena.allocate(size); }
+  void deallocate(void *p) override { _arena.release(p); }
+  void *reallocate(void *p, size_t size) override {
+    return _arena.reallocate(p, size);
+  }
+
+private:
+  Arena &_arena;
+};
+
+ArenaJsonAllocator weatherJsonAllocator(weatherJsonArena);
+
+// GETs url into weatherResponse and parses it into doc, whose memory
+// must come from the (emptied) arena; the HTTP status, or 0 if the JSON
+// failed to parse
+static int fetchJson(const char *url, JsonDocument &doc, const char *what) {
+  size_t len = 0;
+  const int httpCode =
+      timedGet(url, weatherResponse, sizeof(weatherResponse), len);
+  if (httpCode != 200) {
+    logPrintf("[Weather] %s API failed: %d\n", what, httpCode);
+    return httpCode;
+  }
+  DeserializationError error;
+  {
+    TELEMETRY_SCOPE(Telemetry::STAGE_WEATHER_PARSE);
+    error = deserializeJson(doc, weatherResponse, len);
+  }
+  if (error) {
+    logPrintf("[Weather] %s JSON parse error: %s\n", what, error.c_str());
+    return 0;
+  }
+  return httpCode;
+}
+
 static WeatherData fetchWeatherData() {
   WeatherData wd = {};
   wd.valid = false;
   
-  #if !WEATHER_ENABLED
-    return wd;
-  #endif
-  
   // Check if cache is still valid
   if (lastWeatherData.valid && 
       (millis() - lastWeatherData.lastFetch) < WEATHER_CACHE_MS) {
@@ -293,70 +1927,34 @@ static WeatherData fetchWeatherData() {
     return lastWeatherData;
   }
   
-  if (WiFi.status() != WL_CONNECTED) {
+  if (!wifiUp()) {
     Serial.println("[Weather] WiFi not connected");
     return wd;
   }
   
-  HTTPClient http;
-  
   // Fetch current weather
-  String weatherUrl = String("https://api.open-meteo.com/v1/forecast?latitude=") +
-                      WEATHER_LATITUDE + "&longitude=" + WEATHER_LONGITUDE +
-                      "&current=temperature_2m,relative_humidity_2m,pressure_msl," +
-                      "wind_speed_10m,wind_direction_10m,weather_code,cloud_cover";
-  
   Serial.println("[Weather] Fetching weather data...");
-  http.begin(weatherUrl);
-  http.setTimeout(10000);
-  int httpCode = http.GET();
-  
-  if (httpCode != 200) {
-    Serial.printf("[Weather] Weather API failed: %d\n", httpCode);
-    http.end();
-    return wd;
-  }
-  
-  String payload = http.getString();
-  http.end();
-  
-  // Parse weather JSON
-  JsonDocument doc;
-  DeserializationError error = deserializeJson(doc, payload);
-  
-  if (error) {
-    Serial.printf("[Weather] JSON parse error: %s\n", error.c_str());
-    return wd;
+  {
+    weatherJsonArena.reset();
+    JsonDocument doc(&weatherJsonAllocator);
+    if (fetchJson(weatherUrl, doc, "Weather") != 200)
+      return wd;
+    JsonObject current = doc["current"];
+    wd.temperature = current["temperature_2m"] | NAN;
+    wd.humidity = current["relative_humidity_2m"] | NAN;
+    wd.pressure = current["pressure_msl"] | NAN;
+    wd.windSpeed = current["wind_speed_10m"] | NAN;
+    wd.windDirection = current["wind_direction_10m"] | 0;
+    wd.weatherCode = current["weather_code"] | 0;
+    wd.cloudCover = current["cloud_cover"] | 0;
   }
   
-  JsonObject current = doc["current"];
-  wd.temperature = current["temperature_2m"] | NAN;
-  wd.humidity = current["relative_humidity_2m"] | NAN;
-  wd.pressure = current["pressure_msl"] | NAN;
-  wd.windSpeed = current["wind_speed_10m"] | NAN;
-  wd.windDirection = current["wind_direction_10m"] | 0;
-  wd.weatherCode = current["weather_code"] | 0;
-  wd.cloudCover = current["cloud_cover"] | 0;
-  
   // Fetch air quality data
-  String aqiUrl = String("https://air-quality-api.open-meteo.com/v1/air-quality?latitude=") +
-                  WEATHER_LATITUDE + "&longitude=" + WEATHER_LONGITUDE +
-                  "&current=pm10,pm2_5,carbon_monoxide,nitrogen_dioxide," +
-                  "sulphur_dioxide,ozone,european_aqi,us_aqi";
-  
   Serial.println("[Weather] Fetching AQI data...");
-  http.begin(aqiUrl);
-  http.setTimeout(10000);
-  httpCode = http.GET();
-  
-  if (httpCode == 200) {
-    payload = http.getString();
-    http.end();
-    
-    JsonDocument aqiDoc;
-    error = deserializeJson(aqiDoc, payload);
-    
-    if (!error) {
+  {
+    weatherJsonArena.reset();
+    JsonDocument aqiDoc(&weatherJsonAllocator);
+    if (fetchJson(aqiUrl, aqiDoc, "AQI") == 200) {
       JsonObject aqiCurrent = aqiDoc["current"];
       wd.pm10 = aqiCurrent["pm10"] | NAN;
       wd.pm2_5 = aqiCurrent["pm2_5"] | NAN;
@@ -366,12 +1964,7 @@ static WeatherData fetchWeatherData() {
       wd.ozone = aqiCurrent["ozone"] | NAN;
       wd.europeanAqi = aqiCurrent["european_aqi"] | 0;
       wd.usAqi = aqiCurrent["us_aqi"] | 0;
-    } else {
-      Serial.printf("[Weather] AQI JSON parse error: %s\n", error.c_str());
     }
-  } else {
-    Serial.printf("[Weather] AQI API failed: %d\n", httpCode);
-    http.end();
   }
   
   wd.valid = true;
@@ -379,93 +1972,360 @@ static WeatherData fetchWeatherData() {
   lastWeatherData = wd;
   
   Serial.println("[Weather] Data fetched successfully");
-  Serial.printf("[Weather] Temp=%.1fC Humidity=%.0f%% Pressure=%.1fhPa\n", 
-                wd.temperature, wd.humidity, wd.pressure);
-  Serial.printf("[Weather] EU AQI=%d US AQI=%d PM2.5=%.1f PM10=%.1f\n",
-                wd.europeanAqi, wd.usAqi, wd.pm2_5, wd.pm10);
+  logPrintf("[Weather] Temp=%.1fC Humidity=%.0f%% Pressure=%.1fhPa\n", 
+            wd.temperature, wd.humidity, wd.pressure);
+  logPrintf("[Weather] EU AQI=%d US AQI=%d PM2.5=%.1f PM10=%.1f\n",
+            wd.europeanAqi, wd.usAqi, wd.pm2_5, wd.pm10);
   
   return wd;
 }
+#endif
 
-void loop() {
-  ArduinoOTA.handle();
-  bool ready = false;
-  if (!sen66.dataReady(ready)) {
-    Serial.println("dataReady() error");
-    delay(250);
-    return;
+// Retries sensors whose startMeasurement() failed, at most once a second.
+static void startPendingMeasurements() {
+  const unsigned long now = millis();
+  for (uint8_t i = 0; i < sensors.size(); ++i) {
+    SensorNode &node = *sensorNodes[i];
+    if (node.sen66.measurementRunning()) {
+      node.startBackoffMs = 0;
+      continue;
+    }
+    if (node.cleaningReason) // restarted by serviceFanCleaning()
+      continue;
+    if (node.startBackoffMs != 0 &&
+        now - node.startAttemptMs < node.startBackoffMs)
+      continue;
+    node.startAttemptMs = now;
+    if (node.sen66.startMeasurement()) {
+      node.startBackoffMs = 0;
+      continue;
+    }
+    node.startBackoffMs =
+        node.startBackoffMs == 0 ? SENSOR_START_BACKOFF_MIN_MS
+                                 : node.startBackoffMs * 2;
+    if (node.startBackoffMs > SENSOR_START_BACKOFF_MAX_MS)
+      node.startBackoffMs = SENSOR_START_BACKOFF_MAX_MS;
+    logPrintf("%s startMeasurement() failed, next try in %lu s\n",
+              sensorLabel(i), node.startBackoffMs / 1000);
   }
-  if (!ready) {
-    delay(50);
+}
+
+// ===== Fan cleaning =====
+// Nothing waits the stop's STOP_EXEC_TIME_MS or the FAN_CLEANING_TIME_MS
+// out: beginFanCleaning() stops the sensor, which drops it from the
+// acquisition rounds, and serviceFanCleaning() starts the fan and later
+// restores the sensor from loop() once each time is up. Only called
+// between rounds (after poll() delivered), so no read is pending.
+static void startFanCleaning(uint8_t i, const char *reason) {
+  SensorNode &node = *sensorNodes[i];
+  if (node.cleaningReason)
+    return;
+  node.sen66.beginFanCleaning();
+  node.cleaningReason = reason;
+  node.cleaningSince = millis();
+  node.fanRunning = false;
+}
+
+// Epoch seconds of each sensor's last fan cleaning in NVS, 0 if unknown
+static uint32_t lastFanCleaningEpoch(uint8_t i) {
+  HEAP_GUARD_TRANSIENT(); // NVS handle and page cache
+  prefs.begin("fanclean", true);
+  char key[4];
+  snprintf(key, sizeof(key), "s%u", (unsigned)i);
+  const uint32_t epoch = prefs.getUInt(key, 0);
+  prefs.end();
+  return epoch;
+}
+
+static void saveFanCleaning(uint8_t i, unsigned long monoMs) {
+  if (!clockValid())
     return;
+  HEAP_GUARD_TRANSIENT();
+  prefs.begin("fanclean", false);
+  char key[4];
+  snprintf(key, sizeof(key), "s%u", (unsigned)i);
+  prefs.putUInt(key, wallClock.toEpochSeconds(monoMs));
+  prefs.end();
+}
+
+static bool bootFanCleaningDue(uint8_t i) {
+  if (!clockValid())
+    return true;
+  const uint32_t last = lastFanCleaningEpoch(i);
+  const uint32_t now = wallClock.toEpochSeconds(millis());
+  if (last == 0 || last > now ||
+      (uint64_t)(now - last) * 1000 >= CONFIG.fanCleaningIntervalMs)
+    return true;
+  logPrintf("%s fan cleaned %lu h ago, no boot cleaning\n", sensorLabel(i),
+            (unsigned long)((now - last) / 3600));
+  return false;
+}
+
+static void serviceFanCleaning() {
+  const unsigned long now = millis();
+  for (uint8_t i = 0; i < CONFIG.sensorCount; ++i) {
+    SensorNode &node = *sensorNodes[i];
+    if (!node.cleaningReason)
+      continue;
+    if (!node.fanRunning) {
+      if (now - node.cleaningSince < Sen66::STOP_EXEC_TIME_MS)
+        continue;
+      if (!node.sen66.cleanFan()) {
+        // startPendingMeasurements() takes over
+        logPrintf("%s fan cleaning (%s) failed\n", sensorLabel(i),
+                  node.cleaningReason);
+        node.cleaningReason = nullptr;
+        continue;
+      }
+      node.fanRunning = true;
+      node.cleaningSince = now;
+      continue;
+    }
+    if (now - node.cleaningSince < Sen66::FAN_CLEANING_TIME_MS)
+      continue;
+    const char *reason = node.cleaningReason;
+    node.cleaningReason = nullptr;
+    saveFanCleaning(i, node.cleaningSince);
+    if (!node.sen66.finishFanCleaning()) {
+      // startPendingMeasurements() takes over
+      logPrintf("%s fan cleaning (%s) failed to restart the measurement\n",
+                sensorLabel(i), reason);
+      continue;
+    }
+    logPrintf("%s fan cleaning (%s) finished (state restored).\n",
+              sensorLabel(i), reason);
+#if INFLUX_ENABLED
+    // An events line like the detectors', with the next upload
+    Events::Event e = {};
+    e.startMs = node.cleaningSince;
+    e.endMs = now;
+    queueEvent(i, "fan_cleaning", 0, e);
+#endif
+#if VENTILATION_ENABLED
+    node.lastFanCleaning = now;
+#endif
   }
+}
 
-  Sen66::MeasuredValues mv{};
-  Sen66::NumberConcentration nc{};
-  uint32_t statusFlags = 0;
+static void handleEvent(uint8_t i, uint8_t d) {
+  const SensorNode &node = *sensorNodes[i];
+  const Events::Config &c = node.events.config(d);
+  const Events::Event &e = node.events.detector(d).event();
+  const int digits = ENVIRONMENT_FIELDS[c.signal].digits;
+  if (e.active)
+    logPrintf("[Events] %s %s started %lu s ago, magnitude %.*f\n",
+              sensorLabel(i), c.type,
+              (unsigned long)((millis() - e.startMs) / 1000), digits,
+              e.magnitude);
+  else
+    logPrintf("[Events] %s %s ended after %lu s, magnitude %.*f\n",
+              sensorLabel(i), c.type,
+              (unsigned long)((e.endMs - e.startMs) / 1000), digits,
+              e.magnitude);
+#if INFLUX_ENABLED
+  queueEvent(i, c.type, digits, e);
+#endif
 
-  if (!sen66.readMeasuredValues(mv)) {
-    Serial.println("readMeasuredValues() failed, retrying...");
-    delay(50);
-    if (!sen66.readMeasuredValues(mv)) {
-      Serial.println("readMeasuredValues() failed again");
-      delay(200);
-      return;
+#if VENTILATION_ENABLED
+  // Automatic fan cleaning after ventilation
+  if (d == DETECTOR_VENTILATION && e.active) {
+    const unsigned long now = millis();
+    if (now - node.lastFanCleaning > CONFIG.fanCleaningCooldownMs ||
+        node.lastFanCleaning == 0) {
+      Serial.println("Triggering Fan Cleaning due to ventilation event...");
+      // stopMeasurement/restore is integrated into the fan cleaning
+      startFanCleaning(i, "ventilation");
     }
   }
-  if (!sen66.readNumberConcentration(nc)) {
-    Serial.println("readNumberConcentration() failed");
-    delay(200);
+#endif
+}
+
+static void handleSample(uint8_t i) {
+  SensorNode &node = *sensorNodes[i];
+  const Sen66Array::Sample &s = sensors.sample(i);
+  i2cBuses[CONFIG.sensors[i].bus]->countSample();
+  const Sen66::MeasuredValues &mv = s.mv;
+  const Sen66::NumberConcentration &nc = s.nc;
+
+  if (!s.statusValid)
+    logPrintf("%s readDeviceStatus() failed\n", sensorLabel(i));
+
+  const float dp = dewPoint(mv.temperature_c, mv.humidity_rh);
+  if (*node.tag)
+    logPrintf("[%s] ", node.tag);
+  logPrintf("PM1.0=%.1f PM2.5=%.1f PM4.0=%.1f PM10=%.1f ug/m3 | RH=%.2f%% "
+            "T=%.2fC DP=%.2fC | VOC=%.1f NOx=%.1f | CO2=%.0f ppm\n",
+            mv.pm1_0, mv.pm2_5, mv.pm4_0, mv.pm10_0, mv.humidity_rh,
+            mv.temperature_c, dp, mv.voc_index, mv.nox_index, mv.co2_ppm);
+  if (Sen66Protocol::BuildModel::HAS_HCHO) {
+    if (*node.tag)
+      logPrintf("[%s] ", node.tag);
+    logPrintf("HCHO=%.1f ppb\n", mv.hcho_ppb);
+  }
+  if (*node.tag)
+    logPrintf("[%s] ", node.tag);
+  logPrintf("NC0.5=%.1f NC1.0=%.1f NC2.5=%.1f NC4.0=%.1f NC10=%.1f #/cm3 | "
+            "Status=0x%08lX\n",
+            nc.nc0_5, nc.nc1_0, nc.nc2_5, nc.nc4_0, nc.nc10_0,
+            (unsigned long)s.statusFlags);
+
+  node.sampleMs = s.readyMs;
+  node.seq++;
+#if RAW_CAPTURE_ENABLED
+  captureRawSample(i, s);
+#endif
+  History::Ticks ticks;
+  History::toTicks(mv, nc, ticks);
+  if (node.history)
+    node.history->append(s.readyMs, ticks);
+#if UPLINK_BINARY
+  uplinkSample(i, s, ticks, node.seq);
+#endif
+#if EXPOSURE_ENABLED
+  // Without CO2 (SEN65, SEN68) the PM doses are still integrated
+  node.exposure.add(s.readyMs, mv.pm2_5, mv.pm10_0,
+                    Sen66Protocol::BuildModel::HAS_CO2 ? mv.co2_ppm : 0.0f);
+#endif
+
+  // Event detectors; see handleEvent()
+  float values[ENV_FIELD_COUNT];
+  environmentFieldValues(mv, nc, values);
+  const uint32_t changed = node.events.update(s.readyMs, values);
+  for (uint8_t d = 0; changed != 0 && d < node.events.size(); ++d)
+    if (changed & (1u << d))
+      handleEvent(i, d);
+}
+
+static void reportHistory() {
+  for (uint8_t i = 0; i < CONFIG.sensorCount; ++i) {
+    const History::Store *h = sensorNodes[i]->history;
+    if (!h)
+      continue;
+    logPrintf("%s history: %lu samples over %lu s, %u/%u blocks, "
+              "%.2f B/sample\n",
+              sensorLabel(i), (unsigned long)h->samples(),
+              (unsigned long)((h->newestMs() - h->oldestMs()) / 1000),
+              (unsigned)h->blocks(), (unsigned)h->capacityBlocks(),
+              h->bytesPerSample());
+  }
+}
+
+#if HEAP_GUARD_ENABLED
+static void reportHeap() {
+  const HeapGuard::Stats h = HeapGuard::stats();
+  logPrintf("[Heap] %lu allocations (%lu B) since setup, last from %p; "
+            "%lu transient\n",
+            (unsigned long)h.allocations, (unsigned long)h.bytes,
+            h.lastCaller, (unsigned long)h.transient);
+}
+#endif
+
+void loop() {
+  applyTimeSync();
+  if (otaReady) {
+    // LAN services allocate per packet or request (ArduinoOTA reads each
+    // poll into a fresh buffer)
+    HEAP_GUARD_TRANSIENT();
+#if OTA_ENABLED
+    ArduinoOTA.handle();
+#endif
+#if DELTA_OTA_ENABLED
+    deltaServer.handleClient();
+#endif
+    serviceDiagServer();
+  }
+  serviceWifi();
+  TELEMETRY_SAMPLE_HEAP();
+
+  serviceFanCleaning();
+  startPendingMeasurements();
+  if (!sensors.poll(millis())) {
+    delay(10);
     return;
   }
-  if (!sen66.readDeviceStatus(statusFlags)) {
-    Serial.println("readDeviceStatus() failed");
+  TELEMETRY_RECORD(Telemetry::STAGE_SENSOR_READ, sensors.lastRoundMs() * 1000UL);
+
+  if (bootFirstSampleMs == 0) {
+    bootFirstSampleMs = millis();
+    logPrintf("[Boot] Time to first sample: %lu ms\n", bootFirstSampleMs);
   }
+  if (sensors.size() > 1)
+    logPrintf("[Sensors] round: %lu ms\n",
+              (unsigned long)sensors.lastRoundMs());
 
-  const float dp = dewPoint(mv.temperature_c, mv.humidity_rh);
-  Serial.printf("PM1.0=%.1f PM2.5=%.1f PM4.0=%.1f PM10=%.1f ug/m3 | RH=%.2f%% "
-                "T=%.2fC DP=%.2fC | VOC=%.1f NOx=%.1f | CO2=%.0f ppm\n",
-                mv.pm1_0, mv.pm2_5, mv.pm4_0, mv.pm10_0, mv.humidity_rh,
-                mv.temperature_c, dp, mv.voc_index, mv.nox_index, mv.co2_ppm);
-  Serial.printf("NC0.5=%.1f NC1.0=%.1f NC2.5=%.1f NC4.0=%.1f NC10=%.1f #/cm3 | "
-                "Status=0x%08lX\n",
-                nc.nc0_5, nc.nc1_0, nc.nc2_5, nc.nc4_0, nc.nc10_0, statusFlags);
-
-  // Ventilation Detection & Automatic Fan Cleaning
-  if (mv.valid_co2) {
-    ventilationDetector.addSample(mv.co2_ppm);
-    if (ventilationDetector.isVentilationDetected()) {
-      const unsigned long now = millis();
-      if (now - lastFanCleaning > FAN_CLEANING_COOLDOWN_MS ||
-          lastFanCleaning == 0) {
-        Serial.println("Triggering Fan Cleaning due to ventilation event...");
-        // stopMeasurement/restore is now integrated into startFanCleaning
-        if (sen66.startFanCleaning()) {
-          Serial.println("Fan cleaning finished (state restored).");
-          sendFanCleaningEventToInflux();
-          lastFanCleaning = now;
-        } else {
-          Serial.println("Failed to start fan cleaning.");
-        }
-        // No need to manual startMeasurement here
-      }
-    }
+#if EXPOSURE_ENABLED
+  updateExposureDay();
+#endif
+  for (uint8_t i = 0; i < sensors.size(); ++i)
+    if (sensors.newSample(i))
+      handleSample(i);
+
+  logI2cClock();
+  if (millis() - lastHistoryReport >= HISTORY_REPORT_INTERVAL_MS) {
+    lastHistoryReport = millis();
+    reportHistory();
+    reportI2c();
+#if HEAP_GUARD_ENABLED
+    reportHeap();
+#endif
   }
 
+#if INFLUX_ENABLED
   const unsigned long now = millis();
-  if (now - lastSend < MEASUREMENT_INTERVAL_MS) {
-    delay(50);
+  // The first sample is uploaded as soon as the network is up
+  bool due = lastSend == 0 || now - lastSend >= CONFIG.measurementIntervalMs;
+#if UPLINK_BINARY
+  due = due || uplinkDue();
+#endif
+  // Without a link (boot association, an outage) the upload stays due and
+  // goes out as soon as serviceWifi() has it back; sampling goes on
+  if (!due || !wifiUp())
     return;
-  }
   lastSend = now;
 
-  if (WiFi.status() != WL_CONNECTED)
-    wifiConnect();
-  if (WiFi.status() != WL_CONNECTED)
-    return;
+#if WEATHER_ENABLED
+  // Skip the (slow, HTTPS) weather fetch for the very first upload; it is
+  // picked up on the next cycle.
+  WeatherData wd = {};
+  if (bootFirstUploadMs != 0)
+    wd = fetchWeatherData();
+#endif
 
-  // Fetch external weather data
-  WeatherData wd = fetchWeatherData();
+  if (sendToInflux()) {
+#if DELTA_OTA_ENABLED
+    confirmRunningApp();
+#endif
+    if (bootFirstUploadMs == 0) {
+      bootFirstUploadMs = millis();
+      logPrintf("[Boot] Time to first upload: %lu ms (first sample: %lu ms)\n",
+                bootFirstUploadMs, bootFirstSampleMs);
+    }
+  }
+#if WEATHER_ENABLED
+  sendWeatherToInflux(wd);
+#endif
+
+#if TELEMETRY_ENABLED
+  if (millis() - lastTelemetry >= TELEMETRY_INTERVAL_MS) {
+    lastTelemetry = millis();
+    sendTelemetryToInflux();
+  }
+#endif
+#if EXPOSURE_ENABLED
+  if (millis() - lastExposureUpload >= EXPOSURE_INTERVAL_MS) {
+    lastExposureUpload = millis();
+    sendExposureToInflux();
+  }
+#endif
+#endif
 
-  sendToInflux(mv, nc, statusFlags, wd);
+  // Deferred boot maintenance, off the time-to-first-upload path. All
+  // sensors due clean at once, so the gap in the data is paid only once.
+  if (bootFanCleaningPending &&
+      (clockValid() || millis() >= BOOT_FAN_CLEANING_CLOCK_WAIT_MS)) {
+    bootFanCleaningPending = false;
+    for (uint8_t i = 0; i < CONFIG.sensorCount; ++i)
+      if (bootFanCleaningDue(i))
+        startFanCleaning(i, "boot");
+  }
 }
@@ -0,0 +1,131 @@
+// src/sim/Sim.cpp
+#include "Sim.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "HeapGuard.h"
+#include "SimReport.h"
+
+namespace Sim {
+
+static uint64_t clockUs = 0;
+static double driftPpm = 0;
+
+struct Timer {
+  uint64_t atUs;
+  void (*fn)();
+};
+static std::vector<Timer> timers;
+
+struct Outage {
+  uint64_t start;
+  uint64_t end;
+};
+static std::vector<Outage> outages;
+
+static double i2cNoise = 0;
+static uint32_t i2cRng = 0x5E66;
+
+Report &report() {
+  static Report r;
+  return r;
+}
+
+uint64_t nowUs() { return clockUs; }
+
+void advanceUs(uint64_t us) {
+  clockUs += us;
+  for (size_t i = 0; i < timers.size();) {
+    if (timers[i].atUs > clockUs) {
+      ++i;
+      continue;
+    }
+    void (*fn)() = timers[i].fn;
+    timers.erase(timers.begin() + i);
+    // Another task on the ESP32: out of the heap guard's count
+    HEAP_GUARD_PAUSED();
+    fn(); // may schedule again
+    i = 0;
+  }
+}
+
+void setDriftPpm(double ppm) { driftPpm = ppm; }
+
+uint64_t localUs() { return clockUs + (int64_t)(clockUs * driftPpm * 1e-6); }
+
+void schedule(uint64_t atUs, void (*fn)()) { timers.push_back(Timer{atUs, fn}); }
+
+void event(const char *fmt, ...) {
+  HEAP_GUARD_PAUSED();
+  char buf[256];
+  va_list args;
+  va_start(args, fmt);
+  vsnprintf(buf, sizeof(buf), fmt, args);
+  va_end(args);
+  report().timeline.push_back(TimelineEntry{clockUs, buf});
+}
+
+void serialWrite(const char *s, size_t len) {
+  static bool atLineStart = true;
+  report().serialBytes += len;
+  if (!report().verbose)
+    return;
+  for (size_t i = 0; i < len; ++i) {
+    if (atLineStart) {
+      printf("[%s] ", formatTime(clockUs));
+      atLineStart = false;
+    }
+    putchar(s[i]);
+    if (s[i] == '\n')
+      atLineStart = true;
+  }
+}
+
+void addOutage(uint64_t startUs, uint64_t durationUs) {
+  outages.push_back(Outage{startUs, startUs + durationUs});
+}
+
+bool linkAvailable() {
+  for (const Outage &o : outages) {
+    if (clockUs >= o.start && clockUs < o.end)
+      return false;
+  }
+  return true;
+}
+
+bool nextOutage(uint64_t atUs, uint64_t &startUs, uint64_t &endUs) {
+  bool found = false;
+  for (const Outage &o : outages) {
+    if (o.end > atUs && (!found || o.start < startUs)) {
+      startUs = o.start;
+      endUs = o.end;
+      found = true;
+    }
+  }
+  return found;
+}
+
+void setI2cNoise(double probability) { i2cNoise = probability; }
+
+bool i2cGlitch(uint32_t freq) {
+  if (freq <= 100000 || i2cNoise <= 0)
+    return false;
+  i2cRng = i2cRng * 1664525u + 1013904223u;
+  return (i2cRng >> 8) < i2cNoise * 16777216.0;
+}
+
+const char *formatTime(uint64_t us) {
+  static char buf[32];
+  const uint64_t ms = us / 1000;
+  snprintf(buf, sizeof(buf), "%02llu:%02llu:%02llu.%03llu",
+           (unsigned long long)(ms / 3600000),
+           (unsigned long long)(ms / 60000 % 60),
+           (unsigned long long)(ms / 1000 % 60),
+           (unsigned long long)(ms % 1000));
+  return buf;
+}
+
+} // namespace Sim
@@ -0,0 +1,51 @@
+// src/sim/Sim.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+  Virtual clock and bookkeeping shared by the Arduino shims.
+
+  The firmware never sees wall time: millis()/micros()/delay() read and
+  advance Sim::nowUs(), and every shimmed peripheral (I2C, WiFi, HTTP)
+  advances it by a modeled latency. A simulated day therefore costs only
+  the CPU time of the loop() iterations themselves.
+*/
+namespace Sim {
+
+uint64_t nowUs();
+void advanceUs(uint64_t us);
+inline void advanceMs(uint64_t ms) { advanceUs(ms * 1000ULL); }
+
+// The node's oscillator: millis()/micros() run on localUs(), which is
+// off true (wall) time by the drift set with --drift-ppm.
+void setDriftPpm(double ppm);
+uint64_t localUs();
+// True wall clock [ms since epoch], whatever the node's clock says
+int64_t wallMs();
+
+// Runs fn once the clock reaches atUs, from inside whichever call
+// advances it past that point (like an ESP-IDF task preempting loop()).
+void schedule(uint64_t atUs, void (*fn)());
+
+// Appends an entry to the event timeline at the current virtual time.
+void event(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+// Serial output sink (echoed with virtual timestamps in --verbose mode)
+void serialWrite(const char *s, size_t len);
+
+// Scripted WiFi outages; false while inside one.
+void addOutage(uint64_t startUs, uint64_t durationUs);
+bool linkAvailable();
+// The first outage that ends after atUs; false if there is none
+bool nextOutage(uint64_t atUs, uint64_t &startUs, uint64_t &endUs);
+
+// Probability that an I2C read above 100 kHz returns a flipped bit (poor
+// wiring at fast mode); i2cGlitch() draws from a fixed-seed generator.
+void setI2cNoise(double probability);
+bool i2cGlitch(uint32_t freq);
+
+// "hh:mm:ss.mmm" (hours keep counting past 24)
+const char *formatTime(uint64_t us);
+
+} // namespace Sim
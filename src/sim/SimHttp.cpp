@@ -0,0 +1,167 @@
+// src/sim/SimHttp.cpp
+#include "SimHttp.h"
+
+#include <string.h>
+
+#include "Sim.h"
+#include "SimReport.h"
+#include "UplinkBatch.h"
+
+namespace SimHttp {
+
+static const char WEATHER_JSON[] =
+    "{\"current\":{\"temperature_2m\":11.4,\"relative_humidity_2m\":78,"
+    "\"pressure_msl\":1016.2,\"wind_speed_10m\":14.3,"
+    "\"wind_direction_10m\":240,\"weather_code\":3,\"cloud_cover\":92}}";
+
+static const char AQI_JSON[] =
+    "{\"current\":{\"pm10\":14.2,\"pm2_5\":8.9,\"carbon_monoxide\":182.0,"
+    "\"nitrogen_dioxide\":17.5,\"sulphur_dioxide\":1.9,\"ozone\":41.0,"
+    "\"european_aqi\":28,\"us_aqi\":37}}";
+
+// Fields in the field set of one line (after the first unescaped space)
+static uint32_t countFields(const char *line, size_t len) {
+  size_t i = 0;
+  while (i < len && line[i] != ' ')
+    i += line[i] == '\\' ? 2 : 1;
+  uint32_t fields = i < len ? 1 : 0;
+  for (++i; i < len && line[i] != ' '; ++i)
+    if (line[i] == ',')
+      ++fields;
+  return fields;
+}
+
+// True if the line ends with a timestamp (a second unescaped space)
+static bool hasTimestamp(const char *line, size_t len) {
+  uint8_t spaces = 0;
+  for (size_t i = 0; i < len; ++i) {
+    if (line[i] == '\\')
+      ++i;
+    else if (line[i] == ' ')
+      ++spaces;
+  }
+  return spaces >= 2;
+}
+
+static void countPoints(const char *body, size_t len) {
+  Sim::Report &r = Sim::report();
+  size_t pos = 0;
+  bool environment = false;
+  while (pos < len) {
+    const char *nl = (const char *)memchr(body + pos, '\n', len - pos);
+    const size_t end = nl ? (size_t)(nl - body) : len;
+    if (end > pos && body[pos] != '#') {
+      size_t m = pos;
+      while (m < end && body[m] != ',' && body[m] != ' ')
+        ++m;
+      const std::string measurement(body + pos, m - pos);
+      r.pointsByMeasurement[measurement]++;
+      if (measurement == "environment") {
+        environment = true;
+        r.environmentBytes += end - pos + 1;
+        r.environmentFields += countFields(body + pos, end - pos);
+        if (hasTimestamp(body + pos, end - pos))
+          r.environmentTimestamped++;
+        if (memmem(body + pos, end - pos, "time_unsynced=", 14))
+          r.environmentUnsynced++;
+      }
+      if (measurement == "events") {
+        Sim::event("events: %.*s", (int)(end - pos), body + pos);
+        // The end of a detector event repeats its line with active=0; a
+        // fan cleaning is only sent once it is done
+        const char *type =
+            (const char *)memmem(body + pos, end - pos, ",type=", 6);
+        if (type) {
+          type += 6;
+          const char *typeEnd = type;
+          while (typeEnd < body + end && *typeEnd != ',' && *typeEnd != ' ')
+            ++typeEnd;
+          const std::string name(type, typeEnd - type);
+          if (name == "fan_cleaning" ||
+              !memmem(body + pos, end - pos, " active=0", 9))
+            r.eventsByType[name]++;
+        }
+      }
+      // A finished exposure day
+      if (measurement == "exposure" &&
+          memmem(body + pos, end - pos, ",complete=1", 11))
+        Sim::event("exposure: %.*s", (int)(end - pos), body + pos);
+    }
+    pos = end + 1;
+  }
+  // Cadence is per request; a multi-sensor node sends one line per sensor
+  if (environment) {
+    if (r.environmentWritesUs.empty())
+      Sim::event("first environment upload");
+    r.environmentWritesUs.push_back(Sim::nowUs());
+  }
+}
+
+// Stands in for the bridge: decodes the batch as src/bridge would
+static int countBatch(const char *body, size_t len) {
+  Sim::Report &r = Sim::report();
+  Uplink::BatchReader reader((const uint8_t *)body, len);
+  Uplink::Record rec;
+  uint32_t records = 0;
+  if (reader.begin())
+    while (reader.next(rec))
+      records++;
+  if (reader.error()) {
+    Sim::event("uplink batch rejected: %s", reader.error());
+    return 400;
+  }
+  r.uplinkBatches++;
+  r.uplinkRecords += records;
+  r.uplinkBytes += len;
+  if (r.environmentWritesUs.empty())
+    Sim::event("first environment upload");
+  r.environmentWritesUs.push_back(Sim::nowUs());
+  return 204;
+}
+
+int handle(const char *method, const char *url, const char *body,
+           size_t bodyLen, std::string &response, uint32_t timeoutMs) {
+  Sim::Report &r = Sim::report();
+  response.clear();
+
+  if (!Sim::linkAvailable()) {
+    Sim::advanceMs(timeoutMs);
+    if (strstr(url, "/api/v2/write"))
+      r.writeFailures++;
+    if (strstr(url, "/sen66/v1/batch"))
+      r.uplinkFailures++;
+    return -1; // HTTPC_ERROR_CONNECTION_REFUSED
+  }
+
+  if (strcmp(method, "POST") == 0 && strstr(url, "/api/v2/write")) {
+    Sim::advanceMs(WRITE_LATENCY_MS);
+    r.writeRequests++;
+    r.writeBytes += bodyLen;
+    countPoints(body, bodyLen);
+    return 204;
+  }
+
+  if (strcmp(method, "POST") == 0 && strstr(url, "/sen66/v1/batch")) {
+    Sim::advanceMs(WRITE_LATENCY_MS);
+    return countBatch(body, bodyLen);
+  }
+
+  if (strstr(url, "air-quality-api.open-meteo.com")) {
+    Sim::advanceMs(HTTPS_GET_LATENCY_MS);
+    r.weatherRequests++;
+    response = AQI_JSON;
+    return 200;
+  }
+  if (strstr(url, "api.open-meteo.com")) {
+    Sim::advanceMs(HTTPS_GET_LATENCY_MS);
+    r.weatherRequests++;
+    response = WEATHER_JSON;
+    return 200;
+  }
+
+  Sim::advanceMs(WRITE_LATENCY_MS);
+  r.otherRequests++;
+  return 404;
+}
+
+} // namespace SimHttp
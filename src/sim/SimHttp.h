@@ -0,0 +1,25 @@
+// src/sim/SimHttp.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+/*
+  In-process stand-in for the HTTP endpoints the sensor node talks to:
+
+  - POST .../api/v2/write   204, counts points per measurement
+  - GET  api.open-meteo.com / air-quality-api.open-meteo.com   canned JSON
+
+  Each request advances the virtual clock by a modeled latency. While the
+  WiFi link is down requests fail after the client timeout.
+*/
+namespace SimHttp {
+
+// Modeled latencies
+constexpr uint32_t WRITE_LATENCY_MS = 90;
+constexpr uint32_t HTTPS_GET_LATENCY_MS = 850; // incl. TLS handshake
+
+int handle(const char *method, const char *url, const char *body,
+           size_t bodyLen, std::string &response, uint32_t timeoutMs);
+
+} // namespace SimHttp
@@ -0,0 +1,69 @@
+// src/sim/SimReport.h
+#pragma once
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace Sim {
+
+struct I2cSpeedStats {
+  uint32_t transactions = 0;
+  uint32_t failed = 0;    // NACK or timeout
+  uint32_t corrupted = 0; // reads with an injected bit flip
+  uint32_t samples = 0;   // SEN66 measured-values frames read
+  uint64_t busUs = 0;
+};
+
+struct TimelineEntry {
+  uint64_t atUs;
+  std::string text;
+};
+
+// Everything the simulator counts while the firmware runs.
+struct Report {
+  bool verbose = false;
+  uint64_t serialBytes = 0;
+
+  // HTTP stand-in
+  uint32_t writeRequests = 0;
+  uint32_t writeFailures = 0;
+  uint64_t writeBytes = 0;
+  std::map<std::string, uint32_t> pointsByMeasurement;
+  std::vector<uint64_t> environmentWritesUs;
+  uint64_t environmentBytes = 0; // environment lines incl. newline
+  uint32_t environmentFields = 0;
+  uint32_t environmentTimestamped = 0; // lines with an explicit timestamp
+  uint32_t environmentUnsynced = 0;    // time_unsynced=1, stamped by Influx
+  std::map<std::string, uint32_t> eventsByType; // started, by type tag
+  uint32_t uplinkBatches = 0; // binary uplink (src/bridge)
+  uint32_t uplinkFailures = 0;
+  uint32_t uplinkRecords = 0;
+  uint64_t uplinkBytes = 0;
+  uint32_t weatherRequests = 0;
+  uint32_t otherRequests = 0;
+
+  // Fake SEN66
+  uint32_t samplesProduced = 0;
+  uint32_t samplesRead = 0;
+  uint32_t rawFramesRead = 0;
+  uint32_t fanCleanings = 0;
+  uint32_t i2cTransactions = 0;
+  std::map<uint32_t, I2cSpeedStats> i2cBySpeed; // by SCL frequency [Hz]
+  uint32_t i2cBusClears = 0;
+  uint64_t maxSampleGapUs = 0;
+  uint32_t sampleGapsOver2s = 0;
+
+  // WiFi
+  uint32_t wifiBegins = 0;
+  uint32_t linkDrops = 0;
+
+  // Clock
+  uint32_t sntpSyncs = 0;
+
+  std::vector<TimelineEntry> timeline;
+};
+
+Report &report();
+
+} // namespace Sim
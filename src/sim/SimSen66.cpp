@@ -0,0 +1,448 @@
+// src/sim/SimSen66.cpp
+#include "SimSen66.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "FrameLog.h"
+#include "Sen66Protocol.h"
+#include "Sim.h"
+#include "SimReport.h"
+
+using Model = Sen66Protocol::BuildModel;
+using Sen66Protocol::Word;
+using Sen66Protocol::WordList;
+
+// ===== Trace =====
+bool SimTrace::loadCsv(const char *path) {
+  FILE *f = fopen(path, "r");
+  if (!f)
+    return false;
+  _rows.clear();
+  char line[512];
+  while (fgets(line, sizeof(line), f)) {
+    TraceSample s;
+    s.hcho = 20.0f;
+    if (sscanf(line, "%lf,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f", &s.t, &s.pm1_0,
+               &s.pm2_5, &s.pm4_0, &s.pm10, &s.humidity, &s.temperature,
+               &s.voc, &s.nox, &s.co2, &s.hcho) >= 10)
+      _rows.push_back(s);
+  }
+  fclose(f);
+  if (_rows.size() < 2)
+    return false;
+  _period = _rows.back().t + (_rows.back().t - _rows[_rows.size() - 2].t);
+  return true;
+}
+
+bool SimTrace::saveCsv(const char *path) const {
+  FILE *f = fopen(path, "w");
+  if (!f)
+    return false;
+  fprintf(f,
+          "t_s,pm1_0,pm2_5,pm4_0,pm10,humidity,temperature,voc,nox,co2,hcho\n");
+  for (const TraceSample &s : _rows)
+    fprintf(f, "%.0f,%.1f,%.1f,%.1f,%.1f,%.2f,%.2f,%.0f,%.0f,%.0f,%.1f\n",
+            s.t, s.pm1_0, s.pm2_5, s.pm4_0, s.pm10, s.humidity,
+            s.temperature, s.voc, s.nox, s.co2, s.hcho);
+  fclose(f);
+  return true;
+}
+
+static bool within(double h, double from, double to) {
+  return h >= from && h < to;
+}
+
+void SimTrace::synthesizeOfficeDay() {
+  _rows.clear();
+  const double step = 60.0;
+  double co2 = 430, pm = 4.0;
+  uint32_t lcg = 12345;
+  for (double t = 0; t < 86400.0; t += step) {
+    const double h = t / 3600.0;
+    const bool occupied = within(h, 8.5, 12.0) || within(h, 13.0, 17.5);
+    // Stosslueften: short, wide-open windows
+    const bool windowOpen = within(h, 10.0, 10.1) || within(h, 12.0, 12.2) ||
+                            within(h, 15.0, 15.1);
+    const bool cooking = within(h, 12.25, 12.6);
+
+    lcg = lcg * 1664525u + 1013904223u;
+    const float noise = (float)((lcg >> 16) % 7) - 3.0f;
+
+    TraceSample s;
+    s.t = t;
+    s.co2 = (float)co2 + noise;
+    s.pm2_5 = (float)pm;
+    s.pm1_0 = s.pm2_5 * 0.65f;
+    s.pm4_0 = s.pm2_5 * 1.12f;
+    s.pm10 = s.pm2_5 * 1.2f;
+    s.temperature = 21.0f + (occupied ? 1.2f : 0.0f) - (windowOpen ? 1.5f : 0);
+    s.humidity = 44.0f + (occupied ? 3.0f : 0.0f) - (windowOpen ? 4.0f : 0);
+    s.voc = 100.0f + (occupied ? 40.0f : 0.0f) + (cooking ? 180.0f : 0.0f);
+    s.nox = cooking ? 12.0f : 1.0f;
+    // Off-gassing furniture, more with people in, aired out by windows
+    s.hcho = 18.0f + (occupied ? 6.0f : 0.0f) + (cooking ? 25.0f : 0.0f) -
+             (windowOpen ? 10.0f : 0.0f) + noise * 0.5f;
+    _rows.push_back(s);
+
+    // Step to the next row: CO2 mass balance in ppm/min
+    const double gen = occupied ? 10.0 : 0.0;   // small meeting room
+    const double ach = windowOpen ? 30.0 : 0.5; // air changes per hour
+    co2 += gen - (ach / 60.0) * (co2 - 420.0);
+    // PM2.5 with a decaying cooking source
+    pm += (cooking ? 4.0 : 0.0) - (ach / 60.0 + 0.02) * (pm - 4.0);
+  }
+  _period = 86400.0;
+}
+
+static float lerp(float a, float b, double f) { return (float)(a + (b - a) * f); }
+
+TraceSample SimTrace::at(double tSec) const {
+  double t = fmod(tSec, _period);
+  size_t lo = 0, hi = _rows.size() - 1;
+  if (t >= _rows[hi].t)
+    return _rows[hi];
+  while (hi - lo > 1) {
+    const size_t mid = (lo + hi) / 2;
+    if (_rows[mid].t <= t)
+      lo = mid;
+    else
+      hi = mid;
+  }
+  const TraceSample &a = _rows[lo];
+  const TraceSample &b = _rows[hi];
+  const double f = (t - a.t) / (b.t - a.t);
+  TraceSample s;
+  s.t = tSec;
+  s.pm1_0 = lerp(a.pm1_0, b.pm1_0, f);
+  s.pm2_5 = lerp(a.pm2_5, b.pm2_5, f);
+  s.pm4_0 = lerp(a.pm4_0, b.pm4_0, f);
+  s.pm10 = lerp(a.pm10, b.pm10, f);
+  s.humidity = lerp(a.humidity, b.humidity, f);
+  s.temperature = lerp(a.temperature, b.temperature, f);
+  s.voc = lerp(a.voc, b.voc, f);
+  s.nox = lerp(a.nox, b.nox, f);
+  s.co2 = lerp(a.co2, b.co2, f);
+  s.hcho = lerp(a.hcho, b.hcho, f);
+  return s;
+}
+
+// ===== Device =====
+static const uint64_t FIRST_SAMPLE_US = 1100000; // after start measurement
+static const uint64_t SAMPLE_PERIOD_US = 1000000;
+static const uint64_t STOP_EXEC_US = 1000000;
+static const uint64_t FAN_CLEANING_US = 10000000;
+
+int64_t FakeSen66::currentSampleIndex() const {
+  if (!_measuring)
+    return -1;
+  const uint64_t now = Sim::nowUs();
+  if (now < _measStartUs + FIRST_SAMPLE_US)
+    return -1;
+  return (int64_t)((now - _measStartUs - FIRST_SAMPLE_US) / SAMPLE_PERIOD_US);
+}
+
+uint32_t FakeSen66::samplesProduced() const {
+  return _producedBefore + (uint32_t)(currentSampleIndex() + 1);
+}
+
+TraceSample FakeSen66::traceNow() const {
+  return _trace.at(Sim::nowUs() / 1e6 + _offsetSec);
+}
+
+uint8_t FakeSen66::onWrite(uint8_t, const uint8_t *data, size_t len) {
+  if (len == 0)
+    return 0; // address probe: ACK, nothing else
+  if (len < 2)
+    return 4;
+  const uint64_t now = Sim::nowUs();
+  if (now < _busyUntilUs)
+    return 3; // busy: NACK on data
+  const uint16_t cmd = (uint16_t)((data[0] << 8) | data[1]);
+  _pending = 0;
+  switch (cmd) {
+  case 0x0021: // start continuous measurement
+    if (!_measuring) {
+      _measuring = true;
+      _measStartUs = now;
+      _lastReadIndex = -1;
+      Sim::event("%s measurement started", _name);
+    }
+    break;
+  case 0x0104: // stop measurement
+    if (_measuring) {
+      _producedBefore = samplesProduced();
+      _measuring = false;
+      _busyUntilUs = now + STOP_EXEC_US;
+      Sim::event("%s measurement stopped", _name);
+    }
+    break;
+  case 0x5607: // fan cleaning, idle mode only
+    if (_measuring)
+      return 3;
+    _busyUntilUs = now + FAN_CLEANING_US;
+    Sim::report().fanCleanings++;
+    Sim::event("%s fan cleaning", _name);
+    break;
+  case 0x0202:
+  case Model::MEASURED_VALUES_CMD:
+  case 0x0316:
+  case Model::RAW_VALUES_CMD:
+  case 0xD206:
+  case 0xD033:
+    _pending = cmd;
+    break;
+  case 0x60B2: // temperature offset parameters
+    break;
+  default:
+    return 3;
+  }
+  return 0;
+}
+
+size_t FakeSen66::putWords(uint8_t *buf, size_t len, const uint16_t *words,
+                           size_t count) {
+  size_t n = 0;
+  for (size_t i = 0; i < count && n + 3 <= len; ++i) {
+    buf[n] = (uint8_t)(words[i] >> 8);
+    buf[n + 1] = (uint8_t)(words[i] & 0xFF);
+    buf[n + 2] = Sen66Protocol::crc8(buf + n, 2);
+    n += 3;
+  }
+  return n;
+}
+
+// Frame log: a new sample's measured values frame waits for the 0x0316
+// frame that follows it
+void FakeSen66::onDelivered(uint8_t, const uint8_t *buf, size_t len) {
+  if (!_frameLog || _deliveredCmd == 0)
+    return;
+  if (_deliveredCmd == Model::MEASURED_VALUES_CMD) {
+    if (_framePending)
+      writeFrames(nullptr); // the previous sample had no 0x0316 read
+    _frameMeasuredLen = len < sizeof(_frameMeasured) ? len : sizeof(_frameMeasured);
+    memcpy(_frameMeasured, buf, _frameMeasuredLen);
+    _frameMonoMs = (uint32_t)(Sim::localUs() / 1000);
+    _frameEpochMs = Sim::wallMs();
+    _framePending = true;
+  } else if (_deliveredCmd == 0x0316 && _framePending && len == 15) {
+    writeFrames(buf);
+  }
+}
+
+void FakeSen66::writeFrames(const uint8_t *numbers) {
+  const FrameColumns::Record r =
+      FrameColumns::makeRecord(_frameLogIndex, _frameMonoMs, _frameEpochMs,
+                               _frameMeasured, _frameMeasuredLen, numbers);
+  fwrite(&r, sizeof(r), 1, _frameLog);
+  _framePending = false;
+}
+
+static uint16_t scaled(float v, float scale) {
+  const float s = roundf(v * scale);
+  return s < 0 ? 0 : (s > 65534 ? 65534 : (uint16_t)s);
+}
+
+static uint16_t signedScaled(float v, float scale) {
+  return (uint16_t)(int16_t)roundf(v * scale);
+}
+
+// The words of a frame, in order
+template <Word... Ws> static const Word *frameWords(WordList<Ws...>) {
+  static const Word words[] = {Ws...};
+  return words;
+}
+
+// "Not available", as the sensor sends before its first sample
+static uint16_t absentWord(Word w) {
+  switch (w) {
+  case Sen66Protocol::W_HUMIDITY:
+  case Sen66Protocol::W_TEMPERATURE:
+  case Sen66Protocol::W_VOC:
+  case Sen66Protocol::W_NOX:
+  case Sen66Protocol::W_RAW_HUMIDITY:
+  case Sen66Protocol::W_RAW_TEMPERATURE:
+    return 0x7FFF;
+  default:
+    return 0xFFFF;
+  }
+}
+
+// Scaled as Sen66Protocol::WordCodec decodes it
+static uint16_t measuredWord(Word w, const TraceSample &s) {
+  switch (w) {
+  case Sen66Protocol::W_PM1_0:
+    return scaled(s.pm1_0, 10);
+  case Sen66Protocol::W_PM2_5:
+    return scaled(s.pm2_5, 10);
+  case Sen66Protocol::W_PM4_0:
+    return scaled(s.pm4_0, 10);
+  case Sen66Protocol::W_PM10_0:
+    return scaled(s.pm10, 10);
+  case Sen66Protocol::W_HUMIDITY:
+    return signedScaled(s.humidity, 100);
+  case Sen66Protocol::W_TEMPERATURE:
+    return signedScaled(s.temperature, 200);
+  case Sen66Protocol::W_VOC:
+    return signedScaled(s.voc, 10);
+  case Sen66Protocol::W_NOX:
+    return signedScaled(s.nox, 10);
+  case Sen66Protocol::W_CO2:
+    return scaled(s.co2, 1);
+  case Sen66Protocol::W_HCHO:
+    return scaled(s.hcho, 10);
+  default:
+    return absentWord(w);
+  }
+}
+
+// Uncompensated: the sensor reads warm and dry from self-heating. SGP41
+// ticks fall with VOC and rise with NOx; raw CO2 holds 5 s (co2Hold).
+static uint16_t rawWord(Word w, const TraceSample &s,
+                        const TraceSample &co2Hold) {
+  switch (w) {
+  case Sen66Protocol::W_RAW_HUMIDITY:
+    return signedScaled(s.humidity - 4.0f, 100);
+  case Sen66Protocol::W_RAW_TEMPERATURE:
+    return signedScaled(s.temperature + 1.5f, 200);
+  case Sen66Protocol::W_RAW_VOC:
+    return scaled(30000 - (s.voc - 100) * 40, 1);
+  case Sen66Protocol::W_RAW_NOX:
+    return scaled(15000 + (s.nox - 1) * 250, 1);
+  case Sen66Protocol::W_RAW_CO2:
+    return scaled(co2Hold.co2, 1);
+  default:
+    return absentWord(w);
+  }
+}
+
+size_t FakeSen66::onRead(uint8_t, uint8_t *buf, size_t len) {
+  const uint16_t cmd = _pending;
+  _pending = 0;
+  _deliveredCmd = 0;
+  Sim::Report &r = Sim::report();
+  const int64_t idx = currentSampleIndex();
+
+  if (cmd == 0x0202) {
+    const uint16_t ready = (idx >= 0 && idx > _lastReadIndex) ? 1 : 0;
+    return putWords(buf, len, &ready, 1);
+  }
+
+  if (cmd == Model::MEASURED_VALUES_CMD) {
+    const Word *words = frameWords(Model::MeasuredWords());
+    uint16_t w[Model::MeasuredWords::COUNT];
+    bool newSample = false;
+    if (idx < 0) {
+      for (uint8_t i = 0; i < Model::MeasuredWords::COUNT; ++i)
+        w[i] = absentWord(words[i]);
+    } else {
+      const TraceSample s = traceNow();
+      for (uint8_t i = 0; i < Model::MeasuredWords::COUNT; ++i)
+        w[i] = measuredWord(words[i], s);
+
+      if (idx > _lastReadIndex) {
+        newSample = true;
+        const uint64_t now = Sim::nowUs();
+        if (_samplesRead > 0) {
+          const uint64_t gap = now - _lastSampleReadUs;
+          if (gap > r.maxSampleGapUs)
+            r.maxSampleGapUs = gap;
+          if (gap > 2000000)
+            r.sampleGapsOver2s++;
+        }
+        _lastSampleReadUs = now;
+        _samplesRead++;
+        r.samplesRead++;
+        _lastReadIndex = idx;
+        if (!_firstSampleLogged) {
+          _firstSampleLogged = true;
+          Sim::event("%s first sample read", _name);
+        }
+      }
+    }
+    _deliveredCmd = newSample ? cmd : 0;
+    return putWords(buf, len, w, Model::MeasuredWords::COUNT);
+  }
+
+  if (cmd == 0x0316) {
+    const TraceSample s = traceNow();
+    const uint16_t w[5] = {scaled(s.pm1_0 * 6.8f, 10), scaled(s.pm1_0 * 8.0f, 10),
+                           scaled(s.pm2_5 * 5.2f, 10), scaled(s.pm4_0 * 4.6f, 10),
+                           scaled(s.pm10 * 4.3f, 10)};
+    _deliveredCmd = cmd;
+    return putWords(buf, len, w, 5);
+  }
+
+  if (cmd == Model::RAW_VALUES_CMD) {
+    const TraceSample s = traceNow();
+    const TraceSample co2 =
+        _trace.at(floor((Sim::nowUs() / 1e6 + _offsetSec) / 5) * 5);
+    const Word *words = frameWords(Model::RawWords());
+    uint16_t w[Model::RawWords::COUNT];
+    for (uint8_t i = 0; i < Model::RawWords::COUNT; ++i)
+      w[i] = rawWord(words[i], s, co2);
+    if (idx >= 0)
+      r.rawFramesRead++;
+    return putWords(buf, len, w, Model::RawWords::COUNT);
+  }
+
+  if (cmd == 0xD033) {
+    // "SIM" + name, NUL-padded to 32 chars
+    char serial[32] = "SIM";
+    strncat(serial, _name, sizeof(serial) - 4);
+    uint16_t w[16];
+    for (int i = 0; i < 16; ++i)
+      w[i] = (uint16_t)(((uint8_t)serial[2 * i] << 8) | (uint8_t)serial[2 * i + 1]);
+    return putWords(buf, len, w, 16);
+  }
+
+  if (cmd == 0xD206) {
+    const uint16_t w[2] = {0, 0};
+    return putWords(buf, len, w, 2);
+  }
+
+  return 0; // no response pending: NACK
+}
+
+// ===== Multiplexer =====
+SimI2cDevice *FakeTca9548a::selected(uint8_t addr) const {
+  for (uint8_t ch = 0; ch < 8; ++ch)
+    if ((_mask & (1u << ch)) && _channels[ch] && _channels[ch]->claims(addr))
+      return _channels[ch];
+  return nullptr;
+}
+
+bool FakeTca9548a::claims(uint8_t addr) const {
+  return addr == _addr || selected(addr) != nullptr;
+}
+
+uint8_t FakeTca9548a::onWrite(uint8_t addr, const uint8_t *data, size_t len) {
+  if (addr == _addr) {
+    if (len == 0)
+      return 0;
+    if (len != 1)
+      return 3;
+    _mask = data[0];
+    _selects++;
+    return 0;
+  }
+  SimI2cDevice *dev = selected(addr);
+  return dev ? dev->onWrite(addr, data, len) : 2;
+}
+
+size_t FakeTca9548a::onRead(uint8_t addr, uint8_t *buf, size_t len) {
+  if (addr == _addr) {
+    if (len > 0)
+      buf[0] = _mask;
+    return len > 0 ? 1 : 0;
+  }
+  SimI2cDevice *dev = selected(addr);
+  return dev ? dev->onRead(addr, buf, len) : 0;
+}
+
+void FakeTca9548a::onDelivered(uint8_t addr, const uint8_t *buf, size_t len) {
+  SimI2cDevice *dev = selected(addr);
+  if (dev)
+    dev->onDelivered(addr, buf, len);
+}
@@ -0,0 +1,130 @@
+// src/sim/SimSen66.h
+#pragma once
+#include <stdio.h>
+#include <vector>
+
+#include "shims/Wire.h"
+
+// One row of a SEN6x trace, in physical units. Each model reads the
+// columns it measures.
+struct TraceSample {
+  double t; // [s] since trace start
+  float pm1_0, pm2_5, pm4_0, pm10;
+  float humidity, temperature;
+  float voc, nox;
+  float co2;
+  float hcho; // [ppb]
+};
+
+/*
+  Scripted SEN6x input. Either loaded from CSV
+
+    t_s,pm1_0,pm2_5,pm4_0,pm10,humidity,temperature,voc,nox,co2,hcho
+    0,3.1,4.8,5.5,5.8,45.1,22.05,100,1,612,18
+    ...
+
+  (hcho may be left out: 20 ppb throughout)
+
+  or synthesized: one office day (occupancy, three window openings, a
+  lunch cooking spike). Values are linearly interpolated and the trace
+  repeats after its last row.
+*/
+class SimTrace {
+public:
+  bool loadCsv(const char *path);
+  void synthesizeOfficeDay();
+  bool saveCsv(const char *path) const;
+
+  TraceSample at(double tSec) const;
+  bool empty() const { return _rows.empty(); }
+
+private:
+  std::vector<TraceSample> _rows;
+  double _period = 0;
+};
+
+/*
+  Register-level SEN6x model on the simulated I2C bus: start/stop
+  measurement, 1 Hz data-ready, measured values / 0x0316 / raw values /
+  0xD206 reads with CRCs, fan cleaning (10 s, idle mode only). The value
+  reads are those of SEN6X_MODEL, their frames built from its word lists
+  (Sen6x.h), so the sim checks the driver of whichever model it is built
+  for. Several instances can share a trace; offsetSec shifts each one
+  along it.
+*/
+class FakeSen66 : public SimI2cDevice {
+public:
+  FakeSen66(const SimTrace &trace, const char *name, double offsetSec = 0)
+      : _trace(trace), _name(name), _offsetSec(offsetSec) {}
+
+  bool claims(uint8_t addr) const override { return addr == 0x6B; }
+  uint8_t onWrite(uint8_t addr, const uint8_t *data, size_t len) override;
+  size_t onRead(uint8_t addr, uint8_t *buf, size_t len) override;
+  void onDelivered(uint8_t addr, const uint8_t *buf, size_t len) override;
+
+  // Samples produced so far (whether read or not)
+  uint32_t samplesProduced() const;
+  uint32_t samplesRead() const { return _samplesRead; }
+  const char *name() const { return _name; }
+
+  // Appends each sample's value frames, as the firmware received them,
+  // to a frame log (lib/FrameColumns/FrameLog.h) as sensor `index`
+  void logFrames(FILE *log, uint8_t index) {
+    _frameLog = log;
+    _frameLogIndex = index;
+  }
+
+private:
+  int64_t currentSampleIndex() const;
+  TraceSample traceNow() const;
+  size_t putWords(uint8_t *buf, size_t len, const uint16_t *words,
+                  size_t count);
+  void writeFrames(const uint8_t *numbers);
+
+  const SimTrace &_trace;
+  const char *_name;
+  double _offsetSec;
+  uint32_t _samplesRead = 0;
+  uint64_t _lastSampleReadUs = 0;
+  bool _measuring = false;
+  uint64_t _measStartUs = 0;
+  int64_t _lastReadIndex = -1;
+  uint32_t _producedBefore = 0;
+  uint64_t _busyUntilUs = 0; // executing a stop or a fan cleaning
+  uint16_t _pending = 0;
+  bool _firstSampleLogged = false;
+  FILE *_frameLog = nullptr;
+  uint16_t _deliveredCmd = 0; // logged read in flight
+  uint8_t _frameLogIndex = 0;
+  bool _framePending = false;
+  uint8_t _frameMeasured[27];
+  size_t _frameMeasuredLen = 0;
+  uint32_t _frameMonoMs = 0;
+  int64_t _frameEpochMs = 0;
+};
+
+/*
+  TCA9548A model: control register at its own address, and forwards every
+  other transaction to the device attached on the selected channel.
+*/
+class FakeTca9548a : public SimI2cDevice {
+public:
+  explicit FakeTca9548a(uint8_t addr = 0x70) : _addr(addr) {}
+
+  void attach(uint8_t channel, SimI2cDevice *dev) { _channels[channel & 7] = dev; }
+
+  bool claims(uint8_t addr) const override;
+  uint8_t onWrite(uint8_t addr, const uint8_t *data, size_t len) override;
+  size_t onRead(uint8_t addr, uint8_t *buf, size_t len) override;
+  void onDelivered(uint8_t addr, const uint8_t *buf, size_t len) override;
+
+  uint32_t selects() const { return _selects; }
+
+private:
+  SimI2cDevice *selected(uint8_t addr) const;
+
+  uint8_t _addr;
+  uint8_t _mask = 0;
+  uint32_t _selects = 0;
+  SimI2cDevice *_channels[8] = {};
+};
@@ -0,0 +1,308 @@
+// src/sim/main.cpp
+//
+// Time-warp simulator: runs the sensor-node firmware (src/sen66) on the
+// host against shimmed Arduino APIs and a virtual clock.
+//
+//   pio run -e native_sim -t exec
+//   .pio/build/native_sim/program --hours 72 --outage 30:45 --timeline t.txt
+//
+// Options:
+//   --hours <h>          simulated duration (default 24)
+//   --trace <csv>        SEN66 trace (default: synthesized office day)
+//   --dump-trace <csv>   write the trace in use and continue
+//   --outage <h>:<min>   WiFi outage starting at hour h for min minutes
+//   --drift-ppm <ppm>    node oscillator rate error (default 20)
+//   --i2c-noise <p>      probability of a bit flip per I2C read above
+//                        100 kHz (marginal wiring at fast mode)
+//   --i2c-stuck <h>      a slave holds SDA low on Wire from hour h until
+//                        the firmware clears the bus
+//   --timeline <file>    write the full event timeline
+//   --frame-log <file>   record the fake sensors' value frames for
+//                        src/columns (lib/FrameColumns/FrameLog.h)
+//   --verbose            echo firmware Serial output with virtual time
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "FrameLog.h"
+#include "HeapGuard.h"
+#include "Sim.h"
+#include "SimReport.h"
+#include "SimSen66.h"
+#include "config.h"
+#include "shims/WiFi.h"
+#include "shims/Wire.h"
+
+// Firmware entry points (src/sen66/main.cpp)
+void setup();
+void loop();
+
+static uint64_t percentile(std::vector<uint32_t> &v, double pct) {
+  if (v.empty())
+    return 0;
+  const size_t k = std::min(v.size() - 1, (size_t)(pct / 100.0 * v.size()));
+  std::nth_element(v.begin(), v.begin() + k, v.end());
+  return v[k];
+}
+
+static void usage(const char *argv0) {
+  fprintf(stderr,
+          "usage: %s [--hours h] [--trace csv] [--dump-trace csv] "
+          "[--outage h:min]... [--drift-ppm ppm] [--i2c-noise p] "
+          "[--i2c-stuck h] [--timeline file] [--frame-log file] [--verbose]\n",
+          argv0);
+}
+
+static void stickWire() {
+  Sim::event("I2C: slave holds SDA low on Wire");
+  Wire.stick();
+}
+
+int main(int argc, char **argv) {
+  double hours = 24.0;
+  const char *tracePath = nullptr;
+  const char *dumpPath = nullptr;
+  const char *timelinePath = nullptr;
+  const char *frameLogPath = nullptr;
+  double driftPpm = 20.0;
+  Sim::Report &r = Sim::report();
+
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--hours") && i + 1 < argc) {
+      hours = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--trace") && i + 1 < argc) {
+      tracePath = argv[++i];
+    } else if (!strcmp(argv[i], "--dump-trace") && i + 1 < argc) {
+      dumpPath = argv[++i];
+    } else if (!strcmp(argv[i], "--outage") && i + 1 < argc) {
+      double at = 0, minutes = 0;
+      if (sscanf(argv[++i], "%lf:%lf", &at, &minutes) != 2) {
+        usage(argv[0]);
+        return 2;
+      }
+      Sim::addOutage((uint64_t)(at * 3600e6), (uint64_t)(minutes * 60e6));
+    } else if (!strcmp(argv[i], "--drift-ppm") && i + 1 < argc) {
+      driftPpm = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--i2c-noise") && i + 1 < argc) {
+      Sim::setI2cNoise(atof(argv[++i]));
+    } else if (!strcmp(argv[i], "--i2c-stuck") && i + 1 < argc) {
+      Sim::schedule((uint64_t)(atof(argv[++i]) * 3600e6), stickWire);
+    } else if (!strcmp(argv[i], "--timeline") && i + 1 < argc) {
+      timelinePath = argv[++i];
+    } else if (!strcmp(argv[i], "--frame-log") && i + 1 < argc) {
+      frameLogPath = argv[++i];
+    } else if (!strcmp(argv[i], "--verbose")) {
+      r.verbose = true;
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  SimTrace trace;
+  if (tracePath) {
+    if (!trace.loadCsv(tracePath)) {
+      fprintf(stderr, "cannot load trace %s\n", tracePath);
+      return 2;
+    }
+  } else {
+    trace.synthesizeOfficeDay();
+  }
+  if (dumpPath && !trace.saveCsv(dumpPath)) {
+    fprintf(stderr, "cannot write %s\n", dumpPath);
+    return 2;
+  }
+
+  FILE *frameLog = nullptr;
+  if (frameLogPath) {
+    frameLog = fopen(frameLogPath, "wb");
+    if (!frameLog) {
+      fprintf(stderr, "cannot write %s\n", frameLogPath);
+      return 2;
+    }
+    const FrameColumns::FileHeader h =
+        FrameColumns::fileHeader(Sen66Protocol::BuildModel::MODEL);
+    fwrite(&h, sizeof(h), 1, frameLog);
+  }
+
+  // Mirror the firmware's sensor layout (SEN66_SENSORS). Each fake runs
+  // 10 minutes further along the trace so the rooms differ.
+  TwoWire *buses[2] = {&Wire, &Wire1};
+  FakeTca9548a muxes[2];
+  bool muxAttached[2] = {false, false};
+  std::vector<std::unique_ptr<FakeSen66>> fakes;
+  for (uint8_t i = 0; i < CONFIG.sensorCount; ++i) {
+    const SensorConfig &l = CONFIG.sensors[i];
+    FakeSen66 *f = new FakeSen66(trace, *l.tag ? l.tag : "SEN66", i * 600.0);
+    fakes.emplace_back(f);
+    if (frameLog)
+      f->logFrames(frameLog, i);
+    if (l.muxChannel < 0) {
+      buses[l.bus]->attach(f);
+      continue;
+    }
+    muxes[l.bus].attach((uint8_t)l.muxChannel, f);
+    if (!muxAttached[l.bus]) {
+      buses[l.bus]->attach(&muxes[l.bus]);
+      muxAttached[l.bus] = true;
+    }
+  }
+
+  const uint64_t endUs = (uint64_t)(hours * 3600e6);
+  std::vector<uint32_t> loopUs;
+  loopUs.reserve((size_t)(hours * 3600 * 20));
+  uint64_t loopTotalUs = 0;
+  bool linkUp = false;
+
+  Sim::setDriftPpm(driftPpm);
+  const auto wall0 = std::chrono::steady_clock::now();
+  Sim::event("boot");
+  setup();
+  while (Sim::nowUs() < endUs) {
+    const uint64_t t0 = Sim::nowUs();
+    loop();
+    HEAP_GUARD_PAUSED(); // the harness's own bookkeeping
+    if (Sim::nowUs() == t0)
+      Sim::advanceUs(1); // guard against zero-time iterations
+    const uint64_t dt = Sim::nowUs() - t0;
+    loopUs.push_back(dt > UINT32_MAX ? UINT32_MAX : (uint32_t)dt);
+    loopTotalUs += dt;
+
+    const bool up = WiFi.status() == WL_CONNECTED;
+    if (up != linkUp) {
+      Sim::event("WiFi %s", up ? "connected" : "disconnected");
+      if (!up)
+        r.linkDrops++;
+      linkUp = up;
+    }
+  }
+  const double wallSec = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - wall0)
+                             .count();
+
+  // ===== Report =====
+  const double simSec = Sim::nowUs() / 1e6;
+  printf("Simulated %.1f h in %.2f s wall (%.0fx)\n", simSec / 3600.0, wallSec,
+         wallSec > 0 ? simSec / wallSec : 0.0);
+
+  printf("\nUploads\n");
+  printf("  write requests      %u (%u failed), %.1f KiB\n", r.writeRequests,
+         r.writeFailures, r.writeBytes / 1024.0);
+  for (const auto &kv : r.pointsByMeasurement)
+    printf("  %-19s %u points\n", kv.first.c_str(), kv.second);
+  printf("  environment lines   %u fields, %.1f KiB\n", r.environmentFields,
+         r.environmentBytes / 1024.0);
+  printf("  timestamps          %u environment lines, %u unsynced\n",
+         r.environmentTimestamped, r.environmentUnsynced);
+  if (r.uplinkBatches + r.uplinkFailures > 0)
+    printf("  uplink batches      %u (%u failed), %u samples, %.1f KiB\n",
+           r.uplinkBatches, r.uplinkFailures, r.uplinkRecords,
+           r.uplinkBytes / 1024.0);
+  for (const auto &kv : r.eventsByType)
+    printf("  event %-13s %u\n", kv.first.c_str(), kv.second);
+  printf("  weather GETs        %u\n", r.weatherRequests);
+  if (r.environmentWritesUs.size() > 1) {
+    uint64_t minGap = UINT64_MAX, maxGap = 0;
+    for (size_t i = 1; i < r.environmentWritesUs.size(); ++i) {
+      const uint64_t g = r.environmentWritesUs[i] - r.environmentWritesUs[i - 1];
+      minGap = std::min(minGap, g);
+      maxGap = std::max(maxGap, g);
+    }
+    const double mean = (double)(r.environmentWritesUs.back() -
+                                 r.environmentWritesUs.front()) /
+                        (r.environmentWritesUs.size() - 1);
+    printf("  environment cadence min %.1f s, mean %.1f s, max %.1f s\n",
+           minGap / 1e6, mean / 1e6, maxGap / 1e6);
+  }
+
+  printf("\nSensor\n");
+  for (const std::unique_ptr<FakeSen66> &f : fakes)
+    printf("  %-19s %u of %u samples read\n", f->name(), f->samplesRead(),
+           f->samplesProduced());
+  printf("  longest sample gap  %.1f s (%u gaps > 2 s)\n",
+         r.maxSampleGapUs / 1e6, r.sampleGapsOver2s);
+  if (r.rawFramesRead > 0)
+    printf("  raw frames          %u\n", r.rawFramesRead);
+  printf("  fan cleanings       %u\n", r.fanCleanings);
+  printf("  I2C transactions    %u\n", r.i2cTransactions);
+  for (auto it = r.i2cBySpeed.rbegin(); it != r.i2cBySpeed.rend(); ++it) {
+    const Sim::I2cSpeedStats &st = it->second;
+    printf("  I2C %3u kHz         %u transactions (%u failed, %u corrupted), "
+           "%.2f ms bus time/sample\n",
+           it->first / 1000, st.transactions, st.failed, st.corrupted,
+           st.samples ? st.busUs / 1e3 / st.samples : 0.0);
+  }
+  if (r.i2cBusClears > 0)
+    printf("  I2C bus clears      %u\n", r.i2cBusClears);
+  for (int b = 0; b < 2; ++b)
+    if (muxAttached[b])
+      printf("  mux on bus %d        %u channel selects\n", b,
+             muxes[b].selects());
+
+  printf("\nWiFi\n");
+  printf("  begin() calls       %u, link drops %u\n", r.wifiBegins,
+         r.linkDrops);
+
+  printf("\nClock\n");
+  printf("  SNTP syncs          %u, oscillator drift %+.1f ppm\n", r.sntpSyncs,
+         driftPpm);
+
+#if HEAP_GUARD_ENABLED
+  const HeapGuard::Stats heap = HeapGuard::stats();
+  printf("\nHeap (after setup)\n");
+  printf("  allocations         %u (%u B), %u transient\n",
+         heap.allocations, heap.bytes, heap.transient);
+#endif
+
+  printf("\nloop() stalls (virtual time per call)\n");
+  static const uint32_t EDGES[] = {1000, 10000, 100000, 1000000, 5000000,
+                                   15000000};
+  static const char *LABELS[] = {"< 1 ms",  "< 10 ms", "< 100 ms", "< 1 s",
+                                 "< 5 s",   "< 15 s",  ">= 15 s"};
+  uint64_t counts[7] = {0}, timeIn[7] = {0};
+  for (uint32_t us : loopUs) {
+    int b = 0;
+    while (b < 6 && us >= EDGES[b])
+      ++b;
+    counts[b]++;
+    timeIn[b] += us;
+  }
+  for (int b = 0; b < 7; ++b)
+    printf("  %-9s %10llu calls  %5.1f%% of time\n", LABELS[b],
+           (unsigned long long)counts[b],
+           loopTotalUs ? 100.0 * timeIn[b] / loopTotalUs : 0.0);
+  const size_t calls = loopUs.size();
+  const uint64_t p50 = percentile(loopUs, 50);
+  const uint64_t p99 = percentile(loopUs, 99);
+  const uint64_t p999 = percentile(loopUs, 99.9);
+  const uint64_t maxUs = loopUs.empty()
+                             ? 0
+                             : *std::max_element(loopUs.begin(), loopUs.end());
+  printf("  %zu calls, p50 %.1f ms, p99 %.1f ms, p99.9 %.1f ms, max %.1f ms\n",
+         calls, p50 / 1e3, p99 / 1e3, p999 / 1e3, maxUs / 1e3);
+
+  const size_t shown = std::min<size_t>(r.timeline.size(), 40);
+  printf("\nTimeline (%zu events%s)\n", r.timeline.size(),
+         r.timeline.size() > shown ? ", first 40; --timeline for all" : "");
+  for (size_t i = 0; i < shown; ++i)
+    printf("  %s  %s\n", Sim::formatTime(r.timeline[i].atUs),
+           r.timeline[i].text.c_str());
+
+  if (timelinePath) {
+    FILE *f = fopen(timelinePath, "w");
+    if (!f) {
+      fprintf(stderr, "cannot write %s\n", timelinePath);
+      return 2;
+    }
+    for (const Sim::TimelineEntry &e : r.timeline)
+      fprintf(f, "%s\t%s\n", Sim::formatTime(e.atUs), e.text.c_str());
+    fclose(f);
+  }
+  if (frameLog)
+    fclose(frameLog);
+  return 0;
+}
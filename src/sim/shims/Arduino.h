@@ -0,0 +1,195 @@
+// src/sim/shims/Arduino.h
+//
+// Minimal Arduino core for the host simulator: virtual-time millis()/
+// delay(), a std::string backed String, Serial and IPAddress.
+#pragma once
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <time.h>
+
+#include "../Sim.h"
+
+inline unsigned long millis() { return (unsigned long)(Sim::localUs() / 1000); }
+inline unsigned long micros() { return (unsigned long)Sim::localUs(); }
+inline void delay(unsigned long ms) { Sim::advanceMs(ms); }
+inline void delayMicroseconds(unsigned int us) { Sim::advanceUs(us); }
+inline void yield() {}
+// From a fixed seed, so runs repeat (the ESP32 core draws from the RNG)
+long random(long howbig);
+long random(long howsmall, long howbig);
+
+// GPIO: only the I2C pins are modeled, through the TwoWire they belong to
+// (bus clear of a stuck SDA, see Wire.h); other pins read HIGH.
+#define LOW 0x0
+#define HIGH 0x1
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define OUTPUT_OPEN_DRAIN 0x13
+inline void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+// SNTP stand-in: time() (overridden in shims.cpp) counts from boot like
+// the ESP32's until configTime() has "synced" to the virtual wall clock,
+// then resyncs hourly (see esp_sntp.h).
+void configTime(long gmtOffsetSec, int daylightOffsetSec, const char *server1,
+                const char *server2 = nullptr, const char *server3 = nullptr);
+
+class String {
+public:
+  String() {}
+  String(const char *s) : _s(s ? s : "") {}
+  String(const std::string &s) : _s(s) {}
+  explicit String(char c) : _s(1, c) {}
+  explicit String(int v) : _s(std::to_string(v)) {}
+  explicit String(unsigned int v) : _s(std::to_string(v)) {}
+  explicit String(long v) : _s(std::to_string(v)) {}
+  explicit String(unsigned long v) : _s(std::to_string(v)) {}
+  String(float v, unsigned int digits) { format(v, digits); }
+  String(double v, unsigned int digits) { format(v, digits); }
+
+  const char *c_str() const { return _s.c_str(); }
+  const char *data() const { return _s.data(); }
+  unsigned int length() const { return (unsigned int)_s.size(); }
+  size_t size() const { return _s.size(); }
+  bool isEmpty() const { return _s.empty(); }
+  char operator[](unsigned int i) const { return i < _s.size() ? _s[i] : 0; }
+
+  String &operator+=(const String &o) { _s += o._s; return *this; }
+  String &operator+=(const char *o) { _s += o; return *this; }
+  String &operator+=(char c) { _s += c; return *this; }
+  bool concat(const char *o) { _s += o; return true; }
+  bool concat(const char *o, unsigned int n) { _s.append(o, n); return true; }
+  bool concat(char c) { _s += c; return true; }
+
+  bool operator==(const String &o) const { return _s == o._s; }
+  bool operator==(const char *o) const { return _s == o; }
+  bool operator!=(const String &o) const { return _s != o._s; }
+
+  int indexOf(char c, unsigned int from = 0) const {
+    const size_t p = _s.find(c, from);
+    return p == std::string::npos ? -1 : (int)p;
+  }
+  String substring(unsigned int from, unsigned int to) const {
+    if (from > _s.size())
+      return String();
+    return String(_s.substr(from, to - from));
+  }
+  void trim() {
+    const size_t a = _s.find_first_not_of(" \t\r\n");
+    const size_t b = _s.find_last_not_of(" \t\r\n");
+    _s = (a == std::string::npos) ? std::string() : _s.substr(a, b - a + 1);
+  }
+  float toFloat() const { return strtof(_s.c_str(), nullptr); }
+  long toInt() const { return strtol(_s.c_str(), nullptr, 10); }
+
+private:
+  void format(double v, unsigned int digits) {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%.*f", (int)digits, v);
+    _s = buf;
+  }
+  std::string _s;
+};
+
+inline String operator+(const String &a, const String &b) {
+  String r(a);
+  r += b;
+  return r;
+}
+inline String operator+(const String &a, const char *b) {
+  String r(a);
+  r += b;
+  return r;
+}
+inline String operator+(const char *a, const String &b) {
+  String r(a);
+  r += b;
+  return r;
+}
+
+class IPAddress {
+public:
+  IPAddress() : _addr(0) {}
+  IPAddress(uint32_t addr) : _addr(addr) {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+      : _addr((uint32_t)a | ((uint32_t)b << 8) | ((uint32_t)c << 16) |
+              ((uint32_t)d << 24)) {}
+  operator uint32_t() const { return _addr; }
+  String toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", _addr & 0xFF,
+             (_addr >> 8) & 0xFF, (_addr >> 16) & 0xFF, _addr >> 24);
+    return String(buf);
+  }
+
+private:
+  uint32_t _addr;
+};
+
+#define INADDR_NONE IPAddress(0, 0, 0, 0)
+
+class SimSerial {
+public:
+  void begin(unsigned long) {}
+  operator bool() const { return true; }
+
+  size_t print(const char *s) { return write(s); }
+  size_t print(const String &s) { return write(s.c_str()); }
+  size_t print(char c) { char b[2] = {c, 0}; return write(b); }
+  size_t print(int v) { return printf("%d", v); }
+  size_t print(unsigned int v) { return printf("%u", v); }
+  size_t print(long v) { return printf("%ld", v); }
+  size_t print(unsigned long v) { return printf("%lu", v); }
+  size_t print(double v, int digits = 2) { return printf("%.*f", digits, v); }
+  size_t print(const IPAddress &ip) { return print(ip.toString()); }
+
+  size_t println() { return write("\n"); }
+  template <typename T> size_t println(const T &v) {
+    return print(v) + println();
+  }
+
+  // Like the ESP32 core's Print::printf(), which formats into a 64-byte
+  // stack buffer and mallocs a larger one for longer output
+  size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3))) {
+    char buf[64];
+    va_list args, again;
+    va_start(args, fmt);
+    va_copy(again, args);
+    const int n = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    size_t written = 0;
+    if (n >= 0 && (size_t)n < sizeof(buf)) {
+      written = write(buf);
+    } else if (n >= 0) {
+      char *big = (char *)malloc((size_t)n + 1);
+      if (big) {
+        vsnprintf(big, (size_t)n + 1, fmt, again);
+        written = write(big);
+        free(big);
+      }
+    }
+    va_end(again);
+    return written;
+  }
+
+  size_t write(const uint8_t *buf, size_t len) {
+    Sim::serialWrite((const char *)buf, len);
+    return len;
+  }
+
+private:
+  size_t write(const char *s) {
+    const size_t n = strlen(s);
+    Sim::serialWrite(s, n);
+    return n;
+  }
+};
+
+extern SimSerial Serial;
@@ -0,0 +1,32 @@
+// src/sim/shims/ArduinoOTA.h
+#pragma once
+#include <Arduino.h>
+#include <functional>
+
+#define U_FLASH 0
+#define U_SPIFFS 100
+
+typedef enum {
+  OTA_AUTH_ERROR,
+  OTA_BEGIN_ERROR,
+  OTA_CONNECT_ERROR,
+  OTA_RECEIVE_ERROR,
+  OTA_END_ERROR
+} ota_error_t;
+
+// Accepts the configuration and never receives an update.
+class SimArduinoOTA {
+public:
+  void setHostname(const char *) {}
+  void setPassword(const char *) {}
+  void setPort(uint16_t) {}
+  void onStart(std::function<void()>) {}
+  void onEnd(std::function<void()>) {}
+  void onProgress(std::function<void(unsigned int, unsigned int)>) {}
+  void onError(std::function<void(ota_error_t)>) {}
+  int getCommand() { return U_FLASH; }
+  void begin() { Sim::event("OTA ready"); }
+  void handle() {}
+};
+
+extern SimArduinoOTA ArduinoOTA;
@@ -0,0 +1,35 @@
+// src/sim/shims/HTTPClient.h
+//
+// HTTPClient that talks to the in-process HTTP stand-in (SimHttp.h)
+// instead of the network.
+#pragma once
+#include <Arduino.h>
+
+#define HTTP_CODE_OK 200
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_TOO_LESS_RAM (-8)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+class HTTPClient {
+public:
+  bool begin(const String &url) {
+    _url = url;
+    _response = String();
+    return true;
+  }
+  void addHeader(const String &, const String &) {}
+  void setTimeout(uint16_t ms) { _timeoutMs = ms; }
+  void setReuse(bool) {}
+  int GET();
+  int POST(const uint8_t *payload, size_t size);
+  int POST(const String &payload) {
+    return POST((const uint8_t *)payload.c_str(), payload.length());
+  }
+  String getString() { return _response; }
+  void end() {}
+
+private:
+  String _url;
+  String _response;
+  uint16_t _timeoutMs = 5000;
+};
@@ -0,0 +1,20 @@
+// src/sim/shims/Preferences.h
+//
+// In-memory NVS. Contents survive for the whole simulation run.
+#pragma once
+#include <Arduino.h>
+
+class Preferences {
+public:
+  bool begin(const char *ns, bool readOnly = false);
+  void end() {}
+  size_t getBytes(const char *key, void *buf, size_t maxLen);
+  size_t putBytes(const char *key, const void *buf, size_t len);
+  bool remove(const char *key);
+  uint32_t getUInt(const char *key, uint32_t def = 0);
+  size_t putUInt(const char *key, uint32_t value);
+
+private:
+  std::string fullKey(const char *key) const { return _ns + "/" + key; }
+  std::string _ns;
+};
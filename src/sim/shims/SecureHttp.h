@@ -0,0 +1,50 @@
+// src/sim/shims/SecureHttp.h
+//
+// SecureHttp without TLS: the sim's HTTPClient never leaves the process,
+// so there is nothing to verify or resume. post()/get() go to the same
+// in-process stand-in (SimHttp.h), outside the heap guard's count: the
+// stand-in is the network, not the node.
+#pragma once
+#include <Arduino.h>
+#include <HTTPClient.h>
+
+#include "../SimHttp.h"
+#include "HeapGuard.h"
+
+struct TlsHandshakeStats {
+  const char *host;
+  uint32_t ms;
+  uint32_t peakHeap;
+  bool resumed;
+  int error;
+};
+
+class SecureHttp {
+public:
+  static constexpr uint32_t TIMEOUT_MS = 5000;
+
+  bool begin(const uint8_t *, const uint16_t *, uint8_t) { return true; }
+  bool begin(HTTPClient &http, const String &url) { return http.begin(url); }
+  void onHandshake(void (*)(const TlsHandshakeStats &)) {}
+
+  int post(const char *url, const char *, const uint8_t *body, size_t len,
+           uint32_t timeoutMs = TIMEOUT_MS) {
+    HEAP_GUARD_PAUSED();
+    std::string response;
+    return SimHttp::handle("POST", url, (const char *)body, len, response,
+                           timeoutMs);
+  }
+  int get(const char *url, const char *, char *response, size_t cap,
+          size_t &length, uint32_t timeoutMs = TIMEOUT_MS) {
+    HEAP_GUARD_PAUSED();
+    std::string body;
+    const int code = SimHttp::handle("GET", url, nullptr, 0, body, timeoutMs);
+    length = 0;
+    if (body.size() >= cap)
+      return HTTPC_ERROR_TOO_LESS_RAM;
+    memcpy(response, body.data(), body.size());
+    response[body.size()] = '\0';
+    length = body.size();
+    return code;
+  }
+};
@@ -0,0 +1,118 @@
+// src/sim/shims/WiFi.h
+//
+// Station-mode WiFi model: association takes a fixed virtual time (less
+// with a known BSSID/channel) and fails if it ends inside a scripted
+// outage; an outage drops the link. Link changes are reported to
+// onEvent() handlers from Sim timers, as the driver's event task would.
+// With auto-reconnect on (the default) the driver brings the link back
+// after an outage by itself.
+#pragma once
+#include <Arduino.h>
+
+typedef enum {
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL = 1,
+  WL_CONNECTED = 3,
+  WL_CONNECT_FAILED = 4,
+  WL_CONNECTION_LOST = 5,
+  WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1 } wifi_mode_t;
+
+// The station events of arduino-esp32, same values
+typedef enum {
+  ARDUINO_EVENT_WIFI_STA_CONNECTED = 4,
+  ARDUINO_EVENT_WIFI_STA_DISCONNECTED = 5,
+  ARDUINO_EVENT_WIFI_STA_GOT_IP = 7,
+  ARDUINO_EVENT_MAX = 38
+} arduino_event_id_t;
+
+typedef void (*WiFiEventCb)(arduino_event_id_t event);
+
+class SimWiFi {
+public:
+  // Modeled association times
+  static constexpr uint64_t SCAN_CONNECT_US = 2500000;
+  static constexpr uint64_t FAST_CONNECT_US = 350000;
+  static constexpr uint64_t AUTO_RECONNECT_US = 3000000;
+
+  bool mode(wifi_mode_t) { return true; }
+  wl_status_t begin(const char *ssid, const char *pass, int32_t channel = 0,
+                    const uint8_t *bssid = nullptr, bool connect = true);
+  bool config(IPAddress ip, IPAddress, IPAddress,
+              IPAddress = IPAddress()) {
+    _staticIp = (uint32_t)ip != 0;
+    if (_staticIp)
+      _ip = ip;
+    return true;
+  }
+  bool disconnect(bool wifiOff = false);
+  wl_status_t status() { return _connected ? WL_CONNECTED : WL_DISCONNECTED; }
+  bool setAutoReconnect(bool autoReconnect) {
+    _autoReconnect = autoReconnect;
+    return true;
+  }
+  // event = ARDUINO_EVENT_MAX for all of them
+  int onEvent(WiFiEventCb cb, arduino_event_id_t event = ARDUINO_EVENT_MAX);
+
+  IPAddress localIP() { return status() == WL_CONNECTED ? _ip : IPAddress(); }
+  IPAddress gatewayIP() { return IPAddress(192, 168, 1, 1); }
+  IPAddress subnetMask() { return IPAddress(255, 255, 255, 0); }
+  IPAddress dnsIP() { return IPAddress(192, 168, 1, 1); }
+  uint8_t *BSSID() { return _bssid; }
+  int32_t channel() { return 6; }
+  uint8_t *macAddress(uint8_t *mac) {
+    static const uint8_t MAC[6] = {0x34, 0x85, 0x18, 0x5A, 0x0B, 0x2C};
+    memcpy(mac, MAC, sizeof(MAC));
+    return mac;
+  }
+
+private:
+  static constexpr uint8_t MAX_HANDLERS = 4;
+  struct Handler {
+    WiFiEventCb cb;
+    arduino_event_id_t event;
+  };
+
+  // Sim timers
+  static void attemptDone();
+  static void linkCheck();
+  void emit(arduino_event_id_t event);
+  void watchLink();
+
+  bool _begun = false;     // an attempt is under way, or the link is up
+  bool _connected = false;
+  bool _autoReconnect = true;
+  bool _staticIp = false;
+  uint64_t _readyAtUs = 0;
+  Handler _handlers[MAX_HANDLERS] = {};
+  uint8_t _handlerCount = 0;
+  IPAddress _ip = IPAddress(192, 168, 1, 42);
+  uint8_t _bssid[6] = {0x02, 0x00, 0x5E, 0x10, 0x20, 0x30};
+};
+
+extern SimWiFi WiFi;
+
+// Nothing on the simulated network opens connections to the node: the
+// server listens, and every accepted client is empty.
+class WiFiClient {
+public:
+  explicit operator bool() const { return false; }
+  uint8_t connected() { return 0; }
+  int available() { return 0; }
+  int read() { return -1; }
+  size_t write(const uint8_t *, size_t len) { return len; }
+  size_t printf(const char *, ...) { return 0; }
+  void stop() {}
+};
+
+class WiFiServer {
+public:
+  explicit WiFiServer(uint16_t port) : _port(port) {}
+  void begin() {}
+  WiFiClient available() { return WiFiClient(); }
+
+private:
+  uint16_t _port;
+};
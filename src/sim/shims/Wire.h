@@ -0,0 +1,88 @@
+// src/sim/shims/Wire.h
+//
+// TwoWire stand-in that routes transactions to simulated I2C devices and
+// advances the virtual clock by the modeled bus time. Faults: reads above
+// 100 kHz get a flipped bit with the probability set by Sim::setI2cNoise(),
+// and stick() makes a slave hold SDA low (every transaction times out)
+// until SCL is clocked through digitalWrite() on the bus's pin.
+#pragma once
+#include <Arduino.h>
+#include <vector>
+
+class SimI2cDevice {
+public:
+  virtual ~SimI2cDevice() {}
+  // True if the device ACKs this address (a mux also answers for the
+  // devices on its selected channel)
+  virtual bool claims(uint8_t addr) const = 0;
+  // Returns 0 (ACK) or an Arduino endTransmission() error code
+  virtual uint8_t onWrite(uint8_t addr, const uint8_t *data, size_t len) = 0;
+  // Returns the number of bytes provided
+  virtual size_t onRead(uint8_t addr, uint8_t *buf, size_t len) = 0;
+  // What the controller got for that read, bus faults included
+  virtual void onDelivered(uint8_t, const uint8_t *, size_t) {}
+};
+
+class TwoWire {
+public:
+  bool begin() { return true; }
+  bool begin(int sda, int scl, uint32_t freq = 0) {
+    _sda = sda;
+    _scl = scl;
+    if (freq)
+      _freq = freq;
+    return true;
+  }
+  bool end() { return true; }
+  void setClock(uint32_t freq) { _freq = freq; }
+
+  void stick() { _stuck = true; }
+  bool stuck() const { return _stuck; }
+  // GPIO access to the bus pins (see Arduino.h)
+  bool ownsPin(int pin) const { return pin >= 0 && (pin == _sda || pin == _scl); }
+  void pinWrite(int pin, uint8_t val);
+  int pinRead(int pin) const;
+
+  void attach(SimI2cDevice *dev) { _devices.push_back(dev); }
+
+  void beginTransmission(uint8_t addr) {
+    _addr = addr;
+    _txLen = 0;
+  }
+  size_t write(uint8_t b) {
+    if (_txLen >= sizeof(_tx))
+      return 0;
+    _tx[_txLen++] = b;
+    return 1;
+  }
+  size_t write(const uint8_t *data, size_t len) {
+    size_t n = 0;
+    while (n < len && write(data[n]))
+      ++n;
+    return n;
+  }
+  uint8_t endTransmission(bool stop = true);
+  size_t requestFrom(int addr, int len);
+  int available() const { return (int)(_rxLen - _rxPos); }
+  int read() { return _rxPos < _rxLen ? _rx[_rxPos++] : -1; }
+
+private:
+  void chargeBusTime(size_t bytes);
+  SimI2cDevice *find(uint8_t addr) const;
+
+  std::vector<SimI2cDevice *> _devices;
+  uint32_t _freq = 100000;
+  int _sda = -1;
+  int _scl = -1;
+  bool _stuck = false;
+  bool _sclLow = false;
+  uint8_t _addr = 0;
+  uint8_t _tx[64];
+  size_t _txLen = 0;
+  uint8_t _rx[128];
+  size_t _rxLen = 0;
+  size_t _rxPos = 0;
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
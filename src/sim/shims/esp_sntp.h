@@ -0,0 +1,9 @@
+// src/sim/shims/esp_sntp.h
+#pragma once
+#include <sys/time.h>
+
+// Called with the true (virtual wall) time at every SNTP sync: the first
+// one shortly after configTime(), then hourly like lwIP's default
+// CONFIG_LWIP_SNTP_UPDATE_DELAY, retried every 15 s while the link is down.
+typedef void (*sntp_sync_time_cb_t)(struct timeval *tv);
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t callback);
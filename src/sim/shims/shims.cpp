@@ -0,0 +1,331 @@
+// src/sim/shims/shims.cpp
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../SimHttp.h"
+#include "../SimReport.h"
+#include "Arduino.h"
+#include "ArduinoOTA.h"
+#include "HTTPClient.h"
+#include "Preferences.h"
+#include "WiFi.h"
+#include "Wire.h"
+#include "esp_sntp.h"
+
+SimSerial Serial;
+TwoWire Wire;
+TwoWire Wire1;
+SimWiFi WiFi;
+SimArduinoOTA ArduinoOTA;
+
+// ===== Random =====
+long random(long howbig) {
+  static uint32_t state = 0xA5A5;
+  if (howbig <= 0)
+    return 0;
+  state = state * 1664525u + 1013904223u;
+  return (long)((state >> 8) % (uint32_t)howbig);
+}
+
+long random(long howsmall, long howbig) {
+  return howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall);
+}
+
+// ===== Time =====
+static const time_t SIM_EPOCH = 1767225600; // 2026-01-01T00:00:00Z
+static const uint64_t SNTP_LATENCY_US = 80000;
+static const uint64_t SNTP_INTERVAL_US = 3600ULL * 1000000;
+static const uint64_t SNTP_RETRY_US = 15ULL * 1000000;
+static bool sntpStarted = false;
+static bool sntpSynced = false;
+// System time is stepped to wall time at a sync, then runs on the
+// node's (drifting) oscillator until the next one
+static uint64_t sntpWallUs = 0;
+static uint64_t sntpLocalUs = 0;
+static sntp_sync_time_cb_t sntpCallback = nullptr;
+
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t callback) {
+  sntpCallback = callback;
+}
+
+static void sntpSync() {
+  if (!Sim::linkAvailable()) {
+    Sim::schedule(Sim::nowUs() + SNTP_RETRY_US, sntpSync);
+    return;
+  }
+  sntpWallUs = (uint64_t)SIM_EPOCH * 1000000 + Sim::nowUs();
+  sntpLocalUs = Sim::localUs();
+  sntpSynced = true;
+  Sim::report().sntpSyncs++;
+  Sim::schedule(Sim::nowUs() + SNTP_INTERVAL_US, sntpSync);
+  if (sntpCallback) {
+    struct timeval tv;
+    tv.tv_sec = (time_t)(sntpWallUs / 1000000);
+    tv.tv_usec = (suseconds_t)(sntpWallUs % 1000000);
+    sntpCallback(&tv);
+  }
+}
+
+void configTime(long, int, const char *, const char *, const char *) {
+  if (sntpStarted)
+    return;
+  sntpStarted = true;
+  Sim::schedule(Sim::nowUs() + SNTP_LATENCY_US, sntpSync);
+}
+
+int64_t Sim::wallMs() {
+  return (int64_t)SIM_EPOCH * 1000 + (int64_t)(Sim::nowUs() / 1000);
+}
+
+// Replaces libc time() for the firmware under test
+extern "C" time_t time(time_t *out) throw() {
+  const uint64_t local = Sim::localUs();
+  const uint64_t us = sntpSynced ? sntpWallUs + (local - sntpLocalUs) : local;
+  const time_t t = (time_t)(us / 1000000);
+  if (out)
+    *out = t;
+  return t;
+}
+
+// ===== I2C =====
+// A stuck bus holds every transaction until the controller gives up
+static constexpr uint64_t I2C_TIMEOUT_US = 50000;
+// Read length of the SEN66 measured-values frame: one per sample
+static constexpr int MEASURED_VALUES_LEN = 27;
+
+void TwoWire::chargeBusTime(size_t bytes) {
+  // START + address byte + data bytes, 9 clocks per byte, + STOP
+  const uint64_t bits = (uint64_t)(bytes + 1) * 9 + 2;
+  const uint64_t us = (bits * 1000000ULL + _freq - 1) / _freq;
+  Sim::advanceUs(us);
+  Sim::Report &r = Sim::report();
+  r.i2cTransactions++;
+  r.i2cBySpeed[_freq].transactions++;
+  r.i2cBySpeed[_freq].busUs += us;
+}
+
+SimI2cDevice *TwoWire::find(uint8_t addr) const {
+  for (SimI2cDevice *d : _devices)
+    if (d->claims(addr))
+      return d;
+  return nullptr;
+}
+
+uint8_t TwoWire::endTransmission(bool) {
+  if (_stuck) {
+    Sim::advanceUs(I2C_TIMEOUT_US);
+    Sim::report().i2cBySpeed[_freq].failed++;
+    return 5; // timeout
+  }
+  chargeBusTime(_txLen);
+  SimI2cDevice *dev = find(_addr);
+  if (!dev) {
+    Sim::report().i2cBySpeed[_freq].failed++;
+    return 2; // NACK on address
+  }
+  return dev->onWrite(_addr, _tx, _txLen);
+}
+
+size_t TwoWire::requestFrom(int addr, int len) {
+  _rxLen = 0;
+  _rxPos = 0;
+  if (len > (int)sizeof(_rx))
+    len = sizeof(_rx);
+  Sim::I2cSpeedStats &st = Sim::report().i2cBySpeed[_freq];
+  if (_stuck) {
+    Sim::advanceUs(I2C_TIMEOUT_US);
+    st.failed++;
+    return 0;
+  }
+  chargeBusTime((size_t)len);
+  SimI2cDevice *dev = find((uint8_t)addr);
+  if (!dev) {
+    st.failed++;
+    return 0;
+  }
+  _rxLen = dev->onRead((uint8_t)addr, _rx, (size_t)len);
+  if (len == MEASURED_VALUES_LEN)
+    st.samples++;
+  if (_rxLen > 0 && Sim::i2cGlitch(_freq)) {
+    _rx[_rxLen / 2] ^= 0x10;
+    st.corrupted++;
+  }
+  if (_rxLen > 0)
+    dev->onDelivered((uint8_t)addr, _rx, _rxLen);
+  return _rxLen;
+}
+
+void TwoWire::pinWrite(int pin, uint8_t val) {
+  if (pin != _scl)
+    return;
+  const bool pulse = val == HIGH && _sclLow;
+  _sclLow = val == LOW;
+  // Clocking SCL lets the stuck slave finish its byte
+  if (pulse && _stuck) {
+    _stuck = false;
+    Sim::report().i2cBusClears++;
+    Sim::event("I2C bus released by SCL clocking");
+  }
+}
+
+int TwoWire::pinRead(int pin) const { return pin == _sda && _stuck ? LOW : HIGH; }
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  if (Wire.ownsPin(pin))
+    Wire.pinWrite(pin, val);
+  if (Wire1.ownsPin(pin))
+    Wire1.pinWrite(pin, val);
+}
+
+int digitalRead(uint8_t pin) {
+  if (Wire.ownsPin(pin))
+    return Wire.pinRead(pin);
+  if (Wire1.ownsPin(pin))
+    return Wire1.pinRead(pin);
+  return HIGH;
+}
+
+// ===== WiFi =====
+wl_status_t SimWiFi::begin(const char *, const char *, int32_t channel,
+                           const uint8_t *bssid, bool) {
+  _begun = true;
+  _connected = false;
+  const bool fast = channel != 0 && bssid != nullptr;
+  _readyAtUs = Sim::nowUs() + (fast ? FAST_CONNECT_US : SCAN_CONNECT_US);
+  // A cached static lease skips DHCP; otherwise the AP hands out .42
+  if (!_staticIp)
+    _ip = IPAddress(192, 168, 1, 42);
+  Sim::report().wifiBegins++;
+  Sim::schedule(_readyAtUs, attemptDone);
+  return WL_DISCONNECTED;
+}
+
+bool SimWiFi::disconnect(bool) {
+  const bool begun = _begun;
+  _begun = false;
+  _connected = false;
+  if (begun)
+    emit(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+  return true;
+}
+
+int SimWiFi::onEvent(WiFiEventCb cb, arduino_event_id_t event) {
+  if (_handlerCount == MAX_HANDLERS)
+    return 0;
+  _handlers[_handlerCount++] = Handler{cb, event};
+  return _handlerCount;
+}
+
+void SimWiFi::emit(arduino_event_id_t event) {
+  for (uint8_t i = 0; i < _handlerCount; ++i)
+    if (_handlers[i].event == ARDUINO_EVENT_MAX || _handlers[i].event == event)
+      _handlers[i].cb(event);
+}
+
+// Drops the link when the next outage starts
+void SimWiFi::watchLink() {
+  uint64_t start, end;
+  if (Sim::nextOutage(Sim::nowUs(), start, end))
+    Sim::schedule(start, linkCheck);
+}
+
+// The driver's own retry comes after the outage in the way has ended
+static uint64_t autoReconnectAtUs() {
+  uint64_t start, end;
+  if (Sim::nextOutage(Sim::nowUs(), start, end) && start <= Sim::nowUs())
+    return end + SimWiFi::AUTO_RECONNECT_US;
+  return Sim::nowUs() + SimWiFi::SCAN_CONNECT_US;
+}
+
+void SimWiFi::attemptDone() {
+  SimWiFi &w = WiFi;
+  // Cancelled, or superseded by a later begin()
+  if (!w._begun || w._connected || Sim::nowUs() < w._readyAtUs)
+    return;
+  if (Sim::linkAvailable()) {
+    w._connected = true;
+    w.emit(ARDUINO_EVENT_WIFI_STA_CONNECTED);
+    w.emit(ARDUINO_EVENT_WIFI_STA_GOT_IP);
+    w.watchLink();
+    return;
+  }
+  // No AP
+  if (w._autoReconnect) {
+    w._readyAtUs = autoReconnectAtUs();
+    Sim::schedule(w._readyAtUs, attemptDone);
+  } else {
+    w._begun = false;
+  }
+  w.emit(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+}
+
+void SimWiFi::linkCheck() {
+  SimWiFi &w = WiFi;
+  if (!w._connected || Sim::linkAvailable())
+    return;
+  w._connected = false;
+  if (w._autoReconnect) {
+    w._readyAtUs = autoReconnectAtUs();
+    Sim::schedule(w._readyAtUs, attemptDone);
+  } else {
+    w._begun = false;
+  }
+  w.emit(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+}
+
+// ===== HTTP =====
+int HTTPClient::GET() {
+  std::string body;
+  const int code = SimHttp::handle("GET", _url.c_str(), nullptr, 0, body,
+                                   _timeoutMs);
+  _response = String(body);
+  return code;
+}
+
+int HTTPClient::POST(const uint8_t *payload, size_t size) {
+  std::string body;
+  const int code = SimHttp::handle("POST", _url.c_str(),
+                                   (const char *)payload, size, body,
+                                   _timeoutMs);
+  _response = String(body);
+  return code;
+}
+
+// ===== NVS =====
+static std::map<std::string, std::vector<uint8_t>> &nvs() {
+  static std::map<std::string, std::vector<uint8_t>> store;
+  return store;
+}
+
+bool Preferences::begin(const char *ns, bool) {
+  _ns = ns;
+  return true;
+}
+
+size_t Preferences::getBytes(const char *key, void *buf, size_t maxLen) {
+  auto it = nvs().find(fullKey(key));
+  if (it == nvs().end() || it->second.size() > maxLen)
+    return 0;
+  memcpy(buf, it->second.data(), it->second.size());
+  return it->second.size();
+}
+
+size_t Preferences::putBytes(const char *key, const void *buf, size_t len) {
+  const uint8_t *p = (const uint8_t *)buf;
+  nvs()[fullKey(key)] = std::vector<uint8_t>(p, p + len);
+  return len;
+}
+
+bool Preferences::remove(const char *key) {
+  return nvs().erase(fullKey(key)) > 0;
+}
+
+uint32_t Preferences::getUInt(const char *key, uint32_t def) {
+  uint32_t v;
+  return getBytes(key, &v, sizeof(v)) == sizeof(v) ? v : def;
+}
+
+size_t Preferences::putUInt(const char *key, uint32_t value) {
+  return putBytes(key, &value, sizeof(value));
+}
@@ -0,0 +1,213 @@
+// test/FakeSen6x.h
+#pragma once
+#include <string.h>
+
+#include <vector>
+
+#include <Sen66.h>
+#include <Sen66Protocol.h>
+
+/*
+  Host fakes for the driver tests: SEN6x sensors and a TCA9548A behind a
+  Sen66Bus, on a virtual clock that only moves through delayMs() and
+  advance().
+
+  - FakeSen6x answers like the datasheet: a read needs a command at least
+    READ_EXEC_TIME_MS before it and is NACKed otherwise. A measuring
+    sensor has a new sample every second; its measured-values frame holds
+    the words of SEN6X_MODEL, read from `words`. corruptReads flips a bit
+    in that many responses.
+  - FakeBus routes 0x6B to the sensor on the selected mux channel, or to
+    the one directly on the bus when no channel is selected. Every
+    transaction is logged, so tests can check what went over the wire.
+*/
+namespace Fake {
+
+using namespace Sen66Protocol;
+
+class FakeSen6x {
+public:
+  FakeSen6x() {
+    // Datasheet example values, in ticks
+    word[W_PM1_0] = 12;        // 1.2 µg/m3
+    word[W_PM2_5] = 25;        // 2.5
+    word[W_PM4_0] = 31;        // 3.1
+    word[W_PM10_0] = 34;       // 3.4
+    word[W_HUMIDITY] = 4567;   // 45.67 %
+    word[W_TEMPERATURE] = 4300; // 21.5 °C
+    word[W_VOC] = 1100;        // 110
+    word[W_NOX] = 20;          // 2
+    word[W_CO2] = 650;         // ppm
+    word[W_HCHO] = 255;        // 25.5 ppb
+    word[W_RAW_HUMIDITY] = 4500;
+    word[W_RAW_TEMPERATURE] = 4400;
+    word[W_RAW_VOC] = 27000;
+    word[W_RAW_NOX] = 15000;
+    word[W_RAW_CO2] = 640;
+  }
+
+  uint16_t word[W_RAW_CO2 + 1];
+  uint16_t nc[5] = {101, 205, 210, 211, 212}; // x10 #/cm3
+  uint32_t status = 0;
+  bool present = true;
+  uint32_t corruptReads = 0;
+
+  bool measuring = false;
+  uint16_t lastCommand = 0;
+  uint32_t commands = 0; // every command written
+
+  bool write(const uint8_t *data, size_t len, uint32_t nowMs) {
+    if (!present || len < 2)
+      return false;
+    const uint16_t cmd = (uint16_t)(data[0] << 8 | data[1]);
+    lastCommand = cmd;
+    commands++;
+    _pending = cmd;
+    _commandMs = nowMs;
+    if (cmd == 0x0021) {
+      measuring = true;
+      _sampleMs = nowMs + 1000;
+      _pending = 0;
+    } else if (cmd == 0x0104 || cmd == 0x5607) {
+      measuring = false;
+      _pending = 0;
+    }
+    return true;
+  }
+
+  bool read(uint8_t *buf, size_t len, uint32_t nowMs) {
+    if (!present || _pending == 0 ||
+        nowMs - _commandMs < Sen66::READ_EXEC_TIME_MS)
+      return false;
+    uint16_t words[16];
+    size_t n = 0;
+    const uint16_t cmd = _pending;
+    _pending = 0;
+    if (cmd == Sen66::DATA_READY_CMD) {
+      words[n++] = measuring && (int32_t)(nowMs - _sampleMs) >= 0 ? 1 : 0;
+    } else if (cmd == BuildModel::MEASURED_VALUES_CMD) {
+      n = frameWords<BuildModel::MeasuredWords>(words);
+      _sampleMs = nowMs + 1000;
+    } else if (cmd == BuildModel::RAW_VALUES_CMD) {
+      n = frameWords<BuildModel::RawWords>(words);
+    } else if (cmd == Sen66::NUMBER_CONCENTRATION_CMD) {
+      for (; n < 5; ++n)
+        words[n] = nc[n];
+    } else if (cmd == Sen66::DEVICE_STATUS_CMD) {
+      words[n++] = (uint16_t)(status >> 16);
+      words[n++] = (uint16_t)status;
+    } else {
+      return false; // no response to that command (or a wrong model's)
+    }
+    if (len != 3 * n)
+      return false;
+    for (size_t i = 0; i < n; ++i) {
+      buf[3 * i] = (uint8_t)(words[i] >> 8);
+      buf[3 * i + 1] = (uint8_t)words[i];
+      buf[3 * i + 2] = crc8(buf + 3 * i, 2);
+    }
+    if (corruptReads > 0) {
+      corruptReads--;
+      buf[len / 2] ^= 0x10;
+    }
+    return true;
+  }
+
+private:
+  template <Word... Ws> struct List {};
+  template <typename W> struct ListOf;
+  template <Word... Ws> struct ListOf<WordList<Ws...>> {
+    using type = List<Ws...>;
+  };
+  size_t put(uint16_t *, List<>) { return 0; }
+  template <Word W, Word... Rest>
+  size_t put(uint16_t *out, List<W, Rest...>) {
+    out[0] = word[W];
+    return 1 + put(out + 1, List<Rest...>());
+  }
+  template <typename Words> size_t frameWords(uint16_t *out) {
+    return put(out, typename ListOf<Words>::type());
+  }
+
+  uint16_t _pending = 0;
+  uint32_t _commandMs = 0;
+  uint32_t _sampleMs = 0;
+};
+
+class FakeBus : public Sen66Bus {
+public:
+  static constexpr uint8_t MUX_ADDR = 0x70;
+  static constexpr int DIRECT = -1; // Transfer::channel on the bus itself
+
+  struct Transfer {
+    bool write;
+    uint8_t addr;
+    int channel;  // mux register's channel at the time, or DIRECT
+    uint16_t cmd; // written command, mux mask, or the read's command
+    bool ok;
+  };
+
+  uint32_t nowMs = 0;
+  FakeSen6x *direct = nullptr;
+  FakeSen6x *behindMux[8] = {};
+  bool muxPresent = false;
+  uint8_t muxRegister = 0; // 0 = no channel, as after power-up or reset
+  uint32_t busResets = 0;
+  uint32_t corrupt = 0; // reportCorrupt() calls
+  std::vector<Transfer> log;
+
+  void advance(uint32_t ms) { nowMs += ms; }
+
+  bool write(uint8_t addr, const uint8_t *data, size_t len) override {
+    if (addr == MUX_ADDR) {
+      const bool ok = muxPresent && len == 1;
+      if (ok)
+        muxRegister = data[0];
+      log.push_back({true, addr, DIRECT, (uint16_t)(len ? data[0] : 0), ok});
+      return ok;
+    }
+    FakeSen6x *s = sensorAt(addr);
+    const bool ok = s && s->write(data, len, nowMs);
+    log.push_back({true, addr, channel(),
+                   len >= 2 ? (uint16_t)(data[0] << 8 | data[1])
+                            : (uint16_t)0,
+                   ok});
+    return ok;
+  }
+
+  bool read(uint8_t addr, uint8_t *buf, size_t len) override {
+    FakeSen6x *s = sensorAt(addr);
+    const uint16_t cmd = s ? s->lastCommand : 0;
+    const bool ok = s && s->read(buf, len, nowMs);
+    log.push_back({false, addr, channel(), cmd, ok});
+    return ok;
+  }
+
+  void delayMs(uint32_t ms) override { nowMs += ms; }
+  void reportCorrupt() override { corrupt++; }
+  uint32_t resets() const override { return busResets; }
+
+  size_t muxWrites() const {
+    size_t n = 0;
+    for (const Transfer &t : log)
+      n += t.addr == MUX_ADDR;
+    return n;
+  }
+
+private:
+  int channel() const {
+    for (int ch = 0; ch < 8; ++ch)
+      if (muxRegister == (1u << ch))
+        return ch;
+    return DIRECT;
+  }
+
+  FakeSen6x *sensorAt(uint8_t addr) const {
+    if (addr != Sen66::I2C_ADDR)
+      return nullptr;
+    const int ch = channel();
+    return ch == DIRECT ? direct : behindMux[ch];
+  }
+};
+
+} // namespace Fake
@@ -0,0 +1,50 @@
+// test/arduino/Arduino.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+  Just enough of the Arduino core for lib/Sen66Wire on the host: a clock
+  that only moves through delay()/delayMicroseconds(), and GPIO that the
+  fake TwoWire (Wire.h) answers for its bus pins.
+*/
+#define LOW 0x0
+#define HIGH 0x1
+#define INPUT_PULLUP 0x05
+#define OUTPUT_OPEN_DRAIN 0x12
+
+namespace Fake {
+
+inline uint64_t &clockUs() {
+  static uint64_t us = 0;
+  return us;
+}
+
+// The bus pins, answered by whoever owns them
+class Gpio {
+public:
+  virtual ~Gpio() {}
+  virtual void pinWrite(int pin, uint8_t val) = 0;
+  virtual int pinRead(int pin) const = 0;
+};
+
+inline Gpio *&gpio() {
+  static Gpio *g = nullptr;
+  return g;
+}
+
+} // namespace Fake
+
+inline uint32_t micros() { return (uint32_t)Fake::clockUs(); }
+inline uint32_t millis() { return (uint32_t)(Fake::clockUs() / 1000); }
+inline void delay(uint32_t ms) { Fake::clockUs() += ms * 1000ULL; }
+inline void delayMicroseconds(uint32_t us) { Fake::clockUs() += us; }
+
+inline void pinMode(int, uint8_t) {}
+inline void digitalWrite(int pin, uint8_t val) {
+  if (Fake::gpio())
+    Fake::gpio()->pinWrite(pin, val);
+}
+inline int digitalRead(int pin) {
+  return Fake::gpio() ? Fake::gpio()->pinRead(pin) : HIGH;
+}
@@ -0,0 +1,95 @@
+// test/arduino/Wire.h
+#pragma once
+#include <Arduino.h>
+
+/*
+  TwoWire with one scripted device behind it, for the Sen66WireBus tests.
+  Results follow the ESP32 core: endTransmission() returns 2 for a NACK
+  on the address, 4 for a bus error and 5 for a timeout; requestFrom()
+  returns 0 bytes for all of them.
+
+  - present: the device ACKs its address.
+  - failWrites / failReads: that many data transfers end in a bus error
+    (a read comes back empty) although the device is there.
+  - sdaStuck: a slave holds SDA low, so every transfer times out, until
+    releaseAfterPulses SCL pulses have been clocked (-1: never).
+*/
+class TwoWire : public Fake::Gpio {
+public:
+  bool present = true;
+  uint32_t failWrites = 0;
+  uint32_t failReads = 0;
+  bool sdaStuck = false;
+  int releaseAfterPulses = -1;
+
+  // What the bus saw
+  uint32_t freq = 0;
+  uint32_t begins = 0;
+  uint32_t probes = 0; // zero-length writes
+  uint32_t sclPulses = 0;
+
+  bool begin(int sda, int scl, uint32_t f) {
+    _sda = sda;
+    _scl = scl;
+    freq = f;
+    begins++;
+    Fake::gpio() = this;
+    return true;
+  }
+  bool end() { return true; }
+  void setClock(uint32_t f) { freq = f; }
+
+  void beginTransmission(uint8_t) { _txLen = 0; }
+  size_t write(const uint8_t *, size_t len) {
+    _txLen += len;
+    return len;
+  }
+  uint8_t endTransmission() {
+    if (_txLen == 0)
+      probes++;
+    if (sdaStuck)
+      return 5;
+    if (!present)
+      return 2;
+    if (_txLen > 0 && failWrites > 0) {
+      failWrites--;
+      return 4;
+    }
+    return 0;
+  }
+  size_t requestFrom(int, int len) {
+    _rxLen = 0;
+    _rxPos = 0;
+    if (sdaStuck || !present)
+      return 0;
+    if (failReads > 0) {
+      failReads--;
+      return 0;
+    }
+    _rxLen = (size_t)len;
+    return _rxLen;
+  }
+  int read() { return _rxPos < _rxLen ? (int)(_rxPos++ & 0xFF) : -1; }
+
+  void pinWrite(int pin, uint8_t val) override {
+    if (pin != _scl)
+      return;
+    if (_sclLow && val == HIGH) {
+      sclPulses++;
+      if (sdaStuck && releaseAfterPulses > 0 && --releaseAfterPulses == 0)
+        sdaStuck = false;
+    }
+    _sclLow = val == LOW;
+  }
+  int pinRead(int pin) const override {
+    return pin == _sda && sdaStuck ? LOW : HIGH;
+  }
+
+private:
+  int _sda = -1;
+  int _scl = -1;
+  bool _sclLow = false;
+  size_t _txLen = 0;
+  size_t _rxLen = 0;
+  size_t _rxPos = 0;
+};
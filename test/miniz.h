@@ -0,0 +1,83 @@
+// test/miniz.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <zlib.h>
+
+/*
+  Host stand-in for the tinfl part of the ESP32 ROM's miniz, which
+  lib/DeltaOta/DeltaStream.h drives: the same types, flags and status
+  contract, backed by zlib's raw inflate. The output goes into the
+  caller's circular window exactly as tinfl's does; zlib keeps its own
+  copy of the dictionary.
+
+  Linked with -lz ([env:native_test]).
+*/
+typedef uint8_t mz_uint8;
+typedef uint32_t mz_uint32;
+
+#define TINFL_LZ_DICT_SIZE 32768
+
+enum {
+  TINFL_FLAG_PARSE_ZLIB_HEADER = 1,
+  TINFL_FLAG_HAS_MORE_INPUT = 2,
+  TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF = 4,
+  TINFL_FLAG_COMPUTE_ADLER32 = 8
+};
+
+typedef enum {
+  TINFL_STATUS_BAD_PARAM = -3,
+  TINFL_STATUS_ADLER32_MISMATCH = -2,
+  TINFL_STATUS_FAILED = -1,
+  TINFL_STATUS_DONE = 0,
+  TINFL_STATUS_NEEDS_MORE_INPUT = 1,
+  TINFL_STATUS_HAS_MORE_OUTPUT = 2
+} tinfl_status;
+
+typedef struct {
+  z_stream z;
+  int state; // 0 = not started, 1 = inflating, 2 = done, 3 = failed
+} tinfl_decompressor;
+
+static inline void tinfl_standin_init(tinfl_decompressor *r) {
+  memset(r, 0, sizeof(*r));
+}
+#define tinfl_init(r) tinfl_standin_init(r)
+
+static inline tinfl_status
+tinfl_decompress(tinfl_decompressor *r, const mz_uint8 *pIn_buf_next,
+                 size_t *pIn_buf_size, mz_uint8 *pOut_buf_start,
+                 mz_uint8 *pOut_buf_next, size_t *pOut_buf_size,
+                 const mz_uint32 decomp_flags) {
+  (void)pOut_buf_start;
+  if (decomp_flags & (TINFL_FLAG_PARSE_ZLIB_HEADER | TINFL_FLAG_COMPUTE_ADLER32))
+    return TINFL_STATUS_BAD_PARAM; // not needed by the firmware
+  if (r->state >= 2) {
+    *pIn_buf_size = *pOut_buf_size = 0;
+    return r->state == 2 ? TINFL_STATUS_DONE : TINFL_STATUS_FAILED;
+  }
+  if (r->state == 0) {
+    if (inflateInit2(&r->z, -15) != Z_OK)
+      return TINFL_STATUS_FAILED;
+    r->state = 1;
+  }
+  r->z.next_in = (Bytef *)pIn_buf_next;
+  r->z.avail_in = (uInt)*pIn_buf_size;
+  r->z.next_out = pOut_buf_next;
+  r->z.avail_out = (uInt)*pOut_buf_size;
+  const int ret = inflate(&r->z, Z_NO_FLUSH);
+  *pIn_buf_size -= r->z.avail_in;
+  *pOut_buf_size -= r->z.avail_out;
+  if (ret == Z_STREAM_END || (ret != Z_OK && ret != Z_BUF_ERROR)) {
+    inflateEnd(&r->z);
+    r->state = ret == Z_STREAM_END ? 2 : 3;
+    return ret == Z_STREAM_END ? TINFL_STATUS_DONE : TINFL_STATUS_FAILED;
+  }
+  if (r->z.avail_out == 0)
+    return TINFL_STATUS_HAS_MORE_OUTPUT;
+  if (!(decomp_flags & TINFL_FLAG_HAS_MORE_INPUT))
+    return TINFL_STATUS_FAILED; // the stream ended early
+  return TINFL_STATUS_NEEDS_MORE_INPUT;
+}
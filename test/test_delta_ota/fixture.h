@@ -0,0 +1,698 @@
+// test/test_delta_ota/fixture.h
+// Generated by make_fixture.py: scripts/ota_delta.py diff of the
+// images oldImage() and newImage() build. Do not edit.
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+static const size_t FIXTURE_NEW_SIZE = 91152;
+static const uint8_t FIXTURE_PATCH[11008] = {
+    0x53, 0x44, 0x50, 0x31, 0x00, 0xc0, 0x00, 0x00, 0x10, 0x64, 0x01, 0x00, 0xf4, 0x1c, 0x83, 0x12,
+    0x72, 0xc5, 0x6b, 0x05, 0xd4, 0xfc, 0x60, 0x7a, 0x51, 0x48, 0xfa, 0x6b, 0xa6, 0xa3, 0x46, 0x93,
+    0xba, 0xcf, 0x9d, 0x21, 0xf2, 0x5f, 0x32, 0xdb, 0x4e, 0x4a, 0xe8, 0x8d, 0x4d, 0x86, 0x13, 0x1b,
+    0xac, 0x92, 0x63, 0x2a, 0xd7, 0xf2, 0x4f, 0x8b, 0x91, 0x15, 0x14, 0xbc, 0x8a, 0xb3, 0x97, 0x2b,
+    0x46, 0x06, 0xa7, 0x03, 0x4f, 0xeb, 0xe6, 0x3c, 0x18, 0x1e, 0xad, 0x2c, 0x5d, 0xdb, 0x79, 0xf0,
+    0xcf, 0xf5, 0xfe, 0xfe, 0x71, 0x94, 0x24, 0x89, 0xb4, 0xa0, 0x28, 0x12, 0xd2, 0xa2, 0xae, 0xeb,
+    0xb5, 0x67, 0x49, 0x29, 0x2a, 0x09, 0x21, 0x24, 0x4b, 0xd9, 0x09, 0x51, 0x92, 0x12, 0x65, 0xc9,
+    0x9a, 0x28, 0x4b, 0x65, 0x4b, 0xe1, 0x08, 0x87, 0x44, 0x48, 0x3a, 0x2a, 0x22, 0x11, 0x69, 0x13,
+    0xb2, 0x24, 0x59, 0x52, 0x59, 0x3a, 0x59, 0x2a, 0xfc, 0xce, 0x77, 0xe6, 0x3d, 0xf3, 0xbb, 0x4f,
+    0x9f, 0x31, 0xf3, 0x98, 0xe7, 0x8c, 0xf9, 0xcc, 0xf5, 0x79, 0xcf, 0x7b, 0xee, 0xff, 0xdd, 0xf2,
+    0xe6, 0xd9, 0xd5, 0x62, 0x57, 0x8b, 0x3c, 0xf9, 0xf2, 0x2e, 0xcb, 0x9b, 0xaf, 0x75, 0xeb, 0xff,
+    0xdd, 0x3b, 0x72, 0xf7, 0xd9, 0xdc, 0x2d, 0x90, 0xbb, 0x6b, 0xff, 0x71, 0xd7, 0xe5, 0xee, 0x88,
+    0x7f, 0xfc, 0xff, 0xba, 0xb9, 0xbb, 0x37, 0x77, 0x8b, 0xe4, 0xee, 0xa9, 0xdc, 0xdd, 0x94, 0xbb,
+    0xbd, 0x72, 0xf7, 0xe5, 0xdc, 0xfd, 0x24, 0x77, 0x1b, 0xe7, 0xee, 0x0d, 0xb9, 0x5b, 0x3c, 0x77,
+    0x3f, 0xcb, 0xdd, 0x2d, 0xb9, 0xbb, 0x2a, 0x77, 0x27, 0xe6, 0xee, 0x2d, 0xb9, 0xdb, 0x22, 0x77,
+    0x5f, 0xcd, 0xdd, 0x2b, 0x73, 0xf7, 0xf2, 0xdc, 0xfd, 0x21, 0x77, 0xcb, 0xe5, 0xee, 0x9b, 0xb9,
+    0xdb, 0x3d, 0x77, 0xdb, 0xe5, 0xee, 0x65, 0xb9, 0x5b, 0x31, 0x77, 0x3b, 0xe6, 0xee, 0x81, 0x7f,
+    0xbc, 0xe7, 0xfc, 0xe3, 0xf7, 0x75, 0xcd, 0xdd, 0x0d, 0xb9, 0x7b, 0x63, 0xee, 0x86, 0xb9, 0x7b,
+    0x24, 0x77, 0xef, 0xcf, 0xdd, 0x85, 0xb9, 0xfb, 0xdf, 0x7f, 0x7c, 0x2e, 0x7d, 0x73, 0x37, 0xc9,
+    0xdd, 0x51, 0xb9, 0x7b, 0xf2, 0x1f, 0x7f, 0xcf, 0xfb, 0xb9, 0xfb, 0x69, 0xee, 0x3e, 0x93, 0xbb,
+    0x25, 0xff, 0xf1, 0xb9, 0xbc, 0x94, 0xbb, 0x79, 0x73, 0xf7, 0xcb, 0xdc, 0x5d, 0x99, 0xbb, 0xf5,
+    0x73, 0xb7, 0xd4, 0x3f, 0xbe, 0x07, 0x97, 0xe4, 0xee, 0xbe, 0xdc, 0xbd, 0x33, 0x77, 0xf3, 0xe4,
+    0xee, 0x92, 0xdc, 0x1d, 0xf6, 0x8f, 0x3d, 0xeb, 0x73, 0xf7, 0xab, 0xdc, 0xad, 0x91, 0xbb, 0x63,
+    0x73, 0xb7, 0xc4, 0x3f, 0xbe, 0x2f, 0x55, 0x73, 0xf7, 0xbd, 0xff, 0xff, 0xb9, 0xdf, 0x70, 0x43,
+    0x9e, 0x7c, 0xa3, 0x3f, 0xcd, 0x37, 0xb2, 0xec, 0x99, 0x9e, 0xbf, 0x6e, 0x2e, 0xb1, 0xe5, 0xde,
+    0x8b, 0xc6, 0x5d, 0xf4, 0xfd, 0xe5, 0x6d, 0xfe, 0x7e, 0xf9, 0x9c, 0x63, 0x2b, 0x26, 0xfd, 0x74,
+    0xce, 0xae, 0xae, 0x6f, 0x9f, 0x97, 0x7f, 0xea, 0xd1, 0x5e, 0x43, 0x46, 0x85, 0x0b, 0x97, 0x2f,
+    0xbc, 0x6e, 0x77, 0xbe, 0x0f, 0xa7, 0x35, 0x18, 0xf9, 0x6c, 0xb9, 0xf7, 0x7e, 0xe9, 0xda, 0xbd,
+    0x5a, 0xdb, 0x0b, 0x26, 0x95, 0xfb, 0xa5, 0x78, 0x81, 0xfa, 0x67, 0xdd, 0x92, 0x77, 0x70, 0xbc,
+    0xf3, 0xe6, 0x07, 0x7b, 0xd4, 0xfb, 0x25, 0x4f, 0xc1, 0x3c, 0x6b, 0xe6, 0x0f, 0x6e, 0xf6, 0xfa,
+    0x91, 0x9b, 0x1a, 0x7e, 0x37, 0xae, 0xd5, 0x57, 0x2f, 0x3c, 0x3a, 0xe0, 0xb3, 0x81, 0xdf, 0xfc,
+    0x5a, 0x64, 0xd3, 0x57, 0x6d, 0x8f, 0xd7, 0x51, 0xc7, 0x65, 0x0b, 0xaf, 0xbb, 0x7d, 0xf0, 0x94,
+    0x03, 0xdf, 0xb6, 0xbc, 0x66, 0xe5, 0x15, 0xcb, 0x9b, 0x24, 0x43, 0x77, 0xd7, 0x9f, 0x79, 0xf2,
+    0x4c, 0xd5, 0x4d, 0x93, 0x0a, 0x1c, 0x2f, 0xde, 0xa9, 0x5e, 0xff, 0x47, 0x9e, 0x3a, 0x58, 0xbc,
+    0x64, 0xe1, 0x35, 0xd5, 0xe3, 0xa6, 0x43, 0x1b, 0xee, 0x2b, 0x5a, 0x26, 0x7f, 0xb3, 0xa5, 0x41,
+    0xdf, 0xa7, 0x67, 0xdf, 0x70, 0xd7, 0x33, 0x7b, 0xcb, 0x5c, 0x50, 0x70, 0x4a, 0xcb, 0x5f, 0x6f,
+    0x7f, 0x66, 0xeb, 0x82, 0x81, 0xef, 0xdf, 0xb2, 0xe2, 0xf3, 0xdd, 0x1b, 0xde, 0xbf, 0xa4, 0xc5,
+    0x89, 0x93, 0xe1, 0x27, 0x2b, 0x66, 0xcf, 0x3a, 0xf8, 0xf9, 0xca, 0x22, 0x33, 0x1a, 0xcc, 0x7d,
+    0xa8, 0xd9, 0xe4, 0x79, 0x87, 0xeb, 0x3c, 0x57, 0xb2, 0xec, 0xcc, 0x76, 0xe9, 0xfe, 0x7b, 0xae,
+    0x39, 0x96, 0xbf, 0xc5, 0xf2, 0x7b, 0xf2, 0x0c, 0x7b, 0xa6, 0xe7, 0x4f, 0x97, 0xde, 0xff, 0xd1,
+    0x87, 0x6f, 0xbf, 0xd4, 0x79, 0xf3, 0x7f, 0x07, 0x6e, 0x99, 0xfd, 0xfe, 0x37, 0xfb, 0xe6, 0x54,
+    0x98, 0xff, 0xf1, 0x07, 0xdd, 0x5e, 0x9c, 0xd4, 0xad, 0xd3, 0xee, 0x4b, 0xff, 0xd8, 0xd6, 0xbe,
+    0xcb, 0xcf, 0x03, 0x6a, 0xb4, 0x58, 0xb3, 0x73, 0xfb, 0xae, 0x72, 0xab, 0x87, 0x0d, 0x99, 0x35,
+    0xe3, 0x8b, 0x77, 0xb6, 0x8c, 0x7d, 0xa5, 0xd7, 0xf3, 0x65, 0xfe, 0xac, 0x7d, 0xde, 0xe6, 0x9f,
+    0xba, 0xd7, 0x79, 0xb9, 0x47, 0xe5, 0xee, 0x43, 0xce, 0xfe, 0x77, 0xcb, 0x42, 0x15, 0x67, 0xfc,
+    0x5d, 0xb1, 0xc2, 0x17, 0xe5, 0x7e, 0xe8, 0x74, 0x51, 0x9b, 0xda, 0xe3, 0x3a, 0xf6, 0xa9, 0xf2,
+    0xf0, 0x0b, 0xa3, 0xf3, 0xde, 0xdc, 0x2d, 0x1b, 0x36, 0xa1, 0xe1, 0xf5, 0xcf, 0x5c, 0xb6, 0x76,
+    0x79, 0xa1, 0xce, 0xf7, 0x95, 0xea, 0xfe, 0xe5, 0xfa, 0x46, 0xb5, 0x5f, 0x9d, 0x96, 0x77, 0x7c,
+    0x99, 0x45, 0x1b, 0xc7, 0xfd, 0xa7, 0xc0, 0x92, 0xea, 0x0f, 0x5e, 0x7f, 0x72, 0xfc, 0xc6, 0x1e,
+    0x5b, 0x3e, 0x38, 0xb1, 0xae, 0xe4, 0xe2, 0xc9, 0xfd, 0xb2, 0xe3, 0xe7, 0xbc, 0xd4, 0xe3, 0xed,
+    0x26, 0xc7, 0x3a, 0x7f, 0xbf, 0xa0, 0xc7, 0x87, 0xe7, 0x16, 0xb8, 0x27, 0xdb, 0xfb, 0xe1, 0x47,
+    0x1f, 0x8f, 0xb9, 0xf0, 0xaa, 0x1b, 0xa6, 0x94, 0x5c, 0xfb, 0xef, 0xbd, 0xef, 0xad, 0x2c, 0x7c,
+    0x69, 0x56, 0x65, 0xe1, 0xef, 0x93, 0x66, 0x35, 0xed, 0xb6, 0x62, 0xf1, 0xa0, 0x2e, 0xe1, 0x1f,
+    0xeb, 0x1b, 0xec, 0xba, 0x7d, 0xfd, 0x7d, 0xf7, 0xff, 0xb5, 0xbb, 0xf7, 0xd1, 0x6d, 0xf3, 0x1f,
+    0x5b, 0xbc, 0xe4, 0xde, 0xab, 0xf7, 0xec, 0xbc, 0x6f, 0x7f, 0xab, 0x7a, 0x03, 0x66, 0x7c, 0x3c,
+    0xa9, 0xd1, 0x84, 0x6a, 0xaf, 0x5d, 0xfb, 0x5d, 0xb8, 0xe1, 0xde, 0x05, 0xe3, 0x27, 0xcc, 0x7f,
+    0xe3, 0xd4, 0xe5, 0xcd, 0x82, 0xe1, 0x47, 0x17, 0xf7, 0xe9, 0x37, 0xee, 0xf9, 0x0e, 0xaf, 0x0e,
+    0x9e, 0xba, 0x35, 0xa8, 0xd2, 0xfe, 0xe1, 0xcb, 0xbf, 0x2a, 0xb8, 0x29, 0xe8, 0x3d, 0xe0, 0xf9,
+    0x4f, 0x47, 0xd6, 0xe9, 0xfd, 0xce, 0xd4, 0x1f, 0xf2, 0xdc, 0x78, 0xc1, 0x5f, 0x5d, 0x9f, 0x7d,
+    0x62, 0xc8, 0x9d, 0xb7, 0xee, 0xea, 0xd4, 0x76, 0xd8, 0xec, 0xa3, 0x33, 0x57, 0x27, 0x57, 0x8d,
+    0x6f, 0x7c, 0xff, 0x94, 0xb7, 0xf6, 0x3c, 0xf6, 0xe8, 0x3d, 0x43, 0x9f, 0x7d, 0xee, 0xed, 0xc9,
+    0xd3, 0xbe, 0x6d, 0xfa, 0xd0, 0x6b, 0x2f, 0xb4, 0xad, 0x77, 0x72, 0xfc, 0xc4, 0x6a, 0xf9, 0x7c,
+    0x73, 0xd8, 0xea, 0x86, 0x7e, 0x17, 0x0d, 0xda, 0xf6, 0xfb, 0xee, 0x3d, 0x5f, 0x3f, 0x7d, 0xfc,
+    0x9b, 0xee, 0xa5, 0xd7, 0xdd, 0x7e, 0xe6, 0xe5, 0xd7, 0x4a, 0x7c, 0xf1, 0xd2, 0xf2, 0x0e, 0xbb,
+    0x36, 0xaf, 0x6e, 0xde, 0xe2, 0x58, 0xeb, 0xdd, 0x3f, 0xee, 0xde, 0x53, 0xb2, 0x67, 0x95, 0xe5,
+    0x4f, 0xdc, 0xd4, 0xfc, 0xc9, 0x25, 0x7b, 0xae, 0x58, 0x30, 0xaa, 0x72, 0xaf, 0x37, 0x0a, 0x0e,
+    0x9d, 0xdd, 0x7f, 0xe5, 0xa9, 0x47, 0x27, 0x7d, 0x3e, 0xe7, 0x9d, 0x5b, 0x1e, 0xf8, 0xb3, 0xc4,
+    0xad, 0xd7, 0xbf, 0xda, 0xac, 0xc3, 0xc7, 0xd5, 0x6a, 0x0e, 0xa8, 0x5e, 0x62, 0xe4, 0x9d, 0x25,
+    0x2e, 0xbf, 0xff, 0xc8, 0xe0, 0x5f, 0x06, 0x8d, 0x99, 0x31, 0x73, 0x45, 0xda, 0xbd, 0x51, 0xad,
+    0x75, 0x2d, 0xae, 0x7b, 0x6a, 0xda, 0xb7, 0xc3, 0xca, 0x6f, 0x6f, 0xb5, 0x60, 0xd4, 0xa8, 0x01,
+    0xb7, 0x57, 0x1b, 0xfa, 0x54, 0xbf, 0x51, 0x79, 0xde, 0x8c, 0x4f, 0x1c, 0x98, 0x3e, 0xf6, 0xf2,
+    0x62, 0x0f, 0xbc, 0x38, 0xe2, 0xef, 0x81, 0x95, 0x5b, 0xf5, 0xbd, 0xf1, 0xa9, 0xde, 0x97, 0xec,
+    0xbb, 0x63, 0xcc, 0x45, 0xaf, 0x4d, 0x29, 0xd4, 0xa1, 0x4e, 0x91, 0x27, 0x6a, 0x3d, 0x33, 0x79,
+    0xe7, 0xb3, 0x0f, 0x3c, 0xf3, 0xfd, 0xb4, 0x19, 0xe3, 0x9b, 0xae, 0x6d, 0xbf, 0xec, 0xca, 0x3a,
+    0xf5, 0xa6, 0x5f, 0x73, 0xee, 0xe1, 0x05, 0x33, 0x87, 0x4f, 0x6d, 0xf5, 0xf9, 0xae, 0xf2, 0xcf,
+    0xb7, 0xad, 0x7a, 0x4d, 0xd3, 0x22, 0x75, 0x1f, 0xbc, 0xec, 0x81, 0x16, 0x9d, 0xa7, 0x0e, 0xbe,
+    0x76, 0xd2, 0xb0, 0x62, 0xcf, 0xd7, 0xbd, 0xa5, 0xc8, 0xbc, 0x62, 0xff, 0x2e, 0xd7, 0x79, 0xd6,
+    0x8a, 0xe6, 0xfb, 0x27, 0x4f, 0x7c, 0xa7, 0xd9, 0x8a, 0x69, 0x0f, 0xdf, 0x75, 0x47, 0xb9, 0x5f,
+    0x57, 0xac, 0xd8, 0xf3, 0x73, 0x89, 0x0f, 0xee, 0x1b, 0x3d, 0xfd, 0xb6, 0x81, 0x67, 0x9f, 0xda,
+    0x77, 0xe4, 0xe1, 0xeb, 0x36, 0x1e, 0x7b, 0xa1, 0xcf, 0xbd, 0xe7, 0x2c, 0xb9, 0xa4, 0xe9, 0xbc,
+    0xf9, 0x5d, 0xe6, 0xd4, 0xff, 0xad, 0xfa, 0xf2, 0x89, 0xad, 0x46, 0xb4, 0xf9, 0xfc, 0x68, 0xe9,
+    0x3b, 0x66, 0xed, 0x3c, 0x94, 0x3f, 0x5a, 0x56, 0xeb, 0xda, 0xaa, 0x55, 0x47, 0x6c, 0xe8, 0xb7,
+    0xee, 0xc0, 0xf9, 0x4b, 0x37, 0xcc, 0xa9, 0xd8, 0x6c, 0x61, 0xc3, 0xa7, 0x4e, 0x7f, 0xd0, 0xe7,
+    0xea, 0x05, 0xa3, 0x3a, 0x77, 0xdf, 0xfb, 0x64, 0xdf, 0xfc, 0x1a, 0x14, 0x6c, 0xfa, 0xb4, 0xfa,
+    0x25, 0x8b, 0x3f, 0xa8, 0x55, 0xf7, 0xf7, 0x13, 0xaf, 0xe4, 0x6b, 0xf0, 0xc7, 0xf8, 0x5e, 0xc5,
+    0x6a, 0x6e, 0xdb, 0xfe, 0xea, 0xd2, 0xff, 0xe4, 0xfb, 0xae, 0xd7, 0xac, 0x89, 0xfd, 0x26, 0x5f,
+    0xda, 0x71, 0xc7, 0xd7, 0x5d, 0x8b, 0x4c, 0xe9, 0xf3, 0xdc, 0xd2, 0xab, 0xa7, 0xff, 0xd8, 0xe1,
+    0xc3, 0x1d, 0xbf, 0x95, 0x7a, 0xf5, 0xcd, 0xd1, 0x73, 0x9b, 0xbd, 0xb2, 0xa5, 0xe5, 0x2b, 0x23,
+    0x6b, 0xdd, 0x51, 0x50, 0x9f, 0xb5, 0xee, 0x30, 0xe1, 0xf5, 0x9e, 0xa5, 0x1f, 0xf9, 0xea, 0x8d,
+    0xa5, 0x7f, 0x0c, 0xfb, 0xaa, 0xf0, 0xba, 0x8b, 0x3f, 0xba, 0xf6, 0xfe, 0x25, 0xbb, 0x4e, 0x15,
+    0x4a, 0xff, 0x58, 0xdd, 0xae, 0xd2, 0xa3, 0xd5, 0xa7, 0x1f, 0x1f, 0x3d, 0xf8, 0xce, 0xf9, 0xd1,
+    0xfa, 0x7b, 0xc6, 0x0e, 0x5a, 0x53, 0xee, 0xa1, 0x6a, 0x5f, 0x3c, 0xde, 0xf2, 0xfb, 0x6d, 0x63,
+    0xcb, 0xf7, 0x28, 0xbd, 0x46, 0xb7, 0x3c, 0x1d, 0x5f, 0x57, 0xfc, 0xdd, 0xb7, 0xff, 0xe8, 0x59,
+    0xaf, 0xec, 0x63, 0x0d, 0x6a, 0x7e, 0x55, 0xea, 0x9b, 0x8e, 0xed, 0x6b, 0x4e, 0x7e, 0x7d, 0x74,
+    0x85, 0x1f, 0x57, 0x8d, 0x5b, 0x78, 0x7f, 0x83, 0xc1, 0x57, 0xbc, 0xbb, 0x31, 0xbb, 0xfa, 0xa6,
+    0xfc, 0x85, 0x4a, 0xf5, 0xdb, 0xd1, 0xf4, 0xe3, 0x0f, 0x4a, 0x2e, 0x59, 0x79, 0xc1, 0xa2, 0x63,
+    0xe7, 0xfe, 0x72, 0xe9, 0x96, 0x8f, 0x1b, 0x9c, 0x19, 0x73, 0xf3, 0x90, 0x9b, 0x4e, 0xdf, 0xbf,
+    0x61, 0xcb, 0xf4, 0x9f, 0x17, 0xae, 0xe9, 0xbe, 0xea, 0xba, 0xbb, 0x2b, 0x3e, 0xd1, 0x73, 0xdf,
+    0x82, 0x1f, 0x66, 0xae, 0x2c, 0xf4, 0xfc, 0x55, 0x9f, 0xe5, 0x1f, 0x39, 0xf1, 0x8d, 0x0f, 0xc7,
+    0x9c, 0x6a, 0xb8, 0x5f, 0x67, 0xbd, 0xb3, 0xa0, 0xc9, 0xab, 0x2f, 0xbd, 0x54, 0xeb, 0xc8, 0xec,
+    0x55, 0xed, 0x3b, 0xdc, 0xd1, 0x67, 0xe3, 0x25, 0x73, 0xb7, 0x4f, 0x88, 0x1b, 0x6e, 0xf8, 0xbe,
+    0xca, 0xea, 0x07, 0x46, 0xcf, 0x6f, 0xf0, 0x77, 0x81, 0x75, 0x3d, 0xc7, 0xdf, 0xb6, 0x25, 0x4f,
+    0xe5, 0x93, 0x77, 0x15, 0xef, 0xd8, 0x79, 0xec, 0xba, 0x35, 0x7b, 0xbe, 0x1e, 0x3a, 0xbd, 0x58,
+    0x99, 0xbb, 0x7f, 0x3e, 0xf7, 0xad, 0x01, 0x13, 0x8a, 0x8c, 0x5f, 0x75, 0x54, 0x53, 0x35, 0x72,
+    0x60, 0x97, 0x7f, 0x9d, 0x8c, 0x66, 0xbf, 0x75, 0xcf, 0x03, 0x47, 0x8b, 0x36, 0x7c, 0xb2, 0x79,
+    0xf7, 0x09, 0x1b, 0xb7, 0xd4, 0x2e, 0xd6, 0xf9, 0xc1, 0xc3, 0xf3, 0xf6, 0xbe, 0x75, 0xdb, 0x80,
+    0xfc, 0xc7, 0xce, 0x59, 0x7f, 0xf4, 0xce, 0x2b, 0xe7, 0xde, 0xf7, 0xc2, 0x93, 0x33, 0x8b, 0xf4,
+    0x99, 0xfb, 0xcd, 0x8f, 0x65, 0x9e, 0x3c, 0x3c, 0xb3, 0xe9, 0xee, 0xd3, 0x4d, 0xd7, 0x97, 0xdf,
+    0xf2, 0xdb, 0xae, 0x36, 0x6d, 0xb7, 0xdf, 0x75, 0xde, 0xc8, 0x0e, 0x1d, 0xf3, 0x9d, 0x99, 0xd5,
+    0x69, 0xe2, 0xfc, 0x56, 0x57, 0x66, 0xf9, 0xfb, 0x4d, 0x59, 0xbe, 0xf7, 0xd1, 0xf1, 0xef, 0xb4,
+    0xbf, 0xbe, 0x67, 0xd5, 0x7a, 0xa7, 0xc3, 0x8f, 0xea, 0x17, 0x2d, 0xd2, 0x28, 0xff, 0xfb, 0x1f,
+    0xed, 0x9d, 0x33, 0x7a, 0xc9, 0x75, 0x53, 0xaf, 0xde, 0x59, 0x77, 0xe2, 0xd4, 0xbb, 0x1b, 0xbe,
+    0x7d, 0xf6, 0xf0, 0xfa, 0x67, 0x55, 0x5b, 0x5d, 0xa7, 0xf6, 0x6f, 0x93, 0x8f, 0x9e, 0x3e, 0xf6,
+    0xe1, 0xa9, 0xee, 0x9f, 0xdc, 0xdb, 0xa6, 0xfd, 0x43, 0xbf, 0xd5, 0x98, 0x17, 0xcd, 0x7b, 0xae,
+    0xde, 0xeb, 0x53, 0x1b, 0x0f, 0xcd, 0xae, 0x6f, 0x38, 0x62, 0x4f, 0xf5, 0x2e, 0x7f, 0x8d, 0x2f,
+    0x36, 0xaa, 0xc2, 0xfe, 0x6f, 0x4a, 0xe7, 0x6b, 0x71, 0xf6, 0x45, 0x07, 0x7a, 0x3e, 0x7f, 0xe4,
+    0xe2, 0x2e, 0xcf, 0x77, 0xdd, 0xf2, 0x5d, 0xb1, 0x2d, 0xd3, 0x0f, 0xf4, 0x6a, 0xb4, 0xa4, 0x77,
+    0xe3, 0x45, 0xd3, 0x36, 0x8c, 0xb8, 0xb1, 0x7f, 0xd5, 0x4f, 0xd6, 0x1f, 0x6b, 0xbe, 0x63, 0xe4,
+    0x2f, 0x57, 0x9c, 0x68, 0x52, 0x70, 0x52, 0xab, 0x59, 0x87, 0xa7, 0x96, 0x3e, 0x51, 0xed, 0x97,
+    0x16, 0x07, 0xab, 0xd7, 0x7f, 0xb6, 0x5a, 0xcf, 0xee, 0x79, 0xbb, 0xac, 0xbc, 0xa7, 0x60, 0xd9,
+    0x01, 0x13, 0x36, 0x75, 0xa8, 0xb0, 0x6c, 0xf9, 0xf0, 0x55, 0x6f, 0xdc, 0xb4, 0xee, 0xde, 0xba,
+    0xe9, 0x67, 0x23, 0x4b, 0x6c, 0x7d, 0x7b, 0xeb, 0xea, 0xec, 0xca, 0x99, 0xf5, 0xbb, 0x6c, 0x9b,
+    0xd5, 0xbd, 0x44, 0xb4, 0xeb, 0xe7, 0xcd, 0x55, 0x1a, 0x4c, 0xbd, 0x73, 0x5a, 0xff, 0x46, 0x47,
+    0xba, 0xbe, 0x55, 0x65, 0x6b, 0xfb, 0x35, 0xb5, 0xf7, 0xdd, 0x7c, 0x9b, 0x4e, 0xf4, 0x7c, 0xe2,
+    0xae, 0x8f, 0x2f, 0xdd, 0x7f, 0xaa, 0xcb, 0x95, 0xb5, 0xaf, 0xdd, 0x3f, 0xed, 0xea, 0x0a, 0xc5,
+    0xdf, 0xed, 0x31, 0x7c, 0xe2, 0x35, 0xef, 0x7f, 0xf8, 0xf4, 0x4f, 0x15, 0xeb, 0xf7, 0xb9, 0xaa,
+    0xf2, 0x81, 0xb0, 0x6e, 0x09, 0x9f, 0x7a, 0x37, 0xbb, 0xb7, 0xcf, 0xc9, 0xdf, 0xf4, 0x97, 0x9a,
+    0xcc, 0x9c, 0xb2, 0x63, 0x53, 0xa9, 0xf2, 0x2f, 0xdd, 0x1c, 0x8e, 0x6d, 0xb9, 0xa7, 0xd0, 0xf0,
+    0x3c, 0x8d, 0x6b, 0xb7, 0x5b, 0xfb, 0xc9, 0x8f, 0x17, 0xd7, 0x6f, 0xfc, 0xfe, 0xb2, 0x2d, 0x45,
+    0xbe, 0x3d, 0x77, 0xc0, 0xb4, 0xde, 0x4d, 0x82, 0x2d, 0xbb, 0x87, 0xd6, 0xdc, 0x75, 0x68, 0xd2,
+    0xc1, 0xb8, 0x7e, 0xb1, 0x2e, 0x3d, 0xa6, 0x9d, 0x7d, 0xfa, 0xdd, 0x30, 0x4f, 0xff, 0xa3, 0xaf,
+    0xfd, 0x6b, 0xf3, 0xae, 0xa3, 0xe7, 0x56, 0x5e, 0x7e, 0x64, 0xd9, 0xe7, 0x1f, 0xbe, 0xfb, 0xfe,
+    0x37, 0x6d, 0xee, 0x2a, 0xf4, 0x46, 0xe3, 0xe3, 0xe7, 0xfe, 0x9d, 0x36, 0x18, 0x7a, 0x76, 0x99,
+    0xd3, 0x4b, 0xb7, 0xac, 0xbd, 0x63, 0x69, 0xe1, 0x89, 0xcd, 0x8f, 0xae, 0x6b, 0xd9, 0xb5, 0xfa,
+    0xaa, 0x0f, 0xba, 0x2c, 0xd9, 0xd1, 0xf7, 0xb5, 0xe6, 0x13, 0xfb, 0x6c, 0x69, 0x57, 0xa7, 0xed,
+    0xbc, 0xce, 0x47, 0xab, 0x97, 0x88, 0x8e, 0xbf, 0x74, 0x51, 0x9b, 0x31, 0x4f, 0x1c, 0x5c, 0x71,
+    0xe4, 0xd6, 0x5b, 0x9b, 0xdf, 0x58, 0x70, 0xc7, 0x63, 0xc7, 0x7f, 0xac, 0x92, 0xf7, 0xf0, 0xd6,
+    0xf5, 0x57, 0x1e, 0x9e, 0x53, 0xb4, 0xec, 0xae, 0xda, 0x0f, 0x74, 0x7b, 0xf4, 0x9c, 0x16, 0xe5,
+    0xfa, 0xce, 0xe9, 0xd3, 0x3e, 0xbb, 0x7c, 0xcd, 0xf0, 0x6b, 0xb6, 0xef, 0xdd, 0xb7, 0xa4, 0xfe,
+    0xc0, 0xde, 0x4b, 0xde, 0x9e, 0xad, 0x01, 0x6b, 0xbe, 0x28, 0xbf, 0xbf, 0xe7, 0xa4, 0x07, 0x77,
+    0x6c, 0xeb, 0xd3, 0xf5, 0xa7, 0x47, 0xb7, 0xef, 0xac, 0x32, 0xe3, 0xfe, 0xdb, 0x56, 0x75, 0x6f,
+    0x76, 0xfe, 0x92, 0xa7, 0x3f, 0x0b, 0x0b, 0xfa, 0xee, 0xd1, 0xaf, 0x76, 0xbb, 0xfd, 0x50, 0x99,
+    0x93, 0x4b, 0x8e, 0x6d, 0xfe, 0xec, 0xa3, 0xf7, 0x7f, 0x3a, 0x7d, 0xa8, 0xdc, 0x8b, 0xaf, 0xd4,
+    0xfa, 0xfb, 0x8a, 0x13, 0x45, 0xb7, 0xbc, 0x58, 0xaa, 0xe3, 0x82, 0x53, 0xaf, 0x0d, 0x4e, 0x36,
+    0x36, 0x5b, 0x7d, 0x7c, 0xda, 0x45, 0xcf, 0x45, 0xbf, 0x8f, 0x18, 0x31, 0x78, 0xec, 0x0b, 0x43,
+    0xae, 0x5d, 0x3f, 0xfb, 0xd0, 0x8d, 0xf7, 0xbc, 0xbd, 0xa7, 0xf6, 0xb7, 0x07, 0x17, 0xb7, 0x9b,
+    0x7b, 0x85, 0x2e, 0x5f, 0x56, 0xe3, 0xdf, 0x8b, 0x06, 0x1e, 0xff, 0xba, 0xe8, 0xfa, 0x6f, 0x75,
+    0x5b, 0xc1, 0xc6, 0xfd, 0x0e, 0x8e, 0x18, 0x3b, 0xbb, 0x51, 0x87, 0x8d, 0x73, 0xeb, 0x56, 0x78,
+    0xfd, 0xbc, 0xb5, 0x95, 0x4f, 0x5c, 0x13, 0xff, 0xbe, 0xad, 0xc1, 0x94, 0xed, 0x3b, 0x87, 0xf4,
+    0x3f, 0xf1, 0x70, 0xa1, 0xce, 0x2d, 0x47, 0xcd, 0x69, 0xd9, 0xf6, 0x82, 0x0d, 0xbb, 0x87, 0xbc,
+    0x50, 0x63, 0xcf, 0x25, 0xbf, 0xff, 0xa7, 0xd1, 0xc4, 0x96, 0xb7, 0x3e, 0x5b, 0x6c, 0x77, 0xa1,
+    0xca, 0x9f, 0xe6, 0xed, 0xf9, 0x74, 0x91, 0x03, 0xdd, 0x9f, 0x98, 0xf5, 0xe8, 0x4f, 0x7d, 0x7f,
+    0xfb, 0x62, 0x61, 0x83, 0x95, 0x57, 0x3d, 0x79, 0x56, 0x95, 0x49, 0x95, 0xfa, 0x9f, 0x37, 0xbc,
+    0xd1, 0xe1, 0x79, 0x85, 0xb5, 0xad, 0xf9, 0x84, 0xae, 0x7f, 0xcd, 0xb9, 0x6a, 0xc9, 0xf6, 0x7c,
+    0x41, 0x81, 0xaa, 0x2b, 0x5f, 0x5a, 0x70, 0x59, 0xb8, 0xfa, 0x86, 0x37, 0x75, 0xdf, 0x9b, 0x1f,
+    0x8d, 0x7d, 0x27, 0xeb, 0xd7, 0xfa, 0xe2, 0xd2, 0x57, 0xbc, 0xbd, 0xb9, 0xc1, 0x89, 0x87, 0x57,
+    0x65, 0x25, 0x06, 0x14, 0xd9, 0x3b, 0xfe, 0xc9, 0xf3, 0xcb, 0x2c, 0x3a, 0xba, 0x20, 0x7a, 0xff,
+    0xc5, 0x8d, 0x83, 0x5e, 0xaa, 0x5f, 0xf4, 0xd3, 0x72, 0x2b, 0xe6, 0x57, 0xe8, 0xb6, 0xfd, 0xcf,
+    0x3f, 0x3a, 0x7d, 0x3e, 0xac, 0xde, 0x94, 0x5b, 0xab, 0x34, 0x1f, 0x38, 0xeb, 0x8f, 0x66, 0xaf,
+    0x5c, 0x7c, 0x59, 0xe7, 0x9a, 0xbf, 0xae, 0x2d, 0xdf, 0xa5, 0xe9, 0xd6, 0xad, 0xdf, 0xb6, 0x1b,
+    0x3f, 0xbd, 0xe6, 0x5f, 0xa9, 0x6a, 0x0f, 0xac, 0x58, 0x7f, 0x7f, 0x93, 0x23, 0xb7, 0xfc, 0x75,
+    0xa0, 0xc0, 0x3b, 0xd5, 0x16, 0x56, 0x79, 0x33, 0xdc, 0xfd, 0xe7, 0xf6, 0x55, 0x1f, 0xdf, 0x55,
+    0x6b, 0xf4, 0xfe, 0xe7, 0x0e, 0x5d, 0x5a, 0x76, 0xed, 0xf6, 0x61, 0xa5, 0x9b, 0x8e, 0xeb, 0xba,
+    0xad, 0x63, 0xa7, 0x3f, 0xbe, 0x3e, 0x39, 0xb8, 0xd4, 0xbe, 0x3a, 0x4b, 0x07, 0x17, 0x28, 0x71,
+    0xf6, 0x45, 0x33, 0xc7, 0xed, 0xb9, 0x73, 0x57, 0xc5, 0x56, 0xad, 0x3a, 0xee, 0xdd, 0x54, 0x31,
+    0xf8, 0xf2, 0xf1, 0x99, 0x7b, 0x37, 0x2f, 0xe8, 0x94, 0x67, 0x40, 0xa5, 0xb9, 0x6b, 0x9e, 0x1b,
+    0x70, 0xe3, 0x7f, 0xb7, 0x1f, 0xfd, 0xea, 0x8a, 0x63, 0x23, 0x8f, 0xef, 0xbb, 0xad, 0xee, 0xd8,
+    0xfd, 0x9f, 0xfc, 0x74, 0x59, 0x8b, 0x7a, 0xb5, 0x0b, 0x8e, 0x7e, 0xf2, 0x50, 0xfd, 0x73, 0x1e,
+    0x3c, 0xd6, 0xfe, 0x91, 0xe2, 0x9b, 0x2b, 0xd5, 0x38, 0x73, 0xa6, 0x4f, 0x8d, 0xe9, 0x97, 0x8e,
+    0x7d, 0x79, 0x68, 0xd1, 0x9b, 0x96, 0x4e, 0x3d, 0xfa, 0x80, 0x07, 0xb7, 0xbb, 0xf0, 0xf0, 0x73,
+    0x7f, 0x4f, 0xeb, 0x57, 0xfd, 0x8e, 0x8f, 0x7e, 0xab, 0x39, 0xe6, 0x91, 0x41, 0xc9, 0xc0, 0xfe,
+    0x57, 0x6f, 0x6e, 0x5e, 0xbc, 0xef, 0xc2, 0x3c, 0xb3, 0x8e, 0xcc, 0xd9, 0xb8, 0xa3, 0xce, 0x0d,
+    0x15, 0xc2, 0x2b, 0xaf, 0x9f, 0xdf, 0x38, 0xcf, 0xce, 0x47, 0xa2, 0x76, 0xd5, 0x87, 0x1c, 0x6a,
+    0x5a, 0x6d, 0x73, 0x8b, 0x3d, 0x6b, 0xdc, 0xa7, 0x6a, 0x9f, 0x5e, 0x4f, 0xcc, 0x29, 0xd7, 0x68,
+    0xca, 0x2d, 0x67, 0x76, 0xff, 0x1c, 0xcd, 0xdf, 0xd9, 0xa6, 0xdc, 0x89, 0x4f, 0xaa, 0xec, 0xbf,
+    0x75, 0xcc, 0xec, 0x46, 0x6b, 0xef, 0x1b, 0x3e, 0x7e, 0xce, 0x63, 0x0b, 0x3a, 0xbd, 0xbc, 0xa6,
+    0xd8, 0xe9, 0xea, 0xcd, 0x5e, 0x9a, 0xb5, 0xf0, 0xc8, 0xdc, 0xbb, 0x6a, 0xb6, 0x5f, 0xf9, 0xec,
+    0x6d, 0xff, 0xba, 0x7b, 0xf4, 0x80, 0x21, 0xe3, 0x8b, 0xbc, 0x7c, 0x4f, 0xbf, 0x86, 0x1f, 0x1c,
+    0x5b, 0x3a, 0x69, 0x59, 0xbd, 0xdf, 0xf3, 0x86, 0x4b, 0x16, 0x95, 0xca, 0x3b, 0xf7, 0x48, 0xaf,
+    0x32, 0xa5, 0xba, 0xcd, 0x7f, 0xac, 0xf3, 0xb6, 0xc7, 0x6f, 0xbe, 0x6d, 0x76, 0xd9, 0x86, 0xa5,
+    0xdf, 0x71, 0xf8, 0xf2, 0xe0, 0x47, 0xa6, 0xb7, 0x1d, 0xf3, 0x79, 0xd5, 0xdb, 0x4f, 0x06, 0xd3,
+    0x3a, 0x6b, 0x43, 0xff, 0xcd, 0x0f, 0xd6, 0xbe, 0xbd, 0x43, 0xbb, 0x7f, 0x4f, 0x7b, 0x75, 0xe7,
+    0xd5, 0x1f, 0x95, 0x9e, 0x7c, 0x4f, 0xed, 0x72, 0x17, 0xf6, 0x3c, 0xaf, 0x65, 0xbb, 0x3e, 0xa3,
+    0xb7, 0x36, 0x1f, 0x52, 0x67, 0xe0, 0x4f, 0xdd, 0xc7, 0xf7, 0x18, 0xf4, 0x43, 0xd7, 0xff, 0x3e,
+    0xd4, 0xf0, 0x50, 0xdb, 0xeb, 0xe7, 0x8d, 0x9b, 0xb1, 0xf4, 0xbd, 0x9b, 0xfa, 0x36, 0xac, 0x35,
+    0x7d, 0xdc, 0xbe, 0x2b, 0xdb, 0xd7, 0xff, 0x72, 0xde, 0x92, 0x7a, 0x83, 0xbb, 0x4d, 0xf9, 0x70,
+    0xc7, 0x25, 0x33, 0xbb, 0xd4, 0xea, 0xf7, 0xe0, 0xd3, 0xc3, 0x9b, 0x0e, 0x39, 0xff, 0xa9, 0x31,
+    0xe5, 0x9f, 0xac, 0xf9, 0xec, 0xb5, 0x0f, 0xbd, 0xf0, 0xf5, 0x89, 0x7e, 0x8d, 0x6a, 0x4c, 0xae,
+    0x30, 0x64, 0xcf, 0x86, 0x29, 0x6d, 0x9e, 0xfa, 0x57, 0xb9, 0x91, 0x77, 0x94, 0x59, 0x7c, 0x78,
+    0x59, 0xbd, 0xd9, 0x0f, 0x1e, 0x6c, 0xfd, 0xdb, 0xd6, 0x25, 0x8d, 0x2e, 0xff, 0x72, 0x61, 0xdf,
+    0x6a, 0xdf, 0x6f, 0x5e, 0xf4, 0x50, 0xfb, 0xfd, 0xad, 0x77, 0x9f, 0xf7, 0xd6, 0x35, 0x8f, 0xcf,
+    0xfd, 0xe8, 0xb1, 0x5f, 0x9b, 0x74, 0x99, 0xbe, 0xf9, 0x9b, 0x5d, 0xc5, 0x17, 0x17, 0x1d, 0xb4,
+    0xb5, 0xe4, 0x75, 0x5f, 0x5e, 0xdf, 0xa6, 0x55, 0xc1, 0xc5, 0x4d, 0x26, 0x8c, 0x1d, 0xd1, 0x6e,
+    0xdd, 0xcd, 0x3f, 0x2c, 0x2e, 0x7d, 0xde, 0x0b, 0x27, 0x17, 0x9f, 0x5d, 0xe3, 0x60, 0x8b, 0x21,
+    0x03, 0xdf, 0xfa, 0xbe, 0xff, 0xe3, 0xef, 0x16, 0xbb, 0xbb, 0xfa, 0x67, 0xdf, 0x75, 0x7f, 0xa0,
+    0xf5, 0xb8, 0xd3, 0x43, 0x4e, 0x4d, 0xfd, 0x64, 0xf8, 0x6d, 0x4d, 0x93, 0x99, 0x0b, 0xf2, 0x97,
+    0xda, 0x7a, 0x4b, 0xd7, 0x3f, 0xb7, 0x4f, 0x8e, 0x6f, 0xd9, 0x5a, 0xeb, 0x4c, 0x70, 0xf0, 0xae,
+    0xaa, 0xaf, 0x37, 0xf9, 0xfa, 0x9b, 0xea, 0x23, 0x07, 0xf5, 0xfb, 0x61, 0x5b, 0xb7, 0xaf, 0x1f,
+    0xfa, 0xe3, 0xd7, 0x6a, 0x75, 0x2b, 0x5d, 0xdb, 0xb7, 0x5e, 0xf3, 0x47, 0x8a, 0xb7, 0x58, 0x59,
+    0xbe, 0xd3, 0x8c, 0x2e, 0x4b, 0x07, 0x47, 0xed, 0x0b, 0x6d, 0xea, 0xb6, 0x69, 0x53, 0xab, 0x0a,
+    0x23, 0xc6, 0x9e, 0xf7, 0xfa, 0xa2, 0xc1, 0x8d, 0x6f, 0xd8, 0x7b, 0xd6, 0x59, 0x53, 0xe2, 0x5f,
+    0x9f, 0xe8, 0x71, 0x60, 0xd6, 0xa7, 0x4b, 0x8e, 0x1d, 0x9a, 0xb3, 0xba, 0x46, 0xcb, 0xbc, 0xd3,
+    0x47, 0x2f, 0xbf, 0xb9, 0x72, 0xa3, 0x42, 0x3d, 0x0a, 0x95, 0x6c, 0x50, 0xab, 0xd1, 0x67, 0xe5,
+    0xfb, 0xe4, 0x9d, 0x79, 0xa2, 0x4e, 0xb1, 0xb3, 0x2a, 0x8d, 0x7b, 0x6e, 0xd5, 0x9a, 0x19, 0x07,
+    0x27, 0x96, 0xfb, 0xfe, 0xc4, 0x99, 0xd2, 0xe7, 0xbe, 0xf8, 0xcb, 0xf5, 0x03, 0x96, 0xb7, 0xbc,
+    0xb6, 0xc0, 0x83, 0x23, 0x7e, 0x6a, 0x32, 0xea, 0xc7, 0xf6, 0x2f, 0x6e, 0xf9, 0xf4, 0x4c, 0xed,
+    0xd2, 0x85, 0x2f, 0xed, 0x52, 0xe5, 0xa6, 0x45, 0x5b, 0x07, 0x35, 0xfd, 0xfc, 0xc3, 0xdd, 0x85,
+    0xeb, 0x2e, 0xfa, 0xf4, 0xbd, 0x7d, 0xa3, 0xb7, 0xed, 0x9e, 0x74, 0x71, 0x8b, 0xf2, 0x85, 0x6f,
+    0x6e, 0x79, 0x74, 0x40, 0x93, 0x69, 0x05, 0x17, 0x1f, 0xab, 0xb7, 0xb4, 0xe3, 0xe3, 0x2d, 0x37,
+    0xbd, 0xd1, 0x7c, 0x45, 0xd7, 0x4f, 0xfb, 0xdf, 0xdd, 0xb6, 0xf5, 0xd6, 0xce, 0x43, 0xde, 0xac,
+    0x34, 0x74, 0xfa, 0x9a, 0x9a, 0x69, 0x72, 0x5e, 0xd5, 0x0a, 0x87, 0xfb, 0x55, 0xfb, 0xcf, 0x81,
+    0x09, 0x65, 0xa7, 0xbc, 0xf9, 0xc4, 0x17, 0x1f, 0xac, 0xfe, 0xfd, 0xc1, 0xff, 0x7d, 0x55, 0xb7,
+    0xbf, 0x1e, 0x34, 0x38, 0xbf, 0xfc, 0x84, 0x2e, 0x6f, 0xe4, 0xa9, 0x7f, 0xa8, 0xdb, 0xca, 0x3f,
+    0x6b, 0x65, 0x57, 0xf5, 0x7d, 0xed, 0x81, 0x96, 0x05, 0xca, 0x94, 0xe8, 0xb5, 0xe1, 0x9a, 0x8f,
+    0x0b, 0x0d, 0xde, 0x3b, 0xfa, 0xd2, 0x49, 0xa7, 0xd3, 0xba, 0xe9, 0xa6, 0xfa, 0xf7, 0x1e, 0x1b,
+    0xde, 0x7e, 0x4c, 0xcb, 0x7d, 0x3f, 0x5c, 0x58, 0xe9, 0xd3, 0xf1, 0x8b, 0x82, 0x27, 0x2b, 0xf5,
+    0xaf, 0xbe, 0xe2, 0xda, 0xa7, 0x1e, 0x99, 0x7e, 0xb0, 0xed, 0xd3, 0xf9, 0xca, 0x15, 0xff, 0xcf,
+    0xa6, 0xdb, 0xdf, 0xdb, 0xe9, 0x49, 0xb3, 0xee, 0x4f, 0x2a, 0x97, 0x9b, 0xf5, 0x64, 0xdd, 0xf7,
+    0x5a, 0x37, 0x39, 0xdd, 0x73, 0xc3, 0x05, 0x85, 0x56, 0x0c, 0x78, 0x66, 0xdf, 0x55, 0x43, 0xde,
+    0xbd, 0x63, 0x52, 0xeb, 0xdb, 0x7b, 0x6f, 0x5b, 0x55, 0x7d, 0x48, 0x99, 0x92, 0x45, 0x8b, 0x1f,
+    0x5d, 0x70, 0xf6, 0x89, 0x41, 0xab, 0x5f, 0x7e, 0x61, 0x5f, 0xdc, 0x6d, 0xc7, 0xa1, 0x33, 0x75,
+    0x9e, 0xde, 0xf7, 0xd4, 0xa3, 0xc5, 0xff, 0xdb, 0x34, 0xef, 0xae, 0xbb, 0x5b, 0x14, 0x9c, 0x5a,
+    0x74, 0xc7, 0x5d, 0x63, 0x2f, 0xfe, 0x6b, 0x55, 0x91, 0xca, 0x93, 0xcf, 0xd9, 0xf0, 0xc4, 0x8d,
+    0xe9, 0x65, 0xe5, 0x2f, 0xff, 0xe9, 0xf5, 0x7b, 0x0a, 0x0d, 0x2f, 0x9a, 0x7c, 0xbf, 0xb3, 0xf7,
+    0x94, 0x87, 0xf7, 0xb7, 0x18, 0xb3, 0x73, 0xd9, 0x94, 0xb2, 0x35, 0x2e, 0x28, 0xb8, 0xb1, 0xf4,
+    0x90, 0x65, 0x8b, 0xbb, 0xad, 0x4c, 0x7a, 0x5f, 0x50, 0xae, 0xee, 0xfe, 0xa3, 0xcd, 0x67, 0xf5,
+    0xad, 0xb0, 0x34, 0x7a, 0x74, 0x44, 0x98, 0xbe, 0x7f, 0x5f, 0xd5, 0xeb, 0x17, 0x26, 0x55, 0x5a,
+    0xf6, 0xef, 0xf7, 0xdb, 0x9d, 0x35, 0xe6, 0x75, 0x98, 0x77, 0xba, 0xe8, 0x8e, 0xa7, 0x1a, 0xed,
+    0xad, 0xd2, 0xf4, 0xfb, 0x47, 0xda, 0x5e, 0xd8, 0x74, 0x74, 0xad, 0xb7, 0x66, 0x3c, 0x3a, 0x23,
+    0x69, 0xfd, 0xca, 0xf4, 0x21, 0x8d, 0x4f, 0x5c, 0xdc, 0x63, 0xee, 0xcc, 0xbe, 0xc7, 0xbe, 0x6c,
+    0xf6, 0x4b, 0x99, 0x6b, 0xa6, 0x0d, 0x78, 0xa5, 0xdb, 0xbe, 0xf7, 0xce, 0xfe, 0xad, 0x52, 0xaf,
+    0x8a, 0x1d, 0x7b, 0x6e, 0x5c, 0xfc, 0xd1, 0x65, 0xaf, 0xff, 0xd5, 0xf9, 0xe3, 0x8d, 0xd7, 0x8f,
+    0xb9, 0xa0, 0xf9, 0xd0, 0xf3, 0xca, 0x56, 0x4c, 0xfe, 0xde, 0x3a, 0x6c, 0x67, 0x9d, 0x2f, 0xc6,
+    0x9c, 0xb3, 0xb6, 0x70, 0xc9, 0x6b, 0x4b, 0x8d, 0x1a, 0xf3, 0x46, 0xd7, 0xde, 0x43, 0xfc, 0xed,
+    0xa5, 0x27, 0x7b, 0x0c, 0x9d, 0xd2, 0x7c, 0xdb, 0x8a, 0xa9, 0xed, 0x17, 0x77, 0xb8, 0xf3, 0x5f,
+    0x33, 0x46, 0xb4, 0x58, 0x59, 0x78, 0xc0, 0xb1, 0xe1, 0xd7, 0x7d, 0x77, 0x6a, 0xe5, 0xd1, 0x53,
+    0xed, 0xde, 0x99, 0xf9, 0xf6, 0x75, 0x9d, 0xb2, 0x4a, 0x85, 0xbf, 0xea, 0x58, 0xb0, 0xf0, 0x80,
+    0x71, 0xf9, 0xa6, 0x07, 0x6d, 0x6a, 0xad, 0xa9, 0x78, 0xd1, 0x82, 0x89, 0x65, 0xa7, 0xbd, 0x7b,
+    0xbc, 0xda, 0x94, 0x82, 0x93, 0x7b, 0xaf, 0xbf, 0x30, 0x3d, 0xfe, 0xf4, 0xf9, 0x97, 0x5c, 0xd1,
+    0xb3, 0x5d, 0x9b, 0xee, 0x3d, 0xdb, 0x96, 0xb9, 0xe9, 0xff, 0x7e, 0xaa, 0xe0, 0x21, 0x3e, 0xcc,
+    0x47, 0xc0, 0x47, 0xc8, 0x47, 0xc4, 0x47, 0xcc, 0x47, 0xc2, 0x47, 0xca, 0x47, 0x86, 0x87, 0xb8,
+    0x40, 0x5c, 0x20, 0x2e, 0x10, 0x17, 0x88, 0x0b, 0xc4, 0x05, 0xe2, 0x02, 0x71, 0x81, 0xb8, 0x40,
+    0x5c, 0x60, 0x2e, 0x30, 0x17, 0x98, 0x0b, 0xcc, 0x05, 0xe6, 0x02, 0x73, 0x81, 0xb9, 0xc0, 0x5c,
+    0x60, 0x2e, 0x30, 0x17, 0x04, 0x5c, 0x10, 0x70, 0x41, 0xc0, 0x05, 0x01, 0x17, 0x04, 0x5c, 0x10,
+    0x70, 0x41, 0xc0, 0x05, 0x01, 0x17, 0x04, 0x5c, 0x10, 0x70, 0x41, 0xc8, 0x05, 0x21, 0x17, 0x84,
+    0x5c, 0x10, 0x72, 0x41, 0xc8, 0x05, 0x21, 0x17, 0x84, 0x5c, 0x10, 0x72, 0x41, 0xc8, 0x05, 0x21,
+    0x17, 0x44, 0x5c, 0x10, 0x71, 0x41, 0xc4, 0x05, 0x11, 0x17, 0x44, 0x5c, 0x10, 0x71, 0x41, 0xc4,
+    0x05, 0x11, 0x17, 0x44, 0x5c, 0x10, 0x71, 0x41, 0xcc, 0x05, 0x31, 0x17, 0xc4, 0x5c, 0x10, 0x73,
+    0x41, 0xcc, 0x05, 0x31, 0x17, 0xc4, 0x5c, 0x10, 0x73, 0x41, 0xcc, 0x05, 0x31, 0x17, 0x24, 0x5c,
+    0x90, 0x70, 0x41, 0xc2, 0x05, 0x09, 0x17, 0x24, 0x5c, 0x90, 0x70, 0x41, 0xc2, 0x05, 0x09, 0x17,
+    0x24, 0x5c, 0x90, 0x70, 0x41, 0xca, 0x05, 0x29, 0x17, 0xa4, 0x5c, 0x90, 0x72, 0x41, 0xca, 0x05,
+    0x29, 0x17, 0xa4, 0x5c, 0x90, 0x72, 0x41, 0xca, 0x05, 0x29, 0x17, 0x64, 0x5c, 0x90, 0x71, 0x41,
+    0xc6, 0x05, 0x19, 0x17, 0x64, 0x5c, 0x90, 0x71, 0x41, 0xc6, 0x05, 0x19, 0x17, 0x64, 0x5c, 0x90,
+    0x61, 0x81, 0xd8, 0x44, 0xb1, 0x89, 0x62, 0x13, 0xc5, 0x26, 0x8a, 0x4d, 0x14, 0x9b, 0x28, 0x36,
+    0x51, 0x6c, 0xa2, 0xd8, 0x44, 0xb1, 0x89, 0x62, 0x13, 0xc5, 0x26, 0x8a, 0x4d, 0x14, 0x9b, 0x28,
+    0x36, 0x51, 0x6c, 0xa2, 0xd8, 0x44, 0xb1, 0x89, 0x62, 0x13, 0xc5, 0x26, 0x8a, 0x4d, 0x14, 0x9b,
+    0x28, 0x36, 0x51, 0x6c, 0xa2, 0xd8, 0x44, 0xb1, 0x89, 0x62, 0x13, 0xc5, 0x26, 0x8a, 0x4d, 0x14,
+    0x9b, 0x28, 0x36, 0x51, 0x6c, 0xa2, 0xd8, 0x44, 0xb1, 0x89, 0x62, 0x13, 0xc5, 0x26, 0x8a, 0x4d,
+    0x14, 0x9b, 0x28, 0x36, 0x51, 0x6c, 0xa2, 0xd8, 0x44, 0xb1, 0x89, 0x62, 0x13, 0xc5, 0x26, 0x8a,
+    0x4d, 0x14, 0x9b, 0x28, 0x36, 0x51, 0x6c, 0xa2, 0xd8, 0x44, 0xb1, 0x89, 0x62, 0x13, 0xc5, 0x26,
+    0x8a, 0x4d, 0x14, 0x9b, 0x28, 0x36, 0x51, 0x6c, 0xa2, 0xd8, 0x44, 0xb1, 0x89, 0x62, 0x13, 0xc5,
+    0x26, 0x8a, 0x4d, 0x14, 0x9b, 0x28, 0x36, 0x51, 0x6c, 0xa2, 0xd8, 0x44, 0xb1, 0x89, 0x62, 0x13,
+    0xc5, 0x26, 0x8a, 0x4d, 0x14, 0x9b, 0x28, 0x36, 0x51, 0x6c, 0xa2, 0xd8, 0x44, 0xb1, 0x89, 0x62,
+    0x13, 0xc5, 0x26, 0x8a, 0x4d, 0x14, 0x9b, 0x28, 0x36, 0x51, 0x6c, 0xa2, 0xd8, 0x44, 0xb1, 0x89,
+    0x62, 0x13, 0xc5, 0x26, 0x8a, 0x4d, 0x14, 0x9b, 0x28, 0x36, 0x51, 0x6c, 0xa2, 0xd8, 0x44, 0xb1,
+    0x89, 0x62, 0x13, 0xc5, 0x26, 0x8a, 0x4d, 0x14, 0x9b, 0x28, 0x36, 0x51, 0x6c, 0xa2, 0xd8, 0x44,
+    0xb1, 0x89, 0x62, 0x13, 0xc5, 0x26, 0x9a, 0x4d, 0x34, 0x9b, 0x68, 0x36, 0xd1, 0x6c, 0xa2, 0xd9,
+    0x44, 0xb3, 0x89, 0x66, 0x13, 0xcd, 0x26, 0x9a, 0x4d, 0x34, 0x9b, 0x68, 0x36, 0xd1, 0x6c, 0xa2,
+    0xd9, 0x44, 0xb3, 0x89, 0x66, 0x13, 0xcd, 0x26, 0x9a, 0x4d, 0x34, 0x9b, 0x68, 0x36, 0xd1, 0x6c,
+    0xa2, 0xd9, 0x44, 0xb3, 0x89, 0x66, 0x13, 0xcd, 0x26, 0x9a, 0x4d, 0x34, 0x9b, 0x68, 0x36, 0xd1,
+    0x6c, 0xa2, 0xd9, 0x44, 0xb3, 0x89, 0x66, 0x13, 0xcd, 0x26, 0x9a, 0x4d, 0x34, 0x9b, 0x68, 0x36,
+    0xd1, 0x6c, 0xa2, 0xd9, 0x44, 0xb3, 0x89, 0x66, 0x13, 0xcd, 0x26, 0x9a, 0x4d, 0x34, 0x9b, 0x68,
+    0x36, 0xd1, 0x6c, 0xa2, 0xd9, 0x44, 0xb3, 0x89, 0x66, 0x13, 0xcd, 0x26, 0x9a, 0x4d, 0x34, 0x9b,
+    0x68, 0x36, 0xd1, 0x6c, 0xa2, 0xd9, 0x44, 0xb3, 0x89, 0x66, 0x13, 0xcd, 0x26, 0x9a, 0x4d, 0x34,
+    0x9b, 0x68, 0x36, 0xd1, 0x6c, 0xa2, 0xd9, 0x44, 0xb3, 0x89, 0x66, 0x13, 0xcd, 0x26, 0x9a, 0x4d,
+    0x34, 0x9b, 0x68, 0x36, 0xd1, 0x6c, 0xa2, 0xd9, 0x44, 0xb3, 0x89, 0x66, 0x13, 0xcd, 0x26, 0x9a,
+    0x4d, 0x34, 0x9b, 0x68, 0x36, 0xd1, 0x6c, 0xa2, 0xd9, 0x44, 0xb3, 0x89, 0x66, 0x13, 0xcd, 0x26,
+    0x9a, 0x4d, 0x34, 0x9b, 0x68, 0x36, 0xd1, 0x6c, 0xa2, 0xd9, 0x44, 0xb3, 0x89, 0x66, 0x13, 0xcd,
+    0x26, 0x9a, 0x4d, 0x34, 0x9b, 0x68, 0x36, 0xd1, 0x6c, 0xa2, 0xd9, 0x44, 0xb3, 0x89, 0x66, 0x13,
+    0xcd, 0x26, 0x9a, 0x4d, 0x34, 0x9b, 0x68, 0x36, 0xd1, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62,
+    0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0,
+    0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26,
+    0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06,
+    0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c,
+    0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62,
+    0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0,
+    0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26,
+    0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06,
+    0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c,
+    0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62,
+    0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0,
+    0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26,
+    0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06,
+    0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c,
+    0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc0, 0x26, 0x06, 0x6c, 0x62,
+    0xc0, 0x26, 0x06, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8,
+    0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26,
+    0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86,
+    0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c,
+    0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62,
+    0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8,
+    0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26,
+    0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86,
+    0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c,
+    0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62,
+    0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8,
+    0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26,
+    0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86,
+    0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c,
+    0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62,
+    0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc8, 0x26, 0x86, 0x6c, 0x62, 0xc4,
+    0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26,
+    0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46,
+    0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c,
+    0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62,
+    0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4,
+    0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26,
+    0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46,
+    0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c,
+    0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62,
+    0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4,
+    0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26,
+    0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46,
+    0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c,
+    0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62,
+    0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xc4,
+    0x26, 0x46, 0x6c, 0x62, 0xc4, 0x26, 0x46, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26,
+    0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6,
+    0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c,
+    0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62,
+    0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc,
+    0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26,
+    0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6,
+    0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c,
+    0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62,
+    0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc,
+    0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26,
+    0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6,
+    0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c,
+    0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62,
+    0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc,
+    0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26, 0xc6, 0x6c, 0x62, 0xcc, 0x26,
+    0xc6, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26,
+    0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c,
+    0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62,
+    0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2,
+    0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26,
+    0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26,
+    0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c,
+    0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62,
+    0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2,
+    0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26,
+    0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26,
+    0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c,
+    0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62,
+    0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2,
+    0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26,
+    0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xc2, 0x26, 0x26, 0x6c, 0x62, 0xca, 0x26, 0xa6,
+    0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c,
+    0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62,
+    0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca,
+    0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26,
+    0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6,
+    0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c,
+    0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62,
+    0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca,
+    0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26,
+    0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6,
+    0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c,
+    0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62,
+    0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca,
+    0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26,
+    0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xca, 0x26, 0xa6,
+    0x6c, 0x62, 0xca, 0x26, 0xa6, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c,
+    0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62,
+    0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6,
+    0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26,
+    0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66,
+    0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c,
+    0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62,
+    0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6,
+    0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26,
+    0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66,
+    0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c,
+    0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62,
+    0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6,
+    0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26,
+    0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66,
+    0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x6c, 0x62, 0xc6, 0x26, 0x66, 0x68,
+    0xa2, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2,
+    0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45,
+    0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1,
+    0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a,
+    0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44,
+    0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b,
+    0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63,
+    0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74,
+    0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88,
+    0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16,
+    0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7,
+    0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8,
+    0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11,
+    0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c,
+    0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e,
+    0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1,
+    0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22,
+    0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58,
+    0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d,
+    0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2,
+    0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45,
+    0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1,
+    0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a,
+    0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44,
+    0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b,
+    0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63,
+    0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74,
+    0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88,
+    0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16,
+    0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7,
+    0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8,
+    0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11,
+    0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c,
+    0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e,
+    0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1,
+    0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22,
+    0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58,
+    0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d,
+    0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2,
+    0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45,
+    0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1,
+    0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a,
+    0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44,
+    0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b,
+    0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63,
+    0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74,
+    0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88,
+    0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16,
+    0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7,
+    0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8,
+    0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11,
+    0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c,
+    0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e,
+    0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1,
+    0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22,
+    0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58,
+    0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d,
+    0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2,
+    0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45,
+    0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1,
+    0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a,
+    0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44,
+    0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b,
+    0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63,
+    0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74,
+    0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88,
+    0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16,
+    0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7,
+    0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8,
+    0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11,
+    0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c,
+    0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e,
+    0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1,
+    0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22,
+    0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58,
+    0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d,
+    0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2,
+    0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45,
+    0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1,
+    0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a,
+    0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44,
+    0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b,
+    0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63,
+    0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74,
+    0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88,
+    0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16,
+    0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7,
+    0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8,
+    0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11,
+    0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c,
+    0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e,
+    0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1,
+    0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22,
+    0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58,
+    0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d,
+    0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2,
+    0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45,
+    0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1,
+    0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a,
+    0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44,
+    0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b,
+    0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63,
+    0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74,
+    0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88,
+    0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16,
+    0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7,
+    0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8,
+    0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11,
+    0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c,
+    0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e,
+    0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1,
+    0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22,
+    0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58,
+    0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d,
+    0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2,
+    0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45,
+    0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1,
+    0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a,
+    0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44,
+    0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b,
+    0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63,
+    0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74,
+    0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88,
+    0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16,
+    0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7,
+    0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8,
+    0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11,
+    0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c,
+    0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e,
+    0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1,
+    0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22,
+    0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58,
+    0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d,
+    0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2,
+    0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45,
+    0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1,
+    0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a,
+    0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44,
+    0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b,
+    0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63,
+    0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74,
+    0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88,
+    0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16,
+    0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7,
+    0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8,
+    0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11,
+    0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e, 0x45, 0x74, 0x2c,
+    0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe8, 0x58, 0x44, 0xc7, 0x22, 0x3a, 0x16, 0xd1, 0xb1, 0x88, 0x8e,
+    0x45, 0x74, 0x2c, 0xa2, 0x63, 0x11, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3,
+    0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62,
+    0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58,
+    0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d,
+    0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6,
+    0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5,
+    0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1,
+    0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a,
+    0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c,
+    0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b,
+    0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63,
+    0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74,
+    0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98,
+    0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16,
+    0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7,
+    0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9,
+    0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31,
+    0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c,
+    0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e,
+    0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3,
+    0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62,
+    0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58,
+    0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d,
+    0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6,
+    0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5,
+    0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1,
+    0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a,
+    0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c,
+    0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b,
+    0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63,
+    0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74,
+    0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98,
+    0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16,
+    0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7,
+    0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9,
+    0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31,
+    0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c,
+    0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e,
+    0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3,
+    0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62,
+    0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58,
+    0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d,
+    0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6,
+    0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5,
+    0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1,
+    0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a,
+    0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c,
+    0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b,
+    0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63,
+    0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74,
+    0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98,
+    0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16,
+    0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7,
+    0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9,
+    0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31,
+    0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c,
+    0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e,
+    0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3,
+    0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62,
+    0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58,
+    0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d,
+    0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6,
+    0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5,
+    0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1,
+    0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a,
+    0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c,
+    0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b,
+    0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63,
+    0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74,
+    0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98,
+    0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16,
+    0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7,
+    0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9,
+    0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31,
+    0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c,
+    0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e,
+    0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3,
+    0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62,
+    0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58,
+    0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d,
+    0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6,
+    0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5,
+    0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1,
+    0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a,
+    0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c,
+    0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b,
+    0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63,
+    0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74,
+    0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98,
+    0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16,
+    0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7,
+    0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9,
+    0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31,
+    0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c,
+    0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e,
+    0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3,
+    0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62,
+    0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58,
+    0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d,
+    0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6,
+    0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5,
+    0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1,
+    0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a,
+    0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c,
+    0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b,
+    0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63,
+    0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74,
+    0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98,
+    0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16,
+    0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7,
+    0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9,
+    0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31,
+    0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c,
+    0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e,
+    0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3,
+    0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62,
+    0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58,
+    0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d,
+    0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6,
+    0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5,
+    0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1,
+    0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a,
+    0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c,
+    0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b,
+    0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63,
+    0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74,
+    0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98,
+    0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16,
+    0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7,
+    0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9,
+    0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31,
+    0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c,
+    0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e,
+    0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3,
+    0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62,
+    0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58,
+    0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d,
+    0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6,
+    0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5,
+    0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1,
+    0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a,
+    0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c,
+    0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b,
+    0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63,
+    0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74,
+    0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98,
+    0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7, 0x62, 0x3a, 0x16,
+    0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0x31, 0x1d, 0x8b, 0xe9, 0x58, 0x4c, 0xc7,
+    0x62, 0x3a, 0x16, 0xd3, 0xb1, 0x98, 0x8e, 0xc5, 0x74, 0x2c, 0xa6, 0x63, 0xf1, 0xff, 0x39, 0x96,
+    0xbc, 0xbb, 0x5a, 0x1c, 0x5e, 0x94, 0xf7, 0x7f, 0xff, 0xf2, 0xe4, 0x5d, 0x71, 0x26, 0x7f, 0x99,
+    0x32, 0x79, 0xf2, 0x3e, 0xbb, 0x34, 0xdf, 0x17, 0x95, 0xbf, 0xa8, 0x9c, 0x27, 0xcf, 0xff, 0x03,
+};
@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""Regenerates fixture.h for test_delta_ota.
+
+Builds the two synthetic images test_main.cpp builds (same recipe, same
+LCG), diffs them with `scripts/ota_delta.py diff`, and writes the patch
+as a C array. Run from the project root after changing the patch format
+or ota_delta.py:
+
+  python3 test/test_delta_ota/make_fixture.py
+"""
+import subprocess
+import sys
+import tempfile
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parents[2]
+OUT = Path(__file__).with_name("fixture.h")
+
+
+def lcg_bytes(seed, n):
+    out = bytearray(n)
+    state = seed
+    for i in range(n):
+        state = (state * 1103515245 + 12345) & 0xFFFFFFFF
+        out[i] = (state >> 16) & 0xFF
+    return out
+
+
+def old_image():
+    img = lcg_bytes(1, 48 * 1024)
+    for i in range(len(img)):
+        if (i // 64) % 3 == 0:
+            img[i] = i & 0xFF  # tables: compressible, repeated
+    return bytes(img)
+
+
+def new_image(old):
+    # Unchanged start, a block with relocated "addresses", new code, a
+    # long compressible insert (more than the 32 KiB inflate window), and
+    # two blocks swapped
+    moved = bytes((b + 4) & 0xFF if j % 97 == 0 else b
+                  for j, b in enumerate(old[12000:20000]))
+    records = b"".join(b"record %05d;" % k for k in range(3000))
+    return (old[:12000] + moved + bytes(lcg_bytes(2, 3000)) + records +
+            old[26000:] + old[20000:26000])
+
+
+def main():
+    old = old_image()
+    new = new_image(old)
+    with tempfile.TemporaryDirectory() as tmp:
+        tmp = Path(tmp)
+        (tmp / "old.bin").write_bytes(old)
+        (tmp / "new.bin").write_bytes(new)
+        subprocess.run([sys.executable, str(ROOT / "scripts" / "ota_delta.py"),
+                        "diff", str(tmp / "old.bin"), str(tmp / "new.bin"),
+                        str(tmp / "patch.sdp")], check=True)
+        patch = (tmp / "patch.sdp").read_bytes()
+
+    lines = ["// test/test_delta_ota/fixture.h",
+             "// Generated by make_fixture.py: scripts/ota_delta.py diff of the",
+             "// images oldImage() and newImage() build. Do not edit.",
+             "#pragma once",
+             "#include <stddef.h>",
+             "#include <stdint.h>",
+             "",
+             f"static const size_t FIXTURE_NEW_SIZE = {len(new)};",
+             f"static const uint8_t FIXTURE_PATCH[{len(patch)}] = {{"]
+    for i in range(0, len(patch), 16):
+        lines.append("    " + ", ".join(f"0x{b:02x}" for b in patch[i:i + 16]) + ",")
+    lines.append("};")
+    OUT.write_text("\n".join(lines) + "\n")
+    print(f"{OUT.relative_to(ROOT)}: {len(patch)} byte patch, "
+          f"{len(old)} -> {len(new)} byte image")
+
+
+if __name__ == "__main__":
+    main()
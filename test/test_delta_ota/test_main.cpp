@@ -0,0 +1,237 @@
+// test/test_delta_ota/test_main.cpp
+// lib/DeltaOta: a patch from scripts/ota_delta.py diff (fixture.h) through
+// DeltaStream (tinfl) and DeltaPatcher, between file-backed images, in
+// random upload chunk sizes; and the patches the node must refuse.
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+
+#include <string>
+#include <vector>
+
+#include <DeltaStream.h>
+
+#include "fixture.h"
+
+typedef std::vector<uint8_t> Bytes;
+
+// ===== The fixture's images (same recipe as make_fixture.py) =====
+static Bytes lcgBytes(uint32_t seed, size_t n) {
+  Bytes out(n);
+  uint32_t state = seed;
+  for (size_t i = 0; i < n; ++i) {
+    state = state * 1103515245u + 12345u;
+    out[i] = (uint8_t)(state >> 16);
+  }
+  return out;
+}
+
+static Bytes oldImage() {
+  Bytes img = lcgBytes(1, 48 * 1024);
+  for (size_t i = 0; i < img.size(); ++i)
+    if ((i / 64) % 3 == 0)
+      img[i] = (uint8_t)i;
+  return img;
+}
+
+static Bytes newImage(const Bytes &old) {
+  Bytes img(old.begin(), old.begin() + 12000);
+  for (size_t j = 0; j < 8000; ++j)
+    img.push_back((uint8_t)(old[12000 + j] + (j % 97 == 0 ? 4 : 0)));
+  const Bytes code = lcgBytes(2, 3000);
+  img.insert(img.end(), code.begin(), code.end());
+  char record[16];
+  for (int k = 0; k < 3000; ++k) {
+    snprintf(record, sizeof(record), "record %05d;", k);
+    img.insert(img.end(), record, record + strlen(record));
+  }
+  img.insert(img.end(), old.begin() + 26000, old.end());
+  img.insert(img.end(), old.begin() + 20000, old.begin() + 26000);
+  return img;
+}
+
+// ===== File-backed images =====
+class FileSource : public DeltaSource {
+public:
+  explicit FileSource(const Bytes &image) : _f(tmpfile()) {
+    fwrite(image.data(), 1, image.size(), _f);
+  }
+  ~FileSource() { fclose(_f); }
+  bool read(uint32_t offset, uint8_t *buf, size_t len) override {
+    return fseek(_f, (long)offset, SEEK_SET) == 0 &&
+           fread(buf, 1, len, _f) == len;
+  }
+
+private:
+  FILE *_f;
+};
+
+class FileSink : public DeltaSink {
+public:
+  FileSink() : _f(tmpfile()) {}
+  ~FileSink() { fclose(_f); }
+  bool open(uint32_t size) override {
+    _size = size;
+    _opened = true;
+    return true;
+  }
+  bool write(const uint8_t *data, size_t len) override {
+    return _opened && fwrite(data, 1, len, _f) == len;
+  }
+  bool opened() const { return _opened; }
+  Bytes contents() {
+    Bytes out(_size);
+    rewind(_f);
+    out.resize(fread(out.data(), 1, out.size(), _f));
+    return out;
+  }
+
+private:
+  FILE *_f;
+  uint32_t _size = 0;
+  bool _opened = false;
+};
+
+// ===== Helpers =====
+static uint32_t lcgState = 1;
+static uint32_t lcg() {
+  lcgState = lcgState * 1664525u + 1013904223u;
+  return lcgState >> 8;
+}
+
+struct Result {
+  bool fed;
+  bool finished;
+  std::string error;
+  Bytes image;
+  bool sinkOpened;
+};
+
+// Uploads patch against old in random chunks of 1..maxChunk bytes, the
+// way the node's web server hands them over
+static Result apply(const Bytes &old, const Bytes &patch, uint32_t seed,
+                    size_t maxChunk) {
+  lcgState = seed;
+  FileSource source(old);
+  FileSink sink;
+  DeltaPatcher patcher(source, sink);
+  DeltaStream stream(patcher);
+  TEST_ASSERT_TRUE(stream.begin());
+  Result r;
+  r.fed = true;
+  for (size_t pos = 0; pos < patch.size() && r.fed;) {
+    size_t n = 1 + lcg() % maxChunk;
+    if (n > patch.size() - pos)
+      n = patch.size() - pos;
+    r.fed = stream.feed(patch.data() + pos, n);
+    pos += n;
+  }
+  r.finished = r.fed && stream.finish();
+  r.error = stream.error() ? stream.error() : "";
+  r.image = sink.contents();
+  r.sinkOpened = sink.opened();
+  return r;
+}
+
+static Bytes fixturePatch() {
+  return Bytes(FIXTURE_PATCH, FIXTURE_PATCH + sizeof(FIXTURE_PATCH));
+}
+
+void setUp() {}
+void tearDown() {}
+
+// ===== Tests =====
+static void test_fixture_matches_its_images() {
+  const Bytes old = oldImage();
+  TEST_ASSERT_EQUAL_UINT32(FIXTURE_NEW_SIZE, newImage(old).size());
+}
+
+static void test_patch_reproduces_the_new_image() {
+  const Bytes old = oldImage();
+  const Bytes want = newImage(old);
+  const Bytes patch = fixturePatch();
+  const size_t maxChunks[] = {1, 7, 436, 1460, 8192, patch.size()};
+  for (size_t maxChunk : maxChunks) {
+    for (uint32_t seed = 1; seed <= 3; ++seed) {
+      const Result r = apply(old, patch, seed, maxChunk);
+      TEST_ASSERT_EQUAL_STRING("", r.error.c_str());
+      TEST_ASSERT_TRUE(r.fed);
+      TEST_ASSERT_TRUE(r.finished);
+      TEST_ASSERT_EQUAL_UINT32(want.size(), r.image.size());
+      TEST_ASSERT_TRUE(r.image == want);
+    }
+  }
+}
+
+static void test_wrong_base_is_refused_before_writing() {
+  Bytes old = oldImage();
+  old[30000] ^= 1;
+  const Result r = apply(old, fixturePatch(), 1, 1460);
+  TEST_ASSERT_FALSE(r.fed);
+  TEST_ASSERT_FALSE(r.sinkOpened);
+  TEST_ASSERT_EQUAL_STRING(
+      DeltaPatcher::errorName(DeltaPatcher::ERR_WRONG_BASE), r.error.c_str());
+}
+
+static void test_truncated_patch_is_refused() {
+  const Bytes old = oldImage();
+  const Bytes patch = fixturePatch();
+  const size_t cuts[] = {0,
+                         10,
+                         DeltaPatcher::HEADER_SIZE,
+                         DeltaPatcher::HEADER_SIZE + 1,
+                         patch.size() / 2,
+                         patch.size() - 1};
+  for (size_t cut : cuts) {
+    const Bytes part(patch.begin(), patch.begin() + cut);
+    const Result r = apply(old, part, 1, 1460);
+    TEST_ASSERT_TRUE(r.fed);
+    TEST_ASSERT_FALSE(r.finished);
+    TEST_ASSERT_FALSE(r.error.empty());
+  }
+}
+
+static void test_trailing_data_is_refused() {
+  Bytes patch = fixturePatch();
+  patch.push_back(0);
+  const Result r = apply(oldImage(), patch, 1, 1460);
+  TEST_ASSERT_FALSE(r.fed);
+  TEST_ASSERT_EQUAL_STRING("malformed patch", r.error.c_str());
+}
+
+static void test_wrong_new_image_hash_is_refused() {
+  Bytes patch = fixturePatch();
+  patch[12 + Sha256::DIGEST_SIZE] ^= 0x80; // first byte of sha256(new)
+  const Result r = apply(oldImage(), patch, 1, 1460);
+  TEST_ASSERT_TRUE(r.fed);
+  TEST_ASSERT_FALSE(r.finished);
+  TEST_ASSERT_EQUAL_STRING(DeltaPatcher::errorName(DeltaPatcher::ERR_HASH),
+                           r.error.c_str());
+}
+
+static void test_corrupt_records_are_refused() {
+  const Bytes old = oldImage();
+  for (uint32_t i = 0; i < 20; ++i) {
+    Bytes patch = fixturePatch();
+    lcgState = 100 + i;
+    const size_t at =
+        DeltaPatcher::HEADER_SIZE +
+        lcg() % (patch.size() - DeltaPatcher::HEADER_SIZE);
+    patch[at] ^= (uint8_t)(1 + lcg() % 255);
+    const Result r = apply(old, patch, i, 1460);
+    TEST_ASSERT_FALSE(r.finished);
+    TEST_ASSERT_FALSE(r.error.empty());
+  }
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_fixture_matches_its_images);
+  RUN_TEST(test_patch_reproduces_the_new_image);
+  RUN_TEST(test_wrong_base_is_refused_before_writing);
+  RUN_TEST(test_truncated_patch_is_refused);
+  RUN_TEST(test_trailing_data_is_refused);
+  RUN_TEST(test_wrong_new_image_hash_is_refused);
+  RUN_TEST(test_corrupt_records_are_refused);
+  return UNITY_END();
+}
@@ -0,0 +1,115 @@
+// test/test_environment_report/test_main.cpp
+// lib/LineProtocol/EnvironmentReport: change-driven lines, and that a
+// failed upload (rollback) loses neither archived points nor status.
+#include <math.h>
+#include <string.h>
+#include <unity.h>
+
+#include <string>
+
+#include <EnvironmentReport.h>
+
+static const char *KEY = "environment,device=t";
+static const uint32_t HEARTBEAT_MS = 300000;
+
+static uint32_t epochSeconds(uint32_t tMs) { return 1700000000u + tMs / 1000; }
+
+// A slow CO2 ramp with the odd step, everything else flat
+static void sample(uint32_t i, Sen66Protocol::MeasuredValues &mv,
+                   Sen66Protocol::NumberConcentration &nc) {
+  mv = {};
+  nc = {};
+  mv.pm1_0 = mv.pm2_5 = mv.pm4_0 = mv.pm10_0 = 3.0f;
+  mv.humidity_rh = 45.0f;
+  mv.temperature_c = 21.5f;
+  mv.voc_index = 100.0f;
+  mv.nox_index = 1.0f;
+  mv.co2_ppm = 500.0f + 2.0f * i + (i % 40 >= 20 ? 60.0f : 0.0f);
+  mv.hcho_ppb = 10.0f;
+  nc.nc0_5 = nc.nc1_0 = nc.nc2_5 = nc.nc4_0 = nc.nc10_0 = 20.0f;
+}
+
+// Encodes sample i (1 Hz) and returns its lines
+static std::string feed(EnvironmentReport &r, uint32_t i, uint32_t status = 0) {
+  static char buf[4096];
+  LineProtocolWriter w(buf, sizeof(buf));
+  Sen66Protocol::MeasuredValues mv;
+  Sen66Protocol::NumberConcentration nc;
+  sample(i, mv, nc);
+  r.encode(w, KEY, 1000 + i * 1000, i + 1, mv, nc, true, status,
+           epochSeconds);
+  TEST_ASSERT_FALSE(w.overflow());
+  return std::string(w.c_str(), w.length());
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_first_sample_writes_every_field_and_status() {
+  EnvironmentReport r;
+  r.begin(HEARTBEAT_MS);
+  const std::string lines = feed(r, 0);
+  TEST_ASSERT_TRUE(lines.find("co2=") != std::string::npos);
+  TEST_ASSERT_TRUE(lines.find("temperature=") != std::string::npos);
+  TEST_ASSERT_TRUE(lines.find("status=0") != std::string::npos);
+  TEST_ASSERT_TRUE(lines.find("seq=1") != std::string::npos);
+  r.commit();
+  // Flat fields stay quiet until the heartbeat
+  for (uint32_t i = 1; i < 10; ++i)
+    TEST_ASSERT_TRUE(feed(r, i).find("temperature=") == std::string::npos);
+}
+
+static void test_status_is_written_again_after_rollback() {
+  EnvironmentReport r;
+  r.begin(HEARTBEAT_MS);
+  feed(r, 0);
+  r.commit();
+  TEST_ASSERT_TRUE(feed(r, 1, 0x10).find("status=16") != std::string::npos);
+  r.rollback();
+  TEST_ASSERT_TRUE(feed(r, 2, 0x10).find("status=16") != std::string::npos);
+  r.commit();
+  TEST_ASSERT_TRUE(feed(r, 3, 0x10).find("status=") == std::string::npos);
+}
+
+// After a failed upload the report continues as if the failed samples
+// had never been fed: the same lines as a report that skipped them
+static void test_rollback_forgets_the_failed_samples() {
+  EnvironmentReport failing, skipping;
+  failing.begin(HEARTBEAT_MS);
+  skipping.begin(HEARTBEAT_MS);
+  for (uint32_t i = 0; i < 30; ++i) {
+    TEST_ASSERT_EQUAL_STRING(feed(skipping, i).c_str(),
+                             feed(failing, i).c_str());
+    failing.commit();
+    skipping.commit();
+  }
+  std::string lost;
+  for (uint32_t i = 30; i < 45; ++i)
+    lost += feed(failing, i);
+  TEST_ASSERT_FALSE(lost.empty()); // the step at 40 archived points
+  failing.rollback();
+  for (uint32_t i = 45; i < 400; ++i) {
+    TEST_ASSERT_EQUAL_STRING(feed(skipping, i).c_str(),
+                             feed(failing, i).c_str());
+    failing.commit();
+    skipping.commit();
+  }
+}
+
+static void test_begin_forgets_uncommitted_state() {
+  EnvironmentReport r;
+  r.begin(HEARTBEAT_MS);
+  feed(r, 0);
+  r.begin(HEARTBEAT_MS);
+  r.rollback();
+  TEST_ASSERT_TRUE(feed(r, 1).find("status=0") != std::string::npos);
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_first_sample_writes_every_field_and_status);
+  RUN_TEST(test_status_is_written_again_after_rollback);
+  RUN_TEST(test_rollback_forgets_the_failed_samples);
+  RUN_TEST(test_begin_forgets_uncommitted_state);
+  return UNITY_END();
+}
@@ -0,0 +1,268 @@
+// test/test_event_detector/test_main.cpp
+// lib/Events on synthetic 1 Hz series: steps, ramps and noise through the
+// node's detectors (cooking, voc_burst, occupancy, ventilation), checking
+// what fires, when it starts and ends and its magnitude, and that nothing
+// fires below the thresholds.
+#include <math.h>
+#include <unity.h>
+
+#include <vector>
+
+#include <EventDetector.h>
+
+using namespace Events;
+
+// As DETECTOR_DEFAULTS in src/sen66/main.cpp; ventilation with a 10 min
+// peak window
+static const Params COOKING = {1.0f / 600, 3.0f, 15.0f, 120, 0, 1, {}};
+static const Params VOC_BURST = {1.0f / 600, 50.0f, 300.0f, 60, 0, 1, {}};
+static const Params OCCUPANCY = {0.05f, 5.0f, 120.0f, 300, 0, 1, {}};
+static const Params VENTILATION = {0.0f, 20.0f, 100.0f, 120, 600, 1, {}};
+
+static const uint32_t SECOND = 1000;
+static const uint32_t MINUTE = 60 * SECOND;
+
+struct Seen {
+  Change change;
+  uint32_t atMs;
+  Event event;
+};
+
+// Deterministic noise in [-1, 1]
+static uint32_t noiseState = 1;
+static float noise() {
+  noiseState = noiseState * 1664525u + 1013904223u;
+  return (float)(noiseState >> 8) / (float)(1u << 23) - 1.0f;
+}
+
+// Feeds x(t) at 1 Hz for `seconds` and collects the changes
+template <typename F>
+static std::vector<Seen> run(Kind kind, const Params &p, uint32_t seconds,
+                             F x) {
+  noiseState = 1;
+  Detector d;
+  d.configure(kind, p);
+  std::vector<Seen> seen;
+  for (uint32_t i = 0; i < seconds; ++i) {
+    const uint32_t t = i * SECOND;
+    const Change c = d.update(t, x(t));
+    if (c != CHANGE_NONE) {
+      const Seen s = {c, t, d.event()};
+      seen.push_back(s);
+    }
+  }
+  return seen;
+}
+
+static void assertEvent(const std::vector<Seen> &seen, uint32_t startMs,
+                        uint32_t startTolMs, uint32_t endMs,
+                        uint32_t endTolMs, float magnitude, float magTol) {
+  TEST_ASSERT_EQUAL_UINT32(2, seen.size());
+  TEST_ASSERT_EQUAL_UINT8(CHANGE_STARTED, seen[0].change);
+  TEST_ASSERT_EQUAL_UINT8(CHANGE_ENDED, seen[1].change);
+  const Event &e = seen[1].event;
+  TEST_ASSERT_FALSE(e.active);
+  TEST_ASSERT_UINT32_WITHIN(startTolMs, startMs, e.startMs);
+  TEST_ASSERT_UINT32_WITHIN(endTolMs, endMs, e.endMs);
+  TEST_ASSERT_FLOAT_WITHIN(magTol, magnitude, e.magnitude);
+  TEST_ASSERT_TRUE(seen[0].event.startMs == e.startMs);
+}
+
+void setUp() {}
+void tearDown() {}
+
+// ===== cooking: PM2.5 level rise =====
+
+// A 10 min step of +45 µg/m3 after 20 quiet minutes
+static void test_cooking_step() {
+  const uint32_t on = 20 * MINUTE, off = 30 * MINUTE;
+  const std::vector<Seen> seen =
+      run(KIND_LEVEL_RISE, COOKING, 3600, [=](uint32_t t) {
+        return t >= on && t < off ? 50.0f : 5.0f;
+      });
+  // Starts on the step's first sample; ends where the quiet run began,
+  // `hold` samples before it was called
+  assertEvent(seen, on, 0, off, 0, 45.0f, 0.01f);
+  TEST_ASSERT_EQUAL_UINT32(on, seen[0].atMs);
+  TEST_ASSERT_EQUAL_UINT32(off + (COOKING.hold - 1) * SECOND, seen[1].atMs);
+}
+
+// Noise and a lasting step, both below the slack: nothing
+static void test_cooking_below_threshold() {
+  const std::vector<Seen> seen =
+      run(KIND_LEVEL_RISE, COOKING, 7200, [](uint32_t t) {
+        return (t >= 30 * MINUTE ? 7.5f : 5.0f) + 0.4f * noise();
+      });
+  TEST_ASSERT_EQUAL_UINT32(0, seen.size());
+}
+
+// ===== voc_burst: VOC index level rise =====
+
+// The CUSUM needs a few samples to pass h; the start is still the onset
+static void test_voc_burst_step() {
+  const uint32_t on = 15 * MINUTE, off = 20 * MINUTE;
+  const std::vector<Seen> seen =
+      run(KIND_LEVEL_RISE, VOC_BURST, 3600, [=](uint32_t t) {
+        return t >= on && t < off ? 180.0f : 100.0f;
+      });
+  // +80 against k = 50: 30 per sample, over h = 300 on the 11th
+  TEST_ASSERT_EQUAL_UINT32(on + 10 * SECOND, seen[0].atMs);
+  assertEvent(seen, on, 0, off, 0, 80.0f, 0.5f);
+}
+
+// A 5 min ramp of +1 per second: starts once the rise is past k (the
+// baseline creeps up a little before that), peaks at the top
+static void test_voc_burst_ramp() {
+  const uint32_t on = 15 * MINUTE, top = on + 300 * SECOND, off = top + MINUTE;
+  const std::vector<Seen> seen =
+      run(KIND_LEVEL_RISE, VOC_BURST, 3600, [=](uint32_t t) {
+        if (t < on || t >= off)
+          return 100.0f;
+        return t < top ? 100.0f + (t - on) / 1000.0f : 400.0f;
+      });
+  assertEvent(seen, on + 55 * SECOND, 5 * SECOND, off, 0, 300.0f, 10.0f);
+  TEST_ASSERT_TRUE(seen[1].event.magnitude < 300.0f);
+}
+
+static void test_voc_burst_noise() {
+  const std::vector<Seen> seen =
+      run(KIND_LEVEL_RISE, VOC_BURST, 7200,
+          [](uint32_t) { return 100.0f + 45.0f * noise(); });
+  TEST_ASSERT_EQUAL_UINT32(0, seen.size());
+}
+
+// ===== occupancy: CO2 slope rise =====
+
+// 30 min at +20 ppm/min after an hour of noisy baseline, then flat
+static void test_occupancy_ramp() {
+  const uint32_t on = 60 * MINUTE, top = 90 * MINUTE;
+  const std::vector<Seen> seen =
+      run(KIND_SLOPE_RISE, OCCUPANCY, 3 * 3600, [=](uint32_t t) {
+        float x = 450.0f + 3.0f * noise();
+        if (t >= on)
+          x += 20.0f * ((t < top ? t : top) - on) / MINUTE;
+        return x;
+      });
+  // The start is moved back by the smoother's lag (19 samples); the end
+  // is where the lagging trend fell below k again, about a minute late
+  assertEvent(seen, on, 5 * SECOND, top + MINUTE, 30 * SECOND, 600.0f,
+              10.0f);
+}
+
+// A slow rise (3 ppm/min) and noise: nothing
+static void test_occupancy_below_threshold() {
+  const std::vector<Seen> seen =
+      run(KIND_SLOPE_RISE, OCCUPANCY, 3 * 3600, [](uint32_t t) {
+        return 450.0f + 3.0f * t / MINUTE + 5.0f * noise();
+      });
+  TEST_ASSERT_EQUAL_UINT32(0, seen.size());
+}
+
+// ===== ventilation: CO2 drop from its peak =====
+
+// Up to 1200 ppm, window opened: down to 500 in 10 min, then flat
+static void test_ventilation_drop() {
+  const uint32_t peak = 30 * MINUTE, low = 40 * MINUTE;
+  const std::vector<Seen> seen =
+      run(KIND_PEAK_DROP, VENTILATION, 3600, [=](uint32_t t) {
+        if (t <= peak)
+          return 450.0f + 750.0f * t / peak;
+        if (t <= low)
+          return 1200.0f - 700.0f * (t - peak) / (low - peak);
+        return 500.0f;
+      });
+  // Starts at the peak; ends at the lowest value once `hold` samples
+  // brought no new one
+  assertEvent(seen, peak, 0, low, 0, 700.0f, 0.01f);
+  TEST_ASSERT_EQUAL_UINT32(low + VENTILATION.hold * SECOND, seen[1].atMs);
+  // Detected once the drop reached h
+  TEST_ASSERT_UINT32_WITHIN(SECOND, peak + 86 * SECOND, seen[0].atMs);
+}
+
+// The window shut again: CO2 climbing k above the lowest value ends the
+// event early. The peak is the plateau's first sample.
+static void test_ventilation_rebound() {
+  const uint32_t peak = 5 * MINUTE, low = 10 * MINUTE;
+  const std::vector<Seen> seen =
+      run(KIND_PEAK_DROP, VENTILATION, 1800, [=](uint32_t t) {
+        if (t <= peak)
+          return 1000.0f;
+        if (t <= low)
+          return 1000.0f - 400.0f * (t - peak) / (low - peak);
+        return 600.0f + 1.0f * (t - low) / SECOND;
+      });
+  assertEvent(seen, 0, 0, low, 0, 400.0f, 0.01f);
+  TEST_ASSERT_EQUAL_UINT32(low + 21 * SECOND, seen[1].atMs);
+}
+
+// Noise below h, and a slow drop that never falls h within the window
+static void test_ventilation_below_threshold() {
+  std::vector<Seen> seen =
+      run(KIND_PEAK_DROP, VENTILATION, 3600,
+          [](uint32_t) { return 600.0f + 45.0f * noise(); });
+  TEST_ASSERT_EQUAL_UINT32(0, seen.size());
+
+  Params shortWindow = VENTILATION;
+  shortWindow.window = 60;
+  seen = run(KIND_PEAK_DROP, shortWindow, 3600, [](uint32_t t) {
+    return 1200.0f - 1.5f * t / SECOND;
+  });
+  TEST_ASSERT_EQUAL_UINT32(0, seen.size());
+}
+
+// ===== Pipeline =====
+
+// Each detector gets its own signal; NaN is skipped, a disabled detector
+// never fires
+static void test_pipeline_routes_signals() {
+  enum { PM2_5, CO2, VOC, SIGNALS };
+  Pipeline p;
+  Params off = COOKING;
+  off.enabled = 0;
+  const Config configs[] = {
+      {"cooking", PM2_5, KIND_LEVEL_RISE, COOKING},
+      {"voc_burst", VOC, KIND_LEVEL_RISE, VOC_BURST},
+      {"ventilation", CO2, KIND_PEAK_DROP, VENTILATION},
+      {"cooking_off", PM2_5, KIND_LEVEL_RISE, off},
+  };
+  for (const Config &c : configs)
+    TEST_ASSERT_TRUE(p.add(c));
+
+  uint32_t startedBits = 0;
+  for (uint32_t i = 0; i < 1800; ++i) {
+    const uint32_t t = i * SECOND;
+    float v[SIGNALS];
+    v[PM2_5] = t >= 10 * MINUTE ? 60.0f : 5.0f;
+    v[CO2] = i % 10 == 0 ? NAN : 800.0f;
+    v[VOC] = 100.0f;
+    const uint32_t changed = p.update(t, v);
+    for (uint8_t d = 0; d < p.size(); ++d)
+      if ((changed & (1u << d)) && p.change(d) == CHANGE_STARTED)
+        startedBits |= 1u << d;
+  }
+  TEST_ASSERT_EQUAL_HEX32(1u << 0, startedBits);
+  TEST_ASSERT_TRUE(p.detector(0).event().active);
+  TEST_ASSERT_EQUAL_UINT32(10 * MINUTE, p.detector(0).event().startMs);
+  TEST_ASSERT_FALSE(p.detector(3).event().active);
+
+  // New settings restart the detector
+  p.setParams(0, VOC_BURST);
+  TEST_ASSERT_FALSE(p.detector(0).event().active);
+  TEST_ASSERT_EQUAL_FLOAT(VOC_BURST.k, p.config(0).params.k);
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_cooking_step);
+  RUN_TEST(test_cooking_below_threshold);
+  RUN_TEST(test_voc_burst_step);
+  RUN_TEST(test_voc_burst_ramp);
+  RUN_TEST(test_voc_burst_noise);
+  RUN_TEST(test_occupancy_ramp);
+  RUN_TEST(test_occupancy_below_threshold);
+  RUN_TEST(test_ventilation_drop);
+  RUN_TEST(test_ventilation_rebound);
+  RUN_TEST(test_ventilation_below_threshold);
+  RUN_TEST(test_pipeline_routes_signals);
+  return UNITY_END();
+}
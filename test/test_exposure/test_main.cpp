@@ -0,0 +1,193 @@
+// test/test_exposure/test_main.cpp
+// Exposure::Accumulator against closed-form doses: constant inputs, limits
+// crossed inside an interval, gaps that are left out, the rolling hour
+// across jumps in time, and the day's checkpoint surviving a reboot.
+#include <math.h>
+#include <string.h>
+#include <unity.h>
+
+#include <ExposureDose.h>
+
+using namespace Exposure;
+
+static const uint32_t SECOND = 1000;
+static const uint32_t MINUTE = 60 * SECOND;
+static const float HOUR_S = 3600.0f;
+
+// Samples every second from fromMs to toMs, both included
+static void feed(Accumulator &a, uint32_t fromMs, uint32_t toMs, float pm25,
+                 float pm10, float co2) {
+  for (uint32_t t = fromMs; t <= toMs; t += SECOND)
+    a.add(t, pm25, pm10, co2);
+}
+
+static void assertTotals(const Totals &expected, const Totals &actual,
+                         float tol) {
+  TEST_ASSERT_FLOAT_WITHIN(tol * fabsf(expected.pm25Dose) + 1e-6f,
+                           expected.pm25Dose, actual.pm25Dose);
+  TEST_ASSERT_FLOAT_WITHIN(tol * fabsf(expected.co2Excess) + 1e-6f,
+                           expected.co2Excess, actual.co2Excess);
+  TEST_ASSERT_FLOAT_WITHIN(tol * expected.pm25OverH + 1e-6f,
+                           expected.pm25OverH, actual.pm25OverH);
+  TEST_ASSERT_FLOAT_WITHIN(tol * expected.pm10OverH + 1e-6f,
+                           expected.pm10OverH, actual.pm10OverH);
+  TEST_ASSERT_FLOAT_WITHIN(tol * expected.coveredH + 1e-6f,
+                           expected.coveredH, actual.coveredH);
+}
+
+void setUp() {}
+void tearDown() {}
+
+// ===== Doses =====
+
+// 59:59 at constant levels above every limit: dose = level * hours,
+// excess = (CO2 - limit) * hours, all of it over WHO
+static void test_constant_input_above_limits() {
+  Accumulator a;
+  feed(a, 0, 3599 * SECOND, 20.0f, 50.0f, 1500.0f);
+  const float h = 3599 / HOUR_S;
+  const Totals expected = {20.0f * h, 500.0f * h, h, h, h};
+  assertTotals(expected, a.day(), 1e-4f);
+  // Still within the hour
+  assertTotals(expected, a.hour(), 1e-4f);
+}
+
+static void test_constant_input_below_limits() {
+  Accumulator a;
+  feed(a, 0, 1800 * SECOND, 10.0f, 30.0f, 800.0f);
+  const float h = 0.5f;
+  const Totals expected = {10.0f * h, 0.0f, 0.0f, 0.0f, h};
+  assertTotals(expected, a.day(), 1e-4f);
+}
+
+// One 10 s interval crossing the limits: only the triangle above counts
+static void test_limits_crossed_mid_interval() {
+  Accumulator a;
+  a.add(0, 10.0f, 0.0f, 900.0f);
+  a.add(10 * SECOND, 30.0f, 90.0f, 1300.0f);
+  const Totals d = a.day();
+  // CO2 passes 1000 after 2.5 s: 7.5 s above, peaking 300 over
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.5f * 300.0f * 7.5f / HOUR_S,
+                           d.co2Excess);
+  // PM2.5 passes 15 after 2.5 s, PM10 passes 45 after 5 s
+  TEST_ASSERT_FLOAT_WITHIN(1e-7f, 7.5f / HOUR_S, d.pm25OverH);
+  TEST_ASSERT_FLOAT_WITHIN(1e-7f, 5.0f / HOUR_S, d.pm10OverH);
+  // The dose is the whole trapezoid
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.5f * (10.0f + 30.0f) * 10.0f / HOUR_S,
+                           d.pm25Dose);
+  TEST_ASSERT_FLOAT_WITHIN(1e-7f, 10.0f / HOUR_S, d.coveredH);
+
+  // Falling back through the limit is the mirror image
+  Accumulator b;
+  b.add(0, 30.0f, 90.0f, 1300.0f);
+  b.add(10 * SECOND, 10.0f, 0.0f, 900.0f);
+  assertTotals(d, b.day(), 1e-5f);
+}
+
+// ===== Gaps =====
+
+// An interval longer than MAX_GAP_MS, or with a NaN at an end, is left out
+static void test_gaps_contribute_nothing() {
+  Accumulator a;
+  a.add(0, 20.0f, 50.0f, 1500.0f);
+  a.add(SECOND, 20.0f, 50.0f, 1500.0f);
+  a.add(SECOND + MAX_GAP_MS + 1, 20.0f, 50.0f, 1500.0f);
+  TEST_ASSERT_FLOAT_WITHIN(1e-7f, 1 / HOUR_S, a.day().coveredH);
+  a.add(2 * SECOND + MAX_GAP_MS + 1, 20.0f, 50.0f, 1500.0f);
+  TEST_ASSERT_FLOAT_WITHIN(1e-7f, 2 / HOUR_S, a.day().coveredH);
+
+  // Exactly MAX_GAP_MS is still integrated
+  Accumulator b;
+  b.add(0, 20.0f, 50.0f, 1500.0f);
+  b.add(MAX_GAP_MS, 20.0f, 50.0f, 1500.0f);
+  TEST_ASSERT_FLOAT_WITHIN(1e-7f, MAX_GAP_MS / 1000.0f / HOUR_S,
+                           b.day().coveredH);
+
+  Accumulator c;
+  c.add(0, 20.0f, 50.0f, 1500.0f);
+  c.add(SECOND, NAN, 50.0f, 1500.0f);
+  c.add(2 * SECOND, 20.0f, 50.0f, 1500.0f);
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, c.day().coveredH);
+  c.add(3 * SECOND, 20.0f, 50.0f, 1500.0f);
+  TEST_ASSERT_FLOAT_WITHIN(1e-7f, 1 / HOUR_S, c.day().coveredH);
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 20.0f / HOUR_S, c.day().pm25Dose);
+}
+
+// ===== Rolling hour =====
+
+// Jumps in time clear the minutes they pass; more than 60 min clears the
+// whole hour, while the day keeps everything
+static void test_jumps_clear_the_hour() {
+  Accumulator a;
+  feed(a, 0, 600 * SECOND, 20.0f, 50.0f, 1500.0f);
+  a.add(40 * MINUTE, 20.0f, 50.0f, 1500.0f);
+  a.add(40 * MINUTE + SECOND, 20.0f, 50.0f, 1500.0f);
+  TEST_ASSERT_FLOAT_WITHIN(1e-5f, 601 / HOUR_S, a.hour().coveredH);
+
+  // The hour now starts at minute 16: the first ten minutes are out
+  a.add(75 * MINUTE, 20.0f, 50.0f, 1500.0f);
+  a.add(75 * MINUTE + SECOND, 20.0f, 50.0f, 1500.0f);
+  TEST_ASSERT_FLOAT_WITHIN(1e-7f, 2 / HOUR_S, a.hour().coveredH);
+
+  // Over an hour later: only the newest interval is left
+  a.add(200 * MINUTE, 20.0f, 50.0f, 1500.0f);
+  a.add(200 * MINUTE + SECOND, 20.0f, 50.0f, 1500.0f);
+  const Totals h = a.hour();
+  TEST_ASSERT_FLOAT_WITHIN(1e-7f, 1 / HOUR_S, h.coveredH);
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 20.0f / HOUR_S, h.pm25Dose);
+  TEST_ASSERT_FLOAT_WITHIN(1e-5f, 603 / HOUR_S, a.day().coveredH);
+}
+
+// ===== Day =====
+
+// newDay() starts the day over mid-minute without touching the hour; a
+// checkpoint of day() restored after a reboot carries on where it was
+static void test_new_day_and_checkpoint_round_trip() {
+  Accumulator a;
+  feed(a, 0, 1800 * SECOND + 30 * SECOND, 20.0f, 50.0f, 1500.0f);
+  const Totals before = a.hour();
+  a.newDay();
+  const Totals empty = {};
+  assertTotals(empty, a.day(), 0.0f);
+  assertTotals(before, a.hour(), 0.0f);
+
+  // The rest of the running minute counts toward the new day only
+  feed(a, 1831 * SECOND, 1900 * SECOND, 20.0f, 50.0f, 1500.0f);
+  const float h = 70 / HOUR_S;
+  const Totals today = {20.0f * h, 500.0f * h, h, h, h};
+  assertTotals(today, a.day(), 1e-4f);
+
+  // The checkpoint goes to NVS as bytes, as in checkpointExposure()
+  uint8_t nvs[sizeof(Totals)];
+  const Totals saved = a.day();
+  memcpy(nvs, &saved, sizeof(saved));
+
+  Accumulator rebooted;
+  Totals restored;
+  memcpy(&restored, nvs, sizeof(restored));
+  rebooted.restoreDay(restored);
+  assertTotals(today, rebooted.day(), 1e-4f);
+  // The hour starts empty after a reboot
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, rebooted.hour().coveredH);
+
+  // And keeps adding from there
+  feed(rebooted, 5000 * SECOND, 5060 * SECOND, 20.0f, 50.0f, 1500.0f);
+  const float h2 = 130 / HOUR_S;
+  const Totals later = {20.0f * h2, 500.0f * h2, h2, h2, h2};
+  assertTotals(later, rebooted.day(), 1e-4f);
+
+  // A second newDay() drops the restored share too
+  rebooted.newDay();
+  assertTotals(empty, rebooted.day(), 0.0f);
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_constant_input_above_limits);
+  RUN_TEST(test_constant_input_below_limits);
+  RUN_TEST(test_limits_crossed_mid_interval);
+  RUN_TEST(test_gaps_contribute_nothing);
+  RUN_TEST(test_jumps_clear_the_hour);
+  RUN_TEST(test_new_day_and_checkpoint_round_trip);
+  return UNITY_END();
+}
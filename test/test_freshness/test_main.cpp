@@ -0,0 +1,166 @@
+// test/test_freshness/test_main.cpp
+// lib/Iaq/Freshness: new-sample detection across a node reboot, staleness
+// against the budget, and the lamp's display-latency stats: nearest-rank
+// percentiles, the reservoir past CAPACITY, and the telemetry fields.
+#include <string.h>
+#include <unity.h>
+
+#include <Freshness.h>
+
+static const int64_t EPOCH_MS = 1767225600000LL;
+
+static SampleStamp stamp(int64_t timeMs, uint32_t seq)
+{
+  SampleStamp s;
+  s.timeMs = timeMs;
+  s.seq = seq;
+  return s;
+}
+
+void setUp() {}
+void tearDown() {}
+
+// ===== Samples =====
+
+static void test_new_sample_across_a_reboot()
+{
+  const SampleStamp shown = stamp(EPOCH_MS, 57);
+  TEST_ASSERT_FALSE(isNewSample(shown, shown));
+  TEST_ASSERT_TRUE(isNewSample(stamp(EPOCH_MS + 1000, 58), shown));
+  // The node rebooted: seq starts from 1 again, and the clock it set
+  // from SNTP may even be a little behind
+  TEST_ASSERT_TRUE(isNewSample(stamp(EPOCH_MS - 200, 1), shown));
+  TEST_ASSERT_TRUE(isNewSample(stamp(EPOCH_MS, 1), shown));
+  // A node without seq: the time alone tells
+  TEST_ASSERT_TRUE(isNewSample(stamp(EPOCH_MS + 1000, 0), stamp(EPOCH_MS, 0)));
+  TEST_ASSERT_FALSE(isNewSample(stamp(EPOCH_MS, 0), stamp(EPOCH_MS, 0)));
+  // No acquisition time: never new
+  TEST_ASSERT_FALSE(isNewSample(stamp(0, 58), shown));
+}
+
+static void test_staleness_against_the_budget()
+{
+  uint32_t age = 12345;
+  TEST_ASSERT_EQUAL_UINT8(STALENESS_FRESH,
+                          staleness(stamp(EPOCH_MS, 1), EPOCH_MS + 30000, 30000, &age));
+  TEST_ASSERT_EQUAL_UINT32(30000, age);
+  TEST_ASSERT_EQUAL_UINT8(STALENESS_STALE,
+                          staleness(stamp(EPOCH_MS, 1), EPOCH_MS + 30001, 30000, &age));
+  TEST_ASSERT_EQUAL_UINT32(30001, age);
+
+  // Stamped ahead of the lamp's clock: age 0, fresh
+  TEST_ASSERT_EQUAL_UINT8(STALENESS_FRESH,
+                          staleness(stamp(EPOCH_MS + 5000, 1), EPOCH_MS, 30000, &age));
+  TEST_ASSERT_EQUAL_UINT32(0, age);
+
+  // Nothing to compare: the age is left alone
+  age = 7;
+  TEST_ASSERT_EQUAL_UINT8(STALENESS_UNKNOWN, staleness(stamp(0, 1), EPOCH_MS, 30000, &age));
+  TEST_ASSERT_EQUAL_UINT8(STALENESS_UNKNOWN, staleness(stamp(EPOCH_MS, 1), 0, 30000, &age));
+  TEST_ASSERT_EQUAL_UINT32(7, age);
+  TEST_ASSERT_EQUAL_UINT8(STALENESS_STALE, staleness(stamp(EPOCH_MS, 1), EPOCH_MS + 60000, 30000));
+}
+
+// ===== Latency stats =====
+
+static void test_nearest_rank_percentiles()
+{
+  LatencyStats s;
+  TEST_ASSERT_EQUAL_UINT32(0, s.percentileMs(50));
+  TEST_ASSERT_EQUAL_UINT32(0, s.meanMs());
+
+  // 100, 90, ..., 10 (recorded out of order)
+  for (uint32_t i = 10; i >= 1; --i)
+  {
+    s.record(i * 10);
+  }
+  TEST_ASSERT_EQUAL_UINT32(10, s.count());
+  TEST_ASSERT_EQUAL_UINT32(55, s.meanMs());
+  TEST_ASSERT_EQUAL_UINT32(100, s.maxMs());
+  // Rank ceil(p/100 * n): 5th, 9th and 10th of ten
+  TEST_ASSERT_EQUAL_UINT32(50, s.percentileMs(50));
+  TEST_ASSERT_EQUAL_UINT32(90, s.percentileMs(90));
+  TEST_ASSERT_EQUAL_UINT32(100, s.percentileMs(99));
+  TEST_ASSERT_EQUAL_UINT32(10, s.percentileMs(0));
+  TEST_ASSERT_EQUAL_UINT32(100, s.percentileMs(100));
+  TEST_ASSERT_EQUAL_UINT32(60, s.percentileMs(51));
+
+  // A latency after a query is sorted in
+  s.record(5);
+  TEST_ASSERT_EQUAL_UINT32(5, s.percentileMs(0));
+  TEST_ASSERT_EQUAL_UINT32(50, s.percentileMs(50));
+}
+
+// Past CAPACITY count, mean and max stay exact; the percentiles come from
+// a uniform sample of everything recorded
+static void test_more_than_capacity()
+{
+  LatencyStats s;
+  const uint32_t n = 20 * LatencyStats::CAPACITY;
+  for (uint32_t i = 0; i < n; ++i)
+  {
+    // 0..n-1, shuffled so the reservoir sees both ends throughout
+    s.record(i * 7919 % n);
+  }
+  TEST_ASSERT_EQUAL_UINT32(n, s.count());
+  TEST_ASSERT_EQUAL_UINT32((n - 1) / 2, s.meanMs());
+  TEST_ASSERT_EQUAL_UINT32(n - 1, s.maxMs());
+
+  const uint32_t p50 = s.percentileMs(50);
+  const uint32_t p90 = s.percentileMs(90);
+  const uint32_t p99 = s.percentileMs(99);
+  TEST_ASSERT_UINT32_WITHIN(n / 8, n / 2, p50);
+  TEST_ASSERT_UINT32_WITHIN(n / 8, n * 9 / 10, p90);
+  TEST_ASSERT_TRUE(p50 <= p90 && p90 <= p99 && p99 <= s.maxMs());
+  // Not just the first CAPACITY latencies
+  TEST_ASSERT_TRUE(s.percentileMs(100) > 2 * LatencyStats::CAPACITY);
+}
+
+// ===== Telemetry fields =====
+
+static void test_format_fields_keeps_the_interval()
+{
+  LatencyStats s;
+  for (uint32_t i = 1; i <= 10; ++i)
+  {
+    s.record(i * 10);
+  }
+  static const char EXPECTED[] =
+      ",display_latency_count=10i,display_latency_mean_ms=55i,"
+      "display_latency_p50_ms=50i,display_latency_p90_ms=90i,"
+      "display_latency_p99_ms=100i,display_latency_max_ms=100i";
+  char buf[256];
+  TEST_ASSERT_EQUAL_UINT32(strlen(EXPECTED), s.formatFields(buf, sizeof(buf), "display_latency"));
+  TEST_ASSERT_EQUAL_STRING(EXPECTED, buf);
+
+  // Nothing was reset: a failed upload sends the same fields next time
+  TEST_ASSERT_EQUAL_UINT32(10, s.count());
+  TEST_ASSERT_EQUAL_UINT32(strlen(EXPECTED), s.formatFields(buf, sizeof(buf), "display_latency"));
+  TEST_ASSERT_EQUAL_STRING(EXPECTED, buf);
+
+  // Too small, even by the terminator: 0, and still nothing reset
+  TEST_ASSERT_EQUAL_UINT32(0, s.formatFields(buf, strlen(EXPECTED), "display_latency"));
+  TEST_ASSERT_EQUAL_UINT32(0, s.formatFields(buf, 8, "display_latency"));
+  TEST_ASSERT_EQUAL_UINT32(10, s.count());
+  TEST_ASSERT_EQUAL_UINT32(100, s.maxMs());
+
+  // reset() starts the next interval
+  s.reset();
+  TEST_ASSERT_EQUAL_UINT32(0, s.count());
+  TEST_ASSERT_EQUAL_UINT32(0, s.maxMs());
+  TEST_ASSERT_EQUAL_UINT32(0, s.percentileMs(50));
+  s.record(42);
+  TEST_ASSERT_EQUAL_UINT32(42, s.percentileMs(50));
+  TEST_ASSERT_EQUAL_UINT32(42, s.meanMs());
+}
+
+int main(int, char **)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_new_sample_across_a_reboot);
+  RUN_TEST(test_staleness_against_the_budget);
+  RUN_TEST(test_nearest_rank_percentiles);
+  RUN_TEST(test_more_than_capacity);
+  RUN_TEST(test_format_fields_keeps_the_interval);
+  return UNITY_END();
+}
@@ -0,0 +1,224 @@
+// test/test_history/test_main.cpp
+// lib/History: lossless round trip through every code length, the block
+// ring, and scan() against a brute-force reference.
+#include <math.h>
+#include <stdlib.h>
+#include <unity.h>
+
+#include <vector>
+
+#include <History.h>
+
+using namespace History;
+
+struct Sample {
+  uint32_t tMs;
+  Ticks t;
+};
+
+// Deterministic, so a failure reproduces
+static uint32_t lcgState = 1;
+static uint32_t lcg() {
+  lcgState = lcgState * 1664525u + 1013904223u;
+  return lcgState >> 8;
+}
+
+static bool isUnknownTick(uint8_t ch, uint16_t tick) {
+  return isnan(toValue((Channel)ch, tick));
+}
+
+static uint16_t unknownTick(uint8_t ch) {
+  return isUnknownTick(ch, 0x7FFF) ? 0x7FFF : 0xFFFF;
+}
+
+// 1 Hz with jitter, the occasional gap, and per-channel steps of every
+// code length (unchanged, +-8, +-128, anything) plus unknown markers
+static std::vector<Sample> trace(size_t n, uint32_t seed) {
+  lcgState = seed;
+  std::vector<Sample> out(n);
+  uint32_t tMs = 0xFFFF0000u; // wraps during the trace
+  Ticks prev = {};
+  for (size_t i = 0; i < n; ++i) {
+    const uint32_t r = lcg() % 100;
+    tMs += r < 90 ? 1000 + lcg() % 60
+                  : (r < 99 ? 1000 + lcg() % 5000 : 60000 + lcg() % 600000);
+    out[i].tMs = tMs;
+    for (uint8_t ch = 0; ch < CHANNEL_COUNT; ++ch) {
+      const uint32_t kind = lcg() % 100;
+      uint16_t v = prev.v[ch]; // unchanged half of the time
+      if (kind >= 97)
+        v = unknownTick(ch);
+      else if (kind >= 92)
+        v = (uint16_t)lcg();
+      else if (kind >= 80)
+        v = (uint16_t)(v + (int)(lcg() % 257) - 128);
+      else if (kind >= 50)
+        v = (uint16_t)(v + (int)(lcg() % 17) - 8);
+      out[i].t.v[ch] = v;
+    }
+    prev = out[i].t;
+  }
+  return out;
+}
+
+struct Heap {
+  explicit Heap(size_t blocks)
+      : bytes(Store::bytesFor(blocks)), mem(malloc(bytes)) {}
+  ~Heap() { free(mem); }
+  size_t bytes;
+  void *mem;
+};
+
+static void assertSame(const Sample &want, uint32_t tMs, const Ticks &got) {
+  TEST_ASSERT_EQUAL_UINT32(want.tMs, tMs);
+  TEST_ASSERT_EQUAL_MEMORY(want.t.v, got.v, sizeof(got.v));
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_round_trip_is_lossless() {
+  const std::vector<Sample> s = trace(5000, 7);
+  Heap heap(64);
+  Store store(heap.mem, heap.bytes);
+  for (const Sample &x : s)
+    TEST_ASSERT_TRUE(store.append(x.tMs, x.t));
+  TEST_ASSERT_EQUAL_UINT32(s.size(), store.samples());
+  TEST_ASSERT_TRUE(store.blocks() > 1);
+  TEST_ASSERT_EQUAL_UINT32(s.front().tMs, store.oldestMs());
+  TEST_ASSERT_EQUAL_UINT32(s.back().tMs, store.newestMs());
+
+  Cursor c = store.cursor();
+  uint32_t tMs;
+  Ticks t;
+  for (const Sample &x : s) {
+    TEST_ASSERT_TRUE(c.next(tMs, t));
+    assertSame(x, tMs, t);
+  }
+  TEST_ASSERT_FALSE(c.next(tMs, t));
+}
+
+static void test_ring_drops_the_oldest_block() {
+  const std::vector<Sample> s = trace(20000, 11);
+  Heap heap(4);
+  Store store(heap.mem, heap.bytes);
+  for (const Sample &x : s)
+    TEST_ASSERT_TRUE(store.append(x.tMs, x.t));
+  TEST_ASSERT_EQUAL_UINT32(4, store.blocks());
+  TEST_ASSERT_TRUE(store.samples() < s.size());
+  TEST_ASSERT_EQUAL_UINT32(s.back().tMs, store.newestMs());
+
+  // What is left is the newest samples, in order
+  const size_t first = s.size() - store.samples();
+  TEST_ASSERT_EQUAL_UINT32(s[first].tMs, store.oldestMs());
+  Cursor c = store.cursor();
+  uint32_t tMs;
+  Ticks t;
+  for (size_t i = first; i < s.size(); ++i) {
+    TEST_ASSERT_TRUE(c.next(tMs, t));
+    assertSame(s[i], tMs, t);
+  }
+  TEST_ASSERT_FALSE(c.next(tMs, t));
+}
+
+static void test_out_of_order_is_refused() {
+  Heap heap(2);
+  Store store(heap.mem, heap.bytes);
+  Ticks t = {};
+  TEST_ASSERT_TRUE(store.append(5000, t));
+  TEST_ASSERT_FALSE(store.append(4999, t));
+  TEST_ASSERT_TRUE(store.append(5000, t));
+  TEST_ASSERT_EQUAL_UINT32(2, store.samples());
+
+  Store tooSmall(heap.mem, Store::bytesFor(1));
+  TEST_ASSERT_FALSE(tooSmall.append(0, t));
+}
+
+static void test_values_and_unknown_markers() {
+  Sen66Protocol::MeasuredValues mv = {};
+  Sen66Protocol::NumberConcentration nc = {};
+  mv.pm2_5 = 12.3f;
+  mv.humidity_rh = 45.67f;
+  mv.temperature_c = -5.5f;
+  mv.voc_index = NAN;
+  mv.co2_ppm = 812.0f;
+  mv.hcho_ppb = 25.5f;
+  nc.nc10_0 = NAN;
+  Ticks t;
+  toTicks(mv, nc, t);
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 12.3f, toValue(CH_PM2_5, t.v[CH_PM2_5]));
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 45.67f,
+                           toValue(CH_HUMIDITY, t.v[CH_HUMIDITY]));
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, -5.5f,
+                           toValue(CH_TEMPERATURE, t.v[CH_TEMPERATURE]));
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 812.0f, toValue(CH_CO2, t.v[CH_CO2]));
+  TEST_ASSERT_EQUAL_UINT16(255, t.v[CH_HCHO]);
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 25.5f, toValue(CH_HCHO, t.v[CH_HCHO]));
+  TEST_ASSERT_FLOAT_IS_NAN(toValue(CH_VOC, t.v[CH_VOC]));
+  TEST_ASSERT_FLOAT_IS_NAN(toValue(CH_NC10, t.v[CH_NC10]));
+}
+
+// scan() merges whole blocks from their summaries and decodes the rest;
+// either way it must agree with summing the decoded samples
+static void test_scan_matches_decoded_samples() {
+  const std::vector<Sample> s = trace(30000, 23);
+  Heap heap(16);
+  Store store(heap.mem, heap.bytes);
+  for (const Sample &x : s)
+    store.append(x.tMs, x.t);
+
+  std::vector<Sample> kept;
+  Cursor c = store.cursor();
+  Sample x;
+  while (c.next(x.tMs, x.t))
+    kept.push_back(x);
+
+  const uint32_t bucketMs[] = {1000, 60000, 3600000, 86400000};
+  for (uint32_t b : bucketMs) {
+    for (uint8_t ch = 0; ch < CHANNEL_COUNT; ++ch) {
+      const uint32_t from = store.oldestMs() + 12345;
+      const uint32_t to = store.newestMs() - 6789;
+      std::vector<Bucket> out((to - from) / b + 1);
+      const size_t n =
+          store.scan((Channel)ch, from, to, b, out.data(), out.size());
+      TEST_ASSERT_EQUAL_UINT32((to - from + b - 1) / b, n);
+
+      std::vector<Bucket> want(n);
+      for (size_t i = 0; i < n; ++i)
+        want[i] = {from + (uint32_t)i * b, 0, INFINITY, -INFINITY, 0.0};
+      for (const Sample &k : kept) {
+        const uint32_t rel = k.tMs - from;
+        if ((int32_t)rel < 0 || rel >= n * b)
+          continue;
+        const float v = toValue((Channel)ch, k.t.v[ch]);
+        if (isnan(v))
+          continue;
+        Bucket &w = want[rel / b];
+        w.count++;
+        w.min = fminf(w.min, v);
+        w.max = fmaxf(w.max, v);
+        w.sum += v;
+      }
+      for (size_t i = 0; i < n; ++i) {
+        TEST_ASSERT_EQUAL_UINT32(want[i].startMs, out[i].startMs);
+        TEST_ASSERT_EQUAL_UINT32(want[i].count, out[i].count);
+        if (!want[i].count)
+          continue;
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f, want[i].min, out[i].min);
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f, want[i].max, out[i].max);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6 * fabs(want[i].sum) + 1e-2,
+                                 want[i].sum, out[i].sum);
+      }
+    }
+  }
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_round_trip_is_lossless);
+  RUN_TEST(test_ring_drops_the_oldest_block);
+  RUN_TEST(test_out_of_order_is_refused);
+  RUN_TEST(test_values_and_unknown_markers);
+  RUN_TEST(test_scan_matches_decoded_samples);
+  return UNITY_END();
+}
@@ -0,0 +1,279 @@
+// test/test_i2c_dev_bus/test_main.cpp
+// I2cDevBus on a fake I2cDevIo that records every ioctl: the I2C_RDWR
+// messages of each transaction, errno and partial transfers, and a
+// TCA9548A channel on top of it.
+#include <errno.h>
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+#include <string.h>
+#include <unity.h>
+
+#include <vector>
+
+#include <I2cDevBus.h>
+
+static const uint8_t SENSOR = 0x6B;
+static const uint8_t MUX = 0x70;
+static const int FD = 7;
+
+// One adapter. Reads are filled with 0xA5; fail / done script the next
+// I2C_RDWR.
+class FakeIo : public I2cDevIo {
+public:
+  struct Msg {
+    uint16_t addr;
+    uint16_t flags;
+    std::vector<uint8_t> data; // what a write sent
+    uint16_t len;
+  };
+
+  unsigned long funcs = I2C_FUNC_I2C | I2C_FUNC_SMBUS_EMUL;
+  int openErrno = 0;
+  int funcsErrno = 0;
+  int failErrno = 0;   // next I2C_RDWR fails with this errno
+  int partial = -1;    // next I2C_RDWR does only this many messages
+
+  std::vector<std::vector<Msg>> transfers; // one per I2C_RDWR
+  int opens = 0;
+  int closes = 0;
+
+  int open(const char *) override {
+    opens++;
+    if (openErrno) {
+      errno = openErrno;
+      return -1;
+    }
+    return FD;
+  }
+
+  int ioctl(int fd, unsigned long request, void *arg) override {
+    if (fd != FD) {
+      errno = EBADF;
+      return -1;
+    }
+    if (request == I2C_FUNCS) {
+      if (funcsErrno) {
+        errno = funcsErrno;
+        return -1;
+      }
+      *(unsigned long *)arg = funcs;
+      return 0;
+    }
+    if (request != I2C_RDWR) {
+      errno = ENOTTY;
+      return -1;
+    }
+    const i2c_rdwr_ioctl_data &d = *(const i2c_rdwr_ioctl_data *)arg;
+    std::vector<Msg> t;
+    for (uint32_t i = 0; i < d.nmsgs; ++i) {
+      const i2c_msg &m = d.msgs[i];
+      Msg r = {m.addr, m.flags, {}, m.len};
+      if (m.flags & I2C_M_RD)
+        memset(m.buf, 0xA5, m.len);
+      else
+        r.data.assign(m.buf, m.buf + m.len);
+      t.push_back(r);
+    }
+    transfers.push_back(t);
+    if (failErrno) {
+      errno = failErrno;
+      failErrno = 0;
+      return -1;
+    }
+    if (partial >= 0) {
+      const int done = partial;
+      partial = -1;
+      return done;
+    }
+    return (int)d.nmsgs;
+  }
+
+  void close(int) override { closes++; }
+};
+
+void setUp() {}
+void tearDown() {}
+
+static void test_open_checks_plain_i2c() {
+  FakeIo io;
+  I2cDevBus bus("/dev/i2c-1", io);
+  TEST_ASSERT_TRUE(bus.open());
+  TEST_ASSERT_TRUE(bus.isOpen());
+  TEST_ASSERT_EQUAL_STRING("/dev/i2c-1", bus.path());
+
+  // SMBus-only adapter: no I2C_RDWR
+  FakeIo smbus;
+  smbus.funcs = I2C_FUNC_SMBUS_EMUL;
+  I2cDevBus b2("/dev/i2c-2", smbus);
+  errno = 0;
+  TEST_ASSERT_FALSE(b2.open());
+  TEST_ASSERT_EQUAL_INT(EOPNOTSUPP, errno);
+  TEST_ASSERT_FALSE(b2.isOpen());
+  TEST_ASSERT_EQUAL_INT(1, smbus.closes);
+}
+
+// The kernel's errno reaches the caller unchanged
+static void test_open_failures_keep_errno() {
+  FakeIo missing;
+  missing.openErrno = ENOENT;
+  I2cDevBus b1("/dev/i2c-9", missing);
+  TEST_ASSERT_FALSE(b1.open());
+  TEST_ASSERT_EQUAL_INT(ENOENT, errno);
+
+  FakeIo denied;
+  denied.funcsErrno = EACCES;
+  I2cDevBus b2("/dev/i2c-1", denied);
+  TEST_ASSERT_FALSE(b2.open());
+  TEST_ASSERT_EQUAL_INT(EACCES, errno);
+  TEST_ASSERT_EQUAL_INT(1, denied.closes);
+
+  // Nothing reaches a bus that is not open
+  TEST_ASSERT_FALSE(b2.write(SENSOR, (const uint8_t *)"\x03\x00", 2));
+  TEST_ASSERT_TRUE(denied.transfers.empty());
+}
+
+static void test_read_and_write_are_one_message_each() {
+  FakeIo io;
+  I2cDevBus bus("/dev/i2c-1", io);
+  TEST_ASSERT_TRUE(bus.open());
+  const uint8_t cmd[2] = {0x03, 0x00};
+  TEST_ASSERT_TRUE(bus.write(SENSOR, cmd, sizeof(cmd)));
+  uint8_t buf[27] = {};
+  TEST_ASSERT_TRUE(bus.read(SENSOR, buf, sizeof(buf)));
+  TEST_ASSERT_EQUAL_HEX8(0xA5, buf[26]);
+
+  TEST_ASSERT_EQUAL_UINT32(2, io.transfers.size());
+  const FakeIo::Msg &w = io.transfers[0][0];
+  TEST_ASSERT_EQUAL_UINT32(1, io.transfers[0].size());
+  TEST_ASSERT_EQUAL_HEX16(SENSOR, w.addr);
+  TEST_ASSERT_EQUAL_HEX16(0, w.flags);
+  TEST_ASSERT_EQUAL_UINT32(2, w.data.size());
+  TEST_ASSERT_EQUAL_MEMORY(cmd, w.data.data(), 2);
+  const FakeIo::Msg &r = io.transfers[1][0];
+  TEST_ASSERT_EQUAL_UINT32(1, io.transfers[1].size());
+  TEST_ASSERT_EQUAL_HEX16(I2C_M_RD, r.flags);
+  TEST_ASSERT_EQUAL_UINT16(27, r.len);
+
+  TEST_ASSERT_EQUAL_UINT32(2, bus.stats().ioctls);
+  TEST_ASSERT_EQUAL_UINT32(2, bus.stats().messages);
+  TEST_ASSERT_EQUAL_UINT32(0, bus.stats().errors);
+}
+
+// A response and the next command: one I2C_RDWR, the read first, a
+// repeated START (no I2C_M_NOSTART, no STOP flag) before the write
+static void test_read_then_write_is_one_transaction() {
+  FakeIo io;
+  I2cDevBus bus("/dev/i2c-1", io);
+  TEST_ASSERT_TRUE(bus.open());
+  uint8_t buf[9];
+  const uint8_t next[2] = {0x03, 0x00};
+  bool wrote = false;
+  TEST_ASSERT_TRUE(bus.readThenWrite(SENSOR, buf, sizeof(buf), next,
+                                     sizeof(next), wrote));
+  TEST_ASSERT_TRUE(wrote);
+
+  TEST_ASSERT_EQUAL_UINT32(1, io.transfers.size());
+  const std::vector<FakeIo::Msg> &t = io.transfers[0];
+  TEST_ASSERT_EQUAL_UINT32(2, t.size());
+  TEST_ASSERT_EQUAL_HEX16(SENSOR, t[0].addr);
+  TEST_ASSERT_EQUAL_HEX16(I2C_M_RD, t[0].flags);
+  TEST_ASSERT_EQUAL_UINT16(9, t[0].len);
+  TEST_ASSERT_EQUAL_HEX16(SENSOR, t[1].addr);
+  TEST_ASSERT_EQUAL_HEX16(0, t[1].flags);
+  TEST_ASSERT_EQUAL_MEMORY(next, t[1].data.data(), 2);
+  TEST_ASSERT_EQUAL_UINT32(1, bus.stats().ioctls);
+  TEST_ASSERT_EQUAL_UINT32(2, bus.stats().messages);
+}
+
+static void test_failed_and_partial_transfers() {
+  FakeIo io;
+  I2cDevBus bus("/dev/i2c-1", io);
+  TEST_ASSERT_TRUE(bus.open());
+  uint8_t buf[9];
+  const uint8_t next[2] = {0x03, 0x00};
+
+  // NACK: false with the kernel's errno
+  io.failErrno = EREMOTEIO;
+  TEST_ASSERT_FALSE(bus.read(SENSOR, buf, sizeof(buf)));
+  TEST_ASSERT_EQUAL_INT(EREMOTEIO, errno);
+  io.failErrno = ETIMEDOUT;
+  TEST_ASSERT_FALSE(bus.write(SENSOR, next, sizeof(next)));
+  TEST_ASSERT_EQUAL_INT(ETIMEDOUT, errno);
+  TEST_ASSERT_EQUAL_UINT32(2, bus.stats().errors);
+
+  // The adapter stopped at a NACK on the write: the response still counts
+  bool wrote = true;
+  io.partial = 1;
+  TEST_ASSERT_TRUE(bus.readThenWrite(SENSOR, buf, sizeof(buf), next,
+                                     sizeof(next), wrote));
+  TEST_ASSERT_FALSE(wrote);
+  TEST_ASSERT_EQUAL_UINT32(3, bus.stats().errors);
+
+  // Nothing done
+  io.failErrno = EREMOTEIO;
+  TEST_ASSERT_FALSE(bus.readThenWrite(SENSOR, buf, sizeof(buf), next,
+                                      sizeof(next), wrote));
+  TEST_ASSERT_FALSE(wrote);
+  TEST_ASSERT_EQUAL_UINT32(4, bus.stats().errors);
+  TEST_ASSERT_EQUAL_UINT32(4, bus.stats().ioctls);
+}
+
+// A mux channel on i2c-dev: the select is an ioctl of its own (the switch
+// connects at STOP), it is skipped while the channel is selected, and a
+// failure forgets it
+static void test_mux_channel() {
+  FakeIo io;
+  I2cDevBus bus("/dev/i2c-1", io);
+  TEST_ASSERT_TRUE(bus.open());
+  Tca9548a mux(bus);
+  Sen66Bus &ch3 = mux.channel(3);
+  uint8_t buf[9];
+  const uint8_t next[2] = {0x03, 0x00};
+  bool wrote = false;
+
+  TEST_ASSERT_TRUE(ch3.readThenWrite(SENSOR, buf, sizeof(buf), next,
+                                     sizeof(next), wrote));
+  TEST_ASSERT_TRUE(wrote);
+  TEST_ASSERT_EQUAL_UINT32(2, io.transfers.size());
+  TEST_ASSERT_EQUAL_UINT32(1, io.transfers[0].size());
+  TEST_ASSERT_EQUAL_HEX16(MUX, io.transfers[0][0].addr);
+  TEST_ASSERT_EQUAL_HEX8(1u << 3, io.transfers[0][0].data[0]);
+  TEST_ASSERT_EQUAL_UINT32(2, io.transfers[1].size());
+
+  // Still on channel 3
+  TEST_ASSERT_TRUE(ch3.read(SENSOR, buf, sizeof(buf)));
+  TEST_ASSERT_EQUAL_UINT32(3, io.transfers.size());
+  TEST_ASSERT_EQUAL_HEX16(SENSOR, io.transfers[2][0].addr);
+
+  // The write half failed: the mux may have reset, select again
+  io.partial = 1;
+  TEST_ASSERT_TRUE(ch3.readThenWrite(SENSOR, buf, sizeof(buf), next,
+                                     sizeof(next), wrote));
+  TEST_ASSERT_FALSE(wrote);
+  TEST_ASSERT_TRUE(ch3.read(SENSOR, buf, sizeof(buf)));
+  TEST_ASSERT_EQUAL_UINT32(6, io.transfers.size());
+  TEST_ASSERT_EQUAL_HEX16(MUX, io.transfers[4][0].addr);
+
+  // Another channel
+  TEST_ASSERT_TRUE(mux.channel(5).write(SENSOR, next, sizeof(next)));
+  TEST_ASSERT_EQUAL_HEX8(1u << 5, io.transfers[6][0].data[0]);
+
+  // A failed select is not cached either
+  io.failErrno = EREMOTEIO;
+  TEST_ASSERT_FALSE(ch3.read(SENSOR, buf, sizeof(buf)));
+  TEST_ASSERT_EQUAL_UINT32(9, io.transfers.size());
+  TEST_ASSERT_TRUE(ch3.read(SENSOR, buf, sizeof(buf)));
+  TEST_ASSERT_EQUAL_UINT32(11, io.transfers.size());
+  TEST_ASSERT_EQUAL_HEX16(MUX, io.transfers[9][0].addr);
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_open_checks_plain_i2c);
+  RUN_TEST(test_open_failures_keep_errno);
+  RUN_TEST(test_read_and_write_are_one_message_each);
+  RUN_TEST(test_read_then_write_is_one_transaction);
+  RUN_TEST(test_failed_and_partial_transfers);
+  RUN_TEST(test_mux_channel);
+  return UNITY_END();
+}
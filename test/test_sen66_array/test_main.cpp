@@ -0,0 +1,243 @@
+// test/test_sen66_array/test_main.cpp
+// Sen66Array and Tca9548a against fake sensors behind a fake TCA9548A:
+// phase interleaving, sensors that drop out of a round, and the mux's
+// channel cache after a failure or a bus reset.
+#include <unity.h>
+
+#include <Sen66Array.h>
+
+#include "FakeSen6x.h"
+
+using Fake::FakeBus;
+using Fake::FakeSen6x;
+
+// Three sensors on mux channels 0..2
+struct Rig {
+  FakeBus bus;
+  FakeSen6x fake[3];
+  Tca9548a mux{bus};
+  Sen66 sensor[3] = {Sen66(mux.channel(0)), Sen66(mux.channel(1)),
+                     Sen66(mux.channel(2))};
+  Sen66Array array;
+
+  Rig() {
+    bus.muxPresent = true;
+    for (uint8_t i = 0; i < 3; ++i) {
+      bus.behindMux[i] = &fake[i];
+      array.add(sensor[i]);
+    }
+  }
+
+  // Starts the sensors and waits for their first sample
+  void start() {
+    for (uint8_t i = 0; i < 3; ++i)
+      TEST_ASSERT_TRUE(sensor[i].startMeasurement());
+    bus.advance(1000);
+  }
+
+  // Polls every ms until a round delivers; false after limitMs
+  bool round(uint32_t limitMs = 3000) {
+    for (uint32_t t = 0; t < limitMs; ++t, bus.advance(1))
+      if (array.poll(bus.nowMs))
+        return true;
+    return false;
+  }
+};
+
+static size_t failedTransfers(const FakeBus &bus, size_t from) {
+  size_t n = 0;
+  for (size_t i = from; i < bus.log.size(); ++i)
+    n += !bus.log[i].ok;
+  return n;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_round_delivers_every_sensor() {
+  Rig r;
+  r.start();
+  TEST_ASSERT_TRUE(r.round());
+  for (uint8_t i = 0; i < 3; ++i) {
+    TEST_ASSERT_TRUE(r.array.newSample(i));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 2.5f, r.array.sample(i).mv.pm2_5);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 20.5f, r.array.sample(i).nc.nc1_0);
+    TEST_ASSERT_TRUE(r.array.sample(i).statusValid);
+    TEST_ASSERT_EQUAL_UINT32(0, r.array.errors(i));
+  }
+  // Four phases share one 20 ms wait each, however many sensors
+  TEST_ASSERT_UINT32_WITHIN(4, 4 * Sen66::READ_EXEC_TIME_MS,
+                            r.array.lastRoundMs());
+}
+
+static void test_phases_interleave_across_sensors() {
+  Rig r;
+  r.start();
+  const size_t from = r.bus.log.size();
+  TEST_ASSERT_TRUE(r.round(200));
+
+  // Data-ready goes to all three before any response is read
+  int seen[3] = {0, 0, 0};
+  size_t i = from;
+  for (int commands = 0; commands < 3; ++i) {
+    const FakeBus::Transfer &t = r.bus.log[i];
+    TEST_ASSERT_TRUE(t.write);
+    if (t.addr == FakeBus::MUX_ADDR)
+      continue;
+    TEST_ASSERT_EQUAL_HEX16(Sen66::DATA_READY_CMD, t.cmd);
+    TEST_ASSERT_TRUE(t.channel >= 0 && t.channel < 3);
+    seen[t.channel]++;
+    commands++;
+  }
+  TEST_ASSERT_EQUAL_INT(1, seen[0]);
+  TEST_ASSERT_EQUAL_INT(1, seen[1]);
+  TEST_ASSERT_EQUAL_INT(1, seen[2]);
+
+  // Each response is followed by that sensor's next command, without a
+  // channel select in between
+  for (; i + 1 < r.bus.log.size(); ++i) {
+    const FakeBus::Transfer &t = r.bus.log[i];
+    if (t.write || t.cmd == Sen66::DEVICE_STATUS_CMD)
+      continue;
+    const FakeBus::Transfer &next = r.bus.log[i + 1];
+    TEST_ASSERT_TRUE(next.write);
+    TEST_ASSERT_EQUAL_HEX8(Sen66::I2C_ADDR, next.addr);
+    TEST_ASSERT_EQUAL_INT(t.channel, next.channel);
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, failedTransfers(r.bus, from));
+}
+
+static void test_sensor_not_started_is_skipped() {
+  Rig r;
+  TEST_ASSERT_TRUE(r.sensor[0].startMeasurement());
+  TEST_ASSERT_TRUE(r.sensor[2].startMeasurement());
+  r.bus.advance(1000);
+  const size_t from = r.bus.log.size();
+  TEST_ASSERT_TRUE(r.round());
+  TEST_ASSERT_TRUE(r.array.newSample(0));
+  TEST_ASSERT_FALSE(r.array.newSample(1));
+  TEST_ASSERT_FALSE(r.array.hasSample(1));
+  TEST_ASSERT_TRUE(r.array.newSample(2));
+  TEST_ASSERT_EQUAL_UINT32(0, r.array.errors(1));
+  for (size_t i = from; i < r.bus.log.size(); ++i)
+    TEST_ASSERT_NOT_EQUAL(1, r.bus.log[i].channel);
+}
+
+static void test_absent_sensor_drops_out_of_the_round() {
+  Rig r;
+  r.start();
+  TEST_ASSERT_TRUE(r.round());
+  r.fake[1].present = false;
+  TEST_ASSERT_TRUE(r.round());
+  TEST_ASSERT_TRUE(r.array.newSample(0));
+  TEST_ASSERT_FALSE(r.array.newSample(1));
+  TEST_ASSERT_TRUE(r.array.hasSample(1)); // from the first round
+  TEST_ASSERT_TRUE(r.array.newSample(2));
+  TEST_ASSERT_GREATER_THAN_UINT32(0, r.array.errors(1));
+  TEST_ASSERT_EQUAL_UINT32(0, r.array.errors(0));
+  TEST_ASSERT_EQUAL_UINT32(0, r.array.errors(2));
+}
+
+static void test_not_ready_is_no_error() {
+  Rig r;
+  for (uint8_t i = 0; i < 3; ++i)
+    TEST_ASSERT_TRUE(r.sensor[i].startMeasurement());
+  // The first sample takes a second; rounds before that end at data-ready
+  for (uint32_t t = 0; t < 500; ++t, r.bus.advance(1))
+    TEST_ASSERT_FALSE(r.array.poll(r.bus.nowMs));
+  for (uint8_t i = 0; i < 3; ++i) {
+    TEST_ASSERT_FALSE(r.array.hasSample(i));
+    TEST_ASSERT_EQUAL_UINT32(0, r.array.errors(i));
+  }
+}
+
+static void test_corrupt_response_is_retried_next_round() {
+  Rig r;
+  r.start();
+  r.fake[0].corruptReads = 2; // data-ready and measured values
+  TEST_ASSERT_TRUE(r.round(200));
+  TEST_ASSERT_FALSE(r.array.newSample(0));
+  TEST_ASSERT_TRUE(r.array.newSample(1));
+  TEST_ASSERT_GREATER_THAN_UINT32(0, r.bus.corrupt);
+  TEST_ASSERT_TRUE(r.round());
+  TEST_ASSERT_TRUE(r.array.newSample(0));
+}
+
+// A TCA9548A that reset (brown-out) is back at "no channel" without
+// telling the host; the cached selection must not outlive the failure
+static void test_mux_reset_is_recovered() {
+  FakeBus bus;
+  FakeSen6x fake;
+  bus.muxPresent = true;
+  bus.behindMux[4] = &fake;
+  Tca9548a mux(bus);
+  Sen66 sensor(mux.channel(4));
+  Sen66Array array;
+  array.add(sensor);
+  TEST_ASSERT_TRUE(sensor.startMeasurement());
+  bus.advance(1000);
+  for (uint32_t t = 0; t < 200 && !array.poll(bus.nowMs); ++t)
+    bus.advance(1);
+  TEST_ASSERT_TRUE(array.newSample(0));
+
+  bus.muxRegister = 0;
+  bus.advance(1000);
+  const size_t from = bus.log.size();
+  bool delivered = false;
+  for (uint32_t t = 0; t < 200 && !delivered; ++t, bus.advance(1))
+    delivered = array.poll(bus.nowMs);
+  TEST_ASSERT_TRUE(delivered);
+  // The command into the void fails, the retry selects the channel again
+  TEST_ASSERT_FALSE(bus.log[from].ok);
+  TEST_ASSERT_EQUAL_INT(FakeBus::DIRECT, bus.log[from].channel);
+  TEST_ASSERT_EQUAL_HEX8(FakeBus::MUX_ADDR, bus.log[from + 1].addr);
+}
+
+static void test_channel_select_is_cached() {
+  FakeBus bus;
+  FakeSen6x fake;
+  bus.muxPresent = true;
+  bus.behindMux[4] = &fake;
+  Tca9548a mux(bus);
+  Sen66 sensor(mux.channel(4));
+  TEST_ASSERT_TRUE(sensor.startMeasurement());
+  bus.advance(1000);
+  bool ready = false;
+  TEST_ASSERT_TRUE(sensor.dataReady(ready));
+  TEST_ASSERT_TRUE(ready);
+  TEST_ASSERT_EQUAL_UINT32(1, bus.muxWrites());
+}
+
+static void test_bus_reset_reselects_the_channel() {
+  FakeBus bus;
+  FakeSen6x fake;
+  bus.muxPresent = true;
+  bus.behindMux[4] = &fake;
+  Tca9548a mux(bus);
+  Sen66 sensor(mux.channel(4));
+  TEST_ASSERT_TRUE(sensor.startMeasurement());
+  TEST_ASSERT_EQUAL_UINT32(1, bus.muxWrites());
+  // A bus clear may have reset the switch too
+  bus.busResets++;
+  bus.muxRegister = 0;
+  const size_t from = bus.log.size();
+  bool ready = false;
+  TEST_ASSERT_TRUE(sensor.dataReady(ready));
+  TEST_ASSERT_EQUAL_UINT32(2, bus.muxWrites());
+  TEST_ASSERT_EQUAL_HEX8(FakeBus::MUX_ADDR, bus.log[from].addr);
+  TEST_ASSERT_EQUAL_UINT32(0, failedTransfers(bus, from));
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_round_delivers_every_sensor);
+  RUN_TEST(test_phases_interleave_across_sensors);
+  RUN_TEST(test_sensor_not_started_is_skipped);
+  RUN_TEST(test_absent_sensor_drops_out_of_the_round);
+  RUN_TEST(test_not_ready_is_no_error);
+  RUN_TEST(test_corrupt_response_is_retried_next_round);
+  RUN_TEST(test_mux_reset_is_recovered);
+  RUN_TEST(test_channel_select_is_cached);
+  RUN_TEST(test_bus_reset_reselects_the_channel);
+  return UNITY_END();
+}
@@ -0,0 +1,180 @@
+// test/test_sen66_wire_bus/test_main.cpp
+// Sen66WireBus on the fake TwoWire of test/arduino: an absent device
+// against bus errors, bus clears on a stuck SDA, and the clock stepping
+// down 400 -> 100 -> 50 kHz and back up after the hold.
+#include <unity.h>
+
+#include <Sen66WireBus.h>
+
+static const uint8_t ADDR = 0x6B;
+static const uint8_t CMD[2] = {0x03, 0x00};
+static const int SDA_PIN = 5;
+static const int SCL_PIN = 4;
+
+// pins: with them the bus can clear itself
+struct Rig {
+  TwoWire wire;
+  Sen66WireBus bus;
+
+  explicit Rig(bool pins = true)
+      : bus(wire, pins ? SDA_PIN : -1, pins ? SCL_PIN : -1) {
+    bus.begin(400000);
+  }
+
+  bool read() {
+    uint8_t buf[27];
+    return bus.read(ADDR, buf, sizeof(buf));
+  }
+  bool write() { return bus.write(ADDR, CMD, sizeof(CMD)); }
+  const Sen66WireBus::SpeedStats &stats() const {
+    return bus.stats(bus.speed());
+  }
+};
+
+void setUp() {}
+void tearDown() {}
+
+static void test_absent_device_is_counted_apart_from_errors() {
+  Rig r;
+  r.wire.present = false;
+  TEST_ASSERT_FALSE(r.write());
+  TEST_ASSERT_FALSE(r.read());
+  TEST_ASSERT_EQUAL_UINT32(2, r.stats().absent);
+  TEST_ASSERT_EQUAL_UINT32(0, r.stats().errors);
+  TEST_ASSERT_EQUAL_UINT32(1, r.wire.probes); // the read was probed
+
+  // Neither steps the clock down nor clears the bus
+  for (uint16_t i = 0; i < 2 * Sen66WireBus::WINDOW; ++i)
+    r.read();
+  TEST_ASSERT_EQUAL_UINT8(0, r.bus.speed());
+  TEST_ASSERT_EQUAL_UINT32(400000, r.wire.freq);
+  TEST_ASSERT_EQUAL_UINT32(0, r.bus.recoveries());
+}
+
+// Lost arbitration or a timeout: the device is there, the read failed
+static void test_short_read_from_a_present_device_is_an_error() {
+  Rig r;
+  r.wire.failReads = 1;
+  TEST_ASSERT_FALSE(r.read());
+  TEST_ASSERT_EQUAL_UINT32(1, r.wire.probes);
+  TEST_ASSERT_EQUAL_UINT32(1, r.stats().errors);
+  TEST_ASSERT_EQUAL_UINT32(0, r.stats().absent);
+  TEST_ASSERT_TRUE(r.read());
+  TEST_ASSERT_EQUAL_UINT32(2, r.stats().transactions);
+}
+
+static void test_failed_reads_in_a_row_clear_the_bus() {
+  Rig r;
+  r.wire.failReads = Sen66WireBus::RECOVER_AFTER;
+  for (uint8_t i = 0; i < Sen66WireBus::RECOVER_AFTER; ++i)
+    TEST_ASSERT_FALSE(r.read());
+  TEST_ASSERT_EQUAL_UINT32(1, r.bus.recoveries());
+  TEST_ASSERT_EQUAL_UINT32(0, r.bus.failedClears());
+  TEST_ASSERT_EQUAL_UINT32(2, r.wire.begins); // restarted after the clear
+  TEST_ASSERT_EQUAL_UINT32(400000, r.wire.freq);
+  TEST_ASSERT_TRUE(r.read());
+
+  // Without the pins there is nothing to clear with
+  Rig n(false);
+  n.wire.failReads = Sen66WireBus::RECOVER_AFTER;
+  for (uint8_t i = 0; i < Sen66WireBus::RECOVER_AFTER; ++i)
+    n.read();
+  TEST_ASSERT_EQUAL_UINT32(3, n.stats().errors);
+  TEST_ASSERT_EQUAL_UINT32(0, n.bus.recoveries());
+}
+
+static void test_stuck_sda_is_an_error_and_is_clocked_free() {
+  Rig r;
+  r.wire.sdaStuck = true;
+  for (uint8_t i = 0; i < Sen66WireBus::RECOVER_AFTER; ++i)
+    TEST_ASSERT_FALSE(r.read());
+  // The probe timed out too: not absent
+  TEST_ASSERT_EQUAL_UINT32(Sen66WireBus::RECOVER_AFTER, r.stats().errors);
+  TEST_ASSERT_EQUAL_UINT32(0, r.stats().absent);
+  // Nine pulses and the STOP did not help
+  TEST_ASSERT_EQUAL_UINT32(1, r.bus.recoveries());
+  TEST_ASSERT_EQUAL_UINT32(1, r.bus.failedClears());
+  TEST_ASSERT_EQUAL_UINT32(10, r.wire.sclPulses);
+
+  // A slave that lets go after a few clocks
+  r.wire.releaseAfterPulses = 4;
+  for (uint8_t i = 0; i < Sen66WireBus::RECOVER_AFTER; ++i)
+    TEST_ASSERT_FALSE(r.write());
+  TEST_ASSERT_FALSE(r.wire.sdaStuck);
+  TEST_ASSERT_EQUAL_UINT32(2, r.bus.recoveries());
+  TEST_ASSERT_EQUAL_UINT32(1, r.bus.failedClears());
+  TEST_ASSERT_EQUAL_UINT32(10 + 4 + 1, r.wire.sclPulses);
+  TEST_ASSERT_TRUE(r.read());
+}
+
+static void failWrites(Rig &r, uint32_t n) {
+  r.wire.failWrites = n;
+  for (uint32_t i = 0; i < n; ++i)
+    TEST_ASSERT_FALSE(r.write());
+}
+
+static void test_clock_steps_down_and_back_up() {
+  Rig r(false);
+  TEST_ASSERT_EQUAL_UINT32(400000, r.bus.clock());
+
+  failWrites(r, Sen66WireBus::STEP_DOWN_ERRORS - 1);
+  TEST_ASSERT_EQUAL_UINT8(0, r.bus.speed());
+  failWrites(r, 1);
+  TEST_ASSERT_EQUAL_UINT8(1, r.bus.speed());
+  TEST_ASSERT_EQUAL_UINT32(100000, r.wire.freq);
+  TEST_ASSERT_EQUAL_UINT32(Sen66WireBus::STEP_DOWN_ERRORS,
+                           r.bus.stats(0).errors);
+
+  failWrites(r, Sen66WireBus::STEP_DOWN_ERRORS);
+  TEST_ASSERT_EQUAL_UINT8(2, r.bus.speed());
+  TEST_ASSERT_EQUAL_UINT32(50000, r.wire.freq);
+  // The slowest speed is the floor
+  failWrites(r, Sen66WireBus::STEP_DOWN_ERRORS);
+  TEST_ASSERT_EQUAL_UINT8(2, r.bus.speed());
+
+  // Clean windows before the hold is over change nothing
+  for (uint16_t i = 0; i < 2 * Sen66WireBus::WINDOW; ++i)
+    TEST_ASSERT_TRUE(r.write());
+  TEST_ASSERT_EQUAL_UINT8(2, r.bus.speed());
+
+  // After it the next full window tries the faster speed
+  delay(Sen66WireBus::HOLD_MS);
+  uint16_t n = 0;
+  while (r.bus.speed() == 2 && n++ < Sen66WireBus::WINDOW)
+    r.write();
+  TEST_ASSERT_EQUAL_UINT8(1, r.bus.speed());
+  TEST_ASSERT_EQUAL_UINT32(100000, r.wire.freq);
+}
+
+// A probed speed that fails again falls back and holds twice as long
+static void test_failed_probe_doubles_the_hold() {
+  Rig r(false);
+  failWrites(r, Sen66WireBus::STEP_DOWN_ERRORS);
+  TEST_ASSERT_EQUAL_UINT8(1, r.bus.speed());
+  delay(Sen66WireBus::HOLD_MS);
+  for (uint16_t i = 0; i < Sen66WireBus::WINDOW; ++i)
+    r.write();
+  TEST_ASSERT_EQUAL_UINT8(0, r.bus.speed());
+  failWrites(r, Sen66WireBus::STEP_DOWN_ERRORS);
+  TEST_ASSERT_EQUAL_UINT8(1, r.bus.speed());
+
+  delay(Sen66WireBus::HOLD_MS);
+  for (uint16_t i = 0; i < Sen66WireBus::WINDOW; ++i)
+    r.write();
+  TEST_ASSERT_EQUAL_UINT8(1, r.bus.speed());
+  delay(Sen66WireBus::HOLD_MS);
+  for (uint16_t i = 0; i < Sen66WireBus::WINDOW; ++i)
+    r.write();
+  TEST_ASSERT_EQUAL_UINT8(0, r.bus.speed());
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_absent_device_is_counted_apart_from_errors);
+  RUN_TEST(test_short_read_from_a_present_device_is_an_error);
+  RUN_TEST(test_failed_reads_in_a_row_clear_the_bus);
+  RUN_TEST(test_stuck_sda_is_an_error_and_is_clocked_free);
+  RUN_TEST(test_clock_steps_down_and_back_up);
+  RUN_TEST(test_failed_probe_doubles_the_hold);
+  return UNITY_END();
+}
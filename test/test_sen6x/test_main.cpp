@@ -0,0 +1,202 @@
+// test/test_sen6x/test_main.cpp
+// Sen66 driving the SEN6X_MODEL it is built for (native_test: SEN66;
+// native_test_sen63/65/68 for the others): the model's read commands,
+// decoded values, NaN for the words the model lacks, and CRC failures.
+// The expectations come from the datasheet table, not from Sen6x.h; the
+// fake sensor builds its frames from Sen6x.h, so the word order is
+// checked against the table directly.
+#include <math.h>
+#include <unity.h>
+
+#include <type_traits>
+
+#include <Sen66.h>
+
+#include "FakeSen6x.h"
+
+using namespace Sen66Protocol;
+using Fake::FakeBus;
+using Fake::FakeSen6x;
+
+// The datasheet's frames of each model, word by word
+#if SEN6X_MODEL == 63
+static const uint16_t MEASURED_CMD = 0x0471;
+using MeasuredLayout = WordList<W_PM1_0, W_PM2_5, W_PM4_0, W_PM10_0,
+                                W_HUMIDITY, W_TEMPERATURE, W_CO2>;
+static const uint16_t RAW_CMD = 0x0492;
+using RawLayout = WordList<W_RAW_HUMIDITY, W_RAW_TEMPERATURE>;
+#elif SEN6X_MODEL == 65
+static const uint16_t MEASURED_CMD = 0x0446;
+using MeasuredLayout = WordList<W_PM1_0, W_PM2_5, W_PM4_0, W_PM10_0,
+                                W_HUMIDITY, W_TEMPERATURE, W_VOC, W_NOX>;
+static const uint16_t RAW_CMD = 0x0455;
+using RawLayout =
+    WordList<W_RAW_HUMIDITY, W_RAW_TEMPERATURE, W_RAW_VOC, W_RAW_NOX>;
+#elif SEN6X_MODEL == 66
+static const uint16_t MEASURED_CMD = 0x0300;
+using MeasuredLayout =
+    WordList<W_PM1_0, W_PM2_5, W_PM4_0, W_PM10_0, W_HUMIDITY, W_TEMPERATURE,
+             W_VOC, W_NOX, W_CO2>;
+static const uint16_t RAW_CMD = 0x0405;
+using RawLayout = WordList<W_RAW_HUMIDITY, W_RAW_TEMPERATURE, W_RAW_VOC,
+                           W_RAW_NOX, W_RAW_CO2>;
+#elif SEN6X_MODEL == 68
+static const uint16_t MEASURED_CMD = 0x0467;
+using MeasuredLayout =
+    WordList<W_PM1_0, W_PM2_5, W_PM4_0, W_PM10_0, W_HUMIDITY, W_TEMPERATURE,
+             W_VOC, W_NOX, W_HCHO>;
+static const uint16_t RAW_CMD = 0x0455;
+using RawLayout =
+    WordList<W_RAW_HUMIDITY, W_RAW_TEMPERATURE, W_RAW_VOC, W_RAW_NOX>;
+#endif
+
+static const bool HAS_VOC_NOX = MeasuredLayout::has(W_VOC);
+static const bool HAS_CO2 = MeasuredLayout::has(W_CO2);
+static const bool HAS_HCHO = MeasuredLayout::has(W_HCHO);
+static const bool HAS_RAW_CO2 = RawLayout::has(W_RAW_CO2);
+
+// One sensor directly on the bus
+struct Rig {
+  FakeBus bus;
+  FakeSen6x fake;
+  Sen66 sensor{bus};
+
+  Rig() { bus.direct = &fake; }
+
+  // The last command written
+  const FakeBus::Transfer &lastWrite() const {
+    for (size_t i = bus.log.size(); i-- > 0;)
+      if (bus.log[i].write)
+        return bus.log[i];
+    TEST_FAIL_MESSAGE("nothing written");
+    return bus.log[0];
+  }
+};
+
+static void assertValue(bool present, float expected, float value,
+                        bool valid, const char *name) {
+  if (present) {
+    TEST_ASSERT_TRUE_MESSAGE(valid, name);
+    TEST_ASSERT_FLOAT_WITHIN_MESSAGE(0.001f, expected, value, name);
+  } else {
+    TEST_ASSERT_FALSE_MESSAGE(valid, name);
+    TEST_ASSERT_TRUE_MESSAGE(isnan(value), name);
+  }
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_frames_match_the_datasheet() {
+  TEST_ASSERT_EQUAL_HEX16(MEASURED_CMD, BuildModel::MEASURED_VALUES_CMD);
+  TEST_ASSERT_EQUAL_HEX16(RAW_CMD, BuildModel::RAW_VALUES_CMD);
+  TEST_ASSERT_TRUE(
+      (std::is_same<MeasuredLayout, BuildModel::MeasuredWords>::value));
+  TEST_ASSERT_TRUE((std::is_same<RawLayout, BuildModel::RawWords>::value));
+}
+
+static void test_measured_values_use_the_models_frame() {
+  Rig r;
+  Sen66::MeasuredValues mv;
+  TEST_ASSERT_TRUE(r.sensor.readMeasuredValues(mv));
+  TEST_ASSERT_EQUAL_HEX16(MEASURED_CMD, r.lastWrite().cmd);
+  const size_t words = 6 + 2 * HAS_VOC_NOX + HAS_CO2 + HAS_HCHO;
+  TEST_ASSERT_EQUAL_UINT32(3 * words, MEASURED_VALUES_FRAME_LEN);
+
+  assertValue(true, 1.2f, mv.pm1_0, mv.valid_pm1_0, "pm1_0");
+  assertValue(true, 2.5f, mv.pm2_5, mv.valid_pm2_5, "pm2_5");
+  assertValue(true, 3.1f, mv.pm4_0, mv.valid_pm4_0, "pm4_0");
+  assertValue(true, 3.4f, mv.pm10_0, mv.valid_pm10_0, "pm10_0");
+  assertValue(true, 45.67f, mv.humidity_rh, mv.valid_humidity, "humidity");
+  assertValue(true, 21.5f, mv.temperature_c, mv.valid_temperature,
+              "temperature");
+  assertValue(HAS_VOC_NOX, 110.0f, mv.voc_index, mv.valid_voc, "voc");
+  assertValue(HAS_VOC_NOX, 2.0f, mv.nox_index, mv.valid_nox, "nox");
+  assertValue(HAS_CO2, 650.0f, mv.co2_ppm, mv.valid_co2, "co2");
+  assertValue(HAS_HCHO, 25.5f, mv.hcho_ppb, mv.valid_hcho, "hcho");
+}
+
+// Signed words, and the sensor's "unknown" values in a word it sends
+static void test_measured_values_signed_and_unknown_words() {
+  Rig r;
+  r.fake.word[W_TEMPERATURE] = (uint16_t)(int16_t)-2100; // -10.5 °C
+  r.fake.word[W_HUMIDITY] = 0x7FFF;
+  r.fake.word[W_PM2_5] = 0xFFFF;
+  r.fake.word[W_VOC] = (uint16_t)(int16_t)-5; // not sent by every model
+  r.fake.word[W_HCHO] = 0xFFFF;
+  Sen66::MeasuredValues mv;
+  TEST_ASSERT_TRUE(r.sensor.readMeasuredValues(mv));
+  assertValue(true, -10.5f, mv.temperature_c, mv.valid_temperature,
+              "temperature");
+  assertValue(false, 0.0f, mv.humidity_rh, mv.valid_humidity, "humidity");
+  assertValue(false, 0.0f, mv.pm2_5, mv.valid_pm2_5, "pm2_5");
+  assertValue(HAS_VOC_NOX, -0.5f, mv.voc_index, mv.valid_voc, "voc");
+  assertValue(false, 0.0f, mv.hcho_ppb, mv.valid_hcho, "hcho");
+}
+
+static void test_raw_values_use_the_models_frame() {
+  Rig r;
+  Sen66::RawValues raw;
+  TEST_ASSERT_TRUE(r.sensor.readRawValues(raw));
+  TEST_ASSERT_EQUAL_HEX16(RAW_CMD, r.lastWrite().cmd);
+  TEST_ASSERT_EQUAL_UINT32(3 * (2 + 2 * HAS_VOC_NOX + HAS_RAW_CO2),
+                           RAW_VALUES_FRAME_LEN);
+  TEST_ASSERT_EQUAL_INT16(4500, raw.humidity);
+  TEST_ASSERT_EQUAL_INT16(4400, raw.temperature);
+  TEST_ASSERT_EQUAL_UINT16(HAS_VOC_NOX ? 27000 : 0xFFFF, raw.vocTicks);
+  TEST_ASSERT_EQUAL_UINT16(HAS_VOC_NOX ? 15000 : 0xFFFF, raw.noxTicks);
+  TEST_ASSERT_EQUAL_UINT16(HAS_RAW_CO2 ? 640 : 0xFFFF, raw.co2);
+}
+
+// Shared by the family
+static void test_number_concentration_and_status() {
+  Rig r;
+  r.fake.status = 0x00200010;
+  Sen66::NumberConcentration nc;
+  TEST_ASSERT_TRUE(r.sensor.readNumberConcentration(nc));
+  TEST_ASSERT_EQUAL_HEX16(0x0316, r.lastWrite().cmd);
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 10.1f, nc.nc0_5);
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 21.2f, nc.nc10_0);
+  TEST_ASSERT_TRUE(nc.valid_nc0_5 && nc.valid_nc10_0);
+  uint32_t status = 0;
+  TEST_ASSERT_TRUE(r.sensor.readDeviceStatus(status));
+  TEST_ASSERT_EQUAL_HEX32(0x00200010, status);
+}
+
+// One corrupt response costs a retry; the sensor's values come through
+static void test_crc_failure_is_retried() {
+  Rig r;
+  r.fake.corruptReads = 1;
+  Sen66::MeasuredValues mv;
+  TEST_ASSERT_TRUE(r.sensor.readMeasuredValues(mv));
+  TEST_ASSERT_EQUAL_UINT32(1, r.bus.corrupt);
+  TEST_ASSERT_EQUAL_UINT32(1, r.sensor.retries());
+  TEST_ASSERT_EQUAL_UINT32(0, r.sensor.failures());
+  assertValue(true, 2.5f, mv.pm2_5, mv.valid_pm2_5, "pm2_5");
+}
+
+static void test_crc_failure_on_every_attempt_fails_the_read() {
+  Rig r;
+  r.fake.corruptReads = 100;
+  Sen66::MeasuredValues mv;
+  Sen66::RawValues raw;
+  TEST_ASSERT_FALSE(r.sensor.readMeasuredValues(mv));
+  TEST_ASSERT_FALSE(r.sensor.readRawValues(raw));
+  const uint32_t attempts =
+      Sen66::RETRY_POLICY[Sen66::CMD_MEASURED_VALUES].attempts +
+      Sen66::RETRY_POLICY[Sen66::CMD_RAW_VALUES].attempts;
+  TEST_ASSERT_EQUAL_UINT32(attempts, r.bus.corrupt);
+  TEST_ASSERT_EQUAL_UINT32(2, r.sensor.failures());
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_frames_match_the_datasheet);
+  RUN_TEST(test_measured_values_use_the_models_frame);
+  RUN_TEST(test_measured_values_signed_and_unknown_words);
+  RUN_TEST(test_raw_values_use_the_models_frame);
+  RUN_TEST(test_number_concentration_and_status);
+  RUN_TEST(test_crc_failure_is_retried);
+  RUN_TEST(test_crc_failure_on_every_attempt_fails_the_read);
+  return UNITY_END();
+}
@@ -0,0 +1,124 @@
+// test/test_synced_clock/test_main.cpp
+// SyncedClock: the first sync, the oscillator rate estimated over
+// MIN_DRIFT_INTERVAL_MS and applied between syncs, implausible rates
+// ignored, and conversions across a millis() wrap and beyond 24.8 days.
+#include <unity.h>
+
+#include <SyncedClock.h>
+
+static const int64_t EPOCH_MS = 1767225600000LL; // 2026-01-01
+static const uint32_t MINUTE = 60000;
+static const uint32_t HOUR = 60 * MINUTE;
+static const uint32_t DAY = 24 * HOUR;
+
+void setUp() {}
+void tearDown() {}
+
+static void test_first_sync_anchors_without_drift() {
+  SyncedClock c;
+  TEST_ASSERT_FALSE(c.synced());
+  TEST_ASSERT_EQUAL_INT32(0, c.sync(5000, EPOCH_MS));
+  TEST_ASSERT_TRUE(c.synced());
+  TEST_ASSERT_EQUAL_UINT32(1, c.syncs());
+  TEST_ASSERT_EQUAL_UINT32(5000, c.lastSyncMs());
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, c.driftPpm());
+
+  TEST_ASSERT_TRUE(c.toEpochMs(5000) == EPOCH_MS);
+  TEST_ASSERT_TRUE(c.toEpochMs(5000 + HOUR) == EPOCH_MS + HOUR);
+  // Shortly before the anchor
+  TEST_ASSERT_TRUE(c.toEpochMs(4000) == EPOCH_MS - 1000);
+  // Rounded to the nearest second
+  TEST_ASSERT_EQUAL_UINT32(EPOCH_MS / 1000 + 1, c.toEpochSeconds(5500));
+  TEST_ASSERT_EQUAL_UINT32(EPOCH_MS / 1000, c.toEpochSeconds(5499));
+}
+
+// A crystal 20 ppm slow: 24 ms short over 20 minutes
+static void test_drift_is_estimated_and_applied() {
+  SyncedClock c;
+  c.sync(0, EPOCH_MS);
+  // Too soon to tell the rate from network jitter
+  TEST_ASSERT_EQUAL_INT32(-6, c.sync(5 * MINUTE, EPOCH_MS + 5 * MINUTE + 6));
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, c.driftPpm());
+
+  // Measured from the first sync, so frequent syncs still add up
+  c.sync(20 * MINUTE, EPOCH_MS + 20 * MINUTE + 24);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 20.0f, c.driftPpm());
+
+  // An hour later the extrapolation carries the 72 ms
+  const uint32_t t = 80 * MINUTE;
+  TEST_ASSERT_INT32_WITHIN(1, 0,
+                           (int32_t)(c.toEpochMs(t) -
+                                     (EPOCH_MS + t + 24 + 72)));
+  TEST_ASSERT_INT32_WITHIN(1, 0, c.sync(t, EPOCH_MS + t + 24 + 72));
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 20.0f, c.driftPpm());
+
+  // A new rate is blended in with DRIFT_SMOOTHING
+  const uint32_t u = t + HOUR;
+  c.sync(u, EPOCH_MS + u + 24 + 72 + 144); // 40 ppm over the hour
+  TEST_ASSERT_FLOAT_WITHIN(0.01f,
+                           20.0f + SyncedClock::DRIFT_SMOOTHING * 20.0f,
+                           c.driftPpm());
+}
+
+// A 1 s step over 15 minutes is 1111 ppm: a clock step, not a rate
+static void test_implausible_rate_is_ignored() {
+  SyncedClock c;
+  c.sync(0, EPOCH_MS);
+  const uint32_t t = SyncedClock::MIN_DRIFT_INTERVAL_MS;
+  TEST_ASSERT_EQUAL_INT32(-1000, c.sync(t, EPOCH_MS + t + 1000));
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, c.driftPpm());
+  // The anchor still moved
+  TEST_ASSERT_TRUE(c.toEpochMs(t) == EPOCH_MS + t + 1000);
+
+  // Just inside the limit is taken
+  SyncedClock d;
+  d.sync(0, EPOCH_MS);
+  d.sync(t, EPOCH_MS + t + 440); // 489 ppm
+  TEST_ASSERT_FLOAT_WITHIN(1.0f, 489.0f, d.driftPpm());
+}
+
+static void test_millis_wrap() {
+  SyncedClock c;
+  const uint32_t anchor = 0xFFFFFFFFu - 10 * MINUTE;
+  c.sync(anchor, EPOCH_MS);
+  // 20 minutes later millis() has wrapped
+  const uint32_t later = anchor + 20 * MINUTE;
+  TEST_ASSERT_TRUE(later < anchor);
+  TEST_ASSERT_TRUE(c.toEpochMs(later) == EPOCH_MS + 20 * MINUTE);
+
+  // The rate is measured across the wrap too
+  c.sync(later, EPOCH_MS + 20 * MINUTE + 24);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 20.0f, c.driftPpm());
+
+  // And a sample from before the wrap converts backwards
+  TEST_ASSERT_INT32_WITHIN(
+      1, 0,
+      (int32_t)(c.toEpochMs(anchor) - EPOCH_MS));
+}
+
+// An outage that keeps SNTP away for weeks: past 24.8 days of millis()
+// still counts forwards, as far back as MAX_BEFORE_ANCHOR_MS backwards
+static void test_long_extrapolation() {
+  SyncedClock c;
+  c.sync(1000, EPOCH_MS);
+  TEST_ASSERT_TRUE(c.toEpochMs(1000 + 25 * DAY) == EPOCH_MS + 25 * DAY);
+  TEST_ASSERT_TRUE(c.toEpochMs(1000 + 40 * DAY) == EPOCH_MS + 40 * DAY);
+  TEST_ASSERT_EQUAL_UINT32(EPOCH_MS / 1000 + 40 * 86400,
+                           c.toEpochSeconds(1000 + 40 * DAY));
+
+  // A day of history from before the anchor
+  TEST_ASSERT_TRUE(c.toEpochMs(1000 - DAY) == EPOCH_MS - DAY);
+  const uint32_t oldest = 1000 - SyncedClock::MAX_BEFORE_ANCHOR_MS;
+  TEST_ASSERT_TRUE(c.toEpochMs(oldest) ==
+                   EPOCH_MS - SyncedClock::MAX_BEFORE_ANCHOR_MS);
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_first_sync_anchors_without_drift);
+  RUN_TEST(test_drift_is_estimated_and_applied);
+  RUN_TEST(test_implausible_rate_is_ignored);
+  RUN_TEST(test_millis_wrap);
+  RUN_TEST(test_long_extrapolation);
+  return UNITY_END();
+}
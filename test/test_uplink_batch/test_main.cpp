@@ -0,0 +1,364 @@
+// test/test_uplink_batch/test_main.cpp
+// lib/Uplink: a batch written and read back record for record, what the
+// delta coding costs, sequence numbers across a wrap and a reboot,
+// unknown markers, truncated buffers and headers the reader refuses.
+#include <math.h>
+#include <string.h>
+#include <unity.h>
+
+#include <vector>
+
+#include <UplinkBatch.h>
+
+using namespace Uplink;
+using History::Ticks;
+
+static const int64_t BASE_MS = 1767225600000LL; // 2026-01-01
+static const char *const TAGS[2] = {"bus", "mux3"};
+
+struct Batch {
+  uint8_t buf[4096];
+  BatchWriter w{buf, sizeof(buf)};
+  size_t header;
+
+  Batch() {
+    TEST_ASSERT_TRUE(w.begin(BASE_MS, "node1", "kitchen", "home", TAGS, 2));
+    header = w.length();
+  }
+};
+
+static Ticks sampleTicks(uint16_t k) {
+  Ticks t;
+  for (uint8_t c = 0; c < History::CHANNEL_COUNT; ++c)
+    t.v[c] = (uint16_t)(100 * c + k);
+  t.v[History::CH_TEMPERATURE] = (uint16_t)(int16_t)(-150 + k); // -0.75 °C
+  t.v[History::CH_HCHO] = 0xFFFF;
+  return t;
+}
+
+static void assertSameTicks(const Ticks &expected, const Ticks &actual) {
+  TEST_ASSERT_EQUAL_MEMORY(expected.v, actual.v, sizeof(expected.v));
+}
+
+static void assertText(const char *expected, const Text &t) {
+  TEST_ASSERT_EQUAL_UINT32(strlen(expected), t.len);
+  TEST_ASSERT_EQUAL_MEMORY(expected, t.data, t.len);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_round_trip() {
+  Batch b;
+  struct In {
+    uint8_t sensor;
+    int64_t ms;
+    Ticks t;
+    uint32_t status;
+    uint32_t seq;
+  };
+  std::vector<In> in;
+  for (uint16_t i = 0; i < 50; ++i) {
+    const uint8_t s = i % 2;
+    Ticks t = sampleTicks((uint16_t)(i / 2));
+    if (i % 7 == 0)
+      t.v[History::CH_CO2] = (uint16_t)(400 + 37 * i); // bigger steps
+    const In r = {s, BASE_MS + 500 * i + s, t, i > 30 ? 0x10u : 0u,
+                  (uint32_t)(1 + i / 2)};
+    in.push_back(r);
+    TEST_ASSERT_TRUE(b.w.add(r.sensor, r.ms, r.t, r.status, r.seq));
+  }
+  TEST_ASSERT_EQUAL_UINT32(50, b.w.records());
+
+  BatchReader rd(b.w.data(), b.w.length());
+  TEST_ASSERT_TRUE(rd.begin());
+  TEST_ASSERT_EQUAL_UINT8(VERSION, rd.version());
+  TEST_ASSERT_TRUE(rd.baseEpochMs() == BASE_MS);
+  assertText("node1", rd.device());
+  assertText("kitchen", rd.room());
+  assertText("home", rd.site());
+  TEST_ASSERT_EQUAL_UINT8(2, rd.sensorCount());
+  assertText("mux3", rd.sensorTag(1));
+
+  Record r;
+  for (size_t i = 0; i < in.size(); ++i) {
+    TEST_ASSERT_TRUE(rd.next(r));
+    TEST_ASSERT_EQUAL_UINT8(in[i].sensor, r.sensor);
+    TEST_ASSERT_TRUE(r.epochMs == in[i].ms);
+    assertSameTicks(in[i].t, r.ticks);
+    TEST_ASSERT_EQUAL_HEX32(in[i].status, r.status);
+    TEST_ASSERT_EQUAL_UINT32(in[i].seq, r.seq);
+  }
+  TEST_ASSERT_FALSE(rd.next(r));
+  TEST_ASSERT_NULL(rd.error());
+}
+
+// Unchanged channels cost nothing, small steps a byte, a full-range step
+// (and its way back) three
+static void test_varint_deltas() {
+  Batch b;
+  Ticks t = sampleTicks(0);
+  TEST_ASSERT_TRUE(b.w.add(0, BASE_MS, t, 0, 1));
+  size_t len = b.w.length();
+
+  // Same values a second later: sensor, 2-byte time, mask
+  TEST_ASSERT_TRUE(b.w.add(0, BASE_MS + 1000, t, 0, 2));
+  TEST_ASSERT_EQUAL_UINT32(len + 5, b.w.length());
+  len = b.w.length();
+
+  t.v[History::CH_PM2_5] += 3;
+  t.v[History::CH_HUMIDITY] -= 60;
+  TEST_ASSERT_TRUE(b.w.add(0, BASE_MS + 2000, t, 0, 3));
+  TEST_ASSERT_EQUAL_UINT32(len + 5 + 1 + 1, b.w.length());
+  len = b.w.length();
+
+  t.v[History::CH_NOX] = 0xFFFF;
+  TEST_ASSERT_TRUE(b.w.add(0, BASE_MS + 3000, t, 0, 4));
+  t.v[History::CH_NOX] = 0;
+  TEST_ASSERT_TRUE(b.w.add(0, BASE_MS + 4000, t, 0, 5));
+  TEST_ASSERT_EQUAL_UINT32(len + 2 * (5 + 3), b.w.length());
+
+  // Time can go backwards (a clock step)
+  TEST_ASSERT_TRUE(b.w.add(0, BASE_MS + 1500, t, 0, 6));
+
+  BatchReader rd(b.w.data(), b.w.length());
+  TEST_ASSERT_TRUE(rd.begin());
+  Record r;
+  for (int i = 0; i < 4; ++i)
+    TEST_ASSERT_TRUE(rd.next(r));
+  TEST_ASSERT_EQUAL_HEX16(0xFFFF, r.ticks.v[History::CH_NOX]);
+  TEST_ASSERT_TRUE(rd.next(r));
+  TEST_ASSERT_EQUAL_HEX16(0, r.ticks.v[History::CH_NOX]);
+  TEST_ASSERT_EQUAL_UINT16(sampleTicks(0).v[History::CH_PM2_5] + 3,
+                           r.ticks.v[History::CH_PM2_5]);
+  TEST_ASSERT_TRUE(rd.next(r));
+  TEST_ASSERT_TRUE(r.epochMs == BASE_MS + 1500);
+  assertSameTicks(t, r.ticks);
+}
+
+// Consecutive numbers are implied, across the uint32 wrap too; a reboot
+// (back to 1) and a gap are carried
+static void test_sequence_numbers() {
+  Batch b;
+  const Ticks t = sampleTicks(0);
+  const uint32_t seqs[] = {0xFFFFFFFEu, 0xFFFFFFFFu, 0, 1, 1, 2, 10};
+  const bool carried[] = {true, false, false, false, true, false, true};
+  size_t len = 0;
+  for (size_t i = 0; i < sizeof(seqs) / sizeof(seqs[0]); ++i) {
+    len = b.w.length();
+    TEST_ASSERT_TRUE(b.w.add(0, BASE_MS + 1000 * (int64_t)i, t, 0, seqs[i]));
+    // sensor, time (0: one byte, 1000 ms: two), mask
+    const uint8_t maskHigh = b.w.data()[len + 1 + (i ? 2 : 1) + 1];
+    TEST_ASSERT_TRUE_MESSAGE(carried[i] == ((maskHigh & (MASK_SEQ >> 8)) != 0),
+                             "sequence number in the mask");
+  }
+
+  BatchReader rd(b.w.data(), b.w.length());
+  TEST_ASSERT_TRUE(rd.begin());
+  Record r;
+  for (size_t i = 0; i < sizeof(seqs) / sizeof(seqs[0]); ++i) {
+    TEST_ASSERT_TRUE(rd.next(r));
+    TEST_ASSERT_EQUAL_UINT32(seqs[i], r.seq);
+  }
+}
+
+// Every sensor's first record carries its number, whatever the other did
+static void test_sequence_numbers_per_sensor() {
+  Batch b;
+  const Ticks t = sampleTicks(0);
+  TEST_ASSERT_TRUE(b.w.add(0, BASE_MS, t, 0, 7));
+  TEST_ASSERT_TRUE(b.w.add(1, BASE_MS, t, 0, 8));
+  TEST_ASSERT_TRUE(b.w.add(0, BASE_MS + 1000, t, 0, 8));
+  TEST_ASSERT_TRUE(b.w.add(1, BASE_MS + 1000, t, 0, 9));
+  BatchReader rd(b.w.data(), b.w.length());
+  TEST_ASSERT_TRUE(rd.begin());
+  Record r;
+  const uint32_t expected[] = {7, 8, 8, 9};
+  for (uint8_t i = 0; i < 4; ++i) {
+    TEST_ASSERT_TRUE(rd.next(r));
+    TEST_ASSERT_EQUAL_UINT32(expected[i], r.seq);
+  }
+}
+
+// The sensor's markers go through as ticks and still read as unknown;
+// HCHO is not in the schema and always comes back unknown
+static void test_unknown_words() {
+  Batch b;
+  Ticks t = sampleTicks(5);
+  t.v[History::CH_HUMIDITY] = 0x7FFF;
+  t.v[History::CH_TEMPERATURE] = 0x7FFF;
+  t.v[History::CH_VOC] = 0x7FFF;
+  t.v[History::CH_PM2_5] = 0xFFFF;
+  t.v[History::CH_CO2] = 0xFFFF;
+  t.v[History::CH_HCHO] = 123; // dropped
+  TEST_ASSERT_TRUE(b.w.add(0, BASE_MS, t, 0, 1));
+  t.v[History::CH_CO2] = 600;
+  TEST_ASSERT_TRUE(b.w.add(0, BASE_MS + 1000, t, 0, 2));
+
+  BatchReader rd(b.w.data(), b.w.length());
+  TEST_ASSERT_TRUE(rd.begin());
+  Record r;
+  TEST_ASSERT_TRUE(rd.next(r));
+  const uint8_t unknown[] = {History::CH_HUMIDITY, History::CH_TEMPERATURE,
+                             History::CH_VOC, History::CH_PM2_5,
+                             History::CH_CO2, History::CH_HCHO};
+  for (uint8_t c : unknown)
+    TEST_ASSERT_TRUE(isnan(History::toValue((History::Channel)c, r.ticks.v[c])));
+  TEST_ASSERT_EQUAL_HEX16(0xFFFF, r.ticks.v[History::CH_HCHO]);
+  TEST_ASSERT_TRUE(rd.next(r));
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 600.0f,
+                           History::toValue(History::CH_CO2,
+                                            r.ticks.v[History::CH_CO2]));
+  TEST_ASSERT_TRUE(isnan(History::toValue(History::CH_VOC,
+                                          r.ticks.v[History::CH_VOC])));
+}
+
+// A full buffer refuses the record and keeps what it has
+static void test_writer_at_capacity() {
+  uint8_t buf[128];
+  BatchWriter w(buf, sizeof(buf));
+  TEST_ASSERT_TRUE(w.begin(BASE_MS, "node1", "kitchen", "home", TAGS, 2));
+  uint32_t added = 0;
+  Ticks t = sampleTicks(0);
+  while (w.add(0, BASE_MS + 1000 * added, t, 0, added + 1))
+    ++added;
+  TEST_ASSERT_TRUE(added > 0);
+  const size_t len = w.length();
+  TEST_ASSERT_TRUE(len <= sizeof(buf));
+  TEST_ASSERT_EQUAL_UINT32(added, w.records());
+
+  // Whatever made it in reads back whole
+  BatchReader rd(buf, len);
+  TEST_ASSERT_TRUE(rd.begin());
+  Record r;
+  for (uint32_t i = 0; i < added; ++i) {
+    TEST_ASSERT_TRUE(rd.next(r));
+    TEST_ASSERT_EQUAL_UINT32(i + 1, r.seq);
+  }
+  TEST_ASSERT_FALSE(rd.next(r));
+  TEST_ASSERT_NULL(rd.error());
+
+  // A header that does not fit, or too many sensors
+  BatchWriter tiny(buf, 20);
+  TEST_ASSERT_FALSE(tiny.begin(BASE_MS, "node1", "kitchen", "home", TAGS, 2));
+  TEST_ASSERT_FALSE(tiny.add(0, BASE_MS, t, 0, 1));
+  const char *many[MAX_SENSORS + 1] = {};
+  TEST_ASSERT_FALSE(w.begin(BASE_MS, "n", "r", "s", many, MAX_SENSORS + 1));
+}
+
+// Cut anywhere: the whole records before the cut, then an error unless
+// the cut falls between records; never a read past the end
+static void test_truncated_batch() {
+  Batch b;
+  std::vector<size_t> ends; // where each record ends
+  for (uint16_t i = 0; i < 6; ++i) {
+    TEST_ASSERT_TRUE(b.w.add(i % 2, BASE_MS + 1000 * i, sampleTicks(i), i,
+                             (uint32_t)(1 + i / 2)));
+    ends.push_back(b.w.length());
+  }
+
+  Record r;
+  for (size_t cut = 0; cut < b.w.length(); ++cut) {
+    // A copy of exactly that size, so a read past it shows in ASan
+    std::vector<uint8_t> copy(b.w.data(), b.w.data() + cut);
+    BatchReader rd(copy.data(), copy.size());
+    if (cut < b.header) {
+      TEST_ASSERT_FALSE(rd.begin());
+      TEST_ASSERT_NOT_NULL(rd.error());
+      continue;
+    }
+    TEST_ASSERT_TRUE(rd.begin());
+    uint32_t n = 0;
+    while (rd.next(r))
+      ++n;
+    uint32_t whole = 0;
+    bool between = cut == b.header;
+    for (size_t e : ends) {
+      whole += e <= cut;
+      between |= e == cut;
+    }
+    TEST_ASSERT_EQUAL_UINT32(whole, n);
+    if (between)
+      TEST_ASSERT_NULL(rd.error());
+    else
+      TEST_ASSERT_EQUAL_STRING("truncated record", rd.error());
+    TEST_ASSERT_FALSE(rd.next(r)); // stays failed
+  }
+
+  BatchReader head(b.w.data(), b.header - 1);
+  TEST_ASSERT_FALSE(head.begin());
+  TEST_ASSERT_EQUAL_STRING("truncated header", head.error());
+  BatchReader fixed(b.w.data(), 10);
+  TEST_ASSERT_FALSE(fixed.begin());
+  TEST_ASSERT_EQUAL_STRING("not an uplink batch", fixed.error());
+}
+
+static void test_refuses_unknown_headers() {
+  Batch b;
+  TEST_ASSERT_TRUE(b.w.add(0, BASE_MS, sampleTicks(0), 0, 1));
+  std::vector<uint8_t> copy(b.w.data(), b.w.data() + b.w.length());
+
+  copy[4] = VERSION + 1;
+  BatchReader v(copy.data(), copy.size());
+  TEST_ASSERT_FALSE(v.begin());
+  TEST_ASSERT_EQUAL_STRING("unsupported version", v.error());
+  copy[4] = 0;
+  TEST_ASSERT_FALSE(v.begin());
+  Record r;
+  TEST_ASSERT_FALSE(v.next(r));
+
+  copy[4] = VERSION;
+  copy[5] = SCHEMA_SEN66_TICKS + 1;
+  BatchReader s(copy.data(), copy.size());
+  TEST_ASSERT_FALSE(s.begin());
+  TEST_ASSERT_EQUAL_STRING("unknown schema", s.error());
+
+  copy[5] = SCHEMA_SEN66_TICKS;
+  copy[0] = 'X';
+  BatchReader m(copy.data(), copy.size());
+  TEST_ASSERT_FALSE(m.begin());
+  TEST_ASSERT_EQUAL_STRING("not an uplink batch", m.error());
+
+  // A record for a sensor the header does not list
+  copy[0] = 'S';
+  copy[b.header] = 2;
+  BatchReader i(copy.data(), copy.size());
+  TEST_ASSERT_TRUE(i.begin());
+  TEST_ASSERT_FALSE(i.next(r));
+  TEST_ASSERT_EQUAL_STRING("bad sensor index", i.error());
+}
+
+// Version 1 has no sequence numbers: every record reads 0
+static void test_version_1() {
+  Batch b;
+  const Ticks t = sampleTicks(0);
+  TEST_ASSERT_TRUE(b.w.add(0, BASE_MS, t, 3, 5));
+  // As a version 1 writer sends it: no flag, no number (the last byte)
+  std::vector<uint8_t> copy(b.w.data(), b.w.data() + b.w.length() - 1);
+  copy[4] = 1;
+  copy[b.header + 1 + 1 + 1] &= (uint8_t)~(MASK_SEQ >> 8);
+  BatchReader rd(copy.data(), copy.size());
+  TEST_ASSERT_TRUE(rd.begin());
+  TEST_ASSERT_EQUAL_UINT8(1, rd.version());
+  Record r;
+  TEST_ASSERT_TRUE(rd.next(r));
+  TEST_ASSERT_EQUAL_UINT32(0, r.seq);
+  TEST_ASSERT_EQUAL_HEX32(3, r.status);
+  assertSameTicks(t, r.ticks);
+  TEST_ASSERT_FALSE(rd.next(r));
+  TEST_ASSERT_NULL(rd.error());
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_round_trip);
+  RUN_TEST(test_varint_deltas);
+  RUN_TEST(test_sequence_numbers);
+  RUN_TEST(test_sequence_numbers_per_sensor);
+  RUN_TEST(test_unknown_words);
+  RUN_TEST(test_writer_at_capacity);
+  RUN_TEST(test_truncated_batch);
+  RUN_TEST(test_refuses_unknown_headers);
+  RUN_TEST(test_version_1);
+  return UNITY_END();
+}